@@ -61,6 +61,19 @@ AC_DEFUN([AX_LIBEWF_CHECK_LOCAL],
       [1])
   ])
 
+  dnl Headers and functions used to list a directory in libewf/libewf_directory.c
+  AC_CHECK_HEADERS([dirent.h errno.h])
+  AC_CHECK_FUNCS([closedir opendir readdir])
+
+  dnl Headers and functions used to measure elapsed time in libewf/libewf_statistics.c
+  AC_CHECK_HEADERS([sys/time.h])
+  AC_CHECK_FUNCS([clock_gettime gettimeofday])
+
+  dnl Headers and functions used to share the chunks cache between processes in libewf/libewf_shared_memory_chunks_cache.c
+  AC_CHECK_HEADERS([fcntl.h sys/mman.h sys/stat.h unistd.h])
+  AC_SEARCH_LIBS([shm_open],[rt])
+  AC_CHECK_FUNCS([ftruncate mmap munmap shm_open])
+
   dnl Check for internationalization functions in libewf/libewf_i18n.c 
   AC_CHECK_FUNCS([bindtextdomain])
 
@@ -113,6 +126,14 @@ AC_DEFUN([AX_EWFTOOLS_CHECK_LOCAL],
     [AC_CHECK_HEADERS([io.h])
   ])
 
+  dnl Headers and functions used in ewftools/compression_level_controller.c
+  AC_CHECK_HEADERS([sys/time.h])
+  AC_CHECK_FUNCS([clock_gettime gettimeofday])
+
+  dnl Headers and functions used in ewftools/numa_node.c
+  AC_CHECK_HEADERS([sched.h])
+  AC_CHECK_FUNCS([sched_setaffinity])
+
   dnl Headers included in ewftools/log_handle.c
   AC_CHECK_HEADERS([stdarg.h varargs.h])
 
@@ -0,0 +1,4113 @@
+/*
+ * Bench handle
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+
+#include "bench_handle.h"
+#include "byte_size_string.h"
+#include "compression_level_controller.h"
+#include "ewfcommon.h"
+#include "ewfinput.h"
+#include "ewftools_libcerror.h"
+#include "ewftools_libcfile.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libcsplit.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libewf.h"
+
+/* The words used to generate the text chunks
+ */
+static const char *bench_handle_words[ 16 ] = {
+	"acquire ", "chunk ", "data ", "digest ", "disk ", "evidence ", "examiner ", "file ",
+	"header ", "image ", "media ", "sector ", "segment ", "table ", "the ", "verify " };
+
+/* Creates a bench handle
+ * Make sure the value bench_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_initialize(
+     bench_handle_t **bench_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_initialize";
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *bench_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid bench handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*bench_handle = memory_allocate_structure(
+	                 bench_handle_t );
+
+	if( *bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create bench handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *bench_handle,
+	     0,
+	     sizeof( bench_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear bench handle.",
+		 function );
+
+		goto on_error;
+	}
+	( *bench_handle )->ewf_format                        = LIBEWF_FORMAT_ENCASE6;
+	( *bench_handle )->compression_method                = LIBEWF_COMPRESSION_METHOD_DEFLATE;
+	( *bench_handle )->compression_level                 = LIBEWF_COMPRESSION_FAST;
+	( *bench_handle )->bytes_per_sector                  = 512;
+	( *bench_handle )->sectors_per_chunk                 = 64;
+	( *bench_handle )->maximum_segment_size              = EWFCOMMON_DEFAULT_SEGMENT_FILE_SIZE;
+	( *bench_handle )->media_size                        = 64 * 1024 * 1024;
+	( *bench_handle )->zero_percentage                   = 25;
+	( *bench_handle )->text_percentage                   = 25;
+	( *bench_handle )->seed                              = 1;
+	( *bench_handle )->number_of_random_reads            = 1024;
+	( *bench_handle )->number_of_threads[ 0 ]            = 1;
+	( *bench_handle )->number_of_threads_values          = 1;
+	( *bench_handle )->maximum_number_of_open_handles[ 0 ] = 0;
+	( *bench_handle )->number_of_open_handles_values     = 1;
+
+	return( 1 );
+
+on_error:
+	if( *bench_handle != NULL )
+	{
+		memory_free(
+		 *bench_handle );
+
+		*bench_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a bench handle
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_free(
+     bench_handle_t **bench_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_free";
+	int result            = 1;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *bench_handle != NULL )
+	{
+		if( ( *bench_handle )->filenames != NULL )
+		{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+			if( libewf_glob_wide_free(
+			     ( *bench_handle )->filenames,
+			     ( *bench_handle )->number_of_filenames,
+			     error ) != 1 )
+#else
+			if( libewf_glob_free(
+			     ( *bench_handle )->filenames,
+			     ( *bench_handle )->number_of_filenames,
+			     error ) != 1 )
+#endif
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free glob.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *bench_handle )->export_filename != NULL )
+		{
+			memory_free(
+			 ( *bench_handle )->export_filename );
+		}
+		memory_free(
+		 *bench_handle );
+
+		*bench_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the bench handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_signal_abort(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_signal_abort";
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	bench_handle->abort = 1;
+
+	return( 1 );
+}
+
+/* Sets the target path
+ * The segment files are created using the target path as base and
+ * the RAW export file using the target path with a .raw extension
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_set_target_path(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_set_target_path";
+	size_t string_length  = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle->export_filename != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid bench handle - export filename value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( ( string_length == 0 )
+	 || ( string_length > (size_t) ( ( SSIZE_MAX / sizeof( system_character_t ) ) - 5 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid string length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	bench_handle->export_filename = system_string_allocate(
+	                                 string_length + 5 );
+
+	if( bench_handle->export_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create export filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     bench_handle->export_filename,
+	     string,
+	     string_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy target path to export filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     &( bench_handle->export_filename[ string_length ] ),
+	     _SYSTEM_STRING( ".raw" ),
+	     4 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy extension to export filename.",
+		 function );
+
+		goto on_error;
+	}
+	bench_handle->export_filename[ string_length + 4 ] = 0;
+
+	bench_handle->target_path = string;
+
+	return( 1 );
+
+on_error:
+	if( bench_handle->export_filename != NULL )
+	{
+		memory_free(
+		 bench_handle->export_filename );
+
+		bench_handle->export_filename = NULL;
+	}
+	return( -1 );
+}
+
+/* Sets the format
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int bench_handle_set_format(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_set_format";
+	uint8_t ewf_format    = 0;
+	int result            = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = ewfinput_determine_ewf_format(
+	          string,
+	          &ewf_format,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine format.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		/* The logical formats cannot be used to store media data
+		 */
+		if( ( ewf_format == LIBEWF_FORMAT_LOGICAL_ENCASE5 )
+		 || ( ewf_format == LIBEWF_FORMAT_LOGICAL_ENCASE6 )
+		 || ( ewf_format == LIBEWF_FORMAT_LOGICAL_ENCASE7 )
+		 || ( ewf_format == LIBEWF_FORMAT_V2_LOGICAL_ENCASE7 ) )
+		{
+			result = 0;
+		}
+		else
+		{
+			bench_handle->ewf_format = ewf_format;
+		}
+	}
+	return( result );
+}
+
+/* Sets the compression values
+ * The string is either "level" or "method:level"
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int bench_handle_set_compression_values(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	system_character_t *string_segment               = NULL;
+	static char *function                            = "bench_handle_set_compression_values";
+	size_t string_length                             = 0;
+	size_t string_segment_size                       = 0;
+	int number_of_segments                           = 0;
+	int result                                       = 0;
+	int segment_index                                = 0;
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	libcsplit_wide_split_string_t *string_elements   = NULL;
+#else
+	libcsplit_narrow_split_string_t *string_elements = NULL;
+#endif
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcsplit_wide_string_split(
+	     string,
+	     string_length + 1,
+	     (wchar_t) ':',
+	     &string_elements,
+	     error ) != 1 )
+#else
+	if( libcsplit_narrow_string_split(
+	     string,
+	     string_length + 1,
+	     (char) ':',
+	     &string_elements,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to split string.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcsplit_wide_split_string_get_number_of_segments(
+	     string_elements,
+	     &number_of_segments,
+	     error ) != 1 )
+#else
+	if( libcsplit_narrow_split_string_get_number_of_segments(
+	     string_elements,
+	     &number_of_segments,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( number_of_segments != 1 )
+	 && ( number_of_segments != 2 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: number of segments is out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_segments == 2 )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libcsplit_wide_split_string_get_segment_by_index(
+		     string_elements,
+		     segment_index,
+		     &string_segment,
+		     &string_segment_size,
+		     error ) != 1 )
+#else
+		if( libcsplit_narrow_split_string_get_segment_by_index(
+		     string_elements,
+		     segment_index,
+		     &string_segment,
+		     &string_segment_size,
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve string segment: %d.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		if( string_segment == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing string segment: %d.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		result = ewfinput_determine_compression_method(
+			  string_segment,
+			  &( bench_handle->compression_method ),
+			  error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine compression method.",
+			 function );
+
+			goto on_error;
+		}
+		if( bench_handle->ewf_format != LIBEWF_FORMAT_V2_ENCASE7 )
+		{
+			if( bench_handle->compression_method != LIBEWF_COMPRESSION_METHOD_DEFLATE )
+			{
+				bench_handle->compression_method = LIBEWF_COMPRESSION_METHOD_DEFLATE;
+
+				result = 0;
+			}
+		}
+		segment_index++;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcsplit_wide_split_string_get_segment_by_index(
+	     string_elements,
+	     segment_index,
+	     &string_segment,
+	     &string_segment_size,
+	     error ) != 1 )
+#else
+	if( libcsplit_narrow_split_string_get_segment_by_index(
+	     string_elements,
+	     segment_index,
+	     &string_segment,
+	     &string_segment_size,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve string segment: %d.",
+		 function,
+		 segment_index );
+
+		goto on_error;
+	}
+	if( string_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing string segment: %d.",
+		 function,
+		 segment_index );
+
+		goto on_error;
+	}
+	if( ( number_of_segments == 1 )
+	 || ( result != 0 ) )
+	{
+		result = ewfinput_determine_compression_values(
+		          string_segment,
+		          &( bench_handle->compression_level ),
+		          &( bench_handle->compression_flags ),
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine compression values.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcsplit_wide_split_string_free(
+	     &string_elements,
+	     error ) != 1 )
+#else
+	if( libcsplit_narrow_split_string_free(
+	     &string_elements,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free split string.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( string_elements != NULL )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		libcsplit_wide_split_string_free(
+		 &string_elements,
+		 NULL );
+#else
+		libcsplit_narrow_split_string_free(
+		 &string_elements,
+		 NULL );
+#endif
+	}
+	return( -1 );
+}
+
+/* Sets the number of sectors per chunk
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int bench_handle_set_sectors_per_chunk(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_set_sectors_per_chunk";
+	int result            = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = ewfinput_determine_sectors_per_chunk(
+	          string,
+	          &( bench_handle->sectors_per_chunk ),
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine sectors per chunk.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Sets the maximum segment size
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int bench_handle_set_maximum_segment_size(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function         = "bench_handle_set_maximum_segment_size";
+	size_t string_length          = 0;
+	uint64_t maximum_segment_size = 0;
+	int result                    = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	result = byte_size_string_convert(
+	          string,
+	          string_length,
+	          &maximum_segment_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine maximum segment size.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( ( maximum_segment_size < EWFCOMMON_MINIMUM_SEGMENT_FILE_SIZE )
+		 || ( maximum_segment_size >= (uint64_t) EWFCOMMON_MAXIMUM_SEGMENT_FILE_SIZE_32BIT ) )
+		{
+			result = 0;
+		}
+		else
+		{
+			bench_handle->maximum_segment_size = (size64_t) maximum_segment_size;
+		}
+	}
+	return( result );
+}
+
+/* Sets the media size
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int bench_handle_set_media_size(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_set_media_size";
+	size_t string_length  = 0;
+	uint64_t media_size   = 0;
+	int result            = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	result = byte_size_string_convert(
+	          string,
+	          string_length,
+	          &media_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine media size.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		/* The media size must be a multiple of the sector size
+		 */
+		if( ( media_size == 0 )
+		 || ( media_size > (uint64_t) INT64_MAX )
+		 || ( ( media_size % bench_handle->bytes_per_sector ) != 0 ) )
+		{
+			result = 0;
+		}
+		else
+		{
+			bench_handle->media_size = (size64_t) media_size;
+		}
+	}
+	return( result );
+}
+
+/* Sets the entropy mix
+ * The string contains the percentages of zero, text and random chunks
+ * e.g. "25:25:50", the percentages must add up to 100
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int bench_handle_set_entropy_mix(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	int values[ 3 ];
+
+	static char *function = "bench_handle_set_entropy_mix";
+	int number_of_values  = 0;
+	int result            = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = bench_handle_parse_values(
+	          string,
+	          (system_character_t) ':',
+	          values,
+	          3,
+	          &number_of_values,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine entropy mix.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( ( number_of_values != 3 )
+		 || ( ( values[ 0 ] + values[ 1 ] + values[ 2 ] ) != 100 ) )
+		{
+			result = 0;
+		}
+		else
+		{
+			bench_handle->zero_percentage = (uint8_t) values[ 0 ];
+			bench_handle->text_percentage = (uint8_t) values[ 1 ];
+		}
+	}
+	return( result );
+}
+
+/* Sets the number of random reads
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int bench_handle_set_number_of_random_reads(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_set_number_of_random_reads";
+	int number_of_values  = 0;
+	int result            = 0;
+	int value             = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = bench_handle_parse_values(
+	          string,
+	          (system_character_t) ',',
+	          &value,
+	          1,
+	          &number_of_values,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine number of random reads.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( value == 0 )
+		{
+			result = 0;
+		}
+		else
+		{
+			bench_handle->number_of_random_reads = (uint32_t) value;
+		}
+	}
+	return( result );
+}
+
+/* Sets the random number generator seed
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int bench_handle_set_seed(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_set_seed";
+	int number_of_values  = 0;
+	int result            = 0;
+	int value             = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = bench_handle_parse_values(
+	          string,
+	          (system_character_t) ',',
+	          &value,
+	          1,
+	          &number_of_values,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine seed.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		bench_handle->seed = (uint32_t) value;
+	}
+	return( result );
+}
+
+/* Sets the number of threads values
+ * The string contains a comma separated list e.g. "1,2,4"
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int bench_handle_set_number_of_threads(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	int values[ BENCH_HANDLE_MAXIMUM_NUMBER_OF_VALUES ];
+
+	static char *function = "bench_handle_set_number_of_threads";
+	int number_of_values  = 0;
+	int result            = 0;
+	int value_index       = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = bench_handle_parse_values(
+	          string,
+	          (system_character_t) ',',
+	          values,
+	          BENCH_HANDLE_MAXIMUM_NUMBER_OF_VALUES,
+	          &number_of_values,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine number of threads.",
+		 function );
+
+		return( -1 );
+	}
+	for( value_index = 0;
+	     ( result != 0 ) && ( value_index < number_of_values );
+	     value_index++ )
+	{
+		if( ( values[ value_index ] <= 0 )
+		 || ( values[ value_index ] > EWFCOMMON_MAXIMUM_NUMBER_OF_THREADS ) )
+		{
+			result = 0;
+		}
+#if !defined( HAVE_MULTI_THREAD_SUPPORT )
+		/* Without multi-threading support every reader runs on the main thread
+		 */
+		else if( values[ value_index ] != 1 )
+		{
+			result = 0;
+		}
+#endif
+	}
+	if( result != 0 )
+	{
+		for( value_index = 0;
+		     value_index < number_of_values;
+		     value_index++ )
+		{
+			bench_handle->number_of_threads[ value_index ] = values[ value_index ];
+		}
+		bench_handle->number_of_threads_values = number_of_values;
+	}
+	return( result );
+}
+
+/* Sets the maximum number of open handles values
+ * The string contains a comma separated list e.g. "0,1,8"
+ * where 0 represents no maximum
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int bench_handle_set_maximum_number_of_open_handles(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	int values[ BENCH_HANDLE_MAXIMUM_NUMBER_OF_VALUES ];
+
+	static char *function = "bench_handle_set_maximum_number_of_open_handles";
+	int number_of_values  = 0;
+	int result            = 0;
+	int value_index       = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = bench_handle_parse_values(
+	          string,
+	          (system_character_t) ',',
+	          values,
+	          BENCH_HANDLE_MAXIMUM_NUMBER_OF_VALUES,
+	          &number_of_values,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine maximum number of open handles.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		for( value_index = 0;
+		     value_index < number_of_values;
+		     value_index++ )
+		{
+			bench_handle->maximum_number_of_open_handles[ value_index ] = values[ value_index ];
+		}
+		bench_handle->number_of_open_handles_values = number_of_values;
+	}
+	return( result );
+}
+
+/* Parses a list of decimal values separated by a separator character
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int bench_handle_parse_values(
+     const system_character_t *string,
+     system_character_t separator,
+     int *values,
+     int maximum_number_of_values,
+     int *number_of_values,
+     libcerror_error_t **error )
+{
+	static char *function  = "bench_handle_parse_values";
+	size_t string_index    = 0;
+	int number_of_digits   = 0;
+	int value              = 0;
+	int value_index        = 0;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid values.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_values <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of values value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of values.",
+		 function );
+
+		return( -1 );
+	}
+	for( string_index = 0;
+	     ;
+	     string_index++ )
+	{
+		if( ( string[ string_index ] == separator )
+		 || ( string[ string_index ] == 0 ) )
+		{
+			if( ( number_of_digits == 0 )
+			 || ( value_index >= maximum_number_of_values ) )
+			{
+				return( 0 );
+			}
+			values[ value_index++ ] = value;
+
+			if( string[ string_index ] == 0 )
+			{
+				break;
+			}
+			number_of_digits = 0;
+			value            = 0;
+		}
+		else if( ( string[ string_index ] >= (system_character_t) '0' )
+		      && ( string[ string_index ] <= (system_character_t) '9' ) )
+		{
+			if( value > ( ( INT_MAX - 9 ) / 10 ) )
+			{
+				return( 0 );
+			}
+			value *= 10;
+			value += (int) ( string[ string_index ] - (system_character_t) '0' );
+
+			number_of_digits++;
+		}
+		else
+		{
+			return( 0 );
+		}
+	}
+	*number_of_values = value_index;
+
+	return( 1 );
+}
+
+/* Retrieves the next value of the xorshift random number generator
+ * Returns the random value
+ */
+uint32_t bench_handle_get_random(
+          uint32_t *random_state )
+{
+	uint32_t value = *random_state;
+
+	/* A state of 0 would make the generator return 0 forever
+	 */
+	if( value == 0 )
+	{
+		value = 0x9e3779b9UL;
+	}
+	value ^= value << 13;
+	value ^= value >> 17;
+	value ^= value << 5;
+
+	*random_state = value;
+
+	return( value );
+}
+
+/* Generates the synthetic data of a specific chunk
+ * The chunk type is determined by the seed and chunk index so that the data
+ * is reproducible without having to store it
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_generate_chunk_data(
+     bench_handle_t *bench_handle,
+     uint64_t chunk_index,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	const char *word      = NULL;
+	static char *function = "bench_handle_generate_chunk_data";
+	size_t buffer_offset  = 0;
+	size_t word_length    = 0;
+	uint32_t random_state = 0;
+	uint32_t random_value = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	random_state = bench_handle->seed ^ (uint32_t) ( chunk_index * 2654435761UL );
+
+	random_value = bench_handle_get_random(
+	                &random_state ) % 100;
+
+	if( random_value < bench_handle->zero_percentage )
+	{
+		if( memory_set(
+		     buffer,
+		     0,
+		     buffer_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear buffer.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else if( random_value < (uint32_t) ( bench_handle->zero_percentage + bench_handle->text_percentage ) )
+	{
+		while( buffer_offset < buffer_size )
+		{
+			random_value = bench_handle_get_random(
+			                &random_state );
+
+			word = bench_handle_words[ random_value & 0x0f ];
+
+			word_length = narrow_string_length(
+			               word );
+
+			if( word_length > ( buffer_size - buffer_offset ) )
+			{
+				word_length = buffer_size - buffer_offset;
+			}
+			if( memory_copy(
+			     &( buffer[ buffer_offset ] ),
+			     word,
+			     word_length ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy word to buffer.",
+				 function );
+
+				return( -1 );
+			}
+			buffer_offset += word_length;
+		}
+	}
+	else
+	{
+		while( buffer_offset < buffer_size )
+		{
+			random_value = bench_handle_get_random(
+			                &random_state );
+
+			buffer[ buffer_offset++ ] = (uint8_t) ( random_value & 0xff );
+
+			if( buffer_offset < buffer_size )
+			{
+				buffer[ buffer_offset++ ] = (uint8_t) ( ( random_value >> 8 ) & 0xff );
+			}
+			if( buffer_offset < buffer_size )
+			{
+				buffer[ buffer_offset++ ] = (uint8_t) ( ( random_value >> 16 ) & 0xff );
+			}
+			if( buffer_offset < buffer_size )
+			{
+				buffer[ buffer_offset++ ] = (uint8_t) ( random_value >> 24 );
+			}
+		}
+	}
+	return( 1 );
+}
+
+/* Appends a result
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_append_result(
+     bench_handle_t *bench_handle,
+     const char *name,
+     uint64_t number_of_bytes,
+     uint64_t number_of_operations,
+     uint64_t elapsed_time,
+     libcerror_error_t **error )
+{
+	bench_result_t *result = NULL;
+	static char *function  = "bench_handle_append_result";
+	size_t name_length     = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( bench_handle->number_of_results < 0 )
+	 || ( bench_handle->number_of_results >= BENCH_HANDLE_MAXIMUM_NUMBER_OF_RESULTS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid bench handle - number of results value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	name_length = narrow_string_length(
+	               name );
+
+	if( name_length >= BENCH_HANDLE_MAXIMUM_RESULT_NAME_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_LARGE,
+		 "%s: invalid name length value too large.",
+		 function );
+
+		return( -1 );
+	}
+	result = &( bench_handle->results[ bench_handle->number_of_results ] );
+
+	if( narrow_string_copy(
+	     result->name,
+	     name,
+	     name_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy name.",
+		 function );
+
+		return( -1 );
+	}
+	result->name[ name_length ] = 0;
+
+	result->number_of_bytes      = number_of_bytes;
+	result->number_of_operations = number_of_operations;
+	result->elapsed_time         = elapsed_time;
+
+	bench_handle->number_of_results += 1;
+
+	return( 1 );
+}
+
+/* Opens the synthetic image for reading
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_open_image(
+     bench_handle_t *bench_handle,
+     libewf_handle_t **handle,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_open_image";
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle->filenames == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid bench handle - missing filenames.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_initialize(
+	     handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     *handle,
+	     bench_handle->filenames,
+	     bench_handle->number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     *handle,
+	     bench_handle->filenames,
+	     bench_handle->number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *handle != NULL )
+	{
+		libewf_handle_free(
+		 handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the filename of the first segment file of the synthetic image
+ * The filename is created by appending the extension of the format to the target path
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_get_first_segment_filename(
+     bench_handle_t *bench_handle,
+     system_character_t **filename,
+     libcerror_error_t **error )
+{
+	const system_character_t *extension = NULL;
+	static char *function               = "bench_handle_get_first_segment_filename";
+	size_t extension_length             = 0;
+	size_t target_path_length           = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle->target_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid bench handle - missing target path.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	switch( bench_handle->ewf_format )
+	{
+		case LIBEWF_FORMAT_EWF:
+		case LIBEWF_FORMAT_EWFX:
+			extension = _SYSTEM_STRING( ".e01" );
+			break;
+
+		case LIBEWF_FORMAT_SMART:
+			extension = _SYSTEM_STRING( ".s01" );
+			break;
+
+		case LIBEWF_FORMAT_V2_ENCASE7:
+			extension = _SYSTEM_STRING( ".Ex01" );
+			break;
+
+		default:
+			extension = _SYSTEM_STRING( ".E01" );
+			break;
+	}
+	extension_length = system_string_length(
+	                    extension );
+
+	target_path_length = system_string_length(
+	                      bench_handle->target_path );
+
+	*filename = system_string_allocate(
+	             target_path_length + extension_length + 1 );
+
+	if( *filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     *filename,
+	     bench_handle->target_path,
+	     target_path_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy target path to filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     &( ( *filename )[ target_path_length ] ),
+	     extension,
+	     extension_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy extension to filename.",
+		 function );
+
+		goto on_error;
+	}
+	( *filename )[ target_path_length + extension_length ] = 0;
+
+	return( 1 );
+
+on_error:
+	if( *filename != NULL )
+	{
+		memory_free(
+		 *filename );
+
+		*filename = NULL;
+	}
+	return( -1 );
+}
+
+/* Writes the synthetic image and measures the write throughput
+ * Only the time spent in libewf is measured, not the time to generate the data
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_run_write(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error )
+{
+	system_character_t *filenames[ 1 ]    = { NULL };
+	system_character_t *segment_filename = NULL;
+	libewf_handle_t *handle              = NULL;
+	uint8_t *buffer                      = NULL;
+	static char *function                = "bench_handle_run_write";
+	size64_t remaining_size              = 0;
+	size_t chunk_size                    = 0;
+	size_t segment_filename_length       = 0;
+	size_t write_size                    = 0;
+	ssize_t write_count                  = 0;
+	uint64_t chunk_index                 = 0;
+	uint64_t elapsed_time                = 0;
+	uint64_t number_of_operations        = 0;
+	uint64_t start_time                  = 0;
+	uint64_t stop_time                   = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle->target_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid bench handle - missing target path.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle->filenames != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid bench handle - filenames value already set.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_size = (size_t) bench_handle->bytes_per_sector * bench_handle->sectors_per_chunk;
+
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * chunk_size );
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( compression_level_controller_get_current_time(
+	     &start_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start time.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_initialize(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+	filenames[ 0 ] = (system_character_t *) bench_handle->target_path;
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     handle,
+	     filenames,
+	     1,
+	     LIBEWF_OPEN_WRITE,
+	     error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     handle,
+	     filenames,
+	     1,
+	     LIBEWF_OPEN_WRITE,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_bytes_per_sector(
+	     handle,
+	     bench_handle->bytes_per_sector,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set bytes per sector.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_media_size(
+	     handle,
+	     bench_handle->media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set media size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_format(
+	     handle,
+	     bench_handle->ewf_format,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set format.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_compression_method(
+	     handle,
+	     bench_handle->compression_method,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set compression method.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_compression_values(
+	     handle,
+	     bench_handle->compression_level,
+	     bench_handle->compression_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set compression values.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_maximum_segment_size(
+	     handle,
+	     bench_handle->maximum_segment_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set maximum segment size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_sectors_per_chunk(
+	     handle,
+	     bench_handle->sectors_per_chunk,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set sectors per chunk.",
+		 function );
+
+		goto on_error;
+	}
+	if( compression_level_controller_get_current_time(
+	     &stop_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve stop time.",
+		 function );
+
+		goto on_error;
+	}
+	elapsed_time += stop_time - start_time;
+
+	remaining_size = bench_handle->media_size;
+
+	while( remaining_size > 0 )
+	{
+		if( bench_handle->abort != 0 )
+		{
+			break;
+		}
+		write_size = chunk_size;
+
+		if( (size64_t) write_size > remaining_size )
+		{
+			write_size = (size_t) remaining_size;
+		}
+		if( bench_handle_generate_chunk_data(
+		     bench_handle,
+		     chunk_index,
+		     buffer,
+		     write_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to generate chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		if( compression_level_controller_get_current_time(
+		     &start_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve start time.",
+			 function );
+
+			goto on_error;
+		}
+		write_count = libewf_handle_write_buffer(
+		               handle,
+		               buffer,
+		               write_size,
+		               error );
+
+		if( write_count != (ssize_t) write_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write chunk: %" PRIu64 ".",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		if( compression_level_controller_get_current_time(
+		     &stop_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve stop time.",
+			 function );
+
+			goto on_error;
+		}
+		elapsed_time += stop_time - start_time;
+
+		remaining_size -= write_size;
+
+		chunk_index++;
+		number_of_operations++;
+	}
+	if( compression_level_controller_get_current_time(
+	     &start_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start time.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = libewf_handle_write_finalize(
+	               handle,
+	               error );
+
+	if( write_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to finalize handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_close(
+	     handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( compression_level_controller_get_current_time(
+	     &stop_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve stop time.",
+		 function );
+
+		goto on_error;
+	}
+	elapsed_time += stop_time - start_time;
+
+	if( libewf_handle_free(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 buffer );
+
+	buffer = NULL;
+
+	if( bench_handle->abort != 0 )
+	{
+		return( 1 );
+	}
+	if( bench_handle_append_result(
+	     bench_handle,
+	     "write",
+	     (uint64_t) bench_handle->media_size,
+	     number_of_operations,
+	     elapsed_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append result.",
+		 function );
+
+		goto on_error;
+	}
+	if( bench_handle_get_first_segment_filename(
+	     bench_handle,
+	     &segment_filename,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve first segment filename.",
+		 function );
+
+		goto on_error;
+	}
+	segment_filename_length = system_string_length(
+	                           segment_filename );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_glob_wide(
+	     segment_filename,
+	     segment_filename_length,
+	     LIBEWF_FORMAT_UNKNOWN,
+	     &( bench_handle->filenames ),
+	     &( bench_handle->number_of_filenames ),
+	     error ) != 1 )
+#else
+	if( libewf_glob(
+	     segment_filename,
+	     segment_filename_length,
+	     LIBEWF_FORMAT_UNKNOWN,
+	     &( bench_handle->filenames ),
+	     &( bench_handle->number_of_filenames ),
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to resolve segment filenames.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 segment_filename );
+
+	return( 1 );
+
+on_error:
+	if( segment_filename != NULL )
+	{
+		memory_free(
+		 segment_filename );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	return( -1 );
+}
+
+/* Measures the latency of opening the synthetic image
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_run_open(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error )
+{
+	libewf_handle_t *handle = NULL;
+	static char *function   = "bench_handle_run_open";
+	uint64_t elapsed_time   = 0;
+	uint64_t start_time     = 0;
+	uint64_t stop_time      = 0;
+	int open_index          = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	for( open_index = 0;
+	     open_index < BENCH_HANDLE_NUMBER_OF_OPENS;
+	     open_index++ )
+	{
+		if( bench_handle->abort != 0 )
+		{
+			return( 1 );
+		}
+		if( compression_level_controller_get_current_time(
+		     &start_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve start time.",
+			 function );
+
+			goto on_error;
+		}
+		if( bench_handle_open_image(
+		     bench_handle,
+		     &handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open image.",
+			 function );
+
+			goto on_error;
+		}
+		if( compression_level_controller_get_current_time(
+		     &stop_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve stop time.",
+			 function );
+
+			goto on_error;
+		}
+		elapsed_time += stop_time - start_time;
+
+		if( libewf_handle_close(
+		     handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( libewf_handle_free(
+		     &handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( bench_handle_append_result(
+	     bench_handle,
+	     "open",
+	     0,
+	     BENCH_HANDLE_NUMBER_OF_OPENS,
+	     elapsed_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append result.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( handle != NULL )
+	{
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the part of the media data of a reader
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_reader_read(
+     bench_reader_t *reader,
+     libcerror_error_t **error )
+{
+	static char *function    = "bench_handle_reader_read";
+	size64_t number_of_blocks = 0;
+	size64_t remaining_size   = 0;
+	size_t read_size          = 0;
+	ssize_t read_count        = 0;
+	off64_t read_offset       = 0;
+	uint32_t read_index       = 0;
+
+	if( reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( reader->buffer == NULL )
+	 || ( reader->buffer_size == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid reader - missing buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( reader->number_of_random_reads == 0 )
+	{
+		read_offset    = reader->media_offset;
+		remaining_size = reader->media_size;
+
+		while( remaining_size > 0 )
+		{
+			if( *( reader->abort ) != 0 )
+			{
+				break;
+			}
+			read_size = reader->buffer_size;
+
+			if( (size64_t) read_size > remaining_size )
+			{
+				read_size = (size_t) remaining_size;
+			}
+			read_count = libewf_handle_read_buffer_at_offset(
+			              reader->handle,
+			              reader->buffer,
+			              read_size,
+			              read_offset,
+			              error );
+
+			if( read_count != (ssize_t) read_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 read_offset,
+				 read_offset );
+
+				return( -1 );
+			}
+			read_offset    += read_count;
+			remaining_size -= read_count;
+
+			reader->number_of_bytes += read_count;
+			reader->number_of_reads += 1;
+		}
+	}
+	else
+	{
+		number_of_blocks = reader->media_size / reader->buffer_size;
+
+		if( number_of_blocks == 0 )
+		{
+			number_of_blocks = 1;
+		}
+		for( read_index = 0;
+		     read_index < reader->number_of_random_reads;
+		     read_index++ )
+		{
+			if( *( reader->abort ) != 0 )
+			{
+				break;
+			}
+			read_offset = reader->media_offset
+			            + (off64_t) ( ( bench_handle_get_random( &( reader->random_state ) ) % number_of_blocks ) * reader->buffer_size );
+
+			read_size = reader->buffer_size;
+
+			if( (size64_t) read_size > ( reader->media_size - ( read_offset - reader->media_offset ) ) )
+			{
+				read_size = (size_t) ( reader->media_size - ( read_offset - reader->media_offset ) );
+			}
+			read_count = libewf_handle_read_buffer_at_offset(
+			              reader->handle,
+			              reader->buffer,
+			              read_size,
+			              read_offset,
+			              error );
+
+			if( read_count != (ssize_t) read_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 read_offset,
+				 read_offset );
+
+				return( -1 );
+			}
+			reader->number_of_bytes += read_count;
+			reader->number_of_reads += 1;
+		}
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The reader thread callback function
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_reader_thread_callback(
+     bench_reader_t *reader )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "bench_handle_reader_thread_callback";
+
+	if( reader == NULL )
+	{
+		return( -1 );
+	}
+	if( bench_handle_reader_read(
+	     reader,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to read.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	/* Make the other readers stop
+	 */
+	reader->has_failed = 1;
+	*( reader->abort ) = 1;
+
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Measures the sequential or random read throughput
+ * Every reader thread uses its own shared clone of the same handle, sequential
+ * readers read consecutive parts of the media data and random readers read
+ * chunk sized blocks at random offsets of the entire media data
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_run_read(
+     bench_handle_t *bench_handle,
+     uint8_t random_read,
+     int number_of_threads,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error )
+{
+	char name[ BENCH_HANDLE_MAXIMUM_RESULT_NAME_SIZE ];
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	libcthreads_thread_t **threads = NULL;
+#endif
+
+	bench_reader_t *readers        = NULL;
+	static char *function          = "bench_handle_run_read";
+	size64_t part_size             = 0;
+	size_t chunk_size              = 0;
+	uint64_t elapsed_time          = 0;
+	uint64_t number_of_bytes       = 0;
+	uint64_t number_of_operations  = 0;
+	uint64_t start_time            = 0;
+	uint64_t stop_time             = 0;
+	int has_failed                 = 0;
+	int print_count                = 0;
+	int reader_index               = 0;
+	int result                     = 1;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > EWFCOMMON_MAXIMUM_NUMBER_OF_THREADS ) )
+#else
+	if( number_of_threads != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_open_handles < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid maximum number of open handles value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	print_count = narrow_string_snprintf(
+	               name,
+	               BENCH_HANDLE_MAXIMUM_RESULT_NAME_SIZE,
+	               "%s:threads=%d:open_handles=%d",
+	               ( random_read != 0 ) ? "random_read" : "sequential_read",
+	               number_of_threads,
+	               maximum_number_of_open_handles );
+
+	if( ( print_count < 0 )
+	 || ( print_count >= BENCH_HANDLE_MAXIMUM_RESULT_NAME_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set name.",
+		 function );
+
+		return( -1 );
+	}
+	/* The open handles maximum is process-wide and shared by all readers
+	 */
+	if( libewf_set_maximum_number_of_open_handles(
+	     maximum_number_of_open_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set maximum number of open handles.",
+		 function );
+
+		return( -1 );
+	}
+	readers = (bench_reader_t *) memory_allocate(
+	                              sizeof( bench_reader_t ) * number_of_threads );
+
+	if( readers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create readers.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     readers,
+	     0,
+	     sizeof( bench_reader_t ) * number_of_threads ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear readers.",
+		 function );
+
+		memory_free(
+		 readers );
+
+		readers = NULL;
+
+		goto on_error;
+	}
+	chunk_size = (size_t) bench_handle->bytes_per_sector * bench_handle->sectors_per_chunk;
+
+	/* The parts of the sequential readers are chunk aligned
+	 */
+	part_size = ( bench_handle->media_size / number_of_threads / chunk_size ) * chunk_size;
+
+	for( reader_index = 0;
+	     reader_index < number_of_threads;
+	     reader_index++ )
+	{
+		if( reader_index == 0 )
+		{
+			if( bench_handle_open_image(
+			     bench_handle,
+			     &( readers[ reader_index ].handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to open image.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		else if( libewf_handle_clone_shared(
+		          &( readers[ reader_index ].handle ),
+		          readers[ 0 ].handle,
+		          0,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create shared clone: %d.",
+			 function,
+			 reader_index );
+
+			goto on_error;
+		}
+		readers[ reader_index ].buffer = (uint8_t *) memory_allocate(
+		                                              sizeof( uint8_t ) * chunk_size );
+
+		if( readers[ reader_index ].buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create buffer: %d.",
+			 function,
+			 reader_index );
+
+			goto on_error;
+		}
+		readers[ reader_index ].buffer_size = chunk_size;
+		readers[ reader_index ].abort       = &( bench_handle->abort );
+
+		if( random_read != 0 )
+		{
+			readers[ reader_index ].media_offset           = 0;
+			readers[ reader_index ].media_size             = bench_handle->media_size;
+			readers[ reader_index ].number_of_random_reads = bench_handle->number_of_random_reads / number_of_threads;
+			readers[ reader_index ].random_state           = bench_handle->seed + (uint32_t) reader_index;
+
+			if( reader_index < (int) ( bench_handle->number_of_random_reads % number_of_threads ) )
+			{
+				readers[ reader_index ].number_of_random_reads += 1;
+			}
+		}
+		else
+		{
+			readers[ reader_index ].media_offset = (off64_t) ( part_size * reader_index );
+			readers[ reader_index ].media_size   = part_size;
+
+			/* The last reader also reads the remainder of the media data
+			 */
+			if( reader_index == ( number_of_threads - 1 ) )
+			{
+				readers[ reader_index ].media_size = bench_handle->media_size - (size64_t) readers[ reader_index ].media_offset;
+			}
+		}
+	}
+	if( compression_level_controller_get_current_time(
+	     &start_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start time.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_threads == 1 )
+	{
+		if( bench_handle_reader_read(
+		     &( readers[ 0 ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to read.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	else
+	{
+		threads = (libcthreads_thread_t **) memory_allocate(
+		                                     sizeof( libcthreads_thread_t * ) * number_of_threads );
+
+		if( threads == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create threads.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     threads,
+		     0,
+		     sizeof( libcthreads_thread_t * ) * number_of_threads ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear threads.",
+			 function );
+
+			goto on_error;
+		}
+		for( reader_index = 0;
+		     reader_index < number_of_threads;
+		     reader_index++ )
+		{
+			if( libcthreads_thread_create(
+			     &( threads[ reader_index ] ),
+			     NULL,
+			     (int (*)(void *)) &bench_handle_reader_thread_callback,
+			     (void *) &( readers[ reader_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create thread: %d.",
+				 function,
+				 reader_index );
+
+				goto on_error;
+			}
+		}
+		for( reader_index = 0;
+		     reader_index < number_of_threads;
+		     reader_index++ )
+		{
+			if( libcthreads_thread_join(
+			     &( threads[ reader_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread: %d.",
+				 function,
+				 reader_index );
+
+				goto on_error;
+			}
+		}
+		memory_free(
+		 threads );
+
+		threads = NULL;
+	}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	if( compression_level_controller_get_current_time(
+	     &stop_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve stop time.",
+		 function );
+
+		goto on_error;
+	}
+	elapsed_time = stop_time - start_time;
+
+	for( reader_index = number_of_threads - 1;
+	     reader_index >= 0;
+	     reader_index-- )
+	{
+		if( readers[ reader_index ].has_failed != 0 )
+		{
+			has_failed = 1;
+		}
+		number_of_bytes      += readers[ reader_index ].number_of_bytes;
+		number_of_operations += readers[ reader_index ].number_of_reads;
+
+		memory_free(
+		 readers[ reader_index ].buffer );
+
+		readers[ reader_index ].buffer = NULL;
+
+		/* The shared clones are freed before the handle they were cloned from
+		 */
+		if( libewf_handle_close(
+		     readers[ reader_index ].handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close handle: %d.",
+			 function,
+			 reader_index );
+
+			goto on_error;
+		}
+		if( libewf_handle_free(
+		     &( readers[ reader_index ].handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free handle: %d.",
+			 function,
+			 reader_index );
+
+			goto on_error;
+		}
+	}
+	memory_free(
+	 readers );
+
+	readers = NULL;
+
+	if( has_failed != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to read.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_set_maximum_number_of_open_handles(
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to remove maximum number of open handles.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle->abort != 0 )
+	{
+		return( 1 );
+	}
+	if( bench_handle_append_result(
+	     bench_handle,
+	     name,
+	     number_of_bytes,
+	     number_of_operations,
+	     elapsed_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append result.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+
+on_error:
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( threads != NULL )
+	{
+		/* Stop and join the reader threads that were already started
+		 */
+		bench_handle->abort = 1;
+
+		for( reader_index = 0;
+		     reader_index < number_of_threads;
+		     reader_index++ )
+		{
+			if( threads[ reader_index ] != NULL )
+			{
+				libcthreads_thread_join(
+				 &( threads[ reader_index ] ),
+				 NULL );
+			}
+		}
+		memory_free(
+		 threads );
+	}
+#endif
+	if( readers != NULL )
+	{
+		for( reader_index = number_of_threads - 1;
+		     reader_index >= 0;
+		     reader_index-- )
+		{
+			if( readers[ reader_index ].buffer != NULL )
+			{
+				memory_free(
+				 readers[ reader_index ].buffer );
+			}
+			if( readers[ reader_index ].handle != NULL )
+			{
+				libewf_handle_free(
+				 &( readers[ reader_index ].handle ),
+				 NULL );
+			}
+		}
+		memory_free(
+		 readers );
+	}
+	libewf_set_maximum_number_of_open_handles(
+	 0,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Measures the verify throughput
+ * The media data is read and the MD5 and SHA1 digests are calculated
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_run_verify(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error )
+{
+	libewf_handle_t *handle = NULL;
+	static char *function   = "bench_handle_run_verify";
+	uint64_t start_time     = 0;
+	uint64_t stop_time      = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle_open_image(
+	     bench_handle,
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open image.",
+		 function );
+
+		goto on_error;
+	}
+	if( compression_level_controller_get_current_time(
+	     &start_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start time.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_read_digest_range(
+	     handle,
+	     0,
+	     bench_handle->media_size,
+	     LIBEWF_DIGEST_TYPE_MD5 | LIBEWF_DIGEST_TYPE_SHA1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to calculate digests.",
+		 function );
+
+		goto on_error;
+	}
+	if( compression_level_controller_get_current_time(
+	     &stop_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve stop time.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_close(
+	     handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( bench_handle_append_result(
+	     bench_handle,
+	     "verify",
+	     (uint64_t) bench_handle->media_size,
+	     1,
+	     stop_time - start_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append result.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( handle != NULL )
+	{
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Measures the export throughput
+ * The media data is read and written to a RAW file
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_run_export(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error )
+{
+	libcfile_file_t *target_file  = NULL;
+	libewf_handle_t *handle       = NULL;
+	uint8_t *buffer               = NULL;
+	static char *function         = "bench_handle_run_export";
+	size64_t remaining_size       = 0;
+	size_t chunk_size             = 0;
+	size_t read_size              = 0;
+	ssize_t read_count            = 0;
+	ssize_t write_count           = 0;
+	uint64_t number_of_operations = 0;
+	uint64_t start_time           = 0;
+	uint64_t stop_time            = 0;
+	int result                    = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle->export_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid bench handle - missing export filename.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_size = (size_t) bench_handle->bytes_per_sector * bench_handle->sectors_per_chunk;
+
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * chunk_size );
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( bench_handle_open_image(
+	     bench_handle,
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open image.",
+		 function );
+
+		goto on_error;
+	}
+	if( compression_level_controller_get_current_time(
+	     &start_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start time.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_initialize(
+	     &target_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create target file.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libcfile_file_open_wide(
+		  target_file,
+		  bench_handle->export_filename,
+		  LIBCFILE_OPEN_WRITE,
+		  error );
+#else
+	result = libcfile_file_open(
+		  target_file,
+		  bench_handle->export_filename,
+		  LIBCFILE_OPEN_WRITE,
+		  error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open target file.",
+		 function );
+
+		goto on_error;
+	}
+	bench_handle->export_file_created = 1;
+
+	remaining_size = bench_handle->media_size;
+
+	while( remaining_size > 0 )
+	{
+		if( bench_handle->abort != 0 )
+		{
+			break;
+		}
+		read_size = chunk_size;
+
+		if( (size64_t) read_size > remaining_size )
+		{
+			read_size = (size_t) remaining_size;
+		}
+		read_count = libewf_handle_read_buffer(
+		              handle,
+		              buffer,
+		              read_size,
+		              error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer.",
+			 function );
+
+			goto on_error;
+		}
+		write_count = libcfile_file_write_buffer(
+		               target_file,
+		               buffer,
+		               read_size,
+		               error );
+
+		if( write_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write buffer.",
+			 function );
+
+			goto on_error;
+		}
+		remaining_size -= read_size;
+
+		number_of_operations++;
+	}
+	if( libcfile_file_close(
+	     target_file,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close target file.",
+		 function );
+
+		goto on_error;
+	}
+	if( compression_level_controller_get_current_time(
+	     &stop_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve stop time.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_free(
+	     &target_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free target file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_close(
+	     handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 buffer );
+
+	buffer = NULL;
+
+	if( bench_handle->abort != 0 )
+	{
+		return( 1 );
+	}
+	if( bench_handle_append_result(
+	     bench_handle,
+	     "export",
+	     (uint64_t) bench_handle->media_size,
+	     number_of_operations,
+	     stop_time - start_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append result.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( target_file != NULL )
+	{
+		libcfile_file_free(
+		 &target_file,
+		 NULL );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	return( -1 );
+}
+
+/* Runs the benchmarks
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_run(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_run";
+	int open_handles_index = 0;
+	int threads_index      = 0;
+	uint8_t random_read    = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle_run_write(
+	     bench_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to run write benchmark.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle->abort != 0 )
+	{
+		return( 1 );
+	}
+	if( bench_handle_run_open(
+	     bench_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to run open benchmark.",
+		 function );
+
+		return( -1 );
+	}
+	for( random_read = 0;
+	     random_read < 2;
+	     random_read++ )
+	{
+		for( threads_index = 0;
+		     threads_index < bench_handle->number_of_threads_values;
+		     threads_index++ )
+		{
+			for( open_handles_index = 0;
+			     open_handles_index < bench_handle->number_of_open_handles_values;
+			     open_handles_index++ )
+			{
+				if( bench_handle->abort != 0 )
+				{
+					return( 1 );
+				}
+				if( bench_handle_run_read(
+				     bench_handle,
+				     random_read,
+				     bench_handle->number_of_threads[ threads_index ],
+				     bench_handle->maximum_number_of_open_handles[ open_handles_index ],
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GENERIC,
+					 "%s: unable to run read benchmark.",
+					 function );
+
+					return( -1 );
+				}
+			}
+		}
+	}
+	if( bench_handle->abort != 0 )
+	{
+		return( 1 );
+	}
+	if( bench_handle_run_verify(
+	     bench_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to run verify benchmark.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle->abort != 0 )
+	{
+		return( 1 );
+	}
+	if( bench_handle_run_export(
+	     bench_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to run export benchmark.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Removes the segment files and the RAW export file
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_remove_files(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_remove_files";
+	int filename_index    = 0;
+	int result            = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	for( filename_index = 0;
+	     filename_index < bench_handle->number_of_filenames;
+	     filename_index++ )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libcfile_file_remove_wide(
+			  bench_handle->filenames[ filename_index ],
+			  error );
+#else
+		result = libcfile_file_remove(
+			  bench_handle->filenames[ filename_index ],
+			  error );
+#endif
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_UNLINK_FAILED,
+			 "%s: unable to remove segment file: %d.",
+			 function,
+			 filename_index );
+
+			return( -1 );
+		}
+	}
+	/* The filenames are freed so that the segment files are removed only once
+	 */
+	if( bench_handle->filenames != NULL )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libewf_glob_wide_free(
+		     bench_handle->filenames,
+		     bench_handle->number_of_filenames,
+		     error ) != 1 )
+#else
+		if( libewf_glob_free(
+		     bench_handle->filenames,
+		     bench_handle->number_of_filenames,
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free glob.",
+			 function );
+
+			return( -1 );
+		}
+		bench_handle->filenames           = NULL;
+		bench_handle->number_of_filenames = 0;
+	}
+	if( bench_handle->export_file_created != 0 )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libcfile_file_remove_wide(
+			  bench_handle->export_filename,
+			  error );
+#else
+		result = libcfile_file_remove(
+			  bench_handle->export_filename,
+			  error );
+#endif
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_UNLINK_FAILED,
+			 "%s: unable to remove export file.",
+			 function );
+
+			return( -1 );
+		}
+		bench_handle->export_file_created = 0;
+	}
+	return( 1 );
+}
+
+/* Determines the rate per second of a value measured over an elapsed time in nano seconds
+ * Returns the rate or 0 if the elapsed time is 0
+ */
+uint64_t bench_handle_get_rate(
+          uint64_t value,
+          uint64_t elapsed_time )
+{
+	if( elapsed_time == 0 )
+	{
+		return( 0 );
+	}
+	if( value <= ( UINT64_MAX / 1000000000UL ) )
+	{
+		return( ( value * 1000000000UL ) / elapsed_time );
+	}
+	/* Prevent an overflow for large values at the cost of precision
+	 */
+	if( elapsed_time < 1000000000UL )
+	{
+		return( value / ( elapsed_time / 1000000UL + 1 ) * 1000 );
+	}
+	return( value / ( elapsed_time / 1000000000UL ) );
+}
+
+/* Prints the configuration and results as JSON
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_results_fprint(
+     bench_handle_t *bench_handle,
+     FILE *stream,
+     libcerror_error_t **error )
+{
+	bench_result_t *result = NULL;
+	static char *function  = "bench_handle_results_fprint";
+	int result_index       = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	fprintf(
+	 stream,
+	 "{\n" );
+
+	fprintf(
+	 stream,
+	 "\t\"configuration\": {\n" );
+
+	fprintf(
+	 stream,
+	 "\t\t\"format\": %" PRIu8 ",\n",
+	 bench_handle->ewf_format );
+
+	fprintf(
+	 stream,
+	 "\t\t\"compression_method\": %" PRIu16 ",\n",
+	 bench_handle->compression_method );
+
+	fprintf(
+	 stream,
+	 "\t\t\"compression_level\": %" PRIi8 ",\n",
+	 bench_handle->compression_level );
+
+	fprintf(
+	 stream,
+	 "\t\t\"bytes_per_sector\": %" PRIu32 ",\n",
+	 bench_handle->bytes_per_sector );
+
+	fprintf(
+	 stream,
+	 "\t\t\"sectors_per_chunk\": %" PRIu32 ",\n",
+	 bench_handle->sectors_per_chunk );
+
+	fprintf(
+	 stream,
+	 "\t\t\"maximum_segment_size\": %" PRIu64 ",\n",
+	 bench_handle->maximum_segment_size );
+
+	fprintf(
+	 stream,
+	 "\t\t\"media_size\": %" PRIu64 ",\n",
+	 bench_handle->media_size );
+
+	fprintf(
+	 stream,
+	 "\t\t\"number_of_segment_files\": %d,\n",
+	 bench_handle->number_of_filenames );
+
+	fprintf(
+	 stream,
+	 "\t\t\"zero_percentage\": %" PRIu8 ",\n",
+	 bench_handle->zero_percentage );
+
+	fprintf(
+	 stream,
+	 "\t\t\"text_percentage\": %" PRIu8 ",\n",
+	 bench_handle->text_percentage );
+
+	fprintf(
+	 stream,
+	 "\t\t\"random_percentage\": %d,\n",
+	 100 - bench_handle->zero_percentage - bench_handle->text_percentage );
+
+	fprintf(
+	 stream,
+	 "\t\t\"seed\": %" PRIu32 "\n",
+	 bench_handle->seed );
+
+	fprintf(
+	 stream,
+	 "\t},\n" );
+
+	fprintf(
+	 stream,
+	 "\t\"results\": {\n" );
+
+	for( result_index = 0;
+	     result_index < bench_handle->number_of_results;
+	     result_index++ )
+	{
+		result = &( bench_handle->results[ result_index ] );
+
+		fprintf(
+		 stream,
+		 "\t\t\"%s\": { \"bytes\": %" PRIu64 ", \"operations\": %" PRIu64 ", \"elapsed_time\": %" PRIu64 ", \"bytes_per_second\": %" PRIu64 ", \"operations_per_second\": %" PRIu64 " }%s\n",
+		 result->name,
+		 result->number_of_bytes,
+		 result->number_of_operations,
+		 result->elapsed_time,
+		 bench_handle_get_rate(
+		  result->number_of_bytes,
+		  result->elapsed_time ),
+		 bench_handle_get_rate(
+		  result->number_of_operations,
+		  result->elapsed_time ),
+		 ( result_index < ( bench_handle->number_of_results - 1 ) ) ? "," : "" );
+	}
+	fprintf(
+	 stream,
+	 "\t}\n" );
+
+	fprintf(
+	 stream,
+	 "}\n" );
+
+	return( 1 );
+}
+
+/* Compares the results with the results in a baseline file
+ * The baseline file contains the JSON output of a previous run, a result is
+ * considered a regression if its rate is more than tolerance percent below
+ * the baseline rate. The bytes per second are compared for results that
+ * process data and the operations per second for the other results.
+ * Results that are not in the baseline file are ignored.
+ * Returns 1 if no regressions were found, 0 if regressions were found or -1 on error
+ */
+int bench_handle_compare_baseline(
+     bench_handle_t *bench_handle,
+     const system_character_t *filename,
+     int tolerance,
+     libcerror_error_t **error )
+{
+	char key[ BENCH_HANDLE_MAXIMUM_RESULT_NAME_SIZE + 4 ];
+
+	bench_result_t *result     = NULL;
+	libcfile_file_t *file      = NULL;
+	char *baseline_data        = NULL;
+	char *key_string           = NULL;
+	char *rate_key             = NULL;
+	char *rate_string          = NULL;
+	static char *function      = "bench_handle_compare_baseline";
+	size64_t file_size         = 0;
+	size_t rate_key_length     = 0;
+	ssize_t read_count         = 0;
+	uint64_t baseline_rate     = 0;
+	uint64_t rate              = 0;
+	int print_count            = 0;
+	int result_index           = 0;
+	int return_value           = 1;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( tolerance < 0 )
+	 || ( tolerance > 100 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid tolerance value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcfile_file_initialize(
+	     &file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create baseline file.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcfile_file_open_wide(
+	     file,
+	     filename,
+	     LIBCFILE_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libcfile_file_open(
+	     file,
+	     filename,
+	     LIBCFILE_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open baseline file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_get_size(
+	     file,
+	     &file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve baseline file size.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( file_size == 0 )
+	 || ( file_size > (size64_t) ( SSIZE_MAX - 1 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid baseline file size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	baseline_data = narrow_string_allocate(
+	                 (size_t) file_size + 1 );
+
+	if( baseline_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create baseline data.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libcfile_file_read_buffer(
+	              file,
+	              (uint8_t *) baseline_data,
+	              (size_t) file_size,
+	              error );
+
+	if( read_count != (ssize_t) file_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read baseline data.",
+		 function );
+
+		goto on_error;
+	}
+	baseline_data[ file_size ] = 0;
+
+	if( libcfile_file_close(
+	     file,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close baseline file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_free(
+	     &file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free baseline file.",
+		 function );
+
+		goto on_error;
+	}
+	for( result_index = 0;
+	     result_index < bench_handle->number_of_results;
+	     result_index++ )
+	{
+		result = &( bench_handle->results[ result_index ] );
+
+		if( result->number_of_bytes > 0 )
+		{
+			rate_key = "\"bytes_per_second\":";
+			rate     = bench_handle_get_rate(
+			            result->number_of_bytes,
+			            result->elapsed_time );
+		}
+		else
+		{
+			rate_key = "\"operations_per_second\":";
+			rate     = bench_handle_get_rate(
+			            result->number_of_operations,
+			            result->elapsed_time );
+		}
+		print_count = narrow_string_snprintf(
+		               key,
+		               BENCH_HANDLE_MAXIMUM_RESULT_NAME_SIZE + 4,
+		               "\"%s\":",
+		               result->name );
+
+		if( ( print_count < 0 )
+		 || ( print_count >= ( BENCH_HANDLE_MAXIMUM_RESULT_NAME_SIZE + 4 ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set key.",
+			 function );
+
+			goto on_error;
+		}
+		key_string = narrow_string_search_string(
+		              baseline_data,
+		              key,
+		              (size_t) file_size );
+
+		if( key_string == NULL )
+		{
+			continue;
+		}
+		rate_key_length = narrow_string_length(
+		                   rate_key );
+
+		rate_string = narrow_string_search_string(
+		               key_string,
+		               rate_key,
+		               narrow_string_length( key_string ) );
+
+		if( rate_string == NULL )
+		{
+			continue;
+		}
+		rate_string += rate_key_length;
+
+		while( *rate_string == ' ' )
+		{
+			rate_string++;
+		}
+		baseline_rate = 0;
+
+		while( ( *rate_string >= '0' )
+		    && ( *rate_string <= '9' ) )
+		{
+			if( baseline_rate > ( ( UINT64_MAX - 9 ) / 10 ) )
+			{
+				break;
+			}
+			baseline_rate *= 10;
+			baseline_rate += (uint64_t) ( *rate_string - '0' );
+
+			rate_string++;
+		}
+		if( ( baseline_rate > ( UINT64_MAX / 100 ) )
+		 || ( rate > ( UINT64_MAX / 100 ) ) )
+		{
+			continue;
+		}
+		if( ( rate * 100 ) < ( baseline_rate * (uint64_t) ( 100 - tolerance ) ) )
+		{
+			if( bench_handle->notify_stream != NULL )
+			{
+				fprintf(
+				 bench_handle->notify_stream,
+				 "Regression in %s: %" PRIu64 " per second, baseline: %" PRIu64 " per second.\n",
+				 result->name,
+				 rate,
+				 baseline_rate );
+			}
+			return_value = 0;
+		}
+	}
+	memory_free(
+	 baseline_data );
+
+	return( return_value );
+
+on_error:
+	if( baseline_data != NULL )
+	{
+		memory_free(
+		 baseline_data );
+	}
+	if( file != NULL )
+	{
+		libcfile_file_free(
+		 &file,
+		 NULL );
+	}
+	return( -1 );
+}
+
@@ -0,0 +1,386 @@
+/*
+ * Bench handle
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _BENCH_HANDLE_H )
+#define _BENCH_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libewf.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#define BENCH_HANDLE_MAXIMUM_NUMBER_OF_VALUES		8
+#define BENCH_HANDLE_MAXIMUM_NUMBER_OF_RESULTS		64
+#define BENCH_HANDLE_MAXIMUM_RESULT_NAME_SIZE		64
+
+#define BENCH_HANDLE_NUMBER_OF_OPENS			8
+
+typedef struct bench_result bench_result_t;
+
+struct bench_result
+{
+	/* The name
+	 */
+	char name[ BENCH_HANDLE_MAXIMUM_RESULT_NAME_SIZE ];
+
+	/* The number of bytes processed
+	 */
+	uint64_t number_of_bytes;
+
+	/* The number of operations
+	 */
+	uint64_t number_of_operations;
+
+	/* The elapsed time in nano seconds
+	 */
+	uint64_t elapsed_time;
+};
+
+typedef struct bench_reader bench_reader_t;
+
+/* The bench reader reads a part of the media data with its own libewf handle
+ */
+struct bench_reader
+{
+	/* The (libewf) handle
+	 */
+	libewf_handle_t *handle;
+
+	/* The media offset of the part to read
+	 */
+	off64_t media_offset;
+
+	/* The size of the part to read
+	 */
+	size64_t media_size;
+
+	/* The number of random reads, 0 represents a sequential read
+	 */
+	uint32_t number_of_random_reads;
+
+	/* The random number generator state
+	 */
+	uint32_t random_state;
+
+	/* The buffer
+	 */
+	uint8_t *buffer;
+
+	/* The buffer size
+	 */
+	size_t buffer_size;
+
+	/* The number of bytes read
+	 */
+	uint64_t number_of_bytes;
+
+	/* The number of reads
+	 */
+	uint64_t number_of_reads;
+
+	/* The value to indicate the reader failed
+	 */
+	int has_failed;
+
+	/* The value to indicate the reader should abort
+	 */
+	int *abort;
+};
+
+typedef struct bench_handle bench_handle_t;
+
+struct bench_handle
+{
+	/* The target (image base) path
+	 */
+	const system_character_t *target_path;
+
+	/* The export (RAW) filename
+	 */
+	system_character_t *export_filename;
+
+	/* The value to indicate the export file was created
+	 */
+	uint8_t export_file_created;
+
+	/* The EWF format
+	 */
+	uint8_t ewf_format;
+
+	/* The compression method
+	 */
+	uint16_t compression_method;
+
+	/* The compression level
+	 */
+	int8_t compression_level;
+
+	/* The compression flags
+	 */
+	uint8_t compression_flags;
+
+	/* The number of bytes per sector
+	 */
+	uint32_t bytes_per_sector;
+
+	/* The number of sectors per chunk
+	 */
+	uint32_t sectors_per_chunk;
+
+	/* The maximum segment size
+	 */
+	size64_t maximum_segment_size;
+
+	/* The media size
+	 */
+	size64_t media_size;
+
+	/* The percentage of chunks that contain zero bytes
+	 */
+	uint8_t zero_percentage;
+
+	/* The percentage of chunks that contain text
+	 * the remainder of the chunks contains random data
+	 */
+	uint8_t text_percentage;
+
+	/* The random number generator seed
+	 */
+	uint32_t seed;
+
+	/* The number of random reads
+	 */
+	uint32_t number_of_random_reads;
+
+	/* The number of threads values
+	 */
+	int number_of_threads[ BENCH_HANDLE_MAXIMUM_NUMBER_OF_VALUES ];
+
+	/* The number of number of threads values
+	 */
+	int number_of_threads_values;
+
+	/* The maximum number of open handles values, 0 represents no maximum
+	 */
+	int maximum_number_of_open_handles[ BENCH_HANDLE_MAXIMUM_NUMBER_OF_VALUES ];
+
+	/* The number of maximum number of open handles values
+	 */
+	int number_of_open_handles_values;
+
+	/* The results
+	 */
+	bench_result_t results[ BENCH_HANDLE_MAXIMUM_NUMBER_OF_RESULTS ];
+
+	/* The number of results
+	 */
+	int number_of_results;
+
+	/* The segment filenames of the synthetic image
+	 */
+	system_character_t **filenames;
+
+	/* The number of segment filenames
+	 */
+	int number_of_filenames;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* The value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int bench_handle_initialize(
+     bench_handle_t **bench_handle,
+     libcerror_error_t **error );
+
+int bench_handle_free(
+     bench_handle_t **bench_handle,
+     libcerror_error_t **error );
+
+int bench_handle_signal_abort(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error );
+
+int bench_handle_set_target_path(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_set_format(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_set_compression_values(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_set_sectors_per_chunk(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_set_maximum_segment_size(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_set_media_size(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_set_entropy_mix(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_set_number_of_random_reads(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_set_seed(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_set_number_of_threads(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_set_maximum_number_of_open_handles(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_parse_values(
+     const system_character_t *string,
+     system_character_t separator,
+     int *values,
+     int maximum_number_of_values,
+     int *number_of_values,
+     libcerror_error_t **error );
+
+uint32_t bench_handle_get_random(
+          uint32_t *random_state );
+
+int bench_handle_generate_chunk_data(
+     bench_handle_t *bench_handle,
+     uint64_t chunk_index,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int bench_handle_append_result(
+     bench_handle_t *bench_handle,
+     const char *name,
+     uint64_t number_of_bytes,
+     uint64_t number_of_operations,
+     uint64_t elapsed_time,
+     libcerror_error_t **error );
+
+int bench_handle_open_image(
+     bench_handle_t *bench_handle,
+     libewf_handle_t **handle,
+     libcerror_error_t **error );
+
+int bench_handle_get_first_segment_filename(
+     bench_handle_t *bench_handle,
+     system_character_t **filename,
+     libcerror_error_t **error );
+
+int bench_handle_run_write(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error );
+
+int bench_handle_run_open(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error );
+
+int bench_handle_reader_read(
+     bench_reader_t *reader,
+     libcerror_error_t **error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int bench_handle_reader_thread_callback(
+     bench_reader_t *reader );
+
+#endif
+
+int bench_handle_run_read(
+     bench_handle_t *bench_handle,
+     uint8_t random_read,
+     int number_of_threads,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error );
+
+int bench_handle_run_verify(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error );
+
+int bench_handle_run_export(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error );
+
+int bench_handle_run(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error );
+
+int bench_handle_remove_files(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error );
+
+uint64_t bench_handle_get_rate(
+          uint64_t value,
+          uint64_t elapsed_time );
+
+int bench_handle_results_fprint(
+     bench_handle_t *bench_handle,
+     FILE *stream,
+     libcerror_error_t **error );
+
+int bench_handle_compare_baseline(
+     bench_handle_t *bench_handle,
+     const system_character_t *filename,
+     int tolerance,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _BENCH_HANDLE_H ) */
+
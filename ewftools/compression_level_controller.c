@@ -0,0 +1,693 @@
+/*
+ * Adaptive compression level controller
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( TIME_WITH_SYS_TIME )
+#include <sys/time.h>
+#include <time.h>
+#elif defined( HAVE_SYS_TIME_H )
+#include <sys/time.h>
+#else
+#include <time.h>
+#endif
+
+#include "compression_level_controller.h"
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libewf.h"
+
+/* The compression levels ordered from cheapest to most expensive
+ */
+static int8_t compression_level_controller_levels[ COMPRESSION_LEVEL_CONTROLLER_NUMBER_OF_LEVELS ] = {
+	LIBEWF_COMPRESSION_NONE,
+	LIBEWF_COMPRESSION_FAST,
+	LIBEWF_COMPRESSION_DEFAULT,
+	LIBEWF_COMPRESSION_BEST };
+
+static const char *compression_level_controller_level_names[ COMPRESSION_LEVEL_CONTROLLER_NUMBER_OF_LEVELS ] = {
+	"none",
+	"fast",
+	"default",
+	"best" };
+
+/* Retrieves the level index of a specific compression level
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int compression_level_controller_get_level_index(
+     int8_t compression_level,
+     int *level_index,
+     libcerror_error_t **error )
+{
+	static char *function = "compression_level_controller_get_level_index";
+	int index             = 0;
+
+	if( level_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid level index.",
+		 function );
+
+		return( -1 );
+	}
+	for( index = 0;
+	     index < COMPRESSION_LEVEL_CONTROLLER_NUMBER_OF_LEVELS;
+	     index++ )
+	{
+		if( compression_level_controller_levels[ index ] == compression_level )
+		{
+			*level_index = index;
+
+			return( 1 );
+		}
+	}
+	return( 0 );
+}
+
+/* Creates a compression level controller
+ * Make sure the value controller is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int compression_level_controller_initialize(
+     compression_level_controller_t **controller,
+     int8_t minimum_compression_level,
+     int8_t maximum_compression_level,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function   = "compression_level_controller_initialize";
+	int maximum_level_index = 0;
+	int minimum_level_index = 0;
+
+	if( controller == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid controller.",
+		 function );
+
+		return( -1 );
+	}
+	if( *controller != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid controller value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_level_controller_get_level_index(
+	     minimum_compression_level,
+	     &minimum_level_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported minimum compression level.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_level_controller_get_level_index(
+	     maximum_compression_level,
+	     &maximum_level_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported maximum compression level.",
+		 function );
+
+		return( -1 );
+	}
+	if( minimum_level_index > maximum_level_index )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: minimum compression level exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_threads < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of threads value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	*controller = memory_allocate_structure(
+	               compression_level_controller_t );
+
+	if( *controller == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create controller.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *controller,
+	     0,
+	     sizeof( compression_level_controller_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear controller.",
+		 function );
+
+		memory_free(
+		 *controller );
+
+		*controller = NULL;
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *controller )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( compression_level_controller_get_current_time(
+	     &( ( *controller )->window_start_time ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time.",
+		 function );
+
+		goto on_error;
+	}
+	/* Without a process thread pool the data is compressed by the main thread
+	 */
+	if( number_of_threads == 0 )
+	{
+		number_of_threads = 1;
+	}
+	( *controller )->minimum_level_index = minimum_level_index;
+	( *controller )->maximum_level_index = maximum_level_index;
+	( *controller )->current_level_index = maximum_level_index;
+	( *controller )->number_of_threads   = number_of_threads;
+
+	return( 1 );
+
+on_error:
+	if( *controller != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *controller )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *controller )->mutex ),
+			 NULL );
+		}
+#endif
+		memory_free(
+		 *controller );
+
+		*controller = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a compression level controller
+ * Returns 1 if successful or -1 on error
+ */
+int compression_level_controller_free(
+     compression_level_controller_t **controller,
+     libcerror_error_t **error )
+{
+	static char *function = "compression_level_controller_free";
+	int result            = 1;
+
+	if( controller == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid controller.",
+		 function );
+
+		return( -1 );
+	}
+	if( *controller != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *controller )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *controller );
+
+		*controller = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves the current time of a monotonic clock in nano seconds
+ * Returns 1 if successful or -1 on error
+ */
+int compression_level_controller_get_current_time(
+     uint64_t *current_time,
+     libcerror_error_t **error )
+{
+#if defined( WINAPI )
+	LARGE_INTEGER counter;
+	LARGE_INTEGER frequency;
+
+#elif defined( HAVE_CLOCK_GETTIME ) && defined( CLOCK_MONOTONIC )
+	struct timespec time_value;
+
+#elif defined( HAVE_GETTIMEOFDAY )
+	struct timeval time_value;
+
+#else
+	time_t time_value     = 0;
+#endif
+	static char *function = "compression_level_controller_get_current_time";
+
+	if( current_time == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid current time.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI )
+	if( ( QueryPerformanceFrequency(
+	       &frequency ) == 0 )
+	 || ( QueryPerformanceCounter(
+	       &counter ) == 0 )
+	 || ( frequency.QuadPart <= 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve performance counter.",
+		 function );
+
+		return( -1 );
+	}
+	*current_time = ( (uint64_t) ( counter.QuadPart / frequency.QuadPart ) * 1000000000UL )
+	              + ( ( (uint64_t) ( counter.QuadPart % frequency.QuadPart ) * 1000000000UL ) / (uint64_t) frequency.QuadPart );
+
+#elif defined( HAVE_CLOCK_GETTIME ) && defined( CLOCK_MONOTONIC )
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_value ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve monotonic clock time.",
+		 function );
+
+		return( -1 );
+	}
+	*current_time = ( (uint64_t) time_value.tv_sec * 1000000000UL ) + (uint64_t) time_value.tv_nsec;
+
+#elif defined( HAVE_GETTIMEOFDAY )
+	if( gettimeofday(
+	     &time_value,
+	     NULL ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve time of day.",
+		 function );
+
+		return( -1 );
+	}
+	*current_time = ( (uint64_t) time_value.tv_sec * 1000000000UL ) + ( (uint64_t) time_value.tv_usec * 1000UL );
+
+#else
+	time_value = time(
+	              NULL );
+
+	if( time_value == (time_t) -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve time.",
+		 function );
+
+		return( -1 );
+	}
+	*current_time = (uint64_t) time_value * 1000000000UL;
+#endif
+	return( 1 );
+}
+
+/* Retrieves the compression level to use for the next chunk
+ * Returns 1 if successful or -1 on error
+ */
+int compression_level_controller_get_compression_level(
+     compression_level_controller_t *controller,
+     int8_t *compression_level,
+     libcerror_error_t **error )
+{
+	static char *function = "compression_level_controller_get_compression_level";
+
+	if( controller == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid controller.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_level == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression level.",
+		 function );
+
+		return( -1 );
+	}
+	/* A stale read of the current level index is harmless
+	 * it only delays the level change by a chunk
+	 */
+	*compression_level = compression_level_controller_levels[ controller->current_level_index ];
+
+	return( 1 );
+}
+
+/* Updates the controller with the time a chunk took to compress
+ * At the end of every measurement window the utilization of the compression threads
+ * is determined. If the compression threads cannot keep up with the input a cheaper
+ * compression level is chosen. If the projected utilization at the next more expensive
+ * compression level leaves enough headroom that level is chosen.
+ * Returns 1 if successful or -1 on error
+ */
+int compression_level_controller_update(
+     compression_level_controller_t *controller,
+     int8_t compression_level,
+     size_t data_size,
+     uint64_t busy_time,
+     libcerror_error_t **error )
+{
+	static char *function          = "compression_level_controller_update";
+	uint64_t current_time          = 0;
+	uint64_t window_duration       = 0;
+	double projected_utilization   = 0.0;
+	double utilization             = 0.0;
+	int level_index                = 0;
+	int next_level_index           = 0;
+
+	if( controller == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid controller.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_level_controller_get_level_index(
+	     compression_level,
+	     &level_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported compression level.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_level_controller_get_current_time(
+	     &current_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     controller->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	controller->number_of_chunks[ level_index ] += 1;
+	controller->number_of_bytes[ level_index ]  += data_size;
+	controller->busy_time[ level_index ]        += busy_time;
+
+	/* Halve the per level statistics once they grow large so that
+	 * the throughput estimate follows changes in the input data
+	 */
+	if( controller->number_of_bytes[ level_index ] > (uint64_t) 1024 * 1024 * 1024 )
+	{
+		controller->number_of_bytes[ level_index ] /= 2;
+		controller->busy_time[ level_index ]       /= 2;
+	}
+	controller->window_busy_time        += busy_time;
+	controller->window_number_of_chunks += 1;
+
+	if( current_time > controller->window_start_time )
+	{
+		window_duration = current_time - controller->window_start_time;
+	}
+	if( ( window_duration >= COMPRESSION_LEVEL_CONTROLLER_WINDOW_DURATION )
+	 && ( controller->window_number_of_chunks >= (uint64_t) controller->number_of_threads ) )
+	{
+		utilization = ( 100.0 * (double) controller->window_busy_time )
+		            / ( (double) window_duration * (double) controller->number_of_threads );
+
+		if( utilization > (double) COMPRESSION_LEVEL_CONTROLLER_HIGH_UTILIZATION )
+		{
+			if( controller->current_level_index > controller->minimum_level_index )
+			{
+				controller->current_level_index -= 1;
+				controller->number_of_level_changes += 1;
+			}
+		}
+		else if( controller->current_level_index < controller->maximum_level_index )
+		{
+			level_index      = controller->current_level_index;
+			next_level_index = level_index + 1;
+
+			/* Scale the utilization by the ratio of the time per byte of the levels
+			 * if both have been measured, otherwise assume the next level costs twice as much
+			 */
+			if( ( controller->number_of_bytes[ level_index ] > 0 )
+			 && ( controller->busy_time[ level_index ] > 0 )
+			 && ( controller->number_of_bytes[ next_level_index ] > 0 ) )
+			{
+				projected_utilization = utilization
+				                      * ( (double) controller->busy_time[ next_level_index ] / (double) controller->number_of_bytes[ next_level_index ] )
+				                      / ( (double) controller->busy_time[ level_index ] / (double) controller->number_of_bytes[ level_index ] );
+			}
+			else
+			{
+				projected_utilization = utilization * 2.0;
+			}
+			if( projected_utilization < (double) COMPRESSION_LEVEL_CONTROLLER_LOW_UTILIZATION )
+			{
+				controller->current_level_index += 1;
+				controller->number_of_level_changes += 1;
+			}
+		}
+		controller->window_start_time       = current_time;
+		controller->window_busy_time        = 0;
+		controller->window_number_of_chunks = 0;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     controller->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Prints the distribution of the chosen compression levels
+ * Returns 1 if successful or -1 on error
+ */
+int compression_level_controller_fprint(
+     compression_level_controller_t *controller,
+     FILE *stream,
+     libcerror_error_t **error )
+{
+	static char *function     = "compression_level_controller_fprint";
+	uint64_t number_of_chunks = 0;
+	int level_index           = 0;
+
+	if( controller == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid controller.",
+		 function );
+
+		return( -1 );
+	}
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	for( level_index = controller->minimum_level_index;
+	     level_index <= controller->maximum_level_index;
+	     level_index++ )
+	{
+		number_of_chunks += controller->number_of_chunks[ level_index ];
+	}
+	fprintf(
+	 stream,
+	 "Adaptive compression levels:\n" );
+
+	for( level_index = controller->minimum_level_index;
+	     level_index <= controller->maximum_level_index;
+	     level_index++ )
+	{
+		fprintf(
+		 stream,
+		 "\t%s:\t%" PRIu64 " chunks",
+		 compression_level_controller_level_names[ level_index ],
+		 controller->number_of_chunks[ level_index ] );
+
+		if( number_of_chunks > 0 )
+		{
+			fprintf(
+			 stream,
+			 " (%" PRIu64 "%%)",
+			 ( controller->number_of_chunks[ level_index ] * 100 ) / number_of_chunks );
+		}
+		fprintf(
+		 stream,
+		 "\n" );
+	}
+	fprintf(
+	 stream,
+	 "\tlevel changes:\t%" PRIu64 "\n",
+	 controller->number_of_level_changes );
+
+	fprintf(
+	 stream,
+	 "\n" );
+
+	return( 1 );
+}
+
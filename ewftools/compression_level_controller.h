@@ -0,0 +1,152 @@
+/*
+ * Adaptive compression level controller
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _COMPRESSION_LEVEL_CONTROLLER_H )
+#define _COMPRESSION_LEVEL_CONTROLLER_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The compression levels the controller can choose from,
+ * ordered from cheapest to most expensive
+ */
+#define COMPRESSION_LEVEL_CONTROLLER_NUMBER_OF_LEVELS		4
+
+/* The minimum duration of a measurement window in nano seconds
+ */
+#define COMPRESSION_LEVEL_CONTROLLER_WINDOW_DURATION		250000000UL
+
+/* The utilization (in percent) of the compression threads above which
+ * the controller chooses a cheaper compression level
+ */
+#define COMPRESSION_LEVEL_CONTROLLER_HIGH_UTILIZATION		90
+
+/* The projected utilization (in percent) of the compression threads below which
+ * the controller chooses a more expensive compression level
+ */
+#define COMPRESSION_LEVEL_CONTROLLER_LOW_UTILIZATION		75
+
+typedef struct compression_level_controller compression_level_controller_t;
+
+struct compression_level_controller
+{
+	/* The minimum level index
+	 */
+	int minimum_level_index;
+
+	/* The maximum level index
+	 */
+	int maximum_level_index;
+
+	/* The current level index
+	 */
+	int current_level_index;
+
+	/* The number of threads that compress data
+	 */
+	int number_of_threads;
+
+	/* The start time of the current measurement window
+	 */
+	uint64_t window_start_time;
+
+	/* The time spent compressing in the current measurement window
+	 */
+	uint64_t window_busy_time;
+
+	/* The number of chunks compressed in the current measurement window
+	 */
+	uint64_t window_number_of_chunks;
+
+	/* The number of bytes compressed per level
+	 */
+	uint64_t number_of_bytes[ COMPRESSION_LEVEL_CONTROLLER_NUMBER_OF_LEVELS ];
+
+	/* The time spent compressing per level
+	 */
+	uint64_t busy_time[ COMPRESSION_LEVEL_CONTROLLER_NUMBER_OF_LEVELS ];
+
+	/* The number of chunks compressed per level
+	 */
+	uint64_t number_of_chunks[ COMPRESSION_LEVEL_CONTROLLER_NUMBER_OF_LEVELS ];
+
+	/* The number of level changes
+	 */
+	uint64_t number_of_level_changes;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int compression_level_controller_get_level_index(
+     int8_t compression_level,
+     int *level_index,
+     libcerror_error_t **error );
+
+int compression_level_controller_initialize(
+     compression_level_controller_t **controller,
+     int8_t minimum_compression_level,
+     int8_t maximum_compression_level,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int compression_level_controller_free(
+     compression_level_controller_t **controller,
+     libcerror_error_t **error );
+
+int compression_level_controller_get_current_time(
+     uint64_t *current_time,
+     libcerror_error_t **error );
+
+int compression_level_controller_get_compression_level(
+     compression_level_controller_t *controller,
+     int8_t *compression_level,
+     libcerror_error_t **error );
+
+int compression_level_controller_update(
+     compression_level_controller_t *controller,
+     int8_t compression_level,
+     size_t data_size,
+     uint64_t busy_time,
+     libcerror_error_t **error );
+
+int compression_level_controller_fprint(
+     compression_level_controller_t *controller,
+     FILE *stream,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _COMPRESSION_LEVEL_CONTROLLER_H ) */
+
@@ -28,6 +28,7 @@
 
 #include "byte_size_string.h"
 #include "device_handle.h"
+#include "device_reader.h"
 #include "ewfinput.h"
 #include "ewftools_libcerror.h"
 #include "ewftools_libewf.h"
@@ -231,6 +232,24 @@ int device_handle_free(
 			memory_free(
 			 ( *device_handle )->toc_filename );
 		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *device_handle )->device_reader != NULL )
+		{
+			if( device_reader_free(
+			     &( ( *device_handle )->device_reader ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free device reader.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
 		if( ( *device_handle )->type == DEVICE_HANDLE_TYPE_DEVICE )
 		{
 			if( ( *device_handle )->smdev_input_handle != NULL )
@@ -334,6 +353,24 @@ int device_handle_signal_abort(
 				return( -1 );
 			}
 		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( device_handle->device_reader != NULL )
+		{
+			if( device_reader_signal_abort(
+			     device_handle->device_reader,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to signal device reader to abort.",
+				 function );
+
+				return( -1 );
+			}
+		}
+#endif
 	}
 	else if( device_handle->type == DEVICE_HANDLE_TYPE_OPTICAL_DISC_FILE )
 	{
@@ -593,9 +630,50 @@ int device_handle_open_smdev_input(
 
 		goto on_error;
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( device_handle->number_of_readers > 0 )
+	{
+		if( device_reader_initialize(
+		     &( device_handle->device_reader ),
+		     device_handle->number_of_readers,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create device reader.",
+			 function );
+
+			goto on_error;
+		}
+		if( device_reader_open(
+		     device_handle->device_reader,
+		     filenames[ 0 ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open device reader.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
 	return( 1 );
 
 on_error:
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( device_handle->device_reader != NULL )
+	{
+		device_reader_free(
+		 &( device_handle->device_reader ),
+		 NULL );
+	}
+#endif
 	if( device_handle->smdev_input_handle != NULL )
 	{
 		libsmdev_handle_free(
@@ -948,6 +1026,24 @@ int device_handle_close(
 
 			return( -1 );
 		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( device_handle->device_reader != NULL )
+		{
+			if( device_reader_close(
+			     device_handle->device_reader,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close device reader.",
+				 function );
+
+				return( -1 );
+			}
+		}
+#endif
 	}
 	else if( device_handle->type == DEVICE_HANDLE_TYPE_OPTICAL_DISC_FILE )
 	{
@@ -2263,6 +2359,66 @@ int device_handle_set_number_of_error_retries(
 	return( result );
 }
 
+/* Sets the number of asynchronous device readers
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int device_handle_set_number_of_readers(
+     device_handle_t *device_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function  = "device_handle_set_number_of_readers";
+	size_t string_length   = 0;
+	uint64_t size_variable = 0;
+	int result             = 0;
+
+	if( device_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( ewftools_system_string_decimal_copy_to_64_bit(
+	     string,
+	     string_length + 1,
+	     &size_variable,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine number of readers.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( size_variable <= (uint64_t) DEVICE_READER_MAXIMUM_NUMBER_OF_READERS )
+	{
+		device_handle->number_of_readers = (int) size_variable;
+
+		result = 1;
+	}
+#else
+	if( size_variable == 0 )
+	{
+		device_handle->number_of_readers = 0;
+
+		result = 1;
+	}
+#endif
+	return( result );
+}
+
 /* Sets the error values
  * Returns 1 if successful or -1 on error
  */
@@ -2333,6 +2489,27 @@ int device_handle_set_error_values(
 
 			return( -1 );
 		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( device_handle->device_reader != NULL )
+		{
+			if( device_reader_set_error_values(
+			     device_handle->device_reader,
+			     device_handle->number_of_error_retries,
+			     error_granularity,
+			     device_handle->zero_buffer_on_error,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set error values in device reader.",
+				 function );
+
+				return( -1 );
+			}
+		}
+#endif
 	}
 	return( 1 );
 }
@@ -2347,6 +2524,10 @@ int device_handle_get_number_of_read_errors(
 {
 	static char *function = "device_handle_get_number_of_read_errors";
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	int number_of_reader_errors = 0;
+#endif
+
 	if( device_handle == NULL )
 	{
 		libcerror_error_set(
@@ -2374,6 +2555,26 @@ int device_handle_get_number_of_read_errors(
 
 			return( -1 );
 		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( device_handle->device_reader != NULL )
+		{
+			if( device_reader_get_number_of_read_errors(
+			     device_handle->device_reader,
+			     &number_of_reader_errors,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve number of device reader read errors.",
+				 function );
+
+				return( -1 );
+			}
+			*number_of_read_errors += number_of_reader_errors;
+		}
+#endif
 	}
 	else if( ( device_handle->type == DEVICE_HANDLE_TYPE_OPTICAL_DISC_FILE )
 	      || ( device_handle->type == DEVICE_HANDLE_TYPE_FILE ) )
@@ -2406,6 +2607,10 @@ int device_handle_get_read_error(
 {
 	static char *function = "device_handle_get_read_error";
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	int number_of_read_errors = 0;
+#endif
+
 	if( device_handle == NULL )
 	{
 		libcerror_error_set(
@@ -2419,6 +2624,48 @@ int device_handle_get_read_error(
 	}
 	if( device_handle->type == DEVICE_HANDLE_TYPE_DEVICE )
 	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		/* The read errors of the device reader follow those of the device input handle
+		 */
+		if( device_handle->device_reader != NULL )
+		{
+			if( libsmdev_handle_get_number_of_errors(
+			     device_handle->smdev_input_handle,
+			     &number_of_read_errors,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve number of read errors.",
+				 function );
+
+				return( -1 );
+			}
+			if( index >= number_of_read_errors )
+			{
+				if( device_reader_get_read_error(
+				     device_handle->device_reader,
+				     index - number_of_read_errors,
+				     offset,
+				     size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve device reader read error: %d.",
+					 function,
+					 index );
+
+					return( -1 );
+				}
+				return( 1 );
+			}
+		}
+#endif
 		if( libsmdev_handle_get_error(
 		     device_handle->smdev_input_handle,
 		     index,
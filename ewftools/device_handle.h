@@ -25,6 +25,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "device_reader.h"
 #include "ewftools_libcerror.h"
 #include "ewftools_libodraw.h"
 #include "ewftools_libsmdev.h"
@@ -111,6 +112,16 @@ struct device_handle
 	 */
 	uint8_t zero_buffer_on_error;
 
+	/* The number of asynchronous device readers
+	 */
+	int number_of_readers;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The asynchronous device reader
+	 */
+	device_reader_t *device_reader;
+#endif
+
 	/* The notification output stream
 	 */
 	FILE *notify_stream;
@@ -254,6 +265,11 @@ int device_handle_set_number_of_error_retries(
      const system_character_t *string,
      libcerror_error_t **error );
 
+int device_handle_set_number_of_readers(
+     device_handle_t *device_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
 int device_handle_set_error_values(
      device_handle_t *device_handle,
      size_t error_granularity,
@@ -0,0 +1,2457 @@
+/*
+ * Asynchronous device reader
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "device_reader.h"
+#include "ewftools_libcdata.h"
+#include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libsmdev.h"
+#include "storage_media_buffer.h"
+#include "storage_media_buffer_queue.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Creates a device reader
+ * Make sure the value reader is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int device_reader_initialize(
+     device_reader_t **reader,
+     int number_of_readers,
+     libcerror_error_t **error )
+{
+	static char *function = "device_reader_initialize";
+	int reader_index      = 0;
+
+	if( reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( *reader != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid reader value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_readers <= 0 )
+	 || ( number_of_readers > DEVICE_READER_MAXIMUM_NUMBER_OF_READERS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of readers value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*reader = memory_allocate_structure(
+	           device_reader_t );
+
+	if( *reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create reader.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *reader,
+	     0,
+	     sizeof( device_reader_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear reader.",
+		 function );
+
+		memory_free(
+		 *reader );
+
+		*reader = NULL;
+
+		return( -1 );
+	}
+	( *reader )->handles = (libsmdev_handle_t **) memory_allocate(
+	                                               sizeof( libsmdev_handle_t * ) * number_of_readers );
+
+	if( ( *reader )->handles == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create handles.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *reader )->handles,
+	     0,
+	     sizeof( libsmdev_handle_t * ) * number_of_readers ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear handles.",
+		 function );
+
+		goto on_error;
+	}
+	( *reader )->threads = (libcthreads_thread_t **) memory_allocate(
+	                                                  sizeof( libcthreads_thread_t * ) * number_of_readers );
+
+	if( ( *reader )->threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create threads.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *reader )->threads,
+	     0,
+	     sizeof( libcthreads_thread_t * ) * number_of_readers ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear threads.",
+		 function );
+
+		goto on_error;
+	}
+	( *reader )->number_of_readers = number_of_readers;
+
+	for( reader_index = 0;
+	     reader_index < number_of_readers;
+	     reader_index++ )
+	{
+		if( libsmdev_handle_initialize(
+		     &( ( *reader )->handles[ reader_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create handle: %d.",
+			 function,
+			 reader_index );
+
+			goto on_error;
+		}
+	}
+	if( libsmdev_handle_initialize(
+	     &( ( *reader )->probe_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create probe handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libsmdev_handle_initialize(
+	     &( ( *reader )->retry_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create retry handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *reader )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *reader )->list_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create list mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *reader )->completed_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create completed condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *reader )->retry_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create retry condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_list_initialize(
+	     &( ( *reader )->completed_list ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create completed list.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_list_initialize(
+	     &( ( *reader )->retry_list ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create retry list.",
+		 function );
+
+		goto on_error;
+	}
+	( *reader )->bytes_per_sector = 512;
+
+	return( 1 );
+
+on_error:
+	if( *reader != NULL )
+	{
+		if( ( *reader )->completed_list != NULL )
+		{
+			libcdata_list_free(
+			 &( ( *reader )->completed_list ),
+			 NULL,
+			 NULL );
+		}
+		if( ( *reader )->retry_condition != NULL )
+		{
+			libcthreads_condition_free(
+			 &( ( *reader )->retry_condition ),
+			 NULL );
+		}
+		if( ( *reader )->completed_condition != NULL )
+		{
+			libcthreads_condition_free(
+			 &( ( *reader )->completed_condition ),
+			 NULL );
+		}
+		if( ( *reader )->list_mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *reader )->list_mutex ),
+			 NULL );
+		}
+		if( ( *reader )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *reader )->mutex ),
+			 NULL );
+		}
+		if( ( *reader )->retry_handle != NULL )
+		{
+			libsmdev_handle_free(
+			 &( ( *reader )->retry_handle ),
+			 NULL );
+		}
+		if( ( *reader )->probe_handle != NULL )
+		{
+			libsmdev_handle_free(
+			 &( ( *reader )->probe_handle ),
+			 NULL );
+		}
+		if( ( *reader )->handles != NULL )
+		{
+			for( reader_index = 0;
+			     reader_index < number_of_readers;
+			     reader_index++ )
+			{
+				if( ( *reader )->handles[ reader_index ] != NULL )
+				{
+					libsmdev_handle_free(
+					 &( ( *reader )->handles[ reader_index ] ),
+					 NULL );
+				}
+			}
+			memory_free(
+			 ( *reader )->handles );
+		}
+		if( ( *reader )->threads != NULL )
+		{
+			memory_free(
+			 ( *reader )->threads );
+		}
+		memory_free(
+		 *reader );
+
+		*reader = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a device reader
+ * Returns 1 if successful or -1 on error
+ */
+int device_reader_free(
+     device_reader_t **reader,
+     libcerror_error_t **error )
+{
+	static char *function = "device_reader_free";
+	int reader_index      = 0;
+	int result            = 1;
+
+	if( reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( *reader != NULL )
+	{
+		/* The threads are joined in device_reader_join
+		 * and the lists no longer contain buffers at this point
+		 */
+		if( libcdata_list_free(
+		     &( ( *reader )->retry_list ),
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free retry list.",
+			 function );
+
+			result = -1;
+		}
+		if( libcdata_list_free(
+		     &( ( *reader )->completed_list ),
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free completed list.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_condition_free(
+		     &( ( *reader )->retry_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free retry condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_condition_free(
+		     &( ( *reader )->completed_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free completed condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *reader )->list_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free list mutex.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *reader )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+		if( libsmdev_handle_free(
+		     &( ( *reader )->retry_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free retry handle.",
+			 function );
+
+			result = -1;
+		}
+		if( libsmdev_handle_free(
+		     &( ( *reader )->probe_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free probe handle.",
+			 function );
+
+			result = -1;
+		}
+		for( reader_index = 0;
+		     reader_index < ( *reader )->number_of_readers;
+		     reader_index++ )
+		{
+			if( ( ( *reader )->handles[ reader_index ] != NULL )
+			 && ( libsmdev_handle_free(
+			       &( ( *reader )->handles[ reader_index ] ),
+			       error ) != 1 ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free handle: %d.",
+				 function,
+				 reader_index );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 ( *reader )->threads );
+
+		memory_free(
+		 ( *reader )->handles );
+
+		memory_free(
+		 *reader );
+
+		*reader = NULL;
+	}
+	return( result );
+}
+
+/* Signals the device reader to abort
+ * Returns 1 if successful or -1 on error
+ */
+int device_reader_signal_abort(
+     device_reader_t *reader,
+     libcerror_error_t **error )
+{
+	static char *function = "device_reader_signal_abort";
+	int reader_index      = 0;
+
+	if( reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reader.",
+		 function );
+
+		return( -1 );
+	}
+	reader->abort = 1;
+
+	for( reader_index = 0;
+	     reader_index < reader->number_of_readers;
+	     reader_index++ )
+	{
+		if( libsmdev_handle_signal_abort(
+		     reader->handles[ reader_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal handle: %d to abort.",
+			 function,
+			 reader_index );
+
+			return( -1 );
+		}
+	}
+	if( libsmdev_handle_signal_abort(
+	     reader->probe_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to signal probe handle to abort.",
+		 function );
+
+		return( -1 );
+	}
+	if( libsmdev_handle_signal_abort(
+	     reader->retry_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to signal retry handle to abort.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Opens the reader handles
+ * Returns 1 if successful or -1 on error
+ */
+int device_reader_open(
+     device_reader_t *reader,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	libsmdev_handle_t *handle = NULL;
+	static char *function     = "device_reader_open";
+	int handle_index          = 0;
+
+	if( reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	/* The reader handles are followed by the probe and the retry handle
+	 */
+	for( handle_index = 0;
+	     handle_index < reader->number_of_readers + 2;
+	     handle_index++ )
+	{
+		if( handle_index < reader->number_of_readers )
+		{
+			handle = reader->handles[ handle_index ];
+		}
+		else if( handle_index == reader->number_of_readers )
+		{
+			handle = reader->probe_handle;
+		}
+		else
+		{
+			handle = reader->retry_handle;
+		}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libsmdev_handle_open_wide(
+		     handle,
+		     filename,
+		     LIBSMDEV_OPEN_READ,
+		     error ) != 1 )
+#else
+		if( libsmdev_handle_open(
+		     handle,
+		     filename,
+		     LIBSMDEV_OPEN_READ,
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open handle: %d.",
+			 function,
+			 handle_index );
+
+			goto on_error;
+		}
+		/* Only the retry handle retries on error
+		 */
+		if( handle != reader->retry_handle )
+		{
+			if( libsmdev_handle_set_number_of_error_retries(
+			     handle,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set number of error retries in handle: %d.",
+				 function,
+				 handle_index );
+
+				goto on_error;
+			}
+		}
+	}
+	if( libsmdev_handle_get_bytes_per_sector(
+	     reader->retry_handle,
+	     &( reader->bytes_per_sector ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve bytes per sector.",
+		 function );
+
+		goto on_error;
+	}
+	if( reader->bytes_per_sector == 0 )
+	{
+		reader->bytes_per_sector = 512;
+	}
+	reader->error_granularity = (size_t) reader->bytes_per_sector;
+
+	return( 1 );
+
+on_error:
+	device_reader_close(
+	 reader,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Closes the reader handles
+ * Returns the 0 if succesful or -1 on error
+ */
+int device_reader_close(
+     device_reader_t *reader,
+     libcerror_error_t **error )
+{
+	static char *function = "device_reader_close";
+	int reader_index      = 0;
+	int result            = 0;
+
+	if( reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reader.",
+		 function );
+
+		return( -1 );
+	}
+	for( reader_index = 0;
+	     reader_index < reader->number_of_readers;
+	     reader_index++ )
+	{
+		if( libsmdev_handle_close(
+		     reader->handles[ reader_index ],
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close handle: %d.",
+			 function,
+			 reader_index );
+
+			result = -1;
+		}
+	}
+	if( libsmdev_handle_close(
+	     reader->probe_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close probe handle.",
+		 function );
+
+		result = -1;
+	}
+	if( libsmdev_handle_close(
+	     reader->retry_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close retry handle.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+/* Sets the error values of the retry handle
+ * Returns 1 if successful or -1 on error
+ */
+int device_reader_set_error_values(
+     device_reader_t *reader,
+     uint8_t number_of_error_retries,
+     size_t error_granularity,
+     uint8_t zero_buffer_on_error,
+     libcerror_error_t **error )
+{
+	static char *function = "device_reader_set_error_values";
+	uint8_t error_flags   = 0;
+
+	if( reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( libsmdev_handle_set_number_of_error_retries(
+	     reader->retry_handle,
+	     number_of_error_retries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set number of error retries in retry handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libsmdev_handle_set_error_granularity(
+	     reader->retry_handle,
+	     error_granularity,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set error granularity in retry handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( zero_buffer_on_error != 0 )
+	{
+		error_flags = LIBSMDEV_ERROR_FLAG_ZERO_ON_ERROR;
+	}
+	if( libsmdev_handle_set_error_flags(
+	     reader->retry_handle,
+	     error_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set error flags in retry handle.",
+		 function );
+
+		return( -1 );
+	}
+	/* The retry thread narrows down a read error to the error granularity
+	 * which is at least one sector
+	 */
+	if( error_granularity < (size_t) reader->bytes_per_sector )
+	{
+		error_granularity = (size_t) reader->bytes_per_sector;
+	}
+	else
+	{
+		error_granularity -= error_granularity % reader->bytes_per_sector;
+	}
+	reader->error_granularity = error_granularity;
+
+	return( 1 );
+}
+
+/* Starts the reader and retry threads
+ * The start offset is the device offset to start reading from and
+ * the storage media offset the corresponding offset in the storage media buffers
+ * Returns 1 if successful or -1 on error
+ */
+int device_reader_start(
+     device_reader_t *reader,
+     storage_media_buffer_queue_t *storage_media_buffer_queue,
+     off64_t start_offset,
+     off64_t storage_media_offset,
+     size64_t size,
+     size_t read_size,
+     libcerror_error_t **error )
+{
+	static char *function = "device_reader_start";
+	int reader_index      = 0;
+
+	if( reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( start_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid start offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid storage media offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( read_size == 0 )
+	 || ( read_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid read size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	reader->storage_media_buffer_queue = storage_media_buffer_queue;
+	reader->start_offset               = start_offset;
+	reader->storage_media_offset       = storage_media_offset;
+	reader->size                       = size;
+	reader->read_size                  = read_size;
+	reader->next_offset                = 0;
+	reader->next_completed_offset      = 0;
+	reader->next_handle_index          = 0;
+	reader->number_of_active_readers   = reader->number_of_readers;
+	reader->number_of_retried_buffers  = 0;
+	reader->has_failed                 = 0;
+
+	if( libcthreads_thread_create(
+	     &( reader->retry_thread ),
+	     NULL,
+	     (int (*)(void *)) &device_reader_retry_thread_callback,
+	     (void *) reader,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create retry thread.",
+		 function );
+
+		goto on_error;
+	}
+	for( reader_index = 0;
+	     reader_index < reader->number_of_readers;
+	     reader_index++ )
+	{
+		if( libcthreads_thread_create(
+		     &( reader->threads[ reader_index ] ),
+		     NULL,
+		     (int (*)(void *)) &device_reader_reader_thread_callback,
+		     (void *) reader,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread: %d.",
+			 function,
+			 reader_index );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	/* Readers that were never started will not decrement
+	 * the number of active readers
+	 */
+	if( libcthreads_mutex_grab(
+	     reader->list_mutex,
+	     NULL ) == 1 )
+	{
+		reader->number_of_active_readers -= reader->number_of_readers - reader_index;
+		reader->abort                     = 1;
+
+		libcthreads_mutex_release(
+		 reader->list_mutex,
+		 NULL );
+	}
+	device_reader_join(
+	 reader,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Retrieves the next storage media buffer in storage media offset order
+ * This function blocks until the buffer has been read
+ * Returns 1 if successful, 0 if no more buffers are available or -1 on error
+ */
+int device_reader_get_next_buffer(
+     device_reader_t *reader,
+     storage_media_buffer_t **storage_media_buffer,
+     libcerror_error_t **error )
+{
+	libcdata_list_element_t *element                 = NULL;
+	storage_media_buffer_t *completed_storage_buffer = NULL;
+	static char *function                            = "device_reader_get_next_buffer";
+	int result                                       = 0;
+
+	if( reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	*storage_media_buffer = NULL;
+
+	if( libcthreads_mutex_grab(
+	     reader->list_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab list mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( result == 0 )
+	{
+		if( reader->has_failed != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data.",
+			 function );
+
+			goto on_error;
+		}
+		if( ( reader->abort != 0 )
+		 || ( (size64_t) reader->next_completed_offset >= reader->size ) )
+		{
+			break;
+		}
+		if( libcdata_list_get_first_element(
+		     reader->completed_list,
+		     &element,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve first element.",
+			 function );
+
+			goto on_error;
+		}
+		if( element != NULL )
+		{
+			if( libcdata_list_element_get_value(
+			     element,
+			     (intptr_t **) &completed_storage_buffer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve value from list element.",
+				 function );
+
+				goto on_error;
+			}
+			if( completed_storage_buffer == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing storage media buffer.",
+				 function );
+
+				goto on_error;
+			}
+			if( completed_storage_buffer->storage_media_offset == ( reader->storage_media_offset + reader->next_completed_offset ) )
+			{
+				if( libcdata_list_remove_element(
+				     reader->completed_list,
+				     element,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+					 "%s: unable to remove list element from completed list.",
+					 function );
+
+					goto on_error;
+				}
+				/* The completed list no longer manages the list element and the storage media buffer it contains
+				 */
+				if( libcdata_list_element_free(
+				     &element,
+				     NULL,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free list element.",
+					 function );
+
+					goto on_error;
+				}
+				reader->next_completed_offset += (off64_t) completed_storage_buffer->requested_size;
+
+				*storage_media_buffer = completed_storage_buffer;
+
+				result = 1;
+
+				break;
+			}
+		}
+		if( libcthreads_condition_wait(
+		     reader->completed_condition,
+		     reader->list_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for completed condition.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     reader->list_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release list mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+
+on_error:
+	libcthreads_mutex_release(
+	 reader->list_mutex,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Joins the reader and retry threads
+ * Buffers that were not retrieved are handed back to the storage media buffer queue
+ * Returns 1 if successful or -1 on error
+ */
+int device_reader_join(
+     device_reader_t *reader,
+     libcerror_error_t **error )
+{
+	libcdata_list_element_t *element             = NULL;
+	libcdata_list_t *list                        = NULL;
+	storage_media_buffer_t *storage_media_buffer = NULL;
+	static char *function                        = "device_reader_join";
+	int list_index                               = 0;
+	int reader_index                             = 0;
+	int result                                   = 1;
+
+	if( reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     reader->list_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab list mutex.",
+		 function );
+
+		return( -1 );
+	}
+	/* Stop the threads that did not run to completion
+	 */
+	if( (size64_t) reader->next_completed_offset < reader->size )
+	{
+		reader->abort = 1;
+	}
+	/* Hand back the buffers that were not retrieved so that a reader thread
+	 * waiting on the storage media buffer queue can observe the abort
+	 */
+	for( list_index = 0;
+	     list_index < 2;
+	     list_index++ )
+	{
+		if( list_index == 0 )
+		{
+			list = reader->completed_list;
+		}
+		else
+		{
+			list = reader->retry_list;
+		}
+		while( 1 )
+		{
+			if( libcdata_list_get_first_element(
+			     list,
+			     &element,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve first element.",
+				 function );
+
+				result = -1;
+
+				break;
+			}
+			if( element == NULL )
+			{
+				break;
+			}
+			if( libcdata_list_element_get_value(
+			     element,
+			     (intptr_t **) &storage_media_buffer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve value from list element.",
+				 function );
+
+				result = -1;
+
+				break;
+			}
+			if( libcdata_list_remove_element(
+			     list,
+			     element,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+				 "%s: unable to remove list element.",
+				 function );
+
+				result = -1;
+
+				break;
+			}
+			libcdata_list_element_free(
+			 &element,
+			 NULL,
+			 NULL );
+
+			if( storage_media_buffer_queue_release_buffer(
+			     reader->storage_media_buffer_queue,
+			     storage_media_buffer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to release storage media buffer onto queue.",
+				 function );
+
+				storage_media_buffer_free(
+				 &storage_media_buffer,
+				 NULL );
+
+				result = -1;
+			}
+		}
+	}
+	libcthreads_condition_broadcast(
+	 reader->retry_condition,
+	 NULL );
+
+	libcthreads_condition_broadcast(
+	 reader->completed_condition,
+	 NULL );
+
+	if( libcthreads_mutex_release(
+	     reader->list_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release list mutex.",
+		 function );
+
+		return( -1 );
+	}
+	for( reader_index = 0;
+	     reader_index < reader->number_of_readers;
+	     reader_index++ )
+	{
+		if( reader->threads[ reader_index ] == NULL )
+		{
+			continue;
+		}
+		if( libcthreads_thread_join(
+		     &( reader->threads[ reader_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread: %d.",
+			 function,
+			 reader_index );
+
+			result = -1;
+		}
+	}
+	if( reader->retry_thread != NULL )
+	{
+		if( libcthreads_thread_join(
+		     &( reader->retry_thread ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join retry thread.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( ( result == 1 )
+	 && ( reader->has_failed != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+/* Retrieves the number of read errors
+ * Only read errors of the retry handle are reported,
+ * a read error of a reader handle is always retried
+ * Returns 1 if successful or -1 on error
+ */
+int device_reader_get_number_of_read_errors(
+     device_reader_t *reader,
+     int *number_of_read_errors,
+     libcerror_error_t **error )
+{
+	static char *function = "device_reader_get_number_of_read_errors";
+
+	if( reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( libsmdev_handle_get_number_of_errors(
+	     reader->retry_handle,
+	     number_of_read_errors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of read errors.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the information of a read error
+ * Returns 1 if successful or -1 on error
+ */
+int device_reader_get_read_error(
+     device_reader_t *reader,
+     int index,
+     off64_t *offset,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	static char *function = "device_reader_get_read_error";
+
+	if( reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( libsmdev_handle_get_error(
+	     reader->retry_handle,
+	     index,
+	     offset,
+	     size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve read error: %d.",
+		 function,
+		 index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads data at a specific offset without retrying
+ * Returns 1 if the data was read, 0 if a read error occurred or -1 on error
+ */
+int device_reader_read_at_offset(
+     libsmdev_handle_t *handle,
+     uint8_t *data,
+     size_t size,
+     off64_t offset,
+     libcerror_error_t **error )
+{
+	libcerror_error_t *read_error = NULL;
+	static char *function         = "device_reader_read_at_offset";
+	ssize_t read_count            = 0;
+	int number_of_errors          = 0;
+	int previous_number_of_errors = 0;
+
+	if( libsmdev_handle_get_number_of_errors(
+	     handle,
+	     &previous_number_of_errors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of read errors.",
+		 function );
+
+		return( -1 );
+	}
+	if( libsmdev_handle_seek_offset(
+	     handle,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	read_count = libsmdev_handle_read_buffer(
+	              handle,
+	              data,
+	              size,
+	              &read_error );
+
+	if( read_count < 0 )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 read_error );
+		}
+#endif
+		libcerror_error_free(
+		 &read_error );
+
+		return( 0 );
+	}
+	if( (size_t) read_count != size )
+	{
+		return( 0 );
+	}
+	if( libsmdev_handle_get_number_of_errors(
+	     handle,
+	     &number_of_errors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of read errors.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_errors != previous_number_of_errors )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Re-reads a region that contains a read error
+ * The region is bisected using the probe handle until the parts that
+ * fail are no larger than the error granularity, only these parts are
+ * read using the retry handle
+ * Returns 1 if successful or -1 on error
+ */
+int device_reader_retry_region(
+     device_reader_t *reader,
+     uint8_t *data,
+     size_t size,
+     off64_t offset,
+     libcerror_error_t **error )
+{
+	static char *function = "device_reader_retry_region";
+	ssize_t read_count    = 0;
+	size_t part_size      = 0;
+	int part_index        = 0;
+	int result            = 0;
+
+	if( reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( reader->abort != 0 )
+	{
+		return( 1 );
+	}
+	if( size <= reader->error_granularity )
+	{
+		if( libsmdev_handle_seek_offset(
+		     reader->retry_handle,
+		     offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek offset: %" PRIi64 ".",
+			 function,
+			 offset );
+
+			return( -1 );
+		}
+		read_count = libsmdev_handle_read_buffer(
+		              reader->retry_handle,
+		              data,
+		              size,
+		              error );
+
+		if( read_count != (ssize_t) size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data at offset: %" PRIi64 ".",
+			 function,
+			 offset );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	part_size  = size / 2;
+	part_size -= part_size % reader->error_granularity;
+
+	if( part_size == 0 )
+	{
+		part_size = reader->error_granularity;
+	}
+	for( part_index = 0;
+	     part_index < 2;
+	     part_index++ )
+	{
+		result = device_reader_read_at_offset(
+		          reader->probe_handle,
+		          data,
+		          part_size,
+		          offset,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to probe data at offset: %" PRIi64 ".",
+			 function,
+			 offset );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			if( device_reader_retry_region(
+			     reader,
+			     data,
+			     part_size,
+			     offset,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to retry data at offset: %" PRIi64 ".",
+				 function,
+				 offset );
+
+				return( -1 );
+			}
+		}
+		data   += part_size;
+		offset += (off64_t) part_size;
+		size   -= part_size;
+
+		part_size = size;
+	}
+	return( 1 );
+}
+
+/* Reads storage media buffers without retrying on error
+ * Callback function for the reader threads
+ * Returns 1 if successful or -1 on error
+ */
+int device_reader_reader_thread_callback(
+     device_reader_t *reader )
+{
+	libcerror_error_t *error                     = NULL;
+	libsmdev_handle_t *handle                    = NULL;
+	storage_media_buffer_t *storage_media_buffer = NULL;
+	static char *function                        = "device_reader_reader_thread_callback";
+	off64_t read_offset                          = 0;
+	size_t read_size                             = 0;
+	int list_mutex_grabbed                       = 0;
+	int mutex_grabbed                            = 0;
+	int result                                   = 0;
+
+	if( reader == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reader.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_grab(
+	     reader->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	handle = reader->handles[ reader->next_handle_index ];
+
+	reader->next_handle_index += 1;
+
+	if( libcthreads_mutex_release(
+	     reader->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	while( reader->abort == 0 )
+	{
+		/* Grabbing the buffer and claiming the offset under the same mutex
+		 * hands out the buffers in offset order. The lowest outstanding
+		 * offset therefore always holds a buffer, either in a reader
+		 * or in the retry thread.
+		 */
+		if( libcthreads_mutex_grab(
+		     reader->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			goto on_error;
+		}
+		mutex_grabbed = 1;
+
+		if( (size64_t) reader->next_offset >= reader->size )
+		{
+			break;
+		}
+		if( storage_media_buffer_queue_grab_buffer(
+		     reader->storage_media_buffer_queue,
+		     0,
+		     &storage_media_buffer,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to grab storage media buffer from queue.",
+			 function );
+
+			goto on_error;
+		}
+		if( storage_media_buffer == NULL )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing storage media buffer.",
+			 function );
+
+			goto on_error;
+		}
+		if( reader->abort != 0 )
+		{
+			break;
+		}
+		read_offset = reader->next_offset;
+		read_size   = reader->read_size;
+
+		if( ( reader->size - (size64_t) read_offset ) < (size64_t) read_size )
+		{
+			read_size = (size_t) ( reader->size - read_offset );
+		}
+		reader->next_offset += (off64_t) read_size;
+
+		if( libcthreads_mutex_release(
+		     reader->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			goto on_error;
+		}
+		mutex_grabbed = 0;
+
+		if( read_size > storage_media_buffer->raw_buffer_size )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid read size value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		result = device_reader_read_at_offset(
+		          handle,
+		          storage_media_buffer->raw_buffer,
+		          read_size,
+		          reader->start_offset + read_offset,
+		          &error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data at offset: %" PRIi64 ".",
+			 function,
+			 reader->start_offset + read_offset );
+
+			goto on_error;
+		}
+		storage_media_buffer->storage_media_offset = reader->storage_media_offset + read_offset;
+		storage_media_buffer->requested_size       = read_size;
+		storage_media_buffer->raw_buffer_data_size = read_size;
+
+		if( libcthreads_mutex_grab(
+		     reader->list_mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab list mutex.",
+			 function );
+
+			goto on_error;
+		}
+		list_mutex_grabbed = 1;
+
+		if( reader->abort != 0 )
+		{
+			break;
+		}
+		if( result != 0 )
+		{
+			if( libcdata_list_insert_value(
+			     reader->completed_list,
+			     (intptr_t *) storage_media_buffer,
+			     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &storage_media_buffer_compare,
+			     LIBCDATA_INSERT_FLAG_UNIQUE_ENTRIES,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to insert storage media buffer into completed list.",
+				 function );
+
+				goto on_error;
+			}
+			storage_media_buffer = NULL;
+
+			if( libcthreads_condition_broadcast(
+			     reader->completed_condition,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to broadcast completed condition.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		else
+		{
+			/* Hand the buffer to the retry thread and continue
+			 * with the next read
+			 */
+			if( libcdata_list_append_value(
+			     reader->retry_list,
+			     (intptr_t *) storage_media_buffer,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append storage media buffer to retry list.",
+				 function );
+
+				goto on_error;
+			}
+			storage_media_buffer = NULL;
+
+			reader->number_of_retried_buffers += 1;
+
+			if( libcthreads_condition_signal(
+			     reader->retry_condition,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to signal retry condition.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		list_mutex_grabbed = 0;
+
+		if( libcthreads_mutex_release(
+		     reader->list_mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release list mutex.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( list_mutex_grabbed != 0 )
+	{
+		list_mutex_grabbed = 0;
+
+		if( libcthreads_mutex_release(
+		     reader->list_mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release list mutex.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( mutex_grabbed != 0 )
+	{
+		mutex_grabbed = 0;
+
+		if( libcthreads_mutex_release(
+		     reader->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	/* A buffer grabbed after an abort was signalled is handed back
+	 * so that a reader blocked on the queue can observe the abort
+	 */
+	if( storage_media_buffer != NULL )
+	{
+		if( storage_media_buffer_queue_release_buffer(
+		     reader->storage_media_buffer_queue,
+		     storage_media_buffer,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to release storage media buffer onto queue.",
+			 function );
+
+			goto on_error;
+		}
+		storage_media_buffer = NULL;
+	}
+	result = 1;
+
+on_error:
+	if( reader != NULL )
+	{
+		if( result != 1 )
+		{
+			/* Make the other threads stop
+			 */
+			reader->has_failed = 1;
+			reader->abort      = 1;
+
+			if( mutex_grabbed != 0 )
+			{
+				libcthreads_mutex_release(
+				 reader->mutex,
+				 NULL );
+			}
+			if( storage_media_buffer != NULL )
+			{
+				if( storage_media_buffer_queue_release_buffer(
+				     reader->storage_media_buffer_queue,
+				     storage_media_buffer,
+				     NULL ) != 1 )
+				{
+					storage_media_buffer_free(
+					 &storage_media_buffer,
+					 NULL );
+				}
+			}
+		}
+		if( list_mutex_grabbed == 0 )
+		{
+			list_mutex_grabbed = libcthreads_mutex_grab(
+			                      reader->list_mutex,
+			                      NULL );
+		}
+		/* The retry thread stops when all the readers stopped
+		 * and the caller is woken up to observe a failure
+		 */
+		reader->number_of_active_readers -= 1;
+
+		if( list_mutex_grabbed == 1 )
+		{
+			libcthreads_condition_broadcast(
+			 reader->retry_condition,
+			 NULL );
+
+			libcthreads_condition_broadcast(
+			 reader->completed_condition,
+			 NULL );
+
+			libcthreads_mutex_release(
+			 reader->list_mutex,
+			 NULL );
+		}
+	}
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+/* Re-reads storage media buffers that contain a read error
+ * Callback function for the retry thread
+ * Returns 1 if successful or -1 on error
+ */
+int device_reader_retry_thread_callback(
+     device_reader_t *reader )
+{
+	libcdata_list_element_t *element             = NULL;
+	libcerror_error_t *error                     = NULL;
+	storage_media_buffer_t *storage_media_buffer = NULL;
+	static char *function                        = "device_reader_retry_thread_callback";
+	off64_t read_offset                          = 0;
+	int list_mutex_grabbed                       = 0;
+	int result                                   = -1;
+
+	if( reader == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reader.",
+		 function );
+
+		goto on_error;
+	}
+	while( 1 )
+	{
+		if( libcthreads_mutex_grab(
+		     reader->list_mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab list mutex.",
+			 function );
+
+			goto on_error;
+		}
+		list_mutex_grabbed = 1;
+
+		do
+		{
+			if( reader->abort != 0 )
+			{
+				break;
+			}
+			if( libcdata_list_get_first_element(
+			     reader->retry_list,
+			     &element,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve first element.",
+				 function );
+
+				goto on_error;
+			}
+			if( ( element != NULL )
+			 || ( reader->number_of_active_readers <= 0 ) )
+			{
+				break;
+			}
+			if( libcthreads_condition_wait(
+			     reader->retry_condition,
+			     reader->list_mutex,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to wait for retry condition.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		while( element == NULL );
+
+		if( ( reader->abort != 0 )
+		 || ( element == NULL ) )
+		{
+			break;
+		}
+		if( libcdata_list_element_get_value(
+		     element,
+		     (intptr_t **) &storage_media_buffer,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve value from list element.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcdata_list_remove_element(
+		     reader->retry_list,
+		     element,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove list element from retry list.",
+			 function );
+
+			storage_media_buffer = NULL;
+
+			goto on_error;
+		}
+		if( libcdata_list_element_free(
+		     &element,
+		     NULL,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free list element.",
+			 function );
+
+			goto on_error;
+		}
+		list_mutex_grabbed = 0;
+
+		if( libcthreads_mutex_release(
+		     reader->list_mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release list mutex.",
+			 function );
+
+			goto on_error;
+		}
+		/* The reader threads continue with the next reads
+		 * while the bad sectors are retried
+		 */
+		read_offset = reader->start_offset
+		            + ( storage_media_buffer->storage_media_offset - reader->storage_media_offset );
+
+		if( device_reader_retry_region(
+		     reader,
+		     storage_media_buffer->raw_buffer,
+		     storage_media_buffer->raw_buffer_data_size,
+		     read_offset,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to retry data at offset: %" PRIi64 ".",
+			 function,
+			 read_offset );
+
+			goto on_error;
+		}
+		if( libcthreads_mutex_grab(
+		     reader->list_mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab list mutex.",
+			 function );
+
+			goto on_error;
+		}
+		list_mutex_grabbed = 1;
+
+		if( reader->abort != 0 )
+		{
+			break;
+		}
+		/* Merge the buffer back in storage media offset order
+		 */
+		if( libcdata_list_insert_value(
+		     reader->completed_list,
+		     (intptr_t *) storage_media_buffer,
+		     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &storage_media_buffer_compare,
+		     LIBCDATA_INSERT_FLAG_UNIQUE_ENTRIES,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to insert storage media buffer into completed list.",
+			 function );
+
+			goto on_error;
+		}
+		storage_media_buffer = NULL;
+
+		if( libcthreads_condition_broadcast(
+		     reader->completed_condition,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast completed condition.",
+			 function );
+
+			goto on_error;
+		}
+		list_mutex_grabbed = 0;
+
+		if( libcthreads_mutex_release(
+		     reader->list_mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release list mutex.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	result = 1;
+
+on_error:
+	if( reader != NULL )
+	{
+		if( result != 1 )
+		{
+			/* Make the reader threads stop
+			 */
+			reader->has_failed = 1;
+			reader->abort      = 1;
+		}
+		if( storage_media_buffer != NULL )
+		{
+			if( storage_media_buffer_queue_release_buffer(
+			     reader->storage_media_buffer_queue,
+			     storage_media_buffer,
+			     NULL ) != 1 )
+			{
+				storage_media_buffer_free(
+				 &storage_media_buffer,
+				 NULL );
+			}
+		}
+		if( list_mutex_grabbed == 0 )
+		{
+			list_mutex_grabbed = libcthreads_mutex_grab(
+			                      reader->list_mutex,
+			                      NULL );
+		}
+		if( list_mutex_grabbed == 1 )
+		{
+			libcthreads_condition_broadcast(
+			 reader->completed_condition,
+			 NULL );
+
+			libcthreads_mutex_release(
+			 reader->list_mutex,
+			 NULL );
+		}
+	}
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
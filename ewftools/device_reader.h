@@ -0,0 +1,247 @@
+/*
+ * Asynchronous device reader
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _DEVICE_READER_H )
+#define _DEVICE_READER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcdata.h"
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libsmdev.h"
+#include "storage_media_buffer.h"
+#include "storage_media_buffer_queue.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The maximum number of (fast path) reader threads
+ */
+#define DEVICE_READER_MAXIMUM_NUMBER_OF_READERS		32
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+typedef struct device_reader device_reader_t;
+
+/* The device reader keeps multiple reads of a device outstanding.
+ * Every reader thread has its own device handle that does not retry
+ * on a read error. A buffer that contains a read error is handed
+ * to a single retry thread, which narrows down the bad sectors and
+ * re-reads only those with the configured number of error retries.
+ * Buffers are returned to the caller in storage media offset order
+ */
+struct device_reader
+{
+	/* The number of readers
+	 */
+	int number_of_readers;
+
+	/* The reader (libsmdev) handles, these do not retry on error
+	 */
+	libsmdev_handle_t **handles;
+
+	/* The probe (libsmdev) handle used to narrow down a read error
+	 */
+	libsmdev_handle_t *probe_handle;
+
+	/* The retry (libsmdev) handle used to read the bad sectors
+	 */
+	libsmdev_handle_t *retry_handle;
+
+	/* The reader threads
+	 */
+	libcthreads_thread_t **threads;
+
+	/* The retry thread
+	 */
+	libcthreads_thread_t *retry_thread;
+
+	/* The mutex that serializes grabbing a buffer and claiming a read offset
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The mutex that protects the completed and retry lists
+	 */
+	libcthreads_mutex_t *list_mutex;
+
+	/* The condition that signals that a buffer was completed
+	 */
+	libcthreads_condition_t *completed_condition;
+
+	/* The condition that signals that a buffer needs to be retried
+	 */
+	libcthreads_condition_t *retry_condition;
+
+	/* The completed storage media buffers sorted by offset
+	 */
+	libcdata_list_t *completed_list;
+
+	/* The storage media buffers that contain a read error
+	 */
+	libcdata_list_t *retry_list;
+
+	/* The storage media buffer queue
+	 */
+	storage_media_buffer_queue_t *storage_media_buffer_queue;
+
+	/* The error granularity
+	 */
+	size_t error_granularity;
+
+	/* The number of bytes per sector
+	 */
+	uint32_t bytes_per_sector;
+
+	/* The (device) offset at which reading starts
+	 */
+	off64_t start_offset;
+
+	/* The storage media offset that corresponds with the start offset
+	 */
+	off64_t storage_media_offset;
+
+	/* The size of the data to read
+	 */
+	size64_t size;
+
+	/* The read size
+	 */
+	size_t read_size;
+
+	/* The offset of the next read relative to the start offset
+	 */
+	off64_t next_offset;
+
+	/* The offset of the next buffer to return relative to the start offset
+	 */
+	off64_t next_completed_offset;
+
+	/* The index of the next handle to be assigned to a reader thread
+	 */
+	int next_handle_index;
+
+	/* The number of reader threads that are still running
+	 */
+	int number_of_active_readers;
+
+	/* The number of buffers that were handed to the retry thread
+	 */
+	uint64_t number_of_retried_buffers;
+
+	/* Value to indicate if one of the threads failed
+	 */
+	int has_failed;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int device_reader_initialize(
+     device_reader_t **reader,
+     int number_of_readers,
+     libcerror_error_t **error );
+
+int device_reader_free(
+     device_reader_t **reader,
+     libcerror_error_t **error );
+
+int device_reader_signal_abort(
+     device_reader_t *reader,
+     libcerror_error_t **error );
+
+int device_reader_open(
+     device_reader_t *reader,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int device_reader_close(
+     device_reader_t *reader,
+     libcerror_error_t **error );
+
+int device_reader_set_error_values(
+     device_reader_t *reader,
+     uint8_t number_of_error_retries,
+     size_t error_granularity,
+     uint8_t zero_buffer_on_error,
+     libcerror_error_t **error );
+
+int device_reader_start(
+     device_reader_t *reader,
+     storage_media_buffer_queue_t *storage_media_buffer_queue,
+     off64_t start_offset,
+     off64_t storage_media_offset,
+     size64_t size,
+     size_t read_size,
+     libcerror_error_t **error );
+
+int device_reader_get_next_buffer(
+     device_reader_t *reader,
+     storage_media_buffer_t **storage_media_buffer,
+     libcerror_error_t **error );
+
+int device_reader_join(
+     device_reader_t *reader,
+     libcerror_error_t **error );
+
+int device_reader_get_number_of_read_errors(
+     device_reader_t *reader,
+     int *number_of_read_errors,
+     libcerror_error_t **error );
+
+int device_reader_get_read_error(
+     device_reader_t *reader,
+     int index,
+     off64_t *offset,
+     size64_t *size,
+     libcerror_error_t **error );
+
+int device_reader_read_at_offset(
+     libsmdev_handle_t *handle,
+     uint8_t *data,
+     size_t size,
+     off64_t offset,
+     libcerror_error_t **error );
+
+int device_reader_retry_region(
+     device_reader_t *reader,
+     uint8_t *data,
+     size_t size,
+     off64_t offset,
+     libcerror_error_t **error );
+
+int device_reader_reader_thread_callback(
+     device_reader_t *reader );
+
+int device_reader_retry_thread_callback(
+     device_reader_t *reader );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _DEVICE_READER_H ) */
+
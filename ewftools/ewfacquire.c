@@ -118,9 +118,9 @@ void ewfacquire_usage_fprint(
 	                 "                  [ -B number_of_bytes ] [ -c compression_values ]\n"
 	                 "                  [ -C case_number ] [ -d digest_type ] [ -D description ]\n"
 	                 "                  [ -e examiner_name ] [ -E evidence_number ] [ -f format ]\n"
-	                 "                  [ -g number_of_sectors ] [ -j jobs ] [ -l log_filename ]\n"
-	                 "                  [ -m media_type ] [ -M media_flags ] [ -N notes ]\n"
-	                 "                  [ -o offset ] [ -p process_buffer_size ]\n"
+	                 "                  [ -g number_of_sectors ] [ -j jobs ] [ -k readers ]\n"
+	                 "                  [ -l log_filename ] [ -m media_type ] [ -M media_flags ]\n"
+	                 "                  [ -N notes ] [ -o offset ] [ -p process_buffer_size ]\n"
 	                 "                  [ -P bytes_per_sector ] [ -r read_error_retries ]\n"
 	                 "                  [ -S segment_file_size ] [ -t target ] [ -T toc_file ]\n"
 	                 "                  [ -2 secondary_target ] [ -hqRsuvVwx ] source\n\n" );
@@ -144,10 +144,13 @@ void ewfacquire_usage_fprint(
 	                 "\t        compression method options: deflate (default)\n"
 #endif
 	                 "\t        compression level options: none (default), empty-block,\n"
-	                 "\t        fast or best\n" );
+	                 "\t        fast, best or adaptive[=minimum,maximum]\n"
+	                 "\t        adaptive chooses the level per chunk between minimum\n"
+	                 "\t        (default is empty-block) and maximum (default is best)\n"
+	                 "\t        and implies -x\n" );
 	fprintf( stream, "\t-C:     specify the case number (default is case_number).\n" );
 	fprintf( stream, "\t-d:     calculate additional digest (hash) types besides md5, options:\n"
-	                 "\t        sha1, sha256\n" );
+	                 "\t        sha1, sha256, hashtree\n" );
 	fprintf( stream, "\t-D:     specify the description (default is description).\n" );
 	fprintf( stream, "\t-e:     specify the examiner name (default is examiner_name).\n" );
 	fprintf( stream, "\t-E:     specify the evidence number (default is evidence_number).\n" );
@@ -159,6 +162,10 @@ void ewfacquire_usage_fprint(
 	fprintf( stream, "\t-j:     the number of concurrent processing jobs (threads), where\n"
 	                 "\t        a number of 0 represents single-threaded mode (default is 4\n"
 	                 "\t        if multi-threaded mode is supported)\n" );
+	fprintf( stream, "\t-k:     the number of concurrent reads of a device (readers), where\n"
+	                 "\t        a number of 0 represents synchronous reads (default is 0)\n"
+	                 "\t        a read error is retried by a separate thread while the other\n"
+	                 "\t        reads continue, requires multi-threaded mode (-j)\n" );
 	fprintf( stream, "\t-l:     logs acquiry errors and the digest (hash) to the log_filename\n" );
 	fprintf( stream, "\t-m:     specify the media type, options: fixed (default), removable,\n"
 	                 "\t        optical, memory\n" );
@@ -595,10 +602,12 @@ int ewfacquire_read_input(
 	ssize_t process_count                        = 0;
 	ssize_t write_count                          = 0;
 	uint32_t chunk_size                          = 0;
+	uint8_t device_reader_started                = 0;
 	uint8_t storage_media_buffer_mode            = 0;
 	int maximum_number_of_queued_items           = 0;
 	int number_of_read_errors                    = 0;
 	int read_error_iterator                      = 0;
+	int result                                   = 0;
 	int status                                   = PROCESS_STATUS_COMPLETED;
 
 	if( imaging_handle == NULL )
@@ -769,7 +778,11 @@ int ewfacquire_read_input(
 
 		goto on_error;
 	}
-	if( use_chunk_data_functions != 0 )
+	/* Adaptive compression chooses the compression level per chunk
+	 * hence it requires the chunk data functions
+	 */
+	if( ( use_chunk_data_functions != 0 )
+	 || ( imaging_handle->use_adaptive_compression != 0 ) )
 	{
 		process_buffer_size       = (size_t) chunk_size;
 		storage_media_buffer_mode = STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA;
@@ -789,7 +802,21 @@ int ewfacquire_read_input(
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 	if( imaging_handle->number_of_threads != 0 )
 	{
-		maximum_number_of_queued_items = 1 + ( ( 512 * 1024 * 1024 ) / process_buffer_size );
+		if( storage_media_buffer_queue_get_maximum_number_of_values(
+		     imaging_handle->number_of_threads,
+		     process_buffer_size,
+		     &maximum_number_of_queued_items,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine maximum number of queued items.",
+			 function );
+
+			goto on_error;
+		}
 
 		if( libcthreads_thread_pool_create(
 		     &( imaging_handle->process_thread_pool ),
@@ -844,6 +871,7 @@ int ewfacquire_read_input(
 		     &( imaging_handle->storage_media_buffer_queue ),
 		     imaging_handle->output_handle,
 		     maximum_number_of_queued_items,
+		     1,
 		     storage_media_buffer_mode,
 		     process_buffer_size,
 		     error ) != 1 )
@@ -859,6 +887,19 @@ int ewfacquire_read_input(
 		}
 	}
 #endif
+	if( imaging_handle_initialize_compression_level_controller(
+	     imaging_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize compression level controller.",
+		 function );
+
+		goto on_error;
+	}
 	if( imaging_handle_initialize_integrity_hash(
 	     imaging_handle,
 	     error ) != 1 )
@@ -931,11 +972,80 @@ int ewfacquire_read_input(
 			break;
 		}
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
-		if( ( storage_media_buffer == NULL )
-		 && ( imaging_handle->number_of_threads != 0 ) )
+		/* Once the resumed data has been read the device reader
+		 * reads the remaining data asynchronously
+		 */
+		if( ( device_handle->device_reader != NULL )
+		 && ( imaging_handle->number_of_threads != 0 )
+		 && ( imaging_handle->last_offset_written >= resume_acquiry_offset ) )
+		{
+			if( device_reader_started == 0 )
+			{
+				if( storage_media_buffer != NULL )
+				{
+					if( storage_media_buffer_queue_release_buffer(
+					     imaging_handle->storage_media_buffer_queue,
+					     storage_media_buffer,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+						 "%s: unable to release storage media buffer onto queue.",
+						 function );
+
+						goto on_error;
+					}
+					storage_media_buffer = NULL;
+				}
+				if( device_reader_start(
+				     device_handle->device_reader,
+				     imaging_handle->storage_media_buffer_queue,
+				     (off64_t) imaging_handle->acquiry_offset + storage_media_offset,
+				     storage_media_offset,
+				     remaining_aquiry_size,
+				     process_buffer_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to start device reader.",
+					 function );
+
+					goto on_error;
+				}
+				device_reader_started = 1;
+			}
+			result = device_reader_get_next_buffer(
+			          device_handle->device_reader,
+			          &storage_media_buffer,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to retrieve storage media buffer from device reader.",
+				 function );
+
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				break;
+			}
+		}
+		else if( ( storage_media_buffer == NULL )
+		      && ( imaging_handle->number_of_threads != 0 ) )
 		{
 			if( storage_media_buffer_queue_grab_buffer(
 			     imaging_handle->storage_media_buffer_queue,
+			     0,
 			     &storage_media_buffer,
 			     error ) != 1 )
 			{
@@ -1038,6 +1148,13 @@ int ewfacquire_read_input(
 			storage_media_offset  += read_count;
 			remaining_aquiry_size -= read_count;
 		}
+		else if( device_reader_started != 0 )
+		{
+			read_count = (ssize_t) storage_media_buffer->raw_buffer_data_size;
+
+			storage_media_offset  += read_count;
+			remaining_aquiry_size -= read_count;
+		}
 		else
 		{
 			read_count = device_handle_read_storage_media_buffer(
@@ -1167,7 +1284,8 @@ int ewfacquire_read_input(
 #endif
 		else
 		{
-			process_count = storage_media_buffer_write_process(
+			process_count = imaging_handle_process_storage_media_buffer(
+					 imaging_handle,
 					 storage_media_buffer,
 					 error );
 
@@ -1218,6 +1336,26 @@ int ewfacquire_read_input(
 			}
 		}
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( device_reader_started != 0 )
+	{
+		device_reader_started = 0;
+
+		if( device_reader_join(
+		     device_handle->device_reader,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join device reader.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
 	if( imaging_handle->number_of_threads == 0 )
 	{
 		if( storage_media_buffer_free(
@@ -1460,6 +1598,20 @@ int ewfacquire_read_input(
 
 			goto on_error;
 		}
+		if( imaging_handle_print_compression_levels(
+		     imaging_handle,
+		     imaging_handle->notify_stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print compression levels.",
+			 function );
+
+			goto on_error;
+		}
 		if( log_handle != NULL )
 		{
 			if( device_handle_read_errors_fprint(
@@ -1490,6 +1642,20 @@ int ewfacquire_read_input(
 
 				goto on_error;
 			}
+			if( imaging_handle_print_compression_levels(
+			     imaging_handle,
+			     log_handle->log_stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print compression levels in log handle.",
+				 function );
+
+				goto on_error;
+			}
 		}
 	}
 	return( 1 );
@@ -1514,6 +1680,21 @@ on_error:
 		 NULL );
 	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( device_reader_started != 0 )
+	{
+		/* Hand back the buffer so that the device reader threads can stop
+		 */
+		if( storage_media_buffer != NULL )
+		{
+			storage_media_buffer_queue_release_buffer(
+			 imaging_handle->storage_media_buffer_queue,
+			 storage_media_buffer,
+			 NULL );
+		}
+		device_reader_join(
+		 device_handle->device_reader,
+		 NULL );
+	}
 	if( imaging_handle->process_thread_pool != NULL )
 	{
 		libcthreads_thread_pool_join(
@@ -1576,6 +1757,7 @@ int main( int argc, char * const argv[] )
 	system_character_t *option_notes                     = NULL;
 	system_character_t *option_number_of_error_retries   = NULL;
 	system_character_t *option_number_of_jobs            = NULL;
+	system_character_t *option_number_of_readers         = NULL;
 	system_character_t *option_offset                    = NULL;
 	system_character_t *option_process_buffer_size       = NULL;
 	system_character_t *option_secondary_target_filename = NULL;
@@ -1633,7 +1815,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = ewftools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "A:b:B:c:C:d:D:e:E:f:g:hj:l:m:M:N:o:p:P:qr:RsS:t:T:uvVwx2:" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "A:b:B:c:C:d:D:e:E:f:g:hj:k:l:m:M:N:o:p:P:qr:RsS:t:T:uvVwx2:" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -1723,6 +1905,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'k':
+				option_number_of_readers = optarg;
+
+				break;
+
 			case (system_integer_t) 'l':
 				log_filename = optarg;
 
@@ -1947,6 +2134,29 @@ int main( int argc, char * const argv[] )
 	{
 		ewfacquire_device_handle->zero_buffer_on_error = 1;
 	}
+	if( option_number_of_readers != NULL )
+	{
+		result = device_handle_set_number_of_readers(
+			  ewfacquire_device_handle,
+			  option_number_of_readers,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of readers.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of readers defaulting to: %d.\n",
+			 ewfacquire_device_handle->number_of_readers );
+		}
+	}
 	/* Open the input file or device size
 	 */
 	if( device_handle_open_input(
@@ -2546,7 +2756,7 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 		else if( ( result == 0 )
-		      || ( ewfacquire_imaging_handle->number_of_threads > (int) 32 ) )
+		      || ( ewfacquire_imaging_handle->number_of_threads > (int) EWFCOMMON_MAXIMUM_NUMBER_OF_THREADS ) )
 		{
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 			ewfacquire_imaging_handle->number_of_threads = 4;
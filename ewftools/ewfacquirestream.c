@@ -55,6 +55,7 @@
 #include "process_status.h"
 #include "storage_media_buffer.h"
 #include "storage_media_buffer_queue.h"
+#include "stream_reader.h"
 
 imaging_handle_t *ewfacquirestream_imaging_handle = NULL;
 int ewfacquirestream_abort                        = 0;
@@ -117,7 +118,8 @@ void usage_fprint(
 	                 "                        [ -C case_number ] [ -d digest_type ]\n"
 	                 "                        [ -D description ] [ -e examiner_name ]\n"
 	                 "                        [ -E evidence_number ] [ -f format ] [ -j jobs ]\n"
-	                 "                        [ -l log_filename ] [ -m media_type ]\n"
+	                 "                        [ -k input_buffer_size ] [ -l log_filename ]\n"
+	                 "                        [ -m media_type ]\n"
 	                 "                        [ -M media_flags ] [ -N notes ]\n"
 	                 "                        [ -o offset ] [ -p process_buffer_size ]\n"
 	                 "                        [ -P bytes_per_sector ] [ -S segment_file_size ]\n"
@@ -143,10 +145,13 @@ void usage_fprint(
 	                 "\t    compression method options: deflate (default)\n"
 #endif
 	                 "\t    compression level options: none (default), empty-block,\n"
-	                 "\t    fast or best\n" );
+	                 "\t    fast, best or adaptive[=minimum,maximum]\n"
+	                 "\t    adaptive chooses the level per chunk between minimum\n"
+	                 "\t    (default is empty-block) and maximum (default is best)\n"
+	                 "\t    and implies -x\n" );
 	fprintf( stream, "\t-C: specify the case number (default is case_number).\n" );
 	fprintf( stream, "\t-d: calculate additional digest (hash) types besides md5, options:\n"
-	                 "\t    sha1, sha256\n" );
+	                 "\t    sha1, sha256, hashtree\n" );
 	fprintf( stream, "\t-D: specify the description (default is description).\n" );
 	fprintf( stream, "\t-e: specify the examiner name (default is examiner_name).\n" );
 	fprintf( stream, "\t-E: specify the evidence number (default is evidence_number).\n" );
@@ -157,6 +162,10 @@ void usage_fprint(
 	fprintf( stream, "\t-j: the number of concurrent processing jobs (threads), where\n"
 	                 "\t    a number of 0 represents single-threaded mode (default is 4\n"
 	                 "\t    if multi-threaded mode is supported)\n" );
+	fprintf( stream, "\t-k: specify the size of the buffer the input is read into ahead of\n"
+	                 "\t    processing by a dedicated reader thread, where a size of 0\n"
+	                 "\t    represents reading the input in the processing loop (default\n"
+	                 "\t    is 16 MiB if multi-threaded mode is supported)\n" );
 	fprintf( stream, "\t-l: logs acquiry errors and the digest (hash) to the log_filename\n" );
 	fprintf( stream, "\t-m: specify the media type, options: fixed (default), removable,\n"
 	                 "\t    optical, memory\n" );
@@ -509,6 +518,11 @@ int ewfacquirestream_read_input(
 	int maximum_number_of_queued_items           = 0;
 	int status                                   = PROCESS_STATUS_COMPLETED;
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	stream_reader_t *stream_reader               = NULL;
+	size64_t maximum_input_size                  = 0;
+#endif
+
 	if( imaging_handle == NULL )
 	{
 		libcerror_error_set(
@@ -580,7 +594,11 @@ int ewfacquirestream_read_input(
 
 		return( -1 );
 	}
-	if( use_chunk_data_functions != 0 )
+	/* Adaptive compression chooses the compression level per chunk
+	 * hence it requires the chunk data functions
+	 */
+	if( ( use_chunk_data_functions != 0 )
+	 || ( imaging_handle->use_adaptive_compression != 0 ) )
 	{
 		process_buffer_size       = (size_t) chunk_size;
 		storage_media_buffer_mode = STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA;
@@ -600,7 +618,21 @@ int ewfacquirestream_read_input(
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 	if( imaging_handle->number_of_threads != 0 )
 	{
-		maximum_number_of_queued_items = 1 + ( ( 512 * 1024 * 1024 ) / process_buffer_size );
+		if( storage_media_buffer_queue_get_maximum_number_of_values(
+		     imaging_handle->number_of_threads,
+		     process_buffer_size,
+		     &maximum_number_of_queued_items,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine maximum number of queued items.",
+			 function );
+
+			goto on_error;
+		}
 
 		if( libcthreads_thread_pool_create(
 		     &( imaging_handle->process_thread_pool ),
@@ -655,6 +687,7 @@ int ewfacquirestream_read_input(
 		     &( imaging_handle->storage_media_buffer_queue ),
 		     imaging_handle->output_handle,
 		     maximum_number_of_queued_items,
+		     1,
 		     storage_media_buffer_mode,
 		     process_buffer_size,
 		     error ) != 1 )
@@ -670,6 +703,19 @@ int ewfacquirestream_read_input(
 		}
 	}
 #endif
+	if( imaging_handle_initialize_compression_level_controller(
+	     imaging_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize compression level controller.",
+		 function );
+
+		goto on_error;
+	}
 	if( imaging_handle_initialize_integrity_hash(
 	     imaging_handle,
 	     error ) != 1 )
@@ -733,6 +779,45 @@ int ewfacquirestream_read_input(
 			goto on_error;
 		}
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( imaging_handle->input_buffer_size != 0 )
+	{
+		if( imaging_handle->acquiry_size != 0 )
+		{
+			maximum_input_size = imaging_handle->acquiry_offset + imaging_handle->acquiry_size;
+		}
+		if( stream_reader_initialize(
+		     &stream_reader,
+		     input_file_descriptor,
+		     imaging_handle->input_buffer_size,
+		     maximum_input_size,
+		     read_error_retries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create stream reader.",
+			 function );
+
+			goto on_error;
+		}
+		if( stream_reader_start(
+		     stream_reader,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to start stream reader.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
 	remaining_aquiry_size = imaging_handle->acquiry_size;
 	skip_aquiry_size      = imaging_handle->acquiry_offset;
 
@@ -748,6 +833,7 @@ int ewfacquirestream_read_input(
 		{
 			if( storage_media_buffer_queue_grab_buffer(
 			     imaging_handle->storage_media_buffer_queue,
+			     0,
 			     &storage_media_buffer,
 			     error ) != 1 )
 			{
@@ -787,18 +873,42 @@ int ewfacquirestream_read_input(
 		{
 			read_size = (size_t) remaining_aquiry_size;
 		}
-		/* Read a chunk from the file descriptor
-		 */
-		read_count = ewfacquirestream_read_chunk(
-		              imaging_handle->output_handle,
-		              input_file_descriptor,
-		              storage_media_buffer,
-		              storage_media_offset,
-		              storage_media_buffer->raw_buffer_size,
-		              (size32_t) read_size,
-		              read_error_retries,
-		              error );
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( stream_reader != NULL )
+		{
+			read_count = stream_reader_read_storage_media_buffer(
+			              stream_reader,
+			              storage_media_buffer,
+			              storage_media_offset,
+			              read_size,
+			              error );
+
+			/* Closing stdin on abort can cause the reader thread to fail
+			 */
+			if( ( read_count < 0 )
+			 && ( ewfacquirestream_abort != 0 ) )
+			{
+				libcerror_error_free(
+				 error );
 
+				break;
+			}
+		}
+		else
+#endif
+		{
+			/* Read a chunk from the file descriptor
+			 */
+			read_count = ewfacquirestream_read_chunk(
+			              imaging_handle->output_handle,
+			              input_file_descriptor,
+			              storage_media_buffer,
+			              storage_media_offset,
+			              storage_media_buffer->raw_buffer_size,
+			              (size32_t) read_size,
+			              read_error_retries,
+			              error );
+		}
 		if( read_count < 0 )
 		{
 			libcerror_error_set(
@@ -901,7 +1011,8 @@ int ewfacquirestream_read_input(
 		else
 #endif
 		{
-			process_count = storage_media_buffer_write_process(
+			process_count = imaging_handle_process_storage_media_buffer(
+			                 imaging_handle,
 			                 storage_media_buffer,
 			                 error );
 
@@ -951,6 +1062,53 @@ int ewfacquirestream_read_input(
 			}
 		}
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( stream_reader != NULL )
+	{
+		if( ewfacquirestream_abort != 0 )
+		{
+			if( stream_reader_signal_abort(
+			     stream_reader,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to signal stream reader to abort.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( stream_reader_join(
+		     stream_reader,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join stream reader.",
+			 function );
+
+			goto on_error;
+		}
+		if( stream_reader_free(
+		     &stream_reader,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free stream reader.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
 	if( imaging_handle->number_of_threads == 0 )
 	{
 		if( storage_media_buffer_free(
@@ -1125,6 +1283,20 @@ int ewfacquirestream_read_input(
 
 			goto on_error;
 		}
+		if( imaging_handle_print_compression_levels(
+		     imaging_handle,
+		     imaging_handle->notify_stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print compression levels.",
+			 function );
+
+			goto on_error;
+		}
 		if( log_handle != NULL )
 		{
 			if( imaging_handle_print_hashes(
@@ -1141,6 +1313,20 @@ int ewfacquirestream_read_input(
 
 				goto on_error;
 			}
+			if( imaging_handle_print_compression_levels(
+			     imaging_handle,
+			     log_handle->log_stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print compression levels in log handle.",
+				 function );
+
+				goto on_error;
+			}
 		}
 	}
 	return( 1 );
@@ -1165,6 +1351,18 @@ on_error:
 		 NULL );
 	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( stream_reader != NULL )
+	{
+		stream_reader_signal_abort(
+		 stream_reader,
+		 NULL );
+		stream_reader_join(
+		 stream_reader,
+		 NULL );
+		stream_reader_free(
+		 &stream_reader,
+		 NULL );
+	}
 	if( imaging_handle->process_thread_pool != NULL )
 	{
 		libcthreads_thread_pool_join(
@@ -1217,6 +1415,7 @@ int main( int argc, char * const argv[] )
 	system_character_t *option_examiner_name             = NULL;
 	system_character_t *option_format                    = NULL;
 	system_character_t *option_header_codepage           = NULL;
+	system_character_t *option_input_buffer_size         = NULL;
 	system_character_t *option_maximum_segment_size      = NULL;
 	system_character_t *option_media_flags               = NULL;
 	system_character_t *option_media_type                = NULL;
@@ -1300,7 +1499,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = ewftools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "A:b:B:c:C:d:D:e:E:f:hj:l:m:M:N:o:p:P:qsS:t:vVx2:" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "A:b:B:c:C:d:D:e:E:f:hj:k:l:m:M:N:o:p:P:qsS:t:vVx2:" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -1385,6 +1584,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'k':
+				option_input_buffer_size = optarg;
+
+				break;
+
 			case (system_integer_t) 'l':
 				log_filename = optarg;
 
@@ -1944,6 +2148,33 @@ int main( int argc, char * const argv[] )
 			 "Unsupported process buffer size defaulting to: chunk size.\n" );
 		}
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	ewfacquirestream_imaging_handle->input_buffer_size = STREAM_READER_DEFAULT_BUFFER_SIZE;
+#endif
+
+	if( option_input_buffer_size != NULL )
+	{
+		result = imaging_handle_set_input_buffer_size(
+			  ewfacquirestream_imaging_handle,
+			  option_input_buffer_size,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set input buffer size.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported input buffer size defaulting to: %" PRIzd ".\n",
+			 ewfacquirestream_imaging_handle->input_buffer_size );
+		}
+	}
 	if( option_number_of_jobs != NULL )
 	{
 		result = imaging_handle_set_number_of_threads(
@@ -1960,7 +2191,7 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 		else if( ( result == 0 )
-		      || ( ewfacquirestream_imaging_handle->number_of_threads > (int) 32 ) )
+		      || ( ewfacquirestream_imaging_handle->number_of_threads > (int) EWFCOMMON_MAXIMUM_NUMBER_OF_THREADS ) )
 		{
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 			ewfacquirestream_imaging_handle->number_of_threads = 4;
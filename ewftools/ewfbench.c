@@ -0,0 +1,858 @@
+/*
+ * Measures the throughput of libewf using synthetic EWF images
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "bench_handle.h"
+#include "ewfcommon.h"
+#include "ewftools_getopt.h"
+#include "ewftools_libcerror.h"
+#include "ewftools_libclocale.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libewf.h"
+#include "ewftools_output.h"
+#include "ewftools_signal.h"
+#include "ewftools_unused.h"
+
+#define EWFBENCH_DEFAULT_TOLERANCE	10
+
+bench_handle_t *ewfbench_bench_handle = NULL;
+int ewfbench_abort                    = 0;
+
+/* Prints the executable usage information to the stream
+ */
+void usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use ewfbench to measure the throughput of libewf using synthetic EWF\n"
+	                 "(Expert Witness Compression Format) images.\n\n" );
+
+	fprintf( stream, "Usage: ewfbench [ -b number_of_sectors ] [ -B media_size ]\n"
+	                 "                [ -c compression_values ] [ -e entropy_mix ]\n"
+	                 "                [ -f format ] [ -j number_of_threads ]\n"
+	                 "                [ -n number_of_random_reads ]\n"
+	                 "                [ -o maximum_number_of_open_handles ]\n"
+	                 "                [ -r baseline_file ] [ -R tolerance ] [ -s seed ]\n"
+	                 "                [ -S segment_file_size ] [ -t target ]\n"
+	                 "                [ -w results_file ] [ -hvV ]\n\n" );
+
+	fprintf( stream, "\t-b:        specify the number of sectors to use as chunk size\n"
+	                 "\t           (default is 64), options: 16, 32, 64, 128, 256, 512,\n"
+	                 "\t           1024, 2048, 4096, 8192, 16384 or 32768\n" );
+	fprintf( stream, "\t-B:        specify the size of the media data of the synthetic\n"
+	                 "\t           image (default is 64 MiB)\n" );
+	fprintf( stream, "\t-c:        specify the compression values as: level or method:level\n"
+	                 "\t           compression method options: deflate (default),\n"
+	                 "\t           bzip2 (bzip2 is only supported by EWF2 formats)\n"
+	                 "\t           compression level options: none, empty-block,\n"
+	                 "\t           fast (default) or best\n" );
+	fprintf( stream, "\t-e:        specify the percentages of zero, text and random chunks\n"
+	                 "\t           as: zero:text:random (default is 25:25:50)\n" );
+	fprintf( stream, "\t-f:        specify the EWF file format to write to, options: ewf,\n"
+	                 "\t           smart, ftk, encase2, encase3, encase4, encase5,\n"
+	                 "\t           encase6 (default), encase7, encase7-v2, linen5, linen6,\n"
+	                 "\t           linen7, ewfx\n" );
+	fprintf( stream, "\t-h:        shows this help\n" );
+	fprintf( stream, "\t-j:        specify a comma separated list of the number of reader\n"
+	                 "\t           threads (default is 1), e.g. 1,2,4\n" );
+	fprintf( stream, "\t-n:        specify the number of random reads (default is 1024)\n" );
+	fprintf( stream, "\t-o:        specify a comma separated list of the process-wide\n"
+	                 "\t           maximum number of open handles, 0 represents no maximum\n"
+	                 "\t           (default is 0), e.g. 0,1,8\n" );
+	fprintf( stream, "\t-r:        specify the results file of a previous run to compare with\n" );
+	fprintf( stream, "\t-R:        specify the percentage a result can be slower than its\n"
+	                 "\t           baseline before it is considered a regression\n"
+	                 "\t           (default is 10)\n" );
+	fprintf( stream, "\t-s:        specify the seed of the synthetic data (default is 1)\n" );
+	fprintf( stream, "\t-S:        specify the segment file size in bytes (default is 1.4 GiB)\n"
+	                 "\t           (minimum is 1.0 MiB, maximum is 2.0 GiB)\n" );
+	fprintf( stream, "\t-t:        specify the target path of the synthetic image\n"
+	                 "\t           (default is ewfbench), the segment files and RAW export\n"
+	                 "\t           file are removed afterwards\n" );
+	fprintf( stream, "\t-v:        verbose output to stderr\n" );
+	fprintf( stream, "\t-V:        print version\n" );
+	fprintf( stream, "\t-w:        specify the file to write the results to (default is stdout)\n" );
+}
+
+/* Signal handler for ewfbench
+ */
+void ewfbench_signal_handler(
+      ewftools_signal_t signal EWFTOOLS_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function   = "ewfbench_signal_handler";
+
+	EWFTOOLS_UNREFERENCED_PARAMETER( signal )
+
+	ewfbench_abort = 1;
+
+	if( ewfbench_bench_handle != NULL )
+	{
+		if( bench_handle_signal_abort(
+		     ewfbench_bench_handle,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal bench handle to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	/* Force stdin to close otherwise any function reading it will remain blocked
+	 */
+#if defined( WINAPI ) && !defined( __CYGWIN__ )
+	if( _close(
+	     0 ) != 0 )
+#else
+	if( close(
+	     0 ) != 0 )
+#endif
+	{
+		libcnotify_printf(
+		 "%s: unable to close stdin.\n",
+		 function );
+	}
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	int tolerance_values[ 1 ];
+
+	libcerror_error_t *error                            = NULL;
+	FILE *results_stream                                = NULL;
+	system_character_t *option_baseline_filename        = NULL;
+	system_character_t *option_compression_values       = NULL;
+	system_character_t *option_entropy_mix              = NULL;
+	system_character_t *option_format                   = NULL;
+	system_character_t *option_maximum_open_handles     = NULL;
+	system_character_t *option_media_size               = NULL;
+	system_character_t *option_number_of_random_reads   = NULL;
+	system_character_t *option_number_of_threads        = NULL;
+	system_character_t *option_results_filename         = NULL;
+	system_character_t *option_sectors_per_chunk        = NULL;
+	system_character_t *option_seed                     = NULL;
+	system_character_t *option_segment_size             = NULL;
+	system_character_t *option_target_path              = _SYSTEM_STRING( "ewfbench" );
+	system_character_t *option_tolerance                = NULL;
+	system_character_t *program                         = _SYSTEM_STRING( "ewfbench" );
+	system_integer_t option                             = 0;
+	uint8_t verbose                                     = 0;
+	int number_of_tolerance_values                      = 0;
+	int result                                          = 1;
+	int tolerance                                       = EWFBENCH_DEFAULT_TOLERANCE;
+
+	libcnotify_stream_set(
+	 stderr,
+	 NULL );
+	libcnotify_verbose_set(
+	 1 );
+
+	if( libclocale_initialize(
+             "ewftools",
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize locale values.\n" );
+
+		goto on_error;
+	}
+	if( ewftools_output_initialize(
+	     _IONBF,
+	     &error ) != 1 )
+	{
+		ewfoutput_version_fprint(
+		 stderr,
+		 program );
+
+		fprintf(
+		 stderr,
+		 "Unable to initialize output settings.\n" );
+
+		goto on_error;
+	}
+	while( ( option = ewftools_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "b:B:c:e:f:hj:n:o:r:R:s:S:t:vVw:" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				ewfoutput_version_fprint(
+				 stderr,
+				 program );
+
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM ".\n",
+				 argv[ optind ] );
+
+				usage_fprint(
+				 stderr );
+
+				goto on_error;
+
+			case (system_integer_t) 'b':
+				option_sectors_per_chunk = optarg;
+
+				break;
+
+			case (system_integer_t) 'B':
+				option_media_size = optarg;
+
+				break;
+
+			case (system_integer_t) 'c':
+				option_compression_values = optarg;
+
+				break;
+
+			case (system_integer_t) 'e':
+				option_entropy_mix = optarg;
+
+				break;
+
+			case (system_integer_t) 'f':
+				option_format = optarg;
+
+				break;
+
+			case (system_integer_t) 'h':
+				ewfoutput_version_fprint(
+				 stderr,
+				 program );
+
+				usage_fprint(
+				 stderr );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'j':
+				option_number_of_threads = optarg;
+
+				break;
+
+			case (system_integer_t) 'n':
+				option_number_of_random_reads = optarg;
+
+				break;
+
+			case (system_integer_t) 'o':
+				option_maximum_open_handles = optarg;
+
+				break;
+
+			case (system_integer_t) 'r':
+				option_baseline_filename = optarg;
+
+				break;
+
+			case (system_integer_t) 'R':
+				option_tolerance = optarg;
+
+				break;
+
+			case (system_integer_t) 's':
+				option_seed = optarg;
+
+				break;
+
+			case (system_integer_t) 'S':
+				option_segment_size = optarg;
+
+				break;
+
+			case (system_integer_t) 't':
+				option_target_path = optarg;
+
+				break;
+
+			case (system_integer_t) 'v':
+				verbose = 1;
+
+				break;
+
+			case (system_integer_t) 'V':
+				ewfoutput_version_fprint(
+				 stderr,
+				 program );
+
+				ewfoutput_copyright_fprint(
+				 stderr );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'w':
+				option_results_filename = optarg;
+
+				break;
+		}
+	}
+	if( optind != argc )
+	{
+		ewfoutput_version_fprint(
+		 stderr,
+		 program );
+
+		fprintf(
+		 stderr,
+		 "Unsupported argument: %" PRIs_SYSTEM ".\n",
+		 argv[ optind ] );
+
+		usage_fprint(
+		 stderr );
+
+		goto on_error;
+	}
+	ewfoutput_version_fprint(
+	 stderr,
+	 program );
+
+	libcnotify_verbose_set(
+	 verbose );
+
+#if !defined( HAVE_LOCAL_LIBEWF )
+	libewf_notify_set_verbose(
+	 verbose );
+	libewf_notify_set_stream(
+	 stderr,
+	 NULL );
+#endif
+
+	if( bench_handle_initialize(
+	     &ewfbench_bench_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create bench handle.\n" );
+
+		goto on_error;
+	}
+	ewfbench_bench_handle->notify_stream = stderr;
+
+	if( bench_handle_set_target_path(
+	     ewfbench_bench_handle,
+	     option_target_path,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set target path.\n" );
+
+		goto on_error;
+	}
+	/* The format is set first since it determines the supported compression methods
+	 */
+	if( option_format != NULL )
+	{
+		result = bench_handle_set_format(
+			  ewfbench_bench_handle,
+			  option_format,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set format.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported EWF file format type: %" PRIs_SYSTEM ".\n",
+			 option_format );
+
+			goto on_error;
+		}
+	}
+	if( option_compression_values != NULL )
+	{
+		result = bench_handle_set_compression_values(
+			  ewfbench_bench_handle,
+			  option_compression_values,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set compression values.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported compression values: %" PRIs_SYSTEM ".\n",
+			 option_compression_values );
+
+			goto on_error;
+		}
+	}
+	if( option_sectors_per_chunk != NULL )
+	{
+		result = bench_handle_set_sectors_per_chunk(
+			  ewfbench_bench_handle,
+			  option_sectors_per_chunk,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set sectors per chunk.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported sectors per chunk: %" PRIs_SYSTEM ".\n",
+			 option_sectors_per_chunk );
+
+			goto on_error;
+		}
+	}
+	if( option_segment_size != NULL )
+	{
+		result = bench_handle_set_maximum_segment_size(
+			  ewfbench_bench_handle,
+			  option_segment_size,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set maximum segment size.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported maximum segment size: %" PRIs_SYSTEM ".\n",
+			 option_segment_size );
+
+			goto on_error;
+		}
+	}
+	if( option_media_size != NULL )
+	{
+		result = bench_handle_set_media_size(
+			  ewfbench_bench_handle,
+			  option_media_size,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set media size.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported media size: %" PRIs_SYSTEM ".\n",
+			 option_media_size );
+
+			goto on_error;
+		}
+	}
+	if( option_entropy_mix != NULL )
+	{
+		result = bench_handle_set_entropy_mix(
+			  ewfbench_bench_handle,
+			  option_entropy_mix,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set entropy mix.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported entropy mix: %" PRIs_SYSTEM ".\n",
+			 option_entropy_mix );
+
+			goto on_error;
+		}
+	}
+	if( option_number_of_random_reads != NULL )
+	{
+		result = bench_handle_set_number_of_random_reads(
+			  ewfbench_bench_handle,
+			  option_number_of_random_reads,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of random reads.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of random reads: %" PRIs_SYSTEM ".\n",
+			 option_number_of_random_reads );
+
+			goto on_error;
+		}
+	}
+	if( option_seed != NULL )
+	{
+		result = bench_handle_set_seed(
+			  ewfbench_bench_handle,
+			  option_seed,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set seed.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported seed: %" PRIs_SYSTEM ".\n",
+			 option_seed );
+
+			goto on_error;
+		}
+	}
+	if( option_number_of_threads != NULL )
+	{
+		result = bench_handle_set_number_of_threads(
+			  ewfbench_bench_handle,
+			  option_number_of_threads,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of threads.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of threads: %" PRIs_SYSTEM ".\n",
+			 option_number_of_threads );
+
+			goto on_error;
+		}
+	}
+	if( option_maximum_open_handles != NULL )
+	{
+		result = bench_handle_set_maximum_number_of_open_handles(
+			  ewfbench_bench_handle,
+			  option_maximum_open_handles,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set maximum number of open handles.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported maximum number of open handles: %" PRIs_SYSTEM ".\n",
+			 option_maximum_open_handles );
+
+			goto on_error;
+		}
+	}
+	if( option_tolerance != NULL )
+	{
+		result = bench_handle_parse_values(
+			  option_tolerance,
+			  (system_character_t) ',',
+			  tolerance_values,
+			  1,
+			  &number_of_tolerance_values,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to determine tolerance.\n" );
+
+			goto on_error;
+		}
+		else if( ( result == 0 )
+		      || ( tolerance_values[ 0 ] > 100 ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported tolerance: %" PRIs_SYSTEM ".\n",
+			 option_tolerance );
+
+			goto on_error;
+		}
+		tolerance = tolerance_values[ 0 ];
+	}
+	if( ewftools_signal_attach(
+	     ewfbench_signal_handler,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to attach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	result = bench_handle_run(
+	          ewfbench_bench_handle,
+	          &error );
+
+	if( result != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to run benchmarks.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( ( ewfbench_abort == 0 )
+	 && ( result == 1 ) )
+	{
+		if( option_results_filename != NULL )
+		{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+			results_stream = file_stream_open_wide(
+			                  option_results_filename,
+			                  _SYSTEM_STRING( FILE_STREAM_OPEN_WRITE ) );
+#else
+			results_stream = file_stream_open(
+			                  option_results_filename,
+			                  FILE_STREAM_OPEN_WRITE );
+#endif
+			if( results_stream == NULL )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to open results file.\n" );
+
+				goto on_error;
+			}
+		}
+		if( bench_handle_results_fprint(
+		     ewfbench_bench_handle,
+		     ( results_stream != NULL ) ? results_stream : stdout,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to print results.\n" );
+
+			goto on_error;
+		}
+		if( results_stream != NULL )
+		{
+			if( file_stream_close(
+			     results_stream ) != 0 )
+			{
+				results_stream = NULL;
+
+				fprintf(
+				 stderr,
+				 "Unable to close results file.\n" );
+
+				goto on_error;
+			}
+			results_stream = NULL;
+		}
+		if( option_baseline_filename != NULL )
+		{
+			result = bench_handle_compare_baseline(
+			          ewfbench_bench_handle,
+			          option_baseline_filename,
+			          tolerance,
+			          &error );
+
+			if( result == -1 )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to compare results with baseline.\n" );
+
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				fprintf(
+				 stderr,
+				 "Performance regressions found.\n" );
+			}
+		}
+	}
+	if( ewftools_signal_detach(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to detach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( bench_handle_remove_files(
+	     ewfbench_bench_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to remove synthetic image files.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+
+		result = -1;
+	}
+	if( bench_handle_free(
+	     &ewfbench_bench_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free bench handle.\n" );
+
+		goto on_error;
+	}
+	/* The results are written to stdout so the status is written to stderr
+	 */
+	if( ewfbench_abort != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "%" PRIs_SYSTEM ": ABORTED\n",
+		 program );
+
+		return( EXIT_FAILURE );
+	}
+	if( result != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "%" PRIs_SYSTEM ": FAILURE\n",
+		 program );
+
+		return( EXIT_FAILURE );
+	}
+	fprintf(
+	 stderr,
+	 "%" PRIs_SYSTEM ": SUCCESS\n",
+	 program );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( results_stream != NULL )
+	{
+		file_stream_close(
+		 results_stream );
+	}
+	if( ewfbench_bench_handle != NULL )
+	{
+		bench_handle_remove_files(
+		 ewfbench_bench_handle,
+		 NULL );
+		bench_handle_free(
+		 &ewfbench_bench_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
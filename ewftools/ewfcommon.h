@@ -32,6 +32,13 @@
 #define EWFCOMMON_MAXIMUM_SEGMENT_FILE_SIZE_32BIT	INT32_MAX
 #define EWFCOMMON_MAXIMUM_SEGMENT_FILE_SIZE_64BIT	INT64_MAX
 
+/* The maximum number of jobs (threads) is the number of hardware threads of a 2 socket
+ * system with 32 cores per socket and 2 threads per core. More jobs than hardware threads
+ * do not process chunks faster but add context switches and queued buffers
+ */
+#define EWFCOMMON_MAXIMUM_NUMBER_OF_THREADS		128
+#define EWFCOMMON_MAXIMUM_NUMBER_OF_READERS		16
+
 /* This definition is intended for automated testing of variable process buffer sizes
  */
 #if !defined( EWFCOMMON_PROCESS_BUFFER_SIZE )
@@ -117,9 +117,9 @@ void usage_fprint(
 
 	fprintf( stream, "Usage: ewfexport [ -A codepage ] [ -b number_of_sectors ]\n"
 	                 "                 [ -B number_of_bytes ] [ -c compression_values ]\n"
-	                 "                 [ -d digest_type ] [ -f format ] [ -j jobs ] [ -l log_filename ]\n"
-	                 "                 [ -o offset ] [ -p process_buffer_size ]\n"
-	                 "                 [ -S segment_file_size ] [ -t target ] [ -hqsuvVwx ] ewf_files\n\n" );
+	                 "                 [ -d digest_type ] [ -f format ] [ -j jobs ] [ -k readers ]\n"
+	                 "                 [ -l log_filename ] [ -o offset ] [ -p process_buffer_size ]\n"
+	                 "                 [ -S segment_file_size ] [ -t target ] [ -hnqsuvVwx ] ewf_files\n\n" );
 
 	fprintf( stream, "\tewf_files: the first or the entire set of EWF segment files\n\n" );
 
@@ -152,7 +152,14 @@ void usage_fprint(
 	fprintf( stream, "\t-j:        the number of concurrent processing jobs (threads), where\n"
 	                 "\t           a number of 0 represents single-threaded mode (default is 4\n"
 	                 "\t           if multi-threaded mode is supported)\n" );
+	fprintf( stream, "\t-k:        the number of dedicated reader threads that read ahead of\n"
+	                 "\t           the processing jobs, where a number of 0 represents reading\n"
+	                 "\t           by the main thread (default is 0), requires jobs to be 1 or\n"
+	                 "\t           more\n" );
 	fprintf( stream, "\t-l:        logs export errors and the digest (hash) to the log_filename\n" );
+	fprintf( stream, "\t-n:        bind the reader threads round-robin to the NUMA nodes, if\n"
+	                 "\t           supported, so that the buffers of a reader are allocated\n"
+	                 "\t           on its node, requires readers to be 1 or more\n" );
 	fprintf( stream, "\t-o:        specify the offset to start the export (default is 0)\n" );
 	fprintf( stream, "\t-p:        specify the process buffer size (default is the chunk size)\n" );
 	fprintf( stream, "\t-q:        quiet shows minimal status information\n" );
@@ -263,6 +270,7 @@ int main( int argc, char * const argv[] )
 	system_character_t *option_header_codepage         = NULL;
 	system_character_t *option_maximum_segment_size    = NULL;
 	system_character_t *option_number_of_jobs          = NULL;
+	system_character_t *option_number_of_readers       = NULL;
 	system_character_t *option_offset                  = NULL;
 	system_character_t *option_process_buffer_size     = NULL;
 	system_character_t *option_sectors_per_chunk       = NULL;
@@ -272,6 +280,7 @@ int main( int argc, char * const argv[] )
 	system_character_t *request_string                 = NULL;
 	system_integer_t option                            = 0;
 	uint8_t calculate_md5                              = 1;
+	uint8_t numa_node_affinity                         = 0;
 	uint8_t print_status_information                   = 1;
 	uint8_t swap_byte_pairs                            = 0;
 	uint8_t use_chunk_data_functions                   = 0;
@@ -342,7 +351,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = ewftools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "A:b:B:c:d:f:hj:l:o:p:qsS:t:uvVwx" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "A:b:B:c:d:f:hj:k:l:no:p:qsS:t:uvVwx" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -407,11 +416,21 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'k':
+				option_number_of_readers = optarg;
+
+				break;
+
 			case (system_integer_t) 'l':
 				log_filename = optarg;
 
 				break;
 
+			case (system_integer_t) 'n':
+				numa_node_affinity = 1;
+
+				break;
+
 			case (system_integer_t) 'o':
 				option_offset = optarg;
 
@@ -555,6 +574,62 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	/* The reader handles are opened together with the input handle
+	 */
+	if( option_number_of_readers != NULL )
+	{
+		result = export_handle_set_number_of_readers(
+			  ewfexport_export_handle,
+			  option_number_of_readers,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of readers.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			ewfexport_export_handle->number_of_readers = 0;
+
+			fprintf(
+			 stderr,
+			 "Unsupported number of readers defaulting to: 0.\n" );
+		}
+#if !defined( HAVE_MULTI_THREAD_SUPPORT )
+		else if( ewfexport_export_handle->number_of_readers != 0 )
+		{
+			ewfexport_export_handle->number_of_readers = 0;
+
+			fprintf(
+			 stderr,
+			 "Reader threads not supported defaulting to: 0.\n" );
+		}
+#endif
+	}
+	if( numa_node_affinity != 0 )
+	{
+		if( ewfexport_export_handle->number_of_readers == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Binding to NUMA nodes requires reader threads, ignoring.\n" );
+		}
+		else if( export_handle_set_numa_node_affinity(
+		          ewfexport_export_handle,
+		          numa_node_affinity,
+		          &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set NUMA node affinity.\n" );
+
+			goto on_error;
+		}
+	}
 #if defined( HAVE_GETRLIMIT )
 	if( getrlimit(
             RLIMIT_NOFILE,
@@ -884,7 +959,7 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 		else if( ( result == 0 )
-		      || ( ewfexport_export_handle->number_of_threads > (int) 32 ) )
+		      || ( ewfexport_export_handle->number_of_threads > (int) EWFCOMMON_MAXIMUM_NUMBER_OF_THREADS ) )
 		{
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 			ewfexport_export_handle->number_of_threads = 4;
@@ -601,6 +601,156 @@ int ewfinput_determine_compression_values(
 	return( result );
 }
 
+/* Determines the adaptive compression values from a string
+ * The string is either: adaptive or adaptive=minimum,maximum
+ * where minimum and maximum are one of the compression level options
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int ewfinput_determine_adaptive_compression_values(
+     const system_character_t *string,
+     int8_t *minimum_compression_level,
+     int8_t *maximum_compression_level,
+     uint8_t *compression_flags,
+     libcerror_error_t **error )
+{
+	system_character_t level_string[ 16 ];
+
+	const system_character_t *separator = NULL;
+	static char *function               = "ewfinput_determine_adaptive_compression_values";
+	size_t level_string_length          = 0;
+	size_t string_length                = 0;
+	uint8_t maximum_compression_flags   = 0;
+	int result                          = 0;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( minimum_compression_level == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid minimum compression level.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_compression_level == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum compression level.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression flags.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( ( string_length < 8 )
+	 || ( system_string_compare(
+	       string,
+	       _SYSTEM_STRING( "adaptive" ),
+	       8 ) != 0 ) )
+	{
+		return( 0 );
+	}
+	if( string_length == 8 )
+	{
+		*minimum_compression_level = LIBEWF_COMPRESSION_NONE;
+		*maximum_compression_level = LIBEWF_COMPRESSION_BEST;
+		*compression_flags         = LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION;
+
+		return( 1 );
+	}
+	if( string[ 8 ] != (system_character_t) '=' )
+	{
+		return( 0 );
+	}
+	separator = system_string_search_character(
+	             &( string[ 9 ] ),
+	             (system_character_t) ',',
+	             string_length - 9 );
+
+	if( separator == NULL )
+	{
+		return( 0 );
+	}
+	level_string_length = (size_t) ( separator - &( string[ 9 ] ) );
+
+	if( level_string_length >= 16 )
+	{
+		return( 0 );
+	}
+	if( system_string_copy(
+	     level_string,
+	     &( string[ 9 ] ),
+	     level_string_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy minimum compression level string.",
+		 function );
+
+		return( -1 );
+	}
+	level_string[ level_string_length ] = 0;
+
+	result = ewfinput_determine_compression_values(
+	          level_string,
+	          minimum_compression_level,
+	          compression_flags,
+	          error );
+
+	if( result != 1 )
+	{
+		return( result );
+	}
+	result = ewfinput_determine_compression_values(
+	          &( separator[ 1 ] ),
+	          maximum_compression_level,
+	          &maximum_compression_flags,
+	          error );
+
+	if( result != 1 )
+	{
+		return( result );
+	}
+	/* The compression levels are ordered none, fast, best
+	 */
+	if( ( *maximum_compression_level == LIBEWF_COMPRESSION_NONE )
+	 || ( ( *minimum_compression_level == LIBEWF_COMPRESSION_BEST )
+	  && ( *maximum_compression_level != LIBEWF_COMPRESSION_BEST ) ) )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
 /* Determines the media type value from a string
  * Returns 1 if successful, 0 if unsupported value or -1 on error
  */
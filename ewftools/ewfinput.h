@@ -86,6 +86,13 @@ int ewfinput_determine_compression_values(
      uint8_t *compression_flags,
      libcerror_error_t **error );
 
+int ewfinput_determine_adaptive_compression_values(
+     const system_character_t *string,
+     int8_t *minimum_compression_level,
+     int8_t *maximum_compression_level,
+     uint8_t *compression_flags,
+     libcerror_error_t **error );
+
 int ewfinput_determine_media_type(
      const system_character_t *string,
      uint8_t *media_type,
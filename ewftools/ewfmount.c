@@ -72,6 +72,7 @@
 #include <dokan.h>
 #endif
 
+#include "byte_size_string.h"
 #include "ewftools_getopt.h"
 #include "ewftools_glob.h"
 #include "ewftools_libcerror.h"
@@ -98,7 +99,8 @@ void usage_fprint(
 	fprintf( stream, "Use ewfmount to mount the EWF format (Expert Witness\n"
                          "Compression Format)\n\n" );
 
-	fprintf( stream, "Usage: ewfmount [ -f format ] [ -X extended_options ] [ -hvV ]\n"
+	fprintf( stream, "Usage: ewfmount [ -f format ] [ -j jobs ] [ -r max_read ]\n"
+	                 "                [ -X extended_options ] [ -hkvV ]\n"
 	                 "                ewf_files mount_point\n\n" );
 
 	fprintf( stream, "\tewf_files:   the first or the entire set of EWF segment files\n\n" );
@@ -107,6 +109,14 @@ void usage_fprint(
 	fprintf( stream, "\t-f:          specify the input format, options: raw (default),\n"
 	                 "\t             files (restricted to logical volume files)\n" );
 	fprintf( stream, "\t-h:          shows this help\n" );
+	fprintf( stream, "\t-j:          the number of concurrent read jobs (threads), where\n"
+	                 "\t             a number of 0 represents single-threaded mode (default\n"
+	                 "\t             is 4 if multi-threaded mode is supported)\n" );
+	fprintf( stream, "\t-k:          retain the data in the kernel page cache when the\n"
+	                 "\t             mounted files are reopened (kernel_cache)\n" );
+	fprintf( stream, "\t-r:          specify the maximum size of a single read request\n"
+	                 "\t             (max_read), where a size of 0 represents the sub\n"
+	                 "\t             system default (default is 0)\n" );
 	fprintf( stream, "\t-v:          verbose output to stderr\n"
 	                 "\t             ewfmount will remain running in the foreground\n" );
 	fprintf( stream, "\t-V:          print version\n" );
@@ -383,27 +393,11 @@ int ewfmount_fuse_read(
 
 			goto on_error;
 		}
-		if( libewf_file_entry_seek_offset(
-		     file_entry,
-		     (off64_t) offset,
-		     SEEK_SET,
-		     &error ) == -1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_SEEK_FAILED,
-			 "%s: unable to seek offset in file entry.",
-			 function );
-
-			result = -EIO;
-
-			goto on_error;
-		}
-		read_count = libewf_file_entry_read_buffer(
+		read_count = libewf_file_entry_read_buffer_at_offset(
 			      file_entry,
 			      (uint8_t *) buffer,
 			      size,
+			      (off64_t) offset,
 			      &error );
 
 		if( read_count == -1 )
@@ -485,27 +479,11 @@ int ewfmount_fuse_read(
 
 			goto on_error;
 		}
-		if( mount_handle_seek_offset(
-		     ewfmount_mount_handle,
-		     (off64_t) offset,
-		     SEEK_SET,
-		     &error ) == -1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_SEEK_FAILED,
-			 "%s: unable to seek offset in mount handle.",
-			 function );
-
-			result = -EIO;
-
-			goto on_error;
-		}
-		read_count = mount_handle_read_buffer(
+		read_count = mount_handle_read_buffer_at_offset(
 			      ewfmount_mount_handle,
 			      (uint8_t *) buffer,
 			      size,
+			      (off64_t) offset,
 			      &error );
 
 		if( read_count == -1 )
@@ -1776,27 +1754,11 @@ int __stdcall ewfmount_dokan_ReadFile(
 
 			goto on_error;
 		}
-		if( libewf_file_entry_seek_offset(
-		     file_entry,
-		     (off64_t) offset,
-		     SEEK_SET,
-		     &error ) == -1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_SEEK_FAILED,
-			 "%s: unable to seek offset in file entry.",
-			 function );
-
-			result = -ERROR_SEEK_ON_DEVICE;
-
-			goto on_error;
-		}
-		read_count = libewf_file_entry_read_buffer(
+		read_count = libewf_file_entry_read_buffer_at_offset(
 			      file_entry,
 			      (uint8_t *) buffer,
 			      (size_t) number_of_bytes_to_read,
+			      (off64_t) offset,
 			      &error );
 
 		if( read_count == -1 )
@@ -1878,27 +1840,11 @@ int __stdcall ewfmount_dokan_ReadFile(
 
 			goto on_error;
 		}
-		if( mount_handle_seek_offset(
-		     ewfmount_mount_handle,
-		     (off64_t) offset,
-		     SEEK_SET,
-		     &error ) == -1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_SEEK_FAILED,
-			 "%s: unable to seek offset in mount handle.",
-			 function );
-
-			result = -ERROR_SEEK_ON_DEVICE;
-
-			goto on_error;
-		}
-		read_count = mount_handle_read_buffer(
+		read_count = mount_handle_read_buffer_at_offset(
 			      ewfmount_mount_handle,
 			      (uint8_t *) buffer,
 			      (size_t) number_of_bytes_to_read,
+			      (off64_t) offset,
 			      &error );
 
 		if( read_count == -1 )
@@ -3102,8 +3048,13 @@ int main( int argc, char * const argv[] )
 	system_character_t *mount_point              = NULL;
 	system_character_t *option_extended_options  = NULL;
 	system_character_t *option_format            = NULL;
+	system_character_t *option_max_read          = NULL;
+	system_character_t *option_number_of_jobs    = NULL;
 	system_character_t *program                  = _SYSTEM_STRING( "ewfmount" );
 	system_integer_t option                      = 0;
+	size_t string_length                         = 0;
+	uint64_t max_read                            = 0;
+	uint8_t use_kernel_cache                     = 0;
 	int number_of_filenames                      = 0;
 	int result                                   = 0;
 	int verbose                                  = 0;
@@ -3115,9 +3066,13 @@ int main( int argc, char * const argv[] )
 #if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBOSXFUSE )
 	struct fuse_operations ewfmount_fuse_operations;
 
+	char ewfmount_fuse_options[ 64 ];
+
 	struct fuse_args ewfmount_fuse_arguments     = FUSE_ARGS_INIT(0, NULL);
 	struct fuse_chan *ewfmount_fuse_channel      = NULL;
 	struct fuse *ewfmount_fuse_handle            = NULL;
+	size_t fuse_options_length                   = 0;
+	int print_count                              = 0;
 
 #elif defined( HAVE_LIBDOKAN )
 	DOKAN_OPERATIONS ewfmount_dokan_operations;
@@ -3157,7 +3112,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = ewftools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "f:hvVX:" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "f:hj:kr:vVX:" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -3184,6 +3139,21 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_SUCCESS );
 
+			case (system_integer_t) 'j':
+				option_number_of_jobs = optarg;
+
+				break;
+
+			case (system_integer_t) 'k':
+				use_kernel_cache = 1;
+
+				break;
+
+			case (system_integer_t) 'r':
+				option_max_read = optarg;
+
+				break;
+
 			case (system_integer_t) 'v':
 				verbose = 1;
 
@@ -3306,6 +3276,68 @@ int main( int argc, char * const argv[] )
 			 "Unsupported input format defaulting to: raw.\n" );
 		}
 	}
+	if( option_number_of_jobs != NULL )
+	{
+		result = mount_handle_set_number_of_read_handles(
+			  ewfmount_mount_handle,
+			  option_number_of_jobs,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of jobs (threads).\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of jobs (threads) defaulting to: %d.\n",
+			 ewfmount_mount_handle->number_of_read_handles );
+		}
+	}
+#if !defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( ewfmount_mount_handle->number_of_read_handles != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Multi-threading not supported.\n" );
+
+		goto on_error;
+	}
+#endif
+	if( option_max_read != NULL )
+	{
+		string_length = system_string_length(
+		                 option_max_read );
+
+		result = byte_size_string_convert(
+		          option_max_read,
+		          string_length,
+		          &max_read,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to determine maximum read size.\n" );
+
+			goto on_error;
+		}
+		else if( ( result == 0 )
+		      || ( max_read > (uint64_t) UINT32_MAX ) )
+		{
+			max_read = 0;
+
+			fprintf(
+			 stderr,
+			 "Unsupported maximum read size defaulting to: 0.\n" );
+		}
+	}
 #if defined( HAVE_GETRLIMIT )
 	if( getrlimit(
             RLIMIT_NOFILE,
@@ -3359,13 +3391,95 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
-	if( option_extended_options != NULL )
+	/* This argument is required but ignored
+	 */
+	if( fuse_opt_add_arg(
+	     &ewfmount_fuse_arguments,
+	     "" ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable add fuse arguments.\n" );
+
+		goto on_error;
+	}
+	/* The image is read-only hence the data the kernel caches does not go stale
+	 * and concurrent reads can be handed to the read jobs asynchronously
+	 */
+	ewfmount_fuse_options[ 0 ] = 0;
+
+	if( max_read > 0 )
+	{
+		print_count = narrow_string_snprintf(
+		               &( ewfmount_fuse_options[ fuse_options_length ] ),
+		               64 - fuse_options_length,
+		               ",max_read=%" PRIu64 "",
+		               max_read );
+
+		if( ( print_count < 0 )
+		 || ( (size_t) print_count >= ( 64 - fuse_options_length ) ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set fuse options.\n" );
+
+			goto on_error;
+		}
+		fuse_options_length += (size_t) print_count;
+	}
+	if( use_kernel_cache != 0 )
+	{
+		print_count = narrow_string_snprintf(
+		               &( ewfmount_fuse_options[ fuse_options_length ] ),
+		               64 - fuse_options_length,
+		               ",kernel_cache" );
+
+		if( ( print_count < 0 )
+		 || ( (size_t) print_count >= ( 64 - fuse_options_length ) ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set fuse options.\n" );
+
+			goto on_error;
+		}
+		fuse_options_length += (size_t) print_count;
+	}
+	if( ewfmount_mount_handle->number_of_read_handles > 0 )
+	{
+		print_count = narrow_string_snprintf(
+		               &( ewfmount_fuse_options[ fuse_options_length ] ),
+		               64 - fuse_options_length,
+		               ",async_read" );
+
+		if( ( print_count < 0 )
+		 || ( (size_t) print_count >= ( 64 - fuse_options_length ) ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set fuse options.\n" );
+
+			goto on_error;
+		}
+		fuse_options_length += (size_t) print_count;
+	}
+	if( fuse_options_length > 0 )
 	{
-		/* This argument is required but ignored
+		if( fuse_opt_add_arg(
+		     &ewfmount_fuse_arguments,
+		     "-o" ) != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable add fuse arguments.\n" );
+
+			goto on_error;
+		}
+		/* Skip the leading separator
 		 */
 		if( fuse_opt_add_arg(
 		     &ewfmount_fuse_arguments,
-		     "" ) != 0 )
+		     &( ewfmount_fuse_options[ 1 ] ) ) != 0 )
 		{
 			fprintf(
 			 stderr,
@@ -3373,6 +3487,9 @@ int main( int argc, char * const argv[] )
 
 			goto on_error;
 		}
+	}
+	if( option_extended_options != NULL )
+	{
 		if( fuse_opt_add_arg(
 		     &ewfmount_fuse_arguments,
 		     "-o" ) != 0 )
@@ -3439,8 +3556,19 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
-	result = fuse_loop(
-	          ewfmount_fuse_handle );
+	/* In multi-threaded mode every request is handled by its own thread
+	 * and concurrent reads are spread over the read handles
+	 */
+	if( ewfmount_mount_handle->number_of_read_handles > 0 )
+	{
+		result = fuse_loop_mt(
+		          ewfmount_fuse_handle );
+	}
+	else
+	{
+		result = fuse_loop(
+		          ewfmount_fuse_handle );
+	}
 
 	if( result != 0 )
 	{
@@ -3482,7 +3610,7 @@ int main( int argc, char * const argv[] )
 		goto on_error;
 	}
 	ewfmount_dokan_options.Version     = 600;
-	ewfmount_dokan_options.ThreadCount = 0;
+	ewfmount_dokan_options.ThreadCount = (USHORT) ewfmount_mount_handle->number_of_read_handles;
 	ewfmount_dokan_options.MountPoint  = mount_point;
 
 	if( verbose != 0 )
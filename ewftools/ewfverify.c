@@ -50,9 +50,11 @@
 #include "ewftools_signal.h"
 #include "ewftools_unused.h"
 #include "log_handle.h"
+#include "verification_batch.h"
 #include "verification_handle.h"
 
 verification_handle_t *ewfverify_verification_handle = NULL;
+verification_batch_t *ewfverify_verification_batch   = NULL;
 int ewfverify_abort                                  = 0;
 
 /* Prints the executable usage information to the stream
@@ -67,9 +69,11 @@ void usage_fprint(
 	fprintf( stream, "Use ewfverify to verify data stored in the EWF format (Expert Witness\n"
 	                 "Compression Format).\n\n" );
 
-	fprintf( stream, "Usage: ewfverify [ -A codepage ] [ -d digest_type ] [ -f format ]\n"
-	                 "                 [ -j jobs ] [ -l log_filename ] [ -p process_buffer_size ]\n"
-	                 "                 [ -hqvVwx ] ewf_files\n\n" );
+	fprintf( stream, "Usage: ewfverify [ -A codepage ] [ -B manifest_filename ]\n"
+	                 "                 [ -d digest_type ] [ -f format ]\n"
+	                 "                 [ -H hash_tree_range ] [ -j jobs ]\n"
+	                 "                 [ -k readers ] [ -l log_filename ]\n"
+	                 "                 [ -p process_buffer_size ] [ -ChnqvVwx ] ewf_files\n\n" );
 
 	fprintf( stream, "\tewf_files: the first or the entire set of EWF segment files\n\n" );
 
@@ -78,16 +82,35 @@ void usage_fprint(
 	                 "\t           windows-950, windows-1250, windows-1251, windows-1252,\n"
 	                 "\t           windows-1253, windows-1254, windows-1255, windows-1256,\n"
 	                 "\t           windows-1257 or windows-1258\n" );
+	fprintf( stream, "\t-B:        batch mode, verifies the image sets listed in the manifest,\n"
+	                 "\t           one first segment filename per line, instead of ewf_files.\n"
+	                 "\t           The image sets are verified concurrently by the jobs and\n"
+	                 "\t           a tab separated result line is printed per image set, or\n"
+	                 "\t           written to the log_filename if specified\n" );
+	fprintf( stream, "\t-C:        check the chunk checksums of the segment files instead of\n"
+	                 "\t           the digest hashes. The segment files are checked\n"
+	                 "\t           concurrently by the jobs\n" );
 	fprintf( stream, "\t-d:        calculate additional digest (hash) types besides md5,\n"
 	                 "\t           options: sha1, sha256\n" );
 	fprintf( stream, "\t-f:        specify the input format, options: raw (default),\n"
 	                 "\t           files (restricted to logical volume files)\n" );
 	fprintf( stream, "\t-h:        shows this help\n" );
+	fprintf( stream, "\t-H:        verify the media data using the hash tree instead of\n"
+	                 "\t           the digest hashes, options: all, or offset:size to only\n"
+	                 "\t           verify the hash tree leaves that contain the byte range.\n"
+	                 "\t           The leaves are verified concurrently by the jobs\n" );
 	fprintf( stream, "\t-j:        the number of concurrent processing jobs (threads), where\n"
 	                 "\t           a number of 0 represents single-threaded mode (default is 4\n"
 	                 "\t           if multi-threaded mode is supported)\n" );
+	fprintf( stream, "\t-k:        the number of dedicated reader threads that read ahead of\n"
+	                 "\t           the processing jobs, where a number of 0 represents reading\n"
+	                 "\t           by the main thread (default is 0), requires jobs to be 1 or\n"
+	                 "\t           more\n" );
 	fprintf( stream, "\t-l:        logs verification errors and the digest (hash) to the\n"
 	                 "\t           log_filename\n" );
+	fprintf( stream, "\t-n:        bind the reader threads round-robin to the NUMA nodes, if\n"
+	                 "\t           supported, so that the buffers of a reader are allocated\n"
+	                 "\t           on its node, requires readers to be 1 or more\n" );
 	fprintf( stream, "\t-p:        specify the process buffer size (default is the chunk size)\n" );
 	fprintf( stream, "\t-q:        quiet shows minimal status information\n" );
 	fprintf( stream, "\t-v:        verbose output to stderr\n" );
@@ -109,6 +132,22 @@ void ewfverify_signal_handler(
 
 	ewfverify_abort = 1;
 
+	if( ewfverify_verification_batch != NULL )
+	{
+		if( verification_batch_signal_abort(
+		     ewfverify_verification_batch,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal verification batch to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
 	if( ewfverify_verification_handle != NULL )
 	{
 		if( verification_handle_signal_abort(
@@ -156,15 +195,21 @@ int main( int argc, char * const argv[] )
 	system_character_t * const *source_filenames       = NULL;
 	libcerror_error_t *error                           = NULL;
 	log_handle_t *log_handle                           = NULL;
+	FILE *results_stream                               = stdout;
 	system_character_t *log_filename                   = NULL;
 	system_character_t *option_additional_digest_types = NULL;
+	system_character_t *option_batch_manifest          = NULL;
 	system_character_t *option_format                  = NULL;
+	system_character_t *option_hash_tree_range         = NULL;
 	system_character_t *option_header_codepage         = NULL;
 	system_character_t *option_number_of_jobs          = NULL;
+	system_character_t *option_number_of_readers       = NULL;
 	system_character_t *option_process_buffer_size     = NULL;
 	system_character_t *program                        = _SYSTEM_STRING( "ewfverify" );
 	system_integer_t option                            = 0;
 	uint8_t calculate_md5                              = 1;
+	uint8_t check_chunks                               = 0;
+	uint8_t numa_node_affinity                         = 0;
 	uint8_t print_status_information                   = 1;
 	uint8_t use_chunk_data_functions                   = 0;
 	uint8_t verbose                                    = 0;
@@ -209,7 +254,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = ewftools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "A:d:f:j:hl:p:qvVwx" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "A:B:Cd:f:H:j:hk:l:np:qvVwx" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -230,6 +275,16 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'B':
+				option_batch_manifest = optarg;
+
+				break;
+
+			case (system_integer_t) 'C':
+				check_chunks = 1;
+
+				break;
+
 			case (system_integer_t) 'd':
 				option_additional_digest_types = optarg;
 
@@ -246,16 +301,31 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_SUCCESS );
 
+			case (system_integer_t) 'H':
+				option_hash_tree_range = optarg;
+
+				break;
+
 			case (system_integer_t) 'j':
 				option_number_of_jobs = optarg;
 
 				break;
 
+			case (system_integer_t) 'k':
+				option_number_of_readers = optarg;
+
+				break;
+
 			case (system_integer_t) 'l':
 				log_filename = optarg;
 
 				break;
 
+			case (system_integer_t) 'n':
+				numa_node_affinity = 1;
+
+				break;
+
 			case (system_integer_t) 'p':
 				option_process_buffer_size = optarg;
 
@@ -288,7 +358,8 @@ int main( int argc, char * const argv[] )
 				break;
 		}
 	}
-	if( optind == argc )
+	if( ( optind == argc )
+	 && ( option_batch_manifest == NULL ) )
 	{
 		fprintf(
 		 stderr,
@@ -406,7 +477,7 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 		else if( ( result == 0 )
-		      || ( ewfverify_verification_handle->number_of_threads > (int) 32 ) )
+		      || ( ewfverify_verification_handle->number_of_threads > (int) EWFCOMMON_MAXIMUM_NUMBER_OF_THREADS ) )
 		{
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 			ewfverify_verification_handle->number_of_threads = 4;
@@ -420,6 +491,60 @@ int main( int argc, char * const argv[] )
 			 ewfverify_verification_handle->number_of_threads );
 		}
 	}
+	if( option_number_of_readers != NULL )
+	{
+		result = verification_handle_set_number_of_readers(
+			  ewfverify_verification_handle,
+			  option_number_of_readers,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of readers.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			ewfverify_verification_handle->number_of_readers = 0;
+
+			fprintf(
+			 stderr,
+			 "Unsupported number of readers defaulting to: 0.\n" );
+		}
+#if !defined( HAVE_MULTI_THREAD_SUPPORT )
+		else if( ewfverify_verification_handle->number_of_readers != 0 )
+		{
+			ewfverify_verification_handle->number_of_readers = 0;
+
+			fprintf(
+			 stderr,
+			 "Reader threads not supported defaulting to: 0.\n" );
+		}
+#endif
+	}
+	if( numa_node_affinity != 0 )
+	{
+		if( ewfverify_verification_handle->number_of_readers == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Binding to NUMA nodes requires reader threads, ignoring.\n" );
+		}
+		else if( verification_handle_set_numa_node_affinity(
+		          ewfverify_verification_handle,
+		          numa_node_affinity,
+		          &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set NUMA node affinity.\n" );
+
+			goto on_error;
+		}
+	}
 	if( option_additional_digest_types != NULL )
 	{
 		result = verification_handle_set_additional_digest_types(
@@ -436,45 +561,103 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
-#if !defined( HAVE_GLOB_H )
-	if( ewftools_glob_initialize(
-	     &glob,
-	     &error ) != 1 )
+	if( option_hash_tree_range != NULL )
 	{
-		fprintf(
-		 stderr,
-		 "Unable to initialize glob.\n" );
+		if( option_batch_manifest != NULL )
+		{
+			fprintf(
+			 stderr,
+			 "Hash tree verification is not supported in batch mode.\n" );
 
-		goto on_error;
+			goto on_error;
+		}
+		result = verification_handle_set_hash_tree_range(
+			  ewfverify_verification_handle,
+			  option_hash_tree_range,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set hash tree range.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported hash tree range.\n" );
+
+			goto on_error;
+		}
 	}
-	if( ewftools_glob_resolve(
-	     glob,
-	     &( argv[ optind ] ),
-	     argc - optind,
-	     &error ) != 1 )
+	if( check_chunks != 0 )
 	{
-		fprintf(
-		 stderr,
-		 "Unable to resolve glob.\n" );
+		if( ( option_batch_manifest != NULL )
+		 || ( option_hash_tree_range != NULL ) )
+		{
+			fprintf(
+			 stderr,
+			 "Checking chunks is not supported in batch mode or with hash tree verification.\n" );
 
-		goto on_error;
+			goto on_error;
+		}
+		if( verification_handle_set_check_chunks(
+		     ewfverify_verification_handle,
+		     check_chunks,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set check chunks.\n" );
+
+			goto on_error;
+		}
 	}
-	if( ewftools_glob_get_results(
-	     glob,
-	     &number_of_filenames,
-	     (system_character_t ***) &source_filenames,
-	     &error ) != 1 )
+	if( option_batch_manifest == NULL )
 	{
-		fprintf(
-		 stderr,
-		 "Unable to retrieve glob results.\n" );
+#if !defined( HAVE_GLOB_H )
+		if( ewftools_glob_initialize(
+		     &glob,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to initialize glob.\n" );
 
-		goto on_error;
-	}
+			goto on_error;
+		}
+		if( ewftools_glob_resolve(
+		     glob,
+		     &( argv[ optind ] ),
+		     argc - optind,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to resolve glob.\n" );
+
+			goto on_error;
+		}
+		if( ewftools_glob_get_results(
+		     glob,
+		     &number_of_filenames,
+		     (system_character_t ***) &source_filenames,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to retrieve glob results.\n" );
+
+			goto on_error;
+		}
 #else
-	source_filenames    = &( argv[ optind ] );
-	number_of_filenames = argc - optind;
+		source_filenames    = &( argv[ optind ] );
+		number_of_filenames = argc - optind;
 #endif
+	}
 
 #if defined( HAVE_GETRLIMIT )
 	if( getrlimit(
@@ -518,46 +701,77 @@ int main( int argc, char * const argv[] )
 		libcerror_error_free(
 		 &error );
 	}
-	result = verification_handle_open_input(
-	          ewfverify_verification_handle,
-	          source_filenames,
-	          number_of_filenames,
-	          &error );
-
-	if( ewfverify_abort != 0 )
+	if( option_batch_manifest != NULL )
 	{
-		goto on_abort;
+		if( verification_batch_initialize(
+		     &ewfverify_verification_batch,
+		     ewfverify_verification_handle,
+		     option_additional_digest_types,
+		     zero_chunk_on_error,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to create verification batch.\n" );
+
+			goto on_error;
+		}
+		if( verification_batch_read_manifest(
+		     ewfverify_verification_batch,
+		     option_batch_manifest,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to read manifest: %" PRIs_SYSTEM ".\n",
+			 option_batch_manifest );
+
+			goto on_error;
+		}
 	}
-	if( result != 1 )
+	else
 	{
-		fprintf(
-		 stderr,
-		 "Unable to open EWF image file(s).\n" );
+		result = verification_handle_open_input(
+		          ewfverify_verification_handle,
+		          source_filenames,
+		          number_of_filenames,
+		          &error );
 
-		goto on_error;
-	}
+		if( ewfverify_abort != 0 )
+		{
+			goto on_abort;
+		}
+		if( result != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to open EWF image file(s).\n" );
+
+			goto on_error;
+		}
 #if !defined( HAVE_GLOB_H )
-	if( ewftools_glob_free(
-	     &glob,
-	     &error ) != 1 )
-	{
-		fprintf(
-		 stderr,
-		 "Unable to free glob.\n" );
+		if( ewftools_glob_free(
+		     &glob,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to free glob.\n" );
 
-		goto on_error;
-	}
+			goto on_error;
+		}
 #endif
-	if( verification_handle_set_zero_chunk_on_error(
-	     ewfverify_verification_handle,
-	     zero_chunk_on_error,
-	     &error ) != 1 )
-	{
-		fprintf(
-		 stderr,
-		 "Unable to set zero on chunk error.\n" );
+		if( verification_handle_set_zero_chunk_on_error(
+		     ewfverify_verification_handle,
+		     zero_chunk_on_error,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set zero on chunk error.\n" );
 
-		goto on_error;
+			goto on_error;
+		}
 	}
 	if( log_filename != NULL )
 	{
@@ -584,7 +798,70 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
-	if( ewfverify_verification_handle->input_format == VERIFICATION_HANDLE_INPUT_FORMAT_FILES )
+	if( ewfverify_verification_batch != NULL )
+	{
+		if( log_handle != NULL )
+		{
+			results_stream = log_handle->log_stream;
+		}
+		result = verification_batch_verify(
+		          ewfverify_verification_batch,
+		          results_stream,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to verify batch.\n" );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	else if( ewfverify_verification_handle->check_chunks != 0 )
+	{
+		result = verification_handle_check_chunks(
+		          ewfverify_verification_handle,
+		          print_status_information,
+		          log_handle,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to check chunks.\n" );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	else if( ewfverify_verification_handle->verify_hash_tree != 0 )
+	{
+		result = verification_handle_verify_hash_tree(
+		          ewfverify_verification_handle,
+		          print_status_information,
+		          log_handle,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to verify hash tree.\n" );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	else if( ewfverify_verification_handle->input_format == VERIFICATION_HANDLE_INPUT_FORMAT_FILES )
 	{
 		result = verification_handle_verify_single_files(
 		          ewfverify_verification_handle,
@@ -660,9 +937,22 @@ on_abort:
 		libcerror_error_free(
 		 &error );
 	}
-	if( verification_handle_close(
-	     ewfverify_verification_handle,
-	     &error ) != 0 )
+	if( ewfverify_verification_batch != NULL )
+	{
+		if( verification_batch_free(
+		     &ewfverify_verification_batch,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to free verification batch.\n" );
+
+			goto on_error;
+		}
+	}
+	else if( verification_handle_close(
+	          ewfverify_verification_handle,
+	          &error ) != 0 )
 	{
 		fprintf(
 		 stderr,
@@ -723,6 +1013,12 @@ on_error:
 		 &log_handle,
 		 NULL );
 	}
+	if( ewfverify_verification_batch != NULL )
+	{
+		verification_batch_free(
+		 &ewfverify_verification_batch,
+		 NULL );
+	}
 	if( ewfverify_verification_handle != NULL )
 	{
 		verification_handle_close(
@@ -51,6 +51,7 @@
 #include "ewftools_libhmac.h"
 #include "ewftools_system_string.h"
 #include "export_handle.h"
+#include "export_plan.h"
 #include "guid.h"
 #include "process_status.h"
 #include "storage_media_buffer.h"
@@ -257,6 +258,24 @@ int export_handle_free(
 			memory_free(
 			 ( *export_handle )->target_path );
 		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *export_handle )->storage_media_reader != NULL )
+		{
+			if( storage_media_reader_free(
+			     &( ( *export_handle )->storage_media_reader ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free storage media reader.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
 		if( ( *export_handle )->input_handle != NULL )
 		{
 			if( libewf_handle_free(
@@ -412,6 +431,24 @@ int export_handle_signal_abort(
 			return( -1 );
 		}
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->storage_media_reader != NULL )
+	{
+		if( storage_media_reader_signal_abort(
+		     export_handle->storage_media_reader,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal storage media reader to abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
 	if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
 	{
 		if( libewf_handle_signal_abort(
@@ -485,6 +522,8 @@ int export_handle_set_maximum_number_of_open_handles(
 
 		return( -1 );
 	}
+	export_handle->maximum_number_of_open_handles = maximum_number_of_open_handles;
+
 	return( 1 );
 }
 
@@ -501,6 +540,10 @@ int export_handle_open_input(
 	static char *function                 = "export_handle_open_input";
 	size_t first_filename_length          = 0;
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	int maximum_number_of_open_handles    = 0;
+#endif
+
 	if( export_handle == NULL )
 	{
 		libcerror_error_set(
@@ -540,7 +583,7 @@ int export_handle_open_input(
 		                         filenames[ 0 ] );
 
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-		if( libewf_glob_wide(
+		if( libewf_glob_directory_wide(
 		     filenames[ 0 ],
 		     first_filename_length,
 		     LIBEWF_FORMAT_UNKNOWN,
@@ -548,7 +591,7 @@ int export_handle_open_input(
 		     &number_of_filenames,
 		     error ) != 1 )
 #else
-		if( libewf_glob(
+		if( libewf_glob_directory(
 		     filenames[ 0 ],
 		     first_filename_length,
 		     LIBEWF_FORMAT_UNKNOWN,
@@ -568,6 +611,38 @@ int export_handle_open_input(
 		}
 		filenames = (system_character_t * const *) libewf_filenames;
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->number_of_readers != 0 )
+	{
+		/* The input handle and reader handles share the open file handles limit
+		 */
+		maximum_number_of_open_handles = export_handle->maximum_number_of_open_handles;
+
+		if( maximum_number_of_open_handles > 0 )
+		{
+			maximum_number_of_open_handles /= export_handle->number_of_readers + 1;
+
+			if( maximum_number_of_open_handles == 0 )
+			{
+				maximum_number_of_open_handles = 1;
+			}
+			if( libewf_handle_set_maximum_number_of_open_handles(
+			     export_handle->input_handle,
+			     maximum_number_of_open_handles,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set maximum number of open handles in input handle.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+#endif
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 	if( libewf_handle_open_wide(
 	     export_handle->input_handle,
@@ -591,22 +666,58 @@ int export_handle_open_input(
 		 "%s: unable to open file(s).",
 		 function );
 
-		if( libewf_filenames != NULL )
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->number_of_readers != 0 )
+	{
+		if( storage_media_reader_initialize(
+		     &( export_handle->storage_media_reader ),
+		     export_handle->number_of_readers,
+		     error ) != 1 )
 		{
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-			libewf_glob_wide_free(
-			 libewf_filenames,
-			 number_of_filenames,
-			 NULL );
-#else
-			libewf_glob_free(
-			 libewf_filenames,
-			 number_of_filenames,
-			 NULL );
-#endif
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create storage media reader.",
+			 function );
+
+			goto on_error;
+		}
+		if( storage_media_reader_open(
+		     export_handle->storage_media_reader,
+		     filenames,
+		     number_of_filenames,
+		     export_handle->header_codepage,
+		     maximum_number_of_open_handles,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open storage media reader.",
+			 function );
+
+			goto on_error;
+		}
+		if( storage_media_reader_set_numa_node_affinity(
+		     export_handle->storage_media_reader,
+		     export_handle->numa_node_affinity,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set NUMA node affinity in storage media reader.",
+			 function );
+
+			goto on_error;
 		}
-		return( -1 );
 	}
+#endif
 	if( libewf_filenames != NULL )
 	{
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -674,6 +785,31 @@ int export_handle_open_input(
 		return( -1 );
 	}
 	return( 1 );
+
+on_error:
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->storage_media_reader != NULL )
+	{
+		storage_media_reader_free(
+		 &( export_handle->storage_media_reader ),
+		 NULL );
+	}
+#endif
+	if( libewf_filenames != NULL )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		libewf_glob_wide_free(
+		 libewf_filenames,
+		 number_of_filenames,
+		 NULL );
+#else
+		libewf_glob_free(
+		 libewf_filenames,
+		 number_of_filenames,
+		 NULL );
+#endif
+	}
+	return( -1 );
 }
 
 /* Checks if a file can be written
@@ -995,6 +1131,24 @@ int export_handle_close(
 
 		return( -1 );
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->storage_media_reader != NULL )
+	{
+		if( storage_media_reader_close(
+		     export_handle->storage_media_reader,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close storage media reader.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
 	if( libewf_handle_close(
 	     export_handle->input_handle,
 	     error ) != 0 )
@@ -3209,7 +3363,7 @@ int export_handle_set_number_of_threads(
 		}
 		result = 1;
 
-		if( number_of_threads > 32 )
+		if( number_of_threads > (uint64_t) EWFCOMMON_MAXIMUM_NUMBER_OF_THREADS )
 		{
 			result = 0;
 		}
@@ -3221,6 +3375,91 @@ int export_handle_set_number_of_threads(
 	return( result );
 }
 
+/* Sets the number of dedicated reader threads
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int export_handle_set_number_of_readers(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function      = "export_handle_set_number_of_readers";
+	size_t string_length       = 0;
+	uint64_t number_of_readers = 0;
+	int result                 = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string[ 0 ] != (system_character_t) '-' )
+	{
+		string_length = system_string_length(
+				 string );
+
+		if( ewftools_system_string_decimal_copy_to_64_bit(
+		     string,
+		     string_length + 1,
+		     &number_of_readers,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine number of readers.",
+			 function );
+
+			return( -1 );
+		}
+		result = 1;
+
+		if( number_of_readers > (uint64_t) EWFCOMMON_MAXIMUM_NUMBER_OF_READERS )
+		{
+			result = 0;
+		}
+		else
+		{
+			export_handle->number_of_readers = (int) number_of_readers;
+		}
+	}
+	return( result );
+}
+
+
+/* Sets the value to bind the reader threads to the NUMA nodes
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_set_numa_node_affinity(
+     export_handle_t *export_handle,
+     uint8_t numa_node_affinity,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_set_numa_node_affinity";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	export_handle->numa_node_affinity = numa_node_affinity;
+
+	return( 1 );
+}
+
 /* Sets the additional digest types
  * Returns 1 if successful or -1 on error
  */
@@ -3580,6 +3819,25 @@ int export_handle_set_output_values(
 
 		return( -1 );
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->storage_media_reader != NULL )
+	{
+		if( storage_media_reader_set_zero_chunk_on_error(
+		     export_handle->storage_media_reader,
+		     zero_chunk_on_error,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set zero chunk on error in storage media reader.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
 	if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
 	{
 		if( export_handle->ewf_output_handle == NULL )
@@ -5059,6 +5317,7 @@ int export_handle_export_input(
 	ssize_t write_count                                 = 0;
 	uint8_t storage_media_buffer_mode                   = 0;
 	int maximum_number_of_queued_items                  = 0;
+	int number_of_free_lists                            = 1;
 	int status                                          = PROCESS_STATUS_COMPLETED;
 
 	if( export_handle == NULL )
@@ -5204,7 +5463,21 @@ int export_handle_export_input(
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 	if( export_handle->number_of_threads != 0 )
 	{
-		maximum_number_of_queued_items = 1 + ( ( 512 * 1024 * 1024 ) / process_buffer_size );
+		if( storage_media_buffer_queue_get_maximum_number_of_values(
+		     export_handle->number_of_threads,
+		     process_buffer_size,
+		     &maximum_number_of_queued_items,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine maximum number of queued items.",
+			 function );
+
+			goto on_error;
+		}
 
 		if( libcthreads_thread_pool_create(
 		     &( export_handle->input_process_thread_pool ),
@@ -5255,10 +5528,17 @@ int export_handle_export_input(
 
 			goto on_error;
 		}
+		/* Every reader thread grabs its buffers from its own free list
+		 */
+		if( export_handle->storage_media_reader != NULL )
+		{
+			number_of_free_lists = export_handle->storage_media_reader->number_of_readers;
+		}
 		if( storage_media_buffer_queue_initialize(
 		     &( export_handle->storage_media_buffer_queue ),
 		     export_handle->input_handle,
 		     maximum_number_of_queued_items,
+		     number_of_free_lists,
 		     storage_media_buffer_mode,
 		     process_buffer_size,
 		     error ) != 1 )
@@ -5341,6 +5621,33 @@ int export_handle_export_input(
 	}
 	remaining_export_size = (size64_t) export_handle->export_size;
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( ( export_handle->number_of_threads != 0 )
+	 && ( export_handle->storage_media_reader != NULL ) )
+	{
+		if( storage_media_reader_start(
+		     export_handle->storage_media_reader,
+		     export_handle->storage_media_buffer_queue,
+		     export_handle->input_process_thread_pool,
+		     (off64_t) export_handle->export_offset,
+		     (size64_t) export_handle->export_size,
+		     process_buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to start storage media reader.",
+			 function );
+
+			goto on_error;
+		}
+		/* The reader threads read the storage media instead of the main thread
+		 */
+		remaining_export_size = 0;
+	}
+#endif
 	while( remaining_export_size > 0 )
 	{
 		if( export_handle->abort != 0 )
@@ -5352,6 +5659,7 @@ int export_handle_export_input(
 		{
 			if( storage_media_buffer_queue_grab_buffer(
 			     export_handle->storage_media_buffer_queue,
+			     0,
 			     &input_storage_media_buffer,
 			     error ) != 1 )
 			{
@@ -5615,26 +5923,59 @@ int export_handle_export_input(
 		}
 	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
-	if( export_handle->input_process_thread_pool != NULL )
+	if( ( export_handle->number_of_threads != 0 )
+	 && ( export_handle->storage_media_reader != NULL ) )
 	{
-		if( libcthreads_thread_pool_join(
-		     &( export_handle->input_process_thread_pool ),
+		if( storage_media_reader_join(
+		     export_handle->storage_media_reader,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to join input process thread pool.",
+			 "%s: unable to join storage media reader.",
 			 function );
 
 			goto on_error;
 		}
-	}
-	if( export_handle->output_thread_pool != NULL )
-	{
-		if( libcthreads_thread_pool_join(
-		     &( export_handle->output_thread_pool ),
+		/* Checksum errors detected while reading are stored in the reader handles
+		 */
+		if( storage_media_reader_copy_checksum_errors(
+		     export_handle->storage_media_reader,
+		     export_handle->input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to copy checksum errors from storage media reader.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( export_handle->input_process_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( export_handle->input_process_thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join input process thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( export_handle->output_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( export_handle->output_thread_pool ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -5844,6 +6185,15 @@ on_error:
 		 NULL );
 	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->storage_media_reader != NULL )
+	{
+		storage_media_reader_signal_abort(
+		 export_handle->storage_media_reader,
+		 NULL );
+		storage_media_reader_join(
+		 export_handle->storage_media_reader,
+		 NULL );
+	}
 	if( export_handle->input_process_thread_pool != NULL )
 	{
 		libcthreads_thread_pool_join(
@@ -6010,6 +6360,22 @@ int export_handle_export_single_files(
 	 "Created directory: %" PRIs_SYSTEM ".\n",
 	 export_handle->target_path );
 
+	/* The file entry tree is walked first to create the directories and to plan
+	 * the export of the file entry data, which is then read in media data offset order
+	 */
+	if( export_plan_initialize(
+	     &( export_handle->export_plan ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create export plan.",
+		 function );
+
+		goto on_error;
+	}
 	result = export_handle_export_file_entry(
 	          export_handle,
 	          file_entry,
@@ -6030,6 +6396,38 @@ int export_handle_export_single_files(
 
 		goto on_error;
 	}
+	if( export_handle->abort == 0 )
+	{
+		result = export_handle_export_plan(
+		          export_handle,
+		          log_handle,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to export planned file entries.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( export_plan_free(
+	     &( export_handle->export_plan ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free export plan.",
+		 function );
+
+		goto on_error;
+	}
 	if( export_handle->abort != 0 )
 	{
 		status = PROCESS_STATUS_ABORTED;
@@ -6078,6 +6476,12 @@ int export_handle_export_single_files(
 	return( 1 );
 
 on_error:
+	if( export_handle->export_plan != NULL )
+	{
+		export_plan_free(
+		 &( export_handle->export_plan ),
+		 NULL );
+	}
 	if( export_handle->process_status != NULL )
 	{
 		process_status_stop(
@@ -6325,17 +6729,41 @@ int export_handle_export_file_entry(
 			}
 			/* TODO what about NTFS streams ?
 			 */
-			fprintf(
-			 export_handle->notify_stream,
-			 "Single file: %" PRIs_SYSTEM "\n",
-			 &( target_path[ file_entry_path_index ] ) );
-
-			return_value = export_handle_export_file_entry_data(
-				        export_handle,
-			                file_entry,
-			                target_path,
-			                error );
+			if( export_handle->export_plan != NULL )
+			{
+				return_value = export_handle_plan_file_entry_data(
+				                export_handle,
+				                file_entry,
+				                target_path,
+				                target_path_size,
+				                file_entry_path_index,
+				                error );
+
+				if( return_value == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GENERIC,
+					 "%s: unable to plan export of file entry data.",
+					 function );
 
+					goto on_error;
+				}
+			}
+			else
+			{
+				fprintf(
+				 export_handle->notify_stream,
+				 "Single file: %" PRIs_SYSTEM "\n",
+				 &( target_path[ file_entry_path_index ] ) );
+
+				return_value = export_handle_export_file_entry_data(
+					        export_handle,
+				                file_entry,
+				                target_path,
+				                error );
+			}
 			if( return_value == -1 )
 			{
 				libcerror_error_set(
@@ -6719,6 +7147,1075 @@ on_error:
 	return( -1 );
 }
 
+/* Adds the data of a (single) file entry to the export plan
+ * The target file is created so that file entries with the same name are skipped
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_plan_file_entry_data(
+     export_handle_t *export_handle,
+     libewf_file_entry_t *file_entry,
+     const system_character_t *target_path,
+     size_t target_path_size,
+     size_t file_entry_path_index,
+     libcerror_error_t **error )
+{
+	export_plan_item_t *item            = NULL;
+	libcfile_file_t *file               = NULL;
+	static char *function               = "export_handle_plan_file_entry_data";
+	size64_t file_entry_data_size       = 0;
+	off64_t duplicate_media_data_offset = 0;
+	off64_t media_data_offset           = 0;
+	uint32_t flags                      = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->export_plan == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid export handle - missing export plan.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_file_entry_get_size(
+	     file_entry,
+	     &file_entry_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file entry data size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_file_entry_get_flags(
+	     file_entry,
+	     &flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file entry flags.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_file_entry_get_media_data_offset(
+	     file_entry,
+	     &media_data_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file entry media data offset.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( flags & LIBEWF_FILE_ENTRY_FLAG_SPARSE_DATA ) != 0 )
+	{
+		if( libewf_file_entry_get_duplicate_media_data_offset(
+		     file_entry,
+		     &duplicate_media_data_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file entry duplicate media data offset.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	/* The target file is created empty here, its data is written when the plan is exported
+	 */
+	if( libcfile_file_initialize(
+	     &file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcfile_file_open_wide(
+	     file,
+	     target_path,
+	     LIBCFILE_OPEN_WRITE,
+	     error ) != 1 )
+#else
+	if( libcfile_file_open(
+	     file,
+	     target_path,
+	     LIBCFILE_OPEN_WRITE,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file: %" PRIs_SYSTEM ".",
+		 function,
+		 target_path );
+
+		goto on_error;
+	}
+	if( libcfile_file_close(
+	     file,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_free(
+	     &file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file.",
+		 function );
+
+		goto on_error;
+	}
+	if( export_plan_item_initialize(
+	     &item,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create export plan item.",
+		 function );
+
+		goto on_error;
+	}
+	if( export_plan_item_set_target_path(
+	     item,
+	     target_path,
+	     target_path_size,
+	     file_entry_path_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set target path of export plan item.",
+		 function );
+
+		goto on_error;
+	}
+	item->size = file_entry_data_size;
+
+	/* Sparse data is either stored at the duplicate media data offset
+	 * or consists of a single byte that is repeated
+	 */
+	if( ( flags & LIBEWF_FILE_ENTRY_FLAG_SPARSE_DATA ) == 0 )
+	{
+		item->media_data_offset = media_data_offset;
+	}
+	else if( duplicate_media_data_offset >= 0 )
+	{
+		item->media_data_offset = duplicate_media_data_offset;
+	}
+	else
+	{
+		item->media_data_offset = media_data_offset;
+		item->is_sparse         = 1;
+	}
+	if( export_plan_append_item(
+	     export_handle->export_plan,
+	     item,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append item to export plan.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( item != NULL )
+	{
+		export_plan_item_free(
+		 &item,
+		 NULL );
+	}
+	if( file != NULL )
+	{
+		libcfile_file_free(
+		 &file,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the data of an export plan item
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t export_handle_read_plan_item_data(
+         export_handle_t *export_handle,
+         export_plan_item_t *item,
+         size64_t offset,
+         uint8_t *buffer,
+         size_t read_size,
+         libcerror_error_t **error )
+{
+	static char *function = "export_handle_read_plan_item_data";
+	ssize_t read_count    = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( item == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( read_size == 0 )
+	 || ( read_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid read size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( item->is_sparse != 0 )
+	{
+		read_count = libewf_handle_read_buffer_at_offset(
+		              export_handle->input_handle,
+		              buffer,
+		              1,
+		              item->media_data_offset,
+		              error );
+	}
+	else
+	{
+		read_count = libewf_handle_read_buffer_at_offset(
+		              export_handle->input_handle,
+		              buffer,
+		              read_size,
+		              item->media_data_offset + (off64_t) offset,
+		              error );
+	}
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read file entry data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( item->is_sparse != 0 )
+	 && ( read_count == 1 ) )
+	{
+		if( memory_set(
+		     &( buffer[ 1 ] ),
+		     buffer[ 0 ],
+		     read_size - 1 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to set sparse data in buffer.",
+			 function );
+
+			return( -1 );
+		}
+		read_count = (ssize_t) read_size;
+	}
+	return( read_count );
+}
+
+/* Writes the buffered data of an export plan item to its target file
+ * The buffered data is freed afterwards
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_write_plan_item_data(
+     export_handle_t *export_handle,
+     export_plan_item_t *item,
+     libcerror_error_t **error )
+{
+	libcfile_file_t *file = NULL;
+	static char *function = "export_handle_write_plan_item_data";
+	ssize_t write_count   = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( item == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item.",
+		 function );
+
+		return( -1 );
+	}
+	if( item->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid item - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcfile_file_initialize(
+	     &file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcfile_file_open_wide(
+	     file,
+	     item->target_path,
+	     LIBCFILE_OPEN_WRITE,
+	     error ) != 1 )
+#else
+	if( libcfile_file_open(
+	     file,
+	     item->target_path,
+	     LIBCFILE_OPEN_WRITE,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file: %" PRIs_SYSTEM ".",
+		 function,
+		 item->target_path );
+
+		goto on_error;
+	}
+	write_count = libcfile_file_write_buffer(
+	               file,
+	               item->data,
+	               item->data_size,
+	               error );
+
+	if( write_count != (ssize_t) item->data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write file entry data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_close(
+	     file,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_free(
+	     &file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 item->data );
+
+	item->data      = NULL;
+	item->data_size = 0;
+
+	return( 1 );
+
+on_error:
+	if( file != NULL )
+	{
+		libcfile_file_free(
+		 &file,
+		 NULL );
+	}
+	memory_free(
+	 item->data );
+
+	item->data      = NULL;
+	item->data_size = 0;
+
+	return( -1 );
+}
+
+/* Exports the data of an export plan item that is too large to buffer in parts
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int export_handle_export_plan_item_data_in_parts(
+     export_handle_t *export_handle,
+     export_plan_item_t *item,
+     libcerror_error_t **error )
+{
+	libcfile_file_t *file = NULL;
+	uint8_t *buffer       = NULL;
+	static char *function = "export_handle_export_plan_item_data_in_parts";
+	size64_t offset       = 0;
+	size_t read_size      = 0;
+	ssize_t read_count    = 0;
+	ssize_t write_count   = 0;
+	int result            = 1;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( item == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item.",
+		 function );
+
+		return( -1 );
+	}
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * EXPORT_PLAN_MAXIMUM_BUFFERED_DATA_SIZE );
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_initialize(
+	     &file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcfile_file_open_wide(
+	     file,
+	     item->target_path,
+	     LIBCFILE_OPEN_WRITE,
+	     error ) != 1 )
+#else
+	if( libcfile_file_open(
+	     file,
+	     item->target_path,
+	     LIBCFILE_OPEN_WRITE,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file: %" PRIs_SYSTEM ".",
+		 function,
+		 item->target_path );
+
+		goto on_error;
+	}
+	while( offset < item->size )
+	{
+		if( export_handle->abort != 0 )
+		{
+			break;
+		}
+		read_size = EXPORT_PLAN_MAXIMUM_BUFFERED_DATA_SIZE;
+
+		if( ( item->size - offset ) < (size64_t) read_size )
+		{
+			read_size = (size_t) ( item->size - offset );
+		}
+		read_count = export_handle_read_plan_item_data(
+		              export_handle,
+		              item,
+		              offset,
+		              buffer,
+		              read_size,
+		              error );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read file entry data.",
+			 function );
+
+			goto on_error;
+		}
+		else if( read_count != (ssize_t) read_size )
+		{
+			result = 0;
+
+			break;
+		}
+		offset += read_size;
+
+		write_count = libcfile_file_write_buffer(
+		               file,
+		               buffer,
+		               read_size,
+		               error );
+
+		if( write_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write file entry data.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libcfile_file_close(
+	     file,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_free(
+	     &file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 buffer );
+
+	return( result );
+
+on_error:
+	if( file != NULL )
+	{
+		libcfile_file_free(
+		 &file,
+		 NULL );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Callback function for the single files write thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_write_plan_item_data_callback(
+     export_plan_item_t *item,
+     export_handle_t *export_handle )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "export_handle_write_plan_item_data_callback";
+
+	if( item == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item.",
+		 function );
+
+		goto on_error;
+	}
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( export_handle_write_plan_item_data(
+	     export_handle,
+	     item,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write single file: %" PRIs_SYSTEM ".",
+		 function,
+		 item->target_path );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( export_handle != NULL )
+	{
+		export_handle->single_file_write_failed = 1;
+
+		if( item != NULL )
+		{
+			fprintf(
+			 export_handle->notify_stream,
+			 "Unable to write single file: %" PRIs_SYSTEM "\n",
+			 &( item->target_path[ item->file_entry_path_index ] ) );
+		}
+	}
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Exports the file entries in the export plan
+ * The data is read in media data offset order so that the input is read in a single pass
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int export_handle_export_plan(
+     export_handle_t *export_handle,
+     log_handle_t *log_handle,
+     libcerror_error_t **error )
+{
+	export_plan_item_t *item  = NULL;
+	static char *function     = "export_handle_export_plan";
+	size64_t exported_size    = 0;
+	size64_t total_size       = 0;
+	ssize_t read_count        = 0;
+	int item_index            = 0;
+	int result                = 0;
+	int return_value          = 1;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	int maximum_number_of_queued_items = 0;
+#endif
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->export_plan == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid export handle - missing export plan.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_plan_sort(
+	     export_handle->export_plan,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to sort export plan.",
+		 function );
+
+		goto on_error;
+	}
+	for( item_index = 0;
+	     item_index < export_handle->export_plan->number_of_items;
+	     item_index++ )
+	{
+		total_size += export_handle->export_plan->items[ item_index ]->size;
+	}
+	export_handle->single_file_write_failed = 0;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->number_of_threads != 0 )
+	{
+		/* Bound the number of queued items to limit the amount of buffered data
+		 */
+		maximum_number_of_queued_items = export_handle->number_of_threads * 4;
+
+		if( libcthreads_thread_pool_create(
+		     &( export_handle->single_files_write_thread_pool ),
+		     NULL,
+		     export_handle->number_of_threads,
+		     maximum_number_of_queued_items,
+		     (int (*)(intptr_t *, void *)) &export_handle_write_plan_item_data_callback,
+		     (void *) export_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize single files write thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	for( item_index = 0;
+	     item_index < export_handle->export_plan->number_of_items;
+	     item_index++ )
+	{
+		if( export_handle->abort != 0 )
+		{
+			break;
+		}
+		item = export_handle->export_plan->items[ item_index ];
+
+		fprintf(
+		 export_handle->notify_stream,
+		 "Single file: %" PRIs_SYSTEM "\n",
+		 &( item->target_path[ item->file_entry_path_index ] ) );
+
+		/* Empty files were already created when the plan was made
+		 */
+		if( item->size == 0 )
+		{
+			continue;
+		}
+		if( item->size > (size64_t) EXPORT_PLAN_MAXIMUM_BUFFERED_DATA_SIZE )
+		{
+			result = export_handle_export_plan_item_data_in_parts(
+			          export_handle,
+			          item,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to export file entry data.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		else
+		{
+			item->data = (uint8_t *) memory_allocate(
+			                          sizeof( uint8_t ) * (size_t) item->size );
+
+			if( item->data == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create file entry data.",
+				 function );
+
+				goto on_error;
+			}
+			item->data_size = (size_t) item->size;
+
+			read_count = export_handle_read_plan_item_data(
+			              export_handle,
+			              item,
+			              0,
+			              item->data,
+			              item->data_size,
+			              error );
+
+			if( read_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read file entry data.",
+				 function );
+
+				goto on_error;
+			}
+			else if( read_count != (ssize_t) item->data_size )
+			{
+				memory_free(
+				 item->data );
+
+				item->data      = NULL;
+				item->data_size = 0;
+
+				result = 0;
+			}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+			else if( export_handle->single_files_write_thread_pool != NULL )
+			{
+				if( libcthreads_thread_pool_push(
+				     export_handle->single_files_write_thread_pool,
+				     (intptr_t *) item,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to push item onto single files write thread pool queue.",
+					 function );
+
+					goto on_error;
+				}
+				result = 1;
+			}
+#endif
+			else
+			{
+				result = export_handle_write_plan_item_data(
+				          export_handle,
+				          item,
+				          error );
+
+				if( result != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write file entry data.",
+					 function );
+
+					goto on_error;
+				}
+			}
+		}
+		if( result == 0 )
+		{
+			fprintf(
+			 export_handle->notify_stream,
+			 "FAILED\n" );
+
+			if( log_handle != NULL )
+			{
+				log_handle_printf(
+				 log_handle,
+				 "FAILED\n" );
+			}
+			return_value = 0;
+		}
+		exported_size += item->size;
+
+		if( export_handle->process_status != NULL )
+		{
+			if( process_status_update(
+			     export_handle->process_status,
+			     exported_size,
+			     total_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update process status.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->single_files_write_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( export_handle->single_files_write_thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join single files write thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	if( export_handle->single_file_write_failed != 0 )
+	{
+		return_value = 0;
+	}
+	return( return_value );
+
+on_error:
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->single_files_write_thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &( export_handle->single_files_write_thread_pool ),
+		 NULL );
+	}
+#endif
+	return( -1 );
+}
+
 /* Exports a (single) file entry sub file entries
  * Returns 1 if successful, 0 if not or -1 on error
  */
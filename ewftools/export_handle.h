@@ -32,9 +32,12 @@
 #include "ewftools_libewf.h"
 #include "ewftools_libhmac.h"
 #include "ewftools_libsmraw.h"
+#include "export_plan.h"
 #include "log_handle.h"
 #include "process_status.h"
 #include "storage_media_buffer.h"
+#include "storage_media_buffer_queue.h"
+#include "storage_media_reader.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -163,6 +166,18 @@ struct export_handle
 	 */
 	int number_of_threads;
 
+	/* The number of dedicated reader threads
+	 */
+	int number_of_readers;
+
+	/* Value to indicate if the reader threads should be bound to the NUMA nodes
+	 */
+	uint8_t numa_node_affinity;
+
+	/* The maximum number of (concurrent) open file handles
+	 */
+	int maximum_number_of_open_handles;
+
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 
 	/* The input process thread pool
@@ -179,7 +194,15 @@ struct export_handle
 
 	/* The storage media buffer queue
 	 */
-	libcthreads_queue_t *storage_media_buffer_queue;
+	storage_media_buffer_queue_t *storage_media_buffer_queue;
+
+	/* The storage media reader
+	 */
+	storage_media_reader_t *storage_media_reader;
+
+	/* The single files write thread pool
+	 */
+	libcthreads_thread_pool_t *single_files_write_thread_pool;
 
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
@@ -243,6 +266,14 @@ struct export_handle
 	 */
 	process_status_t *process_status;
 
+	/* The single files export plan
+	 */
+	export_plan_t *export_plan;
+
+	/* Value to indicate if writing a single file failed
+	 */
+	int single_file_write_failed;
+
 	/* Value to indicate if abort was signalled
 	 */
 	int abort;
@@ -433,6 +464,16 @@ int export_handle_set_number_of_threads(
      const system_character_t *string,
      libcerror_error_t **error );
 
+int export_handle_set_number_of_readers(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int export_handle_set_numa_node_affinity(
+     export_handle_t *export_handle,
+     uint8_t numa_node_affinity,
+     libcerror_error_t **error );
+
 int export_handle_set_additional_digest_types(
      export_handle_t *export_handle,
      const system_character_t *string,
@@ -517,6 +558,45 @@ int export_handle_export_file_entry_data(
      const system_character_t *export_path,
      libcerror_error_t **error );
 
+int export_handle_plan_file_entry_data(
+     export_handle_t *export_handle,
+     libewf_file_entry_t *file_entry,
+     const system_character_t *target_path,
+     size_t target_path_size,
+     size_t file_entry_path_index,
+     libcerror_error_t **error );
+
+ssize_t export_handle_read_plan_item_data(
+         export_handle_t *export_handle,
+         export_plan_item_t *item,
+         size64_t offset,
+         uint8_t *buffer,
+         size_t read_size,
+         libcerror_error_t **error );
+
+int export_handle_write_plan_item_data(
+     export_handle_t *export_handle,
+     export_plan_item_t *item,
+     libcerror_error_t **error );
+
+int export_handle_export_plan_item_data_in_parts(
+     export_handle_t *export_handle,
+     export_plan_item_t *item,
+     libcerror_error_t **error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int export_handle_write_plan_item_data_callback(
+     export_plan_item_t *item,
+     export_handle_t *export_handle );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+int export_handle_export_plan(
+     export_handle_t *export_handle,
+     log_handle_t *log_handle,
+     libcerror_error_t **error );
+
 int export_handle_export_file_entry_sub_file_entries(
      export_handle_t *export_handle,
      libewf_file_entry_t *file_entry,
@@ -0,0 +1,547 @@
+/*
+ * Single files export plan
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "export_plan.h"
+#include "ewftools_libcerror.h"
+
+/* Creates an export plan item
+ * Make sure the value item is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int export_plan_item_initialize(
+     export_plan_item_t **item,
+     libcerror_error_t **error )
+{
+	static char *function = "export_plan_item_initialize";
+
+	if( item == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item.",
+		 function );
+
+		return( -1 );
+	}
+	if( *item != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid item value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*item = memory_allocate_structure(
+	         export_plan_item_t );
+
+	if( *item == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create item.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *item,
+	     0,
+	     sizeof( export_plan_item_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear item.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *item != NULL )
+	{
+		memory_free(
+		 *item );
+
+		*item = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an export plan item
+ * Returns 1 if successful or -1 on error
+ */
+int export_plan_item_free(
+     export_plan_item_t **item,
+     libcerror_error_t **error )
+{
+	static char *function = "export_plan_item_free";
+
+	if( item == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item.",
+		 function );
+
+		return( -1 );
+	}
+	if( *item != NULL )
+	{
+		if( ( *item )->target_path != NULL )
+		{
+			memory_free(
+			 ( *item )->target_path );
+		}
+		if( ( *item )->data != NULL )
+		{
+			memory_free(
+			 ( *item )->data );
+		}
+		memory_free(
+		 *item );
+
+		*item = NULL;
+	}
+	return( 1 );
+}
+
+/* Sets the target path of an export plan item
+ * Returns 1 if successful or -1 on error
+ */
+int export_plan_item_set_target_path(
+     export_plan_item_t *item,
+     const system_character_t *target_path,
+     size_t target_path_size,
+     size_t file_entry_path_index,
+     libcerror_error_t **error )
+{
+	static char *function = "export_plan_item_set_target_path";
+
+	if( item == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item.",
+		 function );
+
+		return( -1 );
+	}
+	if( item->target_path != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid item - target path value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( target_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid target path.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( target_path_size == 0 )
+	 || ( target_path_size > (size_t) ( SSIZE_MAX / sizeof( system_character_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid target path size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_entry_path_index >= target_path_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file entry path index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	item->target_path = system_string_allocate(
+	                     target_path_size );
+
+	if( item->target_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create target path.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     item->target_path,
+	     target_path,
+	     target_path_size - 1 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy target path.",
+		 function );
+
+		goto on_error;
+	}
+	item->target_path[ target_path_size - 1 ] = 0;
+
+	item->target_path_size      = target_path_size;
+	item->file_entry_path_index = file_entry_path_index;
+
+	return( 1 );
+
+on_error:
+	if( item->target_path != NULL )
+	{
+		memory_free(
+		 item->target_path );
+
+		item->target_path = NULL;
+	}
+	return( -1 );
+}
+
+/* Compares two export plan items by their media data offset
+ * Items with the same media data offset keep the order in which they were added
+ * Returns -1 if the first item is ordered before the second, 1 if after or 0 if equal
+ */
+static int export_plan_item_compare(
+            const void *first_element,
+            const void *second_element )
+{
+	const export_plan_item_t *first_item  = *( (export_plan_item_t * const *) first_element );
+	const export_plan_item_t *second_item = *( (export_plan_item_t * const *) second_element );
+
+	if( first_item->media_data_offset < second_item->media_data_offset )
+	{
+		return( -1 );
+	}
+	else if( first_item->media_data_offset > second_item->media_data_offset )
+	{
+		return( 1 );
+	}
+	if( first_item->sequence_number < second_item->sequence_number )
+	{
+		return( -1 );
+	}
+	else if( first_item->sequence_number > second_item->sequence_number )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Creates an export plan
+ * Make sure the value plan is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int export_plan_initialize(
+     export_plan_t **plan,
+     libcerror_error_t **error )
+{
+	static char *function = "export_plan_initialize";
+
+	if( plan == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid plan.",
+		 function );
+
+		return( -1 );
+	}
+	if( *plan != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid plan value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*plan = memory_allocate_structure(
+	         export_plan_t );
+
+	if( *plan == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create plan.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *plan,
+	     0,
+	     sizeof( export_plan_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear plan.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *plan != NULL )
+	{
+		memory_free(
+		 *plan );
+
+		*plan = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an export plan and its items
+ * Returns 1 if successful or -1 on error
+ */
+int export_plan_free(
+     export_plan_t **plan,
+     libcerror_error_t **error )
+{
+	static char *function = "export_plan_free";
+	int item_index        = 0;
+	int result            = 1;
+
+	if( plan == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid plan.",
+		 function );
+
+		return( -1 );
+	}
+	if( *plan != NULL )
+	{
+		if( ( *plan )->items != NULL )
+		{
+			for( item_index = 0;
+			     item_index < ( *plan )->number_of_items;
+			     item_index++ )
+			{
+				if( export_plan_item_free(
+				     &( ( *plan )->items[ item_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free item: %d.",
+					 function,
+					 item_index );
+
+					result = -1;
+				}
+			}
+			memory_free(
+			 ( *plan )->items );
+		}
+		memory_free(
+		 *plan );
+
+		*plan = NULL;
+	}
+	return( result );
+}
+
+/* Appends an item to the export plan
+ * The plan takes over management of the item
+ * Returns 1 if successful or -1 on error
+ */
+int export_plan_append_item(
+     export_plan_t *plan,
+     export_plan_item_t *item,
+     libcerror_error_t **error )
+{
+	void *reallocation                = NULL;
+	static char *function             = "export_plan_append_item";
+	size_t new_size                   = 0;
+	int new_number_of_allocated_items = 0;
+
+	if( plan == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid plan.",
+		 function );
+
+		return( -1 );
+	}
+	if( item == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item.",
+		 function );
+
+		return( -1 );
+	}
+	if( plan->number_of_items >= plan->number_of_allocated_items )
+	{
+		if( plan->number_of_allocated_items == 0 )
+		{
+			new_number_of_allocated_items = 1024;
+		}
+		else if( plan->number_of_allocated_items <= ( INT32_MAX / 2 ) )
+		{
+			new_number_of_allocated_items = plan->number_of_allocated_items * 2;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid plan - number of allocated items value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		new_size = sizeof( export_plan_item_t * ) * new_number_of_allocated_items;
+
+		if( new_size > (size_t) SSIZE_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid items size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		reallocation = memory_reallocate(
+		                plan->items,
+		                new_size );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to reallocate items.",
+			 function );
+
+			return( -1 );
+		}
+		plan->items                     = (export_plan_item_t **) reallocation;
+		plan->number_of_allocated_items = new_number_of_allocated_items;
+	}
+	item->sequence_number = plan->number_of_items;
+
+	plan->items[ plan->number_of_items ] = item;
+
+	plan->number_of_items += 1;
+
+	return( 1 );
+}
+
+/* Sorts the items of the export plan by their media data offset
+ * Returns 1 if successful or -1 on error
+ */
+int export_plan_sort(
+     export_plan_t *plan,
+     libcerror_error_t **error )
+{
+	static char *function = "export_plan_sort";
+
+	if( plan == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid plan.",
+		 function );
+
+		return( -1 );
+	}
+	if( plan->number_of_items > 1 )
+	{
+		qsort(
+		 plan->items,
+		 (size_t) plan->number_of_items,
+		 sizeof( export_plan_item_t * ),
+		 &export_plan_item_compare );
+	}
+	return( 1 );
+}
+
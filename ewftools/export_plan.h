@@ -0,0 +1,140 @@
+/*
+ * Single files export plan
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _EXPORT_PLAN_H )
+#define _EXPORT_PLAN_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The maximum size of file entry data that is read into a single buffer
+ * and handed to a writer thread, larger file entry data is exported in parts
+ */
+#define EXPORT_PLAN_MAXIMUM_BUFFERED_DATA_SIZE		( 4 * 1024 * 1024 )
+
+typedef struct export_plan_item export_plan_item_t;
+
+/* A file entry of which the data is to be exported
+ */
+struct export_plan_item
+{
+	/* The target path
+	 */
+	system_character_t *target_path;
+
+	/* The target path size
+	 */
+	size_t target_path_size;
+
+	/* The index of the file entry path in the target path
+	 */
+	size_t file_entry_path_index;
+
+	/* The media data offset
+	 */
+	off64_t media_data_offset;
+
+	/* The size of the file entry data
+	 */
+	size64_t size;
+
+	/* Value to indicate the file entry data consists of a single repeated byte
+	 * that is stored at the media data offset
+	 */
+	uint8_t is_sparse;
+
+	/* The sequence number in which the item was added to the plan
+	 */
+	int sequence_number;
+
+	/* The buffered file entry data
+	 */
+	uint8_t *data;
+
+	/* The buffered file entry data size
+	 */
+	size_t data_size;
+};
+
+typedef struct export_plan export_plan_t;
+
+/* The export plan collects the file entries to export so that their data
+ * can be read in media offset order rather than in file entry tree order
+ */
+struct export_plan
+{
+	/* The items
+	 */
+	export_plan_item_t **items;
+
+	/* The number of items
+	 */
+	int number_of_items;
+
+	/* The number of allocated items
+	 */
+	int number_of_allocated_items;
+};
+
+int export_plan_item_initialize(
+     export_plan_item_t **item,
+     libcerror_error_t **error );
+
+int export_plan_item_free(
+     export_plan_item_t **item,
+     libcerror_error_t **error );
+
+int export_plan_item_set_target_path(
+     export_plan_item_t *item,
+     const system_character_t *target_path,
+     size_t target_path_size,
+     size_t file_entry_path_index,
+     libcerror_error_t **error );
+
+int export_plan_initialize(
+     export_plan_t **plan,
+     libcerror_error_t **error );
+
+int export_plan_free(
+     export_plan_t **plan,
+     libcerror_error_t **error );
+
+int export_plan_append_item(
+     export_plan_t *plan,
+     export_plan_item_t *item,
+     libcerror_error_t **error );
+
+int export_plan_sort(
+     export_plan_t *plan,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _EXPORT_PLAN_H ) */
+
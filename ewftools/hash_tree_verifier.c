@@ -0,0 +1,810 @@
+/*
+ * Hash tree verifier
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libewf.h"
+#include "hash_tree_verifier.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Creates a hash tree verifier
+ * Make sure the value verifier is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int hash_tree_verifier_initialize(
+     hash_tree_verifier_t **verifier,
+     int number_of_verifiers,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_tree_verifier_initialize";
+	int verifier_index    = 0;
+
+	if( verifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( *verifier != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid verifier value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_verifiers <= 0 )
+	 || ( number_of_verifiers > (int) ( INT_MAX / sizeof( libewf_handle_t * ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of verifiers value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*verifier = memory_allocate_structure(
+	             hash_tree_verifier_t );
+
+	if( *verifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create verifier.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *verifier,
+	     0,
+	     sizeof( hash_tree_verifier_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear verifier.",
+		 function );
+
+		memory_free(
+		 *verifier );
+
+		*verifier = NULL;
+
+		return( -1 );
+	}
+	( *verifier )->handles = (libewf_handle_t **) memory_allocate(
+	                                             sizeof( libewf_handle_t * ) * number_of_verifiers );
+
+	if( ( *verifier )->handles == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create handles.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *verifier )->handles,
+	     0,
+	     sizeof( libewf_handle_t * ) * number_of_verifiers ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear handles.",
+		 function );
+
+		goto on_error;
+	}
+	( *verifier )->threads = (libcthreads_thread_t **) memory_allocate(
+	                                                  sizeof( libcthreads_thread_t * ) * number_of_verifiers );
+
+	if( ( *verifier )->threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create threads.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *verifier )->threads,
+	     0,
+	     sizeof( libcthreads_thread_t * ) * number_of_verifiers ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear threads.",
+		 function );
+
+		goto on_error;
+	}
+	( *verifier )->number_of_verifiers = number_of_verifiers;
+
+	for( verifier_index = 0;
+	     verifier_index < number_of_verifiers;
+	     verifier_index++ )
+	{
+		if( libewf_handle_initialize(
+		     &( ( *verifier )->handles[ verifier_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create handle: %d.",
+			 function,
+			 verifier_index );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *verifier )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *verifier != NULL )
+	{
+		if( ( *verifier )->handles != NULL )
+		{
+			for( verifier_index = 0;
+			     verifier_index < number_of_verifiers;
+			     verifier_index++ )
+			{
+				if( ( *verifier )->handles[ verifier_index ] != NULL )
+				{
+					libewf_handle_free(
+					 &( ( *verifier )->handles[ verifier_index ] ),
+					 NULL );
+				}
+			}
+			memory_free(
+			 ( *verifier )->handles );
+		}
+		if( ( *verifier )->threads != NULL )
+		{
+			memory_free(
+			 ( *verifier )->threads );
+		}
+		memory_free(
+		 *verifier );
+
+		*verifier = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a hash tree verifier
+ * Returns 1 if successful or -1 on error
+ */
+int hash_tree_verifier_free(
+     hash_tree_verifier_t **verifier,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_tree_verifier_free";
+	int verifier_index    = 0;
+	int result            = 1;
+
+	if( verifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( *verifier != NULL )
+	{
+		/* The threads are joined in hash_tree_verifier_join
+		 */
+		for( verifier_index = 0;
+		     verifier_index < ( *verifier )->number_of_verifiers;
+		     verifier_index++ )
+		{
+			if( ( ( *verifier )->handles[ verifier_index ] != NULL )
+			 && ( libewf_handle_free(
+			       &( ( *verifier )->handles[ verifier_index ] ),
+			       error ) != 1 ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free handle: %d.",
+				 function,
+				 verifier_index );
+
+				result = -1;
+			}
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *verifier )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 ( *verifier )->threads );
+
+		memory_free(
+		 ( *verifier )->handles );
+
+		memory_free(
+		 *verifier );
+
+		*verifier = NULL;
+	}
+	return( result );
+}
+
+/* Signals the hash tree verifier to abort
+ * Returns 1 if successful or -1 on error
+ */
+int hash_tree_verifier_signal_abort(
+     hash_tree_verifier_t *verifier,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_tree_verifier_signal_abort";
+	int verifier_index    = 0;
+
+	if( verifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verifier.",
+		 function );
+
+		return( -1 );
+	}
+	verifier->abort = 1;
+
+	for( verifier_index = 0;
+	     verifier_index < verifier->number_of_verifiers;
+	     verifier_index++ )
+	{
+		if( libewf_handle_signal_abort(
+		     verifier->handles[ verifier_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal handle: %d to abort.",
+			 function,
+			 verifier_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Opens the verifier handles
+ * Every verifier opens the (already resolved) segment files on its own
+ * Returns 1 if successful or -1 on error
+ */
+int hash_tree_verifier_open(
+     hash_tree_verifier_t *verifier,
+     system_character_t * const * filenames,
+     int number_of_filenames,
+     int header_codepage,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_tree_verifier_open";
+	int verifier_index    = 0;
+
+	if( verifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verifier.",
+		 function );
+
+		return( -1 );
+	}
+	for( verifier_index = 0;
+	     verifier_index < verifier->number_of_verifiers;
+	     verifier_index++ )
+	{
+		if( maximum_number_of_open_handles > 0 )
+		{
+			if( libewf_handle_set_maximum_number_of_open_handles(
+			     verifier->handles[ verifier_index ],
+			     maximum_number_of_open_handles,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set maximum number of open handles in handle: %d.",
+				 function,
+				 verifier_index );
+
+				return( -1 );
+			}
+		}
+		if( header_codepage != LIBEWF_CODEPAGE_ASCII )
+		{
+			if( libewf_handle_set_header_codepage(
+			     verifier->handles[ verifier_index ],
+			     header_codepage,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set header codepage in handle: %d.",
+				 function,
+				 verifier_index );
+
+				return( -1 );
+			}
+		}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libewf_handle_open_wide(
+		     verifier->handles[ verifier_index ],
+		     filenames,
+		     number_of_filenames,
+		     LIBEWF_OPEN_READ,
+		     error ) != 1 )
+#else
+		if( libewf_handle_open(
+		     verifier->handles[ verifier_index ],
+		     filenames,
+		     number_of_filenames,
+		     LIBEWF_OPEN_READ,
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open handle: %d.",
+			 function,
+			 verifier_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Closes the verifier handles
+ * Returns the 0 if succesful or -1 on error
+ */
+int hash_tree_verifier_close(
+     hash_tree_verifier_t *verifier,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_tree_verifier_close";
+	int verifier_index    = 0;
+	int result            = 0;
+
+	if( verifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verifier.",
+		 function );
+
+		return( -1 );
+	}
+	for( verifier_index = 0;
+	     verifier_index < verifier->number_of_verifiers;
+	     verifier_index++ )
+	{
+		if( libewf_handle_close(
+		     verifier->handles[ verifier_index ],
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close handle: %d.",
+			 function,
+			 verifier_index );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Starts the verifier threads
+ * The verifiers claim the leaves from first leaf index onwards and store
+ * the result of each leaf in leaf results, which must be able to contain
+ * number of leaves values
+ * Returns 1 if successful or -1 on error
+ */
+int hash_tree_verifier_start(
+     hash_tree_verifier_t *verifier,
+     uint64_t first_leaf_index,
+     uint64_t number_of_leaves,
+     uint8_t *leaf_results,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_tree_verifier_start";
+	int verifier_index    = 0;
+
+	if( verifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( leaf_results == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid leaf results.",
+		 function );
+
+		return( -1 );
+	}
+	verifier->first_leaf_index  = first_leaf_index;
+	verifier->number_of_leaves  = number_of_leaves;
+	verifier->next_leaf_index   = 0;
+	verifier->leaf_results      = leaf_results;
+	verifier->next_handle_index = 0;
+	verifier->has_failed        = 0;
+
+	for( verifier_index = 0;
+	     verifier_index < verifier->number_of_verifiers;
+	     verifier_index++ )
+	{
+		if( libcthreads_thread_create(
+		     &( verifier->threads[ verifier_index ] ),
+		     NULL,
+		     (int (*)(void *)) &hash_tree_verifier_thread_callback,
+		     (void *) verifier,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread: %d.",
+			 function,
+			 verifier_index );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	/* Stop and join the verifier threads that were already started
+	 */
+	verifier->abort = 1;
+
+	hash_tree_verifier_join(
+	 verifier,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Joins the verifier threads
+ * Returns 1 if successful or -1 on error
+ */
+int hash_tree_verifier_join(
+     hash_tree_verifier_t *verifier,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_tree_verifier_join";
+	int verifier_index    = 0;
+	int result            = 1;
+
+	if( verifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verifier.",
+		 function );
+
+		return( -1 );
+	}
+	for( verifier_index = 0;
+	     verifier_index < verifier->number_of_verifiers;
+	     verifier_index++ )
+	{
+		if( verifier->threads[ verifier_index ] == NULL )
+		{
+			continue;
+		}
+		if( libcthreads_thread_join(
+		     &( verifier->threads[ verifier_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread: %d.",
+			 function,
+			 verifier_index );
+
+			result = -1;
+		}
+	}
+	if( ( result == 1 )
+	 && ( verifier->has_failed != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to verify hash tree leaves.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+/* Verifies hash tree leaves until all leaves have been claimed
+ * Callback function for the verifier threads
+ * Returns 1 if successful or -1 on error
+ */
+int hash_tree_verifier_thread_callback(
+     hash_tree_verifier_t *verifier )
+{
+	libcerror_error_t *error = NULL;
+	libewf_handle_t *handle  = NULL;
+	static char *function    = "hash_tree_verifier_thread_callback";
+	uint64_t leaf_index      = 0;
+	int mutex_grabbed        = 0;
+	int result               = 0;
+
+	if( verifier == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verifier.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_grab(
+	     verifier->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	handle = verifier->handles[ verifier->next_handle_index ];
+
+	verifier->next_handle_index += 1;
+
+	if( libcthreads_mutex_release(
+	     verifier->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	while( verifier->abort == 0 )
+	{
+		if( libcthreads_mutex_grab(
+		     verifier->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			goto on_error;
+		}
+		mutex_grabbed = 1;
+
+		if( verifier->next_leaf_index >= verifier->number_of_leaves )
+		{
+			break;
+		}
+		leaf_index = verifier->next_leaf_index;
+
+		verifier->next_leaf_index += 1;
+
+		if( libcthreads_mutex_release(
+		     verifier->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			goto on_error;
+		}
+		mutex_grabbed = 0;
+
+		result = libewf_handle_verify_hash_tree_leaf(
+		          handle,
+		          verifier->first_leaf_index + leaf_index,
+		          &error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to verify hash tree leaf: %" PRIu64 ".",
+			 function,
+			 verifier->first_leaf_index + leaf_index );
+
+			goto on_error;
+		}
+		/* Every leaf result is written by a single thread
+		 */
+		if( result != 0 )
+		{
+			verifier->leaf_results[ leaf_index ] = HASH_TREE_VERIFIER_LEAF_RESULT_MATCH;
+		}
+		else
+		{
+			verifier->leaf_results[ leaf_index ] = HASH_TREE_VERIFIER_LEAF_RESULT_MISMATCH;
+		}
+	}
+	if( mutex_grabbed != 0 )
+	{
+		mutex_grabbed = 0;
+
+		if( libcthreads_mutex_release(
+		     verifier->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( verifier != NULL )
+	{
+		/* Make the other verifiers stop
+		 */
+		verifier->has_failed = 1;
+		verifier->abort      = 1;
+
+		if( mutex_grabbed != 0 )
+		{
+			libcthreads_mutex_release(
+			 verifier->mutex,
+			 NULL );
+		}
+	}
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,144 @@
+/*
+ * Hash tree verifier
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _HASH_TREE_VERIFIER_H )
+#define _HASH_TREE_VERIFIER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libewf.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+enum HASH_TREE_VERIFIER_LEAF_RESULTS
+{
+	HASH_TREE_VERIFIER_LEAF_RESULT_UNVERIFIED	= 0,
+	HASH_TREE_VERIFIER_LEAF_RESULT_MATCH		= 1,
+	HASH_TREE_VERIFIER_LEAF_RESULT_MISMATCH		= 2
+};
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+typedef struct hash_tree_verifier hash_tree_verifier_t;
+
+/* The hash tree verifier verifies hash tree leaves concurrently
+ * Every verifier thread has its own libewf handle and claims the next
+ * unverified leaf, since the leaves can be verified in any order
+ */
+struct hash_tree_verifier
+{
+	/* The number of verifiers
+	 */
+	int number_of_verifiers;
+
+	/* The verifier (libewf) handles
+	 */
+	libewf_handle_t **handles;
+
+	/* The verifier threads
+	 */
+	libcthreads_thread_t **threads;
+
+	/* The mutex that serializes claiming a leaf
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The index of the first leaf to verify
+	 */
+	uint64_t first_leaf_index;
+
+	/* The number of leaves to verify
+	 */
+	uint64_t number_of_leaves;
+
+	/* The index of the next leaf to verify relative to the first leaf index
+	 */
+	uint64_t next_leaf_index;
+
+	/* The leaf results
+	 */
+	uint8_t *leaf_results;
+
+	/* The index of the next handle to be assigned to a verifier thread
+	 */
+	int next_handle_index;
+
+	/* Value to indicate if one of the verifier threads failed
+	 */
+	int has_failed;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int hash_tree_verifier_initialize(
+     hash_tree_verifier_t **verifier,
+     int number_of_verifiers,
+     libcerror_error_t **error );
+
+int hash_tree_verifier_free(
+     hash_tree_verifier_t **verifier,
+     libcerror_error_t **error );
+
+int hash_tree_verifier_signal_abort(
+     hash_tree_verifier_t *verifier,
+     libcerror_error_t **error );
+
+int hash_tree_verifier_open(
+     hash_tree_verifier_t *verifier,
+     system_character_t * const * filenames,
+     int number_of_filenames,
+     int header_codepage,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error );
+
+int hash_tree_verifier_close(
+     hash_tree_verifier_t *verifier,
+     libcerror_error_t **error );
+
+int hash_tree_verifier_start(
+     hash_tree_verifier_t *verifier,
+     uint64_t first_leaf_index,
+     uint64_t number_of_leaves,
+     uint8_t *leaf_results,
+     libcerror_error_t **error );
+
+int hash_tree_verifier_join(
+     hash_tree_verifier_t *verifier,
+     libcerror_error_t **error );
+
+int hash_tree_verifier_thread_callback(
+     hash_tree_verifier_t *verifier );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _HASH_TREE_VERIFIER_H ) */
+
@@ -34,6 +34,7 @@
 #endif
 
 #include "byte_size_string.h"
+#include "compression_level_controller.h"
 #include "digest_hash.h"
 #include "ewfcommon.h"
 #include "ewfinput.h"
@@ -382,6 +383,22 @@ int imaging_handle_free(
 				result = -1;
 			}
 		}
+		if( ( *imaging_handle )->compression_level_controller != NULL )
+		{
+			if( compression_level_controller_free(
+			     &( ( *imaging_handle )->compression_level_controller ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free compression level controller.",
+				 function );
+
+				result = -1;
+			}
+		}
 		memory_free(
 		 *imaging_handle );
 
@@ -603,11 +620,15 @@ int imaging_handle_open_output(
 
 	if( resume != 0 )
 	{
+		/* The hash tree cannot be continued from a previous acquiry
+		 */
+		imaging_handle->calculate_hash_tree = 0;
+
 		first_filename_length = system_string_length(
 		                         filenames[ 0 ] );
 
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-		if( libewf_glob_wide(
+		if( libewf_glob_directory_wide(
 		     filenames[ 0 ],
 		     first_filename_length,
 		     LIBEWF_FORMAT_UNKNOWN,
@@ -615,7 +636,7 @@ int imaging_handle_open_output(
 		     &number_of_filenames,
 		     error ) != 1 )
 #else
-		if( libewf_glob(
+		if( libewf_glob_directory(
 		     filenames[ 0 ],
 		     first_filename_length,
 		     LIBEWF_FORMAT_UNKNOWN,
@@ -767,7 +788,7 @@ int imaging_handle_open_secondary_output(
 		                         filenames[ 0 ] );
 
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-		if( libewf_glob_wide(
+		if( libewf_glob_directory_wide(
 		     filenames[ 0 ],
 		     first_filename_length,
 		     LIBEWF_FORMAT_UNKNOWN,
@@ -775,7 +796,7 @@ int imaging_handle_open_secondary_output(
 		     &number_of_filenames,
 		     error ) != 1 )
 #else
-		if( libewf_glob(
+		if( libewf_glob_directory(
 		     filenames[ 0 ],
 		     first_filename_length,
 		     LIBEWF_FORMAT_UNKNOWN,
@@ -1466,6 +1487,42 @@ int imaging_handle_update_integrity_hash(
 			return( -1 );
 		}
 	}
+	if( imaging_handle->calculate_hash_tree != 0 )
+	{
+		if( libewf_handle_update_hash_tree(
+		     imaging_handle->output_handle,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update hash tree.",
+			 function );
+
+			return( -1 );
+		}
+		if( imaging_handle->secondary_output_handle != NULL )
+		{
+			if( libewf_handle_update_hash_tree(
+			     imaging_handle->secondary_output_handle,
+			     buffer,
+			     buffer_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update hash tree in secondary output handle.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
 	return( 1 );
 }
 
@@ -1656,7 +1713,8 @@ int imaging_handle_process_storage_media_buffer_callback(
 
 		goto on_error;
 	}
-	process_count = storage_media_buffer_write_process(
+	process_count = imaging_handle_process_storage_media_buffer(
+			 imaging_handle,
 			 storage_media_buffer,
 			 &error );
 
@@ -3555,8 +3613,9 @@ int imaging_handle_set_compression_values(
 
 		goto on_error;
 	}
-	result = ewfinput_determine_compression_values(
+	result = ewfinput_determine_adaptive_compression_values(
 	          string_segment,
+	          &( imaging_handle->minimum_compression_level ),
 	          &( imaging_handle->compression_level ),
 	          &( imaging_handle->compression_flags ),
 	          error );
@@ -3567,11 +3626,37 @@ int imaging_handle_set_compression_values(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine compression values.",
+		 "%s: unable to determine adaptive compression values.",
 		 function );
 
 		goto on_error;
 	}
+	else if( result != 0 )
+	{
+		imaging_handle->use_adaptive_compression = 1;
+	}
+	else
+	{
+		imaging_handle->use_adaptive_compression = 0;
+
+		result = ewfinput_determine_compression_values(
+		          string_segment,
+		          &( imaging_handle->compression_level ),
+		          &( imaging_handle->compression_flags ),
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine compression values.",
+			 function );
+
+			goto on_error;
+		}
+	}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 	if( libcsplit_wide_split_string_free(
 	     &string_elements,
@@ -3609,6 +3694,210 @@ on_error:
 	return( -1 );
 }
 
+/* Initializes the compression level controller if adaptive compression is used
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_initialize_compression_level_controller(
+     imaging_handle_t *imaging_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_initialize_compression_level_controller";
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( imaging_handle->compression_level_controller != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid imaging handle - compression level controller value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( imaging_handle->use_adaptive_compression == 0 )
+	{
+		return( 1 );
+	}
+	if( compression_level_controller_initialize(
+	     &( imaging_handle->compression_level_controller ),
+	     imaging_handle->minimum_compression_level,
+	     imaging_handle->compression_level,
+	     imaging_handle->number_of_threads,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create compression level controller.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Processes a storage media buffer before it is written
+ * If adaptive compression is used the compression level of the chunk is chosen
+ * by the compression level controller
+ * Returns the number of bytes processed or -1 on error
+ */
+ssize_t imaging_handle_process_storage_media_buffer(
+         imaging_handle_t *imaging_handle,
+         storage_media_buffer_t *storage_media_buffer,
+         libcerror_error_t **error )
+{
+	static char *function    = "imaging_handle_process_storage_media_buffer";
+	ssize_t process_count    = 0;
+	uint64_t end_time        = 0;
+	uint64_t start_time      = 0;
+	int8_t compression_level = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( imaging_handle->compression_level_controller == NULL )
+	 || ( storage_media_buffer->mode != STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA ) )
+	{
+		process_count = storage_media_buffer_write_process(
+		                 storage_media_buffer,
+		                 error );
+
+		if( process_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to prepare storage media buffer before write.",
+			 function );
+
+			return( -1 );
+		}
+		return( process_count );
+	}
+	if( compression_level_controller_get_compression_level(
+	     imaging_handle->compression_level_controller,
+	     &compression_level,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve compression level.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_data_chunk_set_compression_level(
+	     storage_media_buffer->data_chunk,
+	     compression_level,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set data chunk compression level.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_level_controller_get_current_time(
+	     &start_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start time.",
+		 function );
+
+		return( -1 );
+	}
+	process_count = storage_media_buffer_write_process(
+	                 storage_media_buffer,
+	                 error );
+
+	if( process_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to prepare storage media buffer before write.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_level_controller_get_current_time(
+	     &end_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve end time.",
+		 function );
+
+		return( -1 );
+	}
+	if( end_time < start_time )
+	{
+		end_time = start_time;
+	}
+	if( compression_level_controller_update(
+	     imaging_handle->compression_level_controller,
+	     compression_level,
+	     (size_t) process_count,
+	     end_time - start_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update compression level controller.",
+		 function );
+
+		return( -1 );
+	}
+	return( process_count );
+}
+
 /* Sets the format
  * Returns 1 if successful, 0 if unsupported value or -1 on error
  */
@@ -4182,6 +4471,64 @@ int imaging_handle_set_process_buffer_size(
 	return( result );
 }
 
+/* Sets the input buffer size
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int imaging_handle_set_input_buffer_size(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function  = "imaging_handle_set_input_buffer_size";
+	size_t string_length   = 0;
+	uint64_t size_variable = 0;
+	int result             = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	result = byte_size_string_convert(
+	          string,
+	          string_length,
+	          &size_variable,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine input buffer size.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( size_variable > (uint64_t) SSIZE_MAX )
+		{
+			result = 0;
+		}
+		else
+		{
+			imaging_handle->input_buffer_size = (size_t) size_variable;
+		}
+	}
+	return( result );
+}
+
 /* Sets the number of threads
  * Returns 1 if successful, 0 if unsupported value or -1 on error
  */
@@ -4231,7 +4578,7 @@ int imaging_handle_set_number_of_threads(
 		}
 		result = 1;
 
-		if( number_of_threads > 32 )
+		if( number_of_threads > (uint64_t) EWFCOMMON_MAXIMUM_NUMBER_OF_THREADS )
 		{
 			result = 0;
 		}
@@ -4255,6 +4602,7 @@ int imaging_handle_set_additional_digest_types(
 	static char *function                            = "imaging_handle_set_additional_digest_types";
 	size_t string_length                             = 0;
 	size_t string_segment_size                       = 0;
+	uint8_t calculate_hash_tree                      = 0;
 	uint8_t calculate_sha1                           = 0;
 	uint8_t calculate_sha256                         = 0;
 	int number_of_segments                           = 0;
@@ -4465,6 +4813,23 @@ int imaging_handle_set_additional_digest_types(
 				calculate_sha256 = 1;
 			}
 		}
+		else if( string_segment_size == 9 )
+		{
+			if( system_string_compare(
+			     string_segment,
+			     _SYSTEM_STRING( "hashtree" ),
+			     8 ) == 0 )
+			{
+				calculate_hash_tree = 1;
+			}
+			else if( system_string_compare(
+			          string_segment,
+			          _SYSTEM_STRING( "HASHTREE" ),
+			          8 ) == 0 )
+			{
+				calculate_hash_tree = 1;
+			}
+		}
 	}
 	if( ( calculate_sha1 != 0 )
 	 && ( imaging_handle->calculate_sha1 == 0 ) )
@@ -4504,6 +4869,10 @@ int imaging_handle_set_additional_digest_types(
 		}
 		imaging_handle->calculate_sha256 = 1;
 	}
+	if( calculate_hash_tree != 0 )
+	{
+		imaging_handle->calculate_hash_tree = 1;
+	}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 	if( libcsplit_wide_split_string_free(
 	     &string_elements,
@@ -5121,6 +5490,47 @@ int imaging_handle_set_output_values(
 			return( -1 );
 		}
 	}
+	/* The hash tree section is only written in EWF version 1 formats
+	 */
+	if( ( imaging_handle->ewf_format == LIBEWF_FORMAT_V2_ENCASE7 )
+	 || ( imaging_handle->ewf_format == LIBEWF_FORMAT_V2_LOGICAL_ENCASE7 ) )
+	{
+		imaging_handle->calculate_hash_tree = 0;
+	}
+	if( imaging_handle->calculate_hash_tree != 0 )
+	{
+		if( libewf_handle_set_hash_tree_range_size(
+		     imaging_handle->output_handle,
+		     IMAGING_HANDLE_HASH_TREE_RANGE_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set hash tree range size.",
+			 function );
+
+			return( -1 );
+		}
+		if( imaging_handle->secondary_output_handle != NULL )
+		{
+			if( libewf_handle_set_hash_tree_range_size(
+			     imaging_handle->secondary_output_handle,
+			     IMAGING_HANDLE_HASH_TREE_RANGE_SIZE,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set hash tree range size in secondary output handle.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
 #if defined( HAVE_GUID_SUPPORT ) || defined( WINAPI )
 	if( ( imaging_handle->ewf_format == LIBEWF_FORMAT_ENCASE5 )
 	 || ( imaging_handle->ewf_format == LIBEWF_FORMAT_ENCASE6 )
@@ -6312,6 +6722,40 @@ int imaging_handle_print_parameters(
 			 "none" );
 		}
 	}
+	if( imaging_handle->use_adaptive_compression != 0 )
+	{
+		fprintf(
+		 imaging_handle->notify_stream,
+		 " (adaptive from: " );
+
+		if( imaging_handle->minimum_compression_level == LIBEWF_COMPRESSION_FAST )
+		{
+			fprintf(
+			 imaging_handle->notify_stream,
+			 "fast" );
+		}
+		else if( imaging_handle->minimum_compression_level == LIBEWF_COMPRESSION_BEST )
+		{
+			fprintf(
+			 imaging_handle->notify_stream,
+			 "best" );
+		}
+		else if( ( imaging_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION ) != 0 )
+		{
+			fprintf(
+			 imaging_handle->notify_stream,
+			 "empty-block" );
+		}
+		else
+		{
+			fprintf(
+			 imaging_handle->notify_stream,
+			 "none" );
+		}
+		fprintf(
+		 imaging_handle->notify_stream,
+		 ")" );
+	}
 	fprintf(
 	 imaging_handle->notify_stream,
 	 "\n" );
@@ -6501,3 +6945,45 @@ int imaging_handle_print_hashes(
 	return( 1 );
 }
 
+/* Prints the distribution of the compression levels chosen by adaptive compression
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_print_compression_levels(
+     imaging_handle_t *imaging_handle,
+     FILE *stream,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_print_compression_levels";
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( imaging_handle->compression_level_controller == NULL )
+	{
+		return( 1 );
+	}
+	if( compression_level_controller_fprint(
+	     imaging_handle->compression_level_controller,
+	     stream,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print compression levels.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
@@ -26,6 +26,7 @@
 #include <file_stream.h>
 #include <types.h>
 
+#include "compression_level_controller.h"
 #include "ewftools_libcdata.h"
 #include "ewftools_libcerror.h"
 #include "ewftools_libcthreads.h"
@@ -33,11 +34,16 @@
 #include "ewftools_libhmac.h"
 #include "process_status.h"
 #include "storage_media_buffer.h"
+#include "storage_media_buffer_queue.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
+/* The size of the media data range of a hash tree leaf
+ */
+#define IMAGING_HANDLE_HASH_TREE_RANGE_SIZE	( 64 * 1024 * 1024 )
+
 typedef struct imaging_handle imaging_handle_t;
 
 struct imaging_handle
@@ -118,6 +124,19 @@ struct imaging_handle
 	 */
 	uint8_t compression_flags;
 
+	/* Value to indicate if the compression level should be adapted per chunk
+	 */
+	uint8_t use_adaptive_compression;
+
+	/* The minimum compression level used by adaptive compression
+	 * the compression level is used as the maximum
+	 */
+	int8_t minimum_compression_level;
+
+	/* The compression level controller
+	 */
+	compression_level_controller_t *compression_level_controller;
+
 	/* The EWF format
 	 */
 	uint8_t ewf_format;
@@ -202,6 +221,10 @@ struct imaging_handle
 	 */
 	system_character_t *calculated_sha256_hash_string;
 
+	/* Value to indicate if a hash tree should be written to the output
+	 */
+	uint8_t calculate_hash_tree;
+
 	/* Value to indicate if the chunk data instead of the buffered read and write functions should be used
 	 */
 	uint8_t use_chunk_data_functions;
@@ -210,6 +233,10 @@ struct imaging_handle
 	 */
 	size_t process_buffer_size;
 
+	/* The input buffer size, where 0 represents no input buffer
+	 */
+	size_t input_buffer_size;
+
 	/* The number of threads in the process thread pool
 	 */
 	int number_of_threads;
@@ -230,7 +257,7 @@ struct imaging_handle
 
 	/* The storage media buffer queue
 	 */
-	libcthreads_queue_t *storage_media_buffer_queue;
+	storage_media_buffer_queue_t *storage_media_buffer_queue;
 
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
@@ -439,6 +466,15 @@ int imaging_handle_set_compression_values(
      const system_character_t *string,
      libcerror_error_t **error );
 
+int imaging_handle_initialize_compression_level_controller(
+     imaging_handle_t *imaging_handle,
+     libcerror_error_t **error );
+
+ssize_t imaging_handle_process_storage_media_buffer(
+         imaging_handle_t *imaging_handle,
+         storage_media_buffer_t *storage_media_buffer,
+         libcerror_error_t **error );
+
 int imaging_handle_set_format(
      imaging_handle_t *imaging_handle,
      const system_character_t *string,
@@ -494,6 +530,11 @@ int imaging_handle_set_process_buffer_size(
      const system_character_t *string,
      libcerror_error_t **error );
 
+int imaging_handle_set_input_buffer_size(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
 int imaging_handle_set_number_of_threads(
      imaging_handle_t *imaging_handle,
      const system_character_t *string,
@@ -570,6 +611,11 @@ int imaging_handle_print_hashes(
      FILE *stream,
      libcerror_error_t **error );
 
+int imaging_handle_print_compression_levels(
+     imaging_handle_t *imaging_handle,
+     FILE *stream,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
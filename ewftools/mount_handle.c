@@ -27,7 +27,9 @@
 #include <wide_string.h>
 
 #include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
 #include "ewftools_libewf.h"
+#include "ewftools_system_string.h"
 #include "mount_handle.h"
 
 /* Creates a mount handle
@@ -105,6 +107,10 @@ int mount_handle_initialize(
 	}
 	( *mount_handle )->input_format = MOUNT_HANDLE_INPUT_FORMAT_RAW;
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	( *mount_handle )->number_of_read_handles = 4;
+#endif
+
 	return( 1 );
 
 on_error:
@@ -128,6 +134,10 @@ int mount_handle_free(
 	static char *function = "mount_handle_free";
 	int result            = 1;
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	int read_handle_index = 0;
+#endif
+
 	if( mount_handle == NULL )
 	{
 		libcerror_error_set(
@@ -141,6 +151,72 @@ int mount_handle_free(
 	}
 	if( *mount_handle != NULL )
 	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *mount_handle )->read_handles != NULL )
+		{
+			/* The first read handle is the input handle
+			 */
+			for( read_handle_index = 1;
+			     read_handle_index < ( *mount_handle )->number_of_read_handles;
+			     read_handle_index++ )
+			{
+				if( ( ( *mount_handle )->read_handles[ read_handle_index ] != NULL )
+				 && ( libewf_handle_free(
+				       &( ( *mount_handle )->read_handles[ read_handle_index ] ),
+				       error ) != 1 ) )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free read handle: %d.",
+					 function,
+					 read_handle_index );
+
+					result = -1;
+				}
+			}
+			memory_free(
+			 ( *mount_handle )->read_handles );
+		}
+		if( ( *mount_handle )->free_read_handles != NULL )
+		{
+			memory_free(
+			 ( *mount_handle )->free_read_handles );
+		}
+		if( ( *mount_handle )->read_handles_condition != NULL )
+		{
+			if( libcthreads_condition_free(
+			     &( ( *mount_handle )->read_handles_condition ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free read handles condition.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *mount_handle )->read_handles_mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *mount_handle )->read_handles_mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free read handles mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
 		if( ( *mount_handle )->root_file_entry != NULL )
 		{
 			if( libewf_file_entry_free(
@@ -187,6 +263,10 @@ int mount_handle_signal_abort(
 {
 	static char *function = "mount_handle_signal_abort";
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	int read_handle_index = 0;
+#endif
+
 	if( mount_handle == NULL )
 	{
 		libcerror_error_set(
@@ -214,6 +294,34 @@ int mount_handle_signal_abort(
 			return( -1 );
 		}
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( mount_handle->read_handles != NULL )
+	{
+		for( read_handle_index = 1;
+		     read_handle_index < mount_handle->number_of_read_handles;
+		     read_handle_index++ )
+		{
+			if( mount_handle->read_handles[ read_handle_index ] == NULL )
+			{
+				continue;
+			}
+			if( libewf_handle_signal_abort(
+			     mount_handle->read_handles[ read_handle_index ],
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to signal read handle: %d to abort.",
+				 function,
+				 read_handle_index );
+
+				return( -1 );
+			}
+		}
+	}
+#endif
 	return( 1 );
 }
 
@@ -252,9 +360,80 @@ int mount_handle_set_maximum_number_of_open_handles(
 
 		return( -1 );
 	}
+	mount_handle->maximum_number_of_open_handles = maximum_number_of_open_handles;
+
 	return( 1 );
 }
 
+/* Sets the number of read handles
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int mount_handle_set_number_of_read_handles(
+     mount_handle_t *mount_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function           = "mount_handle_set_number_of_read_handles";
+	size_t string_length            = 0;
+	uint64_t number_of_read_handles = 0;
+	int result                      = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( string[ 0 ] != (system_character_t) '-' )
+	{
+		string_length = system_string_length(
+				 string );
+
+		if( ewftools_system_string_decimal_copy_to_64_bit(
+		     string,
+		     string_length + 1,
+		     &number_of_read_handles,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine number of read handles.",
+			 function );
+
+			return( -1 );
+		}
+		result = 1;
+
+		if( number_of_read_handles > (uint64_t) MOUNT_HANDLE_MAXIMUM_NUMBER_OF_READ_HANDLES )
+		{
+			result = 0;
+		}
+		else
+		{
+			mount_handle->number_of_read_handles = (int) number_of_read_handles;
+		}
+	}
+	return( result );
+}
+
 /* Sets the format
  * Returns 1 if successful, 0 if unsupported value or -1 on error
  */
@@ -358,7 +537,7 @@ int mount_handle_open_input(
 		                         filenames[ 0 ] );
 
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-		if( libewf_glob_wide(
+		if( libewf_glob_directory_wide(
 		     filenames[ 0 ],
 		     first_filename_length,
 		     LIBEWF_FORMAT_UNKNOWN,
@@ -366,7 +545,7 @@ int mount_handle_open_input(
 		     &number_of_filenames,
 		     error ) != 1 )
 #else
-		if( libewf_glob(
+		if( libewf_glob_directory(
 		     filenames[ 0 ],
 		     first_filename_length,
 		     LIBEWF_FORMAT_UNKNOWN,
@@ -425,6 +604,40 @@ int mount_handle_open_input(
 		}
 		return( -1 );
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( mount_handle->number_of_read_handles > 1 )
+	{
+		if( mount_handle_open_read_handles(
+		     mount_handle,
+		     filenames,
+		     number_of_filenames,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open read handles.",
+			 function );
+
+			if( libewf_filenames != NULL )
+			{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+				libewf_glob_wide_free(
+				 libewf_filenames,
+				 number_of_filenames,
+				 NULL );
+#else
+				libewf_glob_free(
+				 libewf_filenames,
+				 number_of_filenames,
+				 NULL );
+#endif
+			}
+			return( -1 );
+		}
+	}
+#endif
 	if( libewf_filenames != NULL )
 	{
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -469,6 +682,442 @@ int mount_handle_open_input(
 	return( 1 );
 }
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Opens the additional read handles
+ * Every read handle has its own file IO pool and chunk cache,
+ * so that reads by different threads do not serialize on the input handle
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_open_read_handles(
+     mount_handle_t *mount_handle,
+     system_character_t * const * filenames,
+     int number_of_filenames,
+     libcerror_error_t **error )
+{
+	static char *function              = "mount_handle_open_read_handles";
+	int maximum_number_of_open_handles = 0;
+	int read_handle_index              = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( mount_handle->read_handles != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid mount handle - read handles value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( mount_handle->number_of_read_handles <= 1 )
+	 || ( mount_handle->number_of_read_handles > MOUNT_HANDLE_MAXIMUM_NUMBER_OF_READ_HANDLES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid mount handle - number of read handles value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	mount_handle->read_handles = (libewf_handle_t **) memory_allocate(
+	                                                   sizeof( libewf_handle_t * ) * mount_handle->number_of_read_handles );
+
+	if( mount_handle->read_handles == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read handles.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     mount_handle->read_handles,
+	     0,
+	     sizeof( libewf_handle_t * ) * mount_handle->number_of_read_handles ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear read handles.",
+		 function );
+
+		goto on_error;
+	}
+	mount_handle->free_read_handles = (libewf_handle_t **) memory_allocate(
+	                                                        sizeof( libewf_handle_t * ) * mount_handle->number_of_read_handles );
+
+	if( mount_handle->free_read_handles == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create free read handles.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( mount_handle->read_handles_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create read handles mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( mount_handle->read_handles_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create read handles condition.",
+		 function );
+
+		goto on_error;
+	}
+	/* The maximum number of open file handles is divided over the read handles
+	 */
+	if( mount_handle->maximum_number_of_open_handles > 0 )
+	{
+		maximum_number_of_open_handles = mount_handle->maximum_number_of_open_handles / mount_handle->number_of_read_handles;
+
+		if( maximum_number_of_open_handles == 0 )
+		{
+			maximum_number_of_open_handles = 1;
+		}
+		if( libewf_handle_set_maximum_number_of_open_handles(
+		     mount_handle->input_handle,
+		     maximum_number_of_open_handles,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum number of open handles in input handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	mount_handle->read_handles[ 0 ] = mount_handle->input_handle;
+
+	for( read_handle_index = 1;
+	     read_handle_index < mount_handle->number_of_read_handles;
+	     read_handle_index++ )
+	{
+		if( libewf_handle_initialize(
+		     &( mount_handle->read_handles[ read_handle_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize read handle: %d.",
+			 function,
+			 read_handle_index );
+
+			goto on_error;
+		}
+		if( maximum_number_of_open_handles > 0 )
+		{
+			if( libewf_handle_set_maximum_number_of_open_handles(
+			     mount_handle->read_handles[ read_handle_index ],
+			     maximum_number_of_open_handles,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set maximum number of open handles in read handle: %d.",
+				 function,
+				 read_handle_index );
+
+				goto on_error;
+			}
+		}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libewf_handle_open_wide(
+		     mount_handle->read_handles[ read_handle_index ],
+		     filenames,
+		     number_of_filenames,
+		     LIBEWF_OPEN_READ,
+		     error ) != 1 )
+#else
+		if( libewf_handle_open(
+		     mount_handle->read_handles[ read_handle_index ],
+		     filenames,
+		     number_of_filenames,
+		     LIBEWF_OPEN_READ,
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open read handle: %d.",
+			 function,
+			 read_handle_index );
+
+			goto on_error;
+		}
+	}
+	for( read_handle_index = 0;
+	     read_handle_index < mount_handle->number_of_read_handles;
+	     read_handle_index++ )
+	{
+		mount_handle->free_read_handles[ read_handle_index ] = mount_handle->read_handles[ read_handle_index ];
+	}
+	mount_handle->number_of_free_read_handles = mount_handle->number_of_read_handles;
+
+	return( 1 );
+
+on_error:
+	if( mount_handle->read_handles_condition != NULL )
+	{
+		libcthreads_condition_free(
+		 &( mount_handle->read_handles_condition ),
+		 NULL );
+	}
+	if( mount_handle->read_handles_mutex != NULL )
+	{
+		libcthreads_mutex_free(
+		 &( mount_handle->read_handles_mutex ),
+		 NULL );
+	}
+	if( mount_handle->free_read_handles != NULL )
+	{
+		memory_free(
+		 mount_handle->free_read_handles );
+
+		mount_handle->free_read_handles = NULL;
+	}
+	if( mount_handle->read_handles != NULL )
+	{
+		for( read_handle_index = 1;
+		     read_handle_index < mount_handle->number_of_read_handles;
+		     read_handle_index++ )
+		{
+			if( mount_handle->read_handles[ read_handle_index ] != NULL )
+			{
+				libewf_handle_close(
+				 mount_handle->read_handles[ read_handle_index ],
+				 NULL );
+				libewf_handle_free(
+				 &( mount_handle->read_handles[ read_handle_index ] ),
+				 NULL );
+			}
+		}
+		memory_free(
+		 mount_handle->read_handles );
+
+		mount_handle->read_handles = NULL;
+	}
+	return( -1 );
+}
+
+/* Grabs a read handle that is not in use
+ * Blocks until a read handle is available
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_grab_read_handle(
+     mount_handle_t *mount_handle,
+     libewf_handle_t **read_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_grab_read_handle";
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     mount_handle->read_handles_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read handles mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( mount_handle->number_of_free_read_handles == 0 )
+	{
+		if( libcthreads_condition_wait(
+		     mount_handle->read_handles_condition,
+		     mount_handle->read_handles_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for read handles condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 mount_handle->read_handles_mutex,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	mount_handle->number_of_free_read_handles -= 1;
+
+	*read_handle = mount_handle->free_read_handles[ mount_handle->number_of_free_read_handles ];
+
+	if( libcthreads_mutex_release(
+	     mount_handle->read_handles_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read handles mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Releases a read handle that was grabbed
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_release_read_handle(
+     mount_handle_t *mount_handle,
+     libewf_handle_t *read_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_release_read_handle";
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     mount_handle->read_handles_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read handles mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( mount_handle->number_of_free_read_handles >= mount_handle->number_of_read_handles )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of free read handles value out of bounds.",
+		 function );
+
+		libcthreads_mutex_release(
+		 mount_handle->read_handles_mutex,
+		 NULL );
+
+		return( -1 );
+	}
+	mount_handle->free_read_handles[ mount_handle->number_of_free_read_handles ] = read_handle;
+
+	mount_handle->number_of_free_read_handles += 1;
+
+	libcthreads_condition_signal(
+	 mount_handle->read_handles_condition,
+	 NULL );
+
+	if( libcthreads_mutex_release(
+	     mount_handle->read_handles_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read handles mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 /* Closes the mount handle
  * Returns the 0 if succesful or -1 on error
  */
@@ -478,6 +1127,10 @@ int mount_handle_close(
 {
 	static char *function = "mount_handle_close";
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	int read_handle_index = 0;
+#endif
+
 	if( mount_handle == NULL )
 	{
 		libcerror_error_set(
@@ -489,6 +1142,30 @@ int mount_handle_close(
 
 		return( -1 );
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( mount_handle->read_handles != NULL )
+	{
+		for( read_handle_index = 1;
+		     read_handle_index < mount_handle->number_of_read_handles;
+		     read_handle_index++ )
+		{
+			if( libewf_handle_close(
+			     mount_handle->read_handles[ read_handle_index ],
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close read handle: %d.",
+				 function,
+				 read_handle_index );
+
+				return( -1 );
+			}
+		}
+	}
+#endif
 	if( libewf_handle_close(
 	     mount_handle->input_handle,
 	     error ) != 0 )
@@ -548,6 +1225,94 @@ ssize_t mount_handle_read_buffer(
 	return( read_count );
 }
 
+/* Read a buffer at a specific offset from the input handle
+ * This function can be called concurrently, if multiple read handles
+ * were opened the read is done by a read handle that is not in use
+ * Return the number of bytes read if successful or -1 on error
+ */
+ssize_t mount_handle_read_buffer_at_offset(
+         mount_handle_t *mount_handle,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libewf_handle_t *read_handle = NULL;
+	static char *function        = "mount_handle_read_buffer_at_offset";
+	ssize_t read_count           = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	read_handle = mount_handle->input_handle;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( mount_handle->read_handles != NULL )
+	{
+		if( mount_handle_grab_read_handle(
+		     mount_handle,
+		     &read_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to grab read handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	read_count = libewf_handle_read_buffer_at_offset(
+	              read_handle,
+	              buffer,
+	              size,
+	              offset,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ") from input handle.",
+		 function,
+		 offset,
+		 offset );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( mount_handle->read_handles != NULL )
+	{
+		if( mount_handle_release_read_handle(
+		     mount_handle,
+		     read_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	return( read_count );
+}
+
 /* Seeks a specific offset from the input handle
  * Return the offset if successful or -1 on error
  */
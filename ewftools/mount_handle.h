@@ -27,6 +27,7 @@
 #include <types.h>
 
 #include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
 #include "ewftools_libewf.h"
 
 #if defined( __cplusplus )
@@ -39,6 +40,10 @@ enum MOUNT_HANDLE_INPUT_FORMATS
 	MOUNT_HANDLE_INPUT_FORMAT_RAW	= (int) 'r'
 };
 
+/* The maximum number of concurrent read handles
+ */
+#define MOUNT_HANDLE_MAXIMUM_NUMBER_OF_READ_HANDLES	64
+
 typedef struct mount_handle mount_handle_t;
 
 struct mount_handle
@@ -58,6 +63,36 @@ struct mount_handle
 	/* The notification output stream
 	 */
 	FILE *notify_stream;
+
+	/* The maximum number of (concurrent) open file handles
+	 */
+	int maximum_number_of_open_handles;
+
+	/* The number of read handles, where 0 represents the input handle is used for all reads
+	 */
+	int number_of_read_handles;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The read handles, where the first read handle is the input handle
+	 */
+	libewf_handle_t **read_handles;
+
+	/* The read handles that are not in use
+	 */
+	libewf_handle_t **free_read_handles;
+
+	/* The number of read handles that are not in use
+	 */
+	int number_of_free_read_handles;
+
+	/* The mutex that protects the read handles that are not in use
+	 */
+	libcthreads_mutex_t *read_handles_mutex;
+
+	/* The condition that signals that a read handle was released
+	 */
+	libcthreads_condition_t *read_handles_condition;
+#endif
 };
 
 int mount_handle_initialize(
@@ -77,6 +112,11 @@ int mount_handle_set_maximum_number_of_open_handles(
      int maximum_number_of_open_handles,
      libcerror_error_t **error );
 
+int mount_handle_set_number_of_read_handles(
+     mount_handle_t *mount_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
 int mount_handle_set_format(
      mount_handle_t *mount_handle,
      const system_character_t *string,
@@ -88,6 +128,26 @@ int mount_handle_open_input(
      int number_of_filenames,
      libcerror_error_t **error );
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int mount_handle_open_read_handles(
+     mount_handle_t *mount_handle,
+     system_character_t * const * filenames,
+     int number_of_filenames,
+     libcerror_error_t **error );
+
+int mount_handle_grab_read_handle(
+     mount_handle_t *mount_handle,
+     libewf_handle_t **read_handle,
+     libcerror_error_t **error );
+
+int mount_handle_release_read_handle(
+     mount_handle_t *mount_handle,
+     libewf_handle_t *read_handle,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 int mount_handle_close(
      mount_handle_t *mount_handle,
      libcerror_error_t **error );
@@ -98,6 +158,13 @@ ssize_t mount_handle_read_buffer(
          size_t size,
          libcerror_error_t **error );
 
+ssize_t mount_handle_read_buffer_at_offset(
+         mount_handle_t *mount_handle,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error );
+
 off64_t mount_handle_seek_offset(
          mount_handle_t *mount_handle,
          off64_t offset,
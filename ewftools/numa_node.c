@@ -0,0 +1,338 @@
+/*
+ * NUMA node functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_SCHED_H )
+#include <sched.h>
+#endif
+
+#include "ewftools_libcerror.h"
+#include "numa_node.h"
+
+#if !defined( WINAPI ) && defined( HAVE_SCHED_SETAFFINITY ) && defined( CPU_SETSIZE )
+
+/* The size of the node CPU list string, which is large enough for
+ * the individually listed CPUs of a node of a large system
+ */
+#define NUMA_NODE_CPU_LIST_STRING_SIZE		4096
+
+/* Opens the CPU list of a specific node
+ * Returns a file stream if successful or NULL if not available
+ */
+FILE *numa_node_open_cpu_list(
+       int node_index )
+{
+	char path[ 64 ];
+
+	if( narrow_string_snprintf(
+	     path,
+	     64,
+	     "/sys/devices/system/node/node%d/cpulist",
+	     node_index ) < 0 )
+	{
+		return( NULL );
+	}
+	path[ 63 ] = 0;
+
+	return( file_stream_open(
+	         path,
+	         "r" ) );
+}
+
+#endif /* !defined( WINAPI ) && defined( HAVE_SCHED_SETAFFINITY ) && defined( CPU_SETSIZE ) */
+
+/* Retrieves the number of NUMA nodes
+ * Returns 1 if successful, 0 if not supported or -1 on error
+ */
+int numa_node_get_number_of_nodes(
+     int *number_of_nodes,
+     libcerror_error_t **error )
+{
+	static char *function     = "numa_node_get_number_of_nodes";
+
+#if defined( WINAPI ) && ( WINVER >= 0x0600 )
+	ULONG highest_node_number = 0;
+
+#elif defined( HAVE_SCHED_SETAFFINITY ) && defined( CPU_SETSIZE )
+	FILE *stream              = NULL;
+	int node_index            = 0;
+#endif
+
+	if( number_of_nodes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of nodes.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI ) && ( WINVER >= 0x0600 )
+	if( GetNumaHighestNodeNumber(
+	     &highest_node_number ) == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve highest node number.",
+		 function );
+
+		return( -1 );
+	}
+	if( highest_node_number >= (ULONG) NUMA_NODE_MAXIMUM_NUMBER_OF_NODES )
+	{
+		highest_node_number = (ULONG) NUMA_NODE_MAXIMUM_NUMBER_OF_NODES - 1;
+	}
+	*number_of_nodes = (int) highest_node_number + 1;
+
+	return( 1 );
+
+#elif defined( HAVE_SCHED_SETAFFINITY ) && defined( CPU_SETSIZE )
+	/* The nodes are numbered consecutively from 0
+	 */
+	for( node_index = 0;
+	     node_index < NUMA_NODE_MAXIMUM_NUMBER_OF_NODES;
+	     node_index++ )
+	{
+		stream = numa_node_open_cpu_list(
+		          node_index );
+
+		if( stream == NULL )
+		{
+			break;
+		}
+		file_stream_close(
+		 stream );
+	}
+	if( node_index == 0 )
+	{
+		return( 0 );
+	}
+	*number_of_nodes = node_index;
+
+	return( 1 );
+
+#else
+	return( 0 );
+
+#endif
+}
+
+/* Binds the current thread to the CPUs of a specific NUMA node
+ * Memory that is first touched by the thread afterwards is allocated
+ * on that node by the default allocation policy of the operating system
+ * Returns 1 if successful, 0 if not supported or -1 on error
+ */
+int numa_node_bind_current_thread(
+     int node_index,
+     libcerror_error_t **error )
+{
+	static char *function = "numa_node_bind_current_thread";
+
+#if defined( WINAPI ) && ( WINVER >= 0x0600 )
+	ULONGLONG cpu_mask    = 0;
+
+#elif defined( HAVE_SCHED_SETAFFINITY ) && defined( CPU_SETSIZE )
+	char cpu_list_string[ NUMA_NODE_CPU_LIST_STRING_SIZE ];
+
+	cpu_set_t cpu_set;
+
+	FILE *stream          = NULL;
+	char *string_end      = NULL;
+	char *string_segment  = NULL;
+	long first_cpu        = 0;
+	long last_cpu         = 0;
+	int number_of_cpus    = 0;
+#endif
+
+	if( ( node_index < 0 )
+	 || ( node_index >= NUMA_NODE_MAXIMUM_NUMBER_OF_NODES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid node index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI ) && ( WINVER >= 0x0600 )
+	if( GetNumaNodeProcessorMask(
+	     (UCHAR) node_index,
+	     &cpu_mask ) == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve processor mask of node: %d.",
+		 function,
+		 node_index );
+
+		return( -1 );
+	}
+	/* A node without processors has only memory
+	 */
+	if( cpu_mask == 0 )
+	{
+		return( 0 );
+	}
+	if( SetThreadAffinityMask(
+	     GetCurrentThread(),
+	     (DWORD_PTR) cpu_mask ) == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set thread affinity to node: %d.",
+		 function,
+		 node_index );
+
+		return( -1 );
+	}
+	return( 1 );
+
+#elif defined( HAVE_SCHED_SETAFFINITY ) && defined( CPU_SETSIZE )
+	stream = numa_node_open_cpu_list(
+	          node_index );
+
+	if( stream == NULL )
+	{
+		return( 0 );
+	}
+	string_segment = file_stream_get_string(
+	                  stream,
+	                  cpu_list_string,
+	                  NUMA_NODE_CPU_LIST_STRING_SIZE );
+
+	file_stream_close(
+	 stream );
+
+	if( string_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read CPU list of node: %d.",
+		 function,
+		 node_index );
+
+		return( -1 );
+	}
+	CPU_ZERO(
+	 &cpu_set );
+
+	/* The CPU list consists of comma separated CPUs or CPU ranges, e.g. 0-3,8-11
+	 */
+	while( ( *string_segment >= '0' )
+	    && ( *string_segment <= '9' ) )
+	{
+		first_cpu = strtol(
+		             string_segment,
+		             &string_end,
+		             10 );
+
+		last_cpu = first_cpu;
+
+		if( *string_end == '-' )
+		{
+			string_segment = &( string_end[ 1 ] );
+
+			last_cpu = strtol(
+			            string_segment,
+			            &string_end,
+			            10 );
+		}
+		if( ( string_end == string_segment )
+		 || ( first_cpu < 0 )
+		 || ( last_cpu < first_cpu )
+		 || ( last_cpu >= (long) CPU_SETSIZE ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported CPU list of node: %d.",
+			 function,
+			 node_index );
+
+			return( -1 );
+		}
+		while( first_cpu <= last_cpu )
+		{
+			CPU_SET(
+			 (int) first_cpu,
+			 &cpu_set );
+
+			first_cpu++;
+			number_of_cpus++;
+		}
+		if( *string_end != ',' )
+		{
+			break;
+		}
+		string_segment = &( string_end[ 1 ] );
+	}
+	/* A node without CPUs has only memory
+	 */
+	if( number_of_cpus == 0 )
+	{
+		return( 0 );
+	}
+	/* A process identifier of 0 represents the calling thread
+	 */
+	if( sched_setaffinity(
+	     0,
+	     sizeof( cpu_set_t ),
+	     &cpu_set ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set thread affinity to node: %d.",
+		 function,
+		 node_index );
+
+		return( -1 );
+	}
+	return( 1 );
+
+#else
+	return( 0 );
+
+#endif
+}
+
@@ -0,0 +1,59 @@
+/*
+ * NUMA node functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _NUMA_NODE_H )
+#define _NUMA_NODE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The maximum number of NUMA nodes that is probed
+ */
+#define NUMA_NODE_MAXIMUM_NUMBER_OF_NODES	64
+
+#if !defined( WINAPI )
+
+FILE *numa_node_open_cpu_list(
+       int node_index );
+
+#endif /* !defined( WINAPI ) */
+
+int numa_node_get_number_of_nodes(
+     int *number_of_nodes,
+     libcerror_error_t **error );
+
+int numa_node_bind_current_thread(
+     int node_index,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _NUMA_NODE_H ) */
+
@@ -0,0 +1,981 @@
+/*
+ * Segment file scanner
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libewf.h"
+#include "segment_file_scanner.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Creates a segment file scanner
+ * Make sure the value scanner is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int segment_file_scanner_initialize(
+     segment_file_scanner_t **scanner,
+     int number_of_scanners,
+     libcerror_error_t **error )
+{
+	static char *function = "segment_file_scanner_initialize";
+	int scanner_index     = 0;
+
+	if( scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( *scanner != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid scanner value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_scanners <= 0 )
+	 || ( number_of_scanners > (int) ( INT_MAX / sizeof( libewf_handle_t * ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of scanners value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*scanner = memory_allocate_structure(
+	            segment_file_scanner_t );
+
+	if( *scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create scanner.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *scanner,
+	     0,
+	     sizeof( segment_file_scanner_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear scanner.",
+		 function );
+
+		memory_free(
+		 *scanner );
+
+		*scanner = NULL;
+
+		return( -1 );
+	}
+	( *scanner )->handles = (libewf_handle_t **) memory_allocate(
+	                                             sizeof( libewf_handle_t * ) * number_of_scanners );
+
+	if( ( *scanner )->handles == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create handles.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *scanner )->handles,
+	     0,
+	     sizeof( libewf_handle_t * ) * number_of_scanners ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear handles.",
+		 function );
+
+		goto on_error;
+	}
+	( *scanner )->threads = (libcthreads_thread_t **) memory_allocate(
+	                                                  sizeof( libcthreads_thread_t * ) * number_of_scanners );
+
+	if( ( *scanner )->threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create threads.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *scanner )->threads,
+	     0,
+	     sizeof( libcthreads_thread_t * ) * number_of_scanners ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear threads.",
+		 function );
+
+		goto on_error;
+	}
+	( *scanner )->number_of_scanners = number_of_scanners;
+
+	for( scanner_index = 0;
+	     scanner_index < number_of_scanners;
+	     scanner_index++ )
+	{
+		if( libewf_handle_initialize(
+		     &( ( *scanner )->handles[ scanner_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create handle: %d.",
+			 function,
+			 scanner_index );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *scanner )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *scanner != NULL )
+	{
+		if( ( *scanner )->handles != NULL )
+		{
+			for( scanner_index = 0;
+			     scanner_index < number_of_scanners;
+			     scanner_index++ )
+			{
+				if( ( *scanner )->handles[ scanner_index ] != NULL )
+				{
+					libewf_handle_free(
+					 &( ( *scanner )->handles[ scanner_index ] ),
+					 NULL );
+				}
+			}
+			memory_free(
+			 ( *scanner )->handles );
+		}
+		if( ( *scanner )->threads != NULL )
+		{
+			memory_free(
+			 ( *scanner )->threads );
+		}
+		memory_free(
+		 *scanner );
+
+		*scanner = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a segment file scanner
+ * Returns 1 if successful or -1 on error
+ */
+int segment_file_scanner_free(
+     segment_file_scanner_t **scanner,
+     libcerror_error_t **error )
+{
+	static char *function = "segment_file_scanner_free";
+	int scanner_index     = 0;
+	int result            = 1;
+
+	if( scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( *scanner != NULL )
+	{
+		/* The threads are joined in segment_file_scanner_join
+		 */
+		for( scanner_index = 0;
+		     scanner_index < ( *scanner )->number_of_scanners;
+		     scanner_index++ )
+		{
+			if( ( ( *scanner )->handles[ scanner_index ] != NULL )
+			 && ( libewf_handle_free(
+			       &( ( *scanner )->handles[ scanner_index ] ),
+			       error ) != 1 ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free handle: %d.",
+				 function,
+				 scanner_index );
+
+				result = -1;
+			}
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *scanner )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 ( *scanner )->threads );
+
+		memory_free(
+		 ( *scanner )->handles );
+
+		memory_free(
+		 *scanner );
+
+		*scanner = NULL;
+	}
+	return( result );
+}
+
+/* Signals the segment file scanner to abort
+ * Returns 1 if successful or -1 on error
+ */
+int segment_file_scanner_signal_abort(
+     segment_file_scanner_t *scanner,
+     libcerror_error_t **error )
+{
+	static char *function = "segment_file_scanner_signal_abort";
+	int scanner_index     = 0;
+
+	if( scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scanner.",
+		 function );
+
+		return( -1 );
+	}
+	scanner->abort = 1;
+
+	for( scanner_index = 0;
+	     scanner_index < scanner->number_of_scanners;
+	     scanner_index++ )
+	{
+		if( libewf_handle_signal_abort(
+		     scanner->handles[ scanner_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal handle: %d to abort.",
+			 function,
+			 scanner_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Opens the scanner handles
+ * Every scanner opens the (already resolved) segment files on its own
+ * Returns 1 if successful or -1 on error
+ */
+int segment_file_scanner_open(
+     segment_file_scanner_t *scanner,
+     system_character_t * const * filenames,
+     int number_of_filenames,
+     int header_codepage,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error )
+{
+	static char *function = "segment_file_scanner_open";
+	int scanner_index     = 0;
+
+	if( scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scanner.",
+		 function );
+
+		return( -1 );
+	}
+	for( scanner_index = 0;
+	     scanner_index < scanner->number_of_scanners;
+	     scanner_index++ )
+	{
+		if( maximum_number_of_open_handles > 0 )
+		{
+			if( libewf_handle_set_maximum_number_of_open_handles(
+			     scanner->handles[ scanner_index ],
+			     maximum_number_of_open_handles,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set maximum number of open handles in handle: %d.",
+				 function,
+				 scanner_index );
+
+				return( -1 );
+			}
+		}
+		if( header_codepage != LIBEWF_CODEPAGE_ASCII )
+		{
+			if( libewf_handle_set_header_codepage(
+			     scanner->handles[ scanner_index ],
+			     header_codepage,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set header codepage in handle: %d.",
+				 function,
+				 scanner_index );
+
+				return( -1 );
+			}
+		}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libewf_handle_open_wide(
+		     scanner->handles[ scanner_index ],
+		     filenames,
+		     number_of_filenames,
+		     LIBEWF_OPEN_READ,
+		     error ) != 1 )
+#else
+		if( libewf_handle_open(
+		     scanner->handles[ scanner_index ],
+		     filenames,
+		     number_of_filenames,
+		     LIBEWF_OPEN_READ,
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open handle: %d.",
+			 function,
+			 scanner_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Closes the scanner handles
+ * Returns the 0 if succesful or -1 on error
+ */
+int segment_file_scanner_close(
+     segment_file_scanner_t *scanner,
+     libcerror_error_t **error )
+{
+	static char *function = "segment_file_scanner_close";
+	int scanner_index     = 0;
+	int result            = 0;
+
+	if( scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scanner.",
+		 function );
+
+		return( -1 );
+	}
+	for( scanner_index = 0;
+	     scanner_index < scanner->number_of_scanners;
+	     scanner_index++ )
+	{
+		if( libewf_handle_close(
+		     scanner->handles[ scanner_index ],
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close handle: %d.",
+			 function,
+			 scanner_index );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Starts the scanner threads
+ * The scanners claim the segment files from the first segment file onwards
+ * Returns 1 if successful or -1 on error
+ */
+int segment_file_scanner_start(
+     segment_file_scanner_t *scanner,
+     uint32_t number_of_segment_files,
+     libcerror_error_t **error )
+{
+	static char *function = "segment_file_scanner_start";
+	int scanner_index     = 0;
+
+	if( scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scanner.",
+		 function );
+
+		return( -1 );
+	}
+	scanner->number_of_segment_files = number_of_segment_files;
+	scanner->next_segment_file_index = 0;
+	scanner->checked_size            = 0;
+	scanner->next_handle_index       = 0;
+	scanner->has_failed              = 0;
+
+	for( scanner_index = 0;
+	     scanner_index < scanner->number_of_scanners;
+	     scanner_index++ )
+	{
+		if( libcthreads_thread_create(
+		     &( scanner->threads[ scanner_index ] ),
+		     NULL,
+		     (int (*)(void *)) &segment_file_scanner_thread_callback,
+		     (void *) scanner,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread: %d.",
+			 function,
+			 scanner_index );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	/* Stop and join the scanner threads that were already started
+	 */
+	scanner->abort = 1;
+
+	segment_file_scanner_join(
+	 scanner,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Joins the scanner threads
+ * Returns 1 if successful or -1 on error
+ */
+int segment_file_scanner_join(
+     segment_file_scanner_t *scanner,
+     libcerror_error_t **error )
+{
+	static char *function = "segment_file_scanner_join";
+	int scanner_index     = 0;
+	int result            = 1;
+
+	if( scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scanner.",
+		 function );
+
+		return( -1 );
+	}
+	for( scanner_index = 0;
+	     scanner_index < scanner->number_of_scanners;
+	     scanner_index++ )
+	{
+		if( scanner->threads[ scanner_index ] == NULL )
+		{
+			continue;
+		}
+		if( libcthreads_thread_join(
+		     &( scanner->threads[ scanner_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread: %d.",
+			 function,
+			 scanner_index );
+
+			result = -1;
+		}
+	}
+	if( ( result == 1 )
+	 && ( scanner->has_failed != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to check segment files.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+/* Retrieves the size of the media data that has been checked
+ * Returns 1 if successful or -1 on error
+ */
+int segment_file_scanner_get_checked_size(
+     segment_file_scanner_t *scanner,
+     size64_t *checked_size,
+     libcerror_error_t **error )
+{
+	static char *function = "segment_file_scanner_get_checked_size";
+
+	if( scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( checked_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checked size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     scanner->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	*checked_size = scanner->checked_size;
+
+	if( libcthreads_mutex_release(
+	     scanner->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Appends the checksum errors found by the scanners to a handle
+ * Overlapping checksum errors are merged by the handle
+ * Returns 1 if successful or -1 on error
+ */
+int segment_file_scanner_append_checksum_errors(
+     segment_file_scanner_t *scanner,
+     libewf_handle_t *handle,
+     libcerror_error_t **error )
+{
+	static char *function      = "segment_file_scanner_append_checksum_errors";
+	uint64_t number_of_sectors = 0;
+	uint64_t start_sector      = 0;
+	uint32_t error_index       = 0;
+	uint32_t number_of_errors  = 0;
+	int scanner_index          = 0;
+
+	if( scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scanner.",
+		 function );
+
+		return( -1 );
+	}
+	for( scanner_index = 0;
+	     scanner_index < scanner->number_of_scanners;
+	     scanner_index++ )
+	{
+		if( libewf_handle_get_number_of_checksum_errors(
+		     scanner->handles[ scanner_index ],
+		     &number_of_errors,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of checksum errors from handle: %d.",
+			 function,
+			 scanner_index );
+
+			return( -1 );
+		}
+		for( error_index = 0;
+		     error_index < number_of_errors;
+		     error_index++ )
+		{
+			if( libewf_handle_get_checksum_error(
+			     scanner->handles[ scanner_index ],
+			     error_index,
+			     &start_sector,
+			     &number_of_sectors,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve checksum error: %" PRIu32 " from handle: %d.",
+				 function,
+				 error_index,
+				 scanner_index );
+
+				return( -1 );
+			}
+			if( libewf_handle_append_checksum_error(
+			     handle,
+			     start_sector,
+			     number_of_sectors,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append checksum error.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	return( 1 );
+}
+
+/* Checks segment files until all segment files have been claimed
+ * Callback function for the scanner threads
+ * Returns 1 if successful or -1 on error
+ */
+int segment_file_scanner_thread_callback(
+     segment_file_scanner_t *scanner )
+{
+	libcerror_error_t *error    = NULL;
+	libewf_handle_t *handle     = NULL;
+	static char *function       = "segment_file_scanner_thread_callback";
+	size64_t range_size         = 0;
+	off64_t range_offset        = 0;
+	uint32_t segment_file_index = 0;
+	int mutex_grabbed           = 0;
+
+	if( scanner == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scanner.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_grab(
+	     scanner->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	handle = scanner->handles[ scanner->next_handle_index ];
+
+	scanner->next_handle_index += 1;
+
+	if( libcthreads_mutex_release(
+	     scanner->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	while( scanner->abort == 0 )
+	{
+		if( libcthreads_mutex_grab(
+		     scanner->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			goto on_error;
+		}
+		mutex_grabbed = 1;
+
+		if( scanner->next_segment_file_index >= scanner->number_of_segment_files )
+		{
+			break;
+		}
+		segment_file_index = scanner->next_segment_file_index;
+
+		scanner->next_segment_file_index += 1;
+
+		if( libcthreads_mutex_release(
+		     scanner->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			goto on_error;
+		}
+		mutex_grabbed = 0;
+
+		if( libewf_handle_get_segment_file_media_range(
+		     handle,
+		     segment_file_index,
+		     &range_offset,
+		     &range_size,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve media range of segment file: %" PRIu32 ".",
+			 function,
+			 segment_file_index );
+
+			goto on_error;
+		}
+		/* Corrupted chunks are tracked as checksum errors by the handle
+		 */
+		if( libewf_handle_check_segment_file_chunks(
+		     handle,
+		     segment_file_index,
+		     &error ) == -1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to check chunks of segment file: %" PRIu32 ".",
+			 function,
+			 segment_file_index );
+
+			goto on_error;
+		}
+		if( libcthreads_mutex_grab(
+		     scanner->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			goto on_error;
+		}
+		scanner->checked_size += range_size;
+
+		if( libcthreads_mutex_release(
+		     scanner->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( mutex_grabbed != 0 )
+	{
+		mutex_grabbed = 0;
+
+		if( libcthreads_mutex_release(
+		     scanner->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( scanner != NULL )
+	{
+		/* Make the other scanners stop
+		 */
+		scanner->has_failed = 1;
+		scanner->abort      = 1;
+
+		if( mutex_grabbed != 0 )
+		{
+			libcthreads_mutex_release(
+			 scanner->mutex,
+			 NULL );
+		}
+	}
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,142 @@
+/*
+ * Segment file scanner
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _SEGMENT_FILE_SCANNER_H )
+#define _SEGMENT_FILE_SCANNER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libewf.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+typedef struct segment_file_scanner segment_file_scanner_t;
+
+/* The segment file scanner checks the chunks of the segment files concurrently
+ * Every scanner thread has its own libewf handle and claims the next
+ * unchecked segment file, since the checksum of a chunk does not depend
+ * on the media data in other chunks
+ */
+struct segment_file_scanner
+{
+	/* The number of scanners
+	 */
+	int number_of_scanners;
+
+	/* The scanner (libewf) handles
+	 */
+	libewf_handle_t **handles;
+
+	/* The scanner threads
+	 */
+	libcthreads_thread_t **threads;
+
+	/* The mutex that serializes claiming a segment file
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The number of segment files to check
+	 */
+	uint32_t number_of_segment_files;
+
+	/* The index of the next segment file to check
+	 */
+	uint32_t next_segment_file_index;
+
+	/* The size of the media data that has been checked
+	 */
+	size64_t checked_size;
+
+	/* The index of the next handle to be assigned to a scanner thread
+	 */
+	int next_handle_index;
+
+	/* Value to indicate if one of the scanner threads failed
+	 */
+	int has_failed;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int segment_file_scanner_initialize(
+     segment_file_scanner_t **scanner,
+     int number_of_scanners,
+     libcerror_error_t **error );
+
+int segment_file_scanner_free(
+     segment_file_scanner_t **scanner,
+     libcerror_error_t **error );
+
+int segment_file_scanner_signal_abort(
+     segment_file_scanner_t *scanner,
+     libcerror_error_t **error );
+
+int segment_file_scanner_open(
+     segment_file_scanner_t *scanner,
+     system_character_t * const * filenames,
+     int number_of_filenames,
+     int header_codepage,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error );
+
+int segment_file_scanner_close(
+     segment_file_scanner_t *scanner,
+     libcerror_error_t **error );
+
+int segment_file_scanner_start(
+     segment_file_scanner_t *scanner,
+     uint32_t number_of_segment_files,
+     libcerror_error_t **error );
+
+int segment_file_scanner_join(
+     segment_file_scanner_t *scanner,
+     libcerror_error_t **error );
+
+int segment_file_scanner_get_checked_size(
+     segment_file_scanner_t *scanner,
+     size64_t *checked_size,
+     libcerror_error_t **error );
+
+int segment_file_scanner_append_checksum_errors(
+     segment_file_scanner_t *scanner,
+     libewf_handle_t *handle,
+     libcerror_error_t **error );
+
+int segment_file_scanner_thread_callback(
+     segment_file_scanner_t *scanner );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _SEGMENT_FILE_SCANNER_H ) */
+
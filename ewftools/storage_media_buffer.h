@@ -73,6 +73,10 @@ struct storage_media_buffer
 	/* The processed size
 	 */
 	size_t processed_size;
+
+	/* The index of the free list the buffer is released onto
+	 */
+	int free_list_index;
 };
 
 int storage_media_buffer_initialize(
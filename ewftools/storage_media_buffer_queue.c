@@ -31,20 +31,24 @@
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 
 /* Creates a storage media buffer queue
+ * The storage media buffers are created on demand when grabbed
+ * The buffers are kept on a free list per worker, where the maximum number
+ * of values is divided over the free lists
  * Make sure the value queue is referencing, is set to NULL
  * Returns 1 if successful or -1 on error
  */
 int storage_media_buffer_queue_initialize(
-     libcthreads_queue_t **queue,
+     storage_media_buffer_queue_t **queue,
      libewf_handle_t *handle,
      int maximum_number_of_values,
+     int number_of_free_lists,
      uint8_t storage_media_buffer_mode,
      size_t storage_media_buffer_size,
      libcerror_error_t **error )
 {
-	storage_media_buffer_t *buffer = NULL;
-	static char *function          = "storage_media_buffer_queue_initialize";
-	int value_index                = 0;
+	static char *function                       = "storage_media_buffer_queue_initialize";
+	int free_list_index                         = 0;
+	int maximum_number_of_buffers_per_free_list = 0;
 
 	if( queue == NULL )
 	{
@@ -80,67 +84,167 @@ int storage_media_buffer_queue_initialize(
 
 		return( -1 );
 	}
-	if( libcthreads_queue_initialize(
-	     queue,
-	     maximum_number_of_values,
-	     error ) != 1 )
+	if( ( number_of_free_lists <= 0 )
+	 || ( number_of_free_lists > (int) ( INT_MAX / sizeof( libcthreads_queue_t * ) ) ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to initialize storage media buffer queue.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of free lists value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer_size >= (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid storage media buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	/* Every free list needs at least 1 buffer for its worker to make progress
+	 */
+	maximum_number_of_buffers_per_free_list = maximum_number_of_values / number_of_free_lists;
+
+	if( maximum_number_of_buffers_per_free_list == 0 )
+	{
+		maximum_number_of_buffers_per_free_list = 1;
+	}
+	*queue = memory_allocate_structure(
+	          storage_media_buffer_queue_t );
+
+	if( *queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create queue.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *queue,
+	     0,
+	     sizeof( storage_media_buffer_queue_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear queue.",
+		 function );
+
+		memory_free(
+		 *queue );
+
+		*queue = NULL;
+
+		return( -1 );
+	}
+	( *queue )->free_lists = (libcthreads_queue_t **) memory_allocate(
+	                                                   sizeof( libcthreads_queue_t * ) * number_of_free_lists );
+
+	if( ( *queue )->free_lists == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create free lists.",
 		 function );
 
 		goto on_error;
 	}
-	for( value_index = 0;
-	     value_index < maximum_number_of_values;
-	     value_index++ )
+	if( memory_set(
+	     ( *queue )->free_lists,
+	     0,
+	     sizeof( libcthreads_queue_t * ) * number_of_free_lists ) == NULL )
 	{
-		/* Add 1 to prevent the queue blocking if full
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear free lists.",
+		 function );
+
+		memory_free(
+		 ( *queue )->free_lists );
+
+		( *queue )->free_lists = NULL;
+
+		goto on_error;
+	}
+	( *queue )->number_of_buffers_per_free_list = (int *) memory_allocate(
+	                                                       sizeof( int ) * number_of_free_lists );
+
+	if( ( *queue )->number_of_buffers_per_free_list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create number of buffers per free list.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *queue )->number_of_buffers_per_free_list,
+	     0,
+	     sizeof( int ) * number_of_free_lists ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear number of buffers per free list.",
+		 function );
+
+		goto on_error;
+	}
+	( *queue )->number_of_free_lists = number_of_free_lists;
+
+	for( free_list_index = 0;
+	     free_list_index < number_of_free_lists;
+	     free_list_index++ )
+	{
+		/* A buffer is always released onto the free list it was created for
+		 * so a free list never holds more than its maximum number of buffers
 		 */
-		if( storage_media_buffer_initialize(
-		     &buffer,
-		     handle,
-		     storage_media_buffer_mode,
-		     storage_media_buffer_size + 1,
+		if( libcthreads_queue_initialize(
+		     &( ( *queue )->free_lists[ free_list_index ] ),
+		     maximum_number_of_buffers_per_free_list,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create storage media buffer.",
-			 function );
+			 "%s: unable to initialize free list: %d.",
+			 function,
+			 free_list_index );
 
 			goto on_error;
 		}
-		if( libcthreads_queue_push(
-		     *queue,
-		     (intptr_t *) buffer,
-		     error ) == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to push storage media buffer onto queue.",
-			 function );
-
-			goto on_error;
-		}
-		buffer = NULL;
 	}
+	( *queue )->handle                                  = handle;
+	( *queue )->storage_media_buffer_mode               = storage_media_buffer_mode;
+	( *queue )->maximum_number_of_buffers_per_free_list = maximum_number_of_buffers_per_free_list;
+
+	/* Add 1 to prevent the queue blocking if full
+	 */
+	( *queue )->storage_media_buffer_size = storage_media_buffer_size + 1;
+
 	return( 1 );
 
 on_error:
-	if( buffer != NULL )
-	{
-		storage_media_buffer_free(
-		 &buffer,
-		 NULL );
-	}
 	if( *queue != NULL )
 	{
 		storage_media_buffer_queue_free(
@@ -154,10 +258,11 @@ on_error:
  * Returns 1 if successful or -1 on error
  */
 int storage_media_buffer_queue_free(
-     libcthreads_queue_t **queue,
+     storage_media_buffer_queue_t **queue,
      libcerror_error_t **error )
 {
 	static char *function = "storage_media_buffer_queue_free";
+	int free_list_index   = 0;
 	int result            = 1;
 
 	if( queue == NULL )
@@ -173,36 +278,173 @@ int storage_media_buffer_queue_free(
 	}
 	if( *queue != NULL )
 	{
-		if( libcthreads_queue_free(
-		     queue,
-		     (int (*)(intptr_t **, libcerror_error_t **)) &storage_media_buffer_free,
-		     error ) != 1 )
+		if( ( *queue )->free_lists != NULL )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free storage media buffer queue.",
-			 function );
+			for( free_list_index = 0;
+			     free_list_index < ( *queue )->number_of_free_lists;
+			     free_list_index++ )
+			{
+				if( ( *queue )->free_lists[ free_list_index ] == NULL )
+				{
+					continue;
+				}
+				if( libcthreads_queue_free(
+				     &( ( *queue )->free_lists[ free_list_index ] ),
+				     (int (*)(intptr_t **, libcerror_error_t **)) &storage_media_buffer_free,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free free list: %d.",
+					 function,
+					 free_list_index );
 
-			result = -1;
+					result = -1;
+				}
+			}
+			memory_free(
+			 ( *queue )->free_lists );
 		}
+		if( ( *queue )->number_of_buffers_per_free_list != NULL )
+		{
+			memory_free(
+			 ( *queue )->number_of_buffers_per_free_list );
+		}
+		memory_free(
+		 *queue );
+
+		*queue = NULL;
 	}
 	return( result );
 }
 
 /* Grabs a storage media buffer from the queue
+ * The buffer is taken from the free list of the worker if available. If not
+ * a new buffer is created for the free list of the worker when its maximum
+ * number of buffers has not been reached, otherwise a buffer is stolen from
+ * the free list of another worker. If no buffer is available this function
+ * blocks until a buffer of the worker is released
+ * This function should only be called from a single (producer) thread
+ * or calls from multiple threads must be serialized by the caller
  * Returns 1 if successful or -1 on error
  */
 int storage_media_buffer_queue_grab_buffer(
-     libcthreads_queue_t *queue,
+     storage_media_buffer_queue_t *queue,
+     int free_list_index,
      storage_media_buffer_t **buffer,
      libcerror_error_t **error )
 {
 	static char *function = "storage_media_buffer_queue_grab_buffer";
+	int steal_index       = 0;
+	int victim_index      = 0;
+	int result            = 0;
+
+	if( queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queue.",
+		 function );
 
+		return( -1 );
+	}
+	if( ( free_list_index < 0 )
+	 || ( free_list_index >= queue->number_of_free_lists ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid free list index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	result = libcthreads_queue_try_pop(
+	          queue->free_lists[ free_list_index ],
+	          (intptr_t **) buffer,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+		 "%s: unable to pop storage media buffer from free list: %d.",
+		 function,
+		 free_list_index );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		return( 1 );
+	}
+	/* Creating the buffer on the thread of the worker places its memory
+	 * close to the worker, hence this is preferred over stealing
+	 */
+	if( queue->number_of_buffers_per_free_list[ free_list_index ] < queue->maximum_number_of_buffers_per_free_list )
+	{
+		if( storage_media_buffer_initialize(
+		     buffer,
+		     queue->handle,
+		     queue->storage_media_buffer_mode,
+		     queue->storage_media_buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create storage media buffer.",
+			 function );
+
+			return( -1 );
+		}
+		( *buffer )->free_list_index = free_list_index;
+
+		queue->number_of_buffers_per_free_list[ free_list_index ] += 1;
+
+		return( 1 );
+	}
+	for( steal_index = 1;
+	     steal_index < queue->number_of_free_lists;
+	     steal_index++ )
+	{
+		victim_index = ( free_list_index + steal_index ) % queue->number_of_free_lists;
+
+		result = libcthreads_queue_try_pop(
+		          queue->free_lists[ victim_index ],
+		          (intptr_t **) buffer,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to pop storage media buffer from free list: %d.",
+			 function,
+			 victim_index );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			return( 1 );
+		}
+	}
+	/* All the buffers of the worker are in use and will be released
+	 * onto its free list when processed
+	 */
 	if( libcthreads_queue_pop(
-	     queue,
+	     queue->free_lists[ free_list_index ],
 	     (intptr_t **) buffer,
 	     error ) != 1 )
 	{
@@ -210,8 +452,9 @@ int storage_media_buffer_queue_grab_buffer(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-		 "%s: unable to pop storage media buffer from queue.",
-		 function );
+		 "%s: unable to pop storage media buffer from free list: %d.",
+		 function,
+		 free_list_index );
 
 		return( -1 );
 	}
@@ -219,17 +462,52 @@ int storage_media_buffer_queue_grab_buffer(
 }
 
 /* Releases a storage media buffer onto the queue
+ * The buffer is released onto the free list it was created for
  * Returns 1 if successful or -1 on error
  */
 int storage_media_buffer_queue_release_buffer(
-     libcthreads_queue_t *queue,
+     storage_media_buffer_queue_t *queue,
      storage_media_buffer_t *buffer,
      libcerror_error_t **error )
 {
 	static char *function = "storage_media_buffer_queue_release_buffer";
 
+	if( queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer->free_list_index < 0 )
+	 || ( buffer->free_list_index >= queue->number_of_free_lists ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer - free list index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
 	if( libcthreads_queue_push(
-	     queue,
+	     queue->free_lists[ buffer->free_list_index ],
 	     (intptr_t *) buffer,
 	     error ) != 1 )
 	{
@@ -237,11 +515,74 @@ int storage_media_buffer_queue_release_buffer(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to push storage media buffer onto queue.",
+		 "%s: unable to push storage media buffer onto free list: %d.",
+		 function,
+		 buffer->free_list_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Determines the maximum number of values in a storage media buffer queue
+ * The queue is sized to hold about 512 MiB of buffers but at least
+ * 4 buffers per thread so that every thread in the pool has work queued
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_queue_get_maximum_number_of_values(
+     int number_of_threads,
+     size_t storage_media_buffer_size,
+     int *maximum_number_of_values,
+     libcerror_error_t **error )
+{
+	static char *function                = "storage_media_buffer_queue_get_maximum_number_of_values";
+	size_t safe_maximum_number_of_values = 0;
+
+	if( number_of_threads < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of threads value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid storage media buffer size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum number of values.",
 		 function );
 
 		return( -1 );
 	}
+	safe_maximum_number_of_values = 1 + ( ( 512 * 1024 * 1024 ) / storage_media_buffer_size );
+
+	if( safe_maximum_number_of_values < ( 4 * (size_t) number_of_threads ) )
+	{
+		safe_maximum_number_of_values = 4 * (size_t) number_of_threads;
+	}
+	if( safe_maximum_number_of_values > (size_t) ( INT_MAX - 1 ) )
+	{
+		safe_maximum_number_of_values = (size_t) ( INT_MAX - 1 );
+	}
+	*maximum_number_of_values = (int) safe_maximum_number_of_values;
+
 	return( 1 );
 }
 
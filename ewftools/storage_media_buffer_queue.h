@@ -36,28 +36,69 @@ extern "C" {
 
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 
+typedef struct storage_media_buffer_queue storage_media_buffer_queue_t;
+
+struct storage_media_buffer_queue
+{
+	/* The free lists of available buffers, one per worker
+	 */
+	libcthreads_queue_t **free_lists;
+
+	/* The number of free lists
+	 */
+	int number_of_free_lists;
+
+	/* The number of buffers allocated per free list
+	 */
+	int *number_of_buffers_per_free_list;
+
+	/* The handle
+	 */
+	libewf_handle_t *handle;
+
+	/* The storage media buffer mode
+	 */
+	uint8_t storage_media_buffer_mode;
+
+	/* The storage media buffer size
+	 */
+	size_t storage_media_buffer_size;
+
+	/* The maximum number of buffers per free list
+	 */
+	int maximum_number_of_buffers_per_free_list;
+};
+
 int storage_media_buffer_queue_initialize(
-     libcthreads_queue_t **queue,
+     storage_media_buffer_queue_t **queue,
      libewf_handle_t *handle,
      int maximum_number_of_values,
+     int number_of_free_lists,
      uint8_t storage_media_buffer_mode,
      size_t storage_media_buffer_size,
      libcerror_error_t **error );
 
 int storage_media_buffer_queue_free(
-     libcthreads_queue_t **queue,
+     storage_media_buffer_queue_t **queue,
      libcerror_error_t **error );
 
 int storage_media_buffer_queue_grab_buffer(
-     libcthreads_queue_t *queue,
+     storage_media_buffer_queue_t *queue,
+     int free_list_index,
      storage_media_buffer_t **buffer,
      libcerror_error_t **error );
 
 int storage_media_buffer_queue_release_buffer(
-     libcthreads_queue_t *queue,
+     storage_media_buffer_queue_t *queue,
      storage_media_buffer_t *buffer,
      libcerror_error_t **error );
 
+int storage_media_buffer_queue_get_maximum_number_of_values(
+     int number_of_threads,
+     size_t storage_media_buffer_size,
+     int *maximum_number_of_values,
+     libcerror_error_t **error );
+
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
 #if defined( __cplusplus )
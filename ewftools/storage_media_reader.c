@@ -0,0 +1,1179 @@
+/*
+ * Storage media reader
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libewf.h"
+#include "numa_node.h"
+#include "storage_media_buffer.h"
+#include "storage_media_buffer_queue.h"
+#include "storage_media_reader.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Creates a storage media reader
+ * Make sure the value reader is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_reader_initialize(
+     storage_media_reader_t **reader,
+     int number_of_readers,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_reader_initialize";
+	int reader_index      = 0;
+
+	if( reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( *reader != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid reader value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_readers <= 0 )
+	 || ( number_of_readers > (int) ( INT_MAX / sizeof( libewf_handle_t * ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of readers value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*reader = memory_allocate_structure(
+	           storage_media_reader_t );
+
+	if( *reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create reader.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *reader,
+	     0,
+	     sizeof( storage_media_reader_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear reader.",
+		 function );
+
+		memory_free(
+		 *reader );
+
+		*reader = NULL;
+
+		return( -1 );
+	}
+	( *reader )->handles = (libewf_handle_t **) memory_allocate(
+	                                             sizeof( libewf_handle_t * ) * number_of_readers );
+
+	if( ( *reader )->handles == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create handles.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *reader )->handles,
+	     0,
+	     sizeof( libewf_handle_t * ) * number_of_readers ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear handles.",
+		 function );
+
+		goto on_error;
+	}
+	( *reader )->threads = (libcthreads_thread_t **) memory_allocate(
+	                                                  sizeof( libcthreads_thread_t * ) * number_of_readers );
+
+	if( ( *reader )->threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create threads.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *reader )->threads,
+	     0,
+	     sizeof( libcthreads_thread_t * ) * number_of_readers ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear threads.",
+		 function );
+
+		goto on_error;
+	}
+	( *reader )->number_of_readers = number_of_readers;
+
+	for( reader_index = 0;
+	     reader_index < number_of_readers;
+	     reader_index++ )
+	{
+		if( libewf_handle_initialize(
+		     &( ( *reader )->handles[ reader_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create handle: %d.",
+			 function,
+			 reader_index );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *reader )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *reader != NULL )
+	{
+		if( ( *reader )->handles != NULL )
+		{
+			for( reader_index = 0;
+			     reader_index < number_of_readers;
+			     reader_index++ )
+			{
+				if( ( *reader )->handles[ reader_index ] != NULL )
+				{
+					libewf_handle_free(
+					 &( ( *reader )->handles[ reader_index ] ),
+					 NULL );
+				}
+			}
+			memory_free(
+			 ( *reader )->handles );
+		}
+		if( ( *reader )->threads != NULL )
+		{
+			memory_free(
+			 ( *reader )->threads );
+		}
+		memory_free(
+		 *reader );
+
+		*reader = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a storage media reader
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_reader_free(
+     storage_media_reader_t **reader,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_reader_free";
+	int reader_index      = 0;
+	int result            = 1;
+
+	if( reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( *reader != NULL )
+	{
+		/* The threads are joined in storage_media_reader_join
+		 */
+		for( reader_index = 0;
+		     reader_index < ( *reader )->number_of_readers;
+		     reader_index++ )
+		{
+			if( ( ( *reader )->handles[ reader_index ] != NULL )
+			 && ( libewf_handle_free(
+			       &( ( *reader )->handles[ reader_index ] ),
+			       error ) != 1 ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free handle: %d.",
+				 function,
+				 reader_index );
+
+				result = -1;
+			}
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *reader )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 ( *reader )->threads );
+
+		memory_free(
+		 ( *reader )->handles );
+
+		memory_free(
+		 *reader );
+
+		*reader = NULL;
+	}
+	return( result );
+}
+
+/* Signals the storage media reader to abort
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_reader_signal_abort(
+     storage_media_reader_t *reader,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_reader_signal_abort";
+	int reader_index      = 0;
+
+	if( reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reader.",
+		 function );
+
+		return( -1 );
+	}
+	reader->abort = 1;
+
+	for( reader_index = 0;
+	     reader_index < reader->number_of_readers;
+	     reader_index++ )
+	{
+		if( libewf_handle_signal_abort(
+		     reader->handles[ reader_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal handle: %d to abort.",
+			 function,
+			 reader_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Opens the reader handles
+ * Every reader opens the (already resolved) segment files on its own
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_reader_open(
+     storage_media_reader_t *reader,
+     system_character_t * const * filenames,
+     int number_of_filenames,
+     int header_codepage,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_reader_open";
+	int reader_index      = 0;
+
+	if( reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reader.",
+		 function );
+
+		return( -1 );
+	}
+	for( reader_index = 0;
+	     reader_index < reader->number_of_readers;
+	     reader_index++ )
+	{
+		if( maximum_number_of_open_handles > 0 )
+		{
+			if( libewf_handle_set_maximum_number_of_open_handles(
+			     reader->handles[ reader_index ],
+			     maximum_number_of_open_handles,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set maximum number of open handles in handle: %d.",
+				 function,
+				 reader_index );
+
+				return( -1 );
+			}
+		}
+		if( header_codepage != LIBEWF_CODEPAGE_ASCII )
+		{
+			if( libewf_handle_set_header_codepage(
+			     reader->handles[ reader_index ],
+			     header_codepage,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set header codepage in handle: %d.",
+				 function,
+				 reader_index );
+
+				return( -1 );
+			}
+		}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libewf_handle_open_wide(
+		     reader->handles[ reader_index ],
+		     filenames,
+		     number_of_filenames,
+		     LIBEWF_OPEN_READ,
+		     error ) != 1 )
+#else
+		if( libewf_handle_open(
+		     reader->handles[ reader_index ],
+		     filenames,
+		     number_of_filenames,
+		     LIBEWF_OPEN_READ,
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open handle: %d.",
+			 function,
+			 reader_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Closes the reader handles
+ * Returns the 0 if succesful or -1 on error
+ */
+int storage_media_reader_close(
+     storage_media_reader_t *reader,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_reader_close";
+	int reader_index      = 0;
+	int result            = 0;
+
+	if( reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reader.",
+		 function );
+
+		return( -1 );
+	}
+	for( reader_index = 0;
+	     reader_index < reader->number_of_readers;
+	     reader_index++ )
+	{
+		if( libewf_handle_close(
+		     reader->handles[ reader_index ],
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close handle: %d.",
+			 function,
+			 reader_index );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Sets the value to zero chunks on checksum error in the reader handles
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_reader_set_zero_chunk_on_error(
+     storage_media_reader_t *reader,
+     uint8_t zero_chunk_on_error,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_reader_set_zero_chunk_on_error";
+	int reader_index      = 0;
+
+	if( reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reader.",
+		 function );
+
+		return( -1 );
+	}
+	for( reader_index = 0;
+	     reader_index < reader->number_of_readers;
+	     reader_index++ )
+	{
+		if( libewf_handle_set_read_zero_chunk_on_error(
+		     reader->handles[ reader_index ],
+		     zero_chunk_on_error,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set zero chunk on error in handle: %d.",
+			 function,
+			 reader_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the value to bind the reader threads to the NUMA nodes
+ * The reader threads are distributed round-robin over the nodes so that
+ * the buffers, which are created by the reader threads, are allocated
+ * on the node of the reader thread. Binding is skipped if not supported
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_reader_set_numa_node_affinity(
+     storage_media_reader_t *reader,
+     uint8_t numa_node_affinity,
+     libcerror_error_t **error )
+{
+	static char *function    = "storage_media_reader_set_numa_node_affinity";
+	int number_of_numa_nodes = 0;
+	int result               = 0;
+
+	if( reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( numa_node_affinity != 0 )
+	{
+		result = numa_node_get_number_of_nodes(
+		          &number_of_numa_nodes,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of NUMA nodes.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			number_of_numa_nodes = 0;
+		}
+	}
+	reader->number_of_numa_nodes = number_of_numa_nodes;
+
+	return( 1 );
+}
+
+/* Starts the reader threads
+ * The readers grab storage media buffers from the queue, fill them with
+ * consecutive blocks of read size and push them onto the process thread pool
+ * The storage media offset of the buffers is relative to the start offset
+ * The number of outstanding reads is bounded by the size of the queue
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_reader_start(
+     storage_media_reader_t *reader,
+     storage_media_buffer_queue_t *storage_media_buffer_queue,
+     libcthreads_thread_pool_t *process_thread_pool,
+     off64_t start_offset,
+     size64_t size,
+     size_t read_size,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_reader_start";
+	int reader_index      = 0;
+
+	if( reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( process_thread_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid process thread pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( start_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid start offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( read_size == 0 )
+	 || ( read_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid read size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	reader->storage_media_buffer_queue = storage_media_buffer_queue;
+	reader->process_thread_pool        = process_thread_pool;
+	reader->start_offset               = start_offset;
+	reader->size                       = size;
+	reader->read_size                  = read_size;
+	reader->next_offset                = 0;
+	reader->next_handle_index          = 0;
+	reader->has_failed                 = 0;
+
+	for( reader_index = 0;
+	     reader_index < reader->number_of_readers;
+	     reader_index++ )
+	{
+		if( libcthreads_thread_create(
+		     &( reader->threads[ reader_index ] ),
+		     NULL,
+		     (int (*)(void *)) &storage_media_reader_thread_callback,
+		     (void *) reader,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread: %d.",
+			 function,
+			 reader_index );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	/* Stop and join the reader threads that were already started
+	 */
+	reader->abort = 1;
+
+	storage_media_reader_join(
+	 reader,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Joins the reader threads
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_reader_join(
+     storage_media_reader_t *reader,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_reader_join";
+	int reader_index      = 0;
+	int result            = 1;
+
+	if( reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reader.",
+		 function );
+
+		return( -1 );
+	}
+	for( reader_index = 0;
+	     reader_index < reader->number_of_readers;
+	     reader_index++ )
+	{
+		if( reader->threads[ reader_index ] == NULL )
+		{
+			continue;
+		}
+		if( libcthreads_thread_join(
+		     &( reader->threads[ reader_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread: %d.",
+			 function,
+			 reader_index );
+
+			result = -1;
+		}
+	}
+	if( ( result == 1 )
+	 && ( reader->has_failed != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+/* Copies the checksum errors detected by the reader handles to the handle
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_reader_copy_checksum_errors(
+     storage_media_reader_t *reader,
+     libewf_handle_t *handle,
+     libcerror_error_t **error )
+{
+	static char *function               = "storage_media_reader_copy_checksum_errors";
+	uint64_t number_of_sectors          = 0;
+	uint64_t start_sector               = 0;
+	uint32_t error_index                = 0;
+	uint32_t number_of_checksum_errors  = 0;
+	int reader_index                    = 0;
+
+	if( reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reader.",
+		 function );
+
+		return( -1 );
+	}
+	for( reader_index = 0;
+	     reader_index < reader->number_of_readers;
+	     reader_index++ )
+	{
+		if( libewf_handle_get_number_of_checksum_errors(
+		     reader->handles[ reader_index ],
+		     &number_of_checksum_errors,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of checksum errors from handle: %d.",
+			 function,
+			 reader_index );
+
+			return( -1 );
+		}
+		for( error_index = 0;
+		     error_index < number_of_checksum_errors;
+		     error_index++ )
+		{
+			if( libewf_handle_get_checksum_error(
+			     reader->handles[ reader_index ],
+			     error_index,
+			     &start_sector,
+			     &number_of_sectors,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve checksum error: %" PRIu32 " from handle: %d.",
+				 function,
+				 error_index,
+				 reader_index );
+
+				return( -1 );
+			}
+			if( libewf_handle_append_checksum_error(
+			     handle,
+			     start_sector,
+			     number_of_sectors,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append checksum error.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	return( 1 );
+}
+
+/* Reads storage media buffers and pushes them onto the process thread pool
+ * Callback function for the reader threads
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_reader_thread_callback(
+     storage_media_reader_t *reader )
+{
+	libcerror_error_t *error                     = NULL;
+	libewf_handle_t *handle                      = NULL;
+	storage_media_buffer_t *storage_media_buffer = NULL;
+	static char *function                        = "storage_media_reader_thread_callback";
+	off64_t storage_media_offset                 = 0;
+	size_t read_size                             = 0;
+	ssize_t read_count                           = 0;
+	int mutex_grabbed                            = 0;
+	int reader_index                             = 0;
+
+	if( reader == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reader.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_grab(
+	     reader->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	reader_index = reader->next_handle_index;
+	handle       = reader->handles[ reader_index ];
+
+	reader->next_handle_index += 1;
+
+	if( libcthreads_mutex_release(
+	     reader->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	/* The binding is done before the first buffer is grabbed so that
+	 * the buffers created by this reader are allocated on its node
+	 */
+	if( reader->number_of_numa_nodes > 0 )
+	{
+		if( numa_node_bind_current_thread(
+		     reader_index % reader->number_of_numa_nodes,
+		     &error ) == -1 )
+		{
+			/* Failing to bind the reader thread is not fatal
+			 */
+#if defined( HAVE_VERBOSE_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: unable to bind reader thread: %d to NUMA node.\n",
+				 function,
+				 reader_index );
+
+				libcnotify_print_error_backtrace(
+				 error );
+			}
+#endif
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	while( reader->abort == 0 )
+	{
+		/* Grabbing the buffer and claiming the offset under the same mutex
+		 * hands out the buffers in offset order. The reader that claimed
+		 * the lowest outstanding offset therefore always holds a buffer,
+		 * which prevents the ordered output from starving the readers.
+		 */
+		if( libcthreads_mutex_grab(
+		     reader->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			goto on_error;
+		}
+		mutex_grabbed = 1;
+
+		if( (size64_t) reader->next_offset >= reader->size )
+		{
+			break;
+		}
+		if( storage_media_buffer_queue_grab_buffer(
+		     reader->storage_media_buffer_queue,
+		     reader_index,
+		     &storage_media_buffer,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to grab storage media buffer from queue.",
+			 function );
+
+			goto on_error;
+		}
+		if( storage_media_buffer == NULL )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing storage media buffer.",
+			 function );
+
+			goto on_error;
+		}
+		if( reader->abort != 0 )
+		{
+			break;
+		}
+		storage_media_offset = reader->next_offset;
+		read_size            = reader->read_size;
+
+		if( ( reader->size - (size64_t) storage_media_offset ) < (size64_t) read_size )
+		{
+			read_size = (size_t) ( reader->size - storage_media_offset );
+		}
+		reader->next_offset += (off64_t) read_size;
+
+		if( libcthreads_mutex_release(
+		     reader->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			goto on_error;
+		}
+		mutex_grabbed = 0;
+
+		if( libewf_handle_seek_offset(
+		     handle,
+		     reader->start_offset + storage_media_offset,
+		     SEEK_SET,
+		     &error ) == -1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek offset: %" PRIi64 ".",
+			 function,
+			 reader->start_offset + storage_media_offset );
+
+			goto on_error;
+		}
+		read_count = storage_media_buffer_read_from_handle(
+		              storage_media_buffer,
+		              handle,
+		              read_size,
+		              &error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data at offset: %" PRIi64 ".",
+			 function,
+			 storage_media_offset );
+
+			goto on_error;
+		}
+		/* The next offset was claimed based on the read size
+		 */
+		if( (size_t) read_count != read_size )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unexpected end of data at offset: %" PRIi64 ".",
+			 function,
+			 storage_media_offset );
+
+			goto on_error;
+		}
+		storage_media_buffer->storage_media_offset = storage_media_offset;
+
+		if( libcthreads_thread_pool_push(
+		     reader->process_thread_pool,
+		     (intptr_t *) storage_media_buffer,
+		     &error ) == -1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push storage media buffer onto process thread pool queue.",
+			 function );
+
+			goto on_error;
+		}
+		storage_media_buffer = NULL;
+	}
+	if( mutex_grabbed != 0 )
+	{
+		mutex_grabbed = 0;
+
+		if( libcthreads_mutex_release(
+		     reader->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	/* A buffer grabbed after an abort was signalled is handed back
+	 * so that a reader blocked on the queue can observe the abort
+	 */
+	if( storage_media_buffer != NULL )
+	{
+		if( storage_media_buffer_queue_release_buffer(
+		     reader->storage_media_buffer_queue,
+		     storage_media_buffer,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to release storage media buffer onto queue.",
+			 function );
+
+			goto on_error;
+		}
+		storage_media_buffer = NULL;
+	}
+	return( 1 );
+
+on_error:
+	if( reader != NULL )
+	{
+		/* Make the other readers stop
+		 */
+		reader->has_failed = 1;
+		reader->abort      = 1;
+
+		if( mutex_grabbed != 0 )
+		{
+			libcthreads_mutex_release(
+			 reader->mutex,
+			 NULL );
+		}
+		if( storage_media_buffer != NULL )
+		{
+			if( storage_media_buffer_queue_release_buffer(
+			     reader->storage_media_buffer_queue,
+			     storage_media_buffer,
+			     NULL ) != 1 )
+			{
+				storage_media_buffer_free(
+				 &storage_media_buffer,
+				 NULL );
+			}
+		}
+	}
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,169 @@
+/*
+ * Storage media reader
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _STORAGE_MEDIA_READER_H )
+#define _STORAGE_MEDIA_READER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libewf.h"
+#include "storage_media_buffer.h"
+#include "storage_media_buffer_queue.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+typedef struct storage_media_reader storage_media_reader_t;
+
+/* The storage media reader is a dedicated read stage that reads ahead
+ * of the process thread pool. Every reader thread has its own libewf handle
+ * so that reads of different chunks are not serialized on a single handle
+ */
+struct storage_media_reader
+{
+	/* The number of readers
+	 */
+	int number_of_readers;
+
+	/* The reader (libewf) handles
+	 */
+	libewf_handle_t **handles;
+
+	/* The reader threads
+	 */
+	libcthreads_thread_t **threads;
+
+	/* The mutex that serializes grabbing a buffer and claiming a read offset
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The storage media buffer queue
+	 */
+	storage_media_buffer_queue_t *storage_media_buffer_queue;
+
+	/* The process thread pool
+	 */
+	libcthreads_thread_pool_t *process_thread_pool;
+
+	/* The offset at which reading starts
+	 */
+	off64_t start_offset;
+
+	/* The size of the data to read
+	 */
+	size64_t size;
+
+	/* The read size
+	 */
+	size_t read_size;
+
+	/* The offset of the next read relative to the start offset
+	 */
+	off64_t next_offset;
+
+	/* The index of the next handle to be assigned to a reader thread
+	 */
+	int next_handle_index;
+
+	/* The number of NUMA nodes the reader threads are distributed over
+	 * where 0 represents that the reader threads are not bound to a node
+	 */
+	int number_of_numa_nodes;
+
+	/* Value to indicate if one of the reader threads failed
+	 */
+	int has_failed;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int storage_media_reader_initialize(
+     storage_media_reader_t **reader,
+     int number_of_readers,
+     libcerror_error_t **error );
+
+int storage_media_reader_free(
+     storage_media_reader_t **reader,
+     libcerror_error_t **error );
+
+int storage_media_reader_signal_abort(
+     storage_media_reader_t *reader,
+     libcerror_error_t **error );
+
+int storage_media_reader_open(
+     storage_media_reader_t *reader,
+     system_character_t * const * filenames,
+     int number_of_filenames,
+     int header_codepage,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error );
+
+int storage_media_reader_close(
+     storage_media_reader_t *reader,
+     libcerror_error_t **error );
+
+int storage_media_reader_set_zero_chunk_on_error(
+     storage_media_reader_t *reader,
+     uint8_t zero_chunk_on_error,
+     libcerror_error_t **error );
+
+int storage_media_reader_set_numa_node_affinity(
+     storage_media_reader_t *reader,
+     uint8_t numa_node_affinity,
+     libcerror_error_t **error );
+
+int storage_media_reader_start(
+     storage_media_reader_t *reader,
+     storage_media_buffer_queue_t *storage_media_buffer_queue,
+     libcthreads_thread_pool_t *process_thread_pool,
+     off64_t start_offset,
+     size64_t size,
+     size_t read_size,
+     libcerror_error_t **error );
+
+int storage_media_reader_join(
+     storage_media_reader_t *reader,
+     libcerror_error_t **error );
+
+int storage_media_reader_copy_checksum_errors(
+     storage_media_reader_t *reader,
+     libewf_handle_t *handle,
+     libcerror_error_t **error );
+
+int storage_media_reader_thread_callback(
+     storage_media_reader_t *reader );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _STORAGE_MEDIA_READER_H ) */
+
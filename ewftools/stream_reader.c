@@ -0,0 +1,1042 @@
+/*
+ * Stream reader
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H ) || defined( WINAPI )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( HAVE_IO_H ) || defined( WINAPI )
+#include <io.h>
+#endif
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libcthreads.h"
+#include "storage_media_buffer.h"
+#include "stream_reader.h"
+
+/* F_SETPIPE_SZ is only defined by the C library headers when _GNU_SOURCE is set
+ */
+#if defined( __linux__ ) && !defined( F_SETPIPE_SZ )
+#define F_SETPIPE_SZ	1031
+#endif
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Creates a stream reader
+ * Make sure the value reader is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int stream_reader_initialize(
+     stream_reader_t **reader,
+     int file_descriptor,
+     size_t buffer_size,
+     size64_t maximum_size,
+     uint8_t read_error_retries,
+     libcerror_error_t **error )
+{
+	static char *function = "stream_reader_initialize";
+
+	if( reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( *reader != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid reader value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*reader = memory_allocate_structure(
+	           stream_reader_t );
+
+	if( *reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create reader.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *reader,
+	     0,
+	     sizeof( stream_reader_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear reader.",
+		 function );
+
+		memory_free(
+		 *reader );
+
+		*reader = NULL;
+
+		return( -1 );
+	}
+	( *reader )->buffer = (uint8_t *) memory_allocate(
+	                                   sizeof( uint8_t ) * buffer_size );
+
+	if( ( *reader )->buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *reader )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *reader )->data_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create data condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *reader )->space_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create space condition.",
+		 function );
+
+		goto on_error;
+	}
+	( *reader )->file_descriptor    = file_descriptor;
+	( *reader )->buffer_size        = buffer_size;
+	( *reader )->maximum_size       = maximum_size;
+	( *reader )->read_error_retries = read_error_retries;
+
+	return( 1 );
+
+on_error:
+	if( *reader != NULL )
+	{
+		if( ( *reader )->data_condition != NULL )
+		{
+			libcthreads_condition_free(
+			 &( ( *reader )->data_condition ),
+			 NULL );
+		}
+		if( ( *reader )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *reader )->mutex ),
+			 NULL );
+		}
+		if( ( *reader )->buffer != NULL )
+		{
+			memory_free(
+			 ( *reader )->buffer );
+		}
+		memory_free(
+		 *reader );
+
+		*reader = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a stream reader
+ * Returns 1 if successful or -1 on error
+ */
+int stream_reader_free(
+     stream_reader_t **reader,
+     libcerror_error_t **error )
+{
+	static char *function = "stream_reader_free";
+	int result            = 1;
+
+	if( reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( *reader != NULL )
+	{
+		/* The thread is joined in stream_reader_join
+		 */
+		if( libcthreads_condition_free(
+		     &( ( *reader )->space_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free space condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_condition_free(
+		     &( ( *reader )->data_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free data condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *reader )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 ( *reader )->buffer );
+
+		memory_free(
+		 *reader );
+
+		*reader = NULL;
+	}
+	return( result );
+}
+
+/* Signals the stream reader to abort
+ * Returns 1 if successful or -1 on error
+ */
+int stream_reader_signal_abort(
+     stream_reader_t *reader,
+     libcerror_error_t **error )
+{
+	static char *function = "stream_reader_signal_abort";
+
+	if( reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     reader->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	reader->abort = 1;
+
+	libcthreads_condition_broadcast(
+	 reader->data_condition,
+	 NULL );
+
+	libcthreads_condition_broadcast(
+	 reader->space_condition,
+	 NULL );
+
+	if( libcthreads_mutex_release(
+	     reader->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Starts the reader thread
+ * Returns 1 if successful or -1 on error
+ */
+int stream_reader_start(
+     stream_reader_t *reader,
+     libcerror_error_t **error )
+{
+	static char *function = "stream_reader_start";
+
+	if( reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( reader->thread != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid reader - thread value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( F_SETPIPE_SZ )
+	/* Enlarge the kernel pipe buffer so that the producer of the input
+	 * can continue writing while the reader thread is not reading.
+	 * This fails if the input is not a pipe, which is not considered an error
+	 */
+	if( fcntl(
+	     reader->file_descriptor,
+	     F_SETPIPE_SZ,
+	     STREAM_READER_PIPE_SIZE ) == -1 )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: unable to set pipe size.\n",
+			 function );
+		}
+#endif
+	}
+#endif
+	reader->data_offset  = 0;
+	reader->data_size    = 0;
+	reader->input_size   = 0;
+	reader->end_of_input = 0;
+	reader->has_failed   = 0;
+
+	if( libcthreads_thread_create(
+	     &( reader->thread ),
+	     NULL,
+	     (int (*)(void *)) &stream_reader_thread_callback,
+	     (void *) reader,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Joins the reader thread
+ * Returns 1 if successful or -1 on error
+ */
+int stream_reader_join(
+     stream_reader_t *reader,
+     libcerror_error_t **error )
+{
+	static char *function = "stream_reader_join";
+	int result            = 1;
+
+	if( reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( reader->thread == NULL )
+	{
+		return( 1 );
+	}
+	/* The reader thread stops when the end of the input is reached,
+	 * when abort is signalled or when it fails to read
+	 */
+	if( libcthreads_thread_join(
+	     &( reader->thread ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to join thread.",
+		 function );
+
+		result = -1;
+	}
+	if( ( result == 1 )
+	 && ( reader->abort == 0 )
+	 && ( reader->has_failed != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+/* Reads a buffer from the ring buffer
+ * Blocks until size bytes are available or the end of the input is reached
+ * This function assumes it is called from a single thread
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t stream_reader_read_buffer(
+         stream_reader_t *reader,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function = "stream_reader_read_buffer";
+	size_t buffer_offset  = 0;
+	size_t copy_size      = 0;
+	size_t data_offset    = 0;
+
+	if( reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < size )
+	{
+		if( libcthreads_mutex_grab(
+		     reader->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			return( -1 );
+		}
+		while( ( reader->data_size == 0 )
+		    && ( reader->end_of_input == 0 )
+		    && ( reader->has_failed == 0 )
+		    && ( reader->abort == 0 ) )
+		{
+			if( libcthreads_condition_wait(
+			     reader->data_condition,
+			     reader->mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to wait for data condition.",
+				 function );
+
+				libcthreads_mutex_release(
+				 reader->mutex,
+				 NULL );
+
+				return( -1 );
+			}
+		}
+		if( reader->has_failed != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: error reading data.",
+			 function );
+
+			libcthreads_mutex_release(
+			 reader->mutex,
+			 NULL );
+
+			return( -1 );
+		}
+		/* The data in the ring buffer is not overwritten by the reader thread
+		 * until it is released, hence it can be copied without holding the mutex
+		 */
+		data_offset = reader->data_offset;
+		copy_size   = reader->data_size;
+
+		if( reader->abort != 0 )
+		{
+			copy_size = 0;
+		}
+		if( libcthreads_mutex_release(
+		     reader->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			return( -1 );
+		}
+		/* No more data is available
+		 */
+		if( copy_size == 0 )
+		{
+			break;
+		}
+		if( copy_size > ( reader->buffer_size - data_offset ) )
+		{
+			copy_size = reader->buffer_size - data_offset;
+		}
+		if( copy_size > ( size - buffer_offset ) )
+		{
+			copy_size = size - buffer_offset;
+		}
+		if( memory_copy(
+		     &( buffer[ buffer_offset ] ),
+		     &( reader->buffer[ data_offset ] ),
+		     copy_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data.",
+			 function );
+
+			return( -1 );
+		}
+		buffer_offset += copy_size;
+
+		if( libcthreads_mutex_grab(
+		     reader->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			return( -1 );
+		}
+		reader->data_offset += copy_size;
+		reader->data_size   -= copy_size;
+
+		if( reader->data_offset >= reader->buffer_size )
+		{
+			reader->data_offset = 0;
+		}
+		libcthreads_condition_signal(
+		 reader->space_condition,
+		 NULL );
+
+		if( libcthreads_mutex_release(
+		     reader->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( (ssize_t) buffer_offset );
+}
+
+/* Reads a storage media buffer from the ring buffer
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t stream_reader_read_storage_media_buffer(
+         stream_reader_t *reader,
+         storage_media_buffer_t *storage_media_buffer,
+         off64_t storage_media_offset,
+         size_t read_size,
+         libcerror_error_t **error )
+{
+	static char *function = "stream_reader_read_storage_media_buffer";
+	ssize_t read_count    = 0;
+
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_size > storage_media_buffer->raw_buffer_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid read size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = stream_reader_read_buffer(
+	              reader,
+	              storage_media_buffer->raw_buffer,
+	              read_size,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		return( -1 );
+	}
+	storage_media_buffer->storage_media_offset = storage_media_offset;
+	storage_media_buffer->requested_size       = read_size;
+	storage_media_buffer->raw_buffer_data_size = (size_t) read_count;
+
+	return( read_count );
+}
+
+/* Reads the input into the ring buffer
+ * Callback function for the reader thread
+ * Returns 1 if successful or -1 on error
+ */
+int stream_reader_thread_callback(
+     stream_reader_t *reader )
+{
+	libcerror_error_t *error      = NULL;
+	static char *function         = "stream_reader_thread_callback";
+	size_t read_size              = 0;
+	size_t write_offset           = 0;
+	ssize_t read_count            = 0;
+	int32_t read_number_of_errors = 0;
+	int result                    = 1;
+
+	if( reader == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reader.",
+		 function );
+
+		goto on_error;
+	}
+	while( 1 )
+	{
+		if( libcthreads_mutex_grab(
+		     reader->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			goto on_error;
+		}
+		while( ( reader->data_size == reader->buffer_size )
+		    && ( reader->abort == 0 ) )
+		{
+			if( libcthreads_condition_wait(
+			     reader->space_condition,
+			     reader->mutex,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to wait for space condition.",
+				 function );
+
+				libcthreads_mutex_release(
+				 reader->mutex,
+				 NULL );
+
+				goto on_error;
+			}
+		}
+		/* Determine the contiguous free space after the data in the ring buffer
+		 */
+		write_offset = reader->data_offset + reader->data_size;
+
+		if( write_offset >= reader->buffer_size )
+		{
+			write_offset -= reader->buffer_size;
+		}
+		if( write_offset < reader->data_offset )
+		{
+			read_size = reader->data_offset - write_offset;
+		}
+		else
+		{
+			read_size = reader->buffer_size - write_offset;
+		}
+		if( reader->abort != 0 )
+		{
+			read_size = 0;
+		}
+		if( libcthreads_mutex_release(
+		     reader->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			goto on_error;
+		}
+		if( read_size > STREAM_READER_MAXIMUM_READ_SIZE )
+		{
+			read_size = STREAM_READER_MAXIMUM_READ_SIZE;
+		}
+		/* Do not read beyond the data needed, so that the reader thread
+		 * does not block on input that will never be processed
+		 */
+		if( reader->maximum_size != 0 )
+		{
+			if( ( reader->maximum_size - reader->input_size ) < (size64_t) read_size )
+			{
+				read_size = (size_t) ( reader->maximum_size - reader->input_size );
+			}
+		}
+		if( read_size == 0 )
+		{
+			break;
+		}
+#if defined( WINAPI ) && !defined( __CYGWIN__ )
+		read_count = _read(
+		              reader->file_descriptor,
+		              &( reader->buffer[ write_offset ] ),
+		              (unsigned int) read_size );
+#else
+		read_count = read(
+		              reader->file_descriptor,
+		              &( reader->buffer[ write_offset ] ),
+		              read_size );
+#endif
+		if( read_count < 0 )
+		{
+			if( ( errno == ESPIPE )
+			 || ( errno == EPERM )
+			 || ( errno == ENXIO )
+			 || ( errno == ENODEV ) )
+			{
+				libcerror_system_set_error(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 errno,
+				 "%s: error reading data.",
+				 function );
+
+				goto on_error;
+			}
+#if defined( HAVE_VERBOSE_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: read error at offset: 0x%08" PRIx64 " when reading %" PRIzd " bytes.\n",
+				 function,
+				 reader->input_size,
+				 read_size );
+			}
+#endif
+			read_number_of_errors++;
+
+			if( read_number_of_errors > reader->read_error_retries )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: error reading data.",
+				 function );
+
+				goto on_error;
+			}
+			continue;
+		}
+		/* No bytes were read
+		 */
+		if( read_count == 0 )
+		{
+			break;
+		}
+		read_number_of_errors = 0;
+		reader->input_size   += read_count;
+
+		if( libcthreads_mutex_grab(
+		     reader->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			goto on_error;
+		}
+		reader->data_size += (size_t) read_count;
+
+		libcthreads_condition_signal(
+		 reader->data_condition,
+		 NULL );
+
+		if( libcthreads_mutex_release(
+		     reader->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_mutex_grab(
+	     reader->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	reader->end_of_input = 1;
+
+	libcthreads_condition_broadcast(
+	 reader->data_condition,
+	 NULL );
+
+	if( libcthreads_mutex_release(
+	     reader->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( reader != NULL )
+	{
+		/* The caller is woken up to observe the failure
+		 */
+		if( libcthreads_mutex_grab(
+		     reader->mutex,
+		     NULL ) == 1 )
+		{
+			reader->has_failed = 1;
+
+			libcthreads_condition_broadcast(
+			 reader->data_condition,
+			 NULL );
+
+			libcthreads_mutex_release(
+			 reader->mutex,
+			 NULL );
+		}
+		else
+		{
+			reader->has_failed = 1;
+		}
+	}
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,165 @@
+/*
+ * Stream reader
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _STREAM_READER_H )
+#define _STREAM_READER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "storage_media_buffer.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The default size of the ring buffer
+ */
+#define STREAM_READER_DEFAULT_BUFFER_SIZE		( 16 * 1024 * 1024 )
+
+/* The maximum size of a single read of the input
+ */
+#define STREAM_READER_MAXIMUM_READ_SIZE			( 1024 * 1024 )
+
+/* The requested size of the pipe buffer of the input
+ */
+#define STREAM_READER_PIPE_SIZE				( 1024 * 1024 )
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+typedef struct stream_reader stream_reader_t;
+
+/* The stream reader reads the input on a dedicated thread into a ring buffer
+ * so that the producer of the input is not stalled while the data is processed
+ */
+struct stream_reader
+{
+	/* The input file descriptor
+	 */
+	int file_descriptor;
+
+	/* The ring buffer
+	 */
+	uint8_t *buffer;
+
+	/* The ring buffer size
+	 */
+	size_t buffer_size;
+
+	/* The offset of the data in the ring buffer
+	 */
+	size_t data_offset;
+
+	/* The size of the data in the ring buffer
+	 */
+	size_t data_size;
+
+	/* The maximum number of bytes to read from the input, where 0 represents no maximum
+	 */
+	size64_t maximum_size;
+
+	/* The number of bytes read from the input
+	 */
+	size64_t input_size;
+
+	/* The number of read error retries
+	 */
+	uint8_t read_error_retries;
+
+	/* The reader thread
+	 */
+	libcthreads_thread_t *thread;
+
+	/* The mutex that protects the ring buffer values
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that signals that data was added to the ring buffer
+	 */
+	libcthreads_condition_t *data_condition;
+
+	/* The condition that signals that space was freed in the ring buffer
+	 */
+	libcthreads_condition_t *space_condition;
+
+	/* Value to indicate the end of the input was reached
+	 */
+	int end_of_input;
+
+	/* Value to indicate if the reader thread failed
+	 */
+	int has_failed;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int stream_reader_initialize(
+     stream_reader_t **reader,
+     int file_descriptor,
+     size_t buffer_size,
+     size64_t maximum_size,
+     uint8_t read_error_retries,
+     libcerror_error_t **error );
+
+int stream_reader_free(
+     stream_reader_t **reader,
+     libcerror_error_t **error );
+
+int stream_reader_signal_abort(
+     stream_reader_t *reader,
+     libcerror_error_t **error );
+
+int stream_reader_start(
+     stream_reader_t *reader,
+     libcerror_error_t **error );
+
+int stream_reader_join(
+     stream_reader_t *reader,
+     libcerror_error_t **error );
+
+ssize_t stream_reader_read_buffer(
+         stream_reader_t *reader,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+ssize_t stream_reader_read_storage_media_buffer(
+         stream_reader_t *reader,
+         storage_media_buffer_t *storage_media_buffer,
+         off64_t storage_media_offset,
+         size_t read_size,
+         libcerror_error_t **error );
+
+int stream_reader_thread_callback(
+     stream_reader_t *reader );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _STREAM_READER_H ) */
+
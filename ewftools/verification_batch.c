@@ -0,0 +1,1640 @@
+/*
+ * Batch verification of multiple image sets
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libewf.h"
+#include "verification_batch.h"
+#include "verification_handle.h"
+
+/* Creates a verification batch item
+ * Make sure the value item is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int verification_batch_item_initialize(
+     verification_batch_item_t **item,
+     const system_character_t *filename,
+     size_t filename_length,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_batch_item_initialize";
+
+	if( item == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item.",
+		 function );
+
+		return( -1 );
+	}
+	if( *item != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid item value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( filename_length == 0 )
+	 || ( filename_length > (size_t) ( ( SSIZE_MAX / sizeof( system_character_t ) ) - 1 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid filename length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*item = memory_allocate_structure(
+	         verification_batch_item_t );
+
+	if( *item == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create item.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *item,
+	     0,
+	     sizeof( verification_batch_item_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear item.",
+		 function );
+
+		memory_free(
+		 *item );
+
+		*item = NULL;
+
+		return( -1 );
+	}
+	( *item )->filename = system_string_allocate(
+	                       filename_length + 1 );
+
+	if( ( *item )->filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     ( *item )->filename,
+	     filename,
+	     filename_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy filename.",
+		 function );
+
+		goto on_error;
+	}
+	( *item )->filename[ filename_length ] = 0;
+
+	return( 1 );
+
+on_error:
+	if( *item != NULL )
+	{
+		if( ( *item )->filename != NULL )
+		{
+			memory_free(
+			 ( *item )->filename );
+		}
+		memory_free(
+		 *item );
+
+		*item = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a verification batch item
+ * Returns 1 if successful or -1 on error
+ */
+int verification_batch_item_free(
+     verification_batch_item_t **item,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_batch_item_free";
+
+	if( item == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item.",
+		 function );
+
+		return( -1 );
+	}
+	if( *item != NULL )
+	{
+		/* The verification handle is managed by the verify function
+		 */
+		if( ( *item )->filename != NULL )
+		{
+			memory_free(
+			 ( *item )->filename );
+		}
+		memory_free(
+		 *item );
+
+		*item = NULL;
+	}
+	return( 1 );
+}
+
+/* Creates a verification batch
+ * Make sure the value batch is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int verification_batch_initialize(
+     verification_batch_t **batch,
+     verification_handle_t *settings_handle,
+     const system_character_t *additional_digest_types,
+     uint8_t zero_chunk_on_error,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_batch_initialize";
+
+	if( batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( *batch != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid batch value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( settings_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid settings handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( settings_handle->input_format != VERIFICATION_HANDLE_INPUT_FORMAT_RAW )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported input format.",
+		 function );
+
+		return( -1 );
+	}
+	*batch = memory_allocate_structure(
+	          verification_batch_t );
+
+	if( *batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create batch.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *batch,
+	     0,
+	     sizeof( verification_batch_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear batch.",
+		 function );
+
+		memory_free(
+		 *batch );
+
+		*batch = NULL;
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *batch )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *batch )->settings_handle                = settings_handle;
+	( *batch )->additional_digest_types        = additional_digest_types;
+	( *batch )->zero_chunk_on_error            = zero_chunk_on_error;
+	( *batch )->maximum_number_of_open_handles = settings_handle->maximum_number_of_open_handles;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	( *batch )->number_of_jobs = settings_handle->number_of_threads;
+#endif
+
+	return( 1 );
+
+on_error:
+	if( *batch != NULL )
+	{
+		memory_free(
+		 *batch );
+
+		*batch = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a verification batch
+ * Returns 1 if successful or -1 on error
+ */
+int verification_batch_free(
+     verification_batch_t **batch,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_batch_free";
+	int item_index        = 0;
+	int result            = 1;
+
+	if( batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( *batch != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *batch )->verify_thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *batch )->verify_thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join verify thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *batch )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		if( ( *batch )->items != NULL )
+		{
+			for( item_index = 0;
+			     item_index < ( *batch )->number_of_items;
+			     item_index++ )
+			{
+				if( verification_batch_item_free(
+				     &( ( *batch )->items[ item_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free item: %d.",
+					 function,
+					 item_index );
+
+					result = -1;
+				}
+			}
+			memory_free(
+			 ( *batch )->items );
+		}
+		memory_free(
+		 *batch );
+
+		*batch = NULL;
+	}
+	return( result );
+}
+
+/* Signals the verification batch to abort
+ * Returns 1 if successful or -1 on error
+ */
+int verification_batch_signal_abort(
+     verification_batch_t *batch,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_batch_signal_abort";
+	int item_index        = 0;
+	int result            = 1;
+
+	if( batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch.",
+		 function );
+
+		return( -1 );
+	}
+	batch->abort = 1;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     batch->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	for( item_index = 0;
+	     item_index < batch->number_of_items;
+	     item_index++ )
+	{
+		if( batch->items[ item_index ]->verification_handle == NULL )
+		{
+			continue;
+		}
+		if( verification_handle_signal_abort(
+		     batch->items[ item_index ]->verification_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal verification handle of item: %d to abort.",
+			 function,
+			 item_index );
+
+			result = -1;
+
+			break;
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     batch->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Appends an item to the verification batch
+ * Returns 1 if successful or -1 on error
+ */
+int verification_batch_append_item(
+     verification_batch_t *batch,
+     verification_batch_item_t *item,
+     libcerror_error_t **error )
+{
+	void *reallocation                = NULL;
+	static char *function             = "verification_batch_append_item";
+	size_t new_size                   = 0;
+	int new_number_of_allocated_items = 0;
+
+	if( batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( item == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item.",
+		 function );
+
+		return( -1 );
+	}
+	if( batch->number_of_items >= batch->number_of_allocated_items )
+	{
+		if( batch->number_of_allocated_items == 0 )
+		{
+			new_number_of_allocated_items = 64;
+		}
+		else if( batch->number_of_allocated_items <= ( INT32_MAX / 2 ) )
+		{
+			new_number_of_allocated_items = batch->number_of_allocated_items * 2;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid batch - number of allocated items value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		new_size = sizeof( verification_batch_item_t * ) * new_number_of_allocated_items;
+
+		if( new_size > (size_t) SSIZE_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid items size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		reallocation = memory_reallocate(
+		                batch->items,
+		                new_size );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to reallocate items.",
+			 function );
+
+			return( -1 );
+		}
+		batch->items                     = (verification_batch_item_t **) reallocation;
+		batch->number_of_allocated_items = new_number_of_allocated_items;
+	}
+	batch->items[ batch->number_of_items ] = item;
+
+	batch->number_of_items += 1;
+
+	return( 1 );
+}
+
+/* Reads the manifest
+ * The manifest contains the filename of the (first) segment file of an image set per line,
+ * empty lines and lines starting with # are ignored
+ * Returns 1 if successful or -1 on error
+ */
+int verification_batch_read_manifest(
+     verification_batch_t *batch,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	system_character_t line[ VERIFICATION_BATCH_MAXIMUM_LINE_SIZE ];
+
+	verification_batch_item_t *item = NULL;
+	system_character_t *end_of_line = NULL;
+	FILE *manifest_stream           = NULL;
+	static char *function           = "verification_batch_read_manifest";
+	size_t line_length              = 0;
+	int line_number                 = 0;
+
+	if( batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	manifest_stream = file_stream_open_wide(
+	                   filename,
+	                   _SYSTEM_STRING( FILE_STREAM_OPEN_READ ) );
+#else
+	manifest_stream = file_stream_open(
+	                   filename,
+	                   FILE_STREAM_OPEN_READ );
+#endif
+	if( manifest_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open manifest.",
+		 function );
+
+		goto on_error;
+	}
+	while( 1 )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( file_stream_get_string_wide(
+		     manifest_stream,
+		     line,
+		     VERIFICATION_BATCH_MAXIMUM_LINE_SIZE ) == NULL )
+#else
+		if( file_stream_get_string(
+		     manifest_stream,
+		     line,
+		     VERIFICATION_BATCH_MAXIMUM_LINE_SIZE ) == NULL )
+#endif
+		{
+			break;
+		}
+		line_number++;
+
+		end_of_line = system_string_search_character(
+		               line,
+		               (system_character_t) '\n',
+		               VERIFICATION_BATCH_MAXIMUM_LINE_SIZE );
+
+		line_length = system_string_length(
+		               line );
+
+		if( ( end_of_line == NULL )
+		 && ( line_length >= ( VERIFICATION_BATCH_MAXIMUM_LINE_SIZE - 1 ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid manifest - line: %d exceeds maximum size.",
+			 function,
+			 line_number );
+
+			goto on_error;
+		}
+		while( ( line_length > 0 )
+		    && ( ( line[ line_length - 1 ] == (system_character_t) '\n' )
+		     ||  ( line[ line_length - 1 ] == (system_character_t) '\r' ) ) )
+		{
+			line_length--;
+		}
+		if( ( line_length == 0 )
+		 || ( line[ 0 ] == (system_character_t) '#' ) )
+		{
+			continue;
+		}
+		if( verification_batch_item_initialize(
+		     &item,
+		     line,
+		     line_length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create item for line: %d.",
+			 function,
+			 line_number );
+
+			goto on_error;
+		}
+		if( verification_batch_append_item(
+		     batch,
+		     item,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append item for line: %d.",
+			 function,
+			 line_number );
+
+			goto on_error;
+		}
+		item = NULL;
+	}
+	if( file_stream_close(
+	     manifest_stream ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close manifest.",
+		 function );
+
+		manifest_stream = NULL;
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( item != NULL )
+	{
+		verification_batch_item_free(
+		 &item,
+		 NULL );
+	}
+	if( manifest_stream != NULL )
+	{
+		file_stream_close(
+		 manifest_stream );
+	}
+	return( -1 );
+}
+
+/* Marks the start of the verification of an item
+ * Determines the number of process threads available to the item,
+ * the jobs are shared by all items that are being verified, once no more
+ * items are queued the remaining items use the jobs that became idle
+ * Returns 1 if successful or -1 on error
+ */
+int verification_batch_start_item(
+     verification_batch_t *batch,
+     verification_batch_item_t *item,
+     verification_handle_t *verification_handle,
+     int *number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_batch_start_item";
+
+	if( batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( item == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of threads.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     batch->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	batch->number_of_queued_items -= 1;
+	batch->number_of_active_items += 1;
+
+	*number_of_threads = 0;
+
+	if( ( batch->number_of_queued_items == 0 )
+	 && ( batch->number_of_jobs > batch->number_of_active_items ) )
+	{
+		*number_of_threads = batch->number_of_jobs / batch->number_of_active_items;
+
+		/* A single process thread adds overhead compared to the main thread
+		 */
+		if( *number_of_threads == 1 )
+		{
+			*number_of_threads = 0;
+		}
+	}
+	item->verification_handle = verification_handle;
+
+	/* Make sure items started after an abort was signalled stop immediately
+	 */
+	if( ( batch->abort != 0 )
+	 && ( verification_handle != NULL ) )
+	{
+		verification_handle->abort = 1;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     batch->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Marks the end of the verification of an item and prints its result
+ * Returns 1 if successful or -1 on error
+ */
+int verification_batch_stop_item(
+     verification_batch_t *batch,
+     verification_batch_item_t *item,
+     verification_handle_t *verification_handle,
+     int result,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_batch_stop_item";
+	int print_result      = 0;
+
+	if( batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( item == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     batch->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	batch->number_of_active_items -= 1;
+
+	item->verification_handle = NULL;
+
+	if( result != 1 )
+	{
+		batch->number_of_failed_items += 1;
+	}
+	/* The results are printed while holding the mutex so that the lines do not interleave
+	 */
+	print_result = verification_batch_result_fprint(
+	                batch,
+	                item,
+	                verification_handle,
+	                result,
+	                error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     batch->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( print_result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print result.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Prints the result of an item to the results stream
+ * The result is printed as a single line of tab separated values:
+ * status, media size, number of checksum errors, calculated MD5, stored MD5,
+ * calculated SHA1, calculated SHA256 and filename, where - represents a value
+ * that is not available
+ * Returns 1 if successful or -1 on error
+ */
+int verification_batch_result_fprint(
+     verification_batch_t *batch,
+     verification_batch_item_t *item,
+     verification_handle_t *verification_handle,
+     int result,
+     libcerror_error_t **error )
+{
+	const system_character_t *calculated_md5_hash_string    = _SYSTEM_STRING( "-" );
+	const system_character_t *calculated_sha1_hash_string   = _SYSTEM_STRING( "-" );
+	const system_character_t *calculated_sha256_hash_string = _SYSTEM_STRING( "-" );
+	const system_character_t *status_string                 = NULL;
+	const system_character_t *stored_md5_hash_string        = _SYSTEM_STRING( "-" );
+	static char *function                                   = "verification_batch_result_fprint";
+	size64_t media_size                                     = 0;
+	uint32_t number_of_checksum_errors                      = 0;
+
+	if( batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( item == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item.",
+		 function );
+
+		return( -1 );
+	}
+	if( batch->results_stream == NULL )
+	{
+		return( 1 );
+	}
+	if( ( verification_handle != NULL )
+	 && ( verification_handle->abort != 0 ) )
+	{
+		status_string = _SYSTEM_STRING( "ABORTED" );
+	}
+	else if( result == 1 )
+	{
+		status_string = _SYSTEM_STRING( "SUCCESS" );
+	}
+	else if( result == 0 )
+	{
+		status_string = _SYSTEM_STRING( "FAILURE" );
+	}
+	else
+	{
+		status_string = _SYSTEM_STRING( "ERROR" );
+	}
+	if( ( verification_handle != NULL )
+	 && ( result != -1 ) )
+	{
+		media_size = verification_handle->media_size;
+
+		if( libewf_handle_get_number_of_checksum_errors(
+		     verification_handle->input_handle,
+		     &number_of_checksum_errors,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of checksum errors.",
+			 function );
+
+			return( -1 );
+		}
+		if( verification_handle->calculate_md5 != 0 )
+		{
+			calculated_md5_hash_string = verification_handle->calculated_md5_hash_string;
+		}
+		if( verification_handle->stored_md5_hash_available != 0 )
+		{
+			stored_md5_hash_string = verification_handle->stored_md5_hash_string;
+		}
+		if( verification_handle->calculate_sha1 != 0 )
+		{
+			calculated_sha1_hash_string = verification_handle->calculated_sha1_hash_string;
+		}
+		if( verification_handle->calculate_sha256 != 0 )
+		{
+			calculated_sha256_hash_string = verification_handle->calculated_sha256_hash_string;
+		}
+	}
+	fprintf(
+	 batch->results_stream,
+	 "%" PRIs_SYSTEM "\t%" PRIu64 "\t%" PRIu32 "\t%" PRIs_SYSTEM "\t%" PRIs_SYSTEM "\t%" PRIs_SYSTEM "\t%" PRIs_SYSTEM "\t%" PRIs_SYSTEM "\n",
+	 status_string,
+	 media_size,
+	 number_of_checksum_errors,
+	 calculated_md5_hash_string,
+	 stored_md5_hash_string,
+	 calculated_sha1_hash_string,
+	 calculated_sha256_hash_string,
+	 item->filename );
+
+	fflush(
+	 batch->results_stream );
+
+	return( 1 );
+}
+
+/* Opens the image set of an item using the settings of the batch
+ * Returns 1 if successful or -1 on error
+ */
+int verification_batch_open_item(
+     verification_batch_t *batch,
+     verification_batch_item_t *item,
+     verification_handle_t *verification_handle,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function              = "verification_batch_open_item";
+	int maximum_number_of_open_handles = 0;
+
+	if( batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( batch->settings_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid batch - missing settings handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( item == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	/* The results are printed by the batch
+	 */
+	verification_handle->notify_stream       = NULL;
+	verification_handle->header_codepage     = batch->settings_handle->header_codepage;
+	verification_handle->process_buffer_size = batch->settings_handle->process_buffer_size;
+	verification_handle->number_of_threads   = number_of_threads;
+
+	if( number_of_threads != 0 )
+	{
+		verification_handle->number_of_readers = batch->settings_handle->number_of_readers;
+	}
+	if( batch->additional_digest_types != NULL )
+	{
+		if( verification_handle_set_additional_digest_types(
+		     verification_handle,
+		     batch->additional_digest_types,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set additional digest types.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	/* The open file handles limit is shared by the items that are verified concurrently
+	 */
+	if( batch->maximum_number_of_open_handles > 0 )
+	{
+		maximum_number_of_open_handles = batch->maximum_number_of_open_handles;
+
+		if( batch->number_of_jobs > 1 )
+		{
+			maximum_number_of_open_handles /= batch->number_of_jobs;
+		}
+		if( maximum_number_of_open_handles == 0 )
+		{
+			maximum_number_of_open_handles = 1;
+		}
+		if( verification_handle_set_maximum_number_of_open_handles(
+		     verification_handle,
+		     maximum_number_of_open_handles,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum number of open file handles.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( verification_handle_open_input(
+	     verification_handle,
+	     &( item->filename ),
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open image set: %" PRIs_SYSTEM ".",
+		 function,
+		 item->filename );
+
+		return( -1 );
+	}
+	if( verification_handle_set_zero_chunk_on_error(
+	     verification_handle,
+	     batch->zero_chunk_on_error,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set zero chunk on error.",
+		 function );
+
+		verification_handle_close(
+		 verification_handle,
+		 NULL );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Verifies the image set of an item
+ * Errors that are specific to the image set are reported in its result
+ * Returns 1 if successful or -1 on error
+ */
+int verification_batch_verify_item(
+     verification_batch_t *batch,
+     verification_batch_item_t *item,
+     libcerror_error_t **error )
+{
+	libcerror_error_t *item_error              = NULL;
+	verification_handle_t *verification_handle = NULL;
+	static char *function                      = "verification_batch_verify_item";
+	int is_open                                = 0;
+	int number_of_threads                      = 0;
+	int result                                 = 0;
+
+	if( batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( batch->settings_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid batch - missing settings handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( item == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle_initialize(
+	     &verification_handle,
+	     batch->settings_handle->calculate_md5,
+	     batch->settings_handle->use_chunk_data_functions,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create verification handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_batch_start_item(
+	     batch,
+	     item,
+	     verification_handle,
+	     &number_of_threads,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to start item.",
+		 function );
+
+		goto on_error;
+	}
+	result = verification_batch_open_item(
+	          batch,
+	          item,
+	          verification_handle,
+	          number_of_threads,
+	          &item_error );
+
+	if( result == 1 )
+	{
+		is_open = 1;
+
+		result = verification_handle_verify_input(
+		          verification_handle,
+		          0,
+		          NULL,
+		          &item_error );
+	}
+	if( result == -1 )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( ( libcnotify_verbose != 0 )
+		 && ( item_error != NULL ) )
+		{
+			libcnotify_print_error_backtrace(
+			 item_error );
+		}
+#endif
+		libcerror_error_free(
+		 &item_error );
+	}
+	if( verification_batch_stop_item(
+	     batch,
+	     item,
+	     verification_handle,
+	     result,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to stop item.",
+		 function );
+
+		goto on_error;
+	}
+	if( is_open != 0 )
+	{
+		is_open = 0;
+
+		if( verification_handle_close(
+		     verification_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close verification handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( verification_handle_free(
+	     &verification_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free verification handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( verification_handle != NULL )
+	{
+		item->verification_handle = NULL;
+
+		if( is_open != 0 )
+		{
+			verification_handle_close(
+			 verification_handle,
+			 NULL );
+		}
+		verification_handle_free(
+		 &verification_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Callback function to verify the image set of an item
+ * Returns 1 if successful or -1 on error
+ */
+int verification_batch_verify_item_callback(
+     verification_batch_item_t *item,
+     verification_batch_t *batch )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "verification_batch_verify_item_callback";
+
+	if( batch == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch.",
+		 function );
+
+		goto on_error;
+	}
+	if( item == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid item.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_batch_verify_item(
+	     batch,
+	     item,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to verify image set: %" PRIs_SYSTEM ".",
+		 function,
+		 item->filename );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( batch != NULL )
+	{
+		/* Stop verifying the remaining items, the batch cannot report their results reliably
+		 */
+		batch->abort = 1;
+	}
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Verifies the image sets of the batch
+ * The results are printed to the results stream per image set when its verification completes
+ * Returns 1 if all image sets were successfully verified, 0 if not or -1 on error
+ */
+int verification_batch_verify(
+     verification_batch_t *batch,
+     FILE *results_stream,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_batch_verify";
+	int item_index        = 0;
+
+	if( batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch.",
+		 function );
+
+		return( -1 );
+	}
+	batch->results_stream         = results_stream;
+	batch->number_of_queued_items = batch->number_of_items;
+	batch->number_of_active_items = 0;
+	batch->number_of_failed_items = 0;
+
+	if( results_stream != NULL )
+	{
+		fprintf(
+		 results_stream,
+		 "# status\tmedia_size\tchecksum_errors\tmd5\tstored_md5\tsha1\tsha256\tfilename\n" );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( ( batch->number_of_jobs > 1 )
+	 && ( batch->number_of_items > 1 ) )
+	{
+		if( libcthreads_thread_pool_create(
+		     &( batch->verify_thread_pool ),
+		     NULL,
+		     batch->number_of_jobs,
+		     batch->number_of_items,
+		     (int (*)(intptr_t *, void *)) &verification_batch_verify_item_callback,
+		     (void *) batch,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize verify thread pool.",
+			 function );
+
+			goto on_error;
+		}
+		for( item_index = 0;
+		     item_index < batch->number_of_items;
+		     item_index++ )
+		{
+			if( batch->abort != 0 )
+			{
+				break;
+			}
+			if( libcthreads_thread_pool_push(
+			     batch->verify_thread_pool,
+			     (intptr_t *) batch->items[ item_index ],
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push item: %d onto verify thread pool queue.",
+				 function,
+				 item_index );
+
+				goto on_error;
+			}
+		}
+		if( libcthreads_thread_pool_join(
+		     &( batch->verify_thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join verify thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else
+#endif
+	{
+		for( item_index = 0;
+		     item_index < batch->number_of_items;
+		     item_index++ )
+		{
+			if( batch->abort != 0 )
+			{
+				break;
+			}
+			if( verification_batch_verify_item(
+			     batch,
+			     batch->items[ item_index ],
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to verify image set: %" PRIs_SYSTEM ".",
+				 function,
+				 batch->items[ item_index ]->filename );
+
+				goto on_error;
+			}
+		}
+	}
+	if( ( batch->abort != 0 )
+	 || ( batch->number_of_failed_items != 0 ) )
+	{
+		return( 0 );
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( batch->verify_thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &( batch->verify_thread_pool ),
+		 NULL );
+	}
+#endif
+	return( -1 );
+}
+
@@ -0,0 +1,213 @@
+/*
+ * Batch verification of multiple image sets
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _VERIFICATION_BATCH_H )
+#define _VERIFICATION_BATCH_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "verification_handle.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The maximum size of a line in the manifest
+ */
+#define VERIFICATION_BATCH_MAXIMUM_LINE_SIZE		4096
+
+typedef struct verification_batch_item verification_batch_item_t;
+
+/* An image set listed in the manifest
+ */
+struct verification_batch_item
+{
+	/* The filename of the (first) segment file
+	 */
+	system_character_t *filename;
+
+	/* The verification handle, only set while the image set is being verified
+	 */
+	verification_handle_t *verification_handle;
+};
+
+typedef struct verification_batch verification_batch_t;
+
+/* The verification batch verifies the image sets of a manifest
+ * with a single pool of worker threads
+ */
+struct verification_batch
+{
+	/* The verification handle that contains the settings
+	 * used for every image set
+	 */
+	verification_handle_t *settings_handle;
+
+	/* The additional digest types
+	 */
+	const system_character_t *additional_digest_types;
+
+	/* Value to indicate if the chunk should be zeroed on error
+	 */
+	uint8_t zero_chunk_on_error;
+
+	/* The number of concurrent processing jobs (threads)
+	 */
+	int number_of_jobs;
+
+	/* The maximum number of (concurrent) open file handles of all image sets
+	 */
+	int maximum_number_of_open_handles;
+
+	/* The items
+	 */
+	verification_batch_item_t **items;
+
+	/* The number of items
+	 */
+	int number_of_items;
+
+	/* The number of allocated items
+	 */
+	int number_of_allocated_items;
+
+	/* The number of items that are queued to be verified
+	 */
+	int number_of_queued_items;
+
+	/* The number of items that are being verified
+	 */
+	int number_of_active_items;
+
+	/* The number of items that were not successfully verified
+	 */
+	int number_of_failed_items;
+
+	/* The results stream
+	 */
+	FILE *results_stream;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The verify thread pool
+	 */
+	libcthreads_thread_pool_t *verify_thread_pool;
+
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int verification_batch_item_initialize(
+     verification_batch_item_t **item,
+     const system_character_t *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
+
+int verification_batch_item_free(
+     verification_batch_item_t **item,
+     libcerror_error_t **error );
+
+int verification_batch_initialize(
+     verification_batch_t **batch,
+     verification_handle_t *settings_handle,
+     const system_character_t *additional_digest_types,
+     uint8_t zero_chunk_on_error,
+     libcerror_error_t **error );
+
+int verification_batch_free(
+     verification_batch_t **batch,
+     libcerror_error_t **error );
+
+int verification_batch_signal_abort(
+     verification_batch_t *batch,
+     libcerror_error_t **error );
+
+int verification_batch_append_item(
+     verification_batch_t *batch,
+     verification_batch_item_t *item,
+     libcerror_error_t **error );
+
+int verification_batch_read_manifest(
+     verification_batch_t *batch,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int verification_batch_start_item(
+     verification_batch_t *batch,
+     verification_batch_item_t *item,
+     verification_handle_t *verification_handle,
+     int *number_of_threads,
+     libcerror_error_t **error );
+
+int verification_batch_stop_item(
+     verification_batch_t *batch,
+     verification_batch_item_t *item,
+     verification_handle_t *verification_handle,
+     int result,
+     libcerror_error_t **error );
+
+int verification_batch_open_item(
+     verification_batch_t *batch,
+     verification_batch_item_t *item,
+     verification_handle_t *verification_handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int verification_batch_result_fprint(
+     verification_batch_t *batch,
+     verification_batch_item_t *item,
+     verification_handle_t *verification_handle,
+     int result,
+     libcerror_error_t **error );
+
+int verification_batch_verify_item(
+     verification_batch_t *batch,
+     verification_batch_item_t *item,
+     libcerror_error_t **error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int verification_batch_verify_item_callback(
+     verification_batch_item_t *item,
+     verification_batch_t *batch );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+int verification_batch_verify(
+     verification_batch_t *batch,
+     FILE *results_stream,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _VERIFICATION_BATCH_H ) */
+
@@ -275,6 +275,50 @@ int verification_handle_free(
 	}
 	if( *verification_handle != NULL )
 	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( ( *verification_handle )->storage_media_reader != NULL )
+		 && ( storage_media_reader_free(
+		       &( ( *verification_handle )->storage_media_reader ),
+		       error ) != 1 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free storage media reader.",
+			 function );
+
+			result = -1;
+		}
+		if( ( ( *verification_handle )->hash_tree_verifier != NULL )
+		 && ( hash_tree_verifier_free(
+		       &( ( *verification_handle )->hash_tree_verifier ),
+		       error ) != 1 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free hash tree verifier.",
+			 function );
+
+			result = -1;
+		}
+		if( ( ( *verification_handle )->segment_file_scanner != NULL )
+		 && ( segment_file_scanner_free(
+		       &( ( *verification_handle )->segment_file_scanner ),
+		       error ) != 1 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free segment file scanner.",
+			 function );
+
+			result = -1;
+		}
+#endif
 		if( ( ( *verification_handle )->input_handle != NULL )
 		 && ( libewf_handle_free(
 		       &( ( *verification_handle )->input_handle ),
@@ -411,6 +455,56 @@ int verification_handle_signal_abort(
 			return( -1 );
 		}
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->storage_media_reader != NULL )
+	{
+		if( storage_media_reader_signal_abort(
+		     verification_handle->storage_media_reader,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal storage media reader to abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( verification_handle->hash_tree_verifier != NULL )
+	{
+		if( hash_tree_verifier_signal_abort(
+		     verification_handle->hash_tree_verifier,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal hash tree verifier to abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( verification_handle->segment_file_scanner != NULL )
+	{
+		if( segment_file_scanner_signal_abort(
+		     verification_handle->segment_file_scanner,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal segment file scanner to abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
 	verification_handle->abort = 1;
 
 	return( 1 );
@@ -451,6 +545,8 @@ int verification_handle_set_maximum_number_of_open_handles(
 
 		return( -1 );
 	}
+	verification_handle->maximum_number_of_open_handles = maximum_number_of_open_handles;
+
 	return( 1 );
 }
 
@@ -467,6 +563,11 @@ int verification_handle_open_input(
 	static char *function                 = "verification_handle_open_input";
 	size_t first_filename_length          = 0;
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	int maximum_number_of_open_handles    = 0;
+	int number_of_additional_handles      = 0;
+#endif
+
 	if( verification_handle == NULL )
 	{
 		libcerror_error_set(
@@ -506,7 +607,7 @@ int verification_handle_open_input(
 		                         filenames[ 0 ] );
 
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-		if( libewf_glob_wide(
+		if( libewf_glob_directory_wide(
 		     filenames[ 0 ],
 		     first_filename_length,
 		     LIBEWF_FORMAT_UNKNOWN,
@@ -514,7 +615,7 @@ int verification_handle_open_input(
 		     &number_of_filenames,
 		     error ) != 1 )
 #else
-		if( libewf_glob(
+		if( libewf_glob_directory(
 		     filenames[ 0 ],
 		     first_filename_length,
 		     LIBEWF_FORMAT_UNKNOWN,
@@ -534,6 +635,48 @@ int verification_handle_open_input(
 		}
 		filenames = (system_character_t * const *) libewf_filenames;
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( ( ( verification_handle->verify_hash_tree != 0 )
+	  || ( verification_handle->check_chunks != 0 ) )
+	 && ( verification_handle->number_of_threads != 0 ) )
+	{
+		number_of_additional_handles = verification_handle->number_of_threads;
+	}
+	else if( verification_handle->number_of_threads != 0 )
+	{
+		number_of_additional_handles = verification_handle->number_of_readers;
+	}
+	if( number_of_additional_handles != 0 )
+	{
+		/* The input handle and reader, verifier or scanner handles share the open file handles limit
+		 */
+		maximum_number_of_open_handles = verification_handle->maximum_number_of_open_handles;
+
+		if( maximum_number_of_open_handles > 0 )
+		{
+			maximum_number_of_open_handles /= number_of_additional_handles + 1;
+
+			if( maximum_number_of_open_handles == 0 )
+			{
+				maximum_number_of_open_handles = 1;
+			}
+			if( libewf_handle_set_maximum_number_of_open_handles(
+			     verification_handle->input_handle,
+			     maximum_number_of_open_handles,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set maximum number of open handles in input handle.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+#endif
 	if( verification_handle->header_codepage != LIBEWF_CODEPAGE_ASCII )
 	{
 		if( libewf_handle_set_header_codepage(
@@ -576,6 +719,127 @@ int verification_handle_open_input(
 
 		goto on_error;
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( ( verification_handle->verify_hash_tree != 0 )
+	 && ( verification_handle->number_of_threads != 0 ) )
+	{
+		if( hash_tree_verifier_initialize(
+		     &( verification_handle->hash_tree_verifier ),
+		     verification_handle->number_of_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create hash tree verifier.",
+			 function );
+
+			goto on_error;
+		}
+		if( hash_tree_verifier_open(
+		     verification_handle->hash_tree_verifier,
+		     filenames,
+		     number_of_filenames,
+		     verification_handle->header_codepage,
+		     maximum_number_of_open_handles,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open hash tree verifier.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else if( ( verification_handle->check_chunks != 0 )
+	      && ( verification_handle->number_of_threads != 0 ) )
+	{
+		if( segment_file_scanner_initialize(
+		     &( verification_handle->segment_file_scanner ),
+		     verification_handle->number_of_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create segment file scanner.",
+			 function );
+
+			goto on_error;
+		}
+		if( segment_file_scanner_open(
+		     verification_handle->segment_file_scanner,
+		     filenames,
+		     number_of_filenames,
+		     verification_handle->header_codepage,
+		     maximum_number_of_open_handles,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open segment file scanner.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else if( ( verification_handle->number_of_threads != 0 )
+	      && ( verification_handle->number_of_readers != 0 ) )
+	{
+		if( storage_media_reader_initialize(
+		     &( verification_handle->storage_media_reader ),
+		     verification_handle->number_of_readers,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create storage media reader.",
+			 function );
+
+			goto on_error;
+		}
+		if( storage_media_reader_open(
+		     verification_handle->storage_media_reader,
+		     filenames,
+		     number_of_filenames,
+		     verification_handle->header_codepage,
+		     maximum_number_of_open_handles,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open storage media reader.",
+			 function );
+
+			goto on_error;
+		}
+		if( storage_media_reader_set_numa_node_affinity(
+		     verification_handle->storage_media_reader,
+		     verification_handle->numa_node_affinity,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set NUMA node affinity in storage media reader.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
 	if( libewf_filenames != NULL )
 	{
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -632,6 +896,26 @@ int verification_handle_open_input(
 	return( 1 );
 
 on_error:
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->storage_media_reader != NULL )
+	{
+		storage_media_reader_free(
+		 &( verification_handle->storage_media_reader ),
+		 NULL );
+	}
+	if( verification_handle->hash_tree_verifier != NULL )
+	{
+		hash_tree_verifier_free(
+		 &( verification_handle->hash_tree_verifier ),
+		 NULL );
+	}
+	if( verification_handle->segment_file_scanner != NULL )
+	{
+		segment_file_scanner_free(
+		 &( verification_handle->segment_file_scanner ),
+		 NULL );
+	}
+#endif
 	if( libewf_filenames != NULL )
 	{
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -670,6 +954,56 @@ int verification_handle_close(
 
 		return( -1 );
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->storage_media_reader != NULL )
+	{
+		if( storage_media_reader_close(
+		     verification_handle->storage_media_reader,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close storage media reader.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( verification_handle->hash_tree_verifier != NULL )
+	{
+		if( hash_tree_verifier_close(
+		     verification_handle->hash_tree_verifier,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close hash tree verifier.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( verification_handle->segment_file_scanner != NULL )
+	{
+		if( segment_file_scanner_close(
+		     verification_handle->segment_file_scanner,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close segment file scanner.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
 	if( libewf_handle_close(
 	     verification_handle->input_handle,
 	     error ) != 0 )
@@ -1606,6 +1940,7 @@ int verification_handle_verify_input(
 	int is_corrupted                             = 0;
 	int maximum_number_of_queued_items           = 0;
 	int md5_hash_compare                         = 0;
+	int number_of_free_lists                     = 1;
 	int sha1_hash_compare                        = 0;
 	int sha256_hash_compare                      = 0;
 	int status                                   = PROCESS_STATUS_COMPLETED;
@@ -1701,7 +2036,21 @@ int verification_handle_verify_input(
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 	if( verification_handle->number_of_threads != 0 )
 	{
-		maximum_number_of_queued_items = 1 + ( ( 512 * 1024 * 1024 ) / process_buffer_size );
+		if( storage_media_buffer_queue_get_maximum_number_of_values(
+		     verification_handle->number_of_threads,
+		     process_buffer_size,
+		     &maximum_number_of_queued_items,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine maximum number of queued items.",
+			 function );
+
+			goto on_error;
+		}
 
 		if( libcthreads_thread_pool_create(
 		     &( verification_handle->process_thread_pool ),
@@ -1752,10 +2101,17 @@ int verification_handle_verify_input(
 
 			goto on_error;
 		}
+		/* Every reader thread grabs its buffers from its own free list
+		 */
+		if( verification_handle->storage_media_reader != NULL )
+		{
+			number_of_free_lists = verification_handle->storage_media_reader->number_of_readers;
+		}
 		if( storage_media_buffer_queue_initialize(
 		     &( verification_handle->storage_media_buffer_queue ),
 		     verification_handle->input_handle,
 		     maximum_number_of_queued_items,
+		     number_of_free_lists,
 		     storage_media_buffer_mode,
 		     process_buffer_size,
 		     error ) != 1 )
@@ -1836,17 +2192,45 @@ int verification_handle_verify_input(
 	}
 	remaining_media_size = verification_handle->media_size;
 
-	while( remaining_media_size > 0 )
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( ( verification_handle->number_of_threads != 0 )
+	 && ( verification_handle->storage_media_reader != NULL ) )
 	{
-		if( verification_handle->abort != 0 )
+		if( storage_media_reader_start(
+		     verification_handle->storage_media_reader,
+		     verification_handle->storage_media_buffer_queue,
+		     verification_handle->process_thread_pool,
+		     0,
+		     verification_handle->media_size,
+		     process_buffer_size,
+		     error ) != 1 )
 		{
-			break;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to start storage media reader.",
+			 function );
+
+			goto on_error;
+		}
+		/* The reader threads read the storage media instead of the main thread
+		 */
+		remaining_media_size = 0;
+	}
+#endif
+	while( remaining_media_size > 0 )
+	{
+		if( verification_handle->abort != 0 )
+		{
+			break;
 		}
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 		if( verification_handle->number_of_threads != 0 )
 		{
 			if( storage_media_buffer_queue_grab_buffer(
 			     verification_handle->storage_media_buffer_queue,
+			     0,
 			     &storage_media_buffer,
 			     error ) != 1 )
 			{
@@ -2036,6 +2420,39 @@ int verification_handle_verify_input(
 		}
 	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( ( verification_handle->number_of_threads != 0 )
+	 && ( verification_handle->storage_media_reader != NULL ) )
+	{
+		if( storage_media_reader_join(
+		     verification_handle->storage_media_reader,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join storage media reader.",
+			 function );
+
+			goto on_error;
+		}
+		/* Checksum errors detected while reading are stored in the reader handles
+		 */
+		if( storage_media_reader_copy_checksum_errors(
+		     verification_handle->storage_media_reader,
+		     verification_handle->input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to copy checksum errors from storage media reader.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( verification_handle->process_thread_pool != NULL )
 	{
 		if( libcthreads_thread_pool_join(
@@ -2175,56 +2592,60 @@ int verification_handle_verify_input(
 	}
 	if( verification_handle->abort == 0 )
 	{
-		fprintf(
-		 verification_handle->notify_stream,
-		 "\n" );
-
-		if( verification_handle_checksum_errors_fprint(
-		     verification_handle,
-		     verification_handle->notify_stream,
-		     error ) != 1 )
+		/* The notify stream is not set when verifying in batch mode
+		 */
+		if( verification_handle->notify_stream != NULL )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-			 "%s: unable to print checksum errors.",
-			 function );
+			fprintf(
+			 verification_handle->notify_stream,
+			 "\n" );
 
-			goto on_error;
-		}
-		if( verification_handle_hash_values_fprint(
-		     verification_handle,
-		     verification_handle->notify_stream,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-			 "%s: unable to print hash values.",
-			 function );
+			if( verification_handle_checksum_errors_fprint(
+			     verification_handle,
+			     verification_handle->notify_stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print checksum errors.",
+				 function );
 
-			goto on_error;
-		}
-		if( verification_handle_additional_hash_values_fprint(
-		     verification_handle,
-		     verification_handle->notify_stream,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-			 "%s: unable to print additional hash values.",
-			 function );
+				goto on_error;
+			}
+			if( verification_handle_hash_values_fprint(
+			     verification_handle,
+			     verification_handle->notify_stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print hash values.",
+				 function );
 
-			goto on_error;
-		}
-		fprintf(
-		 verification_handle->notify_stream,
-		 "\n" );
+				goto on_error;
+			}
+			if( verification_handle_additional_hash_values_fprint(
+			     verification_handle,
+			     verification_handle->notify_stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print additional hash values.",
+				 function );
 
+				goto on_error;
+			}
+			fprintf(
+			 verification_handle->notify_stream,
+			 "\n" );
+		}
 		if( log_handle != NULL )
 		{
 			if( verification_handle_checksum_errors_fprint(
@@ -2324,67 +2745,855 @@ int verification_handle_verify_input(
 		                       verification_handle->calculated_sha256_hash_string,
 		                       65 );
 	}
-	/* Note that a set of EWF files can be verified without an integrity hash
-	 */
-	if( ( is_corrupted == 0 )
-	 && ( number_of_checksum_errors == 0 )
-	 && ( md5_hash_compare == 0 )
-	 && ( sha1_hash_compare == 0 )
-	 && ( sha256_hash_compare == 0 ) )
+	/* Note that a set of EWF files can be verified without an integrity hash
+	 */
+	if( ( is_corrupted == 0 )
+	 && ( number_of_checksum_errors == 0 )
+	 && ( md5_hash_compare == 0 )
+	 && ( sha1_hash_compare == 0 )
+	 && ( sha256_hash_compare == 0 ) )
+	{
+		return( 1 );
+	}
+	return( 0 );
+
+on_error:
+	if( ( verification_handle->number_of_threads == 0 )
+	 && ( storage_media_buffer != NULL ) )
+	{
+		storage_media_buffer_free(
+		 &storage_media_buffer,
+		 NULL );
+	}
+	if( verification_handle->process_status != NULL )
+	{
+		process_status_stop(
+		 verification_handle->process_status,
+		 verification_handle->last_offset_hashed,
+		 PROCESS_STATUS_FAILED,
+		 NULL );
+		process_status_free(
+		 &( verification_handle->process_status ),
+		 NULL );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->storage_media_reader != NULL )
+	{
+		storage_media_reader_signal_abort(
+		 verification_handle->storage_media_reader,
+		 NULL );
+		storage_media_reader_join(
+		 verification_handle->storage_media_reader,
+		 NULL );
+	}
+	if( verification_handle->process_thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &( verification_handle->process_thread_pool ),
+		 NULL );
+	}
+	if( verification_handle->output_thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &( verification_handle->output_thread_pool ),
+		 NULL );
+	}
+	if( verification_handle->output_list != NULL )
+	{
+		verification_handle_empty_output_list(
+		 verification_handle,
+		 NULL );
+		libcdata_list_free(
+		 &( verification_handle->output_list ),
+		 NULL,
+		 NULL );
+	}
+	if( verification_handle->storage_media_buffer_queue != NULL )
+	{
+		storage_media_buffer_queue_free(
+		 &( verification_handle->storage_media_buffer_queue ),
+		 NULL );
+	}
+#endif
+	return( -1 );
+}
+
+/* Verifies the input using the hash tree
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int verification_handle_verify_hash_tree(
+     verification_handle_t *verification_handle,
+     uint8_t print_status_information,
+     log_handle_t *log_handle,
+     libcerror_error_t **error )
+{
+	uint8_t *leaf_results          = NULL;
+	static char *function          = "verification_handle_verify_hash_tree";
+	off64_t range_offset           = 0;
+	off64_t verify_offset          = 0;
+	size64_t leaf_range_size       = 0;
+	size64_t range_size            = 0;
+	size64_t verify_size           = 0;
+	uint64_t first_leaf_index      = 0;
+	uint64_t leaf_index            = 0;
+	uint64_t number_of_leaves      = 0;
+	uint64_t number_of_tree_leaves = 0;
+	uint64_t number_of_mismatches  = 0;
+	int result                     = 0;
+	int status                     = PROCESS_STATUS_COMPLETED;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_get_media_size(
+	     verification_handle->input_handle,
+	     &( verification_handle->media_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		goto on_error;
+	}
+	result = libewf_handle_get_hash_tree_range_size(
+	          verification_handle->input_handle,
+	          &leaf_range_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve hash tree range size.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		result = libewf_handle_get_number_of_hash_tree_leaves(
+		          verification_handle->input_handle,
+		          &number_of_tree_leaves,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of hash tree leaves.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( ( result == 0 )
+	 || ( leaf_range_size == 0 ) )
+	{
+		if( verification_handle->notify_stream != NULL )
+		{
+			fprintf(
+			 verification_handle->notify_stream,
+			 "No hash tree available.\n\n" );
+		}
+		if( log_handle != NULL )
+		{
+			log_handle_printf(
+			 log_handle,
+			 "No hash tree available.\n" );
+		}
+		return( 0 );
+	}
+	if( verification_handle->hash_tree_range_size == 0 )
+	{
+		range_offset = 0;
+		range_size   = verification_handle->media_size;
+	}
+	else
+	{
+		range_offset = verification_handle->hash_tree_range_offset;
+		range_size   = verification_handle->hash_tree_range_size;
+
+		if( (size64_t) range_offset >= verification_handle->media_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid range offset value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		if( range_size > ( verification_handle->media_size - (size64_t) range_offset ) )
+		{
+			range_size = verification_handle->media_size - (size64_t) range_offset;
+		}
+	}
+	if( range_size > 0 )
+	{
+		first_leaf_index = (uint64_t) range_offset / leaf_range_size;
+		number_of_leaves = ( ( (uint64_t) range_offset + range_size - 1 ) / leaf_range_size ) + 1 - first_leaf_index;
+	}
+	if( ( first_leaf_index + number_of_leaves ) > number_of_tree_leaves )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: hash tree does not cover range.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_leaves > 0 )
+	{
+		verify_offset = (off64_t) ( first_leaf_index * leaf_range_size );
+		verify_size   = ( first_leaf_index + number_of_leaves ) * leaf_range_size;
+
+		if( verify_size > verification_handle->media_size )
+		{
+			verify_size = verification_handle->media_size;
+		}
+		verify_size -= (size64_t) verify_offset;
+
+		if( number_of_leaves > (uint64_t) SSIZE_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of leaves value exceeds maximum.",
+			 function );
+
+			goto on_error;
+		}
+		leaf_results = (uint8_t *) memory_allocate(
+		                            sizeof( uint8_t ) * (size_t) number_of_leaves );
+
+		if( leaf_results == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create leaf results.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     leaf_results,
+		     HASH_TREE_VERIFIER_LEAF_RESULT_UNVERIFIED,
+		     sizeof( uint8_t ) * (size_t) number_of_leaves ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear leaf results.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( process_status_initialize(
+	     &( verification_handle->process_status ),
+	     _SYSTEM_STRING( "Verify" ),
+	     _SYSTEM_STRING( "verified" ),
+	     _SYSTEM_STRING( "Read" ),
+	     verification_handle->notify_stream,
+	     print_status_information,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( process_status_start(
+	     verification_handle->process_status,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to start process status.",
+		 function );
+
+		goto on_error;
+	}
+	verification_handle->last_offset_hashed = 0;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( ( verification_handle->hash_tree_verifier != NULL )
+	 && ( number_of_leaves > 0 ) )
+	{
+		if( hash_tree_verifier_start(
+		     verification_handle->hash_tree_verifier,
+		     first_leaf_index,
+		     number_of_leaves,
+		     leaf_results,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to start hash tree verifier.",
+			 function );
+
+			goto on_error;
+		}
+		if( hash_tree_verifier_join(
+		     verification_handle->hash_tree_verifier,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join hash tree verifier.",
+			 function );
+
+			goto on_error;
+		}
+		if( verification_handle->abort == 0 )
+		{
+			verification_handle->last_offset_hashed = (off64_t) verify_size;
+		}
+	}
+	else
+#endif
+	{
+		for( leaf_index = 0;
+		     leaf_index < number_of_leaves;
+		     leaf_index++ )
+		{
+			if( verification_handle->abort != 0 )
+			{
+				break;
+			}
+			result = libewf_handle_verify_hash_tree_leaf(
+			          verification_handle->input_handle,
+			          first_leaf_index + leaf_index,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to verify hash tree leaf: %" PRIu64 ".",
+				 function,
+				 first_leaf_index + leaf_index );
+
+				goto on_error;
+			}
+			else if( result != 0 )
+			{
+				leaf_results[ leaf_index ] = HASH_TREE_VERIFIER_LEAF_RESULT_MATCH;
+			}
+			else
+			{
+				leaf_results[ leaf_index ] = HASH_TREE_VERIFIER_LEAF_RESULT_MISMATCH;
+			}
+			verification_handle->last_offset_hashed += (off64_t) leaf_range_size;
+
+			if( (size64_t) verification_handle->last_offset_hashed > verify_size )
+			{
+				verification_handle->last_offset_hashed = (off64_t) verify_size;
+			}
+			if( process_status_update(
+			     verification_handle->process_status,
+			     (size64_t) verification_handle->last_offset_hashed,
+			     verify_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update process status.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	if( verification_handle->abort != 0 )
+	{
+		status = PROCESS_STATUS_ABORTED;
+	}
+	if( process_status_stop(
+	     verification_handle->process_status,
+	     (size64_t) verification_handle->last_offset_hashed,
+	     status,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to stop process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( process_status_free(
+	     &( verification_handle->process_status ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free process status.",
+		 function );
+
+		goto on_error;
+	}
+	for( leaf_index = 0;
+	     leaf_index < number_of_leaves;
+	     leaf_index++ )
+	{
+		if( leaf_results[ leaf_index ] != HASH_TREE_VERIFIER_LEAF_RESULT_MATCH )
+		{
+			number_of_mismatches++;
+		}
+	}
+	if( verification_handle->abort == 0 )
+	{
+		if( verification_handle->notify_stream != NULL )
+		{
+			fprintf(
+			 verification_handle->notify_stream,
+			 "\n" );
+
+			if( verification_handle_hash_tree_results_fprint(
+			     verification_handle,
+			     first_leaf_index,
+			     number_of_leaves,
+			     leaf_results,
+			     leaf_range_size,
+			     verification_handle->notify_stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print hash tree results.",
+				 function );
+
+				goto on_error;
+			}
+			fprintf(
+			 verification_handle->notify_stream,
+			 "\n" );
+		}
+		if( log_handle != NULL )
+		{
+			if( verification_handle_hash_tree_results_fprint(
+			     verification_handle,
+			     first_leaf_index,
+			     number_of_leaves,
+			     leaf_results,
+			     leaf_range_size,
+			     log_handle->log_stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print hash tree results in log handle.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	if( leaf_results != NULL )
+	{
+		memory_free(
+		 leaf_results );
+	}
+	if( number_of_mismatches != 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+
+on_error:
+	if( verification_handle->process_status != NULL )
+	{
+		process_status_stop(
+		 verification_handle->process_status,
+		 (size64_t) verification_handle->last_offset_hashed,
+		 PROCESS_STATUS_FAILED,
+		 NULL );
+		process_status_free(
+		 &( verification_handle->process_status ),
+		 NULL );
+	}
+	if( leaf_results != NULL )
+	{
+		memory_free(
+		 leaf_results );
+	}
+	return( -1 );
+}
+
+/* Checks the chunks of the segment files of the input
+ * The segment files are checked independently, so that the chunks can be checked in any order
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int verification_handle_check_chunks(
+     verification_handle_t *verification_handle,
+     uint8_t print_status_information,
+     log_handle_t *log_handle,
+     libcerror_error_t **error )
+{
+	static char *function              = "verification_handle_check_chunks";
+	size64_t range_size                = 0;
+	off64_t range_offset               = 0;
+	uint32_t number_of_checksum_errors = 0;
+	uint32_t number_of_segment_files   = 0;
+	uint32_t segment_file_index        = 0;
+	int status                         = PROCESS_STATUS_COMPLETED;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	size64_t checked_size              = 0;
+#endif
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_get_media_size(
+	     verification_handle->input_handle,
+	     &( verification_handle->media_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_number_of_segment_files(
+	     verification_handle->input_handle,
+	     &number_of_segment_files,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segment files.",
+		 function );
+
+		goto on_error;
+	}
+	if( process_status_initialize(
+	     &( verification_handle->process_status ),
+	     _SYSTEM_STRING( "Check" ),
+	     _SYSTEM_STRING( "checked" ),
+	     _SYSTEM_STRING( "Read" ),
+	     verification_handle->notify_stream,
+	     print_status_information,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( process_status_start(
+	     verification_handle->process_status,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to start process status.",
+		 function );
+
+		goto on_error;
+	}
+	verification_handle->last_offset_hashed = 0;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( ( verification_handle->segment_file_scanner != NULL )
+	 && ( number_of_segment_files > 0 ) )
+	{
+		if( segment_file_scanner_start(
+		     verification_handle->segment_file_scanner,
+		     number_of_segment_files,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to start segment file scanner.",
+			 function );
+
+			goto on_error;
+		}
+		if( segment_file_scanner_join(
+		     verification_handle->segment_file_scanner,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join segment file scanner.",
+			 function );
+
+			goto on_error;
+		}
+		if( segment_file_scanner_get_checked_size(
+		     verification_handle->segment_file_scanner,
+		     &checked_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve checked size from segment file scanner.",
+			 function );
+
+			goto on_error;
+		}
+		/* The checksum errors are merged into the input handle
+		 * so that they are printed in order of the media data
+		 */
+		if( segment_file_scanner_append_checksum_errors(
+		     verification_handle->segment_file_scanner,
+		     verification_handle->input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append checksum errors of segment file scanner.",
+			 function );
+
+			goto on_error;
+		}
+		verification_handle->last_offset_hashed = (off64_t) checked_size;
+	}
+	else
+#endif
+	{
+		for( segment_file_index = 0;
+		     segment_file_index < number_of_segment_files;
+		     segment_file_index++ )
+		{
+			if( verification_handle->abort != 0 )
+			{
+				break;
+			}
+			if( libewf_handle_get_segment_file_media_range(
+			     verification_handle->input_handle,
+			     segment_file_index,
+			     &range_offset,
+			     &range_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve media range of segment file: %" PRIu32 ".",
+				 function,
+				 segment_file_index );
+
+				goto on_error;
+			}
+			if( libewf_handle_check_segment_file_chunks(
+			     verification_handle->input_handle,
+			     segment_file_index,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to check chunks of segment file: %" PRIu32 ".",
+				 function,
+				 segment_file_index );
+
+				goto on_error;
+			}
+			verification_handle->last_offset_hashed += (off64_t) range_size;
+
+			if( process_status_update(
+			     verification_handle->process_status,
+			     (size64_t) verification_handle->last_offset_hashed,
+			     verification_handle->media_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update process status.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	if( verification_handle->abort != 0 )
+	{
+		status = PROCESS_STATUS_ABORTED;
+	}
+	if( process_status_stop(
+	     verification_handle->process_status,
+	     (size64_t) verification_handle->last_offset_hashed,
+	     status,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to stop process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( process_status_free(
+	     &( verification_handle->process_status ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_number_of_checksum_errors(
+	     verification_handle->input_handle,
+	     &number_of_checksum_errors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of checksum errors.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle->abort == 0 )
+	{
+		if( verification_handle->notify_stream != NULL )
+		{
+			fprintf(
+			 verification_handle->notify_stream,
+			 "\n" );
+
+			if( verification_handle_checksum_errors_fprint(
+			     verification_handle,
+			     verification_handle->notify_stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print checksum errors.",
+				 function );
+
+				goto on_error;
+			}
+			fprintf(
+			 verification_handle->notify_stream,
+			 "\n" );
+		}
+		if( log_handle != NULL )
+		{
+			if( verification_handle_checksum_errors_fprint(
+			     verification_handle,
+			     log_handle->log_stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print checksum errors in log handle.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	if( number_of_checksum_errors != 0 )
 	{
-		return( 1 );
+		return( 0 );
 	}
-	return( 0 );
+	return( 1 );
 
 on_error:
-	if( ( verification_handle->number_of_threads == 0 )
-	 && ( storage_media_buffer != NULL ) )
-	{
-		storage_media_buffer_free(
-		 &storage_media_buffer,
-		 NULL );
-	}
 	if( verification_handle->process_status != NULL )
 	{
 		process_status_stop(
 		 verification_handle->process_status,
-		 verification_handle->last_offset_hashed,
+		 (size64_t) verification_handle->last_offset_hashed,
 		 PROCESS_STATUS_FAILED,
 		 NULL );
 		process_status_free(
 		 &( verification_handle->process_status ),
 		 NULL );
 	}
-#if defined( HAVE_MULTI_THREAD_SUPPORT )
-	if( verification_handle->process_thread_pool != NULL )
-	{
-		libcthreads_thread_pool_join(
-		 &( verification_handle->process_thread_pool ),
-		 NULL );
-	}
-	if( verification_handle->output_thread_pool != NULL )
-	{
-		libcthreads_thread_pool_join(
-		 &( verification_handle->output_thread_pool ),
-		 NULL );
-	}
-	if( verification_handle->output_list != NULL )
-	{
-		verification_handle_empty_output_list(
-		 verification_handle,
-		 NULL );
-		libcdata_list_free(
-		 &( verification_handle->output_list ),
-		 NULL,
-		 NULL );
-	}
-	if( verification_handle->storage_media_buffer_queue != NULL )
-	{
-		storage_media_buffer_queue_free(
-		 &( verification_handle->storage_media_buffer_queue ),
-		 NULL );
-	}
-#endif
 	return( -1 );
 }
 
@@ -3469,24 +4678,251 @@ int verification_handle_set_header_codepage(
 				 "%s: unable to set header codepage.",
 				 function );
 
-				return( -1 );
-			}
+				return( -1 );
+			}
+		}
+	}
+	return( result );
+}
+
+/* Sets the format
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int verification_handle_set_format(
+     verification_handle_t *verification_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_handle_set_format";
+	size_t string_length  = 0;
+	int result            = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( string_length == 3 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "raw" ),
+		     3 ) == 0 )
+		{
+			verification_handle->input_format = VERIFICATION_HANDLE_INPUT_FORMAT_RAW;
+			result                            = 1;
+		}
+	}
+	else if( string_length == 5 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "files" ),
+		     5 ) == 0 )
+		{
+			verification_handle->input_format = VERIFICATION_HANDLE_INPUT_FORMAT_FILES;
+			result                            = 1;
+		}
+	}
+	return( result );
+}
+
+/* Sets the process buffer size
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int verification_handle_set_process_buffer_size(
+     verification_handle_t *verification_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function  = "verification_handle_set_process_buffer_size";
+	size_t string_length   = 0;
+	uint64_t size_variable = 0;
+	int result             = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	result = byte_size_string_convert(
+	          string,
+	          string_length,
+	          &size_variable,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine process buffer size.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( size_variable > (uint64_t) SSIZE_MAX )
+		{
+			result = 0;
+		}
+		else
+		{
+			verification_handle->process_buffer_size = (size_t) size_variable;
+		}
+	}
+	return( result );
+}
+
+/* Sets the number of threads
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int verification_handle_set_number_of_threads(
+     verification_handle_t *verification_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function      = "verification_handle_set_number_of_threads";
+	size_t string_length       = 0;
+	uint64_t number_of_threads = 0;
+	int result                 = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( string[ 0 ] != (system_character_t) '-' )
+	{
+		string_length = system_string_length(
+				 string );
+
+		if( ewftools_system_string_decimal_copy_to_64_bit(
+		     string,
+		     string_length + 1,
+		     &number_of_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine number of threads.",
+			 function );
+
+			return( -1 );
+		}
+		result = 1;
+
+		if( number_of_threads > (uint64_t) EWFCOMMON_MAXIMUM_NUMBER_OF_THREADS )
+		{
+			result = 0;
+		}
+		else
+		{
+			verification_handle->number_of_threads = (int) number_of_threads;
+		}
+	}
+	return( result );
+}
+
+/* Sets the number of dedicated reader threads
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int verification_handle_set_number_of_readers(
+     verification_handle_t *verification_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function      = "verification_handle_set_number_of_readers";
+	size_t string_length       = 0;
+	uint64_t number_of_readers = 0;
+	int result                 = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string[ 0 ] != (system_character_t) '-' )
+	{
+		string_length = system_string_length(
+				 string );
+
+		if( ewftools_system_string_decimal_copy_to_64_bit(
+		     string,
+		     string_length + 1,
+		     &number_of_readers,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine number of readers.",
+			 function );
+
+			return( -1 );
+		}
+		result = 1;
+
+		if( number_of_readers > (uint64_t) EWFCOMMON_MAXIMUM_NUMBER_OF_READERS )
+		{
+			result = 0;
+		}
+		else
+		{
+			verification_handle->number_of_readers = (int) number_of_readers;
 		}
 	}
 	return( result );
 }
 
-/* Sets the format
- * Returns 1 if successful, 0 if unsupported value or -1 on error
+
+/* Sets the value to bind the reader threads to the NUMA nodes
+ * Returns 1 if successful or -1 on error
  */
-int verification_handle_set_format(
+int verification_handle_set_numa_node_affinity(
      verification_handle_t *verification_handle,
-     const system_character_t *string,
+     uint8_t numa_node_affinity,
      libcerror_error_t **error )
 {
-	static char *function = "verification_handle_set_format";
-	size_t string_length  = 0;
-	int result            = 0;
+	static char *function = "verification_handle_set_numa_node_affinity";
 
 	if( verification_handle == NULL )
 	{
@@ -3499,46 +4935,25 @@ int verification_handle_set_format(
 
 		return( -1 );
 	}
-	string_length = system_string_length(
-	                 string );
+	verification_handle->numa_node_affinity = numa_node_affinity;
 
-	if( string_length == 3 )
-	{
-		if( system_string_compare(
-		     string,
-		     _SYSTEM_STRING( "raw" ),
-		     3 ) == 0 )
-		{
-			verification_handle->input_format = VERIFICATION_HANDLE_INPUT_FORMAT_RAW;
-			result                            = 1;
-		}
-	}
-	else if( string_length == 5 )
-	{
-		if( system_string_compare(
-		     string,
-		     _SYSTEM_STRING( "files" ),
-		     5 ) == 0 )
-		{
-			verification_handle->input_format = VERIFICATION_HANDLE_INPUT_FORMAT_FILES;
-			result                            = 1;
-		}
-	}
-	return( result );
+	return( 1 );
 }
 
-/* Sets the process buffer size
+/* Sets the media data range of which the hash tree should be verified
+ * The range is either all or offset:size
  * Returns 1 if successful, 0 if unsupported value or -1 on error
  */
-int verification_handle_set_process_buffer_size(
+int verification_handle_set_hash_tree_range(
      verification_handle_t *verification_handle,
      const system_character_t *string,
      libcerror_error_t **error )
 {
-	static char *function  = "verification_handle_set_process_buffer_size";
+	static char *function  = "verification_handle_set_hash_tree_range";
+	size_t separator_index = 0;
 	size_t string_length   = 0;
-	uint64_t size_variable = 0;
-	int result             = 0;
+	uint64_t range_offset  = 0;
+	uint64_t range_size    = 0;
 
 	if( verification_handle == NULL )
 	{
@@ -3554,49 +4969,84 @@ int verification_handle_set_process_buffer_size(
 	string_length = system_string_length(
 	                 string );
 
-	result = byte_size_string_convert(
-	          string,
-	          string_length,
-	          &size_variable,
-	          error );
+	if( ( string_length == 3 )
+	 && ( system_string_compare(
+	       string,
+	       _SYSTEM_STRING( "all" ),
+	       3 ) == 0 ) )
+	{
+		verification_handle->verify_hash_tree       = 1;
+		verification_handle->hash_tree_range_offset = 0;
+		verification_handle->hash_tree_range_size   = 0;
 
-	if( result == -1 )
+		return( 1 );
+	}
+	for( separator_index = 0;
+	     separator_index < string_length;
+	     separator_index++ )
+	{
+		if( string[ separator_index ] == (system_character_t) ':' )
+		{
+			break;
+		}
+	}
+	if( ( separator_index == 0 )
+	 || ( separator_index >= ( string_length - 1 ) ) )
+	{
+		return( 0 );
+	}
+	if( byte_size_string_convert(
+	     string,
+	     separator_index,
+	     &range_offset,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine process buffer size.",
+		 "%s: unable to determine range offset.",
 		 function );
 
 		return( -1 );
 	}
-	else if( result != 0 )
+	if( byte_size_string_convert(
+	     &( string[ separator_index + 1 ] ),
+	     string_length - ( separator_index + 1 ),
+	     &range_size,
+	     error ) != 1 )
 	{
-		if( size_variable > (uint64_t) SSIZE_MAX )
-		{
-			result = 0;
-		}
-		else
-		{
-			verification_handle->process_buffer_size = (size_t) size_variable;
-		}
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine range size.",
+		 function );
+
+		return( -1 );
 	}
-	return( result );
+	if( ( range_offset > (uint64_t) INT64_MAX )
+	 || ( range_size == 0 )
+	 || ( range_size > (uint64_t) INT64_MAX ) )
+	{
+		return( 0 );
+	}
+	verification_handle->verify_hash_tree       = 1;
+	verification_handle->hash_tree_range_offset = (off64_t) range_offset;
+	verification_handle->hash_tree_range_size   = (size64_t) range_size;
+
+	return( 1 );
 }
 
-/* Sets the number of threads
- * Returns 1 if successful, 0 if unsupported value or -1 on error
+/* Sets the check chunks
+ * Returns 1 if successful or -1 on error
  */
-int verification_handle_set_number_of_threads(
+int verification_handle_set_check_chunks(
      verification_handle_t *verification_handle,
-     const system_character_t *string,
+     uint8_t check_chunks,
      libcerror_error_t **error )
 {
-	static char *function      = "verification_handle_set_number_of_threads";
-	size_t string_length       = 0;
-	uint64_t number_of_threads = 0;
-	int result                 = 0;
+	static char *function = "verification_handle_set_check_chunks";
 
 	if( verification_handle == NULL )
 	{
@@ -3604,46 +5054,14 @@ int verification_handle_set_number_of_threads(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid imaging handle.",
+		 "%s: invalid verification handle.",
 		 function );
 
 		return( -1 );
 	}
-	string_length = system_string_length(
-	                 string );
-
-	if( string[ 0 ] != (system_character_t) '-' )
-	{
-		string_length = system_string_length(
-				 string );
-
-		if( ewftools_system_string_decimal_copy_to_64_bit(
-		     string,
-		     string_length + 1,
-		     &number_of_threads,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine number of threads.",
-			 function );
+	verification_handle->check_chunks = check_chunks;
 
-			return( -1 );
-		}
-		result = 1;
-
-		if( number_of_threads > 32 )
-		{
-			result = 0;
-		}
-		else
-		{
-			verification_handle->number_of_threads = (int) number_of_threads;
-		}
-	}
-	return( result );
+	return( 1 );
 }
 
 /* Sets the additional digest types
@@ -3979,6 +5397,25 @@ int verification_handle_set_zero_chunk_on_error(
 
 		return( -1 );
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->storage_media_reader != NULL )
+	{
+		if( storage_media_reader_set_zero_chunk_on_error(
+		     verification_handle->storage_media_reader,
+		     zero_chunk_on_error,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set zero chunk on error in storage media reader.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
 	return( 1 );
 }
 
@@ -4337,6 +5774,176 @@ int verification_handle_additional_hash_values_fprint(
 	return( result );
 }
 
+/* Print the hash tree results to a stream
+ * Adjacent leaves that do not match are printed as a single range
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_hash_tree_results_fprint(
+     verification_handle_t *verification_handle,
+     uint64_t first_leaf_index,
+     uint64_t number_of_leaves,
+     const uint8_t *leaf_results,
+     size64_t leaf_range_size,
+     FILE *stream,
+     libcerror_error_t **error )
+{
+	uint8_t root_digest[ LIBHMAC_SHA256_HASH_SIZE ];
+	system_character_t root_digest_string[ 65 ];
+
+	static char *function         = "verification_handle_hash_tree_results_fprint";
+	size64_t mismatch_end_offset  = 0;
+	uint64_t leaf_index           = 0;
+	uint64_t mismatch_start_index = 0;
+	uint64_t number_of_mismatches = 0;
+	int result                    = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( leaf_results == NULL )
+	 && ( number_of_leaves > 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid leaf results.",
+		 function );
+
+		return( -1 );
+	}
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_handle_get_hash_tree_root_digest(
+	          verification_handle->input_handle,
+	          root_digest,
+	          LIBHMAC_SHA256_HASH_SIZE,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve hash tree root digest.",
+		 function );
+
+		return( -1 );
+	}
+	fprintf(
+	 stream,
+	 "Hash tree:\n" );
+
+	if( result != 0 )
+	{
+		if( digest_hash_copy_to_string(
+		     root_digest,
+		     LIBHMAC_SHA256_HASH_SIZE,
+		     root_digest_string,
+		     65,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set root digest string.",
+			 function );
+
+			return( -1 );
+		}
+		fprintf(
+		 stream,
+		 "\troot digest (SHA256):\t%" PRIs_SYSTEM "\n",
+		 root_digest_string );
+	}
+	fprintf(
+	 stream,
+	 "\tleaf range size:\t%" PRIu64 " bytes\n",
+	 leaf_range_size );
+
+	if( number_of_leaves > 0 )
+	{
+		fprintf(
+		 stream,
+		 "\tverified leaves:\t%" PRIu64 " - %" PRIu64 " (number: %" PRIu64 ")\n",
+		 first_leaf_index,
+		 first_leaf_index + number_of_leaves - 1,
+		 number_of_leaves );
+	}
+	for( leaf_index = 0;
+	     leaf_index < number_of_leaves;
+	     leaf_index++ )
+	{
+		if( leaf_results[ leaf_index ] != HASH_TREE_VERIFIER_LEAF_RESULT_MATCH )
+		{
+			number_of_mismatches++;
+		}
+	}
+	if( number_of_mismatches == 0 )
+	{
+		return( 1 );
+	}
+	fprintf(
+	 stream,
+	 "\nHash tree validation errors:\n" );
+	fprintf(
+	 stream,
+	 "\ttotal number of leaves: %" PRIu64 "\n",
+	 number_of_mismatches );
+
+	leaf_index = 0;
+
+	while( leaf_index < number_of_leaves )
+	{
+		if( leaf_results[ leaf_index ] == HASH_TREE_VERIFIER_LEAF_RESULT_MATCH )
+		{
+			leaf_index++;
+
+			continue;
+		}
+		mismatch_start_index = leaf_index;
+
+		while( ( leaf_index < number_of_leaves )
+		    && ( leaf_results[ leaf_index ] != HASH_TREE_VERIFIER_LEAF_RESULT_MATCH ) )
+		{
+			leaf_index++;
+		}
+		mismatch_end_offset = ( first_leaf_index + leaf_index ) * leaf_range_size;
+
+		if( mismatch_end_offset > verification_handle->media_size )
+		{
+			mismatch_end_offset = verification_handle->media_size;
+		}
+		fprintf(
+		 stream,
+		 "\tat offset(s): %" PRIu64 " - %" PRIu64 " (leaves: %" PRIu64 " - %" PRIu64 ")\n",
+		 ( first_leaf_index + mismatch_start_index ) * leaf_range_size,
+		 mismatch_end_offset - 1,
+		 first_leaf_index + mismatch_start_index,
+		 first_leaf_index + leaf_index - 1 );
+	}
+	return( 1 );
+}
+
 /* Print the checksum errors to a stream
  * Returns 1 if successful or -1 on error
  */
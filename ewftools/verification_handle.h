@@ -31,9 +31,13 @@
 #include "ewftools_libcthreads.h"
 #include "ewftools_libewf.h"
 #include "ewftools_libhmac.h"
+#include "hash_tree_verifier.h"
 #include "log_handle.h"
 #include "process_status.h"
+#include "segment_file_scanner.h"
 #include "storage_media_buffer.h"
+#include "storage_media_buffer_queue.h"
+#include "storage_media_reader.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -141,6 +145,36 @@ struct verification_handle
 	 */
 	int number_of_threads;
 
+	/* The number of dedicated reader threads
+	 */
+	int number_of_readers;
+
+	/* Value to indicate if the reader threads should be bound to the NUMA nodes
+	 */
+	uint8_t numa_node_affinity;
+
+	/* The maximum number of (concurrent) open file handles
+	 */
+	int maximum_number_of_open_handles;
+
+	/* Value to indicate if the hash tree should be verified instead of the digest hashes
+	 */
+	uint8_t verify_hash_tree;
+
+	/* The offset of the media data range of which the hash tree should be verified
+	 */
+	off64_t hash_tree_range_offset;
+
+	/* The size of the media data range of which the hash tree should be verified
+	 * where 0 represents the end of the media data
+	 */
+	size64_t hash_tree_range_size;
+
+	/* Value to indicate if the chunks of the segment files should be checked
+	 * instead of the digest hashes
+	 */
+	uint8_t check_chunks;
+
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 
 	/* The process thread pool
@@ -157,7 +191,19 @@ struct verification_handle
 
 	/* The storage media buffer queue
 	 */
-	libcthreads_queue_t *storage_media_buffer_queue;
+	storage_media_buffer_queue_t *storage_media_buffer_queue;
+
+	/* The storage media reader
+	 */
+	storage_media_reader_t *storage_media_reader;
+
+	/* The hash tree verifier
+	 */
+	hash_tree_verifier_t *hash_tree_verifier;
+
+	/* The segment file scanner
+	 */
+	segment_file_scanner_t *segment_file_scanner;
 
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
@@ -264,6 +310,18 @@ int verification_handle_verify_input(
      log_handle_t *log_handle,
      libcerror_error_t **error );
 
+int verification_handle_verify_hash_tree(
+     verification_handle_t *verification_handle,
+     uint8_t print_status_information,
+     log_handle_t *log_handle,
+     libcerror_error_t **error );
+
+int verification_handle_check_chunks(
+     verification_handle_t *verification_handle,
+     uint8_t print_status_information,
+     log_handle_t *log_handle,
+     libcerror_error_t **error );
+
 int verification_handle_verify_single_files(
      verification_handle_t *verification_handle,
      uint8_t print_status_information,
@@ -315,6 +373,26 @@ int verification_handle_set_number_of_threads(
      const system_character_t *string,
      libcerror_error_t **error );
 
+int verification_handle_set_number_of_readers(
+     verification_handle_t *verification_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int verification_handle_set_numa_node_affinity(
+     verification_handle_t *verification_handle,
+     uint8_t numa_node_affinity,
+     libcerror_error_t **error );
+
+int verification_handle_set_hash_tree_range(
+     verification_handle_t *verification_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int verification_handle_set_check_chunks(
+     verification_handle_t *verification_handle,
+     uint8_t check_chunks,
+     libcerror_error_t **error );
+
 int verification_handle_set_additional_digest_types(
      verification_handle_t *verification_handle,
      const system_character_t *string,
@@ -341,6 +419,15 @@ int verification_handle_additional_hash_values_fprint(
      FILE *stream,
      libcerror_error_t **error );
 
+int verification_handle_hash_tree_results_fprint(
+     verification_handle_t *verification_handle,
+     uint64_t first_leaf_index,
+     uint64_t number_of_leaves,
+     const uint8_t *leaf_results,
+     size64_t leaf_range_size,
+     FILE *stream,
+     libcerror_error_t **error );
+
 int verification_handle_checksum_errors_fprint(
      verification_handle_t *verification_handle,
      FILE *stream,
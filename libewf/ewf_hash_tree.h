@@ -0,0 +1,82 @@
+/*
+ * EWF hash tree section
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _EWF_HASH_TREE_H )
+#define _EWF_HASH_TREE_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The hash tree section consists of the header, followed by
+ * the leaf digests and a 4 byte checksum of the leaf digests
+ */
+typedef struct ewf_hash_tree_header ewf_hash_tree_header_t;
+
+struct ewf_hash_tree_header
+{
+	/* The format version
+	 * Consists of 4 bytes
+	 * Contains 1
+	 */
+	uint8_t format_version[ 4 ];
+
+	/* The digest type
+	 * Consists of 4 bytes
+	 * Contains 1 for SHA-256
+	 */
+	uint8_t digest_type[ 4 ];
+
+	/* The size of the media data range of a leaf
+	 * Consists of 8 bytes
+	 */
+	uint8_t range_size[ 8 ];
+
+	/* The media size
+	 * Consists of 8 bytes
+	 */
+	uint8_t media_size[ 8 ];
+
+	/* The number of leaves
+	 * Consists of 8 bytes
+	 */
+	uint8_t number_of_leaves[ 8 ];
+
+	/* The root digest
+	 * Consists of 32 bytes
+	 */
+	uint8_t root_digest[ 32 ];
+
+	/* The section checksum of all previous data
+	 * Consists of 4 bytes
+	 */
+	uint8_t checksum[ 4 ];
+};
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _EWF_HASH_TREE_H ) */
+
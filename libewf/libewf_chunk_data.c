@@ -33,6 +33,8 @@
 #include "libewf_libcnotify.h"
 #include "libewf_libfcache.h"
 #include "libewf_libfdata.h"
+#include "libewf_open_handles_budget.h"
+#include "libewf_statistics.h"
 #include "libewf_types.h"
 #include "libewf_unused.h"
 
@@ -553,14 +555,17 @@ ssize_t libewf_chunk_data_write_buffer(
 
 /* Packs the chunk data
  * This function either adds the checksum or compresses the chunk data
+ * The deflate encoder is optional and should not be shared between threads
  * Returns 1 if successful or -1 on error
  */
 int libewf_chunk_data_pack(
      libewf_chunk_data_t *chunk_data,
      libewf_io_handle_t *io_handle,
+     int8_t compression_level,
      const uint8_t *compressed_zero_byte_empty_block,
      size_t compressed_zero_byte_empty_block_size,
      uint8_t pack_flags,
+     libewf_deflate_encoder_t *deflate_encoder,
      libcerror_error_t **error )
 {
 	static char *function            = "libewf_chunk_data_pack";
@@ -695,7 +700,7 @@ int libewf_chunk_data_pack(
 	 */
 	chunk_data->range_flags = 0;
 
-	if( ( io_handle->compression_level != LIBEWF_COMPRESSION_NONE )
+	if( ( compression_level != LIBEWF_COMPRESSION_NONE )
 	 || ( ( pack_flags & LIBEWF_PACK_FLAG_FORCE_COMPRESSION ) != 0 ) )
 	{
 		if( ( pack_flags & LIBEWF_PACK_FLAG_FORCE_COMPRESSION ) == 0 )
@@ -802,9 +807,9 @@ int libewf_chunk_data_pack(
 		{
 			/* If compression was forced but no compression level provided use the default
 			 */
-			if( io_handle->compression_level == LIBEWF_COMPRESSION_NONE )
+			if( compression_level == LIBEWF_COMPRESSION_NONE )
 			{
-				io_handle->compression_level = LIBEWF_COMPRESSION_DEFAULT;
+				compression_level = LIBEWF_COMPRESSION_DEFAULT;
 			}
 			safe_compressed_data_size = chunk_data->compressed_data_size;
 
@@ -813,9 +818,10 @@ int libewf_chunk_data_pack(
 				  chunk_data->compressed_data,
 				  &safe_compressed_data_size,
 				  io_handle->compression_method,
-				  io_handle->compression_level,
+				  compression_level,
 				  chunk_data->data,
 				  chunk_data->data_size,
+				  deflate_encoder,
 				  error );
 
 			if( result == -1 )
@@ -1039,10 +1045,12 @@ on_error:
 int libewf_chunk_data_unpack(
      libewf_chunk_data_t *chunk_data,
      libewf_io_handle_t *io_handle,
+     libewf_statistics_t *statistics,
      libcerror_error_t **error )
 {
 	static char *function        = "libewf_chunk_data_unpack";
 	size_t remaining_chunk_size  = 0;
+	uint64_t start_time          = 0;
 	uint32_t calculated_checksum = 0;
 
 	if( chunk_data == NULL )
@@ -1201,6 +1209,22 @@ int libewf_chunk_data_unpack(
 			}
 			else
 			{
+				if( statistics != NULL )
+				{
+					if( libewf_statistics_get_current_time(
+					     &start_time,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+						 "%s: unable to retrieve start time.",
+						 function );
+
+						goto on_error;
+					}
+				}
 				if( libewf_decompress_data(
 				     chunk_data->compressed_data,
 				     chunk_data->compressed_data_size,
@@ -1233,6 +1257,24 @@ int libewf_chunk_data_unpack(
 					chunk_data->data_size    = (size_t) chunk_data->chunk_size;
 					chunk_data->range_flags |= LIBEWF_RANGE_FLAG_IS_CORRUPTED;
 				}
+				if( statistics != NULL )
+				{
+					if( libewf_statistics_add_event(
+					     statistics,
+					     LIBEWF_STATISTICS_TYPE_DECOMPRESS,
+					     start_time,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+						 "%s: unable to add decompress statistics event.",
+						 function );
+
+						goto on_error;
+					}
+				}
 			}
 		}
 		else if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_HAS_CHECKSUM ) != 0 )
@@ -1256,6 +1298,22 @@ int libewf_chunk_data_unpack(
 				 &( ( chunk_data->data )[ chunk_data->data_size ] ),
 				 chunk_data->checksum );
 			}
+			if( statistics != NULL )
+			{
+				if( libewf_statistics_get_current_time(
+				     &start_time,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve start time.",
+					 function );
+
+					goto on_error;
+				}
+			}
 			if( libewf_checksum_calculate_adler32(
 			     &calculated_checksum,
 			     chunk_data->data,
@@ -1272,6 +1330,24 @@ int libewf_chunk_data_unpack(
 
 				goto on_error;
 			}
+			if( statistics != NULL )
+			{
+				if( libewf_statistics_add_event(
+				     statistics,
+				     LIBEWF_STATISTICS_TYPE_CHECKSUM,
+				     start_time,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to add checksum statistics event.",
+					 function );
+
+					goto on_error;
+				}
+			}
 			if( chunk_data->checksum != calculated_checksum )
 			{
 				libcerror_error_set(
@@ -1891,6 +1967,21 @@ ssize_t libewf_chunk_data_read_from_file_io_pool(
 
 		return( -1 );
 	}
+	if( libewf_open_handles_access_file_io_pool_entry(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to account access of file IO pool entry: %d in open handles budget.",
+		 function,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
 	if( libbfio_pool_seek_offset(
 	     file_io_pool,
 	     file_io_pool_entry,
@@ -1935,6 +2026,497 @@ ssize_t libewf_chunk_data_read_from_file_io_pool(
 	return( read_count );
 }
 
+/* Reads chunk data from a file IO pool and unpacks it directly into a buffer
+ * The buffer must be able to contain the chunk size, the chunk data is not cached
+ * The compressed data buffer is used to read compressed chunk data into
+ * If the chunk data is corrupted LIBEWF_RANGE_FLAG_IS_CORRUPTED is set in the range flags
+ * Returns the number of bytes unpacked, 0 if the chunk data cannot be unpacked directly or -1 on error
+ */
+ssize_t libewf_chunk_data_read_buffer_from_file_io_pool(
+         libewf_io_handle_t *io_handle,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         off64_t chunk_data_offset,
+         size64_t chunk_data_size,
+         uint32_t chunk_data_flags,
+         uint8_t *compressed_data,
+         size_t compressed_data_size,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libewf_statistics_t *statistics,
+         uint32_t *range_flags,
+         libcerror_error_t **error )
+{
+	uint8_t checksum_data[ 4 ];
+
+	static char *function        = "libewf_chunk_data_read_buffer_from_file_io_pool";
+	size_t data_size             = 0;
+	size_t read_size             = 0;
+	size_t remaining_chunk_size  = 0;
+	ssize_t read_count           = 0;
+	uint64_t start_time          = 0;
+	uint32_t calculated_checksum = 0;
+	uint32_t stored_checksum     = 0;
+	int result                   = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_data_size == (size64_t) 0 )
+	 || ( chunk_data_size > (size64_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range flags.",
+		 function );
+
+		return( -1 );
+	}
+	*range_flags = chunk_data_flags & ~( LIBEWF_RANGE_FLAG_IS_CORRUPTED );
+
+	/* Sparse chunks and chunks that do not fit the buffers are read by means of the chunks cache
+	 */
+	if( ( chunk_data_flags & LIBEWF_RANGE_FLAG_IS_SPARSE ) != 0 )
+	{
+		return( 0 );
+	}
+	if( buffer_size < (size_t) io_handle->chunk_size )
+	{
+		return( 0 );
+	}
+	if( ( chunk_data_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) != 0 )
+	{
+		if( ( compressed_data == NULL )
+		 || ( chunk_data_size > (size64_t) compressed_data_size ) )
+		{
+			return( 0 );
+		}
+		read_size = (size_t) chunk_data_size;
+	}
+	else if( ( chunk_data_flags & LIBEWF_RANGE_FLAG_HAS_CHECKSUM ) != 0 )
+	{
+		if( chunk_data_size < 4 )
+		{
+			return( 0 );
+		}
+		data_size = (size_t) chunk_data_size - 4;
+
+		/* Chunk data that does not fill the chunk is read by means of the chunks cache
+		 */
+		if( data_size != (size_t) io_handle->chunk_size )
+		{
+			return( 0 );
+		}
+		/* The checksum is read separately so that it is not stored in the buffer
+		 */
+		read_size = data_size;
+	}
+	else
+	{
+		data_size = (size_t) chunk_data_size;
+
+		if( data_size != (size_t) io_handle->chunk_size )
+		{
+			return( 0 );
+		}
+		read_size = data_size;
+	}
+	if( statistics != NULL )
+	{
+		if( libewf_statistics_get_current_time(
+		     &start_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve start time.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libewf_open_handles_access_file_io_pool_entry(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to account access of file IO pool entry: %d in open handles budget.",
+		 function,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	if( libbfio_pool_seek_offset(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     chunk_data_offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 " in file IO pool entry: %d.",
+		 function,
+		 chunk_data_offset,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	if( ( chunk_data_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) != 0 )
+	{
+		read_count = libbfio_pool_read_buffer(
+			      file_io_pool,
+			      file_io_pool_entry,
+			      compressed_data,
+			      read_size,
+			      error );
+	}
+	else
+	{
+		read_count = libbfio_pool_read_buffer(
+			      file_io_pool,
+			      file_io_pool_entry,
+			      buffer,
+			      read_size,
+			      error );
+	}
+	if( read_count != (ssize_t) read_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( chunk_data_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) == 0 )
+	 && ( ( chunk_data_flags & LIBEWF_RANGE_FLAG_HAS_CHECKSUM ) != 0 ) )
+	{
+		read_count = libbfio_pool_read_buffer(
+			      file_io_pool,
+			      file_io_pool_entry,
+			      checksum_data,
+			      4,
+			      error );
+
+		if( read_count != (ssize_t) 4 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk checksum.",
+			 function );
+
+			return( -1 );
+		}
+		byte_stream_copy_to_uint32_little_endian(
+		 checksum_data,
+		 stored_checksum );
+	}
+	if( statistics != NULL )
+	{
+		if( libewf_statistics_add_event(
+		     statistics,
+		     LIBEWF_STATISTICS_TYPE_CHUNK_READ,
+		     start_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to add chunk statistics event.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( ( chunk_data_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) != 0 )
+	{
+		data_size = (size_t) io_handle->chunk_size;
+
+		if( ( chunk_data_flags & LIBEWF_RANGE_FLAG_USES_PATTERN_FILL ) != 0 )
+		{
+			if( read_size < 8 )
+			{
+				return( 0 );
+			}
+			remaining_chunk_size = data_size;
+
+			while( ( remaining_chunk_size % 8 ) != 0 )
+			{
+				remaining_chunk_size--;
+
+				buffer[ remaining_chunk_size ] = compressed_data[ remaining_chunk_size % 8 ];
+			}
+			while( remaining_chunk_size > 0 )
+			{
+				remaining_chunk_size -= 8;
+
+				if( memory_copy(
+				     &( buffer[ remaining_chunk_size ] ),
+				     compressed_data,
+				     8 ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy pattern fill to buffer.",
+					 function );
+
+					return( -1 );
+				}
+			}
+		}
+		else
+		{
+			if( statistics != NULL )
+			{
+				if( libewf_statistics_get_current_time(
+				     &start_time,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve start time.",
+					 function );
+
+					return( -1 );
+				}
+			}
+			result = libewf_decompress_data(
+			          compressed_data,
+			          read_size,
+			          io_handle->compression_method,
+			          buffer,
+			          &data_size,
+			          error );
+
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+				 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+				 "%s: unable to decompress chunk data.",
+				 function );
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					if( ( error != NULL )
+					 && ( *error != NULL ) )
+					{
+						libcnotify_print_error_backtrace(
+						 *error );
+					}
+				}
+#endif
+				libcerror_error_free(
+				 error );
+
+				/* Corrupted chunks are read by means of the chunks cache
+				 * to apply zero on error and track the checksum errors
+				 */
+				*range_flags |= LIBEWF_RANGE_FLAG_IS_CORRUPTED;
+
+				return( 0 );
+			}
+			if( statistics != NULL )
+			{
+				if( libewf_statistics_add_event(
+				     statistics,
+				     LIBEWF_STATISTICS_TYPE_DECOMPRESS,
+				     start_time,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to add decompress statistics event.",
+					 function );
+
+					return( -1 );
+				}
+			}
+			/* Chunk data that decompresses to less than the chunk size would
+			 * misplace the data of the chunks that follow it in the buffer
+			 */
+			if( data_size != (size_t) io_handle->chunk_size )
+			{
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_printf(
+					 "%s: decompressed chunk data size: %" PRIzd " does not match chunk size: %" PRIu32 ".\n",
+					 function,
+					 data_size,
+					 io_handle->chunk_size );
+				}
+#endif
+				*range_flags |= LIBEWF_RANGE_FLAG_IS_CORRUPTED;
+
+				return( 0 );
+			}
+		}
+	}
+	else if( ( chunk_data_flags & LIBEWF_RANGE_FLAG_HAS_CHECKSUM ) != 0 )
+	{
+		if( statistics != NULL )
+		{
+			if( libewf_statistics_get_current_time(
+			     &start_time,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve start time.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( libewf_checksum_calculate_adler32(
+		     &calculated_checksum,
+		     buffer,
+		     data_size,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to calculate checksum.",
+			 function );
+
+			return( -1 );
+		}
+		if( statistics != NULL )
+		{
+			if( libewf_statistics_add_event(
+			     statistics,
+			     LIBEWF_STATISTICS_TYPE_CHECKSUM,
+			     start_time,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to add checksum statistics event.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( stored_checksum != calculated_checksum )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_INPUT,
+			 LIBCERROR_INPUT_ERROR_CHECKSUM_MISMATCH,
+			 "%s: chunk data checksum does not match (stored: 0x%08" PRIx32 ", calculated: 0x%08" PRIx32 ").",
+			 function,
+			 stored_checksum,
+			 calculated_checksum );
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				if( ( error != NULL )
+				 && ( *error != NULL ) )
+				{
+					libcnotify_print_error_backtrace(
+					 *error );
+				}
+			}
+#endif
+			libcerror_error_free(
+			 error );
+
+			/* Corrupted chunks are read by means of the chunks cache
+			 * to apply zero on error and track the checksum errors
+			 */
+			*range_flags |= LIBEWF_RANGE_FLAG_IS_CORRUPTED;
+
+			return( 0 );
+		}
+	}
+	return( (ssize_t) data_size );
+}
+
 /* Reads chunk data
  * Callback function for the chunks list
  * Returns 1 if successful or -1 on error
@@ -25,11 +25,13 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_deflate.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcerror.h"
 #include "libewf_libfcache.h"
 #include "libewf_libfdata.h"
+#include "libewf_statistics.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -118,14 +120,17 @@ ssize_t libewf_chunk_data_write_buffer(
 int libewf_chunk_data_pack(
      libewf_chunk_data_t *chunk_data,
      libewf_io_handle_t *io_handle,
+     int8_t compression_level,
      const uint8_t *compressed_zero_byte_empty_block,
      size_t compressed_zero_byte_empty_block_size,
      uint8_t pack_flags,
+     libewf_deflate_encoder_t *deflate_encoder,
      libcerror_error_t **error );
 
 int libewf_chunk_data_unpack(
      libewf_chunk_data_t *chunk_data,
      libewf_io_handle_t *io_handle,
+     libewf_statistics_t *statistics,
      libcerror_error_t **error );
 
 int libewf_chunk_data_check_for_empty_block(
@@ -165,6 +170,21 @@ ssize_t libewf_chunk_data_read_from_file_io_pool(
          uint32_t chunk_data_flags,
          libcerror_error_t **error );
 
+ssize_t libewf_chunk_data_read_buffer_from_file_io_pool(
+         libewf_io_handle_t *io_handle,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         off64_t chunk_data_offset,
+         size64_t chunk_data_size,
+         uint32_t chunk_data_flags,
+         uint8_t *compressed_data,
+         size_t compressed_data_size,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libewf_statistics_t *statistics,
+         uint32_t *range_flags,
+         libcerror_error_t **error );
+
 int libewf_chunk_data_read_element_data(
      libewf_io_handle_t *io_handle,
      libbfio_pool_t *file_io_pool,
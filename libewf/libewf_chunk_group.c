@@ -121,6 +121,8 @@ int libewf_chunk_group_initialize(
 
 		goto on_error;
 	}
+	( *chunk_group )->is_uncached = 1;
+
 	return( 1 );
 
 on_error:
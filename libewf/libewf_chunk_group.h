@@ -41,6 +41,10 @@ struct libewf_chunk_group
 	/* The chunks list
 	 */
 	libfdata_list_t *chunks_list;
+
+	/* Value to indicate the chunk group was read but not yet retrieved from the chunk groups cache
+	 */
+	uint8_t is_uncached;
 };
 
 int libewf_chunk_group_initialize(
@@ -35,6 +35,7 @@
 #include "libewf_libfdata.h"
 #include "libewf_segment_file.h"
 #include "libewf_segment_table.h"
+#include "libewf_statistics.h"
 
 /* Creates a chunk table
  * Make sure the value chunk_table is referencing, is set to NULL
@@ -737,19 +738,154 @@ int libewf_chunk_table_chunk_exists_for_offset(
 	return( result );
 }
 
-/* Retrieves the chunk data of a chunk at a specific offset
- * Adds a checksum error if the data is corrupted
+/* Retrieves the data range of a chunk at a specific offset
+ * Returns 1 if successful, 0 if no such chunk or -1 on error
+ */
+int libewf_chunk_table_get_chunk_data_range_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     off64_t offset,
+     int *file_io_pool_entry,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *chunk_data_flags,
+     libcerror_error_t **error )
+{
+	libewf_chunk_group_t *chunk_group           = NULL;
+	libewf_segment_file_t *segment_file         = NULL;
+	libfdata_list_element_t *chunk_list_element = NULL;
+	static char *function                       = "libewf_chunk_table_get_chunk_data_range_by_offset";
+	off64_t chunk_group_data_offset             = 0;
+	off64_t element_data_offset                 = 0;
+	off64_t segment_file_data_offset            = 0;
+	uint32_t segment_number                     = 0;
+	int chunk_groups_list_index                 = 0;
+	int chunks_list_index                       = 0;
+	int result                                  = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_chunk_table_get_segment_file_chunk_group_by_offset(
+	          chunk_table,
+	          file_io_pool,
+	          segment_table,
+	          chunk_groups_cache,
+	          offset,
+	          &segment_number,
+	          &segment_file_data_offset,
+	          &segment_file,
+	          &chunk_groups_list_index,
+	          &chunk_group_data_offset,
+	          &chunk_group,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment file chunk group at 0x%08" PRIx64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	if( result != 0 )
+	{
+		if( chunk_group == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing chunk group: %d.",
+			 function,
+			 chunk_groups_list_index );
+
+			return( -1 );
+		}
+		result = libfdata_list_get_list_element_at_offset(
+			  chunk_group->chunks_list,
+			  chunk_group_data_offset,
+			  &chunks_list_index,
+			  &element_data_offset,
+			  &chunk_list_element,
+			  error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " from chunk group: %d in segment file: %" PRIu32 " at 0x%08" PRIx64 ".",
+			 function,
+			 chunk_index,
+			 chunk_groups_list_index,
+			 segment_number,
+			 segment_file_data_offset );
+
+			return( -1 );
+		}
+	}
+	if( result != 0 )
+	{
+		/* Only the start of a chunk has a data range that can be read directly
+		 */
+		if( element_data_offset != 0 )
+		{
+			return( 0 );
+		}
+		if( libfdata_list_get_element_by_index(
+		     chunk_group->chunks_list,
+		     chunks_list_index,
+		     file_io_pool_entry,
+		     chunk_data_offset,
+		     chunk_data_size,
+		     chunk_data_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " data range from chunk group: %d.",
+			 function,
+			 chunk_index,
+			 chunk_groups_list_index );
+
+			return( -1 );
+		}
+	}
+	return( result );
+}
+
+/* Retrieves the packed chunk data of a chunk at a specific offset
+ * The chunk data of a missing chunk is marked as corrupted
  * Returns 1 if successful or -1 on error
  */
-int libewf_chunk_table_get_chunk_data_by_offset(
+int libewf_chunk_table_get_packed_chunk_data_by_offset(
      libewf_chunk_table_t *chunk_table,
      uint64_t chunk_index,
-     libewf_io_handle_t *io_handle,
      libbfio_pool_t *file_io_pool,
      libewf_media_values_t *media_values,
      libewf_segment_table_t *segment_table,
      libfcache_cache_t *chunk_groups_cache,
      libfcache_cache_t *chunks_cache,
+     libewf_statistics_t *statistics,
      off64_t offset,
      libewf_chunk_data_t **chunk_data,
      off64_t *chunk_data_offset,
@@ -758,17 +894,17 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 	libewf_chunk_data_t *corrupted_chunk_data = NULL;
 	libewf_chunk_group_t *chunk_group         = NULL;
 	libewf_segment_file_t *segment_file       = NULL;
-	static char *function                     = "libewf_chunk_table_get_chunk_data_by_offset";
+	static char *function                     = "libewf_chunk_table_get_packed_chunk_data_by_offset";
 	off64_t chunk_offset                      = 0;
 	off64_t chunk_group_data_offset           = 0;
 	off64_t segment_file_data_offset          = 0;
 	size_t chunk_data_size                    = 0;
-	uint64_t start_sector                     = 0;
-	uint64_t number_of_sectors                = 0;
+	uint64_t start_time                       = 0;
 	uint32_t segment_number                   = 0;
 	int chunk_groups_list_index               = 0;
 	int chunks_list_index                     = 0;
 	int result                                = 0;
+	int statistics_type                       = 0;
 
 	if( chunk_table == NULL )
 	{
@@ -781,17 +917,6 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 
 		return( -1 );
 	}
-	if( io_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid IO handle.",
-		 function );
-
-		return( -1 );
-	}
 	if( media_values == NULL )
 	{
 		libcerror_error_set(
@@ -825,6 +950,22 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 
 		return( -1 );
 	}
+	if( statistics != NULL )
+	{
+		if( libewf_statistics_get_current_time(
+		     &start_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve start time.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	result = libewf_chunk_table_get_segment_file_chunk_group_by_offset(
 		  chunk_table,
 		  file_io_pool,
@@ -865,6 +1006,47 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 
 			goto on_error;
 		}
+		if( statistics != NULL )
+		{
+			if( chunk_group->is_uncached != 0 )
+			{
+				statistics_type = LIBEWF_STATISTICS_TYPE_CHUNK_GROUP_READ;
+			}
+			else
+			{
+				statistics_type = LIBEWF_STATISTICS_TYPE_CHUNK_GROUPS_CACHE_HIT;
+			}
+			if( libewf_statistics_add_event(
+			     statistics,
+			     statistics_type,
+			     start_time,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to add chunk group statistics event.",
+				 function );
+
+				goto on_error;
+			}
+			if( libewf_statistics_get_current_time(
+			     &start_time,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve start time.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		chunk_group->is_uncached = 0;
+
 		result = libfdata_list_get_element_value_at_offset(
 			  chunk_group->chunks_list,
 			  (intptr_t *) file_io_pool,
@@ -906,24 +1088,33 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 
 			goto on_error;
 		}
-		if( libewf_chunk_data_unpack(
-		     *chunk_data,
-		     io_handle,
-		     error ) != 1 )
+		if( statistics != NULL )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GENERIC,
-			 "%s: unable to unpack chunk: %" PRIu64 " data.",
-			 function,
-			 chunk_index );
-
-			goto on_error;
-		}
-		if( ( ( *chunk_data )->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
-		{
-			chunk_offset = offset - *chunk_data_offset;
+			/* Chunk data retrieved from the chunks cache has already been unpacked
+			 */
+			if( ( ( *chunk_data )->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ) != 0 )
+			{
+				statistics_type = LIBEWF_STATISTICS_TYPE_CHUNK_READ;
+			}
+			else
+			{
+				statistics_type = LIBEWF_STATISTICS_TYPE_CHUNKS_CACHE_HIT;
+			}
+			if( libewf_statistics_add_event(
+			     statistics,
+			     statistics_type,
+			     start_time,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to add chunk statistics event.",
+				 function );
+
+				goto on_error;
+			}
 		}
 	}
 	else
@@ -1000,10 +1191,85 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 		 */
 		corrupted_chunk_data = NULL;
 	}
-	if( ( ( *chunk_data )->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+	return( 1 );
+
+on_error:
+	if( corrupted_chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &corrupted_chunk_data,
+		 NULL );
+	}
+	*chunk_data = NULL;
+
+	return( -1 );
+}
+
+/* Checks the chunk data of a chunk
+ * Adds a checksum error if the data is corrupted
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_check_chunk_data(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libewf_media_values_t *media_values,
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error )
+{
+	static char *function      = "libewf_chunk_table_check_chunk_data";
+	off64_t chunk_offset       = 0;
+	uint64_t start_sector      = 0;
+	uint64_t number_of_sectors = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values->bytes_per_sector == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values - missing bytes per sector.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
 	{
 		/* Add checksum error
 		 */
+		chunk_offset      = (off64_t) chunk_index * media_values->chunk_size;
 		start_sector      = chunk_offset / media_values->bytes_per_sector;
 		number_of_sectors = media_values->sectors_per_chunk;
 
@@ -1027,18 +1293,114 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 			 "%s: unable to insert checksum error in range list.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
 	}
 	return( 1 );
+}
 
-on_error:
-	if( corrupted_chunk_data != NULL )
+/* Retrieves the chunk data of a chunk at a specific offset
+ * Adds a checksum error if the data is corrupted
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_get_chunk_data_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     libfcache_cache_t *chunks_cache,
+     off64_t offset,
+     libewf_chunk_data_t **chunk_data,
+     off64_t *chunk_data_offset,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_table_get_chunk_data_by_offset";
+
+	if( io_handle == NULL )
 	{
-		libewf_chunk_data_free(
-		 &corrupted_chunk_data,
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
 	}
+	if( libewf_chunk_table_get_packed_chunk_data_by_offset(
+	     chunk_table,
+	     chunk_index,
+	     file_io_pool,
+	     media_values,
+	     segment_table,
+	     chunk_groups_cache,
+	     chunks_cache,
+	     NULL,
+	     offset,
+	     chunk_data,
+	     chunk_data_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " packed data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	if( libewf_chunk_data_unpack(
+	     *chunk_data,
+	     io_handle,
+	     NULL,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to unpack chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	if( libewf_chunk_table_check_chunk_data(
+	     chunk_table,
+	     chunk_index,
+	     media_values,
+	     *chunk_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to check chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
 	*chunk_data = NULL;
 
 	return( -1 );
@@ -33,6 +33,7 @@
 #include "libewf_libfdata.h"
 #include "libewf_segment_file.h"
 #include "libewf_segment_table.h"
+#include "libewf_statistics.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -118,6 +119,40 @@ int libewf_chunk_table_chunk_exists_for_offset(
      off64_t offset,
      libcerror_error_t **error );
 
+int libewf_chunk_table_get_chunk_data_range_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     off64_t offset,
+     int *file_io_pool_entry,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *chunk_data_flags,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_get_packed_chunk_data_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     libfcache_cache_t *chunks_cache,
+     libewf_statistics_t *statistics,
+     off64_t offset,
+     libewf_chunk_data_t **chunk_data,
+     off64_t *chunk_data_offset,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_check_chunk_data(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libewf_media_values_t *media_values,
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error );
+
 int libewf_chunk_table_get_chunk_data_by_offset(
      libewf_chunk_table_t *chunk_table,
      uint64_t chunk_index,
@@ -41,6 +41,7 @@
 #include "libewf_libcnotify.h"
 
 /* Compresses data using the compression method
+ * The deflate encoder is optional and is used to reuse the state of the in-tree deflate encoder
  * Returns 1 on success, 0 if buffer is too small or -1 on error
  */
 int libewf_compress_data(
@@ -50,9 +51,11 @@ int libewf_compress_data(
      int8_t compression_level,
      const uint8_t *uncompressed_data,
      size_t uncompressed_data_size,
+     libewf_deflate_encoder_t *deflate_encoder,
      libcerror_error_t **error )
 {
 	static char *function                   = "libewf_compress_data";
+	uint8_t use_deflate_encoder             = 1;
 	int result                              = 0;
 
 #if defined( HAVE_LIBBZ2 ) || defined( BZIP2_DLL )
@@ -108,7 +111,39 @@ int libewf_compress_data(
 
 		return( -1 );
 	}
-	if( compression_method == LIBEWF_COMPRESSION_METHOD_DEFLATE )
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
+	/* If zlib is available it is only bypassed for fast compression
+	 */
+	if( compression_level != LIBEWF_COMPRESSION_FAST )
+	{
+		use_deflate_encoder = 0;
+	}
+#endif
+	if( ( compression_method == LIBEWF_COMPRESSION_METHOD_DEFLATE )
+	 && ( use_deflate_encoder != 0 ) )
+	{
+		result = libewf_deflate_compress(
+		          uncompressed_data,
+		          uncompressed_data_size,
+		          compressed_data,
+		          compressed_data_size,
+		          compression_level,
+		          deflate_encoder,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+			 "%s: unable to compress data.",
+			 function );
+
+			*compressed_data_size = 0;
+		}
+	}
+	else if( compression_method == LIBEWF_COMPRESSION_METHOD_DEFLATE )
 	{
 #if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
 		if( compression_level == LIBEWF_COMPRESSION_DEFAULT )
@@ -25,6 +25,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_deflate.h"
 #include "libewf_libcerror.h"
 
 #if defined( __cplusplus )
@@ -38,6 +39,7 @@ int libewf_compress_data(
      int8_t compression_level,
      const uint8_t *uncompressed_data,
      size_t uncompressed_data_size,
+     libewf_deflate_encoder_t *deflate_encoder,
      libcerror_error_t **error );
 
 int libewf_decompress_data(
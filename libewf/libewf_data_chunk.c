@@ -25,6 +25,7 @@
 
 #include "libewf_data_chunk.h"
 #include "libewf_definitions.h"
+#include "libewf_deflate.h"
 #include "libewf_io_handle.h"
 #include "libewf_libcerror.h"
 #include "libewf_libcthreads.h"
@@ -194,6 +195,22 @@ int libewf_data_chunk_free(
 
 			result = -1;
 		}
+		if( internal_data_chunk->deflate_encoder != NULL )
+		{
+			if( libewf_deflate_encoder_free(
+			     &( internal_data_chunk->deflate_encoder ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free deflate encoder.",
+				 function );
+
+				result = -1;
+			}
+		}
 		/* The io_handle and write_io_handle references are freed elsewhere
 		 */
 		memory_free(
@@ -308,6 +325,81 @@ on_error:
 	return( -1 );
 }
 
+/* Sets the compression level used when writing the data chunk
+ * This overrides the compression level of the IO handle for this data chunk
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_data_chunk_set_compression_level(
+     libewf_data_chunk_t *data_chunk,
+     int8_t compression_level,
+     libcerror_error_t **error )
+{
+	libewf_internal_data_chunk_t *internal_data_chunk = NULL;
+	static char *function                             = "libewf_data_chunk_set_compression_level";
+
+	if( data_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	internal_data_chunk = (libewf_internal_data_chunk_t *) data_chunk;
+
+	if( ( compression_level != LIBEWF_COMPRESSION_DEFAULT )
+	 && ( compression_level != LIBEWF_COMPRESSION_NONE )
+	 && ( compression_level != LIBEWF_COMPRESSION_FAST )
+	 && ( compression_level != LIBEWF_COMPRESSION_BEST ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported compression level.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_data_chunk->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_data_chunk->compression_level     = compression_level;
+	internal_data_chunk->has_compression_level = 1;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_data_chunk->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
 /* Reads a buffer from the data chunk
  * It applies decompression if necessary and validates the chunk checksum
  * This function should be used after libewf_handle_read_data_chunk
@@ -368,6 +460,7 @@ ssize_t libewf_data_chunk_read_buffer(
 		if( libewf_chunk_data_unpack(
 		     internal_data_chunk->chunk_data,
 		     internal_data_chunk->io_handle,
+		     NULL,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -439,6 +532,7 @@ ssize_t libewf_data_chunk_write_buffer(
 	libewf_internal_data_chunk_t *internal_data_chunk = NULL;
 	static char *function                             = "libewf_data_chunk_write_buffer";
 	ssize_t write_count                               = 0;
+	int8_t compression_level                          = 0;
 
 	if( data_chunk == NULL )
 	{
@@ -540,12 +634,42 @@ ssize_t libewf_data_chunk_write_buffer(
 	}
 	internal_data_chunk->data_size = buffer_size;
 
+	if( internal_data_chunk->has_compression_level != 0 )
+	{
+		compression_level = internal_data_chunk->compression_level;
+	}
+	else
+	{
+		compression_level = internal_data_chunk->io_handle->compression_level;
+	}
+	/* The deflate encoder state is kept with the data chunk so it can be reused
+	 * by the thread that writes the data chunk
+	 */
+	if( ( internal_data_chunk->io_handle->compression_method == LIBEWF_COMPRESSION_METHOD_DEFLATE )
+	 && ( internal_data_chunk->deflate_encoder == NULL ) )
+	{
+		if( libewf_deflate_encoder_initialize(
+		     &( internal_data_chunk->deflate_encoder ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create deflate encoder.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( libewf_chunk_data_pack(
 	     internal_data_chunk->chunk_data,
 	     internal_data_chunk->io_handle,
+	     compression_level,
 	     internal_data_chunk->write_io_handle->compressed_zero_byte_empty_block,
 	     internal_data_chunk->write_io_handle->compressed_zero_byte_empty_block_size,
 	     internal_data_chunk->write_io_handle->pack_flags,
+	     internal_data_chunk->deflate_encoder,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -26,6 +26,7 @@
 #include <types.h>
 
 #include "libewf_chunk_data.h"
+#include "libewf_deflate.h"
 #include "libewf_extern.h"
 #include "libewf_io_handle.h"
 #include "libewf_libcerror.h"
@@ -61,6 +62,19 @@ struct libewf_internal_data_chunk
 	 */
 	libewf_chunk_data_t *chunk_data;
 
+	/* The compression level
+	 */
+	int8_t compression_level;
+
+	/* Value to indicate the compression level of the data chunk
+	 * overrides that of the IO handle
+	 */
+	uint8_t has_compression_level;
+
+	/* The deflate encoder, used when the data chunk is packed
+	 */
+	libewf_deflate_encoder_t *deflate_encoder;
+
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	/* The read/write lock
 	 */
@@ -85,6 +99,12 @@ int libewf_internal_data_chunk_set_chunk_data(
      libewf_chunk_data_t *chunk_data,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_data_chunk_set_compression_level(
+     libewf_data_chunk_t *data_chunk,
+     int8_t compression_level,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 ssize_t libewf_data_chunk_read_buffer(
          libewf_data_chunk_t *data_chunk,
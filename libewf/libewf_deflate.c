@@ -24,6 +24,7 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libewf_definitions.h"
 #include "libewf_deflate.h"
 #include "libewf_libcerror.h"
 
@@ -98,7 +99,16 @@ int libewf_deflate_bit_stream_get_value(
 	}
 	*value_32bit = bit_stream->bit_buffer & ~( 0xffffffffUL << number_of_bits );
 
-	bit_stream->bit_buffer     >>= number_of_bits;
+	/* Shifting a 32-bit value by 32 bits is undefined
+	 */
+	if( number_of_bits < 32 )
+	{
+		bit_stream->bit_buffer >>= number_of_bits;
+	}
+	else
+	{
+		bit_stream->bit_buffer = 0;
+	}
 	bit_stream->bit_buffer_size -= number_of_bits;
 
 	return( 1 );
@@ -1656,3 +1666,2018 @@ int libewf_deflate_decompress(
 	return( 1 );
 }
 
+/* The base values of the length codes (257 - 285)
+ */
+static const uint16_t libewf_deflate_length_codes_base[ 29 ] = {
+	3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+	35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+
+static const uint8_t libewf_deflate_length_codes_number_of_extra_bits[ 29 ] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+	3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+
+/* The base values of the distance codes
+ */
+static const uint16_t libewf_deflate_distance_codes_base[ 30 ] = {
+	1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+	257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193,
+	12289, 16385, 24577 };
+
+static const uint8_t libewf_deflate_distance_codes_number_of_extra_bits[ 30 ] = {
+	0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+	7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+/* The order in which the code sizes of the code size alphabet are stored
+ */
+static const uint8_t libewf_deflate_code_sizes_sequence[ 19 ] = {
+	16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2,
+	14, 1, 15 };
+
+/* Writes a value to the output bit stream
+ * Returns 1 on success, 0 if the byte stream is too small or -1 on error
+ */
+int libewf_deflate_output_bit_stream_put_value(
+     libewf_deflate_output_bit_stream_t *bit_stream,
+     uint8_t number_of_bits,
+     uint32_t value_32bit,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_deflate_output_bit_stream_put_value";
+
+	if( bit_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bit stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_bits > (uint8_t) 32 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of bits value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_bits == 0 )
+	{
+		return( 1 );
+	}
+	if( number_of_bits < 32 )
+	{
+		value_32bit &= ( (uint32_t) 1UL << number_of_bits ) - 1;
+	}
+	bit_stream->bit_buffer      |= (uint64_t) value_32bit << bit_stream->bit_buffer_size;
+	bit_stream->bit_buffer_size += number_of_bits;
+
+	while( bit_stream->bit_buffer_size >= 8 )
+	{
+		if( bit_stream->byte_stream_offset >= bit_stream->byte_stream_size )
+		{
+			return( 0 );
+		}
+		bit_stream->byte_stream[ bit_stream->byte_stream_offset++ ] = (uint8_t) ( bit_stream->bit_buffer & 0xff );
+
+		bit_stream->bit_buffer     >>= 8;
+		bit_stream->bit_buffer_size -= 8;
+	}
+	return( 1 );
+}
+
+/* Writes the remaining bits in the bit buffer to the output bit stream
+ * the last byte is padded with 0-bits
+ * Returns 1 on success, 0 if the byte stream is too small or -1 on error
+ */
+int libewf_deflate_output_bit_stream_flush(
+     libewf_deflate_output_bit_stream_t *bit_stream,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_deflate_output_bit_stream_flush";
+
+	if( bit_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bit stream.",
+		 function );
+
+		return( -1 );
+	}
+	while( bit_stream->bit_buffer_size > 0 )
+	{
+		if( bit_stream->byte_stream_offset >= bit_stream->byte_stream_size )
+		{
+			return( 0 );
+		}
+		bit_stream->byte_stream[ bit_stream->byte_stream_offset++ ] = (uint8_t) ( bit_stream->bit_buffer & 0xff );
+
+		bit_stream->bit_buffer >>= 8;
+
+		if( bit_stream->bit_buffer_size < 8 )
+		{
+			bit_stream->bit_buffer_size = 0;
+		}
+		else
+		{
+			bit_stream->bit_buffer_size -= 8;
+		}
+	}
+	bit_stream->bit_buffer = 0;
+
+	return( 1 );
+}
+
+/* Calculates length-limited Huffman code sizes from symbol frequencies
+ * If less than 2 symbols are used 2 codes are created so that the resulting code is complete
+ * Returns 1 on success or -1 on error
+ */
+int libewf_deflate_calculate_huffman_code_sizes(
+     const uint32_t *frequencies,
+     int number_of_symbols,
+     uint8_t maximum_code_size,
+     uint8_t *code_sizes,
+     libcerror_error_t **error )
+{
+	uint32_t sort_counts[ 256 ];
+	uint32_t values[ 288 ];
+	uint16_t sorted_symbols[ 288 ];
+	uint16_t symbols[ 288 ];
+	int number_of_codes_per_size[ 16 ];
+
+	static char *function = "libewf_deflate_calculate_huffman_code_sizes";
+	uint32_t frequency    = 0;
+	uint32_t total        = 0;
+	int available         = 0;
+	int code_size         = 0;
+	int depth             = 0;
+	int leaf              = 0;
+	int next              = 0;
+	int number_of_codes   = 0;
+	int root              = 0;
+	int shift             = 0;
+	int symbol            = 0;
+	int symbol_index      = 0;
+	int used              = 0;
+
+	if( frequencies == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid frequencies.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_symbols < 2 )
+	 || ( number_of_symbols > 288 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of symbols value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_code_size == 0 )
+	 || ( maximum_code_size > 15 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum code size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( code_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid code sizes.",
+		 function );
+
+		return( -1 );
+	}
+	for( symbol = 0;
+	     symbol < number_of_symbols;
+	     symbol++ )
+	{
+		code_sizes[ symbol ] = 0;
+
+		if( frequencies[ symbol ] != 0 )
+		{
+			symbols[ number_of_codes++ ] = (uint16_t) symbol;
+		}
+	}
+	/* A complete code requires at least 2 codes
+	 */
+	for( symbol = 0;
+	     ( number_of_codes < 2 ) && ( symbol < number_of_symbols );
+	     symbol++ )
+	{
+		if( frequencies[ symbol ] == 0 )
+		{
+			symbols[ number_of_codes++ ] = (uint16_t) symbol;
+		}
+	}
+	/* Sort the symbols by frequency using a 2 pass radix sort on 16-bit frequencies
+	 */
+	for( shift = 0;
+	     shift < 16;
+	     shift += 8 )
+	{
+		if( memory_set(
+		     sort_counts,
+		     0,
+		     sizeof( uint32_t ) * 256 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear sort counts.",
+			 function );
+
+			return( -1 );
+		}
+		for( symbol_index = 0;
+		     symbol_index < number_of_codes;
+		     symbol_index++ )
+		{
+			frequency = frequencies[ symbols[ symbol_index ] ];
+
+			if( frequency > 0xffff )
+			{
+				frequency = 0xffff;
+			}
+			sort_counts[ ( frequency >> shift ) & 0xff ] += 1;
+		}
+		total = 0;
+
+		for( symbol = 0;
+		     symbol < 256;
+		     symbol++ )
+		{
+			frequency             = sort_counts[ symbol ];
+			sort_counts[ symbol ] = total;
+			total                += frequency;
+		}
+		for( symbol_index = 0;
+		     symbol_index < number_of_codes;
+		     symbol_index++ )
+		{
+			frequency = frequencies[ symbols[ symbol_index ] ];
+
+			if( frequency > 0xffff )
+			{
+				frequency = 0xffff;
+			}
+			sorted_symbols[ sort_counts[ ( frequency >> shift ) & 0xff ]++ ] = symbols[ symbol_index ];
+		}
+		if( memory_copy(
+		     symbols,
+		     sorted_symbols,
+		     sizeof( uint16_t ) * number_of_codes ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy sorted symbols.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( memory_set(
+	     values,
+	     0,
+	     sizeof( uint32_t ) * 288 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear values.",
+		 function );
+
+		return( -1 );
+	}
+	for( symbol_index = 0;
+	     symbol_index < number_of_codes;
+	     symbol_index++ )
+	{
+		values[ symbol_index ] = frequencies[ symbols[ symbol_index ] ];
+
+		if( values[ symbol_index ] == 0 )
+		{
+			values[ symbol_index ] = 1;
+		}
+	}
+	/* Determine the code sizes in-place using the algorithm of Moffat and Katajainen
+	 * first the parent of every internal node is determined, then the depth
+	 * of the internal nodes and last the depth of the leaves
+	 */
+	values[ 0 ] += values[ 1 ];
+
+	root = 0;
+	leaf = 2;
+
+	for( next = 1;
+	     next < ( number_of_codes - 1 );
+	     next++ )
+	{
+		if( ( leaf >= number_of_codes )
+		 || ( values[ root ] < values[ leaf ] ) )
+		{
+			values[ next ]   = values[ root ];
+			values[ root++ ] = (uint32_t) next;
+		}
+		else
+		{
+			values[ next ] = values[ leaf++ ];
+		}
+		if( ( leaf >= number_of_codes )
+		 || ( ( root < next )
+		  &&  ( values[ root ] < values[ leaf ] ) ) )
+		{
+			values[ next ]  += values[ root ];
+			values[ root++ ] = (uint32_t) next;
+		}
+		else
+		{
+			values[ next ] += values[ leaf++ ];
+		}
+	}
+	values[ number_of_codes - 2 ] = 0;
+
+	for( next = number_of_codes - 3;
+	     next >= 0;
+	     next-- )
+	{
+		values[ next ] = values[ values[ next ] ] + 1;
+	}
+	available = 1;
+	root      = number_of_codes - 2;
+	next      = number_of_codes - 1;
+
+	while( available > 0 )
+	{
+		while( ( root >= 0 )
+		    && ( values[ root ] == (uint32_t) depth ) )
+		{
+			used++;
+			root--;
+		}
+		while( available > used )
+		{
+			values[ next-- ] = (uint32_t) depth;
+
+			available--;
+		}
+		available = 2 * used;
+		used      = 0;
+
+		depth++;
+	}
+	/* Limit the code sizes to the maximum code size
+	 */
+	for( code_size = 0;
+	     code_size < 16;
+	     code_size++ )
+	{
+		number_of_codes_per_size[ code_size ] = 0;
+	}
+	for( symbol_index = 0;
+	     symbol_index < number_of_codes;
+	     symbol_index++ )
+	{
+		if( values[ symbol_index ] > (uint32_t) maximum_code_size )
+		{
+			number_of_codes_per_size[ maximum_code_size ] += 1;
+		}
+		else
+		{
+			number_of_codes_per_size[ values[ symbol_index ] ] += 1;
+		}
+	}
+	total = 0;
+
+	for( code_size = maximum_code_size;
+	     code_size > 0;
+	     code_size-- )
+	{
+		total += (uint32_t) number_of_codes_per_size[ code_size ] << ( maximum_code_size - code_size );
+	}
+	while( total != ( (uint32_t) 1UL << maximum_code_size ) )
+	{
+		number_of_codes_per_size[ maximum_code_size ] -= 1;
+
+		for( code_size = maximum_code_size - 1;
+		     code_size > 0;
+		     code_size-- )
+		{
+			if( number_of_codes_per_size[ code_size ] != 0 )
+			{
+				number_of_codes_per_size[ code_size ]     -= 1;
+				number_of_codes_per_size[ code_size + 1 ] += 2;
+
+				break;
+			}
+		}
+		total--;
+	}
+	/* The least frequent symbols are assigned the largest code sizes
+	 */
+	symbol_index = 0;
+
+	for( code_size = maximum_code_size;
+	     code_size > 0;
+	     code_size-- )
+	{
+		for( next = number_of_codes_per_size[ code_size ];
+		     next > 0;
+		     next-- )
+		{
+			code_sizes[ symbols[ symbol_index++ ] ] = (uint8_t) code_size;
+		}
+	}
+	return( 1 );
+}
+
+/* Calculates the canonical Huffman codes from the code sizes
+ * The codes are stored bit reversed since the bit stream is written least significant bit first
+ * Returns 1 on success or -1 on error
+ */
+int libewf_deflate_calculate_huffman_codes(
+     const uint8_t *code_sizes,
+     int number_of_symbols,
+     uint16_t *codes,
+     libcerror_error_t **error )
+{
+	int number_of_codes_per_size[ 16 ];
+	uint16_t next_codes[ 16 ];
+
+	static char *function = "libewf_deflate_calculate_huffman_codes";
+	uint16_t code         = 0;
+	uint16_t reversed_code = 0;
+	uint8_t bit_index     = 0;
+	int code_size         = 0;
+	int symbol            = 0;
+
+	if( code_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid code sizes.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_symbols < 0 )
+	 || ( number_of_symbols > 288 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of symbols value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( codes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid codes.",
+		 function );
+
+		return( -1 );
+	}
+	for( code_size = 0;
+	     code_size < 16;
+	     code_size++ )
+	{
+		number_of_codes_per_size[ code_size ] = 0;
+	}
+	for( symbol = 0;
+	     symbol < number_of_symbols;
+	     symbol++ )
+	{
+		if( code_sizes[ symbol ] > 15 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid code size: %d value out of bounds.",
+			 function,
+			 symbol );
+
+			return( -1 );
+		}
+		number_of_codes_per_size[ code_sizes[ symbol ] ] += 1;
+	}
+	number_of_codes_per_size[ 0 ] = 0;
+
+	for( code_size = 1;
+	     code_size < 16;
+	     code_size++ )
+	{
+		code = (uint16_t) ( ( code + number_of_codes_per_size[ code_size - 1 ] ) << 1 );
+
+		next_codes[ code_size ] = code;
+	}
+	for( symbol = 0;
+	     symbol < number_of_symbols;
+	     symbol++ )
+	{
+		code_size = code_sizes[ symbol ];
+
+		if( code_size == 0 )
+		{
+			codes[ symbol ] = 0;
+
+			continue;
+		}
+		code          = next_codes[ code_size ]++;
+		reversed_code = 0;
+
+		for( bit_index = 0;
+		     bit_index < (uint8_t) code_size;
+		     bit_index++ )
+		{
+			reversed_code = (uint16_t) ( ( reversed_code << 1 ) | ( code & 1 ) );
+			code        >>= 1;
+		}
+		codes[ symbol ] = reversed_code;
+	}
+	return( 1 );
+}
+
+/* Creates an encoder
+ * Make sure the value encoder is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_deflate_encoder_initialize(
+     libewf_deflate_encoder_t **encoder,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_deflate_encoder_initialize";
+	uint32_t distance     = 0;
+	uint16_t match_size   = 0;
+	uint16_t symbol       = 0;
+	uint8_t code          = 0;
+
+	if( encoder == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid encoder.",
+		 function );
+
+		return( -1 );
+	}
+	if( *encoder != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid encoder value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*encoder = memory_allocate_structure(
+	            libewf_deflate_encoder_t );
+
+	if( *encoder == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create encoder.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *encoder,
+	     0,
+	     sizeof( libewf_deflate_encoder_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear encoder.",
+		 function );
+
+		goto on_error;
+	}
+	/* A hash table value of 0 is below the position base and therefore unused
+	 */
+	( *encoder )->position_base = 1;
+
+	for( symbol = 0;
+	     symbol < 288;
+	     symbol++ )
+	{
+		if( symbol < 144 )
+		{
+			( *encoder )->fixed_literal_code_sizes[ symbol ] = 8;
+		}
+		else if( symbol < 256 )
+		{
+			( *encoder )->fixed_literal_code_sizes[ symbol ] = 9;
+		}
+		else if( symbol < 280 )
+		{
+			( *encoder )->fixed_literal_code_sizes[ symbol ] = 7;
+		}
+		else
+		{
+			( *encoder )->fixed_literal_code_sizes[ symbol ] = 8;
+		}
+	}
+	for( symbol = 0;
+	     symbol < 30;
+	     symbol++ )
+	{
+		( *encoder )->fixed_distance_code_sizes[ symbol ] = 5;
+	}
+	if( libewf_deflate_calculate_huffman_codes(
+	     ( *encoder )->fixed_literal_code_sizes,
+	     288,
+	     ( *encoder )->fixed_literal_codes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to calculate fixed Huffman literal codes.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_deflate_calculate_huffman_codes(
+	     ( *encoder )->fixed_distance_code_sizes,
+	     30,
+	     ( *encoder )->fixed_distance_codes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to calculate fixed Huffman distance codes.",
+		 function );
+
+		goto on_error;
+	}
+	/* The last match size of length code 284 (257 + 27) is 258
+	 * which is overwritten by length code 285 (257 + 28)
+	 */
+	for( code = 0;
+	     code < 29;
+	     code++ )
+	{
+		for( match_size = libewf_deflate_length_codes_base[ code ];
+		     match_size < libewf_deflate_length_codes_base[ code ] + ( 1 << libewf_deflate_length_codes_number_of_extra_bits[ code ] );
+		     match_size++ )
+		{
+			if( match_size > LIBEWF_DEFLATE_MAXIMUM_MATCH_SIZE )
+			{
+				break;
+			}
+			( *encoder )->length_codes[ match_size ] = code;
+		}
+	}
+	for( code = 0;
+	     code < 30;
+	     code++ )
+	{
+		for( distance = libewf_deflate_distance_codes_base[ code ];
+		     distance < (uint32_t) libewf_deflate_distance_codes_base[ code ] + ( 1UL << libewf_deflate_distance_codes_number_of_extra_bits[ code ] );
+		     distance++ )
+		{
+			if( distance <= 256 )
+			{
+				( *encoder )->distance_codes_lookup[ distance - 1 ] = code;
+			}
+			else
+			{
+				( *encoder )->distance_codes_lookup[ 256 + ( ( distance - 1 ) >> 7 ) ] = code;
+			}
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( *encoder != NULL )
+	{
+		memory_free(
+		 *encoder );
+
+		*encoder = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an encoder
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_deflate_encoder_free(
+     libewf_deflate_encoder_t **encoder,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_deflate_encoder_free";
+
+	if( encoder == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid encoder.",
+		 function );
+
+		return( -1 );
+	}
+	if( *encoder != NULL )
+	{
+		memory_free(
+		 *encoder );
+
+		*encoder = NULL;
+	}
+	return( 1 );
+}
+
+/* Writes the symbols of the current block and the end-of-block code to the output bit stream
+ * Returns 1 on success, 0 if the byte stream is too small or -1 on error
+ */
+int libewf_deflate_encoder_write_symbols(
+     libewf_deflate_encoder_t *encoder,
+     libewf_deflate_output_bit_stream_t *bit_stream,
+     const uint16_t *literal_codes,
+     const uint8_t *literal_code_sizes,
+     const uint16_t *distance_codes,
+     const uint8_t *distance_code_sizes,
+     libcerror_error_t **error )
+{
+	static char *function     = "libewf_deflate_encoder_write_symbols";
+	size_t byte_stream_offset = 0;
+	uint64_t bit_buffer       = 0;
+	uint16_t distance         = 0;
+	uint16_t value            = 0;
+	uint8_t bit_buffer_size   = 0;
+	uint8_t code              = 0;
+	uint8_t number_of_bits    = 0;
+	int symbol_index          = 0;
+
+	if( encoder == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid encoder.",
+		 function );
+
+		return( -1 );
+	}
+	if( bit_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bit stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( literal_codes == NULL )
+	 || ( literal_code_sizes == NULL )
+	 || ( distance_codes == NULL )
+	 || ( distance_code_sizes == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid Huffman codes.",
+		 function );
+
+		return( -1 );
+	}
+	/* The bit buffer is kept in local variables and written 32 bits at a time
+	 * a symbol adds at most 48 bits hence the bit buffer is written in between
+	 * the length and distance of a match
+	 */
+	bit_buffer         = bit_stream->bit_buffer;
+	bit_buffer_size    = bit_stream->bit_buffer_size;
+	byte_stream_offset = bit_stream->byte_stream_offset;
+
+	for( symbol_index = 0;
+	     symbol_index <= encoder->number_of_symbols;
+	     symbol_index++ )
+	{
+		if( symbol_index == encoder->number_of_symbols )
+		{
+			/* The end-of-block code
+			 */
+			value    = 256;
+			distance = 0;
+		}
+		else
+		{
+			value    = encoder->symbol_values[ symbol_index ];
+			distance = encoder->symbol_distances[ symbol_index ];
+		}
+		if( distance == 0 )
+		{
+			bit_buffer      |= (uint64_t) literal_codes[ value ] << bit_buffer_size;
+			bit_buffer_size += literal_code_sizes[ value ];
+		}
+		else
+		{
+			code = encoder->length_codes[ value ];
+
+			bit_buffer      |= (uint64_t) literal_codes[ 257 + code ] << bit_buffer_size;
+			bit_buffer_size += literal_code_sizes[ 257 + code ];
+
+			number_of_bits = libewf_deflate_length_codes_number_of_extra_bits[ code ];
+
+			if( number_of_bits > 0 )
+			{
+				bit_buffer      |= (uint64_t) ( value - libewf_deflate_length_codes_base[ code ] ) << bit_buffer_size;
+				bit_buffer_size += number_of_bits;
+			}
+			if( bit_buffer_size >= 32 )
+			{
+				if( ( byte_stream_offset + 4 ) > bit_stream->byte_stream_size )
+				{
+					return( 0 );
+				}
+				byte_stream_copy_from_uint32_little_endian(
+				 &( bit_stream->byte_stream[ byte_stream_offset ] ),
+				 (uint32_t) ( bit_buffer & 0xffffffffUL ) );
+
+				byte_stream_offset += 4;
+				bit_buffer        >>= 32;
+				bit_buffer_size    -= 32;
+			}
+			if( distance <= 256 )
+			{
+				code = encoder->distance_codes_lookup[ distance - 1 ];
+			}
+			else
+			{
+				code = encoder->distance_codes_lookup[ 256 + ( ( distance - 1 ) >> 7 ) ];
+			}
+			bit_buffer      |= (uint64_t) distance_codes[ code ] << bit_buffer_size;
+			bit_buffer_size += distance_code_sizes[ code ];
+
+			number_of_bits = libewf_deflate_distance_codes_number_of_extra_bits[ code ];
+
+			if( number_of_bits > 0 )
+			{
+				bit_buffer      |= (uint64_t) ( distance - libewf_deflate_distance_codes_base[ code ] ) << bit_buffer_size;
+				bit_buffer_size += number_of_bits;
+			}
+		}
+		if( bit_buffer_size >= 32 )
+		{
+			if( ( byte_stream_offset + 4 ) > bit_stream->byte_stream_size )
+			{
+				return( 0 );
+			}
+			byte_stream_copy_from_uint32_little_endian(
+			 &( bit_stream->byte_stream[ byte_stream_offset ] ),
+			 (uint32_t) ( bit_buffer & 0xffffffffUL ) );
+
+			byte_stream_offset += 4;
+			bit_buffer        >>= 32;
+			bit_buffer_size    -= 32;
+		}
+	}
+	bit_stream->bit_buffer         = bit_buffer;
+	bit_stream->bit_buffer_size    = bit_buffer_size;
+	bit_stream->byte_stream_offset = byte_stream_offset;
+
+	return( 1 );
+}
+
+/* Writes a block to the output bit stream
+ * The block is written as an uncompressed, fixed Huffman or dynamic Huffman block
+ * depending on which results in the smallest block
+ * A block without symbols is always written uncompressed
+ * Returns 1 on success, 0 if the byte stream is too small or -1 on error
+ */
+int libewf_deflate_encoder_write_block(
+     libewf_deflate_encoder_t *encoder,
+     libewf_deflate_output_bit_stream_t *bit_stream,
+     const uint8_t *uncompressed_data,
+     size_t block_offset,
+     size_t block_size,
+     uint8_t last_block_flag,
+     libcerror_error_t **error )
+{
+	uint8_t code_sizes[ 286 + 30 ];
+	uint8_t code_size_symbols[ 286 + 30 ];
+	uint8_t code_size_extra_values[ 286 + 30 ];
+	uint32_t code_size_frequencies[ 19 ];
+	uint16_t code_size_codes[ 19 ];
+	uint8_t code_size_code_sizes[ 19 ];
+
+	static char *function                = "libewf_deflate_encoder_write_block";
+	uint64_t dynamic_huffman_size        = 0;
+	uint64_t extra_bits_size             = 0;
+	uint64_t fixed_huffman_size          = 0;
+	uint64_t uncompressed_size           = 0;
+	uint8_t block_type                   = 0;
+	uint8_t code_size                    = 0;
+	uint8_t padding_size                 = 0;
+	int code_index                       = 0;
+	int number_of_code_size_codes        = 0;
+	int number_of_code_size_symbols      = 0;
+	int number_of_code_sizes             = 0;
+	int number_of_distance_codes         = 0;
+	int number_of_literal_codes          = 0;
+	int repeat_count                     = 0;
+	int result                           = 0;
+	int symbol                           = 0;
+
+	if( encoder == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid encoder.",
+		 function );
+
+		return( -1 );
+	}
+	if( bit_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bit stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_size > (size_t) UINT16_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid block size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	/* The size of an uncompressed block, including the bits needed to align to a byte
+	 */
+	padding_size      = (uint8_t) ( ( 8 - ( ( bit_stream->bit_buffer_size + 3 ) & 0x07 ) ) & 0x07 );
+	uncompressed_size = 3 + padding_size + 32 + ( (uint64_t) block_size * 8 );
+
+	if( ( encoder->number_of_symbols == 0 )
+	 && ( block_size > 0 ) )
+	{
+		block_type = LIBEWF_DEFLATE_BLOCK_TYPE_UNCOMPRESSED;
+	}
+	else
+	{
+		encoder->literal_frequencies[ 256 ] = 1;
+
+		for( code_index = 0;
+		     code_index < 29;
+		     code_index++ )
+		{
+			extra_bits_size += (uint64_t) encoder->literal_frequencies[ 257 + code_index ]
+			                 * libewf_deflate_length_codes_number_of_extra_bits[ code_index ];
+		}
+		for( code_index = 0;
+		     code_index < 30;
+		     code_index++ )
+		{
+			extra_bits_size += (uint64_t) encoder->distance_frequencies[ code_index ]
+			                 * libewf_deflate_distance_codes_number_of_extra_bits[ code_index ];
+		}
+		if( libewf_deflate_calculate_huffman_code_sizes(
+		     encoder->literal_frequencies,
+		     286,
+		     15,
+		     encoder->literal_code_sizes,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to calculate literal code sizes.",
+			 function );
+
+			return( -1 );
+		}
+		if( libewf_deflate_calculate_huffman_code_sizes(
+		     encoder->distance_frequencies,
+		     30,
+		     15,
+		     encoder->distance_code_sizes,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to calculate distance code sizes.",
+			 function );
+
+			return( -1 );
+		}
+		for( number_of_literal_codes = 286;
+		     number_of_literal_codes > 257;
+		     number_of_literal_codes-- )
+		{
+			if( encoder->literal_code_sizes[ number_of_literal_codes - 1 ] != 0 )
+			{
+				break;
+			}
+		}
+		for( number_of_distance_codes = 30;
+		     number_of_distance_codes > 1;
+		     number_of_distance_codes-- )
+		{
+			if( encoder->distance_code_sizes[ number_of_distance_codes - 1 ] != 0 )
+			{
+				break;
+			}
+		}
+		/* Run-length encode the literal and distance code sizes as one sequence
+		 */
+		if( memory_copy(
+		     code_sizes,
+		     encoder->literal_code_sizes,
+		     sizeof( uint8_t ) * number_of_literal_codes ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy literal code sizes.",
+			 function );
+
+			return( -1 );
+		}
+		if( memory_copy(
+		     &( code_sizes[ number_of_literal_codes ] ),
+		     encoder->distance_code_sizes,
+		     sizeof( uint8_t ) * number_of_distance_codes ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy distance code sizes.",
+			 function );
+
+			return( -1 );
+		}
+		number_of_code_sizes = number_of_literal_codes + number_of_distance_codes;
+
+		if( memory_set(
+		     code_size_frequencies,
+		     0,
+		     sizeof( uint32_t ) * 19 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear code size frequencies.",
+			 function );
+
+			return( -1 );
+		}
+		code_index = 0;
+
+		while( code_index < number_of_code_sizes )
+		{
+			code_size    = code_sizes[ code_index ];
+			repeat_count = 1;
+
+			while( ( ( code_index + repeat_count ) < number_of_code_sizes )
+			    && ( code_sizes[ code_index + repeat_count ] == code_size ) )
+			{
+				repeat_count++;
+			}
+			code_index += repeat_count;
+
+			if( code_size == 0 )
+			{
+				while( repeat_count >= 11 )
+				{
+					symbol = ( repeat_count > 138 ) ? 138 : repeat_count;
+
+					code_size_symbols[ number_of_code_size_symbols ]        = 18;
+					code_size_extra_values[ number_of_code_size_symbols++ ] = (uint8_t) ( symbol - 11 );
+
+					repeat_count -= symbol;
+				}
+				if( repeat_count >= 3 )
+				{
+					code_size_symbols[ number_of_code_size_symbols ]        = 17;
+					code_size_extra_values[ number_of_code_size_symbols++ ] = (uint8_t) ( repeat_count - 3 );
+
+					repeat_count = 0;
+				}
+			}
+			else
+			{
+				code_size_symbols[ number_of_code_size_symbols ]        = code_size;
+				code_size_extra_values[ number_of_code_size_symbols++ ] = 0;
+
+				repeat_count--;
+
+				while( repeat_count >= 3 )
+				{
+					symbol = ( repeat_count > 6 ) ? 6 : repeat_count;
+
+					code_size_symbols[ number_of_code_size_symbols ]        = 16;
+					code_size_extra_values[ number_of_code_size_symbols++ ] = (uint8_t) ( symbol - 3 );
+
+					repeat_count -= symbol;
+				}
+			}
+			while( repeat_count > 0 )
+			{
+				code_size_symbols[ number_of_code_size_symbols ]        = code_size;
+				code_size_extra_values[ number_of_code_size_symbols++ ] = 0;
+
+				repeat_count--;
+			}
+		}
+		for( code_index = 0;
+		     code_index < number_of_code_size_symbols;
+		     code_index++ )
+		{
+			code_size_frequencies[ code_size_symbols[ code_index ] ] += 1;
+		}
+		if( libewf_deflate_calculate_huffman_code_sizes(
+		     code_size_frequencies,
+		     19,
+		     7,
+		     code_size_code_sizes,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to calculate code size code sizes.",
+			 function );
+
+			return( -1 );
+		}
+		for( number_of_code_size_codes = 19;
+		     number_of_code_size_codes > 4;
+		     number_of_code_size_codes-- )
+		{
+			if( code_size_code_sizes[ libewf_deflate_code_sizes_sequence[ number_of_code_size_codes - 1 ] ] != 0 )
+			{
+				break;
+			}
+		}
+		/* Determine the size of the block in bits for the Huffman encoded block types
+		 */
+		dynamic_huffman_size = 3 + 5 + 5 + 4 + ( 3 * (uint64_t) number_of_code_size_codes ) + extra_bits_size
+		                     + ( 2 * (uint64_t) code_size_frequencies[ 16 ] )
+		                     + ( 3 * (uint64_t) code_size_frequencies[ 17 ] )
+		                     + ( 7 * (uint64_t) code_size_frequencies[ 18 ] );
+
+		fixed_huffman_size = 3 + extra_bits_size;
+
+		for( symbol = 0;
+		     symbol < 19;
+		     symbol++ )
+		{
+			dynamic_huffman_size += (uint64_t) code_size_frequencies[ symbol ] * code_size_code_sizes[ symbol ];
+		}
+		for( symbol = 0;
+		     symbol < 286;
+		     symbol++ )
+		{
+			dynamic_huffman_size += (uint64_t) encoder->literal_frequencies[ symbol ] * encoder->literal_code_sizes[ symbol ];
+			fixed_huffman_size   += (uint64_t) encoder->literal_frequencies[ symbol ] * encoder->fixed_literal_code_sizes[ symbol ];
+		}
+		for( symbol = 0;
+		     symbol < 30;
+		     symbol++ )
+		{
+			dynamic_huffman_size += (uint64_t) encoder->distance_frequencies[ symbol ] * encoder->distance_code_sizes[ symbol ];
+			fixed_huffman_size   += (uint64_t) encoder->distance_frequencies[ symbol ] * 5;
+		}
+		if( ( uncompressed_size <= fixed_huffman_size )
+		 && ( uncompressed_size <= dynamic_huffman_size ) )
+		{
+			block_type = LIBEWF_DEFLATE_BLOCK_TYPE_UNCOMPRESSED;
+		}
+		else if( fixed_huffman_size <= dynamic_huffman_size )
+		{
+			block_type = LIBEWF_DEFLATE_BLOCK_TYPE_HUFFMAN_FIXED;
+		}
+		else
+		{
+			block_type = LIBEWF_DEFLATE_BLOCK_TYPE_HUFFMAN_DYNAMIC;
+		}
+	}
+	result = libewf_deflate_output_bit_stream_put_value(
+	          bit_stream,
+	          3,
+	          (uint32_t) last_block_flag | ( (uint32_t) block_type << 1 ),
+	          error );
+
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	if( block_type == LIBEWF_DEFLATE_BLOCK_TYPE_UNCOMPRESSED )
+	{
+		result = libewf_deflate_output_bit_stream_flush(
+		          bit_stream,
+		          error );
+
+		if( result == 1 )
+		{
+			result = libewf_deflate_output_bit_stream_put_value(
+			          bit_stream,
+			          32,
+			          (uint32_t) block_size | ( ( (uint32_t) block_size ^ 0x0000ffffUL ) << 16 ),
+			          error );
+		}
+		if( result != 1 )
+		{
+			goto on_error;
+		}
+		if( block_size > ( bit_stream->byte_stream_size - bit_stream->byte_stream_offset ) )
+		{
+			return( 0 );
+		}
+		if( block_size > 0 )
+		{
+			if( memory_copy(
+			     &( bit_stream->byte_stream[ bit_stream->byte_stream_offset ] ),
+			     &( uncompressed_data[ block_offset ] ),
+			     block_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy uncompressed block data.",
+				 function );
+
+				return( -1 );
+			}
+			bit_stream->byte_stream_offset += block_size;
+		}
+		return( 1 );
+	}
+	if( block_type == LIBEWF_DEFLATE_BLOCK_TYPE_HUFFMAN_FIXED )
+	{
+		result = libewf_deflate_encoder_write_symbols(
+		          encoder,
+		          bit_stream,
+		          encoder->fixed_literal_codes,
+		          encoder->fixed_literal_code_sizes,
+		          encoder->fixed_distance_codes,
+		          encoder->fixed_distance_code_sizes,
+		          error );
+
+		if( result != 1 )
+		{
+			goto on_error;
+		}
+		return( 1 );
+	}
+	if( libewf_deflate_calculate_huffman_codes(
+	     encoder->literal_code_sizes,
+	     286,
+	     encoder->literal_codes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to calculate literal codes.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_deflate_calculate_huffman_codes(
+	     encoder->distance_code_sizes,
+	     30,
+	     encoder->distance_codes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to calculate distance codes.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_deflate_calculate_huffman_codes(
+	     code_size_code_sizes,
+	     19,
+	     code_size_codes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to calculate code size codes.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_deflate_output_bit_stream_put_value(
+	          bit_stream,
+	          14,
+	          (uint32_t) ( number_of_literal_codes - 257 )
+	          | ( (uint32_t) ( number_of_distance_codes - 1 ) << 5 )
+	          | ( (uint32_t) ( number_of_code_size_codes - 4 ) << 10 ),
+	          error );
+
+	for( code_index = 0;
+	     ( result == 1 ) && ( code_index < number_of_code_size_codes );
+	     code_index++ )
+	{
+		result = libewf_deflate_output_bit_stream_put_value(
+		          bit_stream,
+		          3,
+		          (uint32_t) code_size_code_sizes[ libewf_deflate_code_sizes_sequence[ code_index ] ],
+		          error );
+	}
+	for( code_index = 0;
+	     ( result == 1 ) && ( code_index < number_of_code_size_symbols );
+	     code_index++ )
+	{
+		symbol = code_size_symbols[ code_index ];
+
+		result = libewf_deflate_output_bit_stream_put_value(
+		          bit_stream,
+		          code_size_code_sizes[ symbol ],
+		          (uint32_t) code_size_codes[ symbol ],
+		          error );
+
+		if( ( result == 1 )
+		 && ( symbol >= 16 ) )
+		{
+			if( symbol == 16 )
+			{
+				code_size = 2;
+			}
+			else if( symbol == 17 )
+			{
+				code_size = 3;
+			}
+			else
+			{
+				code_size = 7;
+			}
+			result = libewf_deflate_output_bit_stream_put_value(
+			          bit_stream,
+			          code_size,
+			          (uint32_t) code_size_extra_values[ code_index ],
+			          error );
+		}
+	}
+	if( result == 1 )
+	{
+		result = libewf_deflate_encoder_write_symbols(
+		          encoder,
+		          bit_stream,
+		          encoder->literal_codes,
+		          encoder->literal_code_sizes,
+		          encoder->distance_codes,
+		          encoder->distance_code_sizes,
+		          error );
+	}
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to write block.",
+		 function );
+	}
+	return( result );
+}
+
+/* Compresses data using deflate and stores it as a zlib stream
+ * Returns 1 on success, 0 if compressed data is too small or -1 on error
+ */
+int libewf_deflate_encoder_compress(
+     libewf_deflate_encoder_t *encoder,
+     const uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     uint8_t *compressed_data,
+     size_t *compressed_data_size,
+     int8_t compression_level,
+     libcerror_error_t **error )
+{
+	libewf_deflate_output_bit_stream_t bit_stream;
+
+	static char *function              = "libewf_deflate_encoder_compress";
+	size_t block_offset                = 0;
+	size_t candidate_offset            = 0;
+	size_t data_offset                 = 0;
+	size_t insert_offset               = 0;
+	size_t maximum_match_size          = 0;
+	size_t safe_compressed_data_size   = 0;
+	uint64_t candidate_value_64bit     = 0;
+	uint64_t value_64bit               = 0;
+	uint32_t calculated_checksum       = 0;
+	uint32_t distance                  = 0;
+	uint32_t hash_value                = 0;
+	uint32_t position_base             = 0;
+	uint32_t previous_position         = 0;
+	uint16_t chain_distance            = 0;
+	uint16_t match_distance            = 0;
+	uint16_t match_size                = 0;
+	uint16_t maximum_insert_match_size = 0;
+	uint16_t nice_match_size           = 0;
+	uint16_t size                      = 0;
+	uint8_t compression_flags          = 0;
+	uint8_t last_block_flag            = 0;
+	int chain_size                     = 0;
+	int maximum_chain_size             = 0;
+	int result                         = 0;
+
+	if( encoder == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid encoder.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data_size > (size_t) INT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid uncompressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data size.",
+		 function );
+
+		return( -1 );
+	}
+	safe_compressed_data_size = *compressed_data_size;
+
+	if( safe_compressed_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid compressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	switch( compression_level )
+	{
+		case LIBEWF_COMPRESSION_NONE:
+			compression_flags = 0x01;
+			break;
+
+		case LIBEWF_COMPRESSION_FAST:
+			maximum_chain_size        = 4;
+			nice_match_size           = 32;
+			maximum_insert_match_size = 8;
+			compression_flags         = 0x01;
+			break;
+
+		case LIBEWF_COMPRESSION_DEFAULT:
+			maximum_chain_size        = 64;
+			nice_match_size           = 128;
+			maximum_insert_match_size = LIBEWF_DEFLATE_MAXIMUM_MATCH_SIZE;
+			compression_flags         = 0x9c;
+			break;
+
+		case LIBEWF_COMPRESSION_BEST:
+			maximum_chain_size        = 1024;
+			nice_match_size           = LIBEWF_DEFLATE_MAXIMUM_MATCH_SIZE;
+			maximum_insert_match_size = LIBEWF_DEFLATE_MAXIMUM_MATCH_SIZE;
+			compression_flags         = 0xda;
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported compression level.",
+			 function );
+
+			return( -1 );
+	}
+	/* The hash table is only cleared when the positions of this compression
+	 * do not fit after the position base, otherwise the values of a previous
+	 * compression are below the position base and ignored
+	 */
+	if( ( (uint64_t) encoder->position_base + uncompressed_data_size + 1 ) > (uint64_t) UINT32_MAX )
+	{
+		if( memory_set(
+		     encoder->hash_table,
+		     0,
+		     sizeof( uint32_t ) * LIBEWF_DEFLATE_HASH_TABLE_SIZE ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear hash table.",
+			 function );
+
+			return( -1 );
+		}
+		encoder->position_base = 1;
+	}
+	position_base          = encoder->position_base;
+	encoder->position_base = position_base + (uint32_t) uncompressed_data_size + 1;
+
+	bit_stream.byte_stream        = compressed_data;
+	bit_stream.byte_stream_size   = safe_compressed_data_size;
+	bit_stream.byte_stream_offset = 0;
+	bit_stream.bit_buffer         = 0;
+	bit_stream.bit_buffer_size    = 0;
+
+	/* Write the zlib header: deflate with a 32 KiB window
+	 */
+	result = libewf_deflate_output_bit_stream_put_value(
+	          &bit_stream,
+	          16,
+	          0x78 | ( (uint32_t) compression_flags << 8 ),
+	          error );
+
+	while( ( result == 1 )
+	    && ( last_block_flag == 0 ) )
+	{
+		block_offset = data_offset;
+
+		if( memory_set(
+		     encoder->literal_frequencies,
+		     0,
+		     sizeof( uint32_t ) * 288 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear literal frequencies.",
+			 function );
+
+			return( -1 );
+		}
+		if( memory_set(
+		     encoder->distance_frequencies,
+		     0,
+		     sizeof( uint32_t ) * 30 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear distance frequencies.",
+			 function );
+
+			return( -1 );
+		}
+		encoder->number_of_symbols = 0;
+
+		if( compression_level == LIBEWF_COMPRESSION_NONE )
+		{
+			data_offset += LIBEWF_DEFLATE_MAXIMUM_BLOCK_SIZE;
+
+			if( data_offset > uncompressed_data_size )
+			{
+				data_offset = uncompressed_data_size;
+			}
+		}
+		while( ( compression_level != LIBEWF_COMPRESSION_NONE )
+		    && ( data_offset < uncompressed_data_size )
+		    && ( ( data_offset - block_offset ) < LIBEWF_DEFLATE_MAXIMUM_BLOCK_SIZE ) )
+		{
+			match_size = 0;
+
+			if( ( uncompressed_data_size - data_offset ) >= LIBEWF_DEFLATE_MINIMUM_MATCH_SIZE )
+			{
+				/* Find the longest match in the hash chain of the next 3 bytes
+				 */
+				hash_value = ( (uint32_t) uncompressed_data[ data_offset ]
+				           | ( (uint32_t) uncompressed_data[ data_offset + 1 ] << 8 )
+				           | ( (uint32_t) uncompressed_data[ data_offset + 2 ] << 16 ) ) * 0x9e3779b1UL;
+				hash_value = ( hash_value & 0xffffffffUL ) >> ( 32 - LIBEWF_DEFLATE_HASH_TABLE_BITS );
+
+				previous_position                  = encoder->hash_table[ hash_value ];
+				encoder->hash_table[ hash_value ] = position_base + (uint32_t) data_offset;
+				chain_distance                     = 0;
+
+				if( previous_position >= position_base )
+				{
+					distance = (uint32_t) data_offset - ( previous_position - position_base );
+
+					if( distance <= LIBEWF_DEFLATE_WINDOW_SIZE )
+					{
+						chain_distance = (uint16_t) distance;
+					}
+				}
+				encoder->chain_table[ data_offset & ( LIBEWF_DEFLATE_WINDOW_SIZE - 1 ) ] = chain_distance;
+
+				if( chain_distance != 0 )
+				{
+					maximum_match_size = uncompressed_data_size - data_offset;
+
+					if( maximum_match_size > LIBEWF_DEFLATE_MAXIMUM_MATCH_SIZE )
+					{
+						maximum_match_size = LIBEWF_DEFLATE_MAXIMUM_MATCH_SIZE;
+					}
+					candidate_offset = data_offset - chain_distance;
+					distance         = chain_distance;
+
+					for( chain_size = maximum_chain_size;
+					     chain_size > 0;
+					     chain_size-- )
+					{
+						/* Since the chain table is not cleared the candidate is always verified
+						 */
+						if( uncompressed_data[ candidate_offset + match_size ] == uncompressed_data[ data_offset + match_size ] )
+						{
+							size = 0;
+
+							while( ( size + 8 ) <= (uint16_t) maximum_match_size )
+							{
+								byte_stream_copy_to_uint64_little_endian(
+								 &( uncompressed_data[ candidate_offset + size ] ),
+								 candidate_value_64bit );
+
+								byte_stream_copy_to_uint64_little_endian(
+								 &( uncompressed_data[ data_offset + size ] ),
+								 value_64bit );
+
+								if( candidate_value_64bit != value_64bit )
+								{
+									break;
+								}
+								size += 8;
+							}
+							for( ;
+							     size < (uint16_t) maximum_match_size;
+							     size++ )
+							{
+								if( uncompressed_data[ candidate_offset + size ] != uncompressed_data[ data_offset + size ] )
+								{
+									break;
+								}
+							}
+							if( size > match_size )
+							{
+								match_size     = size;
+								match_distance = (uint16_t) distance;
+
+								if( ( match_size >= nice_match_size )
+								 || ( match_size >= (uint16_t) maximum_match_size ) )
+								{
+									break;
+								}
+							}
+						}
+						chain_distance = encoder->chain_table[ candidate_offset & ( LIBEWF_DEFLATE_WINDOW_SIZE - 1 ) ];
+
+						if( ( chain_distance == 0 )
+						 || ( chain_distance > candidate_offset )
+						 || ( ( distance + chain_distance ) > LIBEWF_DEFLATE_WINDOW_SIZE ) )
+						{
+							break;
+						}
+						candidate_offset -= chain_distance;
+						distance         += chain_distance;
+					}
+				}
+			}
+			if( match_size >= LIBEWF_DEFLATE_MINIMUM_MATCH_SIZE )
+			{
+				encoder->symbol_values[ encoder->number_of_symbols ]      = match_size;
+				encoder->symbol_distances[ encoder->number_of_symbols++ ] = match_distance;
+
+				encoder->literal_frequencies[ 257 + encoder->length_codes[ match_size ] ] += 1;
+
+				if( match_distance <= 256 )
+				{
+					encoder->distance_frequencies[ encoder->distance_codes_lookup[ match_distance - 1 ] ] += 1;
+				}
+				else
+				{
+					encoder->distance_frequencies[ encoder->distance_codes_lookup[ 256 + ( ( match_distance - 1 ) >> 7 ) ] ] += 1;
+				}
+				/* Add the positions inside the match to the hash chains
+				 * for long matches this is skipped to speed up fast compression
+				 */
+				if( match_size <= maximum_insert_match_size )
+				{
+					for( insert_offset = data_offset + 1;
+					     insert_offset < ( data_offset + match_size );
+					     insert_offset++ )
+					{
+						if( ( uncompressed_data_size - insert_offset ) < LIBEWF_DEFLATE_MINIMUM_MATCH_SIZE )
+						{
+							break;
+						}
+						hash_value = ( (uint32_t) uncompressed_data[ insert_offset ]
+						           | ( (uint32_t) uncompressed_data[ insert_offset + 1 ] << 8 )
+						           | ( (uint32_t) uncompressed_data[ insert_offset + 2 ] << 16 ) ) * 0x9e3779b1UL;
+						hash_value = ( hash_value & 0xffffffffUL ) >> ( 32 - LIBEWF_DEFLATE_HASH_TABLE_BITS );
+
+						previous_position                  = encoder->hash_table[ hash_value ];
+						encoder->hash_table[ hash_value ] = position_base + (uint32_t) insert_offset;
+						chain_distance                     = 0;
+
+						if( previous_position >= position_base )
+						{
+							distance = (uint32_t) insert_offset - ( previous_position - position_base );
+
+							if( distance <= LIBEWF_DEFLATE_WINDOW_SIZE )
+							{
+								chain_distance = (uint16_t) distance;
+							}
+						}
+						encoder->chain_table[ insert_offset & ( LIBEWF_DEFLATE_WINDOW_SIZE - 1 ) ] = chain_distance;
+					}
+				}
+				data_offset += match_size;
+			}
+			else
+			{
+				encoder->symbol_values[ encoder->number_of_symbols ]      = uncompressed_data[ data_offset ];
+				encoder->symbol_distances[ encoder->number_of_symbols++ ] = 0;
+
+				encoder->literal_frequencies[ uncompressed_data[ data_offset ] ] += 1;
+
+				data_offset++;
+			}
+		}
+		if( data_offset >= uncompressed_data_size )
+		{
+			last_block_flag = 1;
+		}
+		result = libewf_deflate_encoder_write_block(
+		          encoder,
+		          &bit_stream,
+		          uncompressed_data,
+		          block_offset,
+		          data_offset - block_offset,
+		          last_block_flag,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = libewf_deflate_output_bit_stream_flush(
+		          &bit_stream,
+		          error );
+	}
+	if( result == 1 )
+	{
+		if( libewf_deflate_calculate_adler32(
+		     &calculated_checksum,
+		     uncompressed_data,
+		     uncompressed_data_size,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to calculate checksum.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( bit_stream.byte_stream_size - bit_stream.byte_stream_offset ) < 4 )
+		{
+			result = 0;
+		}
+		else
+		{
+			byte_stream_copy_from_uint32_big_endian(
+			 &( bit_stream.byte_stream[ bit_stream.byte_stream_offset ] ),
+			 calculated_checksum );
+
+			bit_stream.byte_stream_offset += 4;
+		}
+	}
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+		 "%s: unable to compress data.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		*compressed_data_size = libewf_deflate_get_compressed_data_bound(
+		                         uncompressed_data_size );
+
+		return( 0 );
+	}
+	*compressed_data_size = bit_stream.byte_stream_offset;
+
+	return( 1 );
+}
+
+/* Determines the maximum size of the compressed data created by the encoder
+ * this is the size of the zlib stream when every block is stored uncompressed
+ * Returns the maximum compressed data size
+ */
+size_t libewf_deflate_get_compressed_data_bound(
+        size_t uncompressed_data_size )
+{
+	size_t number_of_blocks = ( uncompressed_data_size / LIBEWF_DEFLATE_MAXIMUM_BLOCK_SIZE ) + 1;
+
+	/* 2 bytes for the zlib header, 5 bytes per uncompressed block header
+	 * and 4 bytes for the Adler-32 checksum
+	 */
+	return( uncompressed_data_size + ( 5 * number_of_blocks ) + 6 );
+}
+
+/* Compresses data using deflate (zlib) compression
+ * The encoder is optional and can be reused to prevent reallocating its state
+ * Returns 1 on success, 0 if compressed data is too small or -1 on error
+ */
+int libewf_deflate_compress(
+     const uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     uint8_t *compressed_data,
+     size_t *compressed_data_size,
+     int8_t compression_level,
+     libewf_deflate_encoder_t *encoder,
+     libcerror_error_t **error )
+{
+	libewf_deflate_encoder_t *temporary_encoder = NULL;
+	static char *function                       = "libewf_deflate_compress";
+	int result                                  = 0;
+
+	if( encoder == NULL )
+	{
+		if( libewf_deflate_encoder_initialize(
+		     &temporary_encoder,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create encoder.",
+			 function );
+
+			return( -1 );
+		}
+		encoder = temporary_encoder;
+	}
+	result = libewf_deflate_encoder_compress(
+	          encoder,
+	          uncompressed_data,
+	          uncompressed_data_size,
+	          compressed_data,
+	          compressed_data_size,
+	          compression_level,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+		 "%s: unable to compress data.",
+		 function );
+	}
+	if( temporary_encoder != NULL )
+	{
+		if( libewf_deflate_encoder_free(
+		     &temporary_encoder,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free encoder.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
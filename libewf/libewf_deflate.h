@@ -88,6 +88,116 @@ struct libewf_deflate_huffman_table
 	int number_of_codes;
 };
 
+/* The encoder (compression) definitions
+ */
+#define LIBEWF_DEFLATE_WINDOW_SIZE			32768
+#define LIBEWF_DEFLATE_HASH_TABLE_BITS			15
+#define LIBEWF_DEFLATE_HASH_TABLE_SIZE			( 1 << LIBEWF_DEFLATE_HASH_TABLE_BITS )
+#define LIBEWF_DEFLATE_MINIMUM_MATCH_SIZE		3
+#define LIBEWF_DEFLATE_MAXIMUM_MATCH_SIZE		258
+
+/* The maximum number of uncompressed bytes encoded in a single block
+ * a block can exceed this size by less than the maximum match size
+ */
+#define LIBEWF_DEFLATE_MAXIMUM_BLOCK_SIZE		32768
+
+typedef struct libewf_deflate_output_bit_stream libewf_deflate_output_bit_stream_t;
+
+struct libewf_deflate_output_bit_stream
+{
+	/* The byte stream
+	 */
+	uint8_t *byte_stream;
+
+	/* The byte stream size
+	 */
+	size_t byte_stream_size;
+
+	/* The byte stream offset
+	 */
+	size_t byte_stream_offset;
+
+	/* The bit buffer
+	 */
+	uint64_t bit_buffer;
+
+	/* The number of bits in the bit buffer
+	 */
+	uint8_t bit_buffer_size;
+};
+
+typedef struct libewf_deflate_encoder libewf_deflate_encoder_t;
+
+/* The encoder contains the state that is reused between compressions
+ * an encoder should not be shared between threads
+ */
+struct libewf_deflate_encoder
+{
+	/* The hash table
+	 * contains the most recent position of a hash value relative to the position base
+	 */
+	uint32_t hash_table[ LIBEWF_DEFLATE_HASH_TABLE_SIZE ];
+
+	/* The chain table
+	 * contains the distance to the previous position with the same hash value
+	 */
+	uint16_t chain_table[ LIBEWF_DEFLATE_WINDOW_SIZE ];
+
+	/* The position base
+	 * hash table values below the base originate from a previous compression
+	 */
+	uint32_t position_base;
+
+	/* The symbol values, contains a literal byte or a match size
+	 */
+	uint16_t symbol_values[ LIBEWF_DEFLATE_MAXIMUM_BLOCK_SIZE ];
+
+	/* The symbol distances, contains 0 for a literal or the match distance
+	 */
+	uint16_t symbol_distances[ LIBEWF_DEFLATE_MAXIMUM_BLOCK_SIZE ];
+
+	/* The number of symbols
+	 */
+	int number_of_symbols;
+
+	/* The literal and length code frequencies
+	 */
+	uint32_t literal_frequencies[ 288 ];
+
+	/* The distance code frequencies
+	 */
+	uint32_t distance_frequencies[ 30 ];
+
+	/* The dynamic Huffman literal and length codes and code sizes
+	 */
+	uint16_t literal_codes[ 288 ];
+	uint8_t literal_code_sizes[ 288 ];
+
+	/* The dynamic Huffman distance codes and code sizes
+	 */
+	uint16_t distance_codes[ 30 ];
+	uint8_t distance_code_sizes[ 30 ];
+
+	/* The fixed Huffman literal and length codes and code sizes
+	 */
+	uint16_t fixed_literal_codes[ 288 ];
+	uint8_t fixed_literal_code_sizes[ 288 ];
+
+	/* The fixed Huffman distance codes and code sizes
+	 */
+	uint16_t fixed_distance_codes[ 30 ];
+	uint8_t fixed_distance_code_sizes[ 30 ];
+
+	/* The length code (minus 257) per match size
+	 */
+	uint8_t length_codes[ LIBEWF_DEFLATE_MAXIMUM_MATCH_SIZE + 1 ];
+
+	/* The distance code per distance - 1 for distances upto 256
+	 * and per ( distance - 1 ) / 128 from index 256
+	 */
+	uint8_t distance_codes_lookup[ 512 ];
+};
+
 int libewf_deflate_bit_stream_get_value(
      libewf_deflate_bit_stream_t *bit_stream,
      uint8_t number_of_bits,
@@ -134,6 +244,76 @@ int libewf_deflate_decompress(
      size_t *uncompressed_data_size,
      libcerror_error_t **error );
 
+int libewf_deflate_output_bit_stream_put_value(
+     libewf_deflate_output_bit_stream_t *bit_stream,
+     uint8_t number_of_bits,
+     uint32_t value_32bit,
+     libcerror_error_t **error );
+
+int libewf_deflate_output_bit_stream_flush(
+     libewf_deflate_output_bit_stream_t *bit_stream,
+     libcerror_error_t **error );
+
+int libewf_deflate_calculate_huffman_code_sizes(
+     const uint32_t *frequencies,
+     int number_of_symbols,
+     uint8_t maximum_code_size,
+     uint8_t *code_sizes,
+     libcerror_error_t **error );
+
+int libewf_deflate_calculate_huffman_codes(
+     const uint8_t *code_sizes,
+     int number_of_symbols,
+     uint16_t *codes,
+     libcerror_error_t **error );
+
+int libewf_deflate_encoder_initialize(
+     libewf_deflate_encoder_t **encoder,
+     libcerror_error_t **error );
+
+int libewf_deflate_encoder_free(
+     libewf_deflate_encoder_t **encoder,
+     libcerror_error_t **error );
+
+int libewf_deflate_encoder_write_symbols(
+     libewf_deflate_encoder_t *encoder,
+     libewf_deflate_output_bit_stream_t *bit_stream,
+     const uint16_t *literal_codes,
+     const uint8_t *literal_code_sizes,
+     const uint16_t *distance_codes,
+     const uint8_t *distance_code_sizes,
+     libcerror_error_t **error );
+
+int libewf_deflate_encoder_write_block(
+     libewf_deflate_encoder_t *encoder,
+     libewf_deflate_output_bit_stream_t *bit_stream,
+     const uint8_t *uncompressed_data,
+     size_t block_offset,
+     size_t block_size,
+     uint8_t last_block_flag,
+     libcerror_error_t **error );
+
+int libewf_deflate_encoder_compress(
+     libewf_deflate_encoder_t *encoder,
+     const uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     uint8_t *compressed_data,
+     size_t *compressed_data_size,
+     int8_t compression_level,
+     libcerror_error_t **error );
+
+size_t libewf_deflate_get_compressed_data_bound(
+        size_t uncompressed_data_size );
+
+int libewf_deflate_compress(
+     const uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     uint8_t *compressed_data,
+     size_t *compressed_data_size,
+     int8_t compression_level,
+     libewf_deflate_encoder_t *encoder,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
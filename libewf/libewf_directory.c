@@ -0,0 +1,1109 @@
+/*
+ * Directory functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+#include <wide_string.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_ERRNO_H ) || defined( WINAPI )
+#include <errno.h>
+#endif
+
+#if !defined( WINAPI ) && defined( HAVE_DIRENT_H )
+#include <dirent.h>
+#endif
+
+#include "libewf_directory.h"
+#include "libewf_libcerror.h"
+
+#if defined( WINAPI ) || ( defined( HAVE_DIRENT_H ) && defined( HAVE_OPENDIR ) && defined( HAVE_READDIR ) && defined( HAVE_CLOSEDIR ) )
+#define LIBEWF_DIRECTORY_HAVE_SCAN	1
+#endif
+
+/* The initial number of extensions that is allocated
+ */
+#define LIBEWF_DIRECTORY_INITIAL_NUMBER_OF_EXTENSIONS	64
+
+/* Compares two extensions
+ * Returns -1, 0 or 1 as required by qsort and bsearch
+ */
+int libewf_directory_compare_extensions(
+     const void *first_extension,
+     const void *second_extension )
+{
+	return( memory_compare(
+	         first_extension,
+	         second_extension,
+	         sizeof( char ) * LIBEWF_DIRECTORY_EXTENSION_SIZE ) );
+}
+
+/* Appends an extension to the extensions
+ * The extension is padded with zero bytes and on file systems with caseless names converted to upper case
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_directory_append_extension(
+     char **extensions,
+     int *number_of_extensions,
+     int *number_of_allocated_extensions,
+     const char *extension,
+     size_t extension_length,
+     libcerror_error_t **error )
+{
+	void *reallocation    = NULL;
+	char *entry           = NULL;
+	static char *function = "libewf_directory_append_extension";
+	size_t string_index   = 0;
+
+	if( *number_of_extensions >= *number_of_allocated_extensions )
+	{
+		if( *number_of_allocated_extensions == 0 )
+		{
+			*number_of_allocated_extensions = LIBEWF_DIRECTORY_INITIAL_NUMBER_OF_EXTENSIONS;
+		}
+		else if( *number_of_allocated_extensions < ( INT_MAX / 2 ) )
+		{
+			*number_of_allocated_extensions *= 2;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid number of extensions value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		reallocation = memory_reallocate(
+		                *extensions,
+		                sizeof( char ) * LIBEWF_DIRECTORY_EXTENSION_SIZE * *number_of_allocated_extensions );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize extensions.",
+			 function );
+
+			return( -1 );
+		}
+		*extensions = (char *) reallocation;
+	}
+	entry = &( ( *extensions )[ *number_of_extensions * LIBEWF_DIRECTORY_EXTENSION_SIZE ] );
+
+	if( memory_set(
+	     entry,
+	     0,
+	     sizeof( char ) * LIBEWF_DIRECTORY_EXTENSION_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear extension.",
+		 function );
+
+		return( -1 );
+	}
+	for( string_index = 0;
+	     string_index < extension_length;
+	     string_index++ )
+	{
+		entry[ string_index ] = extension[ string_index ];
+
+#if defined( LIBEWF_DIRECTORY_HAVE_CASELESS_NAMES )
+		if( ( entry[ string_index ] >= 'a' )
+		 && ( entry[ string_index ] <= 'z' ) )
+		{
+			entry[ string_index ] -= 'a' - 'A';
+		}
+#endif
+	}
+	*number_of_extensions += 1;
+
+	return( 1 );
+}
+
+/* Retrieves the sorted extensions of the entries of a directory
+ * Only the names of entries that consist of the prefix followed by an extension
+ * of extension length characters are considered
+ * The extensions are stored consecutively in LIBEWF_DIRECTORY_EXTENSION_SIZE characters each
+ * An empty path represents the current working directory
+ * Returns 1 if successful, 0 if the directory could not be listed or -1 on error
+ */
+int libewf_directory_get_extensions(
+     const char *path,
+     size_t path_length,
+     const char *prefix,
+     size_t prefix_length,
+     size_t extension_length,
+     char **extensions,
+     int *number_of_extensions,
+     libcerror_error_t **error )
+{
+#if defined( WINAPI )
+	WIN32_FIND_DATAA find_data;
+
+	HANDLE find_handle                 = INVALID_HANDLE_VALUE;
+	size_t search_pattern_index        = 0;
+#elif defined( LIBEWF_DIRECTORY_HAVE_SCAN )
+	struct dirent *directory_entry     = NULL;
+	DIR *directory                     = NULL;
+#endif
+#if defined( LIBEWF_DIRECTORY_HAVE_SCAN )
+	const char *entry_name             = NULL;
+	char *search_pattern               = NULL;
+	size_t entry_name_length           = 0;
+	size_t search_pattern_size         = 0;
+	int number_of_allocated_extensions = 0;
+	int result                         = 0;
+#endif
+	static char *function              = "libewf_directory_get_extensions";
+
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		return( -1 );
+	}
+	if( path_length > (size_t) ( SSIZE_MAX - 3 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid path length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( prefix == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid prefix.",
+		 function );
+
+		return( -1 );
+	}
+	if( prefix_length > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid prefix length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( extension_length == 0 )
+	 || ( extension_length >= LIBEWF_DIRECTORY_EXTENSION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid extension length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( extensions == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extensions.",
+		 function );
+
+		return( -1 );
+	}
+	if( *extensions != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid extensions value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_extensions == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of extensions.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_extensions = 0;
+
+#if defined( LIBEWF_DIRECTORY_HAVE_SCAN )
+	/* The search pattern contains the path, a separator, a wildcard and the end-of-string character
+	 * where the path can end with a separator
+	 */
+	search_pattern_size = path_length + 3;
+
+	search_pattern = narrow_string_allocate(
+	                  search_pattern_size );
+
+	if( search_pattern == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create search pattern.",
+		 function );
+
+		goto on_error;
+	}
+	if( path_length == 0 )
+	{
+		search_pattern[ 0 ] = '.';
+		search_pattern[ 1 ] = 0;
+	}
+	else if( narrow_string_copy(
+	          search_pattern,
+	          path,
+	          path_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy path.",
+		 function );
+
+		goto on_error;
+	}
+	else
+	{
+		search_pattern[ path_length ] = 0;
+	}
+#if defined( WINAPI )
+	search_pattern_index = narrow_string_length(
+	                        search_pattern );
+
+	if( ( search_pattern[ search_pattern_index - 1 ] != '\\' )
+	 && ( search_pattern[ search_pattern_index - 1 ] != '/' )
+	 && ( search_pattern[ search_pattern_index - 1 ] != ':' ) )
+	{
+		search_pattern[ search_pattern_index++ ] = '\\';
+	}
+	search_pattern[ search_pattern_index++ ] = '*';
+	search_pattern[ search_pattern_index ]   = 0;
+
+	find_handle = FindFirstFileA(
+	               (LPCSTR) search_pattern,
+	               &find_data );
+
+	if( find_handle == INVALID_HANDLE_VALUE )
+	{
+		memory_free(
+		 search_pattern );
+
+		return( 0 );
+	}
+	do
+	{
+		entry_name = (const char *) find_data.cFileName;
+#else
+	directory = opendir(
+	             search_pattern );
+
+	if( directory == NULL )
+	{
+		memory_free(
+		 search_pattern );
+
+		return( 0 );
+	}
+	do
+	{
+		errno = 0;
+
+		directory_entry = readdir(
+		                   directory );
+
+		if( directory_entry == NULL )
+		{
+			if( errno != 0 )
+			{
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 errno,
+				 "%s: unable to read directory entry.",
+				 function );
+
+				goto on_error;
+			}
+			break;
+		}
+		entry_name = (const char *) directory_entry->d_name;
+#endif
+		entry_name_length = narrow_string_length(
+		                     entry_name );
+
+		if( entry_name_length == ( prefix_length + extension_length ) )
+		{
+#if defined( LIBEWF_DIRECTORY_HAVE_CASELESS_NAMES )
+			result = narrow_string_compare_no_case(
+			          entry_name,
+			          prefix,
+			          prefix_length );
+#else
+			result = narrow_string_compare(
+			          entry_name,
+			          prefix,
+			          prefix_length );
+#endif
+			if( result == 0 )
+			{
+				if( libewf_directory_append_extension(
+				     extensions,
+				     number_of_extensions,
+				     &number_of_allocated_extensions,
+				     &( entry_name[ prefix_length ] ),
+				     extension_length,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to append extension.",
+					 function );
+
+					goto on_error;
+				}
+			}
+		}
+#if defined( WINAPI )
+	}
+	while( FindNextFileA(
+	        find_handle,
+	        &find_data ) != 0 );
+
+	if( FindClose(
+	     find_handle ) == 0 )
+	{
+		find_handle = INVALID_HANDLE_VALUE;
+
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close directory.",
+		 function );
+
+		goto on_error;
+	}
+#else
+	}
+	while( directory_entry != NULL );
+
+	if( closedir(
+	     directory ) != 0 )
+	{
+		directory = NULL;
+
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 errno,
+		 "%s: unable to close directory.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	memory_free(
+	 search_pattern );
+
+	search_pattern = NULL;
+
+	if( *number_of_extensions > 1 )
+	{
+		qsort(
+		 *extensions,
+		 (size_t) *number_of_extensions,
+		 sizeof( char ) * LIBEWF_DIRECTORY_EXTENSION_SIZE,
+		 &libewf_directory_compare_extensions );
+	}
+	return( 1 );
+
+on_error:
+#if defined( WINAPI )
+	if( find_handle != INVALID_HANDLE_VALUE )
+	{
+		FindClose(
+		 find_handle );
+	}
+#else
+	if( directory != NULL )
+	{
+		closedir(
+		 directory );
+	}
+#endif
+	if( search_pattern != NULL )
+	{
+		memory_free(
+		 search_pattern );
+	}
+	if( *extensions != NULL )
+	{
+		memory_free(
+		 *extensions );
+
+		*extensions = NULL;
+	}
+	*number_of_extensions = 0;
+
+	return( -1 );
+#else
+	return( 0 );
+
+#endif /* defined( LIBEWF_DIRECTORY_HAVE_SCAN ) */
+}
+
+/* Determines if the extensions contain a specific extension
+ * Returns 1 if the extensions contain the extension, 0 if not or -1 on error
+ */
+int libewf_directory_has_extension(
+     const char *extensions,
+     int number_of_extensions,
+     const char *extension,
+     size_t extension_length,
+     libcerror_error_t **error )
+{
+	char search_extension[ LIBEWF_DIRECTORY_EXTENSION_SIZE ];
+
+	static char *function = "libewf_directory_has_extension";
+	size_t string_index   = 0;
+
+	if( extensions == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extensions.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_extensions < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of extensions value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( extension == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extension.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( extension_length == 0 )
+	 || ( extension_length >= LIBEWF_DIRECTORY_EXTENSION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid extension length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_extensions == 0 )
+	{
+		return( 0 );
+	}
+	if( memory_set(
+	     search_extension,
+	     0,
+	     sizeof( char ) * LIBEWF_DIRECTORY_EXTENSION_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear search extension.",
+		 function );
+
+		return( -1 );
+	}
+	for( string_index = 0;
+	     string_index < extension_length;
+	     string_index++ )
+	{
+		search_extension[ string_index ] = extension[ string_index ];
+
+#if defined( LIBEWF_DIRECTORY_HAVE_CASELESS_NAMES )
+		if( ( search_extension[ string_index ] >= 'a' )
+		 && ( search_extension[ string_index ] <= 'z' ) )
+		{
+			search_extension[ string_index ] -= 'a' - 'A';
+		}
+#endif
+	}
+	if( bsearch(
+	     search_extension,
+	     extensions,
+	     (size_t) number_of_extensions,
+	     sizeof( char ) * LIBEWF_DIRECTORY_EXTENSION_SIZE,
+	     &libewf_directory_compare_extensions ) == NULL )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Compares two wide extensions
+ * Returns -1, 0 or 1 as required by qsort and bsearch
+ */
+int libewf_directory_compare_extensions_wide(
+     const void *first_extension,
+     const void *second_extension )
+{
+	return( memory_compare(
+	         first_extension,
+	         second_extension,
+	         sizeof( wchar_t ) * LIBEWF_DIRECTORY_EXTENSION_SIZE ) );
+}
+
+/* Appends a wide extension to the extensions
+ * The extension is padded with zero values and on file systems with caseless names converted to upper case
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_directory_append_extension_wide(
+     wchar_t **extensions,
+     int *number_of_extensions,
+     int *number_of_allocated_extensions,
+     const wchar_t *extension,
+     size_t extension_length,
+     libcerror_error_t **error )
+{
+	void *reallocation    = NULL;
+	wchar_t *entry        = NULL;
+	static char *function = "libewf_directory_append_extension_wide";
+	size_t string_index   = 0;
+
+	if( *number_of_extensions >= *number_of_allocated_extensions )
+	{
+		if( *number_of_allocated_extensions == 0 )
+		{
+			*number_of_allocated_extensions = LIBEWF_DIRECTORY_INITIAL_NUMBER_OF_EXTENSIONS;
+		}
+		else if( *number_of_allocated_extensions < ( INT_MAX / 2 ) )
+		{
+			*number_of_allocated_extensions *= 2;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid number of extensions value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		reallocation = memory_reallocate(
+		                *extensions,
+		                sizeof( wchar_t ) * LIBEWF_DIRECTORY_EXTENSION_SIZE * *number_of_allocated_extensions );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize extensions.",
+			 function );
+
+			return( -1 );
+		}
+		*extensions = (wchar_t *) reallocation;
+	}
+	entry = &( ( *extensions )[ *number_of_extensions * LIBEWF_DIRECTORY_EXTENSION_SIZE ] );
+
+	if( memory_set(
+	     entry,
+	     0,
+	     sizeof( wchar_t ) * LIBEWF_DIRECTORY_EXTENSION_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear extension.",
+		 function );
+
+		return( -1 );
+	}
+	for( string_index = 0;
+	     string_index < extension_length;
+	     string_index++ )
+	{
+		entry[ string_index ] = extension[ string_index ];
+
+#if defined( LIBEWF_DIRECTORY_HAVE_CASELESS_NAMES )
+		if( ( entry[ string_index ] >= (wchar_t) 'a' )
+		 && ( entry[ string_index ] <= (wchar_t) 'z' ) )
+		{
+			entry[ string_index ] -= (wchar_t) 'a' - (wchar_t) 'A';
+		}
+#endif
+	}
+	*number_of_extensions += 1;
+
+	return( 1 );
+}
+
+/* Retrieves the sorted wide extensions of the entries of a directory
+ * Only the names of entries that consist of the prefix followed by an extension
+ * of extension length characters are considered
+ * The extensions are stored consecutively in LIBEWF_DIRECTORY_EXTENSION_SIZE characters each
+ * An empty path represents the current working directory
+ * Listing a directory by a wide path is only supported on Windows
+ * Returns 1 if successful, 0 if the directory could not be listed or -1 on error
+ */
+int libewf_directory_get_extensions_wide(
+     const wchar_t *path,
+     size_t path_length,
+     const wchar_t *prefix,
+     size_t prefix_length,
+     size_t extension_length,
+     wchar_t **extensions,
+     int *number_of_extensions,
+     libcerror_error_t **error )
+{
+#if defined( WINAPI )
+	WIN32_FIND_DATAW find_data;
+
+	HANDLE find_handle                 = INVALID_HANDLE_VALUE;
+	const wchar_t *entry_name          = NULL;
+	wchar_t *search_pattern            = NULL;
+	size_t entry_name_length           = 0;
+	size_t search_pattern_index        = 0;
+	size_t search_pattern_size         = 0;
+	int number_of_allocated_extensions = 0;
+	int result                         = 0;
+#endif
+	static char *function              = "libewf_directory_get_extensions_wide";
+
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		return( -1 );
+	}
+	if( path_length > (size_t) ( SSIZE_MAX - 3 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid path length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( prefix == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid prefix.",
+		 function );
+
+		return( -1 );
+	}
+	if( prefix_length > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid prefix length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( extension_length == 0 )
+	 || ( extension_length >= LIBEWF_DIRECTORY_EXTENSION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid extension length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( extensions == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extensions.",
+		 function );
+
+		return( -1 );
+	}
+	if( *extensions != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid extensions value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_extensions == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of extensions.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_extensions = 0;
+
+#if defined( WINAPI )
+	/* The search pattern contains the path, a separator, a wildcard and the end-of-string character
+	 * where the path can end with a separator
+	 */
+	search_pattern_size = path_length + 3;
+
+	search_pattern = wide_string_allocate(
+	                  search_pattern_size );
+
+	if( search_pattern == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create search pattern.",
+		 function );
+
+		goto on_error;
+	}
+	if( path_length == 0 )
+	{
+		search_pattern[ search_pattern_index++ ] = (wchar_t) '.';
+	}
+	else if( wide_string_copy(
+	          search_pattern,
+	          path,
+	          path_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy path.",
+		 function );
+
+		goto on_error;
+	}
+	else
+	{
+		search_pattern_index = path_length;
+	}
+	if( ( search_pattern[ search_pattern_index - 1 ] != (wchar_t) '\\' )
+	 && ( search_pattern[ search_pattern_index - 1 ] != (wchar_t) '/' )
+	 && ( search_pattern[ search_pattern_index - 1 ] != (wchar_t) ':' ) )
+	{
+		search_pattern[ search_pattern_index++ ] = (wchar_t) '\\';
+	}
+	search_pattern[ search_pattern_index++ ] = (wchar_t) '*';
+	search_pattern[ search_pattern_index ]   = 0;
+
+	find_handle = FindFirstFileW(
+	               (LPCWSTR) search_pattern,
+	               &find_data );
+
+	if( find_handle == INVALID_HANDLE_VALUE )
+	{
+		memory_free(
+		 search_pattern );
+
+		return( 0 );
+	}
+	do
+	{
+		entry_name = (const wchar_t *) find_data.cFileName;
+
+		entry_name_length = wide_string_length(
+		                     entry_name );
+
+		if( entry_name_length == ( prefix_length + extension_length ) )
+		{
+			result = wide_string_compare_no_case(
+			          entry_name,
+			          prefix,
+			          prefix_length );
+
+			if( result == 0 )
+			{
+				if( libewf_directory_append_extension_wide(
+				     extensions,
+				     number_of_extensions,
+				     &number_of_allocated_extensions,
+				     &( entry_name[ prefix_length ] ),
+				     extension_length,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to append extension.",
+					 function );
+
+					goto on_error;
+				}
+			}
+		}
+	}
+	while( FindNextFileW(
+	        find_handle,
+	        &find_data ) != 0 );
+
+	if( FindClose(
+	     find_handle ) == 0 )
+	{
+		find_handle = INVALID_HANDLE_VALUE;
+
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close directory.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 search_pattern );
+
+	search_pattern = NULL;
+
+	if( *number_of_extensions > 1 )
+	{
+		qsort(
+		 *extensions,
+		 (size_t) *number_of_extensions,
+		 sizeof( wchar_t ) * LIBEWF_DIRECTORY_EXTENSION_SIZE,
+		 &libewf_directory_compare_extensions_wide );
+	}
+	return( 1 );
+
+on_error:
+	if( find_handle != INVALID_HANDLE_VALUE )
+	{
+		FindClose(
+		 find_handle );
+	}
+	if( search_pattern != NULL )
+	{
+		memory_free(
+		 search_pattern );
+	}
+	if( *extensions != NULL )
+	{
+		memory_free(
+		 *extensions );
+
+		*extensions = NULL;
+	}
+	*number_of_extensions = 0;
+
+	return( -1 );
+#else
+	return( 0 );
+
+#endif /* defined( WINAPI ) */
+}
+
+/* Determines if the wide extensions contain a specific extension
+ * Returns 1 if the extensions contain the extension, 0 if not or -1 on error
+ */
+int libewf_directory_has_extension_wide(
+     const wchar_t *extensions,
+     int number_of_extensions,
+     const wchar_t *extension,
+     size_t extension_length,
+     libcerror_error_t **error )
+{
+	wchar_t search_extension[ LIBEWF_DIRECTORY_EXTENSION_SIZE ];
+
+	static char *function = "libewf_directory_has_extension_wide";
+	size_t string_index   = 0;
+
+	if( extensions == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extensions.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_extensions < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of extensions value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( extension == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extension.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( extension_length == 0 )
+	 || ( extension_length >= LIBEWF_DIRECTORY_EXTENSION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid extension length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_extensions == 0 )
+	{
+		return( 0 );
+	}
+	if( memory_set(
+	     search_extension,
+	     0,
+	     sizeof( wchar_t ) * LIBEWF_DIRECTORY_EXTENSION_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear search extension.",
+		 function );
+
+		return( -1 );
+	}
+	for( string_index = 0;
+	     string_index < extension_length;
+	     string_index++ )
+	{
+		search_extension[ string_index ] = extension[ string_index ];
+
+#if defined( LIBEWF_DIRECTORY_HAVE_CASELESS_NAMES )
+		if( ( search_extension[ string_index ] >= (wchar_t) 'a' )
+		 && ( search_extension[ string_index ] <= (wchar_t) 'z' ) )
+		{
+			search_extension[ string_index ] -= (wchar_t) 'a' - (wchar_t) 'A';
+		}
+#endif
+	}
+	if( bsearch(
+	     search_extension,
+	     extensions,
+	     (size_t) number_of_extensions,
+	     sizeof( wchar_t ) * LIBEWF_DIRECTORY_EXTENSION_SIZE,
+	     &libewf_directory_compare_extensions_wide ) == NULL )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
@@ -0,0 +1,111 @@
+/*
+ * Directory functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_DIRECTORY_H )
+#define _LIBEWF_DIRECTORY_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The number of characters an extension is stored in, including the padding
+ */
+#define LIBEWF_DIRECTORY_EXTENSION_SIZE		8
+
+/* File systems that compare names caseless store the extensions in upper case
+ */
+#if defined( WINAPI ) || defined( __APPLE__ )
+#define LIBEWF_DIRECTORY_HAVE_CASELESS_NAMES	1
+#endif
+
+int libewf_directory_compare_extensions(
+     const void *first_extension,
+     const void *second_extension );
+
+int libewf_directory_append_extension(
+     char **extensions,
+     int *number_of_extensions,
+     int *number_of_allocated_extensions,
+     const char *extension,
+     size_t extension_length,
+     libcerror_error_t **error );
+
+int libewf_directory_get_extensions(
+     const char *path,
+     size_t path_length,
+     const char *prefix,
+     size_t prefix_length,
+     size_t extension_length,
+     char **extensions,
+     int *number_of_extensions,
+     libcerror_error_t **error );
+
+int libewf_directory_has_extension(
+     const char *extensions,
+     int number_of_extensions,
+     const char *extension,
+     size_t extension_length,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+int libewf_directory_compare_extensions_wide(
+     const void *first_extension,
+     const void *second_extension );
+
+int libewf_directory_append_extension_wide(
+     wchar_t **extensions,
+     int *number_of_extensions,
+     int *number_of_allocated_extensions,
+     const wchar_t *extension,
+     size_t extension_length,
+     libcerror_error_t **error );
+
+int libewf_directory_get_extensions_wide(
+     const wchar_t *path,
+     size_t path_length,
+     const wchar_t *prefix,
+     size_t prefix_length,
+     size_t extension_length,
+     wchar_t **extensions,
+     int *number_of_extensions,
+     libcerror_error_t **error );
+
+int libewf_directory_has_extension_wide(
+     const wchar_t *extensions,
+     int number_of_extensions,
+     const wchar_t *extension,
+     size_t extension_length,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_DIRECTORY_H ) */
+
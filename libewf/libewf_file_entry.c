@@ -31,7 +31,7 @@
 #include "libewf_libcnotify.h"
 #include "libewf_libcthreads.h"
 #include "libewf_single_file_entry.h"
-#include "libewf_single_file_tree.h"
+#include "libewf_single_files.h"
 #include "libewf_types.h"
 
 /* Creates a file entry
@@ -2089,26 +2089,14 @@ ssize_t libewf_internal_file_entry_read_buffer_from_single_file_entry(
 	{
 		read_size = 1;
 	}
-	if( libewf_handle_seek_offset(
-	     (libewf_handle_t *) internal_file_entry->internal_handle,
-	     data_offset,
-	     SEEK_SET,
-	     error ) == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset: %" PRIi64 ".",
-		 function,
-		 data_offset );
-
-		return( -1 );
-	}
-	read_count = libewf_handle_read_buffer(
+	/* The seek and read are done while holding the lock of the handle
+	 * so that file entries of the same handle can be read concurrently
+	 */
+	read_count = libewf_handle_read_buffer_at_offset(
 		      (libewf_handle_t *) internal_file_entry->internal_handle,
 		      buffer,
 		      read_size,
+		      data_offset,
 		      error );
 
 	if( read_count <= -1 )
@@ -2117,8 +2105,9 @@ ssize_t libewf_internal_file_entry_read_buffer_from_single_file_entry(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
-		 function );
+		 "%s: unable to read buffer at offset: %" PRIi64 ".",
+		 function,
+		 data_offset );
 
 		return( -1 );
 	}
@@ -2672,20 +2661,37 @@ int libewf_file_entry_get_number_of_sub_file_entries(
 		return( -1 );
 	}
 #endif
-	result = libcdata_tree_node_get_number_of_sub_nodes(
+	result = libewf_single_files_read_sub_nodes(
+	          internal_file_entry->internal_handle->single_files,
 	          internal_file_entry->file_entry_tree_node,
-	          number_of_sub_file_entries,
 	          error );
 
 	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of sub file entries.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read sub file entries.",
 		 function );
 	}
+	else
+	{
+		result = libcdata_tree_node_get_number_of_sub_nodes(
+		          internal_file_entry->file_entry_tree_node,
+		          number_of_sub_file_entries,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of sub file entries.",
+			 function );
+		}
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
 	     internal_file_entry->read_write_lock,
@@ -2778,6 +2784,20 @@ int libewf_file_entry_get_sub_file_entry(
 		return( -1 );
 	}
 #endif
+	if( libewf_single_files_read_sub_nodes(
+	     internal_file_entry->internal_handle->single_files,
+	     internal_file_entry->file_entry_tree_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read sub file entries.",
+		 function );
+
+		goto on_error;
+	}
 	if( libcdata_tree_node_get_sub_node_by_index(
 	     internal_file_entry->file_entry_tree_node,
              sub_file_entry_index,
@@ -2922,7 +2942,8 @@ int libewf_file_entry_get_sub_file_entry_by_utf8_name(
 		return( -1 );
 	}
 #endif
-	result = libewf_single_file_tree_get_sub_node_by_utf8_name(
+	result = libewf_single_files_get_sub_node_by_utf8_name(
+	          internal_file_entry->internal_handle->single_files,
 	          internal_file_entry->file_entry_tree_node,
 	          utf8_string,
 	          utf8_string_length,
@@ -3151,7 +3172,8 @@ int libewf_file_entry_get_sub_file_entry_by_utf8_path(
 
 			goto on_error;
 		}
-		result = libewf_single_file_tree_get_sub_node_by_utf8_name(
+		result = libewf_single_files_get_sub_node_by_utf8_name(
+			  internal_file_entry->internal_handle->single_files,
 			  node,
 			  utf8_string_segment,
 			  utf8_string_segment_length,
@@ -3297,7 +3319,8 @@ int libewf_file_entry_get_sub_file_entry_by_utf16_name(
 		return( -1 );
 	}
 #endif
-	result = libewf_single_file_tree_get_sub_node_by_utf16_name(
+	result = libewf_single_files_get_sub_node_by_utf16_name(
+	          internal_file_entry->internal_handle->single_files,
 	          internal_file_entry->file_entry_tree_node,
 	          utf16_string,
 	          utf16_string_length,
@@ -3526,7 +3549,8 @@ int libewf_file_entry_get_sub_file_entry_by_utf16_path(
 
 			goto on_error;
 		}
-		result = libewf_single_file_tree_get_sub_node_by_utf16_name(
+		result = libewf_single_files_get_sub_node_by_utf16_name(
+			  internal_file_entry->internal_handle->single_files,
 			  node,
 			  utf16_string_segment,
 			  utf16_string_segment_length,
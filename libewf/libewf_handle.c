@@ -36,6 +36,7 @@
 #include "libewf_device_information.h"
 #include "libewf_file_entry.h"
 #include "libewf_hash_sections.h"
+#include "libewf_hash_tree.h"
 #include "libewf_handle.h"
 #include "libewf_header_sections.h"
 #include "libewf_header_values.h"
@@ -48,13 +49,18 @@
 #include "libewf_libfcache.h"
 #include "libewf_libfdata.h"
 #include "libewf_libfvalue.h"
+#include "libewf_libhmac.h"
 #include "libewf_metadata.h"
+#include "libewf_open_handles_budget.h"
+#include "libewf_read_batch.h"
+#include "libewf_read_digest.h"
 #include "libewf_restart_data.h"
 #include "libewf_sector_range.h"
 #include "libewf_segment_file.h"
+#include "libewf_shared_metadata.h"
 #include "libewf_single_file_entry.h"
-#include "libewf_single_file_tree.h"
 #include "libewf_single_files.h"
+#include "libewf_statistics.h"
 #include "libewf_types.h"
 #include "libewf_unused.h"
 #include "libewf_write_io_handle.h"
@@ -384,6 +390,22 @@ int libewf_handle_free(
 
 			result = -1;
 		}
+		if( internal_handle->statistics != NULL )
+		{
+			if( libewf_statistics_free(
+			     &( internal_handle->statistics ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free statistics.",
+				 function );
+
+				result = -1;
+			}
+		}
 		memory_free(
 		 internal_handle );
 	}
@@ -728,6 +750,23 @@ int libewf_handle_clone(
 		}
 		internal_destination_handle->hash_values_parsed = internal_source_handle->hash_values_parsed;
 	}
+	if( ( internal_destination_handle->file_io_pool != NULL )
+	 && ( ( internal_source_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_WRITE ) == 0 ) )
+	{
+		if( libewf_open_handles_register_file_io_pool(
+		     internal_destination_handle->file_io_pool,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to register destination file IO pool with open handles budget.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	internal_destination_handle->maximum_number_of_open_handles = internal_source_handle->maximum_number_of_open_handles;
 	internal_destination_handle->date_format                    = internal_source_handle->date_format;
 
@@ -792,6 +831,10 @@ on_error:
 		}
 		if( internal_destination_handle->file_io_pool != NULL )
 		{
+			libewf_open_handles_unregister_file_io_pool(
+			 internal_destination_handle->file_io_pool,
+			 NULL );
+
 			libbfio_pool_free(
 			 &( internal_destination_handle->file_io_pool ),
 			 NULL );
@@ -835,809 +878,656 @@ on_error:
 	return( -1 );
 }
 
-/* Signals the handle to abort its current activity
+/* Clones the handle so that the clone shares the metadata of the source handle
+ * The clone has its own current offset and file IO pool, the segment table,
+ * chunk table, header and hash values are shared and reference counted.
+ * The share flags control if the chunks cache is shared as well, note that
+ * chunks in a shared chunks cache are unpacked while the shared metadata is grabbed.
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_signal_abort(
-     libewf_handle_t *handle,
+int libewf_handle_clone_shared(
+     libewf_handle_t **destination_handle,
+     libewf_handle_t *source_handle,
+     uint8_t share_flags,
      libcerror_error_t **error )
 {
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_signal_abort";
+	libewf_internal_handle_t *internal_destination_handle = NULL;
+	libewf_internal_handle_t *internal_source_handle      = NULL;
+	static char *function                                 = "libewf_handle_clone_shared";
 
-	if( handle == NULL )
+	if( destination_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 "%s: invalid destination handle.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->io_handle == NULL )
+	if( *destination_handle != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid destination handle value already set.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle->io_handle->abort = 1;
-
-	return( 1 );
-}
-
-/* Opens a set of EWF file(s)
- * For reading files should contain all filenames that make up an EWF image
- * For writing files should contain the base of the filename, extentions like .e01 will be automatically added
- * Returns 1 if successful or -1 on error
- */
-int libewf_handle_open(
-     libewf_handle_t *handle,
-     char * const filenames[],
-     int number_of_filenames,
-     int access_flags,
-     libcerror_error_t **error )
-{
-	libbfio_handle_t *file_io_handle          = NULL;
-	libbfio_pool_t *file_io_pool              = NULL;
-	libewf_internal_handle_t *internal_handle = NULL;
-	libewf_segment_table_t *segment_table     = NULL;
-	char *first_segment_filename              = NULL;
-	static char *function                     = "libewf_handle_open";
-	size_t filename_length                    = 0;
-	int file_io_pool_entry                    = 0;
-	int filename_index                        = 0;
-	int maximum_number_of_open_handles        = 0;
-	int result                                = 0;
-
-	if( handle == NULL )
+	if( source_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 "%s: invalid source handle.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( filenames == NULL )
+	if( ( share_flags & ~( LIBEWF_SHARE_FLAG_CHUNKS_CACHE ) ) != 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid filenames.",
-		 function );
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported share flags: 0x%02" PRIx8 ".",
+		 function,
+		 share_flags );
 
 		return( -1 );
 	}
-	if( number_of_filenames <= 0 )
+	internal_source_handle = (libewf_internal_handle_t *) source_handle;
+
+	if( internal_source_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
-		 "%s: invalid number of files zero or less.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid source handle - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( internal_source_handle->file_io_pool == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid source handle - missing file IO pool.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	maximum_number_of_open_handles = internal_handle->maximum_number_of_open_handles;
-
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_handle->read_write_lock,
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_source_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	if( libbfio_pool_initialize(
-	     &file_io_pool,
-	     0,
-	     maximum_number_of_open_handles,
-	     error ) != 1 )
+	if( ( internal_source_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create file IO pool.",
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: write access currently not supported.",
 		 function );
 
 		goto on_error;
 	}
-	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
+	if( internal_source_handle->shared_metadata == NULL )
 	{
-		for( filename_index = 0;
-		     filename_index < number_of_filenames;
-		     filename_index++ )
+		if( libewf_internal_handle_share_metadata(
+		     internal_source_handle,
+		     error ) != 1 )
 		{
-			filename_length = narrow_string_length(
-					   filenames[ filename_index ] );
-
-			/* Make sure there is more to the filename than the extension
-			 */
-			if( filename_length <= 4 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-				 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
-				 "%s: filename: %s is too small.",
-				 function,
-				 filenames[ filename_index ] );
-
-				goto on_error;
-			}
-			if( libbfio_file_initialize(
-			     &file_io_handle,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to create file IO handle.",
-				 function );
-
-				goto on_error;
-			}
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libbfio_handle_set_track_offsets_read(
-			     file_io_handle,
-			     1,
-			     error ) != 1 )
-			{
-		                libcerror_error_set(
-		                 error,
-		                 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		                 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		                 "%s: unable to set track offsets read in file IO handle.",
-		                 function );
-
-				goto on_error;
-			}
-#endif
-			if( libbfio_file_set_name(
-			     file_io_handle,
-			     filenames[ filename_index ],
-			     filename_length,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-				 "%s: unable to set name in file IO handle.",
-				 function );
-
-				goto on_error;
-			}
-			if( libbfio_pool_append_handle(
-			     file_io_pool,
-			     &file_io_pool_entry,
-			     file_io_handle,
-			     LIBBFIO_OPEN_READ,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to append file IO handle to pool.",
-				 function );
-
-				goto on_error;
-			}
-			file_io_handle = NULL;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to share metadata of source handle.",
+			 function );
 
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
-			{
-				libcnotify_printf(
-				 "%s: added file IO pool entry: %d with filename: %s.\n",
-				 function,
-				 file_io_pool_entry,
-				 filenames[ filename_index ] );
-			}
-#endif
-			if( ( filenames[ filename_index ][ filename_length - 3 ] == 'e' )
-			 || ( filenames[ filename_index ][ filename_length - 3 ] == 'E' )
-			 || ( filenames[ filename_index ][ filename_length - 3 ] == 'l' )
-			 || ( filenames[ filename_index ][ filename_length - 3 ] == 'L' )
-			 || ( filenames[ filename_index ][ filename_length - 3 ] == 's' )
-			 || ( filenames[ filename_index ][ filename_length - 3 ] == 'S' ) )
-			{
-				if( ( filenames[ filename_index ][ filename_length - 2 ] == '0' )
-				 && ( filenames[ filename_index ][ filename_length - 1 ] == '1' ) )
-				{
-					first_segment_filename = filenames[ filename_index ];
-				}
-			}
+			goto on_error;
 		}
 	}
-	if( libewf_segment_table_initialize(
-	     &segment_table,
-	     internal_handle->io_handle,
-	     LIBEWF_DEFAULT_SEGMENT_FILE_SIZE,
-	     error ) != 1 )
+	internal_destination_handle = memory_allocate_structure(
+			               libewf_internal_handle_t );
+
+	if( internal_destination_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create segment table.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create destination handle.",
 		 function );
 
 		goto on_error;
 	}
-	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
+	if( memory_set(
+	     internal_destination_handle,
+	     0,
+	     sizeof( libewf_internal_handle_t ) ) == NULL )
 	{
-		/* Get the basename of the first segment file
-		 */
-		if( first_segment_filename != NULL )
-		{
-			filename_length = narrow_string_length(
-					   first_segment_filename );
-
-			/* Set segment table basename
-			 */
-			if( libewf_segment_table_set_basename(
-			     segment_table,
-			     first_segment_filename,
-			     filename_length - 4,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-				 "%s: unable to set basename in segment table.",
-				 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear destination handle.",
+		 function );
 
-				goto on_error;
-			}
-		}
-	}
-	else if( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
-	{
-		/* Get the basename and store it in the segment tables
-		 */
-		filename_length = narrow_string_length(
-				   filenames[ 0 ] );
+		memory_free(
+		 internal_destination_handle );
 
-		/* Set segment table basename
-		 */
-		if( libewf_segment_table_set_basename(
-		     segment_table,
-		     filenames[ 0 ],
-		     filename_length,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set basename in segment table.",
-			 function );
+		internal_destination_handle = NULL;
 
-			goto on_error;
-		}
+		goto on_error;
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
+	if( libewf_io_handle_clone(
+	     &( internal_destination_handle->io_handle ),
+	     internal_source_handle->io_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination IO handle.",
 		 function );
 
 		goto on_error;
 	}
-#endif
-	result = libewf_internal_handle_open_file_io_pool(
-	          internal_handle,
-	          file_io_pool,
-	          access_flags,
-	          segment_table,
-	          error );
+	internal_destination_handle->io_handle->abort = 0;
 
-	if( result != 1 )
+	if( libewf_media_values_clone(
+	     &( internal_destination_handle->media_values ),
+	     internal_source_handle->media_values,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_OPEN_FAILED,
-		 "%s: unable to open handle using a file IO pool.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination media values.",
 		 function );
-	}
-	else
-	{
-		internal_handle->file_io_pool_created_in_library = 1;
-	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	result = libcthreads_read_write_lock_release_for_write(
-	          internal_handle->read_write_lock,
-	          error );
 
-	if( result != 1 )
+		goto on_error;
+	}
+	if( libcdata_array_clone(
+	     &( internal_destination_handle->sessions ),
+	     internal_source_handle->sessions,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
+	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) &libewf_sector_range_clone,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination sessions array.",
 		 function );
-	}
-#endif
-	if( result != 1 )
-	{
-		goto on_error;
-	}
-	return( 1 );
 
-on_error:
-	if( segment_table != NULL )
-	{
-		libewf_segment_table_free(
-		 &segment_table,
-		 NULL );
-	}
-	if( file_io_handle != NULL )
-	{
-		libbfio_handle_free(
-		 &file_io_handle,
-		 NULL );
-	}
-	if( file_io_pool != NULL )
-	{
-		libbfio_pool_free(
-		 &file_io_pool,
-		 NULL );
+		goto on_error;
 	}
-	return( -1 );
-}
-
-#if defined( HAVE_WIDE_CHARACTER_TYPE )
-
-/* Opens a set of EWF file(s)
- * For reading files should contain all filenames that make up an EWF image
- * For writing files should contain the base of the filename, extentions like .e01 will be automatically added
- * Returns 1 if successful or -1 on error
- */
-int libewf_handle_open_wide(
-     libewf_handle_t *handle,
-     wchar_t * const filenames[],
-     int number_of_filenames,
-     int access_flags,
-     libcerror_error_t **error )
-{
-	libbfio_handle_t *file_io_handle          = NULL;
-	libbfio_pool_t *file_io_pool              = NULL;
-	libewf_internal_handle_t *internal_handle = NULL;
-	libewf_segment_table_t *segment_table     = NULL;
-	wchar_t *first_segment_filename           = NULL;
-	static char *function                     = "libewf_handle_open_wide";
-	size_t filename_length                    = 0;
-	int file_io_pool_entry                    = 0;
-	int filename_index                        = 0;
-	int maximum_number_of_open_handles        = 0;
-	int result                                = 0;
-
-	if( handle == NULL )
+	if( libcdata_array_clone(
+	     &( internal_destination_handle->tracks ),
+	     internal_source_handle->tracks,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
+	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) &libewf_sector_range_clone,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination tracks array.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( filenames == NULL )
+	if( libcdata_range_list_clone(
+	     &( internal_destination_handle->acquiry_errors ),
+	     internal_source_handle->acquiry_errors,
+	     NULL,
+	     NULL,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid filenames.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination acquiry errors range list.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( number_of_filenames <= 0 )
+	if( libbfio_pool_clone(
+	     &( internal_destination_handle->file_io_pool ),
+	     internal_source_handle->file_io_pool,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
-		 "%s: invalid number of files zero or less.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination file IO pool.",
 		 function );
 
-		return( -1 );
+		goto on_error;
+	}
+	internal_destination_handle->file_io_pool_created_in_library = 1;
+
+	if( internal_source_handle->read_io_handle != NULL )
+	{
+		if( libewf_read_io_handle_clone(
+		     &( internal_destination_handle->read_io_handle ),
+		     internal_source_handle->read_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create destination read IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( ( share_flags & LIBEWF_SHARE_FLAG_CHUNKS_CACHE ) == 0 )
+	{
+		if( libfcache_cache_initialize(
+		     &( internal_destination_handle->chunks_cache ),
+		     LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNKS,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create destination chunks cache.",
+			 function );
+
+			goto on_error;
+		}
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_handle->read_write_lock,
+	if( libcthreads_read_write_lock_initialize(
+	     &( internal_destination_handle->read_write_lock ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to intialize destination read/write lock.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 #endif
-	maximum_number_of_open_handles = internal_handle->maximum_number_of_open_handles;
+	if( ( internal_destination_handle->file_io_pool != NULL )
+	 && ( ( internal_source_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_WRITE ) == 0 ) )
+	{
+		if( libewf_open_handles_register_file_io_pool(
+		     internal_destination_handle->file_io_pool,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to register destination file IO pool with open handles budget.",
+			 function );
 
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_handle->read_write_lock,
+			goto on_error;
+		}
+	}
+	if( libewf_shared_metadata_add_reference(
+	     internal_source_handle->shared_metadata,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to add reference to shared metadata.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	if( libbfio_pool_initialize(
-	     &file_io_pool,
-	     0,
-	     maximum_number_of_open_handles,
+	internal_destination_handle->shared_metadata    = internal_source_handle->shared_metadata;
+	internal_destination_handle->segment_table      = internal_source_handle->shared_metadata->segment_table;
+	internal_destination_handle->chunk_table        = internal_source_handle->shared_metadata->chunk_table;
+	internal_destination_handle->chunk_groups_cache = internal_source_handle->shared_metadata->chunk_groups_cache;
+	internal_destination_handle->hash_sections      = internal_source_handle->shared_metadata->hash_sections;
+	internal_destination_handle->header_values      = internal_source_handle->shared_metadata->header_values;
+	internal_destination_handle->hash_values        = internal_source_handle->shared_metadata->hash_values;
+	internal_destination_handle->single_files       = internal_source_handle->shared_metadata->single_files;
+
+	if( ( share_flags & LIBEWF_SHARE_FLAG_CHUNKS_CACHE ) != 0 )
+	{
+		internal_destination_handle->chunks_cache            = internal_source_handle->shared_metadata->chunks_cache;
+		internal_destination_handle->has_shared_chunks_cache = 1;
+	}
+	internal_destination_handle->header_values_parsed           = internal_source_handle->header_values_parsed;
+	internal_destination_handle->hash_values_parsed             = internal_source_handle->hash_values_parsed;
+	internal_destination_handle->maximum_number_of_open_handles = internal_source_handle->maximum_number_of_open_handles;
+	internal_destination_handle->date_format                    = internal_source_handle->date_format;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_source_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create file IO pool.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
-		goto on_error;
+		libewf_handle_free(
+		 (libewf_handle_t **) &internal_destination_handle,
+		 NULL );
+
+		return( -1 );
 	}
-	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
+#endif
+	*destination_handle = (libewf_handle_t *) internal_destination_handle;
+
+	return( 1 );
+
+on_error:
+	if( internal_destination_handle != NULL )
 	{
-		for( filename_index = 0;
-		     filename_index < number_of_filenames;
-		     filename_index++ )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( internal_destination_handle->read_write_lock != NULL )
 		{
-			filename_length = wide_string_length(
-					   filenames[ filename_index ] );
-
-			/* Make sure there is more to the filename than the extension
-			 */
-			if( filename_length <= 4 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-				 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
-				 "%s: filename: %ls is too small.",
-				 function,
-				 filenames[ filename_index ] );
+			libcthreads_read_write_lock_free(
+			 &( internal_destination_handle->read_write_lock ),
+			 NULL );
+		}
+#endif
+		if( internal_destination_handle->chunks_cache != NULL )
+		{
+			libfcache_cache_free(
+			 &( internal_destination_handle->chunks_cache ),
+			 NULL );
+		}
+		if( internal_destination_handle->read_io_handle != NULL )
+		{
+			libewf_read_io_handle_free(
+			 &( internal_destination_handle->read_io_handle ),
+			 NULL );
+		}
+		if( internal_destination_handle->file_io_pool != NULL )
+		{
+			libewf_open_handles_unregister_file_io_pool(
+			 internal_destination_handle->file_io_pool,
+			 NULL );
 
-				goto on_error;
-			}
-			if( libbfio_file_initialize(
-			     &file_io_handle,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to create file IO handle.",
-				 function );
+			libbfio_pool_free(
+			 &( internal_destination_handle->file_io_pool ),
+			 NULL );
+		}
+		if( internal_destination_handle->acquiry_errors != NULL )
+		{
+			libcdata_range_list_free(
+			 &( internal_destination_handle->acquiry_errors ),
+			 NULL,
+			 NULL );
+		}
+		if( internal_destination_handle->tracks != NULL )
+		{
+			libcdata_array_free(
+			 &( internal_destination_handle->tracks ),
+			 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
+			 NULL );
+		}
+		if( internal_destination_handle->sessions != NULL )
+		{
+			libcdata_array_free(
+			 &( internal_destination_handle->sessions ),
+			 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
+			 NULL );
+		}
+		if( internal_destination_handle->media_values != NULL )
+		{
+			libewf_media_values_free(
+			 &( internal_destination_handle->media_values ),
+			 NULL );
+		}
+		if( internal_destination_handle->io_handle != NULL )
+		{
+			libewf_io_handle_free(
+			 &( internal_destination_handle->io_handle ),
+			 NULL );
+		}
+		memory_free(
+		 internal_destination_handle );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_source_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
 
-				goto on_error;
-			}
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libbfio_handle_set_track_offsets_read(
-			     file_io_handle,
-			     1,
-			     error ) != 1 )
-			{
-		                libcerror_error_set(
-		                 error,
-		                 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		                 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		                 "%s: unable to set track offsets read in file IO handle.",
-		                 function );
+/* Moves the metadata of the handle into shared metadata, so that it can be shared with clones
+ * The handle keeps referencing the metadata and continues with its own copy of the IO handle,
+ * since the segment and chunk table keep referencing the IO handle they were created with
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_share_metadata(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	libewf_io_handle_t *io_handle             = NULL;
+	libewf_shared_metadata_t *shared_metadata = NULL;
+	static char *function                     = "libewf_internal_handle_share_metadata";
 
-				goto on_error;
-			}
-#endif
-			if( libbfio_file_set_name_wide(
-			     file_io_handle,
-			     filenames[ filename_index ],
-			     filename_length,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-				 "%s: unable to set name in file IO handle.",
-				 function );
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
 
-				goto on_error;
-			}
-			if( libbfio_pool_append_handle(
-			     file_io_pool,
-			     &file_io_pool_entry,
-			     file_io_handle,
-			     LIBBFIO_OPEN_READ,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to append file IO handle to pool.",
-				 function );
+		return( -1 );
+	}
+	if( internal_handle->shared_metadata != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - shared metadata value already set.",
+		 function );
 
-				goto on_error;
-			}
-			file_io_handle = NULL;
+		return( -1 );
+	}
+	/* The hash values are parsed on demand, parse them before they become shared
+	 */
+	if( internal_handle->hash_values_parsed == 0 )
+	{
+		if( libewf_internal_handle_parse_hash_values(
+		     internal_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to parse hash values.",
+			 function );
 
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
-			{
-				libcnotify_printf(
-				 "%s: added file IO pool entry: %d with filename: %ls.\n",
-				 function,
-				 file_io_pool_entry,
-				 filenames[ filename_index ] );
-			}
-#endif
-			if( ( filenames[ filename_index ][ filename_length - 3 ] == 'e' )
-			 || ( filenames[ filename_index ][ filename_length - 3 ] == 'E' )
-			 || ( filenames[ filename_index ][ filename_length - 3 ] == 'l' )
-			 || ( filenames[ filename_index ][ filename_length - 3 ] == 'L' )
-			 || ( filenames[ filename_index ][ filename_length - 3 ] == 's' )
-			 || ( filenames[ filename_index ][ filename_length - 3 ] == 'S' ) )
-			{
-				if( ( filenames[ filename_index ][ filename_length - 2 ] == '0' )
-				 && ( filenames[ filename_index ][ filename_length - 1 ] == '1' ) )
-				{
-					first_segment_filename = filenames[ filename_index ];
-				}
-			}
+			goto on_error;
 		}
+		internal_handle->hash_values_parsed = 1;
 	}
-	if( libewf_segment_table_initialize(
-	     &segment_table,
+	if( libewf_io_handle_clone(
+	     &io_handle,
 	     internal_handle->io_handle,
-	     LIBEWF_DEFAULT_SEGMENT_FILE_SIZE,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create segment table.",
+		 "%s: unable to create IO handle.",
 		 function );
 
 		goto on_error;
 	}
-	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
+	if( libewf_shared_metadata_initialize(
+	     &shared_metadata,
+	     error ) != 1 )
 	{
-		/* Get the basename of the first segment file
-		 */
-		if( first_segment_filename != NULL )
-		{
-			filename_length = wide_string_length(
-					   first_segment_filename );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create shared metadata.",
+		 function );
 
-			/* Set segment table basename
-			 */
-			if( libewf_segment_table_set_basename_wide(
-			     segment_table,
-			     first_segment_filename,
-			     filename_length - 4,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-				 "%s: unable to set basename in segment table.",
-				 function );
+		goto on_error;
+	}
+	shared_metadata->io_handle            = internal_handle->io_handle;
+	shared_metadata->segment_table        = internal_handle->segment_table;
+	shared_metadata->chunk_table          = internal_handle->chunk_table;
+	shared_metadata->chunk_groups_cache   = internal_handle->chunk_groups_cache;
+	shared_metadata->chunks_cache         = internal_handle->chunks_cache;
+	shared_metadata->hash_sections        = internal_handle->hash_sections;
+	shared_metadata->header_values        = internal_handle->header_values;
+	shared_metadata->hash_values          = internal_handle->hash_values;
+	shared_metadata->single_files         = internal_handle->single_files;
+	shared_metadata->number_of_references = 1;
+
+	internal_handle->io_handle               = io_handle;
+	internal_handle->shared_metadata         = shared_metadata;
+	internal_handle->has_shared_chunks_cache = 1;
 
-				goto on_error;
-			}
-		}
+	return( 1 );
+
+on_error:
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
 	}
-	else if( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
+	return( -1 );
+}
+
+/* Grabs the shared metadata of the handle if it has any
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_grab_shared_metadata(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_grab_shared_metadata";
+
+	if( internal_handle == NULL )
 	{
-		/* Get the basename and store it in the segment tables
-		 */
-		filename_length = wide_string_length(
-				   filenames[ 0 ] );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
 
-		/* Set segment table basename
-		 */
-		if( libewf_segment_table_set_basename_wide(
-		     segment_table,
-		     filenames[ 0 ],
-		     filename_length,
+		return( -1 );
+	}
+	if( internal_handle->shared_metadata != NULL )
+	{
+		if( libewf_shared_metadata_grab(
+		     internal_handle->shared_metadata,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set basename in segment table.",
+			 "%s: unable to grab shared metadata.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
-		 function );
+	return( 1 );
+}
 
-		goto on_error;
-	}
-#endif
-	result = libewf_internal_handle_open_file_io_pool(
-	          internal_handle,
-	          file_io_pool,
-	          access_flags,
-	          segment_table,
-	          error );
+/* Releases the shared metadata of the handle if it has any
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_release_shared_metadata(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_release_shared_metadata";
 
-	if( result != 1 )
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_OPEN_FAILED,
-		 "%s: unable to open handle using a file IO pool.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
-	}
-	else
-	{
-		internal_handle->file_io_pool_created_in_library = 1;
-	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	result = libcthreads_read_write_lock_release_for_write(
-	          internal_handle->read_write_lock,
-	          error );
 
-	if( result != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
-		 function );
+		return( -1 );
 	}
-#endif
-	if( result != 1 )
+	if( internal_handle->shared_metadata != NULL )
 	{
-		goto on_error;
-	}
-	return( 1 );
+		if( libewf_shared_metadata_release(
+		     internal_handle->shared_metadata,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release shared metadata.",
+			 function );
 
-on_error:
-	if( segment_table != NULL )
-	{
-		libewf_segment_table_free(
-		 &segment_table,
-		 NULL );
-	}
-	if( file_io_handle != NULL )
-	{
-		libbfio_handle_free(
-		 &file_io_handle,
-		 NULL );
-	}
-	if( file_io_pool != NULL )
-	{
-		libbfio_pool_free(
-		 &file_io_pool,
-		 NULL );
+			return( -1 );
+		}
 	}
-	return( -1 );
+	return( 1 );
 }
 
-#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
-
-/* Reads the section data from a segment file
+/* Signals the handle to abort its current activity
  * Returns 1 if successful or -1 on error
  */
-int libewf_internal_handle_open_read_segment_file_section_data(
-     libewf_internal_handle_t *internal_handle,
-     libewf_segment_file_t *segment_file,
-     libbfio_pool_t *file_io_pool,
-     int file_io_pool_entry,
+int libewf_handle_signal_abort(
+     libewf_handle_t *handle,
      libcerror_error_t **error )
 {
-	libewf_header_sections_t *header_sections = NULL;
-	libewf_section_t *section                 = NULL;
-	libfcache_cache_t *sections_cache         = NULL;
-	uint8_t *string_data                      = NULL;
-	static char *function                     = "libewf_internal_handle_open_read_segment_file_section_data";
-	off64_t section_data_offset               = 0;
-	size_t string_data_size                   = 0;
-	ssize_t read_count                        = 0;
-	int initialize_chunk_values               = 0;
-	int header_section_found                  = 0;
-	int number_of_sections                    = 0;
-	int section_index                         = 0;
-	int set_identifier_change                 = 0;
-	int single_files_section_found            = 0;
-	int read_table_sections                   = 0;
-	int result                                = 0;
-
-#if defined( HAVE_VERBOSE_OUTPUT )
-	int known_section                         = 0;
-#endif
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_signal_abort";
 
-	if( internal_handle == NULL )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -1648,6 +1538,8 @@ int libewf_internal_handle_open_read_segment_file_section_data(
 
 		return( -1 );
 	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
 	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
@@ -1659,1286 +1551,5484 @@ int libewf_internal_handle_open_read_segment_file_section_data(
 
 		return( -1 );
 	}
-	if( internal_handle->read_io_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing read IO handle.",
-		 function );
+	internal_handle->io_handle->abort = 1;
 
-		return( -1 );
-	}
-	if( internal_handle->media_values == NULL )
+	return( 1 );
+}
+
+/* Opens a set of EWF file(s)
+ * For reading files should contain all filenames that make up an EWF image
+ * For writing files should contain the base of the filename, extentions like .e01 will be automatically added
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_open(
+     libewf_handle_t *handle,
+     char * const filenames[],
+     int number_of_filenames,
+     int access_flags,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle          = NULL;
+	libbfio_pool_t *file_io_pool              = NULL;
+	libewf_internal_handle_t *internal_handle = NULL;
+	libewf_segment_table_t *segment_table     = NULL;
+	char *first_segment_filename              = NULL;
+	static char *function                     = "libewf_handle_open";
+	size_t filename_length                    = 0;
+	int file_io_pool_entry                    = 0;
+	int filename_index                        = 0;
+	int maximum_number_of_open_handles        = 0;
+	int result                                = 0;
+
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->single_files == NULL )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( filenames == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing single files.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filenames.",
 		 function );
 
 		return( -1 );
 	}
-	if( segment_file == NULL )
+	if( number_of_filenames <= 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid segment file.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of files zero or less.",
 		 function );
 
 		return( -1 );
 	}
-	if( libfcache_cache_initialize(
-	     &sections_cache,
-	     LIBEWF_MAXIMUM_CACHE_ENTRIES_SECTIONS,
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create sections cache.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libewf_header_sections_initialize(
-	     &header_sections,
+#endif
+	maximum_number_of_open_handles = internal_handle->maximum_number_of_open_handles;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create header sections.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfdata_list_get_number_of_elements(
-	     segment_file->sections_list,
-	     &number_of_sections,
+#endif
+	if( libbfio_pool_initialize(
+	     &file_io_pool,
+	     0,
+	     maximum_number_of_open_handles,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve the number of sections in the sections list.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO pool.",
 		 function );
 
 		goto on_error;
 	}
-	/* Make sure to read the device information section first so we
-	 * have the correct chunk size when reading Lx01 files.
-	 */
-	if( segment_file->device_information_section_index >= 0 )
+	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
 	{
-		if( libfdata_list_get_element_value_by_index(
-		     segment_file->sections_list,
-		     (intptr_t *) file_io_pool,
-		     sections_cache,
-		     segment_file->device_information_section_index,
-		     (intptr_t **) &section,
-		     0,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve section: %d from sections list.",
-			 function,
-			 segment_file->device_information_section_index );
-
-			goto on_error;
-		}
-		if( section == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing section: %d.",
-			 function,
-			 segment_file->device_information_section_index );
-
-			goto on_error;
-		}
-		if( libewf_segment_file_seek_offset(
-		     segment_file,
-		     file_io_pool,
-		     file_io_pool_entry,
-		     section->start_offset,
-		     error ) == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_OPEN_FAILED,
-			 "%s: unable to seek section: %d data offset: %" PRIu64 ".",
-			 function,
-			 segment_file->device_information_section_index,
-			 section->start_offset );
-
-			goto on_error;
-		}
-		read_count = libewf_section_compressed_string_read(
-			      section,
-			      internal_handle->io_handle,
-			      file_io_pool,
-			      file_io_pool_entry,
-			      internal_handle->io_handle->compression_method,
-			      &string_data,
-			      &string_data_size,
-			      error );
-
-		if( read_count == -1 )
+		for( filename_index = 0;
+		     filename_index < number_of_filenames;
+		     filename_index++ )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read device information file object string.",
-			 function );
+			filename_length = narrow_string_length(
+					   filenames[ filename_index ] );
 
-			goto on_error;
-		}
-		else if( read_count != 0 )
-		{
-			if( internal_handle->read_io_handle->device_information == NULL )
+			/* Make sure there is more to the filename than the extension
+			 */
+			if( filename_length <= 4 )
 			{
-				if( libewf_device_information_parse(
-				     string_data,
-				     string_data_size,
-				     internal_handle->media_values,
-				     internal_handle->header_values,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-					 "%s: unable to parse device information.",
-					 function );
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+				 "%s: filename: %s is too small.",
+				 function,
+				 filenames[ filename_index ] );
 
-					goto on_error;
-				}
-				internal_handle->read_io_handle->device_information      = string_data;
-				internal_handle->read_io_handle->device_information_size = string_data_size;
+				goto on_error;
 			}
-			else
+			if( libbfio_file_initialize(
+			     &file_io_handle,
+			     error ) != 1 )
 			{
-				if( ( internal_handle->read_io_handle->device_information_size != string_data_size )
-				 || ( memory_compare(
-				       internal_handle->read_io_handle->device_information,
-				       string_data,
-				       16 ) != 0 ) )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_INPUT,
-					 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
-					 "%s: device information value mismatch.",
-					 function );
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create file IO handle.",
+				 function );
 
-					goto on_error;
-				}
-				memory_free(
-				 string_data );
+				goto on_error;
 			}
-			string_data = NULL;
-		}
-	}
-	for( section_index = 0;
-	     section_index < number_of_sections;
-	     section_index++ )
-	{
-		if( libfdata_list_get_element_value_by_index(
-		     segment_file->sections_list,
-		     (intptr_t *) file_io_pool,
-		     sections_cache,
-		     section_index,
-		     (intptr_t **) &section,
-		     0,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve section: %d from sections list.",
-			 function,
-			 section_index );
-
-			goto on_error;
-		}
-		result = libewf_section_get_data_offset(
-		          section,
-		          segment_file->major_version,
-		          &section_data_offset,
-		          error );
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libbfio_handle_set_track_offsets_read(
+			     file_io_handle,
+			     1,
+			     error ) != 1 )
+			{
+		                libcerror_error_set(
+		                 error,
+		                 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		                 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		                 "%s: unable to set track offsets read in file IO handle.",
+		                 function );
 
-		if( result == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve section: %d data offset.",
-			 function,
-			 section_index );
+				goto on_error;
+			}
+#endif
+			if( libbfio_file_set_name(
+			     file_io_handle,
+			     filenames[ filename_index ],
+			     filename_length,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set name in file IO handle.",
+				 function );
 
-			goto on_error;
-		}
-		else if( result != 0 )
-		{
-			if( libewf_segment_file_seek_offset(
-			     segment_file,
+				goto on_error;
+			}
+			if( libbfio_pool_append_handle(
 			     file_io_pool,
-			     file_io_pool_entry,
-			     section_data_offset,
-			     error ) == -1 )
+			     &file_io_pool_entry,
+			     file_io_handle,
+			     LIBBFIO_OPEN_READ,
+			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_OPEN_FAILED,
-				 "%s: unable to seek section: %d data offset: %" PRIu64 ".",
-				 function,
-				 section_index,
-				 section_data_offset );
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append file IO handle to pool.",
+				 function );
 
 				goto on_error;
 			}
+			file_io_handle = NULL;
+
 #if defined( HAVE_DEBUG_OUTPUT )
 			if( libcnotify_verbose != 0 )
 			{
-				if( segment_file->major_version == 1 )
-				{
-					libcnotify_printf(
-					 "%s: reading %s section data from file IO pool entry: %d at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
-					 function,
-					 (char *) section->type_string,
-					 file_io_pool_entry,
-					 segment_file->current_offset,
-					 segment_file->current_offset );
-				}
-				else if( segment_file->major_version == 2 )
+				libcnotify_printf(
+				 "%s: added file IO pool entry: %d with filename: %s.\n",
+				 function,
+				 file_io_pool_entry,
+				 filenames[ filename_index ] );
+			}
+#endif
+			if( ( filenames[ filename_index ][ filename_length - 3 ] == 'e' )
+			 || ( filenames[ filename_index ][ filename_length - 3 ] == 'E' )
+			 || ( filenames[ filename_index ][ filename_length - 3 ] == 'l' )
+			 || ( filenames[ filename_index ][ filename_length - 3 ] == 'L' )
+			 || ( filenames[ filename_index ][ filename_length - 3 ] == 's' )
+			 || ( filenames[ filename_index ][ filename_length - 3 ] == 'S' ) )
+			{
+				if( ( filenames[ filename_index ][ filename_length - 2 ] == '0' )
+				 && ( filenames[ filename_index ][ filename_length - 1 ] == '1' ) )
 				{
-					libcnotify_printf(
-					 "%s: reading 0x%08" PRIx32 " section data from file IO pool entry: %d at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
-					 function,
-					 section->type,
-					 file_io_pool_entry,
-					 segment_file->current_offset,
-					 segment_file->current_offset );
+					first_segment_filename = filenames[ filename_index ];
 				}
 			}
-#endif
 		}
-		if( section->type != 0 )
-		{
-			switch( section->type )
-			{
-				case LIBEWF_SECTION_TYPE_DEVICE_INFORMATION:
-					/* Since we already parsed it nothing to do for the device information section
-					 */
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
-#endif
-					break;
+	}
+	if( libewf_segment_table_initialize(
+	     &segment_table,
+	     internal_handle->io_handle,
+	     LIBEWF_DEFAULT_SEGMENT_FILE_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segment table.",
+		 function );
 
-				case LIBEWF_SECTION_TYPE_CASE_DATA:
-					read_count = libewf_section_compressed_string_read(
-						      section,
-						      internal_handle->io_handle,
-						      file_io_pool,
-						      file_io_pool_entry,
-						      internal_handle->io_handle->compression_method,
-						      &string_data,
-						      &string_data_size,
-						      error );
+		goto on_error;
+	}
+	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
+	{
+		/* Get the basename of the first segment file
+		 */
+		if( first_segment_filename != NULL )
+		{
+			filename_length = narrow_string_length(
+					   first_segment_filename );
 
-					if( read_count == -1 )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_IO,
-						 LIBCERROR_IO_ERROR_READ_FAILED,
-						 "%s: unable to read case data file object string.",
-						 function );
+			/* Set segment table basename
+			 */
+			if( libewf_segment_table_set_basename(
+			     segment_table,
+			     first_segment_filename,
+			     filename_length - 4,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set basename in segment table.",
+				 function );
 
-						goto on_error;
-					}
-					else if( read_count != 0 )
-					{
-						if( internal_handle->read_io_handle->case_data == NULL )
-						{
-							if( libewf_case_data_parse(
-							     string_data,
-							     string_data_size,
-							     internal_handle->media_values,
-							     internal_handle->header_values,
-							     &( internal_handle->io_handle->format ),
-							     error ) != 1 )
-							{
-								libcerror_error_set(
-								 error,
-								 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-								 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-								 "%s: unable to parse case data.",
-								 function );
+				goto on_error;
+			}
+		}
+	}
+	else if( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
+	{
+		/* Get the basename and store it in the segment tables
+		 */
+		filename_length = narrow_string_length(
+				   filenames[ 0 ] );
 
-								goto on_error;
-							}
-							internal_handle->read_io_handle->case_data      = string_data;
-							internal_handle->read_io_handle->case_data_size = string_data_size;
+		/* Set segment table basename
+		 */
+		if( libewf_segment_table_set_basename(
+		     segment_table,
+		     filenames[ 0 ],
+		     filename_length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set basename in segment table.",
+			 function );
 
-							initialize_chunk_values = 1;
-						}
-						else
-						{
-							if( ( internal_handle->read_io_handle->case_data_size != string_data_size )
-							 || ( memory_compare(
-							       internal_handle->read_io_handle->case_data,
-							       string_data,
-							       16 ) != 0 ) )
-							{
-								libcerror_error_set(
-								 error,
-								 LIBCERROR_ERROR_DOMAIN_INPUT,
-								 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
-								 "%s: case data value mismatch.",
-								 function );
+			goto on_error;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
 
-								goto on_error;
-							}
-							memory_free(
-							 string_data );
-						}
-						string_data = NULL;
-					}
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
+		goto on_error;
+	}
 #endif
-					break;
+	result = libewf_internal_handle_open_file_io_pool(
+	          internal_handle,
+	          file_io_pool,
+	          access_flags,
+	          segment_table,
+	          error );
 
-				case LIBEWF_SECTION_TYPE_SECTOR_DATA:
-#if defined( HAVE_VERBOSE_OUTPUT )
-					if( libcnotify_verbose != 0 )
-					{
-						if( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
-						{
-							libcnotify_printf(
-							 "%s: found sectors section in EWF-S01 format.\n",
-							 function );
-						}
-					}
-#endif
-					/* Nothing to do for the sectors section
-					 */
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle using a file IO pool.",
+		 function );
+	}
+	else
+	{
+		internal_handle->file_io_pool_created_in_library = 1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	result = libcthreads_read_write_lock_release_for_write(
+	          internal_handle->read_write_lock,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+	}
 #endif
-					break;
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
 
-				case LIBEWF_SECTION_TYPE_SECTOR_TABLE:
-					/* If the chunk_size was unknown when the segment file was opened we
-					 * have to read the chunk groups here
-					 */
-					if( segment_file->number_of_chunks == 0 )
-					{
-						read_table_sections = 1;
-					}
-					if( read_table_sections != 0 )
-					{
-						read_count = libewf_segment_file_read_table_section(
-							      segment_file,
-							      section,
-							      file_io_pool,
-							      file_io_pool_entry,
-							      internal_handle->media_values->chunk_size,
-							      error );
-					}
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
-#endif
-					break;
+on_error:
+	if( segment_table != NULL )
+	{
+		libewf_segment_table_free(
+		 &segment_table,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( file_io_pool != NULL )
+	{
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+	}
+	return( -1 );
+}
 
-				case LIBEWF_SECTION_TYPE_ERROR_TABLE:
-#if defined( HAVE_VERBOSE_OUTPUT )
-					if( libcnotify_verbose != 0 )
-					{
-						if( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
-						{
-							libcnotify_printf(
-							 "%s: found error section in EWF-S01 format.\n",
-							 function );
-						}
-					}
-#endif
-					read_count = libewf_section_error_read(
-						      section,
-						      internal_handle->io_handle,
-						      file_io_pool,
-						      file_io_pool_entry,
-						      segment_file->major_version,
-						      internal_handle->acquiry_errors,
-						      error );
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
 
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
-#endif
-					break;
+/* Opens a set of EWF file(s)
+ * For reading files should contain all filenames that make up an EWF image
+ * For writing files should contain the base of the filename, extentions like .e01 will be automatically added
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_open_wide(
+     libewf_handle_t *handle,
+     wchar_t * const filenames[],
+     int number_of_filenames,
+     int access_flags,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle          = NULL;
+	libbfio_pool_t *file_io_pool              = NULL;
+	libewf_internal_handle_t *internal_handle = NULL;
+	libewf_segment_table_t *segment_table     = NULL;
+	wchar_t *first_segment_filename           = NULL;
+	static char *function                     = "libewf_handle_open_wide";
+	size_t filename_length                    = 0;
+	int file_io_pool_entry                    = 0;
+	int filename_index                        = 0;
+	int maximum_number_of_open_handles        = 0;
+	int result                                = 0;
 
-				case LIBEWF_SECTION_TYPE_SESSION_TABLE:
-#if defined( HAVE_VERBOSE_OUTPUT )
-					if( libcnotify_verbose != 0 )
-					{
-						if( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
-						{
-							libcnotify_printf(
-							 "%s: found session section in EWF-S01 format.\n",
-							 function );
-						}
-					}
-#endif
-					read_count = libewf_section_session_read(
-						      section,
-						      internal_handle->io_handle,
-						      file_io_pool,
-						      file_io_pool_entry,
-						      segment_file->major_version,
-						      internal_handle->media_values,
-						      internal_handle->sessions,
-						      internal_handle->tracks,
-						      error );
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
 
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
-#endif
-					break;
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
 
-				case LIBEWF_SECTION_TYPE_INCREMENT_DATA:
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
-#endif
-					break;
+	if( filenames == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filenames.",
+		 function );
 
-				case LIBEWF_SECTION_TYPE_MD5_HASH:
-					read_count = libewf_section_md5_hash_read(
-						      section,
-						      internal_handle->io_handle,
-						      file_io_pool,
-						      file_io_pool_entry,
-						      segment_file->major_version,
-						      internal_handle->hash_sections,
-						      error );
+		return( -1 );
+	}
+	if( number_of_filenames <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of files zero or less.",
+		 function );
 
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
 #endif
-					break;
+	maximum_number_of_open_handles = internal_handle->maximum_number_of_open_handles;
 
-				case LIBEWF_SECTION_TYPE_SHA1_HASH:
-					read_count = libewf_section_sha1_hash_read(
-						      section,
-						      internal_handle->io_handle,
-						      file_io_pool,
-						      file_io_pool_entry,
-						      internal_handle->hash_sections,
-						      error );
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
 
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
+		return( -1 );
+	}
 #endif
-					break;
-
-				case LIBEWF_SECTION_TYPE_RESTART_DATA:
-					read_count = libewf_section_compressed_string_read(
-						      section,
-					              internal_handle->io_handle,
-						      file_io_pool,
-						      file_io_pool_entry,
-					              internal_handle->io_handle->compression_method,
-						      &string_data,
-						      &string_data_size,
-						      error );
+	if( libbfio_pool_initialize(
+	     &file_io_pool,
+	     0,
+	     maximum_number_of_open_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO pool.",
+		 function );
 
-					if( read_count == -1 )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_IO,
-						 LIBCERROR_IO_ERROR_READ_FAILED,
-						 "%s: unable to read restart data file object string.",
-						 function );
+		goto on_error;
+	}
+	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
+	{
+		for( filename_index = 0;
+		     filename_index < number_of_filenames;
+		     filename_index++ )
+		{
+			filename_length = wide_string_length(
+					   filenames[ filename_index ] );
 
-						goto on_error;
-					}
-					if( libewf_restart_data_parse(
-					     string_data,
-					     string_data_size,
-					     error ) != 1 )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-						 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-						 "%s: unable to parse restart data.",
-						 function );
+			/* Make sure there is more to the filename than the extension
+			 */
+			if( filename_length <= 4 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+				 "%s: filename: %ls is too small.",
+				 function,
+				 filenames[ filename_index ] );
 
-						goto on_error;
-					}
-					memory_free(
-					 string_data );
-
-					string_data = NULL;
+				goto on_error;
+			}
+			if( libbfio_file_initialize(
+			     &file_io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create file IO handle.",
+				 function );
 
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
-#endif
-					break;
+				goto on_error;
+			}
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libbfio_handle_set_track_offsets_read(
+			     file_io_handle,
+			     1,
+			     error ) != 1 )
+			{
+		                libcerror_error_set(
+		                 error,
+		                 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		                 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		                 "%s: unable to set track offsets read in file IO handle.",
+		                 function );
 
-				case LIBEWF_SECTION_TYPE_ENCRYPTION_KEYS:
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
+				goto on_error;
+			}
 #endif
-					break;
+			if( libbfio_file_set_name_wide(
+			     file_io_handle,
+			     filenames[ filename_index ],
+			     filename_length,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set name in file IO handle.",
+				 function );
 
-				case LIBEWF_SECTION_TYPE_MEMORY_EXTENTS_TABLE:
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
-#endif
-					break;
+				goto on_error;
+			}
+			if( libbfio_pool_append_handle(
+			     file_io_pool,
+			     &file_io_pool_entry,
+			     file_io_handle,
+			     LIBBFIO_OPEN_READ,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append file IO handle to pool.",
+				 function );
 
-				case LIBEWF_SECTION_TYPE_NEXT:
-					/* Nothing to do for the next section
-					 */
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
-#endif
-					break;
+				goto on_error;
+			}
+			file_io_handle = NULL;
 
-				case LIBEWF_SECTION_TYPE_FINAL_INFORMATION:
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: added file IO pool entry: %d with filename: %ls.\n",
+				 function,
+				 file_io_pool_entry,
+				 filenames[ filename_index ] );
+			}
 #endif
-					break;
+			if( ( filenames[ filename_index ][ filename_length - 3 ] == 'e' )
+			 || ( filenames[ filename_index ][ filename_length - 3 ] == 'E' )
+			 || ( filenames[ filename_index ][ filename_length - 3 ] == 'l' )
+			 || ( filenames[ filename_index ][ filename_length - 3 ] == 'L' )
+			 || ( filenames[ filename_index ][ filename_length - 3 ] == 's' )
+			 || ( filenames[ filename_index ][ filename_length - 3 ] == 'S' ) )
+			{
+				if( ( filenames[ filename_index ][ filename_length - 2 ] == '0' )
+				 && ( filenames[ filename_index ][ filename_length - 1 ] == '1' ) )
+				{
+					first_segment_filename = filenames[ filename_index ];
+				}
+			}
+		}
+	}
+	if( libewf_segment_table_initialize(
+	     &segment_table,
+	     internal_handle->io_handle,
+	     LIBEWF_DEFAULT_SEGMENT_FILE_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segment table.",
+		 function );
 
-				case LIBEWF_SECTION_TYPE_DONE:
-					/* Nothing to do for the done section
-					 */
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
-#endif
-					break;
+		goto on_error;
+	}
+	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
+	{
+		/* Get the basename of the first segment file
+		 */
+		if( first_segment_filename != NULL )
+		{
+			filename_length = wide_string_length(
+					   first_segment_filename );
 
-				case LIBEWF_SECTION_TYPE_ANALYTICAL_DATA:
-					read_count = libewf_section_compressed_string_read(
-						      section,
-					              internal_handle->io_handle,
-						      file_io_pool,
-						      file_io_pool_entry,
-					              internal_handle->io_handle->compression_method,
-						      &string_data,
-						      &string_data_size,
-						      error );
+			/* Set segment table basename
+			 */
+			if( libewf_segment_table_set_basename_wide(
+			     segment_table,
+			     first_segment_filename,
+			     filename_length - 4,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set basename in segment table.",
+				 function );
 
-					if( read_count == -1 )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_IO,
-						 LIBCERROR_IO_ERROR_READ_FAILED,
-						 "%s: unable to read analytical data file object string.",
-						 function );
+				goto on_error;
+			}
+		}
+	}
+	else if( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
+	{
+		/* Get the basename and store it in the segment tables
+		 */
+		filename_length = wide_string_length(
+				   filenames[ 0 ] );
 
-						goto on_error;
-					}
-					else if( read_count != 0 )
-					{
-						if( libewf_analytical_data_parse(
-						     string_data,
-						     string_data_size,
-						     error ) != 1 )
-						{
-							libcerror_error_set(
-							 error,
-							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-							 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-							 "%s: unable to parse analytical data.",
-							 function );
+		/* Set segment table basename
+		 */
+		if( libewf_segment_table_set_basename_wide(
+		     segment_table,
+		     filenames[ 0 ],
+		     filename_length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set basename in segment table.",
+			 function );
 
-							goto on_error;
-						}
-						memory_free(
-						 string_data );
+			goto on_error;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
 
-						string_data = NULL;
-					}
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
+		goto on_error;
+	}
 #endif
-					break;
+	result = libewf_internal_handle_open_file_io_pool(
+	          internal_handle,
+	          file_io_pool,
+	          access_flags,
+	          segment_table,
+	          error );
 
-				case LIBEWF_SECTION_TYPE_SINGLE_FILES_DATA:
-#if defined( HAVE_VERBOSE_OUTPUT )
-					if( ( internal_handle->io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_EWF1_LOGICAL )
-					 && ( internal_handle->io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_EWF2_LOGICAL ) )
-					{
-						if( libcnotify_verbose != 0 )
-						{
-							libcnotify_printf(
-							 "%s: found single files data section in none logical evidence format.\n",
-							 function );
-						}
-					}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle using a file IO pool.",
+		 function );
+	}
+	else
+	{
+		internal_handle->file_io_pool_created_in_library = 1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	result = libcthreads_read_write_lock_release_for_write(
+	          internal_handle->read_write_lock,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+	}
 #endif
-					read_count = libewf_section_ltree_read(
-						      section,
-						      internal_handle->io_handle,
-						      file_io_pool,
-						      file_io_pool_entry,
-						      segment_file->major_version,
-						      &( internal_handle->single_files->section_data ),
-						      &( internal_handle->single_files->section_data_size ),
-						      &( internal_handle->single_files->ltree_data ),
-						      &( internal_handle->single_files->ltree_data_size ),
-						      error );
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
 
-					single_files_section_found = 1;
+on_error:
+	if( segment_table != NULL )
+	{
+		libewf_segment_table_free(
+		 &segment_table,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( file_io_pool != NULL )
+	{
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+	}
+	return( -1 );
+}
 
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
-#endif
-					break;
-			}
-		}
-		else if( section->type_string_length == 4 )
-		{
-			if( memory_compare(
-			     (void *) section->type_string,
-			     (void *) "data",
-			     4 ) == 0 )
-			{
-#if defined( HAVE_VERBOSE_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					if( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
-					{
-						libcnotify_printf(
-						 "%s: found data section in EWF-S01 format.\n",
-						 function );
-					}
-				}
-#endif
-				read_count = libewf_section_data_read(
-					      section,
-					      internal_handle->io_handle,
-					      file_io_pool,
-					      file_io_pool_entry,
-					      internal_handle->media_values,
-				              &set_identifier_change,
-				              error );
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
 
-				if( set_identifier_change != 0 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_INPUT,
-					 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
-					 "%s: set identifier does not match.",
-					 function );
+/* Reads the section data from a segment file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_open_read_segment_file_section_data(
+     libewf_internal_handle_t *internal_handle,
+     libewf_segment_file_t *segment_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libcerror_error_t **error )
+{
+	libewf_header_sections_t *header_sections = NULL;
+	libewf_section_t *section                 = NULL;
+	libfcache_cache_t *sections_cache         = NULL;
+	uint8_t *string_data                      = NULL;
+	static char *function                     = "libewf_internal_handle_open_read_segment_file_section_data";
+	off64_t section_data_offset               = 0;
+	size_t string_data_size                   = 0;
+	ssize_t read_count                        = 0;
+	int initialize_chunk_values               = 0;
+	int header_section_found                  = 0;
+	int number_of_sections                    = 0;
+	int section_index                         = 0;
+	int set_identifier_change                 = 0;
+	int single_files_section_found            = 0;
+	int read_table_sections                   = 0;
+	int result                                = 0;
 
-					goto on_error;
-				}
 #if defined( HAVE_VERBOSE_OUTPUT )
-				known_section = 1;
+	int known_section                         = 0;
 #endif
-			}
-			else if( memory_compare(
-				  (void *) section->type_string,
-				  (void *) "disk",
-				  4 ) == 0 )
-			{
-				read_count = libewf_segment_file_read_volume_section(
-					      segment_file,
-					      section,
-					      file_io_pool,
-					      file_io_pool_entry,
-					      internal_handle->media_values,
-					      error );
 
-				initialize_chunk_values = 1;
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
 
-#if defined( HAVE_VERBOSE_OUTPUT )
-				known_section = 1;
-#endif
-			}
-		}
-		else if( section->type_string_length == 5 )
-		{
-			if( memory_compare(
-			     (void *) section->type_string,
-			     (void *) "xhash",
-			     5 ) == 0 )
-			{
-#if defined( HAVE_VERBOSE_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					if( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
-					{
-						libcnotify_printf(
-						 "%s: found xhash section in EWF-S01 format.\n",
-						 function );
-					}
-				}
-#endif
-				read_count = libewf_section_compressed_string_read(
-					      section,
-				              internal_handle->io_handle,
-					      file_io_pool,
-					      file_io_pool_entry,
-					      internal_handle->io_handle->compression_method,
-					      &string_data,
-					      &string_data_size,
-					      error );
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
 
-				if( read_count == -1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read xhash string.",
-					 function );
+		return( -1 );
+	}
+	if( internal_handle->read_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing read IO handle.",
+		 function );
 
-					goto on_error;
-				}
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					 if( libewf_debug_utf8_stream_print(
-					      "XHash",
-					      string_data,
-					      string_data_size,
-					      error ) != 1 )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-						 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-						 "%s: unable to print xhash.",
-						 function );
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
 
-						goto on_error;
-					}
-				}
-#endif
-				if( internal_handle->hash_sections->xhash == NULL )
-				{
-					internal_handle->hash_sections->xhash      = string_data;
-					internal_handle->hash_sections->xhash_size = string_data_size;
-				}
-				else
-				{
-					memory_free(
-					 string_data );
+		return( -1 );
+	}
+	if( internal_handle->single_files == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing single files.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfcache_cache_initialize(
+	     &sections_cache,
+	     LIBEWF_MAXIMUM_CACHE_ENTRIES_SECTIONS,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create sections cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_header_sections_initialize(
+	     &header_sections,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create header sections.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_list_get_number_of_elements(
+	     segment_file->sections_list,
+	     &number_of_sections,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve the number of sections in the sections list.",
+		 function );
+
+		goto on_error;
+	}
+	/* Make sure to read the device information section first so we
+	 * have the correct chunk size when reading Lx01 files.
+	 */
+	if( segment_file->device_information_section_index >= 0 )
+	{
+		if( libfdata_list_get_element_value_by_index(
+		     segment_file->sections_list,
+		     (intptr_t *) file_io_pool,
+		     sections_cache,
+		     segment_file->device_information_section_index,
+		     (intptr_t **) &section,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve section: %d from sections list.",
+			 function,
+			 segment_file->device_information_section_index );
+
+			goto on_error;
+		}
+		if( section == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing section: %d.",
+			 function,
+			 segment_file->device_information_section_index );
+
+			goto on_error;
+		}
+		if( libewf_segment_file_seek_offset(
+		     segment_file,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     section->start_offset,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to seek section: %d data offset: %" PRIu64 ".",
+			 function,
+			 segment_file->device_information_section_index,
+			 section->start_offset );
+
+			goto on_error;
+		}
+		read_count = libewf_section_compressed_string_read(
+			      section,
+			      internal_handle->io_handle,
+			      file_io_pool,
+			      file_io_pool_entry,
+			      internal_handle->io_handle->compression_method,
+			      &string_data,
+			      &string_data_size,
+			      error );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read device information file object string.",
+			 function );
+
+			goto on_error;
+		}
+		else if( read_count != 0 )
+		{
+			if( internal_handle->read_io_handle->device_information == NULL )
+			{
+				if( libewf_device_information_parse(
+				     string_data,
+				     string_data_size,
+				     internal_handle->media_values,
+				     internal_handle->header_values,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to parse device information.",
+					 function );
+
+					goto on_error;
 				}
-				string_data = NULL;
-#if defined( HAVE_VERBOSE_OUTPUT )
-				known_section = 1;
-#endif
+				internal_handle->read_io_handle->device_information      = string_data;
+				internal_handle->read_io_handle->device_information_size = string_data_size;
+			}
+			else
+			{
+				if( ( internal_handle->read_io_handle->device_information_size != string_data_size )
+				 || ( memory_compare(
+				       internal_handle->read_io_handle->device_information,
+				       string_data,
+				       16 ) != 0 ) )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_INPUT,
+					 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+					 "%s: device information value mismatch.",
+					 function );
+
+					goto on_error;
+				}
+				memory_free(
+				 string_data );
+			}
+			string_data = NULL;
+		}
+	}
+	for( section_index = 0;
+	     section_index < number_of_sections;
+	     section_index++ )
+	{
+		if( libfdata_list_get_element_value_by_index(
+		     segment_file->sections_list,
+		     (intptr_t *) file_io_pool,
+		     sections_cache,
+		     section_index,
+		     (intptr_t **) &section,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve section: %d from sections list.",
+			 function,
+			 section_index );
+
+			goto on_error;
+		}
+		result = libewf_section_get_data_offset(
+		          section,
+		          segment_file->major_version,
+		          &section_data_offset,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve section: %d data offset.",
+			 function,
+			 section_index );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			if( libewf_segment_file_seek_offset(
+			     segment_file,
+			     file_io_pool,
+			     file_io_pool_entry,
+			     section_data_offset,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to seek section: %d data offset: %" PRIu64 ".",
+				 function,
+				 section_index,
+				 section_data_offset );
+
+				goto on_error;
 			}
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				if( segment_file->major_version == 1 )
+				{
+					libcnotify_printf(
+					 "%s: reading %s section data from file IO pool entry: %d at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+					 function,
+					 (char *) section->type_string,
+					 file_io_pool_entry,
+					 segment_file->current_offset,
+					 segment_file->current_offset );
+				}
+				else if( segment_file->major_version == 2 )
+				{
+					libcnotify_printf(
+					 "%s: reading 0x%08" PRIx32 " section data from file IO pool entry: %d at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+					 function,
+					 section->type,
+					 file_io_pool_entry,
+					 segment_file->current_offset,
+					 segment_file->current_offset );
+				}
+			}
+#endif
+		}
+		if( section->type != 0 )
+		{
+			switch( section->type )
+			{
+				case LIBEWF_SECTION_TYPE_DEVICE_INFORMATION:
+					/* Since we already parsed it nothing to do for the device information section
+					 */
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_CASE_DATA:
+					read_count = libewf_section_compressed_string_read(
+						      section,
+						      internal_handle->io_handle,
+						      file_io_pool,
+						      file_io_pool_entry,
+						      internal_handle->io_handle->compression_method,
+						      &string_data,
+						      &string_data_size,
+						      error );
+
+					if( read_count == -1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_READ_FAILED,
+						 "%s: unable to read case data file object string.",
+						 function );
+
+						goto on_error;
+					}
+					else if( read_count != 0 )
+					{
+						if( internal_handle->read_io_handle->case_data == NULL )
+						{
+							if( libewf_case_data_parse(
+							     string_data,
+							     string_data_size,
+							     internal_handle->media_values,
+							     internal_handle->header_values,
+							     &( internal_handle->io_handle->format ),
+							     error ) != 1 )
+							{
+								libcerror_error_set(
+								 error,
+								 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+								 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+								 "%s: unable to parse case data.",
+								 function );
+
+								goto on_error;
+							}
+							internal_handle->read_io_handle->case_data      = string_data;
+							internal_handle->read_io_handle->case_data_size = string_data_size;
+
+							initialize_chunk_values = 1;
+						}
+						else
+						{
+							if( ( internal_handle->read_io_handle->case_data_size != string_data_size )
+							 || ( memory_compare(
+							       internal_handle->read_io_handle->case_data,
+							       string_data,
+							       16 ) != 0 ) )
+							{
+								libcerror_error_set(
+								 error,
+								 LIBCERROR_ERROR_DOMAIN_INPUT,
+								 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+								 "%s: case data value mismatch.",
+								 function );
+
+								goto on_error;
+							}
+							memory_free(
+							 string_data );
+						}
+						string_data = NULL;
+					}
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_SECTOR_DATA:
+#if defined( HAVE_VERBOSE_OUTPUT )
+					if( libcnotify_verbose != 0 )
+					{
+						if( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
+						{
+							libcnotify_printf(
+							 "%s: found sectors section in EWF-S01 format.\n",
+							 function );
+						}
+					}
+#endif
+					/* Nothing to do for the sectors section
+					 */
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_SECTOR_TABLE:
+					/* If the chunk_size was unknown when the segment file was opened we
+					 * have to read the chunk groups here
+					 */
+					if( segment_file->number_of_chunks == 0 )
+					{
+						read_table_sections = 1;
+					}
+					if( read_table_sections != 0 )
+					{
+						read_count = libewf_segment_file_read_table_section(
+							      segment_file,
+							      section,
+							      file_io_pool,
+							      file_io_pool_entry,
+							      internal_handle->media_values->chunk_size,
+							      error );
+					}
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_ERROR_TABLE:
+#if defined( HAVE_VERBOSE_OUTPUT )
+					if( libcnotify_verbose != 0 )
+					{
+						if( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
+						{
+							libcnotify_printf(
+							 "%s: found error section in EWF-S01 format.\n",
+							 function );
+						}
+					}
+#endif
+					read_count = libewf_section_error_read(
+						      section,
+						      internal_handle->io_handle,
+						      file_io_pool,
+						      file_io_pool_entry,
+						      segment_file->major_version,
+						      internal_handle->acquiry_errors,
+						      error );
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_SESSION_TABLE:
+#if defined( HAVE_VERBOSE_OUTPUT )
+					if( libcnotify_verbose != 0 )
+					{
+						if( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
+						{
+							libcnotify_printf(
+							 "%s: found session section in EWF-S01 format.\n",
+							 function );
+						}
+					}
+#endif
+					read_count = libewf_section_session_read(
+						      section,
+						      internal_handle->io_handle,
+						      file_io_pool,
+						      file_io_pool_entry,
+						      segment_file->major_version,
+						      internal_handle->media_values,
+						      internal_handle->sessions,
+						      internal_handle->tracks,
+						      error );
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_INCREMENT_DATA:
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_MD5_HASH:
+					read_count = libewf_section_md5_hash_read(
+						      section,
+						      internal_handle->io_handle,
+						      file_io_pool,
+						      file_io_pool_entry,
+						      segment_file->major_version,
+						      internal_handle->hash_sections,
+						      error );
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_SHA1_HASH:
+					read_count = libewf_section_sha1_hash_read(
+						      section,
+						      internal_handle->io_handle,
+						      file_io_pool,
+						      file_io_pool_entry,
+						      internal_handle->hash_sections,
+						      error );
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_RESTART_DATA:
+					read_count = libewf_section_compressed_string_read(
+						      section,
+					              internal_handle->io_handle,
+						      file_io_pool,
+						      file_io_pool_entry,
+					              internal_handle->io_handle->compression_method,
+						      &string_data,
+						      &string_data_size,
+						      error );
+
+					if( read_count == -1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_READ_FAILED,
+						 "%s: unable to read restart data file object string.",
+						 function );
+
+						goto on_error;
+					}
+					if( libewf_restart_data_parse(
+					     string_data,
+					     string_data_size,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+						 "%s: unable to parse restart data.",
+						 function );
+
+						goto on_error;
+					}
+					memory_free(
+					 string_data );
+
+					string_data = NULL;
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_ENCRYPTION_KEYS:
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_MEMORY_EXTENTS_TABLE:
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_NEXT:
+					/* Nothing to do for the next section
+					 */
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_FINAL_INFORMATION:
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_DONE:
+					/* Nothing to do for the done section
+					 */
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_ANALYTICAL_DATA:
+					read_count = libewf_section_compressed_string_read(
+						      section,
+					              internal_handle->io_handle,
+						      file_io_pool,
+						      file_io_pool_entry,
+					              internal_handle->io_handle->compression_method,
+						      &string_data,
+						      &string_data_size,
+						      error );
+
+					if( read_count == -1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_READ_FAILED,
+						 "%s: unable to read analytical data file object string.",
+						 function );
+
+						goto on_error;
+					}
+					else if( read_count != 0 )
+					{
+						if( libewf_analytical_data_parse(
+						     string_data,
+						     string_data_size,
+						     error ) != 1 )
+						{
+							libcerror_error_set(
+							 error,
+							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+							 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+							 "%s: unable to parse analytical data.",
+							 function );
+
+							goto on_error;
+						}
+						memory_free(
+						 string_data );
+
+						string_data = NULL;
+					}
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_SINGLE_FILES_DATA:
+#if defined( HAVE_VERBOSE_OUTPUT )
+					if( ( internal_handle->io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_EWF1_LOGICAL )
+					 && ( internal_handle->io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_EWF2_LOGICAL ) )
+					{
+						if( libcnotify_verbose != 0 )
+						{
+							libcnotify_printf(
+							 "%s: found single files data section in none logical evidence format.\n",
+							 function );
+						}
+					}
+#endif
+					read_count = libewf_section_ltree_read(
+						      section,
+						      internal_handle->io_handle,
+						      file_io_pool,
+						      file_io_pool_entry,
+						      segment_file->major_version,
+						      &( internal_handle->single_files->section_data ),
+						      &( internal_handle->single_files->section_data_size ),
+						      &( internal_handle->single_files->ltree_data ),
+						      &( internal_handle->single_files->ltree_data_size ),
+						      error );
+
+					single_files_section_found = 1;
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+			}
+		}
+		else if( section->type_string_length == 4 )
+		{
+			if( memory_compare(
+			     (void *) section->type_string,
+			     (void *) "data",
+			     4 ) == 0 )
+			{
+#if defined( HAVE_VERBOSE_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					if( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
+					{
+						libcnotify_printf(
+						 "%s: found data section in EWF-S01 format.\n",
+						 function );
+					}
+				}
+#endif
+				read_count = libewf_section_data_read(
+					      section,
+					      internal_handle->io_handle,
+					      file_io_pool,
+					      file_io_pool_entry,
+					      internal_handle->media_values,
+				              &set_identifier_change,
+				              error );
+
+				if( set_identifier_change != 0 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_INPUT,
+					 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+					 "%s: set identifier does not match.",
+					 function );
+
+					goto on_error;
+				}
+#if defined( HAVE_VERBOSE_OUTPUT )
+				known_section = 1;
+#endif
+			}
+			else if( memory_compare(
+				  (void *) section->type_string,
+				  (void *) "disk",
+				  4 ) == 0 )
+			{
+				read_count = libewf_segment_file_read_volume_section(
+					      segment_file,
+					      section,
+					      file_io_pool,
+					      file_io_pool_entry,
+					      internal_handle->media_values,
+					      error );
+
+				initialize_chunk_values = 1;
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+				known_section = 1;
+#endif
+			}
+		}
+		else if( section->type_string_length == 5 )
+		{
+			if( memory_compare(
+			     (void *) section->type_string,
+			     (void *) "xhash",
+			     5 ) == 0 )
+			{
+#if defined( HAVE_VERBOSE_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					if( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
+					{
+						libcnotify_printf(
+						 "%s: found xhash section in EWF-S01 format.\n",
+						 function );
+					}
+				}
+#endif
+				read_count = libewf_section_compressed_string_read(
+					      section,
+				              internal_handle->io_handle,
+					      file_io_pool,
+					      file_io_pool_entry,
+					      internal_handle->io_handle->compression_method,
+					      &string_data,
+					      &string_data_size,
+					      error );
+
+				if( read_count == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read xhash string.",
+					 function );
+
+					goto on_error;
+				}
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					 if( libewf_debug_utf8_stream_print(
+					      "XHash",
+					      string_data,
+					      string_data_size,
+					      error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+						 "%s: unable to print xhash.",
+						 function );
+
+						goto on_error;
+					}
+				}
+#endif
+				if( internal_handle->hash_sections->xhash == NULL )
+				{
+					internal_handle->hash_sections->xhash      = string_data;
+					internal_handle->hash_sections->xhash_size = string_data_size;
+				}
+				else
+				{
+					memory_free(
+					 string_data );
+				}
+				string_data = NULL;
+#if defined( HAVE_VERBOSE_OUTPUT )
+				known_section = 1;
+#endif
+			}
+		}
+		else if( section->type_string_length == 6 )
+		{
+			if( memory_compare(
+			     (void *) section->type_string,
+			     (void *) "digest",
+			     6 ) == 0 )
+			{
+#if defined( HAVE_VERBOSE_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					if( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
+					{
+						libcnotify_printf(
+						 "%s: found digest section in EWF-S01 format.\n",
+						 function );
+					}
+				}
+#endif
+				read_count = libewf_section_digest_read(
+					      section,
+				              internal_handle->io_handle,
+					      file_io_pool,
+					      file_io_pool_entry,
+					      internal_handle->hash_sections,
+					      error );
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+				known_section = 1;
+#endif
+			}
+			else if( memory_compare(
+				  (void *) section->type_string,
+				  (void *) "header",
+				  6 ) == 0 )
+			{
+				read_count = libewf_section_compressed_string_read(
+					      section,
+				              internal_handle->io_handle,
+					      file_io_pool,
+					      file_io_pool_entry,
+				              internal_handle->io_handle->compression_method,
+					      &string_data,
+					      &string_data_size,
+					      error );
+
+				if( read_count == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read header file object string.",
+					 function );
+
+					goto on_error;
+				}
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					if( libewf_debug_byte_stream_print(
+					     "Header",
+					     string_data,
+					     string_data_size,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+						 "%s: unable to print header.",
+						 function );
+
+						goto on_error;
+					}
+				}
+#endif
+				if( header_sections->header == NULL )
+				{
+					header_sections->header      = string_data;
+					header_sections->header_size = string_data_size;
+				}
+				else
+				{
+					memory_free(
+					 string_data );
+				}
+				string_data = NULL;
+
+				header_sections->number_of_header_sections += 1;
+
+				header_section_found = 1;
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+				known_section = 1;
+#endif
+			}
+			else if( memory_compare(
+				  (void *) section->type_string,
+				  (void *) "table2",
+				  6 ) == 0 )
+			{
+				if( read_table_sections != 0 )
+				{
+					read_count = libewf_segment_file_read_table2_section(
+						      segment_file,
+						      section,
+						      file_io_pool,
+						      file_io_pool_entry,
+						      error );
+				}
+#if defined( HAVE_VERBOSE_OUTPUT )
+				known_section = 1;
+#endif
+			}
+			else if( memory_compare(
+				  (void *) section->type_string,
+				  (void *) "volume",
+				  6 ) == 0 )
+			{
+				read_count = libewf_segment_file_read_volume_section(
+					      segment_file,
+					      section,
+					      file_io_pool,
+					      file_io_pool_entry,
+					      internal_handle->media_values,
+					      error );
+
+				initialize_chunk_values = 1;
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+				known_section = 1;
+#endif
+			}
+		}
+		else if( section->type_string_length == 7 )
+		{
+			if( memory_compare(
+			     (void *) section->type_string,
+			     (void *) "header2",
+			     7 ) == 0 )
+			{
+				read_count = libewf_section_compressed_string_read(
+					      section,
+				              internal_handle->io_handle,
+					      file_io_pool,
+					      file_io_pool_entry,
+				              internal_handle->io_handle->compression_method,
+					      &string_data,
+					      &string_data_size,
+					      error );
+
+				if( read_count == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read header2 file object string.",
+					 function );
+
+					goto on_error;
+				}
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					if( libewf_debug_utf16_stream_print(
+					     "Header2",
+					     string_data,
+					     string_data_size,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+						 "%s: unable to print header2.",
+						 function );
+
+						goto on_error;
+					}
+				}
+#endif
+				if( header_sections->header2 == NULL )
+				{
+					header_sections->header2      = string_data;
+					header_sections->header2_size = string_data_size;
+				}
+				else
+				{
+					memory_free(
+					 string_data );
+				}
+				string_data = NULL;
+
+				header_sections->number_of_header_sections += 1;
+
+				header_section_found = 1;
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+				known_section = 1;
+#endif
+			}
+			else if( memory_compare(
+				  (void *) section->type_string,
+				  (void *) "xheader",
+				  7 ) == 0 )
+			{
+				read_count = libewf_section_compressed_string_read(
+					      section,
+				              internal_handle->io_handle,
+					      file_io_pool,
+					      file_io_pool_entry,
+				              internal_handle->io_handle->compression_method,
+					      &string_data,
+					      &string_data_size,
+					      error );
+
+				if( read_count == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read xheader string.",
+					 function );
+
+					goto on_error;
+				}
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					if( libewf_debug_utf8_stream_print(
+					     "XHeader",
+					     string_data,
+					     string_data_size,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+						 "%s: unable to print xheader.",
+						 function );
+
+						goto on_error;
+					}
+				}
+#endif
+				if( header_sections->xheader == NULL )
+				{
+					header_sections->xheader      = string_data;
+					header_sections->xheader_size = string_data_size;
+				}
+				else
+				{
+					memory_free(
+					 string_data );
+				}
+				string_data = NULL;
+
+				header_sections->number_of_header_sections += 1;
+
+				header_section_found = 1;
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+				known_section = 1;
+#endif
+			}
+		}
+		else if( section->type_string_length == 8 )
+		{
+			if( memory_compare(
+			     (void *) section->type_string,
+			     (void *) "hashtree",
+			     8 ) == 0 )
+			{
+				read_count = libewf_section_hash_tree_read(
+					      section,
+				              internal_handle->io_handle,
+					      file_io_pool,
+					      file_io_pool_entry,
+					      internal_handle->hash_sections,
+					      error );
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+				known_section = 1;
+#endif
+			}
+		}
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			if( known_section == 0 )
+			{
+				if( segment_file->major_version == 1 )
+				{
+					libcnotify_printf(
+					 "%s: unsupported section type: %s.\n",
+					 function,
+					 (char *) section->type_string );
+				}
+				else if( segment_file->major_version == 2 )
+				{
+					libcnotify_printf(
+					 "%s: unsupported section type: 0x%08" PRIx32 ".\n",
+					 function,
+					 section->type );
+				}
+			}
+		}
+#endif
+		if( read_count == -1 )
+		{
+			if( section->type_string_length > 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read section: %s.",
+				 function,
+				 (char *) section->type_string );
+			}
+			else
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read section: 0x%08" PRIx32 ".",
+				 function,
+				 section->type );
+			}
+			goto on_error;
+		}
+		if( initialize_chunk_values != 0 )
+		{
+			if( segment_file->type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
+			{
+				segment_file->io_handle->segment_file_type = LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART;
+				segment_file->io_handle->format            = LIBEWF_FORMAT_SMART;
+			}
+			if( libewf_media_values_calculate_chunk_size(
+			     internal_handle->media_values,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to calculate chunk size.",
+				 function );
+
+				goto on_error;
+			}
+/* TODO refactor */
+			internal_handle->io_handle->chunk_size = internal_handle->media_values->chunk_size;
+
+			/* Do a preliminary dection of the EWF format for reading the sector table section
+			 */
+			if( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1 )
+			{
+				if( header_sections->number_of_header_sections == 1 )
+				{
+					internal_handle->io_handle->format = LIBEWF_FORMAT_ENCASE1;
+				}
+				else if( internal_handle->media_values->error_granularity == 0 )
+				{
+					internal_handle->io_handle->format = LIBEWF_FORMAT_ENCASE2;
+				}
+			}
+			initialize_chunk_values = 0;
+		}
+	}
+	if( header_section_found != 0 )
+	{
+		if( libewf_header_sections_parse(
+		     header_sections,
+		     internal_handle->io_handle,
+		     internal_handle->header_values,
+		     &( internal_handle->io_handle->format ),
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to parse header sections.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( single_files_section_found != 0 )
+	{
+		if( libewf_single_files_parse(
+		     internal_handle->single_files,
+		     &( internal_handle->media_values->media_size ),
+		     &( internal_handle->io_handle->format ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to parse single files.",
+			 function );
+
+			goto on_error;
+		}
+		if( internal_handle->io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_EWF2_LOGICAL )
+		{
+			if( internal_handle->io_handle->format == LIBEWF_FORMAT_LOGICAL_ENCASE7 )
+			{
+				internal_handle->io_handle->format = LIBEWF_FORMAT_V2_LOGICAL_ENCASE7;
+			}
+		}
+		internal_handle->media_values->number_of_sectors = internal_handle->media_values->media_size
+		                                                 / internal_handle->media_values->bytes_per_sector;
+
+		if( ( internal_handle->media_values->media_size % internal_handle->media_values->bytes_per_sector ) != 0 )
+		{
+			internal_handle->media_values->number_of_sectors += 1;
+		}
+	}
+	if( libewf_header_sections_free(
+	     &header_sections,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free header sections.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfcache_cache_free(
+	     &sections_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free sections cache.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( string_data != NULL )
+	{
+		memory_free(
+		 string_data );
+	}
+	if( header_sections != NULL )
+	{
+		libewf_header_sections_free(
+		 &header_sections,
+		 NULL );
+	}
+	if( sections_cache != NULL )
+	{
+		libfcache_cache_free(
+		 &sections_cache,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Opens the segment files for reading
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_open_read_segment_files(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     libcerror_error_t **error )
+{
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_internal_handle_open_read_segment_files";
+	size64_t maximum_segment_size       = 0;
+	size64_t segment_file_size          = 0;
+	uint32_t number_of_segments         = 0;
+	uint32_t segment_number             = 0;
+	int file_io_pool_entry              = 0;
+	int last_segment_file               = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->read_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - missing read IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_segment_table_get_number_of_segments(
+	     segment_table,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments from segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_segments == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of segments value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	for( segment_number = 0;
+	     segment_number < number_of_segments;
+	     segment_number++ )
+	{
+		if( libewf_segment_table_get_segment_by_index(
+		     segment_table,
+		     segment_number,
+		     &file_io_pool_entry,
+		     &segment_file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+		if( ( segment_number == 0 )
+		 && ( number_of_segments > 1 ) )
+		{
+			/* Round the maximum segment size to nearest number of KiB
+			 */
+			maximum_segment_size = ( segment_file_size >> 10 ) << 10;
+
+			if( libewf_segment_table_set_maximum_segment_size(
+			     segment_table,
+			     maximum_segment_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set maximum segment size in segment table.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( libewf_segment_table_get_segment_file_by_index(
+		     segment_table,
+		     segment_number,
+		     file_io_pool,
+		     &segment_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+		if( segment_file == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing segment file: %" PRIu32 ".",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+		if( segment_file->segment_number != ( segment_number + 1 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_INPUT,
+			 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+			 "%s: segment number mismatch ( stored: %" PRIu32 ", expected: %" PRIu32 " ).",
+			 function,
+			 segment_file->segment_number,
+			 segment_number + 1 );
+
+			return( -1 );
+		}
+		if( segment_file->segment_number == 1 )
+		{
+			internal_handle->io_handle->segment_file_type  = segment_file->type;
+			internal_handle->io_handle->major_version      = segment_file->major_version;
+			internal_handle->io_handle->minor_version      = segment_file->minor_version;
+			internal_handle->io_handle->compression_method = segment_file->compression_method;
+
+			if( segment_file->major_version == 2 )
+			{
+				if( memory_copy(
+				     internal_handle->media_values->set_identifier,
+				     segment_file->set_identifier,
+				     16 ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy segment file set identifier to media values.",
+					 function );
+
+					return( -1 );
+				}
+			}
+		}
+		else
+		{
+			if( ( segment_file->major_version != internal_handle->io_handle->major_version )
+			 || ( segment_file->minor_version != internal_handle->io_handle->minor_version ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_INPUT,
+				 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+				 "%s: segment file format version value mismatch.",
+				 function );
+
+				return( -1 );
+			}
+			if( internal_handle->io_handle->major_version == 2 )
+			{
+				if( segment_file->compression_method != internal_handle->io_handle->compression_method )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_INPUT,
+					 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+					 "%s: segment file compression method value mismatch.",
+					 function );
+
+					return( -1 );
+				}
+				if( memory_compare(
+				     internal_handle->media_values->set_identifier,
+				     segment_file->set_identifier,
+				     16 ) != 0 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_INPUT,
+					 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+					 "%s: segment file set identifier value mismatch.",
+					 function );
+
+					return( -1 );
+				}
+			}
+		}
+		if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_LAST ) != 0 )
+		{
+			last_segment_file = 1;
+		}
+		if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_ENCRYPTED ) != 0 )
+		{
+/* TODO get key info */
+			internal_handle->io_handle->format       = LIBEWF_FORMAT_V2_ENCASE7;
+			internal_handle->io_handle->is_encrypted = 1;
+		}
+		if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_CORRUPTED ) != 0 )
+		{
+			segment_table->flags |= LIBEWF_SEGMENT_TABLE_FLAG_IS_CORRUPTED;
+		}
+		if( libewf_internal_handle_open_read_segment_file_section_data(
+		     internal_handle,
+		     segment_file,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read section data from segment file: %" PRIu32 ".",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+		if( libewf_segment_table_set_segment_storage_media_size_by_index(
+		     segment_table,
+		     segment_number,
+		     segment_file->storage_media_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to set mapped range of element: %" PRIu32 " in segment table.",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+		internal_handle->read_io_handle->storage_media_size_read += segment_file->storage_media_size;
+		internal_handle->read_io_handle->number_of_chunks_read   += segment_file->number_of_chunks;
+	}
+	if( last_segment_file == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing done section.",
+		 function );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			if( ( error != NULL )
+			 && ( *error != NULL ) )
+			{
+				libcnotify_print_error_backtrace(
+				 *error );
+			}
+		}
+#endif
+		libcerror_error_free(
+		 error );
+
+		segment_table->flags |= LIBEWF_SEGMENT_TABLE_FLAG_IS_CORRUPTED;
+	}
+	return( 1 );
+}
+
+/* Opens a set of EWF file(s) using a Basic File IO (bfio) pool
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_open_file_io_pool(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     int access_flags,
+     libewf_segment_table_t *segment_table,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle    = NULL;
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_internal_handle_open_file_io_pool";
+	size64_t segment_file_size          = 0;
+	ssize_t read_count                  = 0;
+	int file_io_pool_entry              = 0;
+	int number_of_file_io_handles       = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->file_io_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - file IO pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_table != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk table value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_groups_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunks group cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunks_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunks cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->hash_sections != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - hash sections value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->single_files != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - single files value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( access_flags & ~( LIBEWF_ACCESS_FLAG_READ | LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME ) ) != 0 )
+	 || ( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	  &&  ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
+	{
+		if( libewf_read_io_handle_initialize(
+		     &( internal_handle->read_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create read IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
+	{
+		if( libewf_write_io_handle_initialize(
+		     &( internal_handle->write_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create write IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libewf_chunk_table_initialize(
+	     &( internal_handle->chunk_table ),
+	     internal_handle->io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk table.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfcache_cache_initialize(
+	     &( internal_handle->chunk_groups_cache ),
+	     LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNK_GROUPS,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk groups cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfcache_cache_initialize(
+	     &( internal_handle->chunks_cache ),
+	     LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNKS,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunks cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_header_values_initialize(
+	     &( internal_handle->header_values ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create header values.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_hash_sections_initialize(
+	     &( internal_handle->hash_sections ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create hash sections.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_single_files_initialize(
+	     &( internal_handle->single_files ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create single files.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_empty(
+	     internal_handle->sessions,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty sessions array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_empty(
+	     internal_handle->tracks,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty tracks array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_range_list_empty(
+	     internal_handle->acquiry_errors,
+	     NULL,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty acquiry errors range list.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
+	{
+		if( libbfio_pool_get_number_of_handles(
+		     file_io_pool,
+		     &number_of_file_io_handles,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve the number of handles in the pool.",
+			 function );
+
+			goto on_error;
+		}
+		if( libewf_segment_file_initialize(
+		     &segment_file,
+		     internal_handle->io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create segment file.",
+			 function );
+
+			goto on_error;
+		}
+		for( file_io_pool_entry = 0;
+		     file_io_pool_entry < number_of_file_io_handles;
+		     file_io_pool_entry++ )
+		{
+			if( libbfio_pool_get_size(
+			     file_io_pool,
+			     file_io_pool_entry,
+			     &segment_file_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve size of file IO pool entry: %d.",
+				 function,
+				 file_io_pool_entry );
+
+				goto on_error;
+			}
+			if( libbfio_pool_get_handle(
+			     file_io_pool,
+			     file_io_pool_entry,
+			     &file_io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to retrieve file IO handle: %d from pool.",
+				 function,
+				 file_io_pool_entry );
+
+				goto on_error;
+			}
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: processing file IO pool entry: %d.\n",
+				 function,
+				 file_io_pool_entry );
+			}
+#endif
+			read_count = libewf_segment_file_read_file_header(
+				      segment_file,
+				      file_io_pool,
+				      file_io_pool_entry,
+				      error );
+
+			if( read_count < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read segment file header.",
+				 function );
+
+				goto on_error;
+			}
+			if( segment_file->segment_number == 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_INPUT,
+				 LIBCERROR_INPUT_ERROR_INVALID_DATA,
+				 "%s: invalid segment number: 0 in file IO pool entry: %d.",
+				 function,
+				 file_io_pool_entry );
+
+				goto on_error;
+			}
+			if( libewf_segment_table_append_segment_by_segment_file(
+			     segment_table,
+			     segment_file,
+			     file_io_pool_entry,
+			     segment_file_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append segment: %" PRIu32 " to segment table.",
+				 function,
+				 segment_file->segment_number );
+
+				goto on_error;
+			}
+		}
+		if( libewf_segment_file_free(
+		     &segment_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free segment file.",
+			 function );
+
+			goto on_error;
+		}
+		if( libewf_internal_handle_open_read_segment_files(
+		     internal_handle,
+		     file_io_pool,
+		     segment_table,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read segment files.",
+			 function );
+
+			if( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 )
+			{
+				goto on_error;
+			}
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				if( ( error != NULL )
+				 && ( *error != NULL ) )
+				{
+					libcnotify_print_error_backtrace(
+					 *error );
+				}
+			}
+#endif
+			libcerror_error_free(
+			 error );
+		}
+		if( internal_handle->media_values == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid handle - missing media values.",
+			 function );
+
+			goto on_error;
+		}
+/* TODO refactor */
+		if( internal_handle->single_files->ltree_data == NULL )
+		{
+			if( libewf_internal_handle_get_media_values(
+			     internal_handle,
+			     &( internal_handle->media_values->media_size ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine media values.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
+	 && ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
+	{
+		if( internal_handle->write_io_handle->values_initialized == 0 )
+		{
+			if( libewf_write_io_handle_initialize_values(
+			     internal_handle->write_io_handle,
+			     internal_handle->io_handle,
+			     internal_handle->media_values,
+			     segment_table,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to initialize write IO handle values.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( libewf_write_io_handle_initialize_resume(
+		     internal_handle->write_io_handle,
+		     internal_handle->io_handle,
+		     file_io_pool,
+		     internal_handle->media_values,
+		     segment_table,
+		     internal_handle->chunk_table,
+		     internal_handle->read_io_handle,
+		     &( internal_handle->current_offset ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize write IO handle to resume.",
+			 function );
+
+			goto on_error;
+		}
+	}
+			internal_handle->io_handle->chunk_size = internal_handle->media_values->chunk_size;
+	if( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) == 0 )
+	{
+		if( libewf_open_handles_register_file_io_pool(
+		     file_io_pool,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to register file IO pool with open handles budget.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	internal_handle->io_handle->access_flags = access_flags;
+	internal_handle->file_io_pool            = file_io_pool;
+	internal_handle->segment_table           = segment_table;
+
+	return( 1 );
+
+on_error:
+	if( segment_file != NULL )
+	{
+		libewf_segment_file_free(
+		 &segment_file,
+		 NULL );
+	}
+	if( internal_handle->single_files != NULL )
+	{
+		libewf_single_files_free(
+		 &( internal_handle->single_files ),
+		 NULL );
+	}
+	if( internal_handle->hash_sections != NULL )
+	{
+		libewf_hash_sections_free(
+		 &( internal_handle->hash_sections ),
+		 NULL );
+	}
+	if( internal_handle->header_values != NULL )
+	{
+		libfvalue_table_free(
+		 &( internal_handle->header_values ),
+		 NULL );
+	}
+	if( internal_handle->chunks_cache != NULL )
+	{
+		libfcache_cache_free(
+		 &( internal_handle->chunks_cache ),
+		 NULL );
+	}
+	if( internal_handle->chunk_groups_cache != NULL )
+	{
+		libfcache_cache_free(
+		 &( internal_handle->chunk_groups_cache ),
+		 NULL );
+	}
+	if( internal_handle->chunk_table != NULL )
+	{
+		libewf_chunk_table_free(
+		 &( internal_handle->chunk_table ),
+		 NULL );
+	}
+	if( internal_handle->write_io_handle != NULL )
+	{
+		libewf_write_io_handle_free(
+		 &( internal_handle->write_io_handle ),
+		 error );
+	}
+	if( internal_handle->read_io_handle != NULL )
+	{
+		libewf_read_io_handle_free(
+		 &( internal_handle->read_io_handle ),
+		 error );
+	}
+	return( -1 );
+}
+
+/* Opens a set of EWF file(s) using a Basic File IO (bfio) pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_open_file_io_pool(
+     libewf_handle_t *handle,
+     libbfio_pool_t *file_io_pool,
+     int access_flags,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	libewf_segment_table_t *segment_table     = NULL;
+	static char *function                     = "libewf_handle_open_file_io_pool";
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - file IO pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_segment_table_initialize(
+	     &segment_table,
+	     internal_handle->io_handle,
+	     LIBEWF_DEFAULT_SEGMENT_FILE_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segment table.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_internal_handle_open_file_io_pool(
+	          internal_handle,
+	          file_io_pool,
+	          access_flags,
+	          segment_table,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle using a file IO pool.",
+		 function );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	result = libcthreads_read_write_lock_release_for_write(
+	          internal_handle->read_write_lock,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+	}
+#endif
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( segment_table != NULL )
+	{
+		libewf_segment_table_free(
+		 &segment_table,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Closes the EWF handle
+ * Waits for the pending asynchronous reads to complete,
+ * the handle cannot be closed from the callback function of an asynchronous read
+ * Returns 0 if successful or -1 on error
+ */
+int libewf_handle_close(
+     libewf_handle_t *handle,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_close";
+	ssize_t write_count                       = 0;
+	int result                                = 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libewf_read_scheduler_t *read_scheduler   = NULL;
+#endif
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+	/* The read scheduler is detached from the handle while holding the read/write lock,
+	 * so that other threads can no longer reference it
+	 */
+	read_scheduler = internal_handle->read_scheduler;
+
+	internal_handle->read_scheduler = NULL;
+
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+	/* The read scheduler is freed without holding the read/write lock
+	 * since the pending asynchronous reads need the lock to complete,
+	 * it is freed after the threads that hold a reference have released it
+	 */
+	if( read_scheduler != NULL )
+	{
+		if( libewf_read_scheduler_free(
+		     &read_scheduler,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read scheduler.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( internal_handle->write_io_handle != NULL )
+	 && ( internal_handle->write_io_handle->write_finalized == 0 ) )
+	{
+		write_count = libewf_internal_handle_write_finalize_file_io_pool(
+		               internal_handle,
+		               internal_handle->file_io_pool,
+		               error );
+
+		if( write_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to finalize write.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->file_io_pool != NULL )
+	{
+		if( libewf_open_handles_unregister_file_io_pool(
+		     internal_handle->file_io_pool,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to unregister file IO pool from open handles budget.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->file_io_pool_created_in_library != 0 )
+	{
+		if( libbfio_pool_close_all(
+		     internal_handle->file_io_pool,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close all file IO pool handles.",
+			 function );
+
+			result = -1;
+		}
+		if( libbfio_pool_free(
+		     &( internal_handle->file_io_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO pool.",
+			 function );
+
+			result = -1;
+		}
+		internal_handle->file_io_pool_created_in_library = 0;
+	}
+	internal_handle->file_io_pool = NULL;
+
+	if( libewf_io_handle_clear(
+	     internal_handle->io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to clear IO handle.",
+		 function );
+
+		result = -1;
+	}
+	if( libewf_media_values_clear(
+	     internal_handle->media_values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to clear media values.",
+		 function );
+
+		result = -1;
+	}
+	if( internal_handle->read_io_handle != NULL )
+	{
+		if( libewf_read_io_handle_free(
+		     &( internal_handle->read_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read IO handle.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->write_io_handle != NULL )
+	{
+		if( libewf_write_io_handle_free(
+		     &( internal_handle->write_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free write IO handle.",
+			 function );
+
+			result = -1;
+		}
+	}
+	/* Free the chunk data if it could not be passed to libfcache_cache_set_value_by_index
+	 */
+	if( internal_handle->chunk_data != NULL )
+	{
+		if( libewf_chunk_data_free(
+		     &( internal_handle->chunk_data ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk data.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->shared_metadata != NULL )
+	{
+		/* The shared metadata is freed when its last reference is removed
+		 */
+		internal_handle->segment_table      = NULL;
+		internal_handle->chunk_table        = NULL;
+		internal_handle->chunk_groups_cache = NULL;
+		internal_handle->hash_sections      = NULL;
+		internal_handle->header_values      = NULL;
+		internal_handle->hash_values        = NULL;
+		internal_handle->single_files       = NULL;
+
+		if( internal_handle->has_shared_chunks_cache != 0 )
+		{
+			internal_handle->chunks_cache = NULL;
+		}
+		internal_handle->has_shared_chunks_cache = 0;
+
+		if( libewf_shared_metadata_remove_reference(
+		     &( internal_handle->shared_metadata ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to remove reference from shared metadata.",
+			 function );
+
+			result = -1;
+		}
+		internal_handle->shared_metadata = NULL;
+	}
+	if( internal_handle->segment_table != NULL )
+	{
+		if( libewf_segment_table_free(
+		     &( internal_handle->segment_table ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free segment table.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->chunk_table != NULL )
+	{
+		if( libewf_chunk_table_free(
+		     &( internal_handle->chunk_table ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk table.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->chunk_groups_cache != NULL )
+	{
+		if( libfcache_cache_free(
+		     &( internal_handle->chunk_groups_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk groups cache.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->chunks_cache != NULL )
+	{
+		if( libfcache_cache_free(
+		     &( internal_handle->chunks_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunks cache.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->hash_sections != NULL )
+	{
+		if( libewf_hash_sections_free(
+		     &( internal_handle->hash_sections ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free hash sections.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->header_values != NULL )
+	{
+		if( libfvalue_table_free(
+		     &( internal_handle->header_values ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free header values.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->hash_values != NULL )
+	{
+		if( libfvalue_table_free(
+		     &( internal_handle->hash_values ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free hash values.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->single_files != NULL )
+	{
+		if( libewf_single_files_free(
+		     &( internal_handle->single_files ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free single files.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->read_digest != NULL )
+	{
+		if( libewf_read_digest_free(
+		     &( internal_handle->read_digest ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read digest.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->shared_memory_chunks_cache != NULL )
+	{
+		if( libewf_shared_memory_chunks_cache_free(
+		     &( internal_handle->shared_memory_chunks_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free shared memory chunks cache.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libcdata_array_empty(
+	     internal_handle->sessions,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty sessions array.",
+		 function );
+
+		result = -1;
+	}
+	if( libcdata_array_empty(
+	     internal_handle->tracks,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty tracks array.",
+		 function );
+
+		result = -1;
+	}
+	if( libcdata_range_list_empty(
+	     internal_handle->acquiry_errors,
+	     NULL,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty acquiry errors range list.",
+		 function );
+
+		result = -1;
+	}
+/* TODO clear IO handle, segment tables */
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		result = -1;
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the key of a chunk in the shared memory chunks cache
+ * The key identifies the stored chunk data by its segment file and data range,
+ * which are retrieved from the chunk table without reading the chunk data
+ * The shared metadata must be grabbed by the caller
+ * Returns 1 if successful, 0 if the chunk cannot be shared or -1 on error
+ */
+int libewf_internal_handle_get_shared_memory_chunks_cache_key(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     uint64_t chunk_index,
+     libewf_shared_memory_chunks_cache_key_t *key,
+     libcerror_error_t **error )
+{
+	static char *function     = "libewf_internal_handle_get_shared_memory_chunks_cache_key";
+	size64_t chunk_data_size  = 0;
+	off64_t chunk_data_offset = 0;
+	uint32_t chunk_data_flags = 0;
+	int file_io_pool_entry    = 0;
+	int result                = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_chunk_table_get_chunk_data_range_by_offset(
+	          internal_handle->chunk_table,
+	          chunk_index,
+	          file_io_pool,
+	          internal_handle->segment_table,
+	          internal_handle->chunk_groups_cache,
+	          (off64_t) ( chunk_index * internal_handle->media_values->chunk_size ),
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &chunk_data_flags,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " data range.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( ( chunk_data_flags & ( LIBEWF_RANGE_FLAG_IS_SPARSE | LIBEWF_RANGE_FLAG_IS_CORRUPTED ) ) != 0 )
+	{
+		return( 0 );
+	}
+	if( memory_copy(
+	     key,
+	     &( internal_handle->shared_memory_chunks_cache_key ),
+	     sizeof( libewf_shared_memory_chunks_cache_key_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy key.",
+		 function );
+
+		return( -1 );
+	}
+	key->chunk_index        = chunk_index;
+	key->chunk_data_offset  = (uint64_t) chunk_data_offset;
+	key->chunk_data_size    = (uint64_t) chunk_data_size;
+	key->segment_file_index = (uint32_t) file_io_pool_entry;
+	key->chunk_data_flags   = chunk_data_flags;
+
+	return( 1 );
+}
+
+/* Reads (media) data of a chunk at a specific offset into a buffer using a Basic File IO (bfio) pool
+ * The data is read up to the end of the chunk
+ * A chunk that is not in the shared chunks cache is unpacked without grabbing the shared metadata
+ * The chunk is stored in the shared memory chunks cache if a shared memory chunks cache key is provided
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libewf_internal_handle_read_chunk_data_from_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         uint64_t chunk_index,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         const libewf_shared_memory_chunks_cache_key_t *shared_memory_chunks_cache_key,
+         libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_internal_handle_read_chunk_data_from_file_io_pool";
+	off64_t chunk_data_offset       = 0;
+	size_t read_size                = 0;
+	int is_grabbed                  = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_internal_handle_grab_shared_metadata(
+	     internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab shared metadata.",
+		 function );
+
+		return( -1 );
+	}
+	is_grabbed = 1;
+
+	if( libewf_chunk_table_get_packed_chunk_data_by_offset(
+	     internal_handle->chunk_table,
+	     chunk_index,
+	     file_io_pool,
+	     internal_handle->media_values,
+	     internal_handle->segment_table,
+	     internal_handle->chunk_groups_cache,
+	     internal_handle->chunks_cache,
+	     internal_handle->statistics,
+	     offset,
+	     &chunk_data,
+	     &chunk_data_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " packed data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	if( internal_handle->has_shared_chunks_cache == 0 )
+	{
+		is_grabbed = 0;
+
+		if( libewf_internal_handle_release_shared_metadata(
+		     internal_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release shared metadata.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libewf_chunk_data_unpack(
+	     chunk_data,
+	     internal_handle->io_handle,
+	     internal_handle->statistics,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to unpack chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+	{
+		if( is_grabbed == 0 )
+		{
+			if( libewf_internal_handle_grab_shared_metadata(
+			     internal_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to grab shared metadata.",
+				 function );
+
+				goto on_error;
+			}
+			is_grabbed = 1;
+		}
+		if( libewf_chunk_table_check_chunk_data(
+		     internal_handle->chunk_table,
+		     chunk_index,
+		     internal_handle->media_values,
+		     chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to check chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		if( internal_handle->has_shared_chunks_cache == 0 )
+		{
+			is_grabbed = 0;
+
+			if( libewf_internal_handle_release_shared_metadata(
+			     internal_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release shared metadata.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	/* Corrupted chunks are not shared with other processes
+	 */
+	if( ( internal_handle->shared_memory_chunks_cache != NULL )
+	 && ( shared_memory_chunks_cache_key != NULL )
+	 && ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) == 0 ) )
+	{
+		if( libewf_shared_memory_chunks_cache_write_chunk(
+		     internal_handle->shared_memory_chunks_cache,
+		     shared_memory_chunks_cache_key,
+		     chunk_index,
+		     chunk_data->data,
+		     chunk_data->data_size,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to write chunk: %" PRIu64 " to shared memory chunks cache.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+	}
+	if( (off64_t) chunk_data_offset > (off64_t) chunk_data->data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: chunk: %" PRIu64 " offset exceeds data size.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	read_size = (size_t) ( chunk_data->data_size - chunk_data_offset );
+
+	if( read_size > buffer_size )
+	{
+		read_size = buffer_size;
+	}
+	if( read_size > 0 )
+	{
+		if( memory_copy(
+		     buffer,
+		     &( ( chunk_data->data )[ chunk_data_offset ] ),
+		     read_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy chunk: %" PRIu64 " data to buffer.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+	}
+	if( is_grabbed != 0 )
+	{
+		is_grabbed = 0;
+
+		if( libewf_internal_handle_release_shared_metadata(
+		     internal_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release shared metadata.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( (ssize_t) read_size );
+
+on_error:
+	if( is_grabbed != 0 )
+	{
+		libewf_internal_handle_release_shared_metadata(
+		 internal_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads (media) data of a whole chunk directly into a buffer using a Basic File IO (bfio) pool
+ * The chunk is read and unpacked without the chunk data and chunks cache
+ * Returns the number of bytes read, 0 if the chunk cannot be read directly or -1 on error
+ */
+ssize_t libewf_internal_handle_read_chunk_buffer_from_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         uint64_t chunk_index,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	static char *function     = "libewf_internal_handle_read_chunk_buffer_from_file_io_pool";
+	size64_t chunk_data_size  = 0;
+	ssize_t read_count        = 0;
+	off64_t chunk_data_offset = 0;
+	uint32_t chunk_data_flags = 0;
+	uint32_t range_flags      = 0;
+	int file_io_pool_entry    = 0;
+	int result                = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->read_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing read IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->read_io_handle->compressed_data == NULL )
+	{
+		internal_handle->read_io_handle->compressed_data_size = (size_t) internal_handle->io_handle->chunk_size;
+
+		internal_handle->read_io_handle->compressed_data = (uint8_t *) memory_allocate(
+		                                                                sizeof( uint8_t ) * internal_handle->read_io_handle->compressed_data_size );
+
+		if( internal_handle->read_io_handle->compressed_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create compressed data.",
+			 function );
+
+			internal_handle->read_io_handle->compressed_data_size = 0;
+
+			return( -1 );
+		}
+	}
+	if( libewf_internal_handle_grab_shared_metadata(
+	     internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab shared metadata.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_chunk_table_get_chunk_data_range_by_offset(
+	          internal_handle->chunk_table,
+	          chunk_index,
+	          file_io_pool,
+	          internal_handle->segment_table,
+	          internal_handle->chunk_groups_cache,
+	          offset,
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &chunk_data_flags,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " data range.",
+		 function,
+		 chunk_index );
+
+		libewf_internal_handle_release_shared_metadata(
+		 internal_handle,
+		 NULL );
+
+		return( -1 );
+	}
+	if( libewf_internal_handle_release_shared_metadata(
+	     internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release shared metadata.",
+		 function );
+
+		return( -1 );
+	}
+	/* Missing chunks are read by means of the chunks cache to mark them as corrupted
+	 */
+	if( result == 0 )
+	{
+		return( 0 );
+	}
+	read_count = libewf_chunk_data_read_buffer_from_file_io_pool(
+	              internal_handle->io_handle,
+	              file_io_pool,
+	              file_io_pool_entry,
+	              chunk_data_offset,
+	              chunk_data_size,
+	              chunk_data_flags,
+	              internal_handle->read_io_handle->compressed_data,
+	              internal_handle->read_io_handle->compressed_data_size,
+	              buffer,
+	              buffer_size,
+	              internal_handle->statistics,
+	              &range_flags,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	/* Corrupted chunks are read by means of the chunks cache to mark them as corrupted
+	 */
+	if( ( range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: chunk: %" PRIu64 " is corrupted and cannot be read directly.\n",
+			 function,
+			 chunk_index );
+		}
+#endif
+		return( 0 );
+	}
+	return( read_count );
+}
+
+/* Reads (media) data from the last current into a buffer using a Basic File IO (bfio) pool
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_internal_handle_read_buffer_from_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libewf_shared_memory_chunks_cache_key_t shared_memory_chunks_cache_key;
+
+	libewf_shared_memory_chunks_cache_key_t *chunk_key = NULL;
+	static char *function                              = "libewf_internal_handle_read_buffer_from_file_io_pool";
+	uint64_t chunk_index                               = 0;
+	uint64_t start_time                                = 0;
+	size_t buffer_offset                               = 0;
+	size_t read_size                                   = 0;
+	ssize_t read_count                                 = 0;
+	ssize_t total_read_count                           = 0;
+	uint8_t read_directly                              = 0;
+	int result                                         = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
+	{
+		return( 0 );
+	}
+	if( (size64_t) ( internal_handle->current_offset + buffer_size ) >= internal_handle->media_values->media_size )
+	{
+		buffer_size = (size_t) ( internal_handle->media_values->media_size - internal_handle->current_offset );
+	}
+	if( internal_handle->statistics != NULL )
+	{
+		if( libewf_statistics_get_current_time(
+		     &start_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve start time.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+
+	/* Reads that cover whole chunks of a read-only handle bypass the chunks cache
+	 */
+	if( ( internal_handle->write_io_handle == NULL )
+	 && ( internal_handle->read_io_handle != NULL ) )
+	{
+		read_directly = 1;
+	}
+	while( buffer_size > 0 )
+	{
+		read_count = 0;
+		chunk_key  = NULL;
+
+		if( internal_handle->shared_memory_chunks_cache != NULL )
+		{
+			if( libewf_internal_handle_grab_shared_metadata(
+			     internal_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to grab shared metadata.",
+				 function );
+
+				return( -1 );
+			}
+			result = libewf_internal_handle_get_shared_memory_chunks_cache_key(
+			          internal_handle,
+			          file_io_pool,
+			          chunk_index,
+			          &shared_memory_chunks_cache_key,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve chunk: %" PRIu64 " shared memory chunks cache key.",
+				 function,
+				 chunk_index );
+
+				libewf_internal_handle_release_shared_metadata(
+				 internal_handle,
+				 NULL );
+
+				return( -1 );
+			}
+			if( libewf_internal_handle_release_shared_metadata(
+			     internal_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release shared metadata.",
+				 function );
+
+				return( -1 );
+			}
+			if( result != 0 )
+			{
+				chunk_key = &shared_memory_chunks_cache_key;
+			}
+		}
+		if( chunk_key != NULL )
+		{
+			read_count = libewf_shared_memory_chunks_cache_read_chunk(
+			              internal_handle->shared_memory_chunks_cache,
+			              chunk_key,
+			              chunk_index,
+			              (size_t) ( internal_handle->current_offset % internal_handle->media_values->chunk_size ),
+			              &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			              buffer_size,
+			              error );
+		}
+		if( ( read_count == 0 )
+		 && ( read_directly != 0 )
+		 && ( buffer_size >= (size_t) internal_handle->media_values->chunk_size )
+		 && ( ( internal_handle->current_offset % internal_handle->media_values->chunk_size ) == 0 ) )
+		{
+			read_count = libewf_internal_handle_read_chunk_buffer_from_file_io_pool(
+			              internal_handle,
+			              file_io_pool,
+			              chunk_index,
+			              internal_handle->current_offset,
+			              &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			              buffer_size,
+			              error );
+
+			if( ( read_count > 0 )
+			 && ( chunk_key != NULL ) )
+			{
+				if( libewf_shared_memory_chunks_cache_write_chunk(
+				     internal_handle->shared_memory_chunks_cache,
+				     chunk_key,
+				     chunk_index,
+				     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+				     (size_t) read_count,
+				     error ) == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to write chunk: %" PRIu64 " to shared memory chunks cache.",
+					 function,
+					 chunk_index );
+
+					return( -1 );
+				}
+			}
+		}
+		if( read_count == 0 )
+		{
+			read_count = libewf_internal_handle_read_chunk_data_from_file_io_pool(
+			              internal_handle,
+			              file_io_pool,
+			              chunk_index,
+			              internal_handle->current_offset,
+			              &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			              buffer_size,
+			              chunk_key,
+			              error );
+		}
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		if( read_count == 0 )
+		{
+			break;
+		}
+		read_size = (size_t) read_count;
+
+		if( internal_handle->read_digest != NULL )
+		{
+			if( libewf_read_digest_update(
+			     internal_handle->read_digest,
+			     internal_handle->current_offset,
+			     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			     read_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update read digest.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		buffer_offset    += read_size;
+		buffer_size      -= read_size;
+		total_read_count += (ssize_t) read_size;
+		chunk_index      += 1;
+
+		internal_handle->current_offset += (off64_t) read_size;
+
+		if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
+		{
+			break;
+		}
+		if( internal_handle->io_handle->abort != 0 )
+		{
+			break;
+		}
+	}
+	if( internal_handle->statistics != NULL )
+	{
+		if( libewf_statistics_add_event(
+		     internal_handle->statistics,
+		     LIBEWF_STATISTICS_TYPE_READ_BUFFER,
+		     start_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to add read buffer statistics event.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( total_read_count );
+}
+
+/* Reads (media) data at the current offset into a buffer
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_handle_read_buffer(
+         libewf_handle_t *handle,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_read_buffer";
+	ssize_t read_count                        = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libewf_internal_handle_read_buffer_from_file_io_pool(
+		      internal_handle,
+		      internal_handle->file_io_pool,
+		      buffer,
+		      buffer_size,
+		      error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		read_count = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Reads (media) data at a specific offset
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_handle_read_buffer_at_offset(
+         libewf_handle_t *handle,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_read_buffer_at_offset";
+	ssize_t read_count                        = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libewf_internal_handle_seek_offset(
+	     internal_handle,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libewf_internal_handle_read_buffer_from_file_io_pool(
+	              internal_handle,
+	              internal_handle->file_io_pool,
+	              buffer,
+	              buffer_size,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Reads the packed chunk data of a chunk using a Basic File IO (bfio) pool
+ * The chunk data is read without the chunk data and chunks cache
+ * Returns 1 if successful, 0 if the chunk cannot be read directly or -1 on error
+ */
+int libewf_internal_handle_read_packed_chunk_data_from_file_io_pool(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     uint64_t chunk_index,
+     off64_t offset,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error )
+{
+	static char *function     = "libewf_internal_handle_read_packed_chunk_data_from_file_io_pool";
+	size64_t chunk_data_size  = 0;
+	ssize_t read_count        = 0;
+	off64_t chunk_data_offset = 0;
+	uint32_t chunk_data_flags = 0;
+	int file_io_pool_entry    = 0;
+	int result                = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_internal_handle_grab_shared_metadata(
+	     internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab shared metadata.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_chunk_table_get_chunk_data_range_by_offset(
+	          internal_handle->chunk_table,
+	          chunk_index,
+	          file_io_pool,
+	          internal_handle->segment_table,
+	          internal_handle->chunk_groups_cache,
+	          offset,
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &chunk_data_flags,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " data range.",
+		 function,
+		 chunk_index );
+
+		libewf_internal_handle_release_shared_metadata(
+		 internal_handle,
+		 NULL );
+
+		return( -1 );
+	}
+	if( libewf_internal_handle_release_shared_metadata(
+	     internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release shared metadata.",
+		 function );
+
+		return( -1 );
+	}
+	/* Missing and sparse chunks are read by means of the chunks cache
+	 */
+	if( ( result == 0 )
+	 || ( ( chunk_data_flags & LIBEWF_RANGE_FLAG_IS_SPARSE ) != 0 ) )
+	{
+		return( 0 );
+	}
+	if( libewf_chunk_data_initialize(
+	     chunk_data,
+	     internal_handle->io_handle->chunk_size,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	/* Chunk data that does not fit the chunk data buffer is read by means of the chunks cache
+	 */
+	if( chunk_data_size > (size64_t) ( *chunk_data )->allocated_data_size )
+	{
+		result = 0;
+	}
+	else
+	{
+		read_count = libewf_chunk_data_read_from_file_io_pool(
+		              *chunk_data,
+		              file_io_pool,
+		              file_io_pool_entry,
+		              chunk_data_offset,
+		              chunk_data_size,
+		              chunk_data_flags,
+		              error );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
 		}
-		else if( section->type_string_length == 6 )
+	}
+	if( result == 0 )
+	{
+		if( libewf_chunk_data_free(
+		     chunk_data,
+		     error ) != 1 )
 		{
-			if( memory_compare(
-			     (void *) section->type_string,
-			     (void *) "digest",
-			     6 ) == 0 )
-			{
-#if defined( HAVE_VERBOSE_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					if( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
-					{
-						libcnotify_printf(
-						 "%s: found digest section in EWF-S01 format.\n",
-						 function );
-					}
-				}
-#endif
-				read_count = libewf_section_digest_read(
-					      section,
-				              internal_handle->io_handle,
-					      file_io_pool,
-					      file_io_pool_entry,
-					      internal_handle->hash_sections,
-					      error );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
 
-#if defined( HAVE_VERBOSE_OUTPUT )
-				known_section = 1;
-#endif
-			}
-			else if( memory_compare(
-				  (void *) section->type_string,
-				  (void *) "header",
-				  6 ) == 0 )
-			{
-				read_count = libewf_section_compressed_string_read(
-					      section,
-				              internal_handle->io_handle,
-					      file_io_pool,
-					      file_io_pool_entry,
-				              internal_handle->io_handle->compression_method,
-					      &string_data,
-					      &string_data_size,
-					      error );
+			goto on_error;
+		}
+	}
+	return( result );
 
-				if( read_count == -1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read header file object string.",
-					 function );
+on_error:
+	if( *chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
 
-					goto on_error;
-				}
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					if( libewf_debug_byte_stream_print(
-					     "Header",
-					     string_data,
-					     string_data_size,
-					     error ) != 1 )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-						 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-						 "%s: unable to print header.",
-						 function );
+/* Reads (media) data of the requests of a read batch using a Basic File IO (bfio) pool
+ * The chunks referenced by the requests are read once in ascending order and unpacked in parallel
+ * Chunks that cannot be read directly are read by means of the chunks cache
+ * A request that cannot be read is marked as failed with a read count of -1
+ * Returns 1 if successful, 0 if one or more requests failed or -1 on error
+ */
+int libewf_internal_handle_read_batch_from_file_io_pool(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_read_batch_t *read_batch,
+     libcerror_error_t **error )
+{
+	libewf_read_batch_chunk_t *chunk     = NULL;
+	libewf_read_batch_request_t *request = NULL;
+	static char *function                = "libewf_internal_handle_read_batch_from_file_io_pool";
+	size_t piece_size                    = 0;
+	ssize_t read_count                   = 0;
+	uint64_t start_time                  = 0;
+	off64_t chunk_offset                 = 0;
+	off64_t piece_offset                 = 0;
+	off64_t request_end_offset           = 0;
+	off64_t window_end_offset            = 0;
+	uint8_t read_directly                = 0;
+	int chunk_index                      = 0;
+	int request_index                    = 0;
+	int result                           = 0;
 
-						goto on_error;
-					}
-				}
-#endif
-				if( header_sections->header == NULL )
-				{
-					header_sections->header      = string_data;
-					header_sections->header_size = string_data_size;
-				}
-				else
-				{
-					memory_free(
-					 string_data );
-				}
-				string_data = NULL;
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
 
-				header_sections->number_of_header_sections += 1;
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
 
-				header_section_found = 1;
+		return( -1 );
+	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
+		 function );
 
-#if defined( HAVE_VERBOSE_OUTPUT )
-				known_section = 1;
-#endif
-			}
-			else if( memory_compare(
-				  (void *) section->type_string,
-				  (void *) "table2",
-				  6 ) == 0 )
-			{
-				if( read_table_sections != 0 )
-				{
-					read_count = libewf_segment_file_read_table2_section(
-						      segment_file,
-						      section,
-						      file_io_pool,
-						      file_io_pool_entry,
-						      error );
-				}
-#if defined( HAVE_VERBOSE_OUTPUT )
-				known_section = 1;
-#endif
-			}
-			else if( memory_compare(
-				  (void *) section->type_string,
-				  (void *) "volume",
-				  6 ) == 0 )
-			{
-				read_count = libewf_segment_file_read_volume_section(
-					      segment_file,
-					      section,
-					      file_io_pool,
-					      file_io_pool_entry,
-					      internal_handle->media_values,
-					      error );
+		return( -1 );
+	}
+	if( read_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read batch.",
+		 function );
 
-				initialize_chunk_values = 1;
+		return( -1 );
+	}
+	if( internal_handle->statistics != NULL )
+	{
+		if( libewf_statistics_get_current_time(
+		     &start_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve start time.",
+			 function );
 
-#if defined( HAVE_VERBOSE_OUTPUT )
-				known_section = 1;
-#endif
-			}
+			return( -1 );
 		}
-		else if( section->type_string_length == 7 )
+	}
+	/* The chunks of a read-only handle bypass the chunks cache
+	 */
+	if( ( internal_handle->write_io_handle == NULL )
+	 && ( internal_handle->read_io_handle != NULL ) )
+	{
+		read_directly = 1;
+	}
+	do
+	{
+		if( internal_handle->io_handle->abort != 0 )
 		{
-			if( memory_compare(
-			     (void *) section->type_string,
-			     (void *) "header2",
-			     7 ) == 0 )
-			{
-				read_count = libewf_section_compressed_string_read(
-					      section,
-				              internal_handle->io_handle,
-					      file_io_pool,
-					      file_io_pool_entry,
-				              internal_handle->io_handle->compression_method,
-					      &string_data,
-					      &string_data_size,
-					      error );
+			break;
+		}
+		result = libewf_read_batch_get_next_chunks(
+		          read_batch,
+		          error );
 
-				if( read_count == -1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read header2 file object string.",
-					 function );
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next chunks.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		/* Read the chunk data in ascending order of the (media) offset which is also the order
+		 * of the chunks in the segment files
+		 */
+		for( chunk_index = 0;
+		     chunk_index < read_batch->number_of_chunks;
+		     chunk_index++ )
+		{
+			if( read_directly == 0 )
+			{
+				break;
+			}
+			chunk = &( read_batch->chunks[ chunk_index ] );
 
-					goto on_error;
-				}
-#if defined( HAVE_DEBUG_OUTPUT )
+			result = libewf_internal_handle_read_packed_chunk_data_from_file_io_pool(
+			          internal_handle,
+			          file_io_pool,
+			          chunk->chunk_index,
+			          (off64_t) ( chunk->chunk_index * internal_handle->io_handle->chunk_size ),
+			          &( chunk->chunk_data ),
+			          error );
+
+			if( result == -1 )
+			{
+#if defined( HAVE_VERBOSE_OUTPUT )
 				if( libcnotify_verbose != 0 )
 				{
-					if( libewf_debug_utf16_stream_print(
-					     "Header2",
-					     string_data,
-					     string_data_size,
-					     error ) != 1 )
+					if( ( error != NULL )
+					 && ( *error != NULL ) )
 					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-						 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-						 "%s: unable to print header2.",
-						 function );
-
-						goto on_error;
+						libcnotify_print_error_backtrace(
+						 *error );
 					}
 				}
 #endif
-				if( header_sections->header2 == NULL )
-				{
-					header_sections->header2      = string_data;
-					header_sections->header2_size = string_data_size;
-				}
-				else
-				{
-					memory_free(
-					 string_data );
-				}
-				string_data = NULL;
+				/* The chunk is read by means of the chunks cache which reports the error
+				 */
+				libcerror_error_free(
+				 error );
+			}
+		}
+		if( libewf_read_batch_unpack_chunks(
+		     read_batch,
+		     internal_handle->statistics,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to unpack chunks.",
+			 function );
 
-				header_sections->number_of_header_sections += 1;
+			goto on_error;
+		}
+		chunk             = &( read_batch->chunks[ read_batch->number_of_chunks - 1 ] );
+		window_end_offset = (off64_t) ( chunk->chunk_index * internal_handle->io_handle->chunk_size ) + (off64_t) chunk->data_size;
 
-				header_section_found = 1;
+		for( request_index = read_batch->active_request_index;
+		     request_index < read_batch->number_of_requests;
+		     request_index++ )
+		{
+			request = read_batch->sorted_requests[ request_index ];
 
-#if defined( HAVE_VERBOSE_OUTPUT )
-				known_section = 1;
-#endif
+			if( request->offset >= window_end_offset )
+			{
+				break;
 			}
-			else if( memory_compare(
-				  (void *) section->type_string,
-				  (void *) "xheader",
-				  7 ) == 0 )
+			if( request->read_count == -1 )
 			{
-				read_count = libewf_section_compressed_string_read(
-					      section,
-				              internal_handle->io_handle,
-					      file_io_pool,
-					      file_io_pool_entry,
-				              internal_handle->io_handle->compression_method,
-					      &string_data,
-					      &string_data_size,
-					      error );
+				continue;
+			}
+			request_end_offset = request->offset + (off64_t) request->buffer_size;
 
-				if( read_count == -1 )
+			for( chunk_index = 0;
+			     chunk_index < read_batch->number_of_chunks;
+			     chunk_index++ )
+			{
+				chunk        = &( read_batch->chunks[ chunk_index ] );
+				chunk_offset = (off64_t) ( chunk->chunk_index * internal_handle->io_handle->chunk_size );
+
+				if( chunk_offset >= request_end_offset )
 				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read xheader string.",
-					 function );
+					break;
+				}
+				if( ( chunk_offset + (off64_t) chunk->data_size ) <= request->offset )
+				{
+					continue;
+				}
+				piece_offset = chunk_offset;
 
-					goto on_error;
+				if( piece_offset < request->offset )
+				{
+					piece_offset = request->offset;
 				}
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
+				piece_size = (size_t) ( chunk_offset + (off64_t) chunk->data_size - piece_offset );
+
+				if( piece_size > (size_t) ( request_end_offset - piece_offset ) )
 				{
-					if( libewf_debug_utf8_stream_print(
-					     "XHeader",
-					     string_data,
-					     string_data_size,
-					     error ) != 1 )
+					piece_size = (size_t) ( request_end_offset - piece_offset );
+				}
+				if( chunk->chunk_data != NULL )
+				{
+					if( memory_copy(
+					     &( ( request->buffer )[ piece_offset - request->offset ] ),
+					     &( ( chunk->chunk_data->data )[ piece_offset - chunk_offset ] ),
+					     piece_size ) == NULL )
 					{
 						libcerror_error_set(
 						 error,
-						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-						 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-						 "%s: unable to print xheader.",
-						 function );
+						 LIBCERROR_ERROR_DOMAIN_MEMORY,
+						 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+						 "%s: unable to copy chunk: %" PRIu64 " data to buffer: %d.",
+						 function,
+						 chunk->chunk_index,
+						 request->request_index );
 
 						goto on_error;
 					}
-				}
-#endif
-				if( header_sections->xheader == NULL )
-				{
-					header_sections->xheader      = string_data;
-					header_sections->xheader_size = string_data_size;
+					read_count = (ssize_t) piece_size;
 				}
 				else
 				{
-					memory_free(
-					 string_data );
+					read_count = libewf_internal_handle_read_chunk_data_from_file_io_pool(
+					              internal_handle,
+					              file_io_pool,
+					              chunk->chunk_index,
+					              piece_offset,
+					              &( ( request->buffer )[ piece_offset - request->offset ] ),
+					              piece_size,
+					              NULL,
+					              error );
 				}
-				string_data = NULL;
-
-				header_sections->number_of_header_sections += 1;
-
-				header_section_found = 1;
-
+				if( read_count != (ssize_t) piece_size )
+				{
 #if defined( HAVE_VERBOSE_OUTPUT )
-				known_section = 1;
+					if( libcnotify_verbose != 0 )
+					{
+						if( ( error != NULL )
+						 && ( *error != NULL ) )
+						{
+							libcnotify_print_error_backtrace(
+							 *error );
+						}
+					}
 #endif
-			}
-		}
-#if defined( HAVE_VERBOSE_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			if( known_section == 0 )
-			{
-				if( segment_file->major_version == 1 )
-				{
-					libcnotify_printf(
-					 "%s: unsupported section type: %s.\n",
-					 function,
-					 (char *) section->type_string );
-				}
-				else if( segment_file->major_version == 2 )
-				{
-					libcnotify_printf(
-					 "%s: unsupported section type: 0x%08" PRIx32 ".\n",
-					 function,
-					 section->type );
+					libcerror_error_free(
+					 error );
+
+					request->read_count = -1;
+
+					break;
 				}
+				request->read_count += read_count;
 			}
 		}
-#endif
-		if( read_count == -1 )
+		if( libewf_read_batch_free_chunks(
+		     read_batch,
+		     error ) != 1 )
 		{
-			if( section->type_string_length > 0 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_READ_FAILED,
-				 "%s: unable to read section: %s.",
-				 function,
-				 (char *) section->type_string );
-			}
-			else
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_READ_FAILED,
-				 "%s: unable to read section: 0x%08" PRIx32 ".",
-				 function,
-				 section->type );
-			}
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunks.",
+			 function );
+
 			goto on_error;
 		}
-		if( initialize_chunk_values != 0 )
+	}
+	while( result == 1 );
+
+	result = 1;
+
+	for( request_index = 0;
+	     request_index < read_batch->number_of_requests;
+	     request_index++ )
+	{
+		request = read_batch->sorted_requests[ request_index ];
+
+		/* Requests that were not read completely due to an abort are marked as failed
+		 */
+		if( request->read_count != (ssize_t) request->buffer_size )
 		{
-			if( segment_file->type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
-			{
-				segment_file->io_handle->segment_file_type = LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART;
-				segment_file->io_handle->format            = LIBEWF_FORMAT_SMART;
-			}
-			if( libewf_media_values_calculate_chunk_size(
-			     internal_handle->media_values,
+			request->read_count = -1;
+		}
+		if( request->read_count == -1 )
+		{
+			result = 0;
+
+			continue;
+		}
+		if( internal_handle->read_digest != NULL )
+		{
+			if( libewf_read_digest_update(
+			     internal_handle->read_digest,
+			     request->offset,
+			     request->buffer,
+			     (size_t) request->read_count,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-				 "%s: unable to calculate chunk size.",
+				 "%s: unable to update read digest.",
 				 function );
 
 				goto on_error;
 			}
-/* TODO refactor */
-			internal_handle->io_handle->chunk_size = internal_handle->media_values->chunk_size;
-
-			/* Do a preliminary dection of the EWF format for reading the sector table section
-			 */
-			if( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1 )
-			{
-				if( header_sections->number_of_header_sections == 1 )
-				{
-					internal_handle->io_handle->format = LIBEWF_FORMAT_ENCASE1;
-				}
-				else if( internal_handle->media_values->error_granularity == 0 )
-				{
-					internal_handle->io_handle->format = LIBEWF_FORMAT_ENCASE2;
-				}
-			}
-			initialize_chunk_values = 0;
 		}
 	}
-	if( header_section_found != 0 )
+	if( internal_handle->statistics != NULL )
 	{
-		if( libewf_header_sections_parse(
-		     header_sections,
-		     internal_handle->io_handle,
-		     internal_handle->header_values,
-		     &( internal_handle->io_handle->format ),
-		     error ) == -1 )
+		if( libewf_statistics_add_event(
+		     internal_handle->statistics,
+		     LIBEWF_STATISTICS_TYPE_READ_BUFFER,
+		     start_time,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to parse header sections.",
+			 "%s: unable to add read buffer statistics event.",
 			 function );
 
-			goto on_error;
-		}
+			return( -1 );
+		}
+	}
+	return( result );
+
+on_error:
+	libewf_read_batch_free_chunks(
+	 read_batch,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Reads (media) data at specific offsets into multiple buffers
+ * The chunks that are referenced by the requests are read and unpacked once,
+ * the unpacking is done in parallel if multi-threading is supported
+ * The number of bytes read per request is stored in read_counts, where -1 indicates the request failed
+ * The current offset is not changed
+ * Returns 1 if successful, 0 if one or more requests failed or -1 on error
+ */
+int libewf_handle_read_buffers_at_offsets(
+     libewf_handle_t *handle,
+     void * const *buffers,
+     const size_t *buffer_sizes,
+     const off64_t *offsets,
+     ssize_t *read_counts,
+     int number_of_requests,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	libewf_read_batch_t *read_batch           = NULL;
+	static char *function                     = "libewf_handle_read_buffers_at_offsets";
+	int request_index                         = 0;
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
 	}
-	if( single_files_section_found != 0 )
+	if( internal_handle->media_values == NULL )
 	{
-		if( libewf_single_files_parse(
-		     internal_handle->single_files,
-		     &( internal_handle->media_values->media_size ),
-		     &( internal_handle->io_handle->format ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to parse single files.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
 
-			goto on_error;
-		}
-		if( internal_handle->io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_EWF2_LOGICAL )
-		{
-			if( internal_handle->io_handle->format == LIBEWF_FORMAT_LOGICAL_ENCASE7 )
-			{
-				internal_handle->io_handle->format = LIBEWF_FORMAT_V2_LOGICAL_ENCASE7;
-			}
-		}
-		internal_handle->media_values->number_of_sectors = internal_handle->media_values->media_size
-		                                                 / internal_handle->media_values->bytes_per_sector;
+		return( -1 );
+	}
+	if( read_counts == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read counts.",
+		 function );
 
-		if( ( internal_handle->media_values->media_size % internal_handle->media_values->bytes_per_sector ) != 0 )
-		{
-			internal_handle->media_values->number_of_sectors += 1;
-		}
+		return( -1 );
 	}
-	if( libewf_header_sections_free(
-	     &header_sections,
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free header sections.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfcache_cache_free(
-	     &sections_cache,
+#endif
+	if( libewf_read_batch_initialize(
+	     &read_batch,
+	     internal_handle->io_handle,
+	     buffers,
+	     buffer_sizes,
+	     offsets,
+	     number_of_requests,
+	     internal_handle->media_values->media_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free sections cache.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create read batch.",
 		 function );
 
 		goto on_error;
 	}
-	return( 1 );
+	result = libewf_internal_handle_read_batch_from_file_io_pool(
+	          internal_handle,
+	          internal_handle->file_io_pool,
+	          read_batch,
+	          error );
 
-on_error:
-	if( string_data != NULL )
+	if( result == -1 )
 	{
-		memory_free(
-		 string_data );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffers.",
+		 function );
+
+		goto on_error;
 	}
-	if( header_sections != NULL )
+	for( request_index = 0;
+	     request_index < number_of_requests;
+	     request_index++ )
 	{
-		libewf_header_sections_free(
-		 &header_sections,
-		 NULL );
+		read_counts[ request_index ] = read_batch->requests[ request_index ].read_count;
 	}
-	if( sections_cache != NULL )
+	if( libewf_read_batch_free(
+	     &read_batch,
+	     error ) != 1 )
 	{
-		libfcache_cache_free(
-		 &sections_cache,
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free read batch.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+
+on_error:
+	if( read_batch != NULL )
+	{
+		libewf_read_batch_free(
+		 &read_batch,
 		 NULL );
 	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
 	return( -1 );
 }
 
-/* Opens the segment files for reading
- * Returns 1 if successful or -1 on error
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Reads the (media) data of a chunk into a buffer on behalf of the read scheduler
+ * The chunk data of a read-only handle is read while holding the read/write lock and unpacked without it,
+ * so that multiple chunks are unpacked in parallel
+ * Chunks that cannot be read directly are read by means of the chunks cache
+ * Returns the number of bytes read or -1 on error
  */
-int libewf_internal_handle_open_read_segment_files(
-     libewf_internal_handle_t *internal_handle,
-     libbfio_pool_t *file_io_pool,
-     libewf_segment_table_t *segment_table,
-     libcerror_error_t **error )
+ssize_t libewf_internal_handle_read_scheduled_chunk(
+         libewf_internal_handle_t *internal_handle,
+         uint64_t chunk_index,
+         uint8_t *chunk_buffer,
+         size_t chunk_buffer_size,
+         libcerror_error_t **error )
 {
-	libewf_segment_file_t *segment_file = NULL;
-	static char *function               = "libewf_internal_handle_open_read_segment_files";
-	size64_t maximum_segment_size       = 0;
-	size64_t segment_file_size          = 0;
-	uint32_t number_of_segments         = 0;
-	uint32_t segment_number             = 0;
-	int file_io_pool_entry              = 0;
-	int last_segment_file               = 0;
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_internal_handle_read_scheduled_chunk";
+	size_t data_size                = 0;
+	ssize_t read_count              = 0;
+	off64_t chunk_offset            = 0;
+	int result                      = 0;
 
 	if( internal_handle == NULL )
 	{
@@ -2962,888 +7052,1093 @@ int libewf_internal_handle_open_read_segment_files(
 
 		return( -1 );
 	}
-	if( internal_handle->read_io_handle == NULL )
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - missing read IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
 		 function );
 
 		return( -1 );
 	}
-	if( segment_table == NULL )
+	if( chunk_buffer == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid segment table.",
+		 "%s: invalid chunk buffer.",
 		 function );
 
 		return( -1 );
 	}
-	if( libewf_segment_table_get_number_of_segments(
-	     segment_table,
-	     &number_of_segments,
-	     error ) != 1 )
+	chunk_offset = (off64_t) ( chunk_index * internal_handle->media_values->chunk_size );
+
+	if( (size64_t) chunk_offset >= internal_handle->media_values->media_size )
+	{
+		return( 0 );
+	}
+	data_size = (size_t) internal_handle->media_values->chunk_size;
+
+	if( (size64_t) data_size > ( internal_handle->media_values->media_size - (size64_t) chunk_offset ) )
+	{
+		data_size = (size_t) ( internal_handle->media_values->media_size - (size64_t) chunk_offset );
+	}
+	if( data_size > chunk_buffer_size )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of segments from segment table.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid chunk buffer size value too small.",
 		 function );
 
 		return( -1 );
 	}
-	if( number_of_segments == 0 )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid number of segments value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
-		return( -1 );
-	}
-	for( segment_number = 0;
-	     segment_number < number_of_segments;
-	     segment_number++ )
-	{
-		if( libewf_segment_table_get_segment_by_index(
-		     segment_table,
-		     segment_number,
-		     &file_io_pool_entry,
-		     &segment_file_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
-			 function,
-			 segment_number );
-
-			return( -1 );
-		}
-		if( ( segment_number == 0 )
-		 && ( number_of_segments > 1 ) )
-		{
-			/* Round the maximum segment size to nearest number of KiB
-			 */
-			maximum_segment_size = ( segment_file_size >> 10 ) << 10;
-
-			if( libewf_segment_table_set_maximum_segment_size(
-			     segment_table,
-			     maximum_segment_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-				 "%s: unable to set maximum segment size in segment table.",
-				 function );
-
-				return( -1 );
-			}
-		}
-		if( libewf_segment_table_get_segment_file_by_index(
-		     segment_table,
-		     segment_number,
-		     file_io_pool,
-		     &segment_file,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
-			 function,
-			 segment_number );
-
-			return( -1 );
-		}
-		if( segment_file == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing segment file: %" PRIu32 ".",
-			 function,
-			 segment_number );
-
-			return( -1 );
-		}
-		if( segment_file->segment_number != ( segment_number + 1 ) )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_INPUT,
-			 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
-			 "%s: segment number mismatch ( stored: %" PRIu32 ", expected: %" PRIu32 " ).",
-			 function,
-			 segment_file->segment_number,
-			 segment_number + 1 );
+		return( -1 );
+	}
+	if( ( internal_handle->write_io_handle == NULL )
+	 && ( internal_handle->read_io_handle != NULL ) )
+	{
+		result = libewf_internal_handle_read_packed_chunk_data_from_file_io_pool(
+		          internal_handle,
+		          internal_handle->file_io_pool,
+		          chunk_index,
+		          chunk_offset,
+		          &chunk_data,
+		          error );
 
-			return( -1 );
-		}
-		if( segment_file->segment_number == 1 )
+		if( result == -1 )
 		{
-			internal_handle->io_handle->segment_file_type  = segment_file->type;
-			internal_handle->io_handle->major_version      = segment_file->major_version;
-			internal_handle->io_handle->minor_version      = segment_file->minor_version;
-			internal_handle->io_handle->compression_method = segment_file->compression_method;
-
-			if( segment_file->major_version == 2 )
+#if defined( HAVE_VERBOSE_OUTPUT )
+			if( libcnotify_verbose != 0 )
 			{
-				if( memory_copy(
-				     internal_handle->media_values->set_identifier,
-				     segment_file->set_identifier,
-				     16 ) == NULL )
+				if( ( error != NULL )
+				 && ( *error != NULL ) )
 				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_MEMORY,
-					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-					 "%s: unable to copy segment file set identifier to media values.",
-					 function );
-
-					return( -1 );
+					libcnotify_print_error_backtrace(
+					 *error );
 				}
 			}
+#endif
+			libcerror_error_free(
+			 error );
 		}
-		else
-		{
-			if( ( segment_file->major_version != internal_handle->io_handle->major_version )
-			 || ( segment_file->minor_version != internal_handle->io_handle->minor_version ) )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_INPUT,
-				 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
-				 "%s: segment file format version value mismatch.",
-				 function );
+	}
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
 
-				return( -1 );
-			}
-			if( internal_handle->io_handle->major_version == 2 )
-			{
-				if( segment_file->compression_method != internal_handle->io_handle->compression_method )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_INPUT,
-					 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
-					 "%s: segment file compression method value mismatch.",
-					 function );
+		goto on_error;
+	}
+	result = 0;
 
-					return( -1 );
-				}
-				if( memory_compare(
-				     internal_handle->media_values->set_identifier,
-				     segment_file->set_identifier,
-				     16 ) != 0 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_INPUT,
-					 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
-					 "%s: segment file set identifier value mismatch.",
-					 function );
+	if( chunk_data != NULL )
+	{
+		result = libewf_chunk_data_unpack(
+		          chunk_data,
+		          internal_handle->io_handle,
+		          NULL,
+		          error );
 
-					return( -1 );
+		if( result != 1 )
+		{
+#if defined( HAVE_VERBOSE_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				if( ( error != NULL )
+				 && ( *error != NULL ) )
+				{
+					libcnotify_print_error_backtrace(
+					 *error );
 				}
 			}
+#endif
+			libcerror_error_free(
+			 error );
+
+			result = 0;
 		}
-		if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_LAST ) != 0 )
-		{
-			last_segment_file = 1;
-		}
-		if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_ENCRYPTED ) != 0 )
-		{
-/* TODO get key info */
-			internal_handle->io_handle->format       = LIBEWF_FORMAT_V2_ENCASE7;
-			internal_handle->io_handle->is_encrypted = 1;
-		}
-		if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_CORRUPTED ) != 0 )
+		else if( ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+		      || ( chunk_data->data_size != data_size ) )
 		{
-			segment_table->flags |= LIBEWF_SEGMENT_TABLE_FLAG_IS_CORRUPTED;
+			result = 0;
 		}
-		if( libewf_internal_handle_open_read_segment_file_section_data(
-		     internal_handle,
-		     segment_file,
-		     file_io_pool,
-		     file_io_pool_entry,
-		     error ) != 1 )
+		else if( memory_copy(
+		          chunk_buffer,
+		          chunk_data->data,
+		          data_size ) == NULL )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read section data from segment file: %" PRIu32 ".",
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy chunk: %" PRIu64 " data.",
 			 function,
-			 segment_number );
+			 chunk_index );
 
-			return( -1 );
+			goto on_error;
 		}
-		if( libewf_segment_table_set_segment_storage_media_size_by_index(
-		     segment_table,
-		     segment_number,
-		     segment_file->storage_media_size,
+		if( libewf_chunk_data_free(
+		     &chunk_data,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to set mapped range of element: %" PRIu32 " in segment table.",
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk: %" PRIu64 " data.",
 			 function,
-			 segment_number );
+			 chunk_index );
 
-			return( -1 );
+			goto on_error;
 		}
-		internal_handle->read_io_handle->storage_media_size_read += segment_file->storage_media_size;
-		internal_handle->read_io_handle->number_of_chunks_read   += segment_file->number_of_chunks;
 	}
-	if( last_segment_file == 0 )
+	if( result != 0 )
+	{
+		return( (ssize_t) data_size );
+	}
+	/* Chunks that cannot be read directly are read by means of the chunks cache
+	 */
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing done section.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			if( ( error != NULL )
-			 && ( *error != NULL ) )
-			{
-				libcnotify_print_error_backtrace(
-				 *error );
-			}
-		}
-#endif
-		libcerror_error_free(
-		 error );
+		return( -1 );
+	}
+	read_count = libewf_internal_handle_read_chunk_data_from_file_io_pool(
+	              internal_handle,
+	              internal_handle->file_io_pool,
+	              chunk_index,
+	              chunk_offset,
+	              chunk_buffer,
+	              data_size,
+	              NULL,
+	              error );
 
-		segment_table->flags |= LIBEWF_SEGMENT_TABLE_FLAG_IS_CORRUPTED;
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		libcthreads_read_write_lock_release_for_write(
+		 internal_handle->read_write_lock,
+		 NULL );
+
+		return( -1 );
 	}
-	return( 1 );
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+	return( read_count );
+
+on_error:
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	return( -1 );
 }
 
-/* Opens a set of EWF file(s) using a Basic File IO (bfio) pool
- * This function is not multi-thread safe acquire write lock before call
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+/* Reads (media) data at a specific offset asynchronously
+ * The callback function is called when the read has completed with the number of bytes read or -1 on error,
+ * from a thread of the handle if multi-threading is supported or before the function returns otherwise
+ * Concurrent reads of the same chunk share the read and unpacking of the chunk
+ * The buffer must remain available until the callback function has been called
+ * The callback function must not close or free the handle or wait for the asynchronous reads,
+ * since these wait for the read that calls the callback function to complete
+ * The current offset is not changed and the data is not included in the read digest
  * Returns 1 if successful or -1 on error
  */
-int libewf_internal_handle_open_file_io_pool(
-     libewf_internal_handle_t *internal_handle,
-     libbfio_pool_t *file_io_pool,
-     int access_flags,
-     libewf_segment_table_t *segment_table,
+int libewf_handle_read_buffer_at_offset_async(
+     libewf_handle_t *handle,
+     void *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     void (*callback)(
+            libewf_handle_t *handle,
+            void *buffer,
+            ssize_t read_count,
+            void *callback_data ),
+     void *callback_data,
      libcerror_error_t **error )
 {
-	libbfio_handle_t *file_io_handle    = NULL;
-	libewf_segment_file_t *segment_file = NULL;
-	static char *function               = "libewf_internal_handle_open_file_io_pool";
-	size64_t segment_file_size          = 0;
-	ssize_t read_count                  = 0;
-	int file_io_pool_entry              = 0;
-	int number_of_file_io_handles       = 0;
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_read_buffer_at_offset_async";
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libewf_read_scheduler_t *read_scheduler   = NULL;
+	int result                                = 1;
+#else
+	ssize_t read_count                        = 0;
+#endif
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
 
-	if( internal_handle == NULL )
+		return( -1 );
+	}
+	if( callback == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 "%s: invalid callback function.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->file_io_pool != NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - file IO pool value already set.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
+	if( internal_handle->read_scheduler == NULL )
+	{
+		if( libewf_read_scheduler_initialize(
+		     &( internal_handle->read_scheduler ),
+		     internal_handle->media_values->chunk_size,
+		     internal_handle->media_values->media_size,
+		     LIBEWF_READ_SCHEDULER_NUMBER_OF_THREADS,
+		     (ssize_t (*)(intptr_t *, uint64_t, uint8_t *, size_t, libcerror_error_t **)) &libewf_internal_handle_read_scheduled_chunk,
+		     (intptr_t *) internal_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create read scheduler.",
+			 function );
+
+			libcthreads_read_write_lock_release_for_write(
+			 internal_handle->read_write_lock,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	/* The reference keeps the read scheduler from being freed by a concurrent close
+	 */
+	read_scheduler = internal_handle->read_scheduler;
+
+	if( libewf_read_scheduler_grab(
+	     read_scheduler,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read scheduler.",
 		 function );
 
+		libcthreads_read_write_lock_release_for_write(
+		 internal_handle->read_write_lock,
+		 NULL );
+
 		return( -1 );
 	}
-	if( internal_handle->chunk_table != NULL )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk table value already set.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
+		libewf_read_scheduler_release(
+		 read_scheduler,
+		 NULL );
+
 		return( -1 );
 	}
-	if( internal_handle->chunk_groups_cache != NULL )
+	/* The read is submitted without holding the read/write lock
+	 * since the threads of the read scheduler need the lock to read the chunks
+	 */
+	if( libewf_read_scheduler_submit(
+	     read_scheduler,
+	     handle,
+	     (uint8_t *) buffer,
+	     buffer_size,
+	     offset,
+	     callback,
+	     callback_data,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunks group cache value already set.",
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to submit read.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-	if( internal_handle->chunks_cache != NULL )
+	if( libewf_read_scheduler_release(
+	     read_scheduler,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunks cache value already set.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read scheduler.",
 		 function );
 
+		result = -1;
+	}
+	if( result != 1 )
+	{
 		return( -1 );
 	}
-	if( internal_handle->hash_sections != NULL )
+#else
+	if( libewf_handle_read_buffers_at_offsets(
+	     handle,
+	     &buffer,
+	     &buffer_size,
+	     &offset,
+	     &read_count,
+	     1,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		return( -1 );
+	}
+	callback(
+	 handle,
+	 buffer,
+	 read_count,
+	 callback_data );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+	return( 1 );
+}
+
+/* Waits until the pending asynchronous reads have completed
+ * This function cannot be called from the callback function of an asynchronous read
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_wait_for_async_reads(
+     libewf_handle_t *handle,
+     libcerror_error_t **error )
+{
+	static char *function                     = "libewf_handle_wait_for_async_reads";
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libewf_internal_handle_t *internal_handle = NULL;
+	libewf_read_scheduler_t *read_scheduler   = NULL;
+	int result                                = 1;
+#endif
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - hash sections value already set.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->single_files != NULL )
+	/* The reference keeps the read scheduler from being freed by a concurrent close
+	 */
+	read_scheduler = internal_handle->read_scheduler;
+
+	if( read_scheduler != NULL )
+	{
+		if( libewf_read_scheduler_grab(
+		     read_scheduler,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read scheduler.",
+			 function );
+
+			libcthreads_read_write_lock_release_for_read(
+			 internal_handle->read_write_lock,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - single files value already set.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
+		result = -1;
+	}
+	/* The read/write lock is not held while waiting
+	 * since the threads of the read scheduler need the lock to read the chunks
+	 */
+	if( read_scheduler != NULL )
+	{
+		if( result == 1 )
+		{
+			if( libewf_read_scheduler_wait(
+			     read_scheduler,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to wait for read scheduler.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libewf_read_scheduler_release(
+		     read_scheduler,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read scheduler.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result != 1 )
+	{
 		return( -1 );
 	}
-	if( file_io_pool == NULL )
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+	return( 1 );
+}
+
+/* Starts calculating digests over the media data that is read
+ * The digests are calculated from the current offset onwards while the media data is read,
+ * the media data must be read in order for the digests to be available
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_start_read_digest(
+     libewf_handle_t *handle,
+     uint8_t digest_types,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_start_read_digest";
+	int result                                = 1;
+
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid file IO pool.",
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( ( access_flags & ~( LIBEWF_ACCESS_FLAG_READ | LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME ) ) != 0 )
-	 || ( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	  &&  ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 ) ) )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported access flags.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
+#endif
+	if( internal_handle->read_digest != NULL )
 	{
-		if( libewf_read_io_handle_initialize(
-		     &( internal_handle->read_io_handle ),
+		if( libewf_read_digest_free(
+		     &( internal_handle->read_digest ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create read IO handle.",
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read digest.",
 			 function );
 
-			goto on_error;
+			result = -1;
 		}
 	}
-	if( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
+	if( result == 1 )
 	{
-		if( libewf_write_io_handle_initialize(
-		     &( internal_handle->write_io_handle ),
+		if( libewf_read_digest_initialize(
+		     &( internal_handle->read_digest ),
+		     digest_types,
+		     internal_handle->current_offset,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create write IO handle.",
+			 "%s: unable to create read digest.",
 			 function );
 
-			goto on_error;
+			result = -1;
 		}
 	}
-	if( libewf_chunk_table_initialize(
-	     &( internal_handle->chunk_table ),
-	     internal_handle->io_handle,
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create chunk table.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Reads the media data of a specific range and calculates its digests
+ * The media data is digested by a dedicated thread while the next media data
+ * is read and decoded, if multi-threading is supported
+ * The digests can be retrieved with libewf_handle_get_read_digest
+ * Returns 1 if successful, 0 if aborted or -1 on error
+ */
+int libewf_handle_read_digest_range(
+     libewf_handle_t *handle,
+     off64_t range_offset,
+     size64_t range_size,
+     uint8_t digest_types,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	libewf_read_digest_t *read_digest         = NULL;
+	uint8_t *buffer                           = NULL;
+	static char *function                     = "libewf_handle_read_digest_range";
+	size64_t remaining_size                   = 0;
+	size_t read_size                          = 0;
+	ssize_t read_count                        = 0;
+	int result                                = 1;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libewf_read_digest_buffer_t *digest_buffer = NULL;
+#endif
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfcache_cache_initialize(
-	     &( internal_handle->chunk_groups_cache ),
-	     LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNK_GROUPS,
-	     error ) != 1 )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create chunk groups cache.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfcache_cache_initialize(
-	     &( internal_handle->chunks_cache ),
-	     LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNKS,
-	     error ) != 1 )
+	if( internal_handle->file_io_pool == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create chunks cache.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libewf_header_values_initialize(
-	     &( internal_handle->header_values ),
-	     error ) != 1 )
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create header values.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libewf_hash_sections_initialize(
-	     &( internal_handle->hash_sections ),
-	     error ) != 1 )
+	if( ( range_offset < 0 )
+	 || ( (size64_t) range_offset > internal_handle->media_values->media_size ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create hash sections.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid range offset value out of bounds.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libewf_single_files_initialize(
-	     &( internal_handle->single_files ),
+	if( range_size > ( internal_handle->media_values->media_size - (size64_t) range_offset ) )
+	{
+		range_size = internal_handle->media_values->media_size - (size64_t) range_offset;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create single files.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libcdata_array_empty(
-	     internal_handle->sessions,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
+#endif
+	/* The read digest is attached to the handle once the range has been digested,
+	 * so that the reads below do not update it
+	 */
+	if( internal_handle->read_digest != NULL )
+	{
+		if( libewf_read_digest_free(
+		     &( internal_handle->read_digest ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read digest.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libewf_read_digest_initialize(
+	     &read_digest,
+	     digest_types,
+	     range_offset,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty sessions array.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create read digest.",
 		 function );
 
 		goto on_error;
 	}
-	if( libcdata_array_empty(
-	     internal_handle->tracks,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
-	     error ) != 1 )
+	if( libewf_internal_handle_seek_offset(
+	     internal_handle,
+	     range_offset,
+	     SEEK_SET,
+	     error ) == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty tracks array.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 ".",
+		 function,
+		 range_offset );
 
 		goto on_error;
 	}
-	if( libcdata_range_list_empty(
-	     internal_handle->acquiry_errors,
-	     NULL,
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libewf_read_digest_start_thread(
+	     read_digest,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty acquiry errors range list.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to start digest thread.",
 		 function );
 
 		goto on_error;
 	}
-	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
+#else
+	read_size = LIBEWF_READ_DIGEST_BUFFER_SIZE;
+
+	if( (size64_t) read_size > range_size )
 	{
-		if( libbfio_pool_get_number_of_handles(
-		     file_io_pool,
-		     &number_of_file_io_handles,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve the number of handles in the pool.",
-			 function );
+		read_size = (size_t) range_size;
+	}
+	if( read_size > 0 )
+	{
+		buffer = (uint8_t *) memory_allocate(
+		                      sizeof( uint8_t ) * read_size );
 
-			goto on_error;
-		}
-		if( libewf_segment_file_initialize(
-		     &segment_file,
-		     internal_handle->io_handle,
-		     error ) != 1 )
+		if( buffer == NULL )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create segment file.",
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create buffer.",
 			 function );
 
 			goto on_error;
 		}
-		for( file_io_pool_entry = 0;
-		     file_io_pool_entry < number_of_file_io_handles;
-		     file_io_pool_entry++ )
-		{
-			if( libbfio_pool_get_size(
-			     file_io_pool,
-			     file_io_pool_entry,
-			     &segment_file_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve size of file IO pool entry: %d.",
-				 function,
-				 file_io_pool_entry );
-
-				goto on_error;
-			}
-			if( libbfio_pool_get_handle(
-			     file_io_pool,
-			     file_io_pool_entry,
-			     &file_io_handle,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to retrieve file IO handle: %d from pool.",
-				 function,
-				 file_io_pool_entry );
-
-				goto on_error;
-			}
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
-			{
-				libcnotify_printf(
-				 "%s: processing file IO pool entry: %d.\n",
-				 function,
-				 file_io_pool_entry );
-			}
+	}
 #endif
-			read_count = libewf_segment_file_read_file_header(
-				      segment_file,
-				      file_io_pool,
-				      file_io_pool_entry,
-				      error );
-
-			if( read_count < 0 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_READ_FAILED,
-				 "%s: unable to read segment file header.",
-				 function );
+	remaining_size = range_size;
 
-				goto on_error;
-			}
-			if( segment_file->segment_number == 0 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_INPUT,
-				 LIBCERROR_INPUT_ERROR_INVALID_DATA,
-				 "%s: invalid segment number: 0 in file IO pool entry: %d.",
-				 function,
-				 file_io_pool_entry );
+	while( remaining_size > 0 )
+	{
+		if( internal_handle->io_handle->abort != 0 )
+		{
+			result = 0;
 
-				goto on_error;
-			}
-			if( libewf_segment_table_append_segment_by_segment_file(
-			     segment_table,
-			     segment_file,
-			     file_io_pool_entry,
-			     segment_file_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to append segment: %" PRIu32 " to segment table.",
-				 function,
-				 segment_file->segment_number );
+			break;
+		}
+		read_size = LIBEWF_READ_DIGEST_BUFFER_SIZE;
 
-				goto on_error;
-			}
+		if( (size64_t) read_size > remaining_size )
+		{
+			read_size = (size_t) remaining_size;
 		}
-		if( libewf_segment_file_free(
-		     &segment_file,
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libewf_read_digest_grab_buffer(
+		     read_digest,
+		     &digest_buffer,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free segment file.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to grab digest buffer.",
 			 function );
 
 			goto on_error;
 		}
-		if( libewf_internal_handle_open_read_segment_files(
-		     internal_handle,
-		     file_io_pool,
-		     segment_table,
-		     error ) != 1 )
+		buffer = digest_buffer->data;
+#endif
+		read_count = libewf_internal_handle_read_buffer_from_file_io_pool(
+		              internal_handle,
+		              internal_handle->file_io_pool,
+		              buffer,
+		              read_size,
+		              error );
+
+		if( read_count != (ssize_t) read_size )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read segment files.",
-			 function );
-
-			if( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 )
-			{
-				goto on_error;
-			}
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
-			{
-				if( ( error != NULL )
-				 && ( *error != NULL ) )
-				{
-					libcnotify_print_error_backtrace(
-					 *error );
-				}
-			}
-#endif
-			libcerror_error_free(
-			 error );
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer.",
+			 function );
+
+			goto on_error;
 		}
-		if( internal_handle->media_values == NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		digest_buffer->data_size = read_size;
+
+		if( libewf_read_digest_push_buffer(
+		     read_digest,
+		     digest_buffer,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid handle - missing media values.",
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push digest buffer.",
 			 function );
 
 			goto on_error;
 		}
-/* TODO refactor */
-		if( internal_handle->single_files->ltree_data == NULL )
-		{
-			if( libewf_internal_handle_get_media_values(
-			     internal_handle,
-			     &( internal_handle->media_values->media_size ),
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to determine media values.",
-				 function );
+		digest_buffer = NULL;
+		buffer        = NULL;
 
-				goto on_error;
-			}
-		}
-	}
-	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
-	 && ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
-	{
-		if( internal_handle->write_io_handle->values_initialized == 0 )
+		if( read_digest->has_failed != 0 )
 		{
-			if( libewf_write_io_handle_initialize_values(
-			     internal_handle->write_io_handle,
-			     internal_handle->io_handle,
-			     internal_handle->media_values,
-			     segment_table,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to initialize write IO handle values.",
-				 function );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to digest media data.",
+			 function );
 
-				goto on_error;
-			}
+			goto on_error;
 		}
-		if( libewf_write_io_handle_initialize_resume(
-		     internal_handle->write_io_handle,
-		     internal_handle->io_handle,
-		     file_io_pool,
-		     internal_handle->media_values,
-		     segment_table,
-		     internal_handle->chunk_table,
-		     internal_handle->read_io_handle,
-		     &( internal_handle->current_offset ),
+#else
+		if( libewf_read_digest_update(
+		     read_digest,
+		     read_digest->current_offset,
+		     buffer,
+		     read_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize write IO handle to resume.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update read digest.",
 			 function );
 
 			goto on_error;
 		}
+#endif
+		remaining_size -= read_size;
 	}
-			internal_handle->io_handle->chunk_size = internal_handle->media_values->chunk_size;
-	internal_handle->io_handle->access_flags = access_flags;
-	internal_handle->file_io_pool            = file_io_pool;
-	internal_handle->segment_table           = segment_table;
-
-	return( 1 );
-
-on_error:
-	if( segment_file != NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libewf_read_digest_stop_thread(
+	     read_digest,
+	     error ) != 1 )
 	{
-		libewf_segment_file_free(
-		 &segment_file,
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to stop digest thread.",
+		 function );
+
+		goto on_error;
 	}
-	if( internal_handle->single_files != NULL )
+#else
+	if( buffer != NULL )
 	{
-		libewf_single_files_free(
-		 &( internal_handle->single_files ),
-		 NULL );
+		memory_free(
+		 buffer );
+
+		buffer = NULL;
 	}
-	if( internal_handle->hash_sections != NULL )
+#endif
+	if( result == 1 )
 	{
-		libewf_hash_sections_free(
-		 &( internal_handle->hash_sections ),
-		 NULL );
+		if( libewf_read_digest_finalize(
+		     read_digest,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize read digest.",
+			 function );
+
+			goto on_error;
+		}
+		internal_handle->read_digest = read_digest;
 	}
-	if( internal_handle->header_values != NULL )
+	else
 	{
-		libfvalue_table_free(
-		 &( internal_handle->header_values ),
-		 NULL );
+		if( libewf_read_digest_free(
+		     &read_digest,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read digest.",
+			 function );
+
+			goto on_error;
+		}
 	}
-	if( internal_handle->chunks_cache != NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
-		libfcache_cache_free(
-		 &( internal_handle->chunks_cache ),
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
 	}
-	if( internal_handle->chunk_groups_cache != NULL )
+#endif
+	return( result );
+
+on_error:
+	if( read_digest != NULL )
 	{
-		libfcache_cache_free(
-		 &( internal_handle->chunk_groups_cache ),
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		/* A digest buffer that is still grabbed is not returned, the stop buffer
+		 * is grabbed from the buffers released by the digest thread
+		 */
+		libewf_read_digest_stop_thread(
+		 read_digest,
 		 NULL );
-	}
-	if( internal_handle->chunk_table != NULL )
-	{
-		libewf_chunk_table_free(
-		 &( internal_handle->chunk_table ),
+#endif
+		libewf_read_digest_free(
+		 &read_digest,
 		 NULL );
 	}
-	if( internal_handle->write_io_handle != NULL )
-	{
-		libewf_write_io_handle_free(
-		 &( internal_handle->write_io_handle ),
-		 error );
-	}
-	if( internal_handle->read_io_handle != NULL )
+#if !defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( buffer != NULL )
 	{
-		libewf_read_io_handle_free(
-		 &( internal_handle->read_io_handle ),
-		 error );
+		memory_free(
+		 buffer );
 	}
+#endif
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
 	return( -1 );
 }
 
-/* Opens a set of EWF file(s) using a Basic File IO (bfio) pool
- * Returns 1 if successful or -1 on error
+/* Retrieves a specific digest calculated over the media data that was read
+ * The digest calculation is finalized, media data that is read afterwards is not digested
+ * Returns 1 if successful, 0 if not available or -1 on error
  */
-int libewf_handle_open_file_io_pool(
+int libewf_handle_get_read_digest(
      libewf_handle_t *handle,
-     libbfio_pool_t *file_io_pool,
-     int access_flags,
+     uint8_t digest_type,
+     uint8_t *digest,
+     size_t digest_size,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	libewf_segment_table_t *segment_table     = NULL;
-	static char *function                     = "libewf_handle_open_file_io_pool";
+	static char *function                     = "libewf_handle_get_read_digest";
 	int result                                = 0;
 
 	if( handle == NULL )
@@ -3859,32 +8154,6 @@ int libewf_handle_open_file_io_pool(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->file_io_pool != NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - file IO pool value already set.",
-		 function );
-
-		return( -1 );
-	}
-	if( libewf_segment_table_initialize(
-	     &segment_table,
-	     internal_handle->io_handle,
-	     LIBEWF_DEFAULT_SEGMENT_FILE_SIZE,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create segment table.",
-		 function );
-
-		goto on_error;
-	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
@@ -3900,64 +8169,56 @@ int libewf_handle_open_file_io_pool(
 		return( -1 );
 	}
 #endif
-	result = libewf_internal_handle_open_file_io_pool(
-	          internal_handle,
-	          file_io_pool,
-	          access_flags,
-	          segment_table,
-	          error );
-
-	if( result != 1 )
+	if( internal_handle->read_digest != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_OPEN_FAILED,
-		 "%s: unable to open handle using a file IO pool.",
-		 function );
+		result = libewf_read_digest_get_digest(
+		          internal_handle->read_digest,
+		          digest_type,
+		          digest,
+		          digest_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve digest.",
+			 function );
+		}
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	result = libcthreads_read_write_lock_release_for_write(
-	          internal_handle->read_write_lock,
-	          error );
-
-	if( result != 1 )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
-		 function );
-	}
-#endif
-	if( result != 1 )
-	{
-		goto on_error;
-	}
-	return( 1 );
-
-on_error:
-	if( segment_table != NULL )
-	{
-		libewf_segment_table_free(
-		 &segment_table,
-		 NULL );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
 	}
-	return( -1 );
+#endif
+	return( result );
 }
 
-/* Closes the EWF handle
- * Returns 0 if successful or -1 on error
+/* Sets the value to indicate if the handle should collect statistics
+ * The statistics contain the number of events and the elapsed time per stage of a read
+ * Disabling the collection of statistics discards the collected statistics
+ * Returns 1 if successful or -1 on error
  */
-int libewf_handle_close(
+int libewf_handle_set_collect_statistics(
      libewf_handle_t *handle,
+     uint8_t collect_statistics,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_close";
-	ssize_t write_count                       = 0;
-	int result                                = 0;
+	static char *function                     = "libewf_handle_set_collect_statistics";
+	int result                                = 1;
 
 	if( handle == NULL )
 	{
@@ -3987,305 +8248,382 @@ int libewf_handle_close(
 		return( -1 );
 	}
 #endif
-	if( ( internal_handle->write_io_handle != NULL )
-	 && ( internal_handle->write_io_handle->write_finalized == 0 ) )
+	if( ( collect_statistics != 0 )
+	 && ( internal_handle->statistics == NULL ) )
 	{
-		write_count = libewf_internal_handle_write_finalize_file_io_pool(
-		               internal_handle,
-		               internal_handle->file_io_pool,
-		               error );
-
-		if( write_count < 0 )
+		if( libewf_statistics_initialize(
+		     &( internal_handle->statistics ),
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to finalize write.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create statistics.",
 			 function );
 
 			result = -1;
 		}
 	}
-	if( internal_handle->file_io_pool_created_in_library != 0 )
+	else if( ( collect_statistics == 0 )
+	      && ( internal_handle->statistics != NULL ) )
 	{
-		if( libbfio_pool_close_all(
-		     internal_handle->file_io_pool,
-		     error ) != 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
-			 "%s: unable to close all file IO pool handles.",
-			 function );
-
-			result = -1;
-		}
-		if( libbfio_pool_free(
-		     &( internal_handle->file_io_pool ),
+		if( libewf_statistics_free(
+		     &( internal_handle->statistics ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free file IO pool.",
+			 "%s: unable to free statistics.",
 			 function );
 
 			result = -1;
 		}
-		internal_handle->file_io_pool_created_in_library = 0;
 	}
-	internal_handle->file_io_pool = NULL;
-
-	if( libewf_io_handle_clear(
-	     internal_handle->io_handle,
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to clear IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
-		result = -1;
+		return( -1 );
 	}
-	if( libewf_media_values_clear(
-	     internal_handle->media_values,
+#endif
+	return( result );
+}
+
+/* Retrieves the number of events and the cumulative elapsed time in nano seconds of a specific statistics type
+ * Returns 1 if successful, 0 if the handle does not collect statistics or -1 on error
+ */
+int libewf_handle_get_statistics_value(
+     libewf_handle_t *handle,
+     int statistics_type,
+     uint64_t *number_of_events,
+     uint64_t *elapsed_time,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_statistics_value";
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to clear media values.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
-		result = -1;
+		return( -1 );
 	}
-	if( internal_handle->read_io_handle != NULL )
+#endif
+	if( internal_handle->statistics != NULL )
 	{
-		if( libewf_read_io_handle_free(
-		     &( internal_handle->read_io_handle ),
-		     error ) != 1 )
+		result = libewf_statistics_get_value(
+		          internal_handle->statistics,
+		          statistics_type,
+		          number_of_events,
+		          elapsed_time,
+		          error );
+
+		if( result != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free read IO handle.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve statistics value.",
 			 function );
 
 			result = -1;
 		}
 	}
-	if( internal_handle->write_io_handle != NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
-		if( libewf_write_io_handle_free(
-		     &( internal_handle->write_io_handle ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free write IO handle.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
 
-			result = -1;
-		}
+		return( -1 );
 	}
-	/* Free the chunk data if it could not be passed to libfcache_cache_set_value_by_index
-	 */
-	if( internal_handle->chunk_data != NULL )
+#endif
+	return( result );
+}
+
+/* Resets the statistics collected by the handle
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_reset_statistics(
+     libewf_handle_t *handle,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_reset_statistics";
+	int result                                = 1;
+
+	if( handle == NULL )
 	{
-		if( libewf_chunk_data_free(
-		     &( internal_handle->chunk_data ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free chunk data.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
 
-			result = -1;
-		}
+		return( -1 );
 	}
-	if( internal_handle->segment_table != NULL )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
-		if( libewf_segment_table_free(
-		     &( internal_handle->segment_table ),
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->statistics != NULL )
+	{
+		if( libewf_statistics_clear(
+		     internal_handle->statistics,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free segment table.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to clear statistics.",
 			 function );
 
 			result = -1;
 		}
 	}
-	if( internal_handle->chunk_table != NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
-		if( libewf_chunk_table_free(
-		     &( internal_handle->chunk_table ),
-		     error ) != 1 )
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets the chunks cache in shared memory
+ * The unpacked chunks are shared with other processes that read the same image using the same name,
+ * where the shared memory is created with the maximum cache size if it does not exist
+ * The handle must be opened for reading only, a name of NULL stops using the shared memory chunks cache
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_shared_memory_chunks_cache(
+     libewf_handle_t *handle,
+     const char *name,
+     size_t name_length,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_shared_memory_chunks_cache";
+	size_t byte_index                         = 0;
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( name != NULL )
+	{
+		if( internal_handle->media_values == NULL )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free chunk table.",
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid handle - missing media values.",
 			 function );
 
-			result = -1;
+			return( -1 );
 		}
-	}
-	if( internal_handle->chunk_groups_cache != NULL )
-	{
-		if( libfcache_cache_free(
-		     &( internal_handle->chunk_groups_cache ),
-		     error ) != 1 )
+		if( ( internal_handle->read_io_handle == NULL )
+		 || ( internal_handle->write_io_handle != NULL ) )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free chunk groups cache.",
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: invalid handle - handle not opened for reading only.",
 			 function );
 
-			result = -1;
+			return( -1 );
+		}
+		/* The chunks are identified by the segment file set identifier
+		 */
+		for( byte_index = 0;
+		     byte_index < 16;
+		     byte_index++ )
+		{
+			if( internal_handle->media_values->set_identifier[ byte_index ] != 0 )
+			{
+				break;
+			}
 		}
-	}
-	if( internal_handle->chunks_cache != NULL )
-	{
-		if( libfcache_cache_free(
-		     &( internal_handle->chunks_cache ),
-		     error ) != 1 )
+		if( byte_index >= 16 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free chunks cache.",
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid handle - invalid media values - missing segment file set identifier.",
 			 function );
 
-			result = -1;
+			return( -1 );
 		}
 	}
-	if( internal_handle->hash_sections != NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
-		if( libewf_hash_sections_free(
-		     &( internal_handle->hash_sections ),
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->shared_memory_chunks_cache != NULL )
+	{
+		if( libewf_shared_memory_chunks_cache_free(
+		     &( internal_handle->shared_memory_chunks_cache ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free hash sections.",
+			 "%s: unable to free shared memory chunks cache.",
 			 function );
 
 			result = -1;
 		}
 	}
-	if( internal_handle->header_values != NULL )
+	if( ( result == 1 )
+	 && ( name != NULL ) )
 	{
-		if( libfvalue_table_free(
-		     &( internal_handle->header_values ),
+		if( libewf_shared_memory_chunks_cache_initialize(
+		     &( internal_handle->shared_memory_chunks_cache ),
+		     name,
+		     name_length,
+		     maximum_cache_size,
+		     internal_handle->media_values->chunk_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free header values.",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create shared memory chunks cache.",
 			 function );
 
 			result = -1;
 		}
-	}
-	if( internal_handle->hash_values != NULL )
-	{
-		if( libfvalue_table_free(
-		     &( internal_handle->hash_values ),
-		     error ) != 1 )
+		else if( memory_set(
+		          &( internal_handle->shared_memory_chunks_cache_key ),
+		          0,
+		          sizeof( libewf_shared_memory_chunks_cache_key_t ) ) == NULL )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free hash values.",
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear shared memory chunks cache key.",
 			 function );
 
 			result = -1;
 		}
-	}
-	if( internal_handle->single_files != NULL )
-	{
-		if( libewf_single_files_free(
-		     &( internal_handle->single_files ),
-		     error ) != 1 )
+		else if( memory_copy(
+		          internal_handle->shared_memory_chunks_cache_key.set_identifier,
+		          internal_handle->media_values->set_identifier,
+		          16 ) == NULL )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free single files.",
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy segment file set identifier.",
 			 function );
 
 			result = -1;
 		}
+		if( result != 1 )
+		{
+			libewf_shared_memory_chunks_cache_free(
+			 &( internal_handle->shared_memory_chunks_cache ),
+			 NULL );
+		}
+		else
+		{
+			internal_handle->shared_memory_chunks_cache_key.media_size = internal_handle->media_values->media_size;
+			internal_handle->shared_memory_chunks_cache_key.chunk_size = internal_handle->media_values->chunk_size;
+		}
 	}
-	if( libcdata_array_empty(
-	     internal_handle->sessions,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty sessions array.",
-		 function );
-
-		result = -1;
-	}
-	if( libcdata_array_empty(
-	     internal_handle->tracks,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty tracks array.",
-		 function );
-
-		result = -1;
-	}
-	if( libcdata_range_list_empty(
-	     internal_handle->acquiry_errors,
-	     NULL,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty acquiry errors range list.",
-		 function );
-
-		result = -1;
-	}
-/* TODO clear IO handle, segment tables */
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
@@ -4298,32 +8636,36 @@ int libewf_handle_close(
 		 "%s: unable to release read/write lock for writing.",
 		 function );
 
-		result = -1;
+		return( -1 );
 	}
 #endif
 	return( result );
 }
 
-/* Reads (media) data from the last current into a buffer using a Basic File IO (bfio) pool
- * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+/* Verifies the media data of a specific hash tree leaf
+ * The media data of the leaf is read and its digest compared with the stored leaf digest
+ * Returns 1 if the digests match, 0 if not or -1 on error
  */
-ssize_t libewf_internal_handle_read_buffer_from_file_io_pool(
-         libewf_internal_handle_t *internal_handle,
-         libbfio_pool_t *file_io_pool,
-         void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
+int libewf_handle_verify_hash_tree_leaf(
+     libewf_handle_t *handle,
+     uint64_t leaf_index,
+     libcerror_error_t **error )
 {
-	libewf_chunk_data_t *chunk_data = NULL;
-	static char *function           = "libewf_internal_handle_read_buffer_from_file_io_pool";
-	off64_t chunk_data_offset       = 0;
-	uint64_t chunk_index            = 0;
-	size_t buffer_offset            = 0;
-	size_t read_size                = 0;
-	ssize_t total_read_count        = 0;
+	uint8_t leaf_digest[ LIBEWF_HASH_TREE_DIGEST_SIZE ];
 
-	if( internal_handle == NULL )
+	libewf_internal_handle_t *internal_handle = NULL;
+	libhmac_sha256_context_t *sha256_context  = NULL;
+	uint8_t *buffer                           = NULL;
+	static char *function                     = "libewf_handle_verify_hash_tree_leaf";
+	size64_t leaf_range_size                  = 0;
+	size64_t remaining_size                   = 0;
+	off64_t leaf_range_offset                 = 0;
+	size_t buffer_size                        = 0;
+	size_t read_size                          = 0;
+	ssize_t read_count                        = 0;
+	int result                                = 0;
+
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -4334,258 +8676,247 @@ ssize_t libewf_internal_handle_read_buffer_from_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 "%s: invalid handle - missing file IO pool.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->chunk_data != NULL )
+	if( internal_handle->hash_sections == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk data set.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing hash sections.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values == NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+#endif
+	if( ( internal_handle->hash_sections->hash_tree == NULL )
+	 || ( internal_handle->hash_sections->hash_tree->is_finalized == 0 ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 "%s: invalid handle - missing hash tree.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( buffer == NULL )
+	if( libewf_hash_tree_get_leaf_range(
+	     internal_handle->hash_sections->hash_tree,
+	     leaf_index,
+	     &leaf_range_offset,
+	     &leaf_range_size,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve range of leaf: %" PRIu64 ".",
+		 function,
+		 leaf_index );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( buffer_size > (size_t) SSIZE_MAX )
+	if( ( (size64_t) leaf_range_offset + leaf_range_size ) > internal_handle->media_values->media_size )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid buffer size value exceeds maximum.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid leaf: %" PRIu64 " range exceeds media size.",
+		 function,
+		 leaf_index );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
+	buffer_size = LIBEWF_HASH_TREE_MAXIMUM_READ_SIZE;
+
+	if( (size64_t) buffer_size > leaf_range_size )
 	{
-		return( 0 );
+		buffer_size = (size_t) leaf_range_size;
 	}
-	if( (size64_t) ( internal_handle->current_offset + buffer_size ) >= internal_handle->media_values->media_size )
+	if( buffer_size > 0 )
 	{
-		buffer_size = (size_t) ( internal_handle->media_values->media_size - internal_handle->current_offset );
-	}
-	chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+		buffer = (uint8_t *) memory_allocate(
+		                      sizeof( uint8_t ) * buffer_size );
 
-	while( buffer_size > 0 )
-	{
-		if( libewf_chunk_table_get_chunk_data_by_offset(
-		     internal_handle->chunk_table,
-		     chunk_index,
-		     internal_handle->io_handle,
-		     file_io_pool,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
-		     internal_handle->chunk_groups_cache,
-		     internal_handle->chunks_cache,
-		     internal_handle->current_offset,
-		     &chunk_data,
-		     &chunk_data_offset,
-		     error ) != 1 )
+		if( buffer == NULL )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to read chunk: %" PRIu64 " data.",
-			 function,
-			 chunk_index );
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create buffer.",
+			 function );
 
-			return( -1 );
+			goto on_error;
 		}
-		if( chunk_data == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing chunk: %" PRIu64 " data.",
-			 function,
-			 chunk_index );
+	}
+	if( libhmac_sha256_initialize(
+	     &sha256_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize SHA256 context.",
+		 function );
 
-			return( -1 );
-		}
-		if( (off64_t) chunk_data_offset > (off64_t) chunk_data->data_size )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: chunk: %" PRIu64 " offset exceeds data size.",
-			 function,
-			 chunk_index );
+		goto on_error;
+	}
+	if( libewf_internal_handle_seek_offset(
+	     internal_handle,
+	     leaf_range_offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 ".",
+		 function,
+		 leaf_range_offset );
 
-			return( -1 );
-		}
-		read_size = (size_t) ( chunk_data->data_size - chunk_data_offset );
+		goto on_error;
+	}
+	remaining_size = leaf_range_size;
+
+	while( remaining_size > 0 )
+	{
+		read_size = buffer_size;
 
-		if( read_size > buffer_size )
+		if( (size64_t) read_size > remaining_size )
 		{
-			read_size = buffer_size;
+			read_size = (size_t) remaining_size;
 		}
-		if( read_size == 0 )
-		{
-			break;
-		}
-		if( memory_copy(
-		     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
-		     &( ( chunk_data->data )[ chunk_data_offset ] ),
-		     read_size ) == NULL )
+		read_count = libewf_internal_handle_read_buffer_from_file_io_pool(
+		              internal_handle,
+		              internal_handle->file_io_pool,
+		              buffer,
+		              read_size,
+		              error );
+
+		if( read_count != (ssize_t) read_size )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy chunk: %" PRIu64 " data to buffer.",
-			 function,
-			 chunk_index );
-
-			return( -1 );
-		}
-		buffer_offset    += read_size;
-		buffer_size      -= read_size;
-		total_read_count += (ssize_t) read_size;
-		chunk_index      += 1;
-
-		internal_handle->current_offset += (off64_t) read_size;
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer.",
+			 function );
 
-		if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
-		{
-			break;
+			goto on_error;
 		}
-		if( internal_handle->io_handle->abort != 0 )
+		if( libhmac_sha256_update(
+		     sha256_context,
+		     buffer,
+		     read_size,
+		     error ) != 1 )
 		{
-			break;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA256 hash.",
+			 function );
+
+			goto on_error;
 		}
-		chunk_data        = NULL;
-		chunk_data_offset = 0;
+		remaining_size -= read_size;
 	}
-	return( total_read_count );
-}
-
-/* Reads (media) data at the current offset into a buffer
- * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
- */
-ssize_t libewf_handle_read_buffer(
-         libewf_handle_t *handle,
-         void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
-{
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_read_buffer";
-	ssize_t read_count                        = 0;
-
-	if( handle == NULL )
+	if( libhmac_sha256_finalize(
+	     sha256_context,
+	     leaf_digest,
+	     LIBEWF_HASH_TREE_DIGEST_SIZE,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize SHA256 hash.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
+	result = libewf_hash_tree_compare_leaf_digest(
+	          internal_handle->hash_sections->hash_tree,
+	          leaf_index,
+	          leaf_digest,
+	          LIBEWF_HASH_TREE_DIGEST_SIZE,
+	          error );
 
-	if( internal_handle->file_io_pool == NULL )
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to compare digest of leaf: %" PRIu64 ".",
+		 function,
+		 leaf_index );
 
-		return( -1 );
+		goto on_error;
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
+	if( libhmac_sha256_free(
+	     &sha256_context,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free SHA256 context.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	read_count = libewf_internal_handle_read_buffer_from_file_io_pool(
-		      internal_handle,
-		      internal_handle->file_io_pool,
-		      buffer,
-		      buffer_size,
-		      error );
-
-	if( read_count == -1 )
+	if( buffer != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
-		 function );
+		memory_free(
+		 buffer );
 
-		read_count = -1;
+		buffer = NULL;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -4602,22 +8933,50 @@ ssize_t libewf_handle_read_buffer(
 		return( -1 );
 	}
 #endif
-	return( read_count );
+	return( result );
+
+on_error:
+	if( sha256_context != NULL )
+	{
+		libhmac_sha256_free(
+		 &sha256_context,
+		 NULL );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
 }
 
-/* Reads (media) data at a specific offset
- * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+/* Checks the chunks stored in a specific segment file
+ * Every chunk is read and unpacked, which validates its checksum, in
+ * media data order within the segment file. The chunks are not copied.
+ * Corrupted chunks are added to the checksum errors
+ * Returns 1 if all chunks are valid, 0 if not or -1 on error
  */
-ssize_t libewf_handle_read_buffer_at_offset(
-         libewf_handle_t *handle,
-         void *buffer,
-         size_t buffer_size,
-         off64_t offset,
-         libcerror_error_t **error )
+int libewf_handle_check_segment_file_chunks(
+     libewf_handle_t *handle,
+     uint32_t segment_file_index,
+     libcerror_error_t **error )
 {
+	libewf_chunk_data_t *chunk_data           = NULL;
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_read_buffer_at_offset";
-	ssize_t read_count                        = 0;
+	static char *function                     = "libewf_handle_check_segment_file_chunks";
+	size64_t range_size                       = 0;
+	off64_t chunk_data_offset                 = 0;
+	off64_t chunk_offset                      = 0;
+	off64_t range_end_offset                  = 0;
+	off64_t range_offset                      = 0;
+	uint64_t chunk_index                      = 0;
+	int is_grabbed                            = 0;
+	int result                                = 1;
 
 	if( handle == NULL )
 	{
@@ -4632,6 +8991,17 @@ ssize_t libewf_handle_read_buffer_at_offset(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
 	if( internal_handle->file_io_pool == NULL )
 	{
 		libcerror_error_set(
@@ -4643,6 +9013,28 @@ ssize_t libewf_handle_read_buffer_at_offset(
 
 		return( -1 );
 	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
@@ -4658,38 +9050,108 @@ ssize_t libewf_handle_read_buffer_at_offset(
 		return( -1 );
 	}
 #endif
-	if( libewf_internal_handle_seek_offset(
+	if( libewf_internal_handle_get_segment_file_media_range(
 	     internal_handle,
-	     offset,
-	     SEEK_SET,
-	     error ) == -1 )
+	     segment_file_index,
+	     &range_offset,
+	     &range_size,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media range of segment file: %" PRIu32 ".",
+		 function,
+		 segment_file_index );
 
 		goto on_error;
 	}
-	read_count = libewf_internal_handle_read_buffer_from_file_io_pool(
-	              internal_handle,
-	              internal_handle->file_io_pool,
-	              buffer,
-	              buffer_size,
-	              error );
+	range_end_offset = range_offset + (off64_t) range_size;
 
-	if( read_count == -1 )
+	chunk_index  = (uint64_t) range_offset / internal_handle->media_values->chunk_size;
+	chunk_offset = (off64_t) chunk_index * internal_handle->media_values->chunk_size;
+
+	while( chunk_offset < range_end_offset )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
-		 function );
+		if( internal_handle->io_handle->abort != 0 )
+		{
+			break;
+		}
+		if( libewf_internal_handle_grab_shared_metadata(
+		     internal_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab shared metadata.",
+			 function );
 
-		goto on_error;
+			goto on_error;
+		}
+		is_grabbed = 1;
+
+		/* Retrieving the chunk data unpacks the chunk and adds a checksum error if it is corrupted
+		 */
+		if( libewf_chunk_table_get_chunk_data_by_offset(
+		     internal_handle->chunk_table,
+		     chunk_index,
+		     internal_handle->io_handle,
+		     internal_handle->file_io_pool,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
+		     internal_handle->chunk_groups_cache,
+		     internal_handle->chunks_cache,
+		     chunk_offset,
+		     &chunk_data,
+		     &chunk_data_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		if( chunk_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+		{
+			result = 0;
+		}
+		is_grabbed = 0;
+
+		if( libewf_internal_handle_release_shared_metadata(
+		     internal_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release shared metadata.",
+			 function );
+
+			goto on_error;
+		}
+		chunk_index  += 1;
+		chunk_offset += internal_handle->media_values->chunk_size;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -4706,9 +9168,15 @@ ssize_t libewf_handle_read_buffer_at_offset(
 		return( -1 );
 	}
 #endif
-	return( read_count );
+	return( result );
 
 on_error:
+	if( is_grabbed != 0 )
+	{
+		libewf_internal_handle_release_shared_metadata(
+		 internal_handle,
+		 NULL );
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	libcthreads_read_write_lock_release_for_write(
 	 internal_handle->read_write_lock,
@@ -4999,9 +9467,11 @@ ssize_t libewf_internal_handle_write_buffer_to_file_io_pool(
 			if( libewf_chunk_data_pack(
 			     internal_handle->chunk_data,
 			     internal_handle->io_handle,
+			     internal_handle->io_handle->compression_level,
 			     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
 			     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
 			     internal_handle->write_io_handle->pack_flags,
+			     internal_handle->write_io_handle->deflate_encoder,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
@@ -5560,6 +10030,19 @@ ssize_t libewf_internal_handle_read_data_chunk_from_file_io_pool(
 	internal_handle->current_offset = (off64_t) internal_handle->current_chunk_index
 	                                * (off64_t) internal_handle->media_values->chunk_size;
 
+	if( libewf_internal_handle_grab_shared_metadata(
+	     internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab shared metadata.",
+		 function );
+
+		return( -1 );
+	}
 	if( libewf_chunk_table_get_chunk_data_by_offset(
 	     internal_handle->chunk_table,
 	     internal_handle->current_chunk_index,
@@ -5582,7 +10065,7 @@ ssize_t libewf_internal_handle_read_data_chunk_from_file_io_pool(
 		 function,
 		 internal_handle->current_chunk_index );
 
-		return( -1 );
+		goto on_error;
 	}
 	if( chunk_data == NULL )
 	{
@@ -5594,7 +10077,7 @@ ssize_t libewf_internal_handle_read_data_chunk_from_file_io_pool(
 		 function,
 		 internal_handle->current_chunk_index );
 
-		return( -1 );
+		goto on_error;
 	}
 	read_count = (ssize_t) chunk_data->data_size;
 
@@ -5612,6 +10095,19 @@ ssize_t libewf_internal_handle_read_data_chunk_from_file_io_pool(
 		 function,
 		 internal_handle->current_chunk_index );
 
+		goto on_error;
+	}
+	if( libewf_internal_handle_release_shared_metadata(
+	     internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release shared metadata.",
+		 function );
+
 		return( -1 );
 	}
 	internal_handle->current_offset += read_count;
@@ -5619,6 +10115,13 @@ ssize_t libewf_internal_handle_read_data_chunk_from_file_io_pool(
 	internal_handle->current_chunk_index++;
 
 	return( read_count );
+
+on_error:
+	libewf_internal_handle_release_shared_metadata(
+	 internal_handle,
+	 NULL );
+
+	return( -1 );
 }
 
 /* Reads a (media) data chunk at the current offset
@@ -6111,6 +10614,26 @@ ssize_t libewf_internal_handle_write_finalize_file_io_pool(
 	{
 		return( 0 );
 	}
+	/* The hash tree is finalized before the hash sections are written
+	 */
+	if( ( internal_handle->hash_sections != NULL )
+	 && ( internal_handle->hash_sections->hash_tree != NULL )
+	 && ( internal_handle->hash_sections->hash_tree->is_finalized == 0 ) )
+	{
+		if( libewf_hash_tree_finalize(
+		     internal_handle->hash_sections->hash_tree,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize hash tree.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	if( internal_handle->chunk_data != NULL )
 	{
 		chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
@@ -6153,9 +10676,11 @@ ssize_t libewf_internal_handle_write_finalize_file_io_pool(
 		if( libewf_chunk_data_pack(
 		     internal_handle->chunk_data,
 		     internal_handle->io_handle,
+		     internal_handle->io_handle->compression_level,
 		     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
 		     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
 		     internal_handle->write_io_handle->pack_flags,
+		     internal_handle->write_io_handle->deflate_encoder,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -6913,7 +11438,230 @@ int libewf_handle_set_maximum_number_of_open_handles(
 		internal_handle->maximum_number_of_open_handles = maximum_number_of_open_handles;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Determine if the segment files are corrupted
+ * Returns 1 if corrupted, 0 if not or -1 on error
+ */
+int libewf_handle_segment_files_corrupted(
+     libewf_handle_t *handle,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_segment_files_corrupted";
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing segment table.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = ( internal_handle->segment_table->flags & LIBEWF_SEGMENT_TABLE_FLAG_IS_CORRUPTED ) != 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Determine if the segment files are encrypted
+ * Returns 1 if encrypted, 0 if not or -1 on error
+ */
+int libewf_handle_segment_files_encrypted(
+     libewf_handle_t *handle,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_segment_files_encrypted";
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = (int) internal_handle->io_handle->is_encrypted;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the number of segment files
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_number_of_segment_files(
+     libewf_handle_t *handle,
+     uint32_t *number_of_segment_files,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_number_of_segment_files";
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing segment table.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libewf_segment_table_get_number_of_segments(
+	     internal_handle->segment_table,
+	     number_of_segment_files,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -6921,7 +11669,7 @@ int libewf_handle_set_maximum_number_of_open_handles(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
@@ -6930,18 +11678,26 @@ int libewf_handle_set_maximum_number_of_open_handles(
 	return( result );
 }
 
-/* Determine if the segment files are corrupted
- * Returns 1 if corrupted, 0 if not or -1 on error
+/* Retrieves the range of the media data that is stored in a specific segment file
+ * The range of a segment file without chunks has a size of 0
+ * This function is not multi-thread safe acquire read lock before call
+ * Returns 1 if successful or -1 on error
  */
-int libewf_handle_segment_files_corrupted(
-     libewf_handle_t *handle,
+int libewf_internal_handle_get_segment_file_media_range(
+     libewf_internal_handle_t *internal_handle,
+     uint32_t segment_file_index,
+     off64_t *range_offset,
+     size64_t *range_size,
      libcerror_error_t **error )
 {
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_segment_files_corrupted";
-	int result                                = 0;
+	static char *function       = "libewf_internal_handle_get_segment_file_media_range";
+	size64_t segment_media_size = 0;
+	size64_t segment_offset     = 0;
+	uint32_t number_of_segments = 0;
+	uint32_t segment_index      = 0;
+	int result                  = 0;
 
-	if( handle == NULL )
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -6952,64 +11708,126 @@ int libewf_handle_segment_files_corrupted(
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->segment_table == NULL )
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing segment table.",
+		 "%s: invalid handle - missing media values.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( range_offset == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range offset.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	result = ( internal_handle->segment_table->flags & LIBEWF_SEGMENT_TABLE_FLAG_IS_CORRUPTED ) != 0;
+	if( range_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range size.",
+		 function );
 
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_handle->read_write_lock,
+		return( -1 );
+	}
+	if( libewf_segment_table_get_number_of_segments(
+	     internal_handle->segment_table,
+	     &number_of_segments,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	return( result );
+	if( segment_file_index >= number_of_segments )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment file index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* The segment files store the media data consecutively
+	 */
+	for( segment_index = 0;
+	     segment_index <= segment_file_index;
+	     segment_index++ )
+	{
+		result = libewf_segment_table_get_segment_storage_media_size_by_index(
+		          internal_handle->segment_table,
+		          segment_index,
+		          &segment_media_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve storage media size of segment: %" PRIu32 ".",
+			 function,
+			 segment_index );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			segment_media_size = 0;
+		}
+		if( segment_index < segment_file_index )
+		{
+			segment_offset += segment_media_size;
+		}
+	}
+	if( segment_offset > internal_handle->media_values->media_size )
+	{
+		segment_offset = internal_handle->media_values->media_size;
+	}
+	/* The last chunk of the last segment file can be smaller than the chunk size
+	 */
+	if( segment_media_size > ( internal_handle->media_values->media_size - segment_offset ) )
+	{
+		segment_media_size = internal_handle->media_values->media_size - segment_offset;
+	}
+	*range_offset = (off64_t) segment_offset;
+	*range_size   = segment_media_size;
+
+	return( 1 );
 }
 
-/* Determine if the segment files are encrypted
- * Returns 1 if encrypted, 0 if not or -1 on error
+/* Retrieves the range of the media data that is stored in a specific segment file
+ * Returns 1 if successful or -1 on error
  */
-int libewf_handle_segment_files_encrypted(
+int libewf_handle_get_segment_file_media_range(
      libewf_handle_t *handle,
+     uint32_t segment_file_index,
+     off64_t *range_offset,
+     size64_t *range_size,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_segment_files_encrypted";
-	int result                                = 0;
+	static char *function                     = "libewf_handle_get_segment_file_media_range";
+	int result                                = 1;
 
 	if( handle == NULL )
 	{
@@ -7024,17 +11842,6 @@ int libewf_handle_segment_files_encrypted(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->io_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
-		 function );
-
-		return( -1 );
-	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
@@ -7050,8 +11857,23 @@ int libewf_handle_segment_files_encrypted(
 		return( -1 );
 	}
 #endif
-	result = (int) internal_handle->io_handle->is_encrypted;
+	if( libewf_internal_handle_get_segment_file_media_range(
+	     internal_handle,
+	     segment_file_index,
+	     range_offset,
+	     range_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media range of segment file: %" PRIu32 ".",
+		 function,
+		 segment_file_index );
 
+		result = -1;
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
@@ -8409,6 +13231,7 @@ int libewf_internal_handle_get_media_values(
 			if( libewf_chunk_data_unpack(
 			     chunk_data,
 			     internal_handle->io_handle,
+			     NULL,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
@@ -8848,42 +13671,15 @@ int libewf_internal_handle_get_file_entry_by_utf8_path(
 	{
 		result = 1;
 	}
-	else while( utf8_string_index < utf8_string_length )
+	else
 	{
-		utf8_string_segment        = (uint8_t *) &( utf8_string[ utf8_string_index ] );
-		utf8_string_segment_length = 0;
-
-		while( utf8_string_index < utf8_string_length )
-		{
-			if( ( utf8_string[ utf8_string_index ] == (uint8_t) LIBEWF_SEPARATOR )
-			 || ( utf8_string[ utf8_string_index ] == (uint8_t) 0 ) )
-			{
-				utf8_string_index++;
-
-				break;
-			}
-			utf8_string_index++;
-
-			utf8_string_segment_length++;
-		}
-		if( utf8_string_segment_length == 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing sub file entry name.",
-			 function );
-
-			return( -1 );
-		}
-		result = libewf_single_file_tree_get_sub_node_by_utf8_name(
-			  node,
-			  utf8_string_segment,
-			  utf8_string_segment_length,
-			  &sub_node,
-			  &sub_single_file_entry,
-			  error );
+		result = libewf_single_files_get_cached_node_by_path(
+		          internal_handle->single_files,
+		          utf8_string,
+		          utf8_string_length,
+		          1,
+		          &sub_node,
+		          error );
 
 		if( result == -1 )
 		{
@@ -8891,16 +13687,93 @@ int libewf_internal_handle_get_file_entry_by_utf8_path(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve single file entry sub node by name.",
+			 "%s: unable to retrieve cached single file entry node by path.",
 			 function );
 
 			return( -1 );
 		}
-		else if( result == 0 )
+		else if( result != 0 )
 		{
-			break;
+			node = sub_node;
+		}
+		else
+		{
+			while( utf8_string_index < utf8_string_length )
+			{
+				utf8_string_segment        = (uint8_t *) &( utf8_string[ utf8_string_index ] );
+				utf8_string_segment_length = 0;
+
+				while( utf8_string_index < utf8_string_length )
+				{
+					if( ( utf8_string[ utf8_string_index ] == (uint8_t) LIBEWF_SEPARATOR )
+					 || ( utf8_string[ utf8_string_index ] == (uint8_t) 0 ) )
+					{
+						utf8_string_index++;
+
+						break;
+					}
+					utf8_string_index++;
+
+					utf8_string_segment_length++;
+				}
+				if( utf8_string_segment_length == 0 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+					 "%s: missing sub file entry name.",
+					 function );
+
+					return( -1 );
+				}
+				result = libewf_single_files_get_sub_node_by_utf8_name(
+					  internal_handle->single_files,
+					  node,
+					  utf8_string_segment,
+					  utf8_string_segment_length,
+					  &sub_node,
+					  &sub_single_file_entry,
+					  error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve single file entry sub node by name.",
+					 function );
+
+					return( -1 );
+				}
+				else if( result == 0 )
+				{
+					break;
+				}
+				node = sub_node;
+			}
+			if( result != 0 )
+			{
+				if( libewf_single_files_set_cached_node_by_path(
+				     internal_handle->single_files,
+				     utf8_string,
+				     utf8_string_length,
+				     1,
+				     node,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set cached single file entry node by path.",
+					 function );
+
+					return( -1 );
+				}
+			}
 		}
-		node = sub_node;
 	}
 	if( result != 0 )
 	{
@@ -9133,42 +14006,15 @@ int libewf_internal_handle_get_file_entry_by_utf16_path(
 	{
 		result = 1;
 	}
-	else while( utf16_string_index < utf16_string_length )
+	else
 	{
-		utf16_string_segment        = (uint16_t *) &( utf16_string[ utf16_string_index ] );
-		utf16_string_segment_length = 0;
-
-		while( utf16_string_index < utf16_string_length )
-		{
-			if( ( utf16_string[ utf16_string_index ] == (uint16_t) LIBEWF_SEPARATOR )
-			 || ( utf16_string[ utf16_string_index ] == (uint16_t) 0 ) )
-			{
-				utf16_string_index++;
-
-				break;
-			}
-			utf16_string_index++;
-
-			utf16_string_segment_length++;
-		}
-		if( utf16_string_segment_length == 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing sub file entry name.",
-			 function );
-
-			return( -1 );
-		}
-		result = libewf_single_file_tree_get_sub_node_by_utf16_name(
-			  node,
-			  utf16_string_segment,
-			  utf16_string_segment_length,
-			  &sub_node,
-			  &sub_single_file_entry,
-			  error );
+		result = libewf_single_files_get_cached_node_by_path(
+		          internal_handle->single_files,
+		          (const uint8_t *) utf16_string,
+		          sizeof( uint16_t ) * utf16_string_length,
+		          2,
+		          &sub_node,
+		          error );
 
 		if( result == -1 )
 		{
@@ -9176,16 +14022,93 @@ int libewf_internal_handle_get_file_entry_by_utf16_path(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve single file entry sub node by name.",
+			 "%s: unable to retrieve cached single file entry node by path.",
 			 function );
 
 			return( -1 );
 		}
-		else if( result == 0 )
+		else if( result != 0 )
 		{
-			break;
+			node = sub_node;
+		}
+		else
+		{
+			while( utf16_string_index < utf16_string_length )
+			{
+				utf16_string_segment        = (uint16_t *) &( utf16_string[ utf16_string_index ] );
+				utf16_string_segment_length = 0;
+
+				while( utf16_string_index < utf16_string_length )
+				{
+					if( ( utf16_string[ utf16_string_index ] == (uint16_t) LIBEWF_SEPARATOR )
+					 || ( utf16_string[ utf16_string_index ] == (uint16_t) 0 ) )
+					{
+						utf16_string_index++;
+
+						break;
+					}
+					utf16_string_index++;
+
+					utf16_string_segment_length++;
+				}
+				if( utf16_string_segment_length == 0 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+					 "%s: missing sub file entry name.",
+					 function );
+
+					return( -1 );
+				}
+				result = libewf_single_files_get_sub_node_by_utf16_name(
+					  internal_handle->single_files,
+					  node,
+					  utf16_string_segment,
+					  utf16_string_segment_length,
+					  &sub_node,
+					  &sub_single_file_entry,
+					  error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve single file entry sub node by name.",
+					 function );
+
+					return( -1 );
+				}
+				else if( result == 0 )
+				{
+					break;
+				}
+				node = sub_node;
+			}
+			if( result != 0 )
+			{
+				if( libewf_single_files_set_cached_node_by_path(
+				     internal_handle->single_files,
+				     (const uint8_t *) utf16_string,
+				     sizeof( uint16_t ) * utf16_string_length,
+				     2,
+				     node,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set cached single file entry node by path.",
+					 function );
+
+					return( -1 );
+				}
+			}
 		}
-		node = sub_node;
 	}
 	if( result != 0 )
 	{
@@ -38,11 +38,17 @@
 #include "libewf_libfcache.h"
 #include "libewf_libfdata.h"
 #include "libewf_libfvalue.h"
+#include "libewf_read_batch.h"
 #include "libewf_io_handle.h"
 #include "libewf_media_values.h"
+#include "libewf_read_digest.h"
 #include "libewf_read_io_handle.h"
+#include "libewf_read_scheduler.h"
 #include "libewf_segment_table.h"
+#include "libewf_shared_memory_chunks_cache.h"
+#include "libewf_shared_metadata.h"
 #include "libewf_single_files.h"
+#include "libewf_statistics.h"
 #include "libewf_types.h"
 #include "libewf_write_io_handle.h"
 
@@ -150,10 +156,38 @@ struct libewf_internal_handle
 	 */
 	libewf_single_files_t *single_files;
 
+	/* The read digest
+	 */
+	libewf_read_digest_t *read_digest;
+
+	/* The statistics, NULL if the handle does not collect statistics
+	 */
+	libewf_statistics_t *statistics;
+
+	/* The metadata shared with clones
+	 */
+	libewf_shared_metadata_t *shared_metadata;
+
+	/* Value to indicate the chunks cache is part of the shared metadata
+	 */
+	uint8_t has_shared_chunks_cache;
+
+	/* The chunks cache in shared memory, NULL if the handle does not use it
+	 */
+	libewf_shared_memory_chunks_cache_t *shared_memory_chunks_cache;
+
+	/* The key of the chunks in the shared memory chunks cache, which contains the values shared by all chunks
+	 */
+	libewf_shared_memory_chunks_cache_key_t shared_memory_chunks_cache_key;
+
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	/* The read/write lock
 	 */
 	libcthreads_read_write_lock_t *read_write_lock;
+
+	/* The read scheduler of the asynchronous reads, created on first use
+	 */
+	libewf_read_scheduler_t *read_scheduler;
 #endif
 };
 
@@ -173,6 +207,25 @@ int libewf_handle_clone(
      libewf_handle_t *source_handle,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_clone_shared(
+     libewf_handle_t **destination_handle,
+     libewf_handle_t *source_handle,
+     uint8_t share_flags,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_share_metadata(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_grab_shared_metadata(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_release_shared_metadata(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_signal_abort(
      libewf_handle_t *handle,
@@ -230,6 +283,32 @@ int libewf_handle_close(
      libewf_handle_t *handle,
      libcerror_error_t **error );
 
+int libewf_internal_handle_get_shared_memory_chunks_cache_key(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     uint64_t chunk_index,
+     libewf_shared_memory_chunks_cache_key_t *key,
+     libcerror_error_t **error );
+
+ssize_t libewf_internal_handle_read_chunk_data_from_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         uint64_t chunk_index,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         const libewf_shared_memory_chunks_cache_key_t *shared_memory_chunks_cache_key,
+         libcerror_error_t **error );
+
+ssize_t libewf_internal_handle_read_chunk_buffer_from_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         uint64_t chunk_index,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
 ssize_t libewf_internal_handle_read_buffer_from_file_io_pool(
          libewf_internal_handle_t *internal_handle,
          libbfio_pool_t *file_io_pool,
@@ -252,6 +331,121 @@ ssize_t libewf_handle_read_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error );
 
+int libewf_internal_handle_read_packed_chunk_data_from_file_io_pool(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     uint64_t chunk_index,
+     off64_t offset,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_read_batch_from_file_io_pool(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_read_batch_t *read_batch,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_read_buffers_at_offsets(
+     libewf_handle_t *handle,
+     void * const *buffers,
+     const size_t *buffer_sizes,
+     const off64_t *offsets,
+     ssize_t *read_counts,
+     int number_of_requests,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+ssize_t libewf_internal_handle_read_scheduled_chunk(
+         libewf_internal_handle_t *internal_handle,
+         uint64_t chunk_index,
+         uint8_t *chunk_buffer,
+         size_t chunk_buffer_size,
+         libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+LIBEWF_EXTERN \
+int libewf_handle_read_buffer_at_offset_async(
+     libewf_handle_t *handle,
+     void *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     void (*callback)(
+            libewf_handle_t *handle,
+            void *buffer,
+            ssize_t read_count,
+            void *callback_data ),
+     void *callback_data,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_wait_for_async_reads(
+     libewf_handle_t *handle,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_start_read_digest(
+     libewf_handle_t *handle,
+     uint8_t digest_types,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_read_digest_range(
+     libewf_handle_t *handle,
+     off64_t range_offset,
+     size64_t range_size,
+     uint8_t digest_types,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_read_digest(
+     libewf_handle_t *handle,
+     uint8_t digest_type,
+     uint8_t *digest,
+     size_t digest_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_collect_statistics(
+     libewf_handle_t *handle,
+     uint8_t collect_statistics,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_statistics_value(
+     libewf_handle_t *handle,
+     int statistics_type,
+     uint64_t *number_of_events,
+     uint64_t *elapsed_time,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_reset_statistics(
+     libewf_handle_t *handle,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_shared_memory_chunks_cache(
+     libewf_handle_t *handle,
+     const char *name,
+     size_t name_length,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_verify_hash_tree_leaf(
+     libewf_handle_t *handle,
+     uint64_t leaf_index,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_check_segment_file_chunks(
+     libewf_handle_t *handle,
+     uint32_t segment_file_index,
+     libcerror_error_t **error );
+
 ssize_t libewf_internal_handle_write_buffer_to_file_io_pool(
          libewf_internal_handle_t *internal_handle,
          libbfio_pool_t *file_io_pool,
@@ -349,6 +543,27 @@ int libewf_handle_segment_files_encrypted(
      libewf_handle_t *handle,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_get_number_of_segment_files(
+     libewf_handle_t *handle,
+     uint32_t *number_of_segment_files,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_get_segment_file_media_range(
+     libewf_internal_handle_t *internal_handle,
+     uint32_t segment_file_index,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_segment_file_media_range(
+     libewf_handle_t *handle,
+     uint32_t segment_file_index,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_get_segment_filename_size(
      libewf_handle_t *handle,
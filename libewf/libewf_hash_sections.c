@@ -25,6 +25,7 @@
 
 #include "libewf_libcerror.h"
 #include "libewf_hash_sections.h"
+#include "libewf_hash_tree.h"
 #include "libewf_hash_values.h"
 
 /* Creates hash sections
@@ -108,6 +109,7 @@ int libewf_hash_sections_free(
      libcerror_error_t **error )
 {
         static char *function = "libewf_hash_sections_free";
+	int result            = 1;
 
 	if( hash_sections == NULL )
 	{
@@ -127,12 +129,28 @@ int libewf_hash_sections_free(
 			memory_free(
 			 ( *hash_sections )->xhash );
 		}
+		if( ( *hash_sections )->hash_tree != NULL )
+		{
+			if( libewf_hash_tree_free(
+			     &( ( *hash_sections )->hash_tree ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free hash tree.",
+				 function );
+
+				result = -1;
+			}
+		}
 		memory_free(
 		 *hash_sections );
 
 		*hash_sections = NULL;
 	}
-	return( 1 );
+	return( result );
 }
 
 /* Clones the hash sections
@@ -203,6 +221,7 @@ int libewf_hash_sections_clone(
 	}
 	( *destination_hash_sections )->xhash      = NULL;
 	( *destination_hash_sections )->xhash_size = 0;
+	( *destination_hash_sections )->hash_tree  = NULL;
 
 	if( source_hash_sections->xhash != NULL )
 	{
@@ -236,6 +255,20 @@ int libewf_hash_sections_clone(
 		}
 		( *destination_hash_sections )->xhash_size = source_hash_sections->xhash_size;
 	}
+	if( libewf_hash_tree_clone(
+	     &( ( *destination_hash_sections )->hash_tree ),
+	     source_hash_sections->hash_tree,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination hash tree.",
+		 function );
+
+		goto on_error;
+	}
 	return( 1 );
 
 on_error:
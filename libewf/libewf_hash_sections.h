@@ -25,6 +25,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_hash_tree.h"
 #include "libewf_libcerror.h"
 #include "libewf_libfvalue.h"
 
@@ -87,6 +88,10 @@ struct libewf_hash_sections
 	/* Value to indicate if the SHA1 digest was set
 	 */
 	uint8_t sha1_digest_set;
+
+	/* The hash tree as found in the hash tree section
+	 */
+	libewf_hash_tree_t *hash_tree;
 };
 
 int libewf_hash_sections_initialize(
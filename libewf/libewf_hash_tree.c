@@ -0,0 +1,1572 @@
+/*
+ * Hash tree functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_checksum.h"
+#include "libewf_hash_tree.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libhmac.h"
+
+#include "ewf_hash_tree.h"
+
+/* Creates a hash tree
+ * Make sure the value hash_tree is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_hash_tree_initialize(
+     libewf_hash_tree_t **hash_tree,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_hash_tree_initialize";
+
+	if( hash_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( *hash_tree != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid hash tree value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*hash_tree = memory_allocate_structure(
+	              libewf_hash_tree_t );
+
+	if( *hash_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create hash tree.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *hash_tree,
+	     0,
+	     sizeof( libewf_hash_tree_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear hash tree.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *hash_tree != NULL )
+	{
+		memory_free(
+		 *hash_tree );
+
+		*hash_tree = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a hash tree
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_hash_tree_free(
+     libewf_hash_tree_t **hash_tree,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_hash_tree_free";
+	int result            = 1;
+
+	if( hash_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( *hash_tree != NULL )
+	{
+		if( ( *hash_tree )->leaf_context != NULL )
+		{
+			if( libhmac_sha256_free(
+			     &( ( *hash_tree )->leaf_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free leaf SHA256 context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *hash_tree )->leaf_digests != NULL )
+		{
+			memory_free(
+			 ( *hash_tree )->leaf_digests );
+		}
+		memory_free(
+		 *hash_tree );
+
+		*hash_tree = NULL;
+	}
+	return( result );
+}
+
+/* Clones the hash tree
+ * The state of a leaf that is being calculated is not cloned
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_hash_tree_clone(
+     libewf_hash_tree_t **destination_hash_tree,
+     libewf_hash_tree_t *source_hash_tree,
+     libcerror_error_t **error )
+{
+	static char *function    = "libewf_hash_tree_clone";
+	size_t leaf_digests_size = 0;
+
+	if( destination_hash_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination hash tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_hash_tree != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid destination hash tree value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_hash_tree == NULL )
+	{
+		*destination_hash_tree = NULL;
+
+		return( 1 );
+	}
+	*destination_hash_tree = memory_allocate_structure(
+	                          libewf_hash_tree_t );
+
+	if( *destination_hash_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create destination hash tree.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     *destination_hash_tree,
+	     source_hash_tree,
+	     sizeof( libewf_hash_tree_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy source to destination hash tree.",
+		 function );
+
+		memory_free(
+		 *destination_hash_tree );
+
+		*destination_hash_tree = NULL;
+
+		return( -1 );
+	}
+	( *destination_hash_tree )->leaf_digests               = NULL;
+	( *destination_hash_tree )->number_of_allocated_leaves = 0;
+	( *destination_hash_tree )->leaf_context               = NULL;
+	( *destination_hash_tree )->leaf_data_size             = 0;
+
+	if( source_hash_tree->number_of_leaves > 0 )
+	{
+		leaf_digests_size = (size_t) source_hash_tree->number_of_leaves * LIBEWF_HASH_TREE_DIGEST_SIZE;
+
+		( *destination_hash_tree )->leaf_digests = (uint8_t *) memory_allocate(
+		                                                        sizeof( uint8_t ) * leaf_digests_size );
+
+		if( ( *destination_hash_tree )->leaf_digests == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create destination leaf digests.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     ( *destination_hash_tree )->leaf_digests,
+		     source_hash_tree->leaf_digests,
+		     leaf_digests_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy source to destination leaf digests.",
+			 function );
+
+			goto on_error;
+		}
+		( *destination_hash_tree )->number_of_allocated_leaves = source_hash_tree->number_of_leaves;
+	}
+	return( 1 );
+
+on_error:
+	if( *destination_hash_tree != NULL )
+	{
+		libewf_hash_tree_free(
+		 destination_hash_tree,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Sets the size of the media data range of a leaf
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_hash_tree_set_range_size(
+     libewf_hash_tree_t *hash_tree,
+     size64_t range_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_hash_tree_set_range_size";
+
+	if( hash_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( hash_tree->media_size != 0 )
+	 || ( hash_tree->is_finalized != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: range size cannot be changed.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( range_size < (size64_t) LIBEWF_HASH_TREE_MINIMUM_RANGE_SIZE )
+	 || ( range_size > (size64_t) INT64_MAX )
+	 || ( ( range_size % 512 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid range size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	hash_tree->range_size = range_size;
+
+	return( 1 );
+}
+
+/* Finalizes the digest of the leaf that is being calculated
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_hash_tree_finalize_leaf(
+     libewf_hash_tree_t *hash_tree,
+     libcerror_error_t **error )
+{
+	uint8_t *reallocation               = NULL;
+	static char *function               = "libewf_hash_tree_finalize_leaf";
+	uint64_t number_of_allocated_leaves = 0;
+
+	if( hash_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_tree->leaf_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid hash tree - missing leaf SHA256 context.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_tree->number_of_leaves >= LIBEWF_HASH_TREE_MAXIMUM_NUMBER_OF_LEAVES )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid hash tree - number of leaves value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_tree->number_of_leaves >= hash_tree->number_of_allocated_leaves )
+	{
+		number_of_allocated_leaves = hash_tree->number_of_allocated_leaves * 2;
+
+		if( number_of_allocated_leaves == 0 )
+		{
+			number_of_allocated_leaves = 256;
+		}
+		else if( number_of_allocated_leaves > LIBEWF_HASH_TREE_MAXIMUM_NUMBER_OF_LEAVES )
+		{
+			number_of_allocated_leaves = LIBEWF_HASH_TREE_MAXIMUM_NUMBER_OF_LEAVES;
+		}
+		reallocation = (uint8_t *) memory_reallocate(
+		                            hash_tree->leaf_digests,
+		                            sizeof( uint8_t ) * (size_t) number_of_allocated_leaves * LIBEWF_HASH_TREE_DIGEST_SIZE );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize leaf digests.",
+			 function );
+
+			return( -1 );
+		}
+		hash_tree->leaf_digests               = reallocation;
+		hash_tree->number_of_allocated_leaves = number_of_allocated_leaves;
+	}
+	if( libhmac_sha256_finalize(
+	     hash_tree->leaf_context,
+	     &( hash_tree->leaf_digests[ hash_tree->number_of_leaves * LIBEWF_HASH_TREE_DIGEST_SIZE ] ),
+	     LIBEWF_HASH_TREE_DIGEST_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize leaf SHA256 hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( libhmac_sha256_free(
+	     &( hash_tree->leaf_context ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free leaf SHA256 context.",
+		 function );
+
+		return( -1 );
+	}
+	hash_tree->number_of_leaves += 1;
+	hash_tree->leaf_data_size    = 0;
+
+	return( 1 );
+}
+
+/* Updates the hash tree with media data
+ * The media data must be provided in order, starting at offset 0
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_hash_tree_update(
+     libewf_hash_tree_t *hash_tree,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_hash_tree_update";
+	size_t buffer_offset  = 0;
+	size_t update_size    = 0;
+
+	if( hash_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_tree->range_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid hash tree - missing range size.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_tree->is_finalized != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid hash tree - already finalized.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < buffer_size )
+	{
+		if( hash_tree->leaf_context == NULL )
+		{
+			if( libhmac_sha256_initialize(
+			     &( hash_tree->leaf_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to initialize leaf SHA256 context.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		update_size = buffer_size - buffer_offset;
+
+		if( (size64_t) update_size > ( hash_tree->range_size - hash_tree->leaf_data_size ) )
+		{
+			update_size = (size_t) ( hash_tree->range_size - hash_tree->leaf_data_size );
+		}
+		if( libhmac_sha256_update(
+		     hash_tree->leaf_context,
+		     &( buffer[ buffer_offset ] ),
+		     update_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update leaf SHA256 hash.",
+			 function );
+
+			return( -1 );
+		}
+		buffer_offset             += update_size;
+		hash_tree->leaf_data_size += update_size;
+		hash_tree->media_size     += update_size;
+
+		if( hash_tree->leaf_data_size == hash_tree->range_size )
+		{
+			if( libewf_hash_tree_finalize_leaf(
+			     hash_tree,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to finalize leaf: %" PRIu64 ".",
+				 function,
+				 hash_tree->number_of_leaves );
+
+				return( -1 );
+			}
+		}
+	}
+	return( 1 );
+}
+
+/* Finalizes the hash tree
+ * Finalizes the last (partial) leaf and calculates the root digest
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_hash_tree_finalize(
+     libewf_hash_tree_t *hash_tree,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_hash_tree_finalize";
+
+	if( hash_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_tree->is_finalized != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid hash tree - already finalized.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_tree->leaf_context != NULL )
+	{
+		if( libewf_hash_tree_finalize_leaf(
+		     hash_tree,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize leaf: %" PRIu64 ".",
+			 function,
+			 hash_tree->number_of_leaves );
+
+			return( -1 );
+		}
+	}
+	if( libewf_hash_tree_calculate_root_digest(
+	     hash_tree->leaf_digests,
+	     hash_tree->number_of_leaves,
+	     hash_tree->root_digest,
+	     LIBEWF_HASH_TREE_DIGEST_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to calculate root digest.",
+		 function );
+
+		return( -1 );
+	}
+	hash_tree->is_finalized = 1;
+
+	return( 1 );
+}
+
+/* Calculates the root digest from the leaf digests
+ * An inner node contains the SHA-256 of the byte 0x01 followed by the digests
+ * of its left and right child nodes. A node without a sibling is promoted
+ * to the next level unchanged. The root of a tree without leaves is
+ * the SHA-256 of empty data.
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_hash_tree_calculate_root_digest(
+     const uint8_t *leaf_digests,
+     uint64_t number_of_leaves,
+     uint8_t *root_digest,
+     size_t root_digest_size,
+     libcerror_error_t **error )
+{
+	uint8_t node_data[ 1 + ( 2 * LIBEWF_HASH_TREE_DIGEST_SIZE ) ];
+
+	const uint8_t *level_digests = NULL;
+	uint8_t *node_digests        = NULL;
+	static char *function        = "libewf_hash_tree_calculate_root_digest";
+	uint64_t node_index          = 0;
+	uint64_t number_of_nodes     = 0;
+
+	if( ( leaf_digests == NULL )
+	 && ( number_of_leaves > 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid leaf digests.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_leaves > (uint64_t) LIBEWF_HASH_TREE_MAXIMUM_NUMBER_OF_LEAVES )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of leaves value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( root_digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid root digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( root_digest_size < LIBEWF_HASH_TREE_DIGEST_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid root digest size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_leaves == 0 )
+	{
+		if( libhmac_sha256_calculate(
+		     node_data,
+		     0,
+		     root_digest,
+		     LIBEWF_HASH_TREE_DIGEST_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to calculate SHA256 hash.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	if( number_of_leaves == 1 )
+	{
+		if( memory_copy(
+		     root_digest,
+		     leaf_digests,
+		     LIBEWF_HASH_TREE_DIGEST_SIZE ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy root digest.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	/* The nodes of a level are stored in place of the nodes of the previous level
+	 */
+	node_digests = (uint8_t *) memory_allocate(
+	                            sizeof( uint8_t ) * (size_t) ( ( number_of_leaves + 1 ) / 2 ) * LIBEWF_HASH_TREE_DIGEST_SIZE );
+
+	if( node_digests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create node digests.",
+		 function );
+
+		goto on_error;
+	}
+	node_data[ 0 ] = 0x01;
+
+	level_digests   = leaf_digests;
+	number_of_nodes = number_of_leaves;
+
+	while( number_of_nodes > 1 )
+	{
+		for( node_index = 0;
+		     ( node_index + 1 ) < number_of_nodes;
+		     node_index += 2 )
+		{
+			if( memory_copy(
+			     &( node_data[ 1 ] ),
+			     &( level_digests[ node_index * LIBEWF_HASH_TREE_DIGEST_SIZE ] ),
+			     2 * LIBEWF_HASH_TREE_DIGEST_SIZE ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy child node digests.",
+				 function );
+
+				goto on_error;
+			}
+			if( libhmac_sha256_calculate(
+			     node_data,
+			     1 + ( 2 * LIBEWF_HASH_TREE_DIGEST_SIZE ),
+			     &( node_digests[ ( node_index / 2 ) * LIBEWF_HASH_TREE_DIGEST_SIZE ] ),
+			     LIBEWF_HASH_TREE_DIGEST_SIZE,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to calculate SHA256 hash.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( node_index < number_of_nodes )
+		{
+			if( memory_copy(
+			     &( node_digests[ ( node_index / 2 ) * LIBEWF_HASH_TREE_DIGEST_SIZE ] ),
+			     &( level_digests[ node_index * LIBEWF_HASH_TREE_DIGEST_SIZE ] ),
+			     LIBEWF_HASH_TREE_DIGEST_SIZE ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy node digest.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		level_digests   = node_digests;
+		number_of_nodes = ( number_of_nodes + 1 ) / 2;
+	}
+	if( memory_copy(
+	     root_digest,
+	     node_digests,
+	     LIBEWF_HASH_TREE_DIGEST_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy root digest.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 node_digests );
+
+	return( 1 );
+
+on_error:
+	if( node_digests != NULL )
+	{
+		memory_free(
+		 node_digests );
+	}
+	return( -1 );
+}
+
+/* Reads the hash tree from the section data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_hash_tree_read_data(
+     libewf_hash_tree_t *hash_tree,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t calculated_root_digest[ LIBEWF_HASH_TREE_DIGEST_SIZE ];
+
+	static char *function        = "libewf_hash_tree_read_data";
+	size64_t range_size          = 0;
+	size64_t media_size          = 0;
+	size_t leaf_digests_size     = 0;
+	uint64_t number_of_leaves    = 0;
+	uint32_t calculated_checksum = 0;
+	uint32_t digest_type         = 0;
+	uint32_t format_version      = 0;
+	uint32_t stored_checksum     = 0;
+
+	if( hash_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( hash_tree->leaf_digests != NULL )
+	 || ( hash_tree->leaf_context != NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid hash tree - leaf digests value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < ( sizeof( ewf_hash_tree_header_t ) + 4 ) )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: hash tree header data:\n",
+		 function );
+		libcnotify_print_data(
+		 data,
+		 sizeof( ewf_hash_tree_header_t ),
+		 0 );
+	}
+#endif
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (ewf_hash_tree_header_t *) data )->format_version,
+	 format_version );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (ewf_hash_tree_header_t *) data )->digest_type,
+	 digest_type );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (ewf_hash_tree_header_t *) data )->range_size,
+	 range_size );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (ewf_hash_tree_header_t *) data )->media_size,
+	 media_size );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (ewf_hash_tree_header_t *) data )->number_of_leaves,
+	 number_of_leaves );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (ewf_hash_tree_header_t *) data )->checksum,
+	 stored_checksum );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: format version\t\t\t\t: %" PRIu32 "\n",
+		 function,
+		 format_version );
+
+		libcnotify_printf(
+		 "%s: digest type\t\t\t\t: %" PRIu32 "\n",
+		 function,
+		 digest_type );
+
+		libcnotify_printf(
+		 "%s: range size\t\t\t\t: %" PRIu64 "\n",
+		 function,
+		 range_size );
+
+		libcnotify_printf(
+		 "%s: media size\t\t\t\t: %" PRIu64 "\n",
+		 function,
+		 media_size );
+
+		libcnotify_printf(
+		 "%s: number of leaves\t\t\t: %" PRIu64 "\n",
+		 function,
+		 number_of_leaves );
+
+		libcnotify_printf(
+		 "%s: root digest:\n",
+		 function );
+		libcnotify_print_data(
+		 ( (ewf_hash_tree_header_t *) data )->root_digest,
+		 LIBEWF_HASH_TREE_DIGEST_SIZE,
+		 0 );
+
+		libcnotify_printf(
+		 "%s: checksum\t\t\t\t\t: 0x%08" PRIx32 "\n",
+		 function,
+		 stored_checksum );
+
+		libcnotify_printf(
+		 "\n" );
+	}
+#endif
+	if( libewf_checksum_calculate_adler32(
+	     &calculated_checksum,
+	     data,
+	     sizeof( ewf_hash_tree_header_t ) - 4,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate header checksum.",
+		 function );
+
+		return( -1 );
+	}
+	if( stored_checksum != calculated_checksum )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_INPUT,
+		 LIBCERROR_INPUT_ERROR_CHECKSUM_MISMATCH,
+		 "%s: header checksum does not match (stored: 0x%08" PRIx32 ", calculated: 0x%08" PRIx32 ").",
+		 function,
+		 stored_checksum,
+		 calculated_checksum );
+
+		return( -1 );
+	}
+	if( format_version != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported format version: %" PRIu32 ".",
+		 function,
+		 format_version );
+
+		return( -1 );
+	}
+	if( digest_type != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported digest type: %" PRIu32 ".",
+		 function,
+		 digest_type );
+
+		return( -1 );
+	}
+	if( ( range_size < (size64_t) LIBEWF_HASH_TREE_MINIMUM_RANGE_SIZE )
+	 || ( range_size > (size64_t) INT64_MAX )
+	 || ( ( range_size % 512 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid range size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_leaves > (uint64_t) LIBEWF_HASH_TREE_MAXIMUM_NUMBER_OF_LEAVES )
+	 || ( number_of_leaves != ( ( media_size / range_size ) + ( ( ( media_size % range_size ) != 0 ) ? 1 : 0 ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of leaves value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	leaf_digests_size = (size_t) number_of_leaves * LIBEWF_HASH_TREE_DIGEST_SIZE;
+
+	if( data_size != ( sizeof( ewf_hash_tree_header_t ) + leaf_digests_size + 4 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 &( data[ sizeof( ewf_hash_tree_header_t ) + leaf_digests_size ] ),
+	 stored_checksum );
+
+	if( libewf_checksum_calculate_adler32(
+	     &calculated_checksum,
+	     &( data[ sizeof( ewf_hash_tree_header_t ) ] ),
+	     leaf_digests_size,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate leaf digests checksum.",
+		 function );
+
+		return( -1 );
+	}
+	if( stored_checksum != calculated_checksum )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_INPUT,
+		 LIBCERROR_INPUT_ERROR_CHECKSUM_MISMATCH,
+		 "%s: leaf digests checksum does not match (stored: 0x%08" PRIx32 ", calculated: 0x%08" PRIx32 ").",
+		 function,
+		 stored_checksum,
+		 calculated_checksum );
+
+		return( -1 );
+	}
+	/* The root digest binds the leaf digests together
+	 */
+	if( libewf_hash_tree_calculate_root_digest(
+	     &( data[ sizeof( ewf_hash_tree_header_t ) ] ),
+	     number_of_leaves,
+	     calculated_root_digest,
+	     LIBEWF_HASH_TREE_DIGEST_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to calculate root digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_compare(
+	     ( (ewf_hash_tree_header_t *) data )->root_digest,
+	     calculated_root_digest,
+	     LIBEWF_HASH_TREE_DIGEST_SIZE ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_INPUT,
+		 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+		 "%s: mismatch in root digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_leaves > 0 )
+	{
+		hash_tree->leaf_digests = (uint8_t *) memory_allocate(
+		                                       sizeof( uint8_t ) * leaf_digests_size );
+
+		if( hash_tree->leaf_digests == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create leaf digests.",
+			 function );
+
+			return( -1 );
+		}
+		if( memory_copy(
+		     hash_tree->leaf_digests,
+		     &( data[ sizeof( ewf_hash_tree_header_t ) ] ),
+		     leaf_digests_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy leaf digests.",
+			 function );
+
+			memory_free(
+			 hash_tree->leaf_digests );
+
+			hash_tree->leaf_digests = NULL;
+
+			return( -1 );
+		}
+	}
+	if( memory_copy(
+	     hash_tree->root_digest,
+	     calculated_root_digest,
+	     LIBEWF_HASH_TREE_DIGEST_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy root digest.",
+		 function );
+
+		return( -1 );
+	}
+	hash_tree->range_size                 = range_size;
+	hash_tree->media_size                 = media_size;
+	hash_tree->number_of_leaves           = number_of_leaves;
+	hash_tree->number_of_allocated_leaves = number_of_leaves;
+	hash_tree->leaf_data_size             = 0;
+	hash_tree->is_finalized               = 1;
+
+	return( 1 );
+}
+
+/* Retrieves the size of the section data of the hash tree
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_hash_tree_get_data_size(
+     libewf_hash_tree_t *hash_tree,
+     size_t *data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_hash_tree_get_data_size";
+
+	if( hash_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_tree->is_finalized == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid hash tree - not finalized.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
+		 function );
+
+		return( -1 );
+	}
+	*data_size = sizeof( ewf_hash_tree_header_t )
+	           + ( (size_t) hash_tree->number_of_leaves * LIBEWF_HASH_TREE_DIGEST_SIZE )
+	           + 4;
+
+	return( 1 );
+}
+
+/* Writes the hash tree to the section data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_hash_tree_write_data(
+     libewf_hash_tree_t *hash_tree,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function        = "libewf_hash_tree_write_data";
+	size_t leaf_digests_size     = 0;
+	uint32_t calculated_checksum = 0;
+
+	if( hash_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_tree->is_finalized == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid hash tree - not finalized.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	leaf_digests_size = (size_t) hash_tree->number_of_leaves * LIBEWF_HASH_TREE_DIGEST_SIZE;
+
+	if( data_size != ( sizeof( ewf_hash_tree_header_t ) + leaf_digests_size + 4 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     data,
+	     0,
+	     sizeof( ewf_hash_tree_header_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear hash tree header data.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewf_hash_tree_header_t *) data )->format_version,
+	 1 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewf_hash_tree_header_t *) data )->digest_type,
+	 1 );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 ( (ewf_hash_tree_header_t *) data )->range_size,
+	 hash_tree->range_size );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 ( (ewf_hash_tree_header_t *) data )->media_size,
+	 hash_tree->media_size );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 ( (ewf_hash_tree_header_t *) data )->number_of_leaves,
+	 hash_tree->number_of_leaves );
+
+	if( memory_copy(
+	     ( (ewf_hash_tree_header_t *) data )->root_digest,
+	     hash_tree->root_digest,
+	     LIBEWF_HASH_TREE_DIGEST_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy root digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_checksum_calculate_adler32(
+	     &calculated_checksum,
+	     data,
+	     sizeof( ewf_hash_tree_header_t ) - 4,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate header checksum.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewf_hash_tree_header_t *) data )->checksum,
+	 calculated_checksum );
+
+	if( leaf_digests_size > 0 )
+	{
+		if( memory_copy(
+		     &( data[ sizeof( ewf_hash_tree_header_t ) ] ),
+		     hash_tree->leaf_digests,
+		     leaf_digests_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy leaf digests.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libewf_checksum_calculate_adler32(
+	     &calculated_checksum,
+	     &( data[ sizeof( ewf_hash_tree_header_t ) ] ),
+	     leaf_digests_size,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate leaf digests checksum.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 &( data[ sizeof( ewf_hash_tree_header_t ) + leaf_digests_size ] ),
+	 calculated_checksum );
+
+	return( 1 );
+}
+
+/* Retrieves the media data range of a specific leaf
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_hash_tree_get_leaf_range(
+     libewf_hash_tree_t *hash_tree,
+     uint64_t leaf_index,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_hash_tree_get_leaf_range";
+	off64_t offset        = 0;
+
+	if( hash_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( leaf_index >= hash_tree->number_of_leaves )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid leaf index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range size.",
+		 function );
+
+		return( -1 );
+	}
+	offset = (off64_t) ( leaf_index * hash_tree->range_size );
+
+	*range_offset = offset;
+	*range_size   = hash_tree->media_size - (size64_t) offset;
+
+	if( *range_size > hash_tree->range_size )
+	{
+		*range_size = hash_tree->range_size;
+	}
+	return( 1 );
+}
+
+/* Compares a digest with the digest of a specific leaf
+ * Returns 1 if the digests match, 0 if not or -1 on error
+ */
+int libewf_hash_tree_compare_leaf_digest(
+     libewf_hash_tree_t *hash_tree,
+     uint64_t leaf_index,
+     const uint8_t *digest,
+     size_t digest_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_hash_tree_compare_leaf_digest";
+
+	if( hash_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( leaf_index >= hash_tree->number_of_leaves )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid leaf index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_size != LIBEWF_HASH_TREE_DIGEST_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid digest size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_compare(
+	     &( hash_tree->leaf_digests[ leaf_index * LIBEWF_HASH_TREE_DIGEST_SIZE ] ),
+	     digest,
+	     LIBEWF_HASH_TREE_DIGEST_SIZE ) != 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,176 @@
+/*
+ * Hash tree functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_HASH_TREE_H )
+#define _LIBEWF_HASH_TREE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+#include "libewf_libhmac.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The size of a hash tree digest
+ */
+#define LIBEWF_HASH_TREE_DIGEST_SIZE			32
+
+/* The default size of the media data range of a leaf
+ */
+#define LIBEWF_HASH_TREE_DEFAULT_RANGE_SIZE		( 64 * 1024 * 1024 )
+
+/* The minimum size of the media data range of a leaf
+ */
+#define LIBEWF_HASH_TREE_MINIMUM_RANGE_SIZE		( 64 * 1024 )
+
+/* The maximum size of the media data that is read at once when verifying a leaf
+ */
+#define LIBEWF_HASH_TREE_MAXIMUM_READ_SIZE		( 1024 * 1024 )
+
+/* The maximum number of leaves
+ */
+#define LIBEWF_HASH_TREE_MAXIMUM_NUMBER_OF_LEAVES	( 16 * 1024 * 1024 )
+
+typedef struct libewf_hash_tree libewf_hash_tree_t;
+
+/* The hash tree is a binary tree of SHA-256 digests over the media data
+ * A leaf contains the digest of a fixed size range of the media data,
+ * so that ranges can be verified independently and in any order. The
+ * root digest binds the leaves together.
+ */
+struct libewf_hash_tree
+{
+	/* The size of the media data range of a leaf
+	 */
+	size64_t range_size;
+
+	/* The media size
+	 */
+	size64_t media_size;
+
+	/* The number of leaves
+	 */
+	uint64_t number_of_leaves;
+
+	/* The number of allocated leaves
+	 */
+	uint64_t number_of_allocated_leaves;
+
+	/* The leaf digests
+	 */
+	uint8_t *leaf_digests;
+
+	/* The root digest
+	 */
+	uint8_t root_digest[ LIBEWF_HASH_TREE_DIGEST_SIZE ];
+
+	/* Value to indicate the hash tree was finalized
+	 */
+	uint8_t is_finalized;
+
+	/* The SHA-256 context of the leaf that is being calculated
+	 */
+	libhmac_sha256_context_t *leaf_context;
+
+	/* The size of the media data in the leaf that is being calculated
+	 */
+	size64_t leaf_data_size;
+};
+
+int libewf_hash_tree_initialize(
+     libewf_hash_tree_t **hash_tree,
+     libcerror_error_t **error );
+
+int libewf_hash_tree_free(
+     libewf_hash_tree_t **hash_tree,
+     libcerror_error_t **error );
+
+int libewf_hash_tree_clone(
+     libewf_hash_tree_t **destination_hash_tree,
+     libewf_hash_tree_t *source_hash_tree,
+     libcerror_error_t **error );
+
+int libewf_hash_tree_set_range_size(
+     libewf_hash_tree_t *hash_tree,
+     size64_t range_size,
+     libcerror_error_t **error );
+
+int libewf_hash_tree_finalize_leaf(
+     libewf_hash_tree_t *hash_tree,
+     libcerror_error_t **error );
+
+int libewf_hash_tree_update(
+     libewf_hash_tree_t *hash_tree,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int libewf_hash_tree_finalize(
+     libewf_hash_tree_t *hash_tree,
+     libcerror_error_t **error );
+
+int libewf_hash_tree_calculate_root_digest(
+     const uint8_t *leaf_digests,
+     uint64_t number_of_leaves,
+     uint8_t *root_digest,
+     size_t root_digest_size,
+     libcerror_error_t **error );
+
+int libewf_hash_tree_read_data(
+     libewf_hash_tree_t *hash_tree,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libewf_hash_tree_get_data_size(
+     libewf_hash_tree_t *hash_tree,
+     size_t *data_size,
+     libcerror_error_t **error );
+
+int libewf_hash_tree_write_data(
+     libewf_hash_tree_t *hash_tree,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libewf_hash_tree_get_leaf_range(
+     libewf_hash_tree_t *hash_tree,
+     uint64_t leaf_index,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error );
+
+int libewf_hash_tree_compare_leaf_digest(
+     libewf_hash_tree_t *hash_tree,
+     uint64_t leaf_index,
+     const uint8_t *digest,
+     size_t digest_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_HASH_TREE_H ) */
+
@@ -204,6 +204,46 @@ int libewf_handle_set_sha1_hash(
      size_t size,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_set_hash_tree_range_size(
+     libewf_handle_t *handle,
+     size64_t range_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_update_hash_tree(
+     libewf_handle_t *handle,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_hash_tree_range_size(
+     libewf_handle_t *handle,
+     size64_t *range_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_number_of_hash_tree_leaves(
+     libewf_handle_t *handle,
+     uint64_t *number_of_leaves,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_hash_tree_leaf_range(
+     libewf_handle_t *handle,
+     uint64_t leaf_index,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_hash_tree_root_digest(
+     libewf_handle_t *handle,
+     uint8_t *root_digest,
+     size_t size,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_set_read_zero_chunk_on_error(
      libewf_handle_t *handle,
@@ -0,0 +1,1427 @@
+/*
+ * Open handles budget functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_open_handles_budget.h"
+
+/* The process-wide open handles budget, NULL if not set
+ */
+libewf_open_handles_budget_t *libewf_global_open_handles_budget = NULL;
+
+/* Creates an open handles budget
+ * Make sure the value budget is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_open_handles_budget_initialize(
+     libewf_open_handles_budget_t **budget,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_open_handles_budget_initialize";
+
+	if( budget == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid budget.",
+		 function );
+
+		return( -1 );
+	}
+	if( *budget != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid budget value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_open_handles <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of open handles value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	*budget = memory_allocate_structure(
+	           libewf_open_handles_budget_t );
+
+	if( *budget == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create budget.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *budget,
+	     0,
+	     sizeof( libewf_open_handles_budget_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear budget.",
+		 function );
+
+		memory_free(
+		 *budget );
+
+		*budget = NULL;
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *budget )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *budget )->maximum_number_of_open_handles = maximum_number_of_open_handles;
+
+	return( 1 );
+
+on_error:
+	if( *budget != NULL )
+	{
+		memory_free(
+		 *budget );
+
+		*budget = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an open handles budget
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_open_handles_budget_free(
+     libewf_open_handles_budget_t **budget,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_open_handles_budget_free";
+	int client_index      = 0;
+	int result            = 1;
+
+	if( budget == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid budget.",
+		 function );
+
+		return( -1 );
+	}
+	if( *budget != NULL )
+	{
+		if( ( *budget )->clients != NULL )
+		{
+			for( client_index = 0;
+			     client_index < ( *budget )->number_of_clients;
+			     client_index++ )
+			{
+				if( ( *budget )->clients[ client_index ]->entries != NULL )
+				{
+					memory_free(
+					 ( *budget )->clients[ client_index ]->entries );
+				}
+				memory_free(
+				 ( *budget )->clients[ client_index ] );
+			}
+			memory_free(
+			 ( *budget )->clients );
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *budget )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *budget );
+
+		*budget = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves the maximum number of open handles
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_open_handles_budget_get_maximum_number_of_open_handles(
+     libewf_open_handles_budget_t *budget,
+     int *maximum_number_of_open_handles,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_open_handles_budget_get_maximum_number_of_open_handles";
+
+	if( budget == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid budget.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_open_handles == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum number of open handles.",
+		 function );
+
+		return( -1 );
+	}
+	*maximum_number_of_open_handles = budget->maximum_number_of_open_handles;
+
+	return( 1 );
+}
+
+/* Sets the maximum number of open handles
+ * When the budget is lowered the allowance of the least recently used clients is reduced,
+ * every client retains an allowance of at least 1 open handle
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_open_handles_budget_set_maximum_number_of_open_handles(
+     libewf_open_handles_budget_t *budget,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_open_handles_budget_set_maximum_number_of_open_handles";
+	int result            = 0;
+
+	if( budget == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid budget.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_open_handles <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of open handles value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     budget->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	budget->maximum_number_of_open_handles = maximum_number_of_open_handles;
+
+	while( budget->number_of_granted_open_handles > budget->maximum_number_of_open_handles )
+	{
+		result = libewf_open_handles_budget_reclaim(
+		          budget,
+		          NULL,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to reclaim open handle.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     budget->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 budget->mutex,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Retrieves the open handles statistics
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_open_handles_budget_get_statistics(
+     libewf_open_handles_budget_t *budget,
+     uint64_t *number_of_opens,
+     uint64_t *number_of_closes,
+     uint64_t *number_of_hits,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_open_handles_budget_get_statistics";
+
+	if( budget == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid budget.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_opens == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of opens.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_closes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of closes.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_hits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of hits.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     budget->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*number_of_opens  = budget->number_of_opens;
+	*number_of_closes = budget->number_of_closes;
+	*number_of_hits   = budget->number_of_hits;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     budget->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the index of the client of a specific file IO pool
+ * The budget mutex must be held by the caller
+ * Returns 1 if successful, 0 if no such client or -1 on error
+ */
+int libewf_open_handles_budget_get_client_index(
+     libewf_open_handles_budget_t *budget,
+     libbfio_pool_t *file_io_pool,
+     int *client_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_open_handles_budget_get_client_index";
+	int safe_client_index = 0;
+
+	if( budget == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid budget.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( client_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid client index.",
+		 function );
+
+		return( -1 );
+	}
+	for( safe_client_index = 0;
+	     safe_client_index < budget->number_of_clients;
+	     safe_client_index++ )
+	{
+		if( budget->clients[ safe_client_index ]->file_io_pool == file_io_pool )
+		{
+			*client_index = safe_client_index;
+
+			return( 1 );
+		}
+	}
+	return( 0 );
+}
+
+/* Reclaims a granted open handle from the least recently used client
+ * Only clients with an allowance of more than 1 open handle, and if a requesting client
+ * is provided, more than the allowance of the requesting client are considered
+ * The reduction is applied to the file IO pool when the client next accesses it
+ * The budget mutex must be held by the caller
+ * Returns 1 if successful, 0 if no open handle could be reclaimed or -1 on error
+ */
+int libewf_open_handles_budget_reclaim(
+     libewf_open_handles_budget_t *budget,
+     libewf_open_handles_budget_client_t *client,
+     libcerror_error_t **error )
+{
+	libewf_open_handles_budget_client_t *candidate_client = NULL;
+	libewf_open_handles_budget_client_t *victim_client    = NULL;
+	static char *function                                 = "libewf_open_handles_budget_reclaim";
+	int client_index                                      = 0;
+
+	if( budget == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid budget.",
+		 function );
+
+		return( -1 );
+	}
+	for( client_index = 0;
+	     client_index < budget->number_of_clients;
+	     client_index++ )
+	{
+		candidate_client = budget->clients[ client_index ];
+
+		if( ( candidate_client == client )
+		 || ( candidate_client->number_of_granted_open_handles <= 1 ) )
+		{
+			continue;
+		}
+		if( ( client != NULL )
+		 && ( candidate_client->number_of_granted_open_handles <= client->number_of_granted_open_handles ) )
+		{
+			continue;
+		}
+		if( ( victim_client == NULL )
+		 || ( candidate_client->last_access < victim_client->last_access ) )
+		{
+			victim_client = candidate_client;
+		}
+	}
+	if( victim_client == NULL )
+	{
+		return( 0 );
+	}
+	victim_client->number_of_granted_open_handles -= 1;
+	budget->number_of_granted_open_handles        -= 1;
+
+	return( 1 );
+}
+
+/* Closes open entries of the file IO pool of a client until no more than
+ * the maximum number of open handles remain open
+ * Entries that were opened only once are closed before entries that were reopened,
+ * since the latter are the segment files the client keeps returning to,
+ * within each group the least recently used entry is closed first
+ * The budget mutex must be held by the caller
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_open_handles_budget_close_entries(
+     libewf_open_handles_budget_t *budget,
+     libewf_open_handles_budget_client_t *client,
+     int maximum_number_of_open_handles,
+     int excluded_entry,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libewf_open_handles_budget_close_entries";
+	uint8_t entry_is_reopened        = 0;
+	uint8_t victim_is_reopened       = 0;
+	int entry_index                  = 0;
+	int number_of_open_handles       = 0;
+	int result                       = 0;
+	int victim_entry                 = 0;
+
+	if( budget == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid budget.",
+		 function );
+
+		return( -1 );
+	}
+	if( client == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid client.",
+		 function );
+
+		return( -1 );
+	}
+	do
+	{
+		number_of_open_handles = 0;
+		victim_entry           = -1;
+		victim_is_reopened     = 0;
+
+		for( entry_index = 0;
+		     entry_index < client->number_of_entries;
+		     entry_index++ )
+		{
+			if( libbfio_pool_get_handle(
+			     client->file_io_pool,
+			     entry_index,
+			     &file_io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve file IO handle: %d from pool.",
+				 function,
+				 entry_index );
+
+				return( -1 );
+			}
+			result = libbfio_handle_is_open(
+			          file_io_handle,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if file IO handle: %d is open.",
+				 function,
+				 entry_index );
+
+				return( -1 );
+			}
+			else if( result == 0 )
+			{
+				continue;
+			}
+			number_of_open_handles++;
+
+			if( entry_index == excluded_entry )
+			{
+				continue;
+			}
+			entry_is_reopened = (uint8_t) ( client->entries[ entry_index ].number_of_opens > 1 );
+
+			if( ( victim_entry == -1 )
+			 || ( ( victim_is_reopened != 0 )
+			  &&  ( entry_is_reopened == 0 ) )
+			 || ( ( victim_is_reopened == entry_is_reopened )
+			  &&  ( client->entries[ entry_index ].last_access < client->entries[ victim_entry ].last_access ) ) )
+			{
+				victim_entry       = entry_index;
+				victim_is_reopened = entry_is_reopened;
+			}
+		}
+		if( ( number_of_open_handles <= maximum_number_of_open_handles )
+		 || ( victim_entry == -1 ) )
+		{
+			break;
+		}
+		if( libbfio_pool_close(
+		     client->file_io_pool,
+		     victim_entry,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close file IO pool entry: %d.",
+			 function,
+			 victim_entry );
+
+			return( -1 );
+		}
+		budget->number_of_closes += 1;
+	}
+	while( number_of_open_handles > maximum_number_of_open_handles );
+
+	return( 1 );
+}
+
+/* Resizes the entries of a client to the number of handles in its file IO pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_open_handles_budget_client_resize_entries(
+     libewf_open_handles_budget_client_t *client,
+     libcerror_error_t **error )
+{
+	void *reallocation    = NULL;
+	static char *function = "libewf_open_handles_budget_client_resize_entries";
+	int number_of_handles = 0;
+
+	if( client == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid client.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_pool_get_number_of_handles(
+	     client->file_io_pool,
+	     &number_of_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of handles in pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_handles <= client->number_of_entries )
+	{
+		return( 1 );
+	}
+	if( (size_t) number_of_handles > (size_t) ( SSIZE_MAX / sizeof( libewf_open_handles_budget_entry_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of handles value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	reallocation = memory_reallocate(
+	                client->entries,
+	                sizeof( libewf_open_handles_budget_entry_t ) * number_of_handles );
+
+	if( reallocation == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to resize entries.",
+		 function );
+
+		return( -1 );
+	}
+	client->entries = (libewf_open_handles_budget_entry_t *) reallocation;
+
+	if( memory_set(
+	     &( client->entries[ client->number_of_entries ] ),
+	     0,
+	     sizeof( libewf_open_handles_budget_entry_t ) * ( number_of_handles - client->number_of_entries ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear entries.",
+		 function );
+
+		return( -1 );
+	}
+	client->number_of_entries = number_of_handles;
+
+	return( 1 );
+}
+
+/* Registers a file IO pool with the budget
+ * The file IO pool is limited to 1 open handle, its allowance grows when its
+ * entries are reopened, i.e. when a small allowance causes open and close churn
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_open_handles_budget_register_file_io_pool(
+     libewf_open_handles_budget_t *budget,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error )
+{
+	libewf_open_handles_budget_client_t *client = NULL;
+	void *reallocation                          = NULL;
+	static char *function                       = "libewf_open_handles_budget_register_file_io_pool";
+	int client_index                            = 0;
+	int number_of_allocated_clients             = 0;
+	int result                                  = 0;
+
+	if( budget == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid budget.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     budget->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_open_handles_budget_get_client_index(
+	          budget,
+	          file_io_pool,
+	          &client_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve client index.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file IO pool value already registered.",
+		 function );
+
+		goto on_error;
+	}
+	if( budget->number_of_clients >= budget->number_of_allocated_clients )
+	{
+		if( budget->number_of_allocated_clients == 0 )
+		{
+			number_of_allocated_clients = 16;
+		}
+		else if( budget->number_of_allocated_clients < ( INT_MAX / 2 ) )
+		{
+			number_of_allocated_clients = budget->number_of_allocated_clients * 2;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of clients value exceeds maximum.",
+			 function );
+
+			goto on_error;
+		}
+		reallocation = memory_reallocate(
+		                budget->clients,
+		                sizeof( libewf_open_handles_budget_client_t * ) * number_of_allocated_clients );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize clients.",
+			 function );
+
+			goto on_error;
+		}
+		budget->clients                     = (libewf_open_handles_budget_client_t **) reallocation;
+		budget->number_of_allocated_clients = number_of_allocated_clients;
+	}
+	client = memory_allocate_structure(
+	          libewf_open_handles_budget_client_t );
+
+	if( client == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create client.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     client,
+	     0,
+	     sizeof( libewf_open_handles_budget_client_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear client.",
+		 function );
+
+		memory_free(
+		 client );
+
+		client = NULL;
+
+		goto on_error;
+	}
+	client->file_io_pool                   = file_io_pool;
+	client->maximum_number_of_open_handles = 1;
+	client->number_of_granted_open_handles = 1;
+
+	if( libewf_open_handles_budget_client_resize_entries(
+	     client,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize client entries.",
+		 function );
+
+		goto on_error;
+	}
+	/* Close all handles that were opened before the file IO pool was registered
+	 * so that the file IO pool only tracks handles opened within its limit
+	 */
+	if( libewf_open_handles_budget_close_entries(
+	     budget,
+	     client,
+	     0,
+	     -1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file IO pool entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_set_maximum_number_of_open_handles(
+	     file_io_pool,
+	     client->maximum_number_of_open_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set maximum number of open handles in file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( budget->number_of_granted_open_handles >= budget->maximum_number_of_open_handles )
+	{
+		if( libewf_open_handles_budget_reclaim(
+		     budget,
+		     client,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to reclaim open handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	budget->access_sequence += 1;
+
+	client->last_access = budget->access_sequence;
+
+	budget->clients[ budget->number_of_clients ] = client;
+
+	budget->number_of_clients              += 1;
+	budget->number_of_granted_open_handles += 1;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     budget->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( client != NULL )
+	{
+		if( client->entries != NULL )
+		{
+			memory_free(
+			 client->entries );
+		}
+		memory_free(
+		 client );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 budget->mutex,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Unregisters a file IO pool from the budget
+ * The allowance of the file IO pool is returned to the budget
+ * Returns 1 if successful, 0 if the file IO pool was not registered or -1 on error
+ */
+int libewf_open_handles_budget_unregister_file_io_pool(
+     libewf_open_handles_budget_t *budget,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error )
+{
+	libewf_open_handles_budget_client_t *client = NULL;
+	static char *function                       = "libewf_open_handles_budget_unregister_file_io_pool";
+	int client_index                            = 0;
+	int result                                  = 0;
+
+	if( budget == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid budget.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     budget->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_open_handles_budget_get_client_index(
+	          budget,
+	          file_io_pool,
+	          &client_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve client index.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		client = budget->clients[ client_index ];
+
+		budget->number_of_granted_open_handles -= client->number_of_granted_open_handles;
+		budget->number_of_clients              -= 1;
+
+		budget->clients[ client_index ] = budget->clients[ budget->number_of_clients ];
+
+		budget->clients[ budget->number_of_clients ] = NULL;
+
+		if( client->entries != NULL )
+		{
+			memory_free(
+			 client->entries );
+		}
+		memory_free(
+		 client );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     budget->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 budget->mutex,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Accounts for an access of an entry of a file IO pool
+ * Must be called before the file IO pool entry is read, by the thread that owns the file IO pool
+ * Pending reductions of the allowance are applied and, if the entry is not open,
+ * another entry is closed to make room so that the file IO pool never exceeds its allowance
+ * Returns 1 if successful, 0 if the file IO pool was not registered or -1 on error
+ */
+int libewf_open_handles_budget_access_file_io_pool_entry(
+     libewf_open_handles_budget_t *budget,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle            = NULL;
+	libewf_open_handles_budget_client_t *client = NULL;
+	static char *function                       = "libewf_open_handles_budget_access_file_io_pool_entry";
+	int client_index                            = 0;
+	int maximum_number_of_open_handles          = 0;
+	int result                                  = 0;
+
+	if( budget == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid budget.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     budget->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_open_handles_budget_get_client_index(
+	          budget,
+	          file_io_pool,
+	          &client_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve client index.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		client = budget->clients[ client_index ];
+
+		budget->access_sequence += 1;
+
+		client->last_access = budget->access_sequence;
+
+		if( libewf_open_handles_budget_client_resize_entries(
+		     client,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize client entries.",
+			 function );
+
+			goto on_error;
+		}
+		if( ( file_io_pool_entry < 0 )
+		 || ( file_io_pool_entry >= client->number_of_entries ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid file IO pool entry value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		if( libbfio_pool_get_handle(
+		     file_io_pool,
+		     file_io_pool_entry,
+		     &file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file IO handle: %d from pool.",
+			 function,
+			 file_io_pool_entry );
+
+			goto on_error;
+		}
+		result = libbfio_handle_is_open(
+		          file_io_handle,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if file IO handle: %d is open.",
+			 function,
+			 file_io_pool_entry );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			budget->number_of_hits += 1;
+		}
+		else
+		{
+			budget->number_of_opens += 1;
+
+			/* A reopened entry indicates the allowance is too small for the access pattern
+			 */
+			if( ( client->entries[ file_io_pool_entry ].number_of_opens > 0 )
+			 && ( client->number_of_granted_open_handles < client->number_of_entries ) )
+			{
+				if( budget->number_of_granted_open_handles >= budget->maximum_number_of_open_handles )
+				{
+					if( libewf_open_handles_budget_reclaim(
+					     budget,
+					     client,
+					     error ) == -1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+						 "%s: unable to reclaim open handle.",
+						 function );
+
+						goto on_error;
+					}
+				}
+				if( budget->number_of_granted_open_handles < budget->maximum_number_of_open_handles )
+				{
+					client->number_of_granted_open_handles += 1;
+					budget->number_of_granted_open_handles += 1;
+				}
+			}
+			client->entries[ file_io_pool_entry ].number_of_opens += 1;
+		}
+		maximum_number_of_open_handles = client->number_of_granted_open_handles;
+
+		if( result == 0 )
+		{
+			maximum_number_of_open_handles -= 1;
+		}
+		/* Close entries to apply a pending reduction or to make room for the entry
+		 */
+		if( libewf_open_handles_budget_close_entries(
+		     budget,
+		     client,
+		     maximum_number_of_open_handles,
+		     file_io_pool_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close file IO pool entries.",
+			 function );
+
+			goto on_error;
+		}
+		if( client->number_of_granted_open_handles != client->maximum_number_of_open_handles )
+		{
+			if( libbfio_pool_set_maximum_number_of_open_handles(
+			     file_io_pool,
+			     client->number_of_granted_open_handles,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set maximum number of open handles in file IO pool.",
+				 function );
+
+				goto on_error;
+			}
+			client->maximum_number_of_open_handles = client->number_of_granted_open_handles;
+		}
+		client->entries[ file_io_pool_entry ].last_access = budget->access_sequence;
+
+		result = 1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     budget->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 budget->mutex,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Registers a file IO pool with the process-wide budget
+ * Returns 1 if successful, 0 if no budget is set or -1 on error
+ */
+int libewf_open_handles_register_file_io_pool(
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error )
+{
+	if( libewf_global_open_handles_budget == NULL )
+	{
+		return( 0 );
+	}
+	return( libewf_open_handles_budget_register_file_io_pool(
+	         libewf_global_open_handles_budget,
+	         file_io_pool,
+	         error ) );
+}
+
+/* Unregisters a file IO pool from the process-wide budget
+ * Returns 1 if successful, 0 if no budget is set or the file IO pool was not registered or -1 on error
+ */
+int libewf_open_handles_unregister_file_io_pool(
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error )
+{
+	if( libewf_global_open_handles_budget == NULL )
+	{
+		return( 0 );
+	}
+	return( libewf_open_handles_budget_unregister_file_io_pool(
+	         libewf_global_open_handles_budget,
+	         file_io_pool,
+	         error ) );
+}
+
+/* Accounts for an access of an entry of a file IO pool in the process-wide budget
+ * Returns 1 if successful, 0 if no budget is set or the file IO pool was not registered or -1 on error
+ */
+int libewf_open_handles_access_file_io_pool_entry(
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libcerror_error_t **error )
+{
+	if( libewf_global_open_handles_budget == NULL )
+	{
+		return( 0 );
+	}
+	return( libewf_open_handles_budget_access_file_io_pool_entry(
+	         libewf_global_open_handles_budget,
+	         file_io_pool,
+	         file_io_pool_entry,
+	         error ) );
+}
+
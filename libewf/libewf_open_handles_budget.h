@@ -0,0 +1,212 @@
+/*
+ * Open handles budget functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_OPEN_HANDLES_BUDGET_H )
+#define _LIBEWF_OPEN_HANDLES_BUDGET_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_open_handles_budget_entry libewf_open_handles_budget_entry_t;
+
+struct libewf_open_handles_budget_entry
+{
+	/* The access sequence number of the last access
+	 */
+	uint64_t last_access;
+
+	/* The number of times the entry was opened
+	 */
+	uint32_t number_of_opens;
+};
+
+typedef struct libewf_open_handles_budget_client libewf_open_handles_budget_client_t;
+
+struct libewf_open_handles_budget_client
+{
+	/* The file IO pool
+	 */
+	libbfio_pool_t *file_io_pool;
+
+	/* The maximum number of open handles set in the file IO pool
+	 */
+	int maximum_number_of_open_handles;
+
+	/* The number of open handles granted by the budget
+	 * this value can be lower than the maximum until the client next accesses the file IO pool
+	 */
+	int number_of_granted_open_handles;
+
+	/* The access sequence number of the last access
+	 */
+	uint64_t last_access;
+
+	/* The entries
+	 */
+	libewf_open_handles_budget_entry_t *entries;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+};
+
+typedef struct libewf_open_handles_budget libewf_open_handles_budget_t;
+
+struct libewf_open_handles_budget
+{
+	/* The maximum number of open handles shared by all clients
+	 */
+	int maximum_number_of_open_handles;
+
+	/* The number of open handles granted to the clients
+	 */
+	int number_of_granted_open_handles;
+
+	/* The clients
+	 */
+	libewf_open_handles_budget_client_t **clients;
+
+	/* The number of clients
+	 */
+	int number_of_clients;
+
+	/* The number of allocated clients
+	 */
+	int number_of_allocated_clients;
+
+	/* The access sequence number
+	 */
+	uint64_t access_sequence;
+
+	/* The number of times a file IO pool entry was opened
+	 */
+	uint64_t number_of_opens;
+
+	/* The number of times a file IO pool entry was closed by the budget
+	 */
+	uint64_t number_of_closes;
+
+	/* The number of times a file IO pool entry was accessed while open
+	 */
+	uint64_t number_of_hits;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+/* The process-wide open handles budget, NULL if not set
+ */
+extern libewf_open_handles_budget_t *libewf_global_open_handles_budget;
+
+int libewf_open_handles_budget_initialize(
+     libewf_open_handles_budget_t **budget,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error );
+
+int libewf_open_handles_budget_free(
+     libewf_open_handles_budget_t **budget,
+     libcerror_error_t **error );
+
+int libewf_open_handles_budget_get_maximum_number_of_open_handles(
+     libewf_open_handles_budget_t *budget,
+     int *maximum_number_of_open_handles,
+     libcerror_error_t **error );
+
+int libewf_open_handles_budget_set_maximum_number_of_open_handles(
+     libewf_open_handles_budget_t *budget,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error );
+
+int libewf_open_handles_budget_get_statistics(
+     libewf_open_handles_budget_t *budget,
+     uint64_t *number_of_opens,
+     uint64_t *number_of_closes,
+     uint64_t *number_of_hits,
+     libcerror_error_t **error );
+
+int libewf_open_handles_budget_get_client_index(
+     libewf_open_handles_budget_t *budget,
+     libbfio_pool_t *file_io_pool,
+     int *client_index,
+     libcerror_error_t **error );
+
+int libewf_open_handles_budget_reclaim(
+     libewf_open_handles_budget_t *budget,
+     libewf_open_handles_budget_client_t *client,
+     libcerror_error_t **error );
+
+int libewf_open_handles_budget_close_entries(
+     libewf_open_handles_budget_t *budget,
+     libewf_open_handles_budget_client_t *client,
+     int maximum_number_of_open_handles,
+     int excluded_entry,
+     libcerror_error_t **error );
+
+int libewf_open_handles_budget_client_resize_entries(
+     libewf_open_handles_budget_client_t *client,
+     libcerror_error_t **error );
+
+int libewf_open_handles_budget_register_file_io_pool(
+     libewf_open_handles_budget_t *budget,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error );
+
+int libewf_open_handles_budget_unregister_file_io_pool(
+     libewf_open_handles_budget_t *budget,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error );
+
+int libewf_open_handles_budget_access_file_io_pool_entry(
+     libewf_open_handles_budget_t *budget,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libcerror_error_t **error );
+
+int libewf_open_handles_register_file_io_pool(
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error );
+
+int libewf_open_handles_unregister_file_io_pool(
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error );
+
+int libewf_open_handles_access_file_io_pool_entry(
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_OPEN_HANDLES_BUDGET_H ) */
+
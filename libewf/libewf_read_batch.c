@@ -0,0 +1,1075 @@
+/*
+ * Read batch functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "libewf_chunk_data.h"
+#include "libewf_definitions.h"
+#include "libewf_io_handle.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
+#include "libewf_read_batch.h"
+#include "libewf_statistics.h"
+
+/* Creates a read batch
+ * Make sure the value read_batch is referencing, is set to NULL
+ * The size of the requests is limited to the media size
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_batch_initialize(
+     libewf_read_batch_t **read_batch,
+     libewf_io_handle_t *io_handle,
+     void * const *buffers,
+     const size_t *buffer_sizes,
+     const off64_t *offsets,
+     int number_of_requests,
+     size64_t media_size,
+     libcerror_error_t **error )
+{
+	libewf_read_batch_request_t *request = NULL;
+	static char *function                = "libewf_read_batch_initialize";
+	int request_index                    = 0;
+
+	if( read_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_batch != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid read batch value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffers.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer sizes.",
+		 function );
+
+		return( -1 );
+	}
+	if( offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_requests <= 0 )
+	 || ( (size_t) number_of_requests > (size_t) ( SSIZE_MAX / sizeof( libewf_read_batch_request_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of requests value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	for( request_index = 0;
+	     request_index < number_of_requests;
+	     request_index++ )
+	{
+		if( buffers[ request_index ] == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid buffer: %d.",
+			 function,
+			 request_index );
+
+			return( -1 );
+		}
+		if( buffer_sizes[ request_index ] > (size_t) SSIZE_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid buffer: %d size value exceeds maximum.",
+			 function,
+			 request_index );
+
+			return( -1 );
+		}
+		if( offsets[ request_index ] < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+			 "%s: invalid offset: %d value less than zero.",
+			 function,
+			 request_index );
+
+			return( -1 );
+		}
+	}
+	*read_batch = memory_allocate_structure(
+	               libewf_read_batch_t );
+
+	if( *read_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read batch.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *read_batch,
+	     0,
+	     sizeof( libewf_read_batch_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear read batch.",
+		 function );
+
+		memory_free(
+		 *read_batch );
+
+		*read_batch = NULL;
+
+		return( -1 );
+	}
+	( *read_batch )->requests = (libewf_read_batch_request_t *) memory_allocate(
+	                                                             sizeof( libewf_read_batch_request_t ) * number_of_requests );
+
+	if( ( *read_batch )->requests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create requests.",
+		 function );
+
+		goto on_error;
+	}
+	( *read_batch )->sorted_requests = (libewf_read_batch_request_t **) memory_allocate(
+	                                                                     sizeof( libewf_read_batch_request_t * ) * number_of_requests );
+
+	if( ( *read_batch )->sorted_requests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create sorted requests.",
+		 function );
+
+		goto on_error;
+	}
+	for( request_index = 0;
+	     request_index < number_of_requests;
+	     request_index++ )
+	{
+		request = &( ( ( *read_batch )->requests )[ request_index ] );
+
+		request->request_index = request_index;
+		request->offset        = offsets[ request_index ];
+		request->buffer        = (uint8_t *) buffers[ request_index ];
+		request->buffer_size   = buffer_sizes[ request_index ];
+		request->read_count    = 0;
+
+		if( (size64_t) request->offset >= media_size )
+		{
+			request->buffer_size = 0;
+		}
+		else if( (size64_t) request->buffer_size > ( media_size - (size64_t) request->offset ) )
+		{
+			request->buffer_size = (size_t) ( media_size - (size64_t) request->offset );
+		}
+		( *read_batch )->sorted_requests[ request_index ] = request;
+	}
+	if( number_of_requests > 1 )
+	{
+		qsort(
+		 ( *read_batch )->sorted_requests,
+		 (size_t) number_of_requests,
+		 sizeof( libewf_read_batch_request_t * ),
+		 &libewf_read_batch_compare_requests );
+	}
+	( *read_batch )->io_handle          = io_handle;
+	( *read_batch )->media_size         = media_size;
+	( *read_batch )->number_of_requests = number_of_requests;
+
+	return( 1 );
+
+on_error:
+	if( *read_batch != NULL )
+	{
+		if( ( *read_batch )->requests != NULL )
+		{
+			memory_free(
+			 ( *read_batch )->requests );
+		}
+		memory_free(
+		 *read_batch );
+
+		*read_batch = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a read batch
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_batch_free(
+     libewf_read_batch_t **read_batch,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_batch_free";
+	int result            = 1;
+
+	if( read_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_batch != NULL )
+	{
+		if( libewf_read_batch_free_chunks(
+		     *read_batch,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunks.",
+			 function );
+
+			result = -1;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( *read_batch )->unpack_thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *read_batch )->unpack_thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join unpack thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *read_batch )->unpacked_condition != NULL )
+		{
+			if( libcthreads_condition_free(
+			     &( ( *read_batch )->unpacked_condition ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free unpacked condition.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *read_batch )->mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *read_batch )->mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+		memory_free(
+		 ( *read_batch )->sorted_requests );
+
+		memory_free(
+		 ( *read_batch )->requests );
+
+		memory_free(
+		 *read_batch );
+
+		*read_batch = NULL;
+	}
+	return( result );
+}
+
+/* Compares two requests by their offset
+ * Returns -1, 0 or 1 as required by qsort and bsearch
+ */
+int libewf_read_batch_compare_requests(
+     const void *first_request,
+     const void *second_request )
+{
+	const libewf_read_batch_request_t *first  = *( (libewf_read_batch_request_t * const *) first_request );
+	const libewf_read_batch_request_t *second = *( (libewf_read_batch_request_t * const *) second_request );
+
+	if( first->offset < second->offset )
+	{
+		return( -1 );
+	}
+	else if( first->offset > second->offset )
+	{
+		return( 1 );
+	}
+	/* Keep the order of the caller for requests with the same offset
+	 */
+	if( first->request_index < second->request_index )
+	{
+		return( -1 );
+	}
+	else if( first->request_index > second->request_index )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Retrieves the next chunks that are referenced by the requests
+ * The chunks are unique and in ascending order over all subsequent calls,
+ * hence every chunk is read and unpacked once
+ * Returns 1 if successful, 0 if no more chunks are available or -1 on error
+ */
+int libewf_read_batch_get_next_chunks(
+     libewf_read_batch_t *read_batch,
+     libcerror_error_t **error )
+{
+	libewf_read_batch_request_t *request = NULL;
+	static char *function                = "libewf_read_batch_get_next_chunks";
+	size64_t chunk_size                  = 0;
+	uint64_t first_chunk_index           = 0;
+	uint64_t last_chunk_index            = 0;
+	off64_t chunk_offset                 = 0;
+
+	if( read_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_batch->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid read batch - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_batch->number_of_chunks != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid read batch - chunks value already set.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_size = (size64_t) read_batch->io_handle->chunk_size;
+
+	/* Requests that end before the next chunk have been read completely
+	 */
+	while( read_batch->active_request_index < read_batch->sorted_request_index )
+	{
+		request = read_batch->sorted_requests[ read_batch->active_request_index ];
+
+		if( (size64_t) ( request->offset + request->buffer_size ) > ( read_batch->next_chunk_index * chunk_size ) )
+		{
+			break;
+		}
+		read_batch->active_request_index += 1;
+	}
+	while( ( read_batch->sorted_request_index < read_batch->number_of_requests )
+	    && ( read_batch->number_of_chunks < LIBEWF_READ_BATCH_MAXIMUM_NUMBER_OF_CHUNKS ) )
+	{
+		request = read_batch->sorted_requests[ read_batch->sorted_request_index ];
+
+		if( request->buffer_size == 0 )
+		{
+			read_batch->sorted_request_index += 1;
+
+			continue;
+		}
+		first_chunk_index = (uint64_t) request->offset / chunk_size;
+		last_chunk_index  = ( (uint64_t) request->offset + request->buffer_size - 1 ) / chunk_size;
+
+		if( read_batch->next_chunk_index < first_chunk_index )
+		{
+			read_batch->next_chunk_index = first_chunk_index;
+		}
+		if( read_batch->next_chunk_index > last_chunk_index )
+		{
+			read_batch->sorted_request_index += 1;
+
+			continue;
+		}
+		chunk_offset = (off64_t) ( read_batch->next_chunk_index * chunk_size );
+
+		read_batch->chunks[ read_batch->number_of_chunks ].chunk_index = read_batch->next_chunk_index;
+		read_batch->chunks[ read_batch->number_of_chunks ].data_size   = (size_t) chunk_size;
+		read_batch->chunks[ read_batch->number_of_chunks ].chunk_data  = NULL;
+
+		if( ( read_batch->media_size - (size64_t) chunk_offset ) < chunk_size )
+		{
+			read_batch->chunks[ read_batch->number_of_chunks ].data_size = (size_t) ( read_batch->media_size - (size64_t) chunk_offset );
+		}
+		read_batch->number_of_chunks += 1;
+		read_batch->next_chunk_index += 1;
+	}
+	if( read_batch->number_of_chunks == 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Frees the chunk data of the chunks
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_batch_free_chunks(
+     libewf_read_batch_t *read_batch,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_batch_free_chunks";
+	int chunk_index       = 0;
+	int result            = 1;
+
+	if( read_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read batch.",
+		 function );
+
+		return( -1 );
+	}
+	for( chunk_index = 0;
+	     chunk_index < read_batch->number_of_chunks;
+	     chunk_index++ )
+	{
+		if( read_batch->chunks[ chunk_index ].chunk_data != NULL )
+		{
+			if( libewf_chunk_data_free(
+			     &( read_batch->chunks[ chunk_index ].chunk_data ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free chunk: %" PRIu64 " data.",
+				 function,
+				 read_batch->chunks[ chunk_index ].chunk_index );
+
+				result = -1;
+			}
+		}
+	}
+	read_batch->number_of_chunks = 0;
+
+	return( result );
+}
+
+/* Unpacks the chunk data of a chunk
+ * Chunk data that cannot be unpacked or is corrupted is freed,
+ * so that the chunk is read by means of the chunks cache, which reports the error
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_batch_unpack_chunk(
+     libewf_read_batch_t *read_batch,
+     libewf_read_batch_chunk_t *chunk,
+     libewf_statistics_t *statistics,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_batch_unpack_chunk";
+	int result            = 0;
+
+	if( read_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk->chunk_data == NULL )
+	{
+		return( 1 );
+	}
+	result = libewf_chunk_data_unpack(
+	          chunk->chunk_data,
+	          read_batch->io_handle,
+	          statistics,
+	          error );
+
+	if( result != 1 )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			if( ( error != NULL )
+			 && ( *error != NULL ) )
+			{
+				libcnotify_print_error_backtrace(
+				 *error );
+			}
+		}
+#endif
+		libcerror_error_free(
+		 error );
+	}
+	else if( ( ( chunk->chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+	      || ( chunk->chunk_data->data_size != chunk->data_size ) )
+	{
+		result = 0;
+	}
+	if( result != 1 )
+	{
+		if( libewf_chunk_data_free(
+		     &( chunk->chunk_data ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk: %" PRIu64 " data.",
+			 function,
+			 chunk->chunk_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Callback function to unpack the chunk data of a chunk
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_batch_unpack_chunk_callback(
+     libewf_read_batch_chunk_t *chunk,
+     libewf_read_batch_t *read_batch )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "libewf_read_batch_unpack_chunk_callback";
+	int result               = 1;
+
+	/* The statistics are not multi-thread safe hence the chunks unpacked by the thread pool are not accounted for
+	 */
+	if( libewf_read_batch_unpack_chunk(
+	     read_batch,
+	     chunk,
+	     NULL,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to unpack chunk.",
+		 function );
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+
+		result = -1;
+	}
+	/* The chunk is accounted for also if it could not be unpacked
+	 * otherwise the wait for the unpacked chunks would not end
+	 */
+	if( libcthreads_mutex_grab(
+	     read_batch->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	read_batch->number_of_pending_chunks -= 1;
+
+	if( read_batch->number_of_pending_chunks == 0 )
+	{
+		if( libcthreads_condition_broadcast(
+		     read_batch->unpacked_condition,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast unpacked condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 read_batch->mutex,
+			 NULL );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     read_batch->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+#if defined( HAVE_VERBOSE_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+	}
+#endif
+	libcerror_error_free(
+	 &error );
+
+	return( -1 );
+}
+
+/* Waits until all chunks pushed onto the unpack thread pool have been unpacked
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_batch_wait_for_unpacked_chunks(
+     libewf_read_batch_t *read_batch,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_batch_wait_for_unpacked_chunks";
+
+	if( read_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_batch->mutex == NULL )
+	{
+		return( 1 );
+	}
+	if( libcthreads_mutex_grab(
+	     read_batch->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( read_batch->number_of_pending_chunks > 0 )
+	{
+		if( libcthreads_condition_wait(
+		     read_batch->unpacked_condition,
+		     read_batch->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to wait for unpacked condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 read_batch->mutex,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	if( libcthreads_mutex_release(
+	     read_batch->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+/* Unpacks the chunk data of the chunks
+ * If multi-threading is supported the chunks are unpacked by a thread pool,
+ * which is created once per read batch and reused for its subsequent chunks
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_batch_unpack_chunks(
+     libewf_read_batch_t *read_batch,
+     libewf_statistics_t *statistics,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	int number_of_packed_chunks = 0;
+	int number_of_threads       = 0;
+#endif
+
+	static char *function       = "libewf_read_batch_unpack_chunks";
+	int chunk_index             = 0;
+
+	if( read_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read batch.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	for( chunk_index = 0;
+	     chunk_index < read_batch->number_of_chunks;
+	     chunk_index++ )
+	{
+		if( read_batch->chunks[ chunk_index ].chunk_data != NULL )
+		{
+			number_of_packed_chunks++;
+		}
+	}
+	number_of_threads = LIBEWF_READ_BATCH_NUMBER_OF_THREADS;
+
+	if( number_of_threads > number_of_packed_chunks )
+	{
+		number_of_threads = number_of_packed_chunks;
+	}
+	/* A thread pool that already exists is used also for a small number of chunks
+	 * since the threads are already running
+	 */
+	if( ( number_of_threads > 1 )
+	 || ( ( read_batch->unpack_thread_pool != NULL )
+	  &&  ( number_of_packed_chunks > 0 ) ) )
+	{
+		if( read_batch->unpack_thread_pool == NULL )
+		{
+			if( read_batch->mutex == NULL )
+			{
+				if( libcthreads_mutex_initialize(
+				     &( read_batch->mutex ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to initialize mutex.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			if( read_batch->unpacked_condition == NULL )
+			{
+				if( libcthreads_condition_initialize(
+				     &( read_batch->unpacked_condition ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to initialize unpacked condition.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			if( libcthreads_thread_pool_create(
+			     &( read_batch->unpack_thread_pool ),
+			     NULL,
+			     LIBEWF_READ_BATCH_NUMBER_OF_THREADS,
+			     LIBEWF_READ_BATCH_MAXIMUM_NUMBER_OF_CHUNKS,
+			     (int (*)(intptr_t *, void *)) &libewf_read_batch_unpack_chunk_callback,
+			     (void *) read_batch,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to initialize unpack thread pool.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		for( chunk_index = 0;
+		     chunk_index < read_batch->number_of_chunks;
+		     chunk_index++ )
+		{
+			if( read_batch->chunks[ chunk_index ].chunk_data == NULL )
+			{
+				continue;
+			}
+			if( libcthreads_mutex_grab(
+			     read_batch->mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to grab mutex.",
+				 function );
+
+				goto on_error;
+			}
+			read_batch->number_of_pending_chunks += 1;
+
+			if( libcthreads_mutex_release(
+			     read_batch->mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release mutex.",
+				 function );
+
+				goto on_error;
+			}
+			if( libcthreads_thread_pool_push(
+			     read_batch->unpack_thread_pool,
+			     (intptr_t *) &( read_batch->chunks[ chunk_index ] ),
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push chunk: %" PRIu64 " onto unpack thread pool queue.",
+				 function,
+				 read_batch->chunks[ chunk_index ].chunk_index );
+
+				if( libcthreads_mutex_grab(
+				     read_batch->mutex,
+				     NULL ) == 1 )
+				{
+					read_batch->number_of_pending_chunks -= 1;
+
+					libcthreads_mutex_release(
+					 read_batch->mutex,
+					 NULL );
+				}
+				goto on_error;
+			}
+		}
+		if( libewf_read_batch_wait_for_unpacked_chunks(
+		     read_batch,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to wait for unpacked chunks.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else
+#endif
+	{
+		for( chunk_index = 0;
+		     chunk_index < read_batch->number_of_chunks;
+		     chunk_index++ )
+		{
+			if( libewf_read_batch_unpack_chunk(
+			     read_batch,
+			     &( read_batch->chunks[ chunk_index ] ),
+			     statistics,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to unpack chunk: %" PRIu64 ".",
+				 function,
+				 read_batch->chunks[ chunk_index ].chunk_index );
+
+				goto on_error;
+			}
+		}
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The chunks that were pushed onto the unpack thread pool are still referenced by its threads
+	 */
+	libewf_read_batch_wait_for_unpacked_chunks(
+	 read_batch,
+	 NULL );
+#endif
+	return( -1 );
+}
@@ -0,0 +1,210 @@
+/*
+ * Read batch functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_READ_BATCH_H )
+#define _LIBEWF_READ_BATCH_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_io_handle.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_statistics.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The maximum number of chunks that are read and unpacked at once
+ */
+#define LIBEWF_READ_BATCH_MAXIMUM_NUMBER_OF_CHUNKS	64
+
+/* The number of threads that unpack the chunks
+ */
+#define LIBEWF_READ_BATCH_NUMBER_OF_THREADS		4
+
+typedef struct libewf_read_batch_request libewf_read_batch_request_t;
+
+struct libewf_read_batch_request
+{
+	/* The index of the request as passed by the caller
+	 */
+	int request_index;
+
+	/* The (media) offset
+	 */
+	off64_t offset;
+
+	/* The buffer
+	 */
+	uint8_t *buffer;
+
+	/* The buffer size
+	 */
+	size_t buffer_size;
+
+	/* The number of bytes read or -1 on error
+	 */
+	ssize_t read_count;
+};
+
+typedef struct libewf_read_batch_chunk libewf_read_batch_chunk_t;
+
+struct libewf_read_batch_chunk
+{
+	/* The chunk index
+	 */
+	uint64_t chunk_index;
+
+	/* The (media) data size of the chunk
+	 */
+	size_t data_size;
+
+	/* The chunk data
+	 * where NULL represents a chunk that is read by means of the chunks cache
+	 */
+	libewf_chunk_data_t *chunk_data;
+};
+
+typedef struct libewf_read_batch libewf_read_batch_t;
+
+/* The read batch reads the (media) data of multiple requests
+ * where every chunk that is referenced by the requests is read and unpacked once
+ */
+struct libewf_read_batch
+{
+	/* The IO handle
+	 */
+	libewf_io_handle_t *io_handle;
+
+	/* The media size
+	 */
+	size64_t media_size;
+
+	/* The requests
+	 */
+	libewf_read_batch_request_t *requests;
+
+	/* The requests sorted by offset
+	 */
+	libewf_read_batch_request_t **sorted_requests;
+
+	/* The number of requests
+	 */
+	int number_of_requests;
+
+	/* The index of the first sorted request that is not completely read
+	 */
+	int active_request_index;
+
+	/* The index of the sorted request of the next chunk
+	 */
+	int sorted_request_index;
+
+	/* The index of the next chunk
+	 */
+	uint64_t next_chunk_index;
+
+	/* The chunks
+	 */
+	libewf_read_batch_chunk_t chunks[ LIBEWF_READ_BATCH_MAXIMUM_NUMBER_OF_CHUNKS ];
+
+	/* The number of chunks
+	 */
+	int number_of_chunks;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The unpack thread pool
+	 * which is created on first use and used for all the chunks of the read batch
+	 */
+	libcthreads_thread_pool_t *unpack_thread_pool;
+
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that is signalled when all pushed chunks have been unpacked
+	 */
+	libcthreads_condition_t *unpacked_condition;
+
+	/* The number of chunks pushed onto the unpack thread pool that have not been unpacked
+	 */
+	int number_of_pending_chunks;
+#endif
+};
+
+int libewf_read_batch_initialize(
+     libewf_read_batch_t **read_batch,
+     libewf_io_handle_t *io_handle,
+     void * const *buffers,
+     const size_t *buffer_sizes,
+     const off64_t *offsets,
+     int number_of_requests,
+     size64_t media_size,
+     libcerror_error_t **error );
+
+int libewf_read_batch_free(
+     libewf_read_batch_t **read_batch,
+     libcerror_error_t **error );
+
+int libewf_read_batch_compare_requests(
+     const void *first_request,
+     const void *second_request );
+
+int libewf_read_batch_get_next_chunks(
+     libewf_read_batch_t *read_batch,
+     libcerror_error_t **error );
+
+int libewf_read_batch_free_chunks(
+     libewf_read_batch_t *read_batch,
+     libcerror_error_t **error );
+
+int libewf_read_batch_unpack_chunk(
+     libewf_read_batch_t *read_batch,
+     libewf_read_batch_chunk_t *chunk,
+     libewf_statistics_t *statistics,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+int libewf_read_batch_unpack_chunk_callback(
+     libewf_read_batch_chunk_t *chunk,
+     libewf_read_batch_t *read_batch );
+
+int libewf_read_batch_wait_for_unpacked_chunks(
+     libewf_read_batch_t *read_batch,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+int libewf_read_batch_unpack_chunks(
+     libewf_read_batch_t *read_batch,
+     libewf_statistics_t *statistics,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_READ_BATCH_H ) */
+
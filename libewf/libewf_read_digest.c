@@ -0,0 +1,1073 @@
+/*
+ * Read digest functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
+#include "libewf_libhmac.h"
+#include "libewf_read_digest.h"
+
+/* Creates a read digest
+ * Make sure the value read_digest is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_digest_initialize(
+     libewf_read_digest_t **read_digest,
+     uint8_t digest_types,
+     off64_t start_offset,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_digest_initialize";
+
+	if( read_digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_digest != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid read digest value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( digest_types == 0 )
+	 || ( ( digest_types & ~( LIBEWF_DIGEST_TYPE_MD5 | LIBEWF_DIGEST_TYPE_SHA1 | LIBEWF_DIGEST_TYPE_SHA256 ) ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported digest types: 0x%02" PRIx8 ".",
+		 function,
+		 digest_types );
+
+		return( -1 );
+	}
+	if( start_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid start offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	*read_digest = memory_allocate_structure(
+	                libewf_read_digest_t );
+
+	if( *read_digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read digest.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *read_digest,
+	     0,
+	     sizeof( libewf_read_digest_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear read digest.",
+		 function );
+
+		memory_free(
+		 *read_digest );
+
+		*read_digest = NULL;
+
+		return( -1 );
+	}
+	if( ( digest_types & LIBEWF_DIGEST_TYPE_MD5 ) != 0 )
+	{
+		if( libhmac_md5_initialize(
+		     &( ( *read_digest )->md5_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize MD5 context.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( ( digest_types & LIBEWF_DIGEST_TYPE_SHA1 ) != 0 )
+	{
+		if( libhmac_sha1_initialize(
+		     &( ( *read_digest )->sha1_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize SHA1 context.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( ( digest_types & LIBEWF_DIGEST_TYPE_SHA256 ) != 0 )
+	{
+		if( libhmac_sha256_initialize(
+		     &( ( *read_digest )->sha256_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize SHA256 context.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	( *read_digest )->digest_types   = digest_types;
+	( *read_digest )->start_offset   = start_offset;
+	( *read_digest )->current_offset = start_offset;
+
+	return( 1 );
+
+on_error:
+	if( *read_digest != NULL )
+	{
+		libewf_read_digest_free(
+		 read_digest,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a read digest
+ * The digest thread must have been stopped before
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_digest_free(
+     libewf_read_digest_t **read_digest,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_digest_free";
+	int result            = 1;
+
+	if( read_digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_digest != NULL )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( *read_digest )->empty_queue != NULL )
+		{
+			if( libcthreads_queue_free(
+			     &( ( *read_digest )->empty_queue ),
+			     NULL,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free empty queue.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *read_digest )->full_queue != NULL )
+		{
+			if( libcthreads_queue_free(
+			     &( ( *read_digest )->full_queue ),
+			     NULL,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free full queue.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *read_digest )->buffers_data != NULL )
+		{
+			memory_free(
+			 ( *read_digest )->buffers_data );
+		}
+		if( ( *read_digest )->buffers != NULL )
+		{
+			memory_free(
+			 ( *read_digest )->buffers );
+		}
+#endif
+		if( ( *read_digest )->md5_context != NULL )
+		{
+			if( libhmac_md5_free(
+			     &( ( *read_digest )->md5_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free MD5 context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *read_digest )->sha1_context != NULL )
+		{
+			if( libhmac_sha1_free(
+			     &( ( *read_digest )->sha1_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free SHA1 context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *read_digest )->sha256_context != NULL )
+		{
+			if( libhmac_sha256_free(
+			     &( ( *read_digest )->sha256_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free SHA256 context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *read_digest );
+
+		*read_digest = NULL;
+	}
+	return( result );
+}
+
+/* Updates the read digest with media data
+ * Media data that is not read in order makes the digests unavailable
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_digest_update(
+     libewf_read_digest_t *read_digest,
+     off64_t offset,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_digest_update";
+
+	if( read_digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( read_digest->is_finalized != 0 )
+	 || ( read_digest->is_out_of_order != 0 )
+	 || ( buffer_size == 0 ) )
+	{
+		return( 1 );
+	}
+	if( offset != read_digest->current_offset )
+	{
+		read_digest->is_out_of_order = 1;
+
+		return( 1 );
+	}
+	if( read_digest->md5_context != NULL )
+	{
+		if( libhmac_md5_update(
+		     read_digest->md5_context,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update MD5 hash.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( read_digest->sha1_context != NULL )
+	{
+		if( libhmac_sha1_update(
+		     read_digest->sha1_context,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA1 hash.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( read_digest->sha256_context != NULL )
+	{
+		if( libhmac_sha256_update(
+		     read_digest->sha256_context,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA256 hash.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	read_digest->current_offset += (off64_t) buffer_size;
+
+	return( 1 );
+}
+
+/* Finalizes the read digest
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_digest_finalize(
+     libewf_read_digest_t *read_digest,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_digest_finalize";
+
+	if( read_digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_digest->is_finalized != 0 )
+	{
+		return( 1 );
+	}
+	if( read_digest->md5_context != NULL )
+	{
+		if( libhmac_md5_finalize(
+		     read_digest->md5_context,
+		     read_digest->md5_digest,
+		     LIBHMAC_MD5_HASH_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize MD5 hash.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( read_digest->sha1_context != NULL )
+	{
+		if( libhmac_sha1_finalize(
+		     read_digest->sha1_context,
+		     read_digest->sha1_digest,
+		     LIBHMAC_SHA1_HASH_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize SHA1 hash.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( read_digest->sha256_context != NULL )
+	{
+		if( libhmac_sha256_finalize(
+		     read_digest->sha256_context,
+		     read_digest->sha256_digest,
+		     LIBHMAC_SHA256_HASH_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize SHA256 hash.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	read_digest->is_finalized = 1;
+
+	return( 1 );
+}
+
+/* Retrieves a specific digest
+ * The read digest is finalized if necessary
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libewf_read_digest_get_digest(
+     libewf_read_digest_t *read_digest,
+     uint8_t digest_type,
+     uint8_t *digest,
+     size_t digest_size,
+     libcerror_error_t **error )
+{
+	uint8_t *read_digest_data = NULL;
+	static char *function     = "libewf_read_digest_get_digest";
+	size_t read_digest_size   = 0;
+
+	if( read_digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest.",
+		 function );
+
+		return( -1 );
+	}
+	switch( digest_type )
+	{
+		case LIBEWF_DIGEST_TYPE_MD5:
+			read_digest_data = read_digest->md5_digest;
+			read_digest_size = LIBHMAC_MD5_HASH_SIZE;
+			break;
+
+		case LIBEWF_DIGEST_TYPE_SHA1:
+			read_digest_data = read_digest->sha1_digest;
+			read_digest_size = LIBHMAC_SHA1_HASH_SIZE;
+			break;
+
+		case LIBEWF_DIGEST_TYPE_SHA256:
+			read_digest_data = read_digest->sha256_digest;
+			read_digest_size = LIBHMAC_SHA256_HASH_SIZE;
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported digest type: 0x%02" PRIx8 ".",
+			 function,
+			 digest_type );
+
+			return( -1 );
+	}
+	if( digest_size < read_digest_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: digest too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( read_digest->digest_types & digest_type ) == 0 )
+	 || ( read_digest->is_out_of_order != 0 ) )
+	{
+		return( 0 );
+	}
+	if( libewf_read_digest_finalize(
+	     read_digest,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize read digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     digest,
+	     read_digest_data,
+	     read_digest_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy digest.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Starts the digest thread
+ * The media data is passed to the digest thread in buffers, so that it is
+ * digested while the next media data is read and decoded
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_digest_start_thread(
+     libewf_read_digest_t *read_digest,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_digest_start_thread";
+	int buffer_index      = 0;
+
+	if( read_digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_digest->thread != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid read digest - thread value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_digest->buffers == NULL )
+	{
+		read_digest->buffers = (libewf_read_digest_buffer_t *) memory_allocate(
+		                                                        sizeof( libewf_read_digest_buffer_t ) * LIBEWF_READ_DIGEST_NUMBER_OF_BUFFERS );
+
+		if( read_digest->buffers == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create buffers.",
+			 function );
+
+			goto on_error;
+		}
+		read_digest->buffers_data = (uint8_t *) memory_allocate(
+		                                         sizeof( uint8_t ) * LIBEWF_READ_DIGEST_BUFFER_SIZE * LIBEWF_READ_DIGEST_NUMBER_OF_BUFFERS );
+
+		if( read_digest->buffers_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create buffers data.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcthreads_queue_initialize(
+		     &( read_digest->empty_queue ),
+		     LIBEWF_READ_DIGEST_NUMBER_OF_BUFFERS,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create empty queue.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcthreads_queue_initialize(
+		     &( read_digest->full_queue ),
+		     LIBEWF_READ_DIGEST_NUMBER_OF_BUFFERS,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create full queue.",
+			 function );
+
+			goto on_error;
+		}
+		for( buffer_index = 0;
+		     buffer_index < LIBEWF_READ_DIGEST_NUMBER_OF_BUFFERS;
+		     buffer_index++ )
+		{
+			read_digest->buffers[ buffer_index ].data      = &( read_digest->buffers_data[ buffer_index * LIBEWF_READ_DIGEST_BUFFER_SIZE ] );
+			read_digest->buffers[ buffer_index ].data_size = 0;
+
+			if( libcthreads_queue_push(
+			     read_digest->empty_queue,
+			     (intptr_t *) &( read_digest->buffers[ buffer_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push buffer: %d onto empty queue.",
+				 function,
+				 buffer_index );
+
+				goto on_error;
+			}
+		}
+	}
+	read_digest->has_failed = 0;
+
+	if( libcthreads_thread_create(
+	     &( read_digest->thread ),
+	     NULL,
+	     (int (*)(void *)) &libewf_read_digest_thread_callback,
+	     (void *) read_digest,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create digest thread.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( read_digest->full_queue != NULL )
+	{
+		libcthreads_queue_free(
+		 &( read_digest->full_queue ),
+		 NULL,
+		 NULL );
+	}
+	if( read_digest->empty_queue != NULL )
+	{
+		libcthreads_queue_free(
+		 &( read_digest->empty_queue ),
+		 NULL,
+		 NULL );
+	}
+	if( read_digest->buffers_data != NULL )
+	{
+		memory_free(
+		 read_digest->buffers_data );
+
+		read_digest->buffers_data = NULL;
+	}
+	if( read_digest->buffers != NULL )
+	{
+		memory_free(
+		 read_digest->buffers );
+
+		read_digest->buffers = NULL;
+	}
+	return( -1 );
+}
+
+/* Grabs a buffer to read media data into
+ * Blocks until the digest thread has released a buffer
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_digest_grab_buffer(
+     libewf_read_digest_t *read_digest,
+     libewf_read_digest_buffer_t **buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_digest_grab_buffer";
+
+	if( read_digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_queue_pop(
+	     read_digest->empty_queue,
+	     (intptr_t **) buffer,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+		 "%s: unable to pop buffer from empty queue.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Pushes a buffer with media data onto the queue of the digest thread
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_digest_push_buffer(
+     libewf_read_digest_t *read_digest,
+     libewf_read_digest_buffer_t *buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_digest_push_buffer";
+
+	if( read_digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_queue_push(
+	     read_digest->full_queue,
+	     (intptr_t *) buffer,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push buffer onto full queue.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Stops the digest thread
+ * Waits until the digest thread has digested all the buffers pushed before
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_digest_stop_thread(
+     libewf_read_digest_t *read_digest,
+     libcerror_error_t **error )
+{
+	libewf_read_digest_buffer_t *buffer = NULL;
+	static char *function               = "libewf_read_digest_stop_thread";
+	int result                          = 1;
+
+	if( read_digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_digest->thread == NULL )
+	{
+		return( 1 );
+	}
+	/* A buffer without data signals the digest thread to stop
+	 */
+	if( libewf_read_digest_grab_buffer(
+	     read_digest,
+	     &buffer,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to grab buffer.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		buffer->data_size = 0;
+
+		if( libewf_read_digest_push_buffer(
+		     read_digest,
+		     buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push buffer.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libcthreads_thread_join(
+	     &( read_digest->thread ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to join digest thread.",
+		 function );
+
+		result = -1;
+	}
+	if( ( result == 1 )
+	 && ( read_digest->has_failed != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to digest media data.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+/* Digests the buffers on the full queue until the stop buffer is popped
+ * The buffers are released onto the empty queue, also after a failure,
+ * so that the reading thread is never blocked
+ * Callback function for the digest thread
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_digest_thread_callback(
+     libewf_read_digest_t *read_digest )
+{
+	libcerror_error_t *error            = NULL;
+	libewf_read_digest_buffer_t *buffer = NULL;
+	static char *function               = "libewf_read_digest_thread_callback";
+	size_t data_size                    = 0;
+
+	if( read_digest == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read digest.",
+		 function );
+
+		goto on_error;
+	}
+	do
+	{
+		if( libcthreads_queue_pop(
+		     read_digest->full_queue,
+		     (intptr_t **) &buffer,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to pop buffer from full queue.",
+			 function );
+
+			goto on_error;
+		}
+		data_size = buffer->data_size;
+
+		if( ( data_size > 0 )
+		 && ( read_digest->has_failed == 0 ) )
+		{
+			if( libewf_read_digest_update(
+			     read_digest,
+			     read_digest->current_offset,
+			     buffer->data,
+			     data_size,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update read digest.",
+				 function );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_print_error_backtrace(
+					 error );
+				}
+#endif
+				libcerror_error_free(
+				 &error );
+
+				read_digest->has_failed = 1;
+			}
+		}
+		if( libcthreads_queue_push(
+		     read_digest->empty_queue,
+		     (intptr_t *) buffer,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push buffer onto empty queue.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	while( data_size > 0 );
+
+	return( 1 );
+
+on_error:
+	if( read_digest != NULL )
+	{
+		read_digest->has_failed = 1;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+	}
+#endif
+	libcerror_error_free(
+	 &error );
+
+	return( -1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,194 @@
+/*
+ * Read digest functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_READ_DIGEST_H )
+#define _LIBEWF_READ_DIGEST_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_libhmac.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The size of a buffer that is passed to the digest thread
+ */
+#define LIBEWF_READ_DIGEST_BUFFER_SIZE			( 1024 * 1024 )
+
+/* The number of buffers that are passed between the reading and the digest thread
+ */
+#define LIBEWF_READ_DIGEST_NUMBER_OF_BUFFERS		4
+
+typedef struct libewf_read_digest_buffer libewf_read_digest_buffer_t;
+
+struct libewf_read_digest_buffer
+{
+	/* The data
+	 */
+	uint8_t *data;
+
+	/* The data size
+	 * where 0 signals the digest thread to stop
+	 */
+	size_t data_size;
+};
+
+typedef struct libewf_read_digest libewf_read_digest_t;
+
+/* The read digest calculates digests over the media data while it is read
+ * The media data must be read in order, otherwise the digests are unavailable
+ */
+struct libewf_read_digest
+{
+	/* The digest types
+	 */
+	uint8_t digest_types;
+
+	/* The offset of the media data at which the digests started
+	 */
+	off64_t start_offset;
+
+	/* The offset of the media data that is expected to be read next
+	 */
+	off64_t current_offset;
+
+	/* Value to indicate the media data was not read in order
+	 */
+	uint8_t is_out_of_order;
+
+	/* Value to indicate the digests were finalized
+	 */
+	uint8_t is_finalized;
+
+	/* The MD5 context
+	 */
+	libhmac_md5_context_t *md5_context;
+
+	/* The SHA1 context
+	 */
+	libhmac_sha1_context_t *sha1_context;
+
+	/* The SHA256 context
+	 */
+	libhmac_sha256_context_t *sha256_context;
+
+	/* The MD5 digest
+	 */
+	uint8_t md5_digest[ LIBHMAC_MD5_HASH_SIZE ];
+
+	/* The SHA1 digest
+	 */
+	uint8_t sha1_digest[ LIBHMAC_SHA1_HASH_SIZE ];
+
+	/* The SHA256 digest
+	 */
+	uint8_t sha256_digest[ LIBHMAC_SHA256_HASH_SIZE ];
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The digest thread
+	 */
+	libcthreads_thread_t *thread;
+
+	/* The buffers
+	 */
+	libewf_read_digest_buffer_t *buffers;
+
+	/* The buffers data
+	 */
+	uint8_t *buffers_data;
+
+	/* The queue of buffers that are available to be read into
+	 */
+	libcthreads_queue_t *empty_queue;
+
+	/* The queue of buffers that contain media data to be digested
+	 */
+	libcthreads_queue_t *full_queue;
+
+	/* Value to indicate the digest thread failed
+	 */
+	int has_failed;
+#endif
+};
+
+int libewf_read_digest_initialize(
+     libewf_read_digest_t **read_digest,
+     uint8_t digest_types,
+     off64_t start_offset,
+     libcerror_error_t **error );
+
+int libewf_read_digest_free(
+     libewf_read_digest_t **read_digest,
+     libcerror_error_t **error );
+
+int libewf_read_digest_update(
+     libewf_read_digest_t *read_digest,
+     off64_t offset,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int libewf_read_digest_finalize(
+     libewf_read_digest_t *read_digest,
+     libcerror_error_t **error );
+
+int libewf_read_digest_get_digest(
+     libewf_read_digest_t *read_digest,
+     uint8_t digest_type,
+     uint8_t *digest,
+     size_t digest_size,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+int libewf_read_digest_start_thread(
+     libewf_read_digest_t *read_digest,
+     libcerror_error_t **error );
+
+int libewf_read_digest_grab_buffer(
+     libewf_read_digest_t *read_digest,
+     libewf_read_digest_buffer_t **buffer,
+     libcerror_error_t **error );
+
+int libewf_read_digest_push_buffer(
+     libewf_read_digest_t *read_digest,
+     libewf_read_digest_buffer_t *buffer,
+     libcerror_error_t **error );
+
+int libewf_read_digest_stop_thread(
+     libewf_read_digest_t *read_digest,
+     libcerror_error_t **error );
+
+int libewf_read_digest_thread_callback(
+     libewf_read_digest_t *read_digest );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_READ_DIGEST_H ) */
+
@@ -141,6 +141,11 @@ int libewf_read_io_handle_free(
 			memory_free(
 			 ( *read_io_handle )->device_information );
 		}
+		if( ( *read_io_handle )->compressed_data != NULL )
+		{
+			memory_free(
+			 ( *read_io_handle )->compressed_data );
+		}
 		memory_free(
 		 *read_io_handle );
 
@@ -65,6 +65,14 @@ struct libewf_read_io_handle
         /* The (total) number of chunks read
          */
         uint64_t number_of_chunks_read;
+
+	/* The compressed data buffer, used to read chunks directly into the buffer of a read
+	 */
+	uint8_t *compressed_data;
+
+	/* The size of the compressed data buffer
+	 */
+	size_t compressed_data_size;
 };
 
 int libewf_read_io_handle_initialize(
@@ -0,0 +1,1277 @@
+/*
+ * Read scheduler functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
+#include "libewf_read_scheduler.h"
+#include "libewf_types.h"
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Creates a read scheduler
+ * Make sure the value read_scheduler is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_scheduler_initialize(
+     libewf_read_scheduler_t **read_scheduler,
+     size32_t chunk_size,
+     size64_t media_size,
+     int number_of_threads,
+     ssize_t (*read_chunk)(
+                intptr_t *data_handle,
+                uint64_t chunk_index,
+                uint8_t *chunk_buffer,
+                size_t chunk_buffer_size,
+                libcerror_error_t **error ),
+     intptr_t *data_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_scheduler_initialize";
+
+	if( read_scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read scheduler.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_scheduler != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid read scheduler value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if SIZEOF_SIZE_T <= 4
+	if( ( chunk_size == 0 )
+	 || ( (size_t) chunk_size > (size_t) SSIZE_MAX ) )
+#else
+	if( chunk_size == 0 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_threads <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of threads value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read chunk function.",
+		 function );
+
+		return( -1 );
+	}
+	*read_scheduler = memory_allocate_structure(
+	                   libewf_read_scheduler_t );
+
+	if( *read_scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read scheduler.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *read_scheduler,
+	     0,
+	     sizeof( libewf_read_scheduler_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear read scheduler.",
+		 function );
+
+		memory_free(
+		 *read_scheduler );
+
+		*read_scheduler = NULL;
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *read_scheduler )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *read_scheduler )->completed_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize completed condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_thread_pool_create(
+	     &( ( *read_scheduler )->thread_pool ),
+	     NULL,
+	     number_of_threads,
+	     LIBEWF_READ_SCHEDULER_MAXIMUM_NUMBER_OF_JOBS,
+	     (int (*)(intptr_t *, void *)) &libewf_read_scheduler_process_job_callback,
+	     (void *) *read_scheduler,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	( *read_scheduler )->chunk_size  = chunk_size;
+	( *read_scheduler )->media_size  = media_size;
+	( *read_scheduler )->read_chunk  = read_chunk;
+	( *read_scheduler )->data_handle = data_handle;
+
+	return( 1 );
+
+on_error:
+	if( *read_scheduler != NULL )
+	{
+		if( ( *read_scheduler )->completed_condition != NULL )
+		{
+			libcthreads_condition_free(
+			 &( ( *read_scheduler )->completed_condition ),
+			 NULL );
+		}
+		if( ( *read_scheduler )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *read_scheduler )->mutex ),
+			 NULL );
+		}
+		memory_free(
+		 *read_scheduler );
+
+		*read_scheduler = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a read scheduler
+ * Waits for the pending requests to complete and the users to release the read scheduler before the threads are stopped
+ * The read scheduler cannot be freed from the callback function of a request since the threads cannot be joined from one of the threads
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_scheduler_free(
+     libewf_read_scheduler_t **read_scheduler,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_scheduler_free";
+	int result            = 1;
+
+	if( read_scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read scheduler.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_scheduler != NULL )
+	{
+		if( libcthreads_mutex_grab(
+		     ( *read_scheduler )->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			return( -1 );
+		}
+		while( ( ( *read_scheduler )->number_of_pending_requests > 0 )
+		    || ( ( *read_scheduler )->number_of_users > 0 ) )
+		{
+			if( libcthreads_condition_wait(
+			     ( *read_scheduler )->completed_condition,
+			     ( *read_scheduler )->mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to wait for completed condition.",
+				 function );
+
+				libcthreads_mutex_release(
+				 ( *read_scheduler )->mutex,
+				 NULL );
+
+				return( -1 );
+			}
+		}
+		if( libcthreads_mutex_release(
+		     ( *read_scheduler )->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( *read_scheduler )->thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *read_scheduler )->thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libcthreads_condition_free(
+		     &( ( *read_scheduler )->completed_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free completed condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *read_scheduler )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *read_scheduler );
+
+		*read_scheduler = NULL;
+	}
+	return( result );
+}
+
+/* Grabs a reference to the read scheduler
+ * The read scheduler is not freed until the reference is released
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_scheduler_grab(
+     libewf_read_scheduler_t *read_scheduler,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_scheduler_grab";
+
+	if( read_scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read scheduler.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     read_scheduler->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	read_scheduler->number_of_users += 1;
+
+	if( libcthreads_mutex_release(
+	     read_scheduler->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Releases a reference to the read scheduler
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_scheduler_release(
+     libewf_read_scheduler_t *read_scheduler,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_scheduler_release";
+
+	if( read_scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read scheduler.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     read_scheduler->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_scheduler->number_of_users <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid read scheduler - number of users value out of bounds.",
+		 function );
+
+		libcthreads_mutex_release(
+		 read_scheduler->mutex,
+		 NULL );
+
+		return( -1 );
+	}
+	read_scheduler->number_of_users -= 1;
+
+	if( read_scheduler->number_of_users == 0 )
+	{
+		if( libcthreads_condition_broadcast(
+		     read_scheduler->completed_condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast completed condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 read_scheduler->mutex,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	if( libcthreads_mutex_release(
+	     read_scheduler->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Submits an asynchronous read of (media) data
+ * The read is split into the chunks it references, a chunk that is already queued or
+ * being read for another request is shared instead of queued again
+ * The callback function is called from one of the threads of the scheduler when the read has completed,
+ * or directly if there is no data to read
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_scheduler_submit(
+     libewf_read_scheduler_t *read_scheduler,
+     libewf_handle_t *handle,
+     uint8_t *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     void (*callback)(
+            libewf_handle_t *handle,
+            void *buffer,
+            ssize_t read_count,
+            void *callback_data ),
+     void *callback_data,
+     libcerror_error_t **error )
+{
+	libewf_read_scheduler_job_t **new_jobs  = NULL;
+	libewf_read_scheduler_job_t *job        = NULL;
+	libewf_read_scheduler_request_t *request = NULL;
+	libewf_read_scheduler_waiter_t *waiter  = NULL;
+	static char *function                   = "libewf_read_scheduler_submit";
+	size64_t chunk_offset                   = 0;
+	uint64_t chunk_index                    = 0;
+	uint64_t first_chunk_index              = 0;
+	uint64_t number_of_chunks               = 0;
+	uint64_t waiter_index                   = 0;
+	int number_of_new_jobs                  = 0;
+	int job_index                           = 0;
+
+	if( read_scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read scheduler.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( callback == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callback function.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) offset >= read_scheduler->media_size )
+	{
+		buffer_size = 0;
+	}
+	else if( (size64_t) buffer_size > ( read_scheduler->media_size - (size64_t) offset ) )
+	{
+		buffer_size = (size_t) ( read_scheduler->media_size - (size64_t) offset );
+	}
+	if( buffer_size == 0 )
+	{
+		callback(
+		 handle,
+		 (void *) buffer,
+		 0,
+		 callback_data );
+
+		return( 1 );
+	}
+	first_chunk_index = (uint64_t) offset / read_scheduler->chunk_size;
+	number_of_chunks  = ( ( (uint64_t) offset + buffer_size - 1 ) / read_scheduler->chunk_size ) - first_chunk_index + 1;
+
+	/* All the memory needed is allocated before the request is added to the jobs,
+	 * so that a request is either added completely or not at all
+	 */
+	request = memory_allocate_structure(
+	           libewf_read_scheduler_request_t );
+
+	if( request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create request.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     request,
+	     0,
+	     sizeof( libewf_read_scheduler_request_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear request.",
+		 function );
+
+		memory_free(
+		 request );
+
+		return( -1 );
+	}
+	request->waiters = (libewf_read_scheduler_waiter_t *) memory_allocate(
+	                                                       sizeof( libewf_read_scheduler_waiter_t ) * (size_t) number_of_chunks );
+
+	if( request->waiters == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create waiters.",
+		 function );
+
+		goto on_error;
+	}
+	new_jobs = (libewf_read_scheduler_job_t **) memory_allocate(
+	                                             sizeof( libewf_read_scheduler_job_t * ) * (size_t) number_of_chunks );
+
+	if( new_jobs == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create new jobs.",
+		 function );
+
+		goto on_error;
+	}
+	for( waiter_index = 0;
+	     waiter_index < number_of_chunks;
+	     waiter_index++ )
+	{
+		new_jobs[ waiter_index ] = memory_allocate_structure(
+		                            libewf_read_scheduler_job_t );
+
+		if( new_jobs[ waiter_index ] == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create job.",
+			 function );
+
+			goto on_error;
+		}
+		number_of_new_jobs++;
+	}
+	request->handle                   = handle;
+	request->offset                   = offset;
+	request->buffer                   = buffer;
+	request->buffer_size              = buffer_size;
+	request->number_of_pending_chunks = number_of_chunks;
+	request->callback                 = callback;
+	request->callback_data            = callback_data;
+
+	if( libcthreads_mutex_grab(
+	     read_scheduler->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	number_of_new_jobs = 0;
+
+	for( waiter_index = 0;
+	     waiter_index < number_of_chunks;
+	     waiter_index++ )
+	{
+		chunk_index  = first_chunk_index + waiter_index;
+		chunk_offset = chunk_index * read_scheduler->chunk_size;
+
+		waiter = &( request->waiters[ waiter_index ] );
+
+		waiter->request = request;
+		waiter->offset  = (off64_t) chunk_offset;
+		waiter->size    = (size_t) read_scheduler->chunk_size;
+
+		if( waiter->offset < offset )
+		{
+			waiter->size  -= (size_t) ( offset - waiter->offset );
+			waiter->offset = offset;
+		}
+		if( (size64_t) ( waiter->offset + waiter->size ) > (size64_t) ( offset + buffer_size ) )
+		{
+			waiter->size = (size_t) ( offset + buffer_size - waiter->offset );
+		}
+		for( job = read_scheduler->jobs;
+		     job != NULL;
+		     job = job->next_job )
+		{
+			if( job->chunk_index == chunk_index )
+			{
+				break;
+			}
+		}
+		if( job == NULL )
+		{
+			job = new_jobs[ number_of_new_jobs++ ];
+
+			job->chunk_index = chunk_index;
+			job->waiters     = NULL;
+			job->next_job    = read_scheduler->jobs;
+
+			read_scheduler->jobs = job;
+		}
+		waiter->next_waiter = job->waiters;
+		job->waiters        = waiter;
+	}
+	read_scheduler->number_of_pending_requests += 1;
+
+	if( libcthreads_mutex_release(
+	     read_scheduler->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	/* The request is owned by the jobs from here on
+	 */
+	for( job_index = 0;
+	     job_index < number_of_new_jobs;
+	     job_index++ )
+	{
+		if( libcthreads_thread_pool_push(
+		     read_scheduler->thread_pool,
+		     (intptr_t *) new_jobs[ job_index ],
+		     error ) == -1 )
+		{
+#if defined( HAVE_VERBOSE_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				if( ( error != NULL )
+				 && ( *error != NULL ) )
+				{
+					libcnotify_print_error_backtrace(
+					 *error );
+				}
+			}
+#endif
+			libcerror_error_free(
+			 error );
+
+			/* A job that cannot be queued is processed by the calling thread
+			 */
+			if( libewf_read_scheduler_process_job(
+			     read_scheduler,
+			     new_jobs[ job_index ],
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to process job.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	while( job_index < (int) number_of_chunks )
+	{
+		memory_free(
+		 new_jobs[ job_index++ ] );
+	}
+	memory_free(
+	 new_jobs );
+
+	return( 1 );
+
+on_error:
+	if( new_jobs != NULL )
+	{
+		for( job_index = 0;
+		     job_index < number_of_new_jobs;
+		     job_index++ )
+		{
+			memory_free(
+			 new_jobs[ job_index ] );
+		}
+		memory_free(
+		 new_jobs );
+	}
+	if( request != NULL )
+	{
+		if( request->waiters != NULL )
+		{
+			memory_free(
+			 request->waiters );
+		}
+		memory_free(
+		 request );
+	}
+	return( -1 );
+}
+
+/* Completes a request
+ * Calls the callback function and frees the request
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_scheduler_complete_request(
+     libewf_read_scheduler_t *read_scheduler,
+     libewf_read_scheduler_request_t *request,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_scheduler_complete_request";
+	ssize_t read_count    = 0;
+
+	if( read_scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read scheduler.",
+		 function );
+
+		return( -1 );
+	}
+	if( request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid request.",
+		 function );
+
+		return( -1 );
+	}
+	if( request->has_failed != 0 )
+	{
+		read_count = -1;
+	}
+	else
+	{
+		read_count = (ssize_t) request->buffer_size;
+	}
+	request->callback(
+	 request->handle,
+	 (void *) request->buffer,
+	 read_count,
+	 request->callback_data );
+
+	memory_free(
+	 request->waiters );
+
+	memory_free(
+	 request );
+
+	if( libcthreads_mutex_grab(
+	     read_scheduler->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	read_scheduler->number_of_pending_requests -= 1;
+
+	if( read_scheduler->number_of_pending_requests == 0 )
+	{
+		if( libcthreads_condition_broadcast(
+		     read_scheduler->completed_condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast completed condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 read_scheduler->mutex,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	if( libcthreads_mutex_release(
+	     read_scheduler->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Processes a job
+ * Reads the chunk once and copies its data to all the requests waiting for it
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_scheduler_process_job(
+     libewf_read_scheduler_t *read_scheduler,
+     libewf_read_scheduler_job_t *job,
+     libcerror_error_t **error )
+{
+	libewf_read_scheduler_job_t *previous_job    = NULL;
+	libewf_read_scheduler_request_t *request     = NULL;
+	libewf_read_scheduler_waiter_t *next_waiter  = NULL;
+	libewf_read_scheduler_waiter_t *waiter       = NULL;
+	uint8_t *chunk_buffer                        = NULL;
+	static char *function                        = "libewf_read_scheduler_process_job";
+	size_t waiter_offset                         = 0;
+	ssize_t read_count                           = -1;
+	off64_t chunk_offset                         = 0;
+	int is_completed                             = 0;
+	int result                                   = 1;
+
+	if( read_scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read scheduler.",
+		 function );
+
+		return( -1 );
+	}
+	if( job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid job.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_offset = (off64_t) ( job->chunk_index * read_scheduler->chunk_size );
+
+	chunk_buffer = (uint8_t *) memory_allocate(
+	                            sizeof( uint8_t ) * read_scheduler->chunk_size );
+
+	/* A chunk that cannot be read makes the requests waiting for it fail
+	 */
+	if( chunk_buffer != NULL )
+	{
+		read_count = read_scheduler->read_chunk(
+		              read_scheduler->data_handle,
+		              job->chunk_index,
+		              chunk_buffer,
+		              (size_t) read_scheduler->chunk_size,
+		              error );
+
+		if( read_count == -1 )
+		{
+#if defined( HAVE_VERBOSE_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				if( ( error != NULL )
+				 && ( *error != NULL ) )
+				{
+					libcnotify_print_error_backtrace(
+					 *error );
+				}
+			}
+#endif
+			libcerror_error_free(
+			 error );
+		}
+	}
+	/* Once the job is removed no more requests are added to it
+	 */
+	if( libcthreads_mutex_grab(
+	     read_scheduler->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( read_scheduler->jobs == job )
+	{
+		read_scheduler->jobs = job->next_job;
+	}
+	else
+	{
+		for( previous_job = read_scheduler->jobs;
+		     previous_job != NULL;
+		     previous_job = previous_job->next_job )
+		{
+			if( previous_job->next_job == job )
+			{
+				previous_job->next_job = job->next_job;
+
+				break;
+			}
+		}
+	}
+	waiter = job->waiters;
+
+	if( libcthreads_mutex_release(
+	     read_scheduler->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	while( waiter != NULL )
+	{
+		/* The waiter is freed together with its request
+		 */
+		next_waiter = waiter->next_waiter;
+		request     = waiter->request;
+
+		waiter_offset = (size_t) ( waiter->offset - chunk_offset );
+
+		if( ( read_count >= 0 )
+		 && ( ( waiter_offset + waiter->size ) <= (size_t) read_count ) )
+		{
+			if( memory_copy(
+			     &( ( request->buffer )[ waiter->offset - request->offset ] ),
+			     &( chunk_buffer[ waiter_offset ] ),
+			     waiter->size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy chunk: %" PRIu64 " data to buffer.",
+				 function,
+				 job->chunk_index );
+
+				goto on_error;
+			}
+		}
+		if( libcthreads_mutex_grab(
+		     read_scheduler->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			goto on_error;
+		}
+		if( ( read_count < 0 )
+		 || ( ( waiter_offset + waiter->size ) > (size_t) read_count ) )
+		{
+			request->has_failed = 1;
+		}
+		request->number_of_pending_chunks -= 1;
+
+		is_completed = (int) ( request->number_of_pending_chunks == 0 );
+
+		if( libcthreads_mutex_release(
+		     read_scheduler->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			goto on_error;
+		}
+		if( is_completed != 0 )
+		{
+			if( libewf_read_scheduler_complete_request(
+			     read_scheduler,
+			     request,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to complete request.",
+				 function );
+
+				result = -1;
+			}
+		}
+		waiter = next_waiter;
+	}
+	if( chunk_buffer != NULL )
+	{
+		memory_free(
+		 chunk_buffer );
+	}
+	memory_free(
+	 job );
+
+	return( result );
+
+on_error:
+	if( chunk_buffer != NULL )
+	{
+		memory_free(
+		 chunk_buffer );
+	}
+	return( -1 );
+}
+
+/* Callback function to process a job
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_scheduler_process_job_callback(
+     libewf_read_scheduler_job_t *job,
+     libewf_read_scheduler_t *read_scheduler )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "libewf_read_scheduler_process_job_callback";
+
+	if( libewf_read_scheduler_process_job(
+	     read_scheduler,
+	     job,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to process job.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_VERBOSE_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+	}
+#endif
+	libcerror_error_free(
+	 &error );
+
+	return( -1 );
+}
+
+/* Waits until all pending requests have completed
+ * The read scheduler cannot be waited for from the callback function of a request since the request has not completed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_scheduler_wait(
+     libewf_read_scheduler_t *read_scheduler,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_scheduler_wait";
+
+	if( read_scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read scheduler.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     read_scheduler->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( read_scheduler->number_of_pending_requests > 0 )
+	{
+		if( libcthreads_condition_wait(
+		     read_scheduler->completed_condition,
+		     read_scheduler->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to wait for completed condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 read_scheduler->mutex,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	if( libcthreads_mutex_release(
+	     read_scheduler->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
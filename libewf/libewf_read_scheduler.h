@@ -0,0 +1,251 @@
+/*
+ * Read scheduler functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_READ_SCHEDULER_H )
+#define _LIBEWF_READ_SCHEDULER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* The number of threads that read and unpack the chunks
+ */
+#define LIBEWF_READ_SCHEDULER_NUMBER_OF_THREADS		4
+
+/* The maximum number of chunks that are queued to be read
+ */
+#define LIBEWF_READ_SCHEDULER_MAXIMUM_NUMBER_OF_JOBS	256
+
+typedef struct libewf_read_scheduler_request libewf_read_scheduler_request_t;
+typedef struct libewf_read_scheduler_waiter libewf_read_scheduler_waiter_t;
+typedef struct libewf_read_scheduler_job libewf_read_scheduler_job_t;
+
+/* The request of a single asynchronous read
+ */
+struct libewf_read_scheduler_request
+{
+	/* The handle that is passed to the callback function
+	 */
+	libewf_handle_t *handle;
+
+	/* The (media) offset
+	 */
+	off64_t offset;
+
+	/* The buffer
+	 */
+	uint8_t *buffer;
+
+	/* The buffer size
+	 */
+	size_t buffer_size;
+
+	/* Value to indicate the read failed
+	 */
+	uint8_t has_failed;
+
+	/* The number of chunks that still need to be read
+	 */
+	uint64_t number_of_pending_chunks;
+
+	/* The waiters, one per chunk
+	 */
+	libewf_read_scheduler_waiter_t *waiters;
+
+	/* The callback function
+	 */
+	void (*callback)(
+	       libewf_handle_t *handle,
+	       void *buffer,
+	       ssize_t read_count,
+	       void *callback_data );
+
+	/* The callback data
+	 */
+	void *callback_data;
+};
+
+/* The part of a request that is waiting for a chunk
+ */
+struct libewf_read_scheduler_waiter
+{
+	/* The request
+	 */
+	libewf_read_scheduler_request_t *request;
+
+	/* The (media) offset
+	 */
+	off64_t offset;
+
+	/* The size
+	 */
+	size_t size;
+
+	/* The next waiter of the same chunk
+	 */
+	libewf_read_scheduler_waiter_t *next_waiter;
+};
+
+/* The read of a chunk that is shared by all requests waiting for the chunk
+ */
+struct libewf_read_scheduler_job
+{
+	/* The chunk index
+	 */
+	uint64_t chunk_index;
+
+	/* The waiters
+	 */
+	libewf_read_scheduler_waiter_t *waiters;
+
+	/* The next job
+	 */
+	libewf_read_scheduler_job_t *next_job;
+};
+
+typedef struct libewf_read_scheduler libewf_read_scheduler_t;
+
+/* The read scheduler reads the (media) data of asynchronous reads
+ * Concurrent reads of the same chunk are combined into a single job, so that the chunk is read and unpacked once
+ */
+struct libewf_read_scheduler
+{
+	/* The chunk size
+	 */
+	size32_t chunk_size;
+
+	/* The media size
+	 */
+	size64_t media_size;
+
+	/* The data handle that is passed to the read chunk function
+	 */
+	intptr_t *data_handle;
+
+	/* The read chunk function
+	 */
+	ssize_t (*read_chunk)(
+	           intptr_t *data_handle,
+	           uint64_t chunk_index,
+	           uint8_t *chunk_buffer,
+	           size_t chunk_buffer_size,
+	           libcerror_error_t **error );
+
+	/* The jobs that are queued or being read
+	 */
+	libewf_read_scheduler_job_t *jobs;
+
+	/* The number of requests that have not completed
+	 */
+	int number_of_pending_requests;
+
+	/* The number of users that hold a reference to the read scheduler
+	 */
+	int number_of_users;
+
+	/* The thread pool
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that is signalled when all requests have completed
+	 */
+	libcthreads_condition_t *completed_condition;
+};
+
+int libewf_read_scheduler_initialize(
+     libewf_read_scheduler_t **read_scheduler,
+     size32_t chunk_size,
+     size64_t media_size,
+     int number_of_threads,
+     ssize_t (*read_chunk)(
+                intptr_t *data_handle,
+                uint64_t chunk_index,
+                uint8_t *chunk_buffer,
+                size_t chunk_buffer_size,
+                libcerror_error_t **error ),
+     intptr_t *data_handle,
+     libcerror_error_t **error );
+
+int libewf_read_scheduler_free(
+     libewf_read_scheduler_t **read_scheduler,
+     libcerror_error_t **error );
+
+int libewf_read_scheduler_grab(
+     libewf_read_scheduler_t *read_scheduler,
+     libcerror_error_t **error );
+
+int libewf_read_scheduler_release(
+     libewf_read_scheduler_t *read_scheduler,
+     libcerror_error_t **error );
+
+int libewf_read_scheduler_submit(
+     libewf_read_scheduler_t *read_scheduler,
+     libewf_handle_t *handle,
+     uint8_t *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     void (*callback)(
+            libewf_handle_t *handle,
+            void *buffer,
+            ssize_t read_count,
+            void *callback_data ),
+     void *callback_data,
+     libcerror_error_t **error );
+
+int libewf_read_scheduler_complete_request(
+     libewf_read_scheduler_t *read_scheduler,
+     libewf_read_scheduler_request_t *request,
+     libcerror_error_t **error );
+
+int libewf_read_scheduler_process_job(
+     libewf_read_scheduler_t *read_scheduler,
+     libewf_read_scheduler_job_t *job,
+     libcerror_error_t **error );
+
+int libewf_read_scheduler_process_job_callback(
+     libewf_read_scheduler_job_t *job,
+     libewf_read_scheduler_t *read_scheduler );
+
+int libewf_read_scheduler_wait(
+     libewf_read_scheduler_t *read_scheduler,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_READ_SCHEDULER_H ) */
+
@@ -30,6 +30,7 @@
 #include "libewf_debug.h"
 #include "libewf_definitions.h"
 #include "libewf_hash_sections.h"
+#include "libewf_hash_tree.h"
 #include "libewf_header_values.h"
 #include "libewf_header_sections.h"
 #include "libewf_io_handle.h"
@@ -39,6 +40,7 @@
 #include "libewf_libcnotify.h"
 #include "libewf_libhmac.h"
 #include "libewf_media_values.h"
+#include "libewf_open_handles_budget.h"
 #include "libewf_section.h"
 #include "libewf_sector_range.h"
 #include "libewf_single_files.h"
@@ -509,6 +511,21 @@ ssize_t libewf_section_descriptor_read(
 		 file_offset );
 	}
 #endif
+	if( libewf_open_handles_access_file_io_pool_entry(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to account access of file IO pool entry: %d in open handles budget.",
+		 function,
+		 file_io_pool_entry );
+
+		goto on_error;
+	}
 	if( libbfio_pool_seek_offset(
 	     file_io_pool,
 	     file_io_pool_entry,
@@ -2036,6 +2053,7 @@ ssize_t libewf_section_write_compressed_string(
 	          compression_level,
 	          uncompressed_string,
 	          uncompressed_string_size,
+	          NULL,
 	          error );
 
 	if( result == 0 )
@@ -2099,6 +2117,7 @@ ssize_t libewf_section_write_compressed_string(
 		          compression_level,
 		          uncompressed_string,
 		          uncompressed_string_size,
+		          NULL,
 		          error );
 	}
 	if( result != 1 )
@@ -5492,6 +5511,320 @@ on_error:
 	return( -1 );
 }
 
+/* Reads a version 1 hash tree section
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libewf_section_hash_tree_read(
+         libewf_section_t *section,
+         libewf_io_handle_t *io_handle,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         libewf_hash_sections_t *hash_sections,
+         libcerror_error_t **error )
+{
+	libewf_hash_tree_t *hash_tree = NULL;
+	uint8_t *section_data         = NULL;
+	static char *function         = "libewf_section_hash_tree_read";
+	size_t section_data_size      = 0;
+	ssize_t read_count            = 0;
+
+	if( section == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid section.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_sections == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash sections.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = libewf_section_read_data(
+	              section,
+	              io_handle,
+	              file_io_pool,
+	              file_io_pool_entry,
+	              &section_data,
+	              &section_data_size,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read section data.",
+		 function );
+
+		goto on_error;
+	}
+	else if( read_count == 0 )
+	{
+		return( 0 );
+	}
+	if( section_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing section data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_hash_tree_initialize(
+	     &hash_tree,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create hash tree.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_hash_tree_read_data(
+	     hash_tree,
+	     section_data,
+	     section_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read hash tree.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 section_data );
+
+	section_data = NULL;
+
+	/* The last hash tree section takes precedence
+	 */
+	if( hash_sections->hash_tree != NULL )
+	{
+		if( libewf_hash_tree_free(
+		     &( hash_sections->hash_tree ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free previous hash tree.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	hash_sections->hash_tree = hash_tree;
+
+	return( read_count );
+
+on_error:
+	if( hash_tree != NULL )
+	{
+		libewf_hash_tree_free(
+		 &hash_tree,
+		 NULL );
+	}
+	if( section_data != NULL )
+	{
+		memory_free(
+		 section_data );
+	}
+	return( -1 );
+}
+
+/* Writes a version 1 hash tree section
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_section_hash_tree_write(
+         libewf_section_t *section,
+         libewf_io_handle_t *io_handle,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         off64_t section_offset,
+         libewf_hash_sections_t *hash_sections,
+         libcerror_error_t **error )
+{
+	uint8_t *section_data     = NULL;
+	static char *function     = "libewf_section_hash_tree_write";
+	size_t section_data_size  = 0;
+	ssize_t total_write_count = 0;
+	ssize_t write_count       = 0;
+
+	if( section == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid section.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_sections == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash sections.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_sections->hash_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid hash sections - missing hash tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_hash_tree_get_data_size(
+	     hash_sections->hash_tree,
+	     &section_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve hash tree data size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_section_set_values(
+	     section,
+	     0,
+	     (uint8_t *) "hashtree",
+	     8,
+	     section_offset,
+	     (size64_t) ( sizeof( ewf_section_descriptor_v1_t ) + section_data_size ),
+	     (size64_t) section_data_size,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set section values.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = libewf_section_descriptor_write(
+		       section,
+		       file_io_pool,
+		       file_io_pool_entry,
+		       1,
+		       error );
+
+	if( write_count != (ssize_t) sizeof( ewf_section_descriptor_v1_t ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write section descriptor data.",
+		 function );
+
+		goto on_error;
+	}
+	total_write_count += write_count;
+
+	section_data = (uint8_t *) memory_allocate(
+	                            sizeof( uint8_t ) * section_data_size );
+
+	if( section_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create section data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_hash_tree_write_data(
+	     hash_sections->hash_tree,
+	     section_data,
+	     section_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write hash tree.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = libewf_section_write_data(
+	               section,
+	               io_handle,
+	               file_io_pool,
+	               file_io_pool_entry,
+	               section_data,
+	               section_data_size,
+	               error );
+
+	if( write_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write section data.",
+		 function );
+
+		goto on_error;
+	}
+	total_write_count += write_count;
+
+	memory_free(
+	 section_data );
+
+	return( total_write_count );
+
+on_error:
+	if( section_data != NULL )
+	{
+		memory_free(
+		 section_data );
+	}
+	return( -1 );
+}
+
 /* Reads a version 1 ltree section or version 2 singles files data section
  * The section data will be set to a buffer containing the full section data
  * The ltree data will be set to a pointer within the section data
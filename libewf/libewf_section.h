@@ -275,6 +275,23 @@ ssize_t libewf_section_sha1_hash_write(
          libewf_hash_sections_t *hash_sections,
          libcerror_error_t **error );
 
+ssize_t libewf_section_hash_tree_read(
+         libewf_section_t *section,
+         libewf_io_handle_t *io_handle,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         libewf_hash_sections_t *hash_sections,
+         libcerror_error_t **error );
+
+ssize_t libewf_section_hash_tree_write(
+         libewf_section_t *section,
+         libewf_io_handle_t *io_handle,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         off64_t section_offset,
+         libewf_hash_sections_t *hash_sections,
+         libcerror_error_t **error );
+
 ssize_t libewf_section_ltree_read(
          libewf_section_t *section,
           libewf_io_handle_t *io_handle,
@@ -50,6 +50,7 @@
 #include "libewf_libfdata.h"
 #include "libewf_libfguid.h"
 #include "libewf_libfvalue.h"
+#include "libewf_open_handles_budget.h"
 #include "libewf_section.h"
 #include "libewf_segment_file.h"
 #include "libewf_segment_table.h"
@@ -1169,6 +1170,21 @@ off64_t libewf_segment_file_seek_offset(
 
 		return( -1 );
 	}
+	if( libewf_open_handles_access_file_io_pool_entry(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to account access of file IO pool entry: %d in open handles budget.",
+		 function,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
 	if( libbfio_pool_seek_offset(
 	     file_io_pool,
 	     file_io_pool_entry,
@@ -4474,6 +4490,79 @@ ssize_t libewf_segment_file_write_hash_sections(
 			}
 		}
 	}
+	/* Write the hash tree section if required
+	 */
+	if( ( segment_file->major_version == 1 )
+	 && ( hash_sections->hash_tree != NULL ) )
+	{
+		if( libewf_section_initialize(
+		     &section,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create section.",
+			 function );
+
+			goto on_error;
+		}
+		write_count = libewf_section_hash_tree_write(
+			       section,
+			       segment_file->io_handle,
+			       file_io_pool,
+			       file_io_pool_entry,
+			       segment_file->current_offset,
+			       hash_sections,
+			       error );
+
+		if( write_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write hash tree section.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfdata_list_append_element(
+		     segment_file->sections_list,
+		     &element_index,
+		     file_io_pool_entry,
+		     segment_file->current_offset,
+		     sizeof( ewf_section_descriptor_v1_t ),
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append section to sections list.",
+			 function );
+
+			goto on_error;
+		}
+		segment_file->current_offset += write_count;
+		total_write_count            += write_count;
+
+		if( libewf_section_free(
+		     &section,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free section.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( segment_file->io_handle->format == LIBEWF_FORMAT_EWFX )
 	{
 		/* Write the xhash section
@@ -0,0 +1,1211 @@
+/*
+ * Shared memory chunks cache functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H ) || defined( WINAPI )
+#include <errno.h>
+#endif
+
+#if !defined( WINAPI )
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_SYS_MMAN_H )
+#include <sys/mman.h>
+#endif
+
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+#endif /* !defined( WINAPI ) */
+
+#include "libewf_checksum.h"
+#include "libewf_libcerror.h"
+#include "libewf_shared_memory_chunks_cache.h"
+
+#if defined( WINAPI ) || ( defined( __GNUC__ ) && defined( HAVE_SYS_MMAN_H ) && defined( HAVE_SHM_OPEN ) && defined( HAVE_MMAP ) && defined( HAVE_MUNMAP ) && defined( HAVE_FTRUNCATE ) && defined( HAVE_UNISTD_H ) )
+#define LIBEWF_SHARED_MEMORY_CHUNKS_CACHE_HAVE_SHARED_MEMORY	1
+#endif
+
+/* The number of times a process waits 1 millisecond for another process to initialize the shared memory
+ */
+#define LIBEWF_SHARED_MEMORY_CHUNKS_CACHE_MAXIMUM_NUMBER_OF_RETRIES	1000
+
+/* The atomic operations on the shared memory
+ */
+#if defined( WINAPI )
+#define libewf_shared_memory_chunks_cache_compare_and_swap( value, expected_value, new_value ) \
+	( InterlockedCompareExchange64( (volatile LONGLONG *) ( value ), (LONGLONG) ( new_value ), (LONGLONG) ( expected_value ) ) == (LONGLONG) ( expected_value ) )
+
+#define libewf_shared_memory_chunks_cache_increment( value ) \
+	(uint64_t) InterlockedIncrement64( (volatile LONGLONG *) ( value ) )
+
+#define libewf_shared_memory_chunks_cache_memory_barrier() \
+	MemoryBarrier()
+
+#define libewf_shared_memory_chunks_cache_sleep() \
+	Sleep( 1 )
+
+#elif defined( LIBEWF_SHARED_MEMORY_CHUNKS_CACHE_HAVE_SHARED_MEMORY )
+#define libewf_shared_memory_chunks_cache_compare_and_swap( value, expected_value, new_value ) \
+	__sync_bool_compare_and_swap( ( value ), ( expected_value ), ( new_value ) )
+
+#define libewf_shared_memory_chunks_cache_increment( value ) \
+	__sync_add_and_fetch( ( value ), 1 )
+
+#define libewf_shared_memory_chunks_cache_memory_barrier() \
+	__sync_synchronize()
+
+#define libewf_shared_memory_chunks_cache_sleep() \
+	usleep( 1000 )
+
+#endif
+
+/* Creates a shared memory chunks cache
+ * Opens the named shared memory if it exists or creates it otherwise,
+ * where the size of the data of a slot is the chunk size of the process that creates the shared memory
+ * Make sure the value shared_memory_chunks_cache is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_shared_memory_chunks_cache_initialize(
+     libewf_shared_memory_chunks_cache_t **shared_memory_chunks_cache,
+     const char *name,
+     size_t name_length,
+     size64_t maximum_cache_size,
+     size32_t chunk_size,
+     libcerror_error_t **error )
+{
+#if defined( LIBEWF_SHARED_MEMORY_CHUNKS_CACHE_HAVE_SHARED_MEMORY )
+	libewf_shared_memory_chunks_cache_header_t *header = NULL;
+	char *shared_memory_name                           = NULL;
+	size64_t mapped_size                               = 0;
+	size_t header_size                                 = 0;
+	size_t name_index                                  = 0;
+	size_t slot_size                                   = 0;
+	uint64_t number_of_sets                            = 0;
+	int is_creator                                     = 0;
+	int number_of_retries                              = 0;
+
+#if defined( WINAPI )
+	MEMORY_BASIC_INFORMATION memory_information;
+
+	DWORD error_code                                   = 0;
+#else
+	struct stat file_statistics;
+
+	int file_descriptor                                = -1;
+#endif
+#endif /* defined( LIBEWF_SHARED_MEMORY_CHUNKS_CACHE_HAVE_SHARED_MEMORY ) */
+
+	static char *function                              = "libewf_shared_memory_chunks_cache_initialize";
+
+	if( shared_memory_chunks_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared memory chunks cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *shared_memory_chunks_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid shared memory chunks cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( name_length == 0 )
+	 || ( name_length > (size_t) ( SSIZE_MAX - 2 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid name length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid chunk size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( LIBEWF_SHARED_MEMORY_CHUNKS_CACHE_HAVE_SHARED_MEMORY )
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: shared memory not supported.",
+	 function );
+
+	return( -1 );
+#else
+	header_size = sizeof( libewf_shared_memory_chunks_cache_header_t );
+
+	if( ( header_size % LIBEWF_SHARED_MEMORY_CHUNKS_CACHE_ALIGNMENT ) != 0 )
+	{
+		header_size += LIBEWF_SHARED_MEMORY_CHUNKS_CACHE_ALIGNMENT - ( header_size % LIBEWF_SHARED_MEMORY_CHUNKS_CACHE_ALIGNMENT );
+	}
+	slot_size = sizeof( libewf_shared_memory_chunks_cache_slot_t ) + (size_t) chunk_size;
+
+	if( ( slot_size % LIBEWF_SHARED_MEMORY_CHUNKS_CACHE_ALIGNMENT ) != 0 )
+	{
+		slot_size += LIBEWF_SHARED_MEMORY_CHUNKS_CACHE_ALIGNMENT - ( slot_size % LIBEWF_SHARED_MEMORY_CHUNKS_CACHE_ALIGNMENT );
+	}
+	if( maximum_cache_size > (size64_t) SSIZE_MAX )
+	{
+		maximum_cache_size = (size64_t) SSIZE_MAX;
+	}
+	if( maximum_cache_size > (size64_t) header_size )
+	{
+		number_of_sets = ( maximum_cache_size - header_size ) / ( slot_size * LIBEWF_SHARED_MEMORY_CHUNKS_CACHE_NUMBER_OF_WAYS );
+	}
+	if( number_of_sets == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid maximum cache size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_sets > (uint64_t) UINT32_MAX )
+	{
+		number_of_sets = (uint64_t) UINT32_MAX;
+	}
+	mapped_size = header_size + ( number_of_sets * slot_size * LIBEWF_SHARED_MEMORY_CHUNKS_CACHE_NUMBER_OF_WAYS );
+
+	/* On POSIX systems the name of the shared memory starts with a slash
+	 */
+	shared_memory_name = narrow_string_allocate(
+	                      name_length + 2 );
+
+	if( shared_memory_name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create shared memory name.",
+		 function );
+
+		goto on_error;
+	}
+#if !defined( WINAPI )
+	if( name[ 0 ] != '/' )
+	{
+		shared_memory_name[ name_index++ ] = '/';
+	}
+#endif
+	if( narrow_string_copy(
+	     &( shared_memory_name[ name_index ] ),
+	     name,
+	     name_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy shared memory name.",
+		 function );
+
+		goto on_error;
+	}
+	shared_memory_name[ name_index + name_length ] = 0;
+
+	*shared_memory_chunks_cache = memory_allocate_structure(
+	                               libewf_shared_memory_chunks_cache_t );
+
+	if( *shared_memory_chunks_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create shared memory chunks cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *shared_memory_chunks_cache,
+	     0,
+	     sizeof( libewf_shared_memory_chunks_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear shared memory chunks cache.",
+		 function );
+
+		memory_free(
+		 *shared_memory_chunks_cache );
+
+		*shared_memory_chunks_cache = NULL;
+
+		goto on_error;
+	}
+#if defined( WINAPI )
+	( *shared_memory_chunks_cache )->file_mapping = CreateFileMappingA(
+	                                                 INVALID_HANDLE_VALUE,
+	                                                 NULL,
+	                                                 PAGE_READWRITE,
+	                                                 (DWORD) ( mapped_size >> 32 ),
+	                                                 (DWORD) ( mapped_size & 0xffffffffUL ),
+	                                                 (LPCSTR) shared_memory_name );
+
+	error_code = GetLastError();
+
+	if( ( *shared_memory_chunks_cache )->file_mapping == NULL )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 (uint32_t) error_code,
+		 "%s: unable to open shared memory: %s.",
+		 function,
+		 shared_memory_name );
+
+		goto on_error;
+	}
+	if( error_code != ERROR_ALREADY_EXISTS )
+	{
+		is_creator = 1;
+	}
+	( *shared_memory_chunks_cache )->mapped_data = (uint8_t *) MapViewOfFile(
+	                                                            ( *shared_memory_chunks_cache )->file_mapping,
+	                                                            FILE_MAP_ALL_ACCESS,
+	                                                            0,
+	                                                            0,
+	                                                            0 );
+
+	if( ( *shared_memory_chunks_cache )->mapped_data == NULL )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 (uint32_t) GetLastError(),
+		 "%s: unable to map shared memory: %s.",
+		 function,
+		 shared_memory_name );
+
+		goto on_error;
+	}
+	if( VirtualQuery(
+	     ( *shared_memory_chunks_cache )->mapped_data,
+	     &memory_information,
+	     sizeof( MEMORY_BASIC_INFORMATION ) ) == 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 (uint32_t) GetLastError(),
+		 "%s: unable to retrieve size of shared memory: %s.",
+		 function,
+		 shared_memory_name );
+
+		goto on_error;
+	}
+	if( is_creator == 0 )
+	{
+		mapped_size = (size64_t) memory_information.RegionSize;
+	}
+	( *shared_memory_chunks_cache )->mapped_size = (size_t) mapped_size;
+#else
+	/* The shared memory is only accessible by the user since the Adler-32 checksum of a slot
+	 * detects corrupted chunk data but not chunk data that was deliberately replaced
+	 */
+	file_descriptor = shm_open(
+	                   shared_memory_name,
+	                   O_RDWR | O_CREAT | O_EXCL,
+	                   0600 );
+
+	if( file_descriptor != -1 )
+	{
+		is_creator = 1;
+
+		if( ftruncate(
+		     file_descriptor,
+		     (off_t) mapped_size ) != 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 errno,
+			 "%s: unable to resize shared memory: %s.",
+			 function,
+			 shared_memory_name );
+
+			goto on_error;
+		}
+	}
+	else if( errno == EEXIST )
+	{
+		file_descriptor = shm_open(
+		                   shared_memory_name,
+		                   O_RDWR,
+		                   0 );
+	}
+	if( file_descriptor == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to open shared memory: %s.",
+		 function,
+		 shared_memory_name );
+
+		goto on_error;
+	}
+	/* The process that created the shared memory might not have resized it yet
+	 */
+	if( is_creator == 0 )
+	{
+		for( number_of_retries = 0;
+		     number_of_retries < LIBEWF_SHARED_MEMORY_CHUNKS_CACHE_MAXIMUM_NUMBER_OF_RETRIES;
+		     number_of_retries++ )
+		{
+			if( fstat(
+			     file_descriptor,
+			     &file_statistics ) != 0 )
+			{
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_GENERIC,
+				 errno,
+				 "%s: unable to retrieve size of shared memory: %s.",
+				 function,
+				 shared_memory_name );
+
+				goto on_error;
+			}
+			if( file_statistics.st_size > 0 )
+			{
+				break;
+			}
+			libewf_shared_memory_chunks_cache_sleep();
+		}
+		mapped_size = (size64_t) file_statistics.st_size;
+	}
+	if( ( mapped_size < (size64_t) header_size )
+	 || ( mapped_size > (size64_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid shared memory: %s size value out of bounds.",
+		 function,
+		 shared_memory_name );
+
+		goto on_error;
+	}
+	( *shared_memory_chunks_cache )->mapped_data = (uint8_t *) mmap(
+	                                                            NULL,
+	                                                            (size_t) mapped_size,
+	                                                            PROT_READ | PROT_WRITE,
+	                                                            MAP_SHARED,
+	                                                            file_descriptor,
+	                                                            0 );
+
+	if( ( *shared_memory_chunks_cache )->mapped_data == (uint8_t *) MAP_FAILED )
+	{
+		( *shared_memory_chunks_cache )->mapped_data = NULL;
+
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to map shared memory: %s.",
+		 function,
+		 shared_memory_name );
+
+		goto on_error;
+	}
+	( *shared_memory_chunks_cache )->mapped_size = (size_t) mapped_size;
+
+	/* The mapping remains valid after the file descriptor is closed
+	 */
+	close(
+	 file_descriptor );
+
+	file_descriptor = -1;
+#endif /* defined( WINAPI ) */
+
+	header = (libewf_shared_memory_chunks_cache_header_t *) ( *shared_memory_chunks_cache )->mapped_data;
+
+	if( is_creator != 0 )
+	{
+		if( memory_copy(
+		     header->signature,
+		     LIBEWF_SHARED_MEMORY_CHUNKS_CACHE_SIGNATURE,
+		     8 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy signature.",
+			 function );
+
+			goto on_error;
+		}
+		header->mapped_size    = mapped_size;
+		header->slot_data_size = (uint32_t) chunk_size;
+		header->number_of_sets = (uint32_t) number_of_sets;
+
+		libewf_shared_memory_chunks_cache_memory_barrier();
+
+		header->is_initialized = 1;
+	}
+	else
+	{
+		for( number_of_retries = 0;
+		     number_of_retries < LIBEWF_SHARED_MEMORY_CHUNKS_CACHE_MAXIMUM_NUMBER_OF_RETRIES;
+		     number_of_retries++ )
+		{
+			if( header->is_initialized != 0 )
+			{
+				break;
+			}
+			libewf_shared_memory_chunks_cache_sleep();
+		}
+		libewf_shared_memory_chunks_cache_memory_barrier();
+
+		if( header->is_initialized == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: shared memory: %s was not initialized.",
+			 function,
+			 shared_memory_name );
+
+			goto on_error;
+		}
+		if( memory_compare(
+		     header->signature,
+		     LIBEWF_SHARED_MEMORY_CHUNKS_CACHE_SIGNATURE,
+		     8 ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported shared memory: %s signature.",
+			 function,
+			 shared_memory_name );
+
+			goto on_error;
+		}
+		slot_size = sizeof( libewf_shared_memory_chunks_cache_slot_t ) + (size_t) header->slot_data_size;
+
+		if( ( slot_size % LIBEWF_SHARED_MEMORY_CHUNKS_CACHE_ALIGNMENT ) != 0 )
+		{
+			slot_size += LIBEWF_SHARED_MEMORY_CHUNKS_CACHE_ALIGNMENT - ( slot_size % LIBEWF_SHARED_MEMORY_CHUNKS_CACHE_ALIGNMENT );
+		}
+		number_of_sets = header->number_of_sets;
+
+		if( ( header->mapped_size > mapped_size )
+		 || ( number_of_sets == 0 )
+		 || ( ( header_size + ( number_of_sets * slot_size * LIBEWF_SHARED_MEMORY_CHUNKS_CACHE_NUMBER_OF_WAYS ) ) > header->mapped_size ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid shared memory: %s layout value out of bounds.",
+			 function,
+			 shared_memory_name );
+
+			goto on_error;
+		}
+	}
+	( *shared_memory_chunks_cache )->header         = header;
+	( *shared_memory_chunks_cache )->slots          = &( ( ( *shared_memory_chunks_cache )->mapped_data )[ header_size ] );
+	( *shared_memory_chunks_cache )->slot_size      = slot_size;
+	( *shared_memory_chunks_cache )->slot_data_size = (size_t) header->slot_data_size;
+	( *shared_memory_chunks_cache )->number_of_sets = (uint32_t) number_of_sets;
+
+	memory_free(
+	 shared_memory_name );
+
+	return( 1 );
+
+on_error:
+#if !defined( WINAPI )
+	if( file_descriptor != -1 )
+	{
+		close(
+		 file_descriptor );
+	}
+	/* Remove shared memory that was not initialized, otherwise other processes cannot use it
+	 */
+	if( ( is_creator != 0 )
+	 && ( shared_memory_name != NULL ) )
+	{
+		shm_unlink(
+		 shared_memory_name );
+	}
+#endif
+	if( *shared_memory_chunks_cache != NULL )
+	{
+		libewf_shared_memory_chunks_cache_free(
+		 shared_memory_chunks_cache,
+		 NULL );
+	}
+	if( shared_memory_name != NULL )
+	{
+		memory_free(
+		 shared_memory_name );
+	}
+	return( -1 );
+
+#endif /* !defined( LIBEWF_SHARED_MEMORY_CHUNKS_CACHE_HAVE_SHARED_MEMORY ) */
+}
+
+/* Frees a shared memory chunks cache
+ * The shared memory itself is not removed so that the cached chunks remain available to other processes
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_shared_memory_chunks_cache_free(
+     libewf_shared_memory_chunks_cache_t **shared_memory_chunks_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_shared_memory_chunks_cache_free";
+	int result            = 1;
+
+	if( shared_memory_chunks_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared memory chunks cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *shared_memory_chunks_cache != NULL )
+	{
+#if defined( WINAPI )
+		if( ( *shared_memory_chunks_cache )->mapped_data != NULL )
+		{
+			if( UnmapViewOfFile(
+			     ( *shared_memory_chunks_cache )->mapped_data ) == 0 )
+			{
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 (uint32_t) GetLastError(),
+				 "%s: unable to unmap shared memory.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *shared_memory_chunks_cache )->file_mapping != NULL )
+		{
+			if( CloseHandle(
+			     ( *shared_memory_chunks_cache )->file_mapping ) == 0 )
+			{
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 (uint32_t) GetLastError(),
+				 "%s: unable to close shared memory.",
+				 function );
+
+				result = -1;
+			}
+		}
+#elif defined( LIBEWF_SHARED_MEMORY_CHUNKS_CACHE_HAVE_SHARED_MEMORY )
+		if( ( *shared_memory_chunks_cache )->mapped_data != NULL )
+		{
+			if( munmap(
+			     ( *shared_memory_chunks_cache )->mapped_data,
+			     ( *shared_memory_chunks_cache )->mapped_size ) != 0 )
+			{
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 errno,
+				 "%s: unable to unmap shared memory.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+		memory_free(
+		 *shared_memory_chunks_cache );
+
+		*shared_memory_chunks_cache = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves the index of the set of slots a chunk is stored in
+ * Consecutive chunks are spread over the sets
+ * Returns the set index
+ */
+uint32_t libewf_shared_memory_chunks_cache_get_set_index(
+          libewf_shared_memory_chunks_cache_t *shared_memory_chunks_cache,
+          const libewf_shared_memory_chunks_cache_key_t *key )
+{
+	uint64_t hash  = 0xcbf29ce484222325ULL;
+	size_t index   = 0;
+
+	/* Calculate a FNV-1a hash of the segment file set identifier, media size and chunk data offset
+	 */
+	for( index = 0;
+	     index < 16;
+	     index++ )
+	{
+		hash ^= key->set_identifier[ index ];
+		hash *= 0x100000001b3ULL;
+	}
+	hash ^= key->media_size;
+	hash *= 0x100000001b3ULL;
+
+	hash ^= key->chunk_data_offset;
+	hash *= 0x100000001b3ULL;
+
+	hash ^= key->chunk_index * 0x9e3779b97f4a7c15ULL;
+	hash ^= hash >> 29;
+
+	return( (uint32_t) ( hash % shared_memory_chunks_cache->number_of_sets ) );
+}
+
+/* Retrieves a specific slot
+ * Returns the slot
+ */
+libewf_shared_memory_chunks_cache_slot_t *libewf_shared_memory_chunks_cache_get_slot(
+                                           libewf_shared_memory_chunks_cache_t *shared_memory_chunks_cache,
+                                           uint32_t set_index,
+                                           int way_index )
+{
+	size_t slot_index = ( (size_t) set_index * LIBEWF_SHARED_MEMORY_CHUNKS_CACHE_NUMBER_OF_WAYS ) + (size_t) way_index;
+
+	return( (libewf_shared_memory_chunks_cache_slot_t *) &( ( shared_memory_chunks_cache->slots )[ slot_index * shared_memory_chunks_cache->slot_size ] ) );
+}
+
+/* Reads (media) data of a chunk from the shared memory chunks cache
+ * The data is read from the data offset up to the end of the chunk
+ * The lookup does not use a lock, when the slot is overwritten while it is read the slot is read again,
+ * the data that was read is verified with the Adler-32 checksum of the slot
+ * When the chunk is considered missing the buffer can contain part of the data
+ * Returns the number of bytes read, 0 if the chunk is not cached or -1 on error
+ */
+ssize_t libewf_shared_memory_chunks_cache_read_chunk(
+         libewf_shared_memory_chunks_cache_t *shared_memory_chunks_cache,
+         const libewf_shared_memory_chunks_cache_key_t *key,
+         uint64_t chunk_index,
+         size_t data_offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libewf_shared_memory_chunks_cache_key_t chunk_key;
+
+	libewf_shared_memory_chunks_cache_slot_t *slot = NULL;
+	uint8_t *slot_data                             = NULL;
+	static char *function                          = "libewf_shared_memory_chunks_cache_read_chunk";
+	size_t read_size                               = 0;
+	uint64_t data_size                             = 0;
+	uint64_t sequence_number                       = 0;
+	uint32_t calculated_checksum                   = 0;
+	uint32_t set_index                             = 0;
+	uint32_t stored_checksum                       = 0;
+	int number_of_retries                          = 0;
+	int way_index                                  = 0;
+
+	if( shared_memory_chunks_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared memory chunks cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     &chunk_key,
+	     key,
+	     sizeof( libewf_shared_memory_chunks_cache_key_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy key.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_key.chunk_index = chunk_index;
+
+	set_index = libewf_shared_memory_chunks_cache_get_set_index(
+	             shared_memory_chunks_cache,
+	             &chunk_key );
+
+	for( way_index = 0;
+	     way_index < LIBEWF_SHARED_MEMORY_CHUNKS_CACHE_NUMBER_OF_WAYS;
+	     way_index++ )
+	{
+		slot = libewf_shared_memory_chunks_cache_get_slot(
+		        shared_memory_chunks_cache,
+		        set_index,
+		        way_index );
+
+		slot_data = &( ( (uint8_t *) slot )[ sizeof( libewf_shared_memory_chunks_cache_slot_t ) ] );
+
+		for( number_of_retries = 0;
+		     number_of_retries < LIBEWF_SHARED_MEMORY_CHUNKS_CACHE_MAXIMUM_NUMBER_OF_READ_RETRIES;
+		     number_of_retries++ )
+		{
+			sequence_number = slot->sequence_number;
+
+			libewf_shared_memory_chunks_cache_memory_barrier();
+
+			if( ( sequence_number == 0 )
+			 || ( ( sequence_number & 1 ) != 0 ) )
+			{
+				break;
+			}
+			if( memory_compare(
+			     &( slot->key ),
+			     &chunk_key,
+			     sizeof( libewf_shared_memory_chunks_cache_key_t ) ) != 0 )
+			{
+				/* The key is compared again if the slot was written while it was compared
+				 */
+				libewf_shared_memory_chunks_cache_memory_barrier();
+
+				if( slot->sequence_number != sequence_number )
+				{
+					continue;
+				}
+				break;
+			}
+			data_size       = slot->data_size;
+			stored_checksum = slot->checksum;
+
+			if( ( data_size > (uint64_t) shared_memory_chunks_cache->slot_data_size )
+			 || ( (uint64_t) data_offset >= data_size ) )
+			{
+				libewf_shared_memory_chunks_cache_memory_barrier();
+
+				if( slot->sequence_number != sequence_number )
+				{
+					continue;
+				}
+				break;
+			}
+			read_size = (size_t) ( data_size - data_offset );
+
+			if( read_size > buffer_size )
+			{
+				read_size = buffer_size;
+			}
+			if( memory_copy(
+			     buffer,
+			     &( slot_data[ data_offset ] ),
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+			/* The checksum is calculated over the data that was copied into the buffer
+			 * and the remainder of the chunk data in the slot
+			 */
+			if( libewf_checksum_calculate_adler32(
+			     &calculated_checksum,
+			     slot_data,
+			     data_offset,
+			     1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to calculate checksum.",
+				 function );
+
+				return( -1 );
+			}
+			if( libewf_checksum_calculate_adler32(
+			     &calculated_checksum,
+			     buffer,
+			     read_size,
+			     calculated_checksum,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to calculate checksum.",
+				 function );
+
+				return( -1 );
+			}
+			if( libewf_checksum_calculate_adler32(
+			     &calculated_checksum,
+			     &( slot_data[ data_offset + read_size ] ),
+			     (size_t) data_size - ( data_offset + read_size ),
+			     calculated_checksum,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to calculate checksum.",
+				 function );
+
+				return( -1 );
+			}
+			libewf_shared_memory_chunks_cache_memory_barrier();
+
+			if( slot->sequence_number != sequence_number )
+			{
+				continue;
+			}
+			/* Data that does not match its checksum is considered missing
+			 */
+			if( calculated_checksum != stored_checksum )
+			{
+				break;
+			}
+			slot->access_time = libewf_shared_memory_chunks_cache_increment(
+			                     &( shared_memory_chunks_cache->header->access_counter ) );
+
+			return( (ssize_t) read_size );
+		}
+	}
+	return( 0 );
+}
+
+/* Writes (media) data of a chunk to the shared memory chunks cache
+ * The chunk replaces the empty or least recently used slot of its set,
+ * a chunk that is already cached, larger than the slot or of which the slot is being written is not stored
+ * A slot of a process that terminated while writing the slot is not used again
+ * Returns 1 if the chunk was stored, 0 if not or -1 on error
+ */
+int libewf_shared_memory_chunks_cache_write_chunk(
+     libewf_shared_memory_chunks_cache_t *shared_memory_chunks_cache,
+     const libewf_shared_memory_chunks_cache_key_t *key,
+     uint64_t chunk_index,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libewf_shared_memory_chunks_cache_key_t chunk_key;
+
+	libewf_shared_memory_chunks_cache_slot_t *least_recently_used_slot = NULL;
+	libewf_shared_memory_chunks_cache_slot_t *slot                     = NULL;
+	static char *function                                              = "libewf_shared_memory_chunks_cache_write_chunk";
+	uint64_t sequence_number                                           = 0;
+	uint32_t checksum                                                  = 0;
+	uint32_t set_index                                                 = 0;
+	int way_index                                                      = 0;
+
+	if( shared_memory_chunks_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared memory chunks cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size == 0 )
+	 || ( data_size > shared_memory_chunks_cache->slot_data_size ) )
+	{
+		return( 0 );
+	}
+	if( libewf_checksum_calculate_adler32(
+	     &checksum,
+	     data,
+	     data_size,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate checksum.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     &chunk_key,
+	     key,
+	     sizeof( libewf_shared_memory_chunks_cache_key_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy key.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_key.chunk_index = chunk_index;
+
+	set_index = libewf_shared_memory_chunks_cache_get_set_index(
+	             shared_memory_chunks_cache,
+	             &chunk_key );
+
+	for( way_index = 0;
+	     way_index < LIBEWF_SHARED_MEMORY_CHUNKS_CACHE_NUMBER_OF_WAYS;
+	     way_index++ )
+	{
+		slot = libewf_shared_memory_chunks_cache_get_slot(
+		        shared_memory_chunks_cache,
+		        set_index,
+		        way_index );
+
+		sequence_number = slot->sequence_number;
+
+		if( ( sequence_number & 1 ) != 0 )
+		{
+			continue;
+		}
+		if( sequence_number == 0 )
+		{
+			least_recently_used_slot = slot;
+
+			break;
+		}
+		if( memory_compare(
+		     &( slot->key ),
+		     &chunk_key,
+		     sizeof( libewf_shared_memory_chunks_cache_key_t ) ) == 0 )
+		{
+			return( 0 );
+		}
+		if( ( least_recently_used_slot == NULL )
+		 || ( slot->access_time < least_recently_used_slot->access_time ) )
+		{
+			least_recently_used_slot = slot;
+		}
+	}
+	if( least_recently_used_slot == NULL )
+	{
+		return( 0 );
+	}
+	slot            = least_recently_used_slot;
+	sequence_number = slot->sequence_number;
+
+	/* The slot is marked as being written by making its sequence number odd,
+	 * if another process marked it first the chunk is not stored
+	 */
+	if( ( ( sequence_number & 1 ) != 0 )
+	 || ( libewf_shared_memory_chunks_cache_compare_and_swap(
+	       &( slot->sequence_number ),
+	       sequence_number,
+	       sequence_number + 1 ) == 0 ) )
+	{
+		return( 0 );
+	}
+	libewf_shared_memory_chunks_cache_memory_barrier();
+
+	if( memory_copy(
+	     &( slot->key ),
+	     &chunk_key,
+	     sizeof( libewf_shared_memory_chunks_cache_key_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy key.",
+		 function );
+
+		goto on_error;
+	}
+	slot->data_size = (uint64_t) data_size;
+	slot->checksum  = checksum;
+
+	if( memory_copy(
+	     &( ( (uint8_t *) slot )[ sizeof( libewf_shared_memory_chunks_cache_slot_t ) ] ),
+	     data,
+	     data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	slot->access_time = libewf_shared_memory_chunks_cache_increment(
+	                     &( shared_memory_chunks_cache->header->access_counter ) );
+
+	/* The compare and swap also orders the writes of the slot before the new sequence number
+	 */
+	libewf_shared_memory_chunks_cache_compare_and_swap(
+	 &( slot->sequence_number ),
+	 sequence_number + 1,
+	 sequence_number + 2 );
+
+	return( 1 );
+
+on_error:
+	/* Clear the key so that the slot cannot be matched
+	 */
+	memory_set(
+	 &( slot->key ),
+	 0,
+	 sizeof( libewf_shared_memory_chunks_cache_key_t ) );
+
+	libewf_shared_memory_chunks_cache_compare_and_swap(
+	 &( slot->sequence_number ),
+	 sequence_number + 1,
+	 sequence_number + 2 );
+
+	return( -1 );
+}
+
@@ -0,0 +1,237 @@
+/*
+ * Shared memory chunks cache functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_SHARED_MEMORY_CHUNKS_CACHE_H )
+#define _LIBEWF_SHARED_MEMORY_CHUNKS_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The signature of the shared memory, which includes the version of the layout
+ */
+#define LIBEWF_SHARED_MEMORY_CHUNKS_CACHE_SIGNATURE		"EWFSCC03"
+
+/* The number of slots a chunk can be stored in
+ */
+#define LIBEWF_SHARED_MEMORY_CHUNKS_CACHE_NUMBER_OF_WAYS	4
+
+/* The alignment of the header and the slots
+ */
+#define LIBEWF_SHARED_MEMORY_CHUNKS_CACHE_ALIGNMENT		64
+
+/* The number of times a slot is read again when it was written while it was read
+ */
+#define LIBEWF_SHARED_MEMORY_CHUNKS_CACHE_MAXIMUM_NUMBER_OF_READ_RETRIES	4
+
+typedef struct libewf_shared_memory_chunks_cache_key libewf_shared_memory_chunks_cache_key_t;
+
+/* The key of a chunk
+ * The chunk is identified by where and how it is stored in the segment files,
+ * since images can share the same segment file set identifier
+ * The key must be cleared before it is set, since it is compared including its padding
+ */
+struct libewf_shared_memory_chunks_cache_key
+{
+	/* The segment file set identifier
+	 */
+	uint8_t set_identifier[ 16 ];
+
+	/* The media size
+	 */
+	uint64_t media_size;
+
+	/* The chunk index
+	 */
+	uint64_t chunk_index;
+
+	/* The offset of the chunk data in the segment file
+	 */
+	uint64_t chunk_data_offset;
+
+	/* The size of the stored chunk data
+	 */
+	uint64_t chunk_data_size;
+
+	/* The chunk size
+	 */
+	uint32_t chunk_size;
+
+	/* The index of the segment file that contains the chunk
+	 */
+	uint32_t segment_file_index;
+
+	/* The range flags of the stored chunk data
+	 */
+	uint32_t chunk_data_flags;
+};
+
+typedef struct libewf_shared_memory_chunks_cache_header libewf_shared_memory_chunks_cache_header_t;
+
+/* The header at the start of the shared memory
+ */
+struct libewf_shared_memory_chunks_cache_header
+{
+	/* The signature
+	 */
+	uint8_t signature[ 8 ];
+
+	/* The size of the shared memory
+	 */
+	uint64_t mapped_size;
+
+	/* The size of the data of a slot
+	 */
+	uint32_t slot_data_size;
+
+	/* The number of sets of slots
+	 */
+	uint32_t number_of_sets;
+
+	/* Value to indicate the header has been initialized by the process that created the shared memory
+	 */
+	volatile uint64_t is_initialized;
+
+	/* The counter used to determine the least recently used slot
+	 */
+	volatile uint64_t access_counter;
+};
+
+typedef struct libewf_shared_memory_chunks_cache_slot libewf_shared_memory_chunks_cache_slot_t;
+
+/* The slot of a chunk, which is followed by the chunk data
+ */
+struct libewf_shared_memory_chunks_cache_slot
+{
+	/* The sequence number, where 0 represents an empty slot
+	 * and an odd value a slot that is being written
+	 */
+	volatile uint64_t sequence_number;
+
+	/* The value of the access counter when the slot was last used
+	 */
+	volatile uint64_t access_time;
+
+	/* The key
+	 */
+	libewf_shared_memory_chunks_cache_key_t key;
+
+	/* The size of the chunk data
+	 */
+	uint64_t data_size;
+
+	/* The Adler-32 checksum of the chunk data
+	 */
+	uint32_t checksum;
+};
+
+typedef struct libewf_shared_memory_chunks_cache libewf_shared_memory_chunks_cache_t;
+
+/* The shared memory chunks cache contains unpacked chunks that are shared between processes
+ * The chunks are looked up without a lock, where a slot is read optimistically and its sequence number
+ * is checked afterwards to detect a concurrent write
+ */
+struct libewf_shared_memory_chunks_cache
+{
+#if defined( WINAPI )
+	/* The file mapping handle
+	 */
+	HANDLE file_mapping;
+#endif
+
+	/* The mapped shared memory
+	 */
+	uint8_t *mapped_data;
+
+	/* The size of the mapped shared memory
+	 */
+	size_t mapped_size;
+
+	/* The header
+	 */
+	libewf_shared_memory_chunks_cache_header_t *header;
+
+	/* The slots
+	 */
+	uint8_t *slots;
+
+	/* The size of a slot including its data
+	 */
+	size_t slot_size;
+
+	/* The size of the data of a slot
+	 */
+	size_t slot_data_size;
+
+	/* The number of sets of slots
+	 */
+	uint32_t number_of_sets;
+};
+
+int libewf_shared_memory_chunks_cache_initialize(
+     libewf_shared_memory_chunks_cache_t **shared_memory_chunks_cache,
+     const char *name,
+     size_t name_length,
+     size64_t maximum_cache_size,
+     size32_t chunk_size,
+     libcerror_error_t **error );
+
+int libewf_shared_memory_chunks_cache_free(
+     libewf_shared_memory_chunks_cache_t **shared_memory_chunks_cache,
+     libcerror_error_t **error );
+
+uint32_t libewf_shared_memory_chunks_cache_get_set_index(
+          libewf_shared_memory_chunks_cache_t *shared_memory_chunks_cache,
+          const libewf_shared_memory_chunks_cache_key_t *key );
+
+libewf_shared_memory_chunks_cache_slot_t *libewf_shared_memory_chunks_cache_get_slot(
+                                           libewf_shared_memory_chunks_cache_t *shared_memory_chunks_cache,
+                                           uint32_t set_index,
+                                           int way_index );
+
+ssize_t libewf_shared_memory_chunks_cache_read_chunk(
+         libewf_shared_memory_chunks_cache_t *shared_memory_chunks_cache,
+         const libewf_shared_memory_chunks_cache_key_t *key,
+         uint64_t chunk_index,
+         size_t data_offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
+int libewf_shared_memory_chunks_cache_write_chunk(
+     libewf_shared_memory_chunks_cache_t *shared_memory_chunks_cache,
+     const libewf_shared_memory_chunks_cache_key_t *key,
+     uint64_t chunk_index,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_SHARED_MEMORY_CHUNKS_CACHE_H ) */
+
@@ -0,0 +1,127 @@
+/*
+ * Shared metadata functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_SHARED_METADATA_H )
+#define _LIBEWF_SHARED_METADATA_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_table.h"
+#include "libewf_hash_sections.h"
+#include "libewf_io_handle.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_libfcache.h"
+#include "libewf_libfvalue.h"
+#include "libewf_segment_table.h"
+#include "libewf_single_files.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_shared_metadata libewf_shared_metadata_t;
+
+/* The shared metadata contains the metadata of an opened image that is shared
+ * by a handle and its shared clones. It is freed when its last reference is released.
+ * The segment table, chunk table and caches are populated on demand, hence
+ * they must only be accessed while the shared metadata is grabbed.
+ */
+struct libewf_shared_metadata
+{
+	/* The number of references
+	 */
+	int number_of_references;
+
+	/* The IO handle referenced by the segment and chunk table
+	 */
+	libewf_io_handle_t *io_handle;
+
+	/* The segment file table
+	 */
+	libewf_segment_table_t *segment_table;
+
+	/* The chunk table
+	 */
+	libewf_chunk_table_t *chunk_table;
+
+	/* The chunk groups cache
+	 */
+	libfcache_cache_t *chunk_groups_cache;
+
+	/* The chunks cache
+	 */
+	libfcache_cache_t *chunks_cache;
+
+	/* The hash sections
+	 */
+	libewf_hash_sections_t *hash_sections;
+
+	/* The header values
+	 */
+	libfvalue_table_t *header_values;
+
+	/* The hash values
+	 */
+	libfvalue_table_t *hash_values;
+
+	/* The single files
+	 */
+	libewf_single_files_t *single_files;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The read/write lock
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
+};
+
+int libewf_shared_metadata_initialize(
+     libewf_shared_metadata_t **shared_metadata,
+     libcerror_error_t **error );
+
+int libewf_shared_metadata_free(
+     libewf_shared_metadata_t **shared_metadata,
+     libcerror_error_t **error );
+
+int libewf_shared_metadata_add_reference(
+     libewf_shared_metadata_t *shared_metadata,
+     libcerror_error_t **error );
+
+int libewf_shared_metadata_remove_reference(
+     libewf_shared_metadata_t **shared_metadata,
+     libcerror_error_t **error );
+
+int libewf_shared_metadata_grab(
+     libewf_shared_metadata_t *shared_metadata,
+     libcerror_error_t **error );
+
+int libewf_shared_metadata_release(
+     libewf_shared_metadata_t *shared_metadata,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_SHARED_METADATA_H ) */
+
@@ -28,6 +28,7 @@
 #include "libewf_libfvalue.h"
 #include "libewf_libuna.h"
 #include "libewf_single_file_entry.h"
+#include "libewf_single_file_name_index.h"
 
 /* Creates a single file entry
  * Make sure the value single_file_entry is referencing, is set to NULL
@@ -113,6 +114,7 @@ int libewf_single_file_entry_free(
      libcerror_error_t **error )
 {
 	static char *function = "libewf_single_file_entry_free";
+	int result            = 1;
 
 	if( single_file_entry == NULL )
 	{
@@ -142,12 +144,28 @@ int libewf_single_file_entry_free(
 			memory_free(
 			 ( *single_file_entry )->sha1_hash );
 		}
+		if( ( *single_file_entry )->sub_node_name_index != NULL )
+		{
+			if( libewf_single_file_name_index_free(
+			     &( ( *single_file_entry )->sub_node_name_index ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free sub node name index.",
+				 function );
+
+				result = -1;
+			}
+		}
 		memory_free(
 		 *single_file_entry );
 
 		*single_file_entry = NULL;
 	}
-	return( 1 );
+	return( result );
 }
 
 /* Clones the single file entry
@@ -225,6 +243,9 @@ int libewf_single_file_entry_clone(
 	( *destination_single_file_entry )->md5_hash  = NULL;
 	( *destination_single_file_entry )->sha1_hash = NULL;
 
+	( *destination_single_file_entry )->sub_node_name_index          = NULL;
+	( *destination_single_file_entry )->number_of_unread_sub_entries = 0;
+
 	if( source_single_file_entry->name != NULL )
 	{
 		( *destination_single_file_entry )->name = (uint8_t *) memory_allocate(
@@ -27,6 +27,7 @@
 
 #include "libewf_date_time.h"
 #include "libewf_libcerror.h"
+#include "libewf_single_file_name_index.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -103,6 +104,18 @@ struct libewf_single_file_entry
 	/* The SHA1 digest hash size
 	 */
 	size_t sha1_hash_size;
+
+	/* The name index of the sub file entries, which is built on demand
+	 */
+	libewf_single_file_name_index_t *sub_node_name_index;
+
+	/* The index of the ltree record of the single file entry
+	 */
+	int record_index;
+
+	/* The number of sub file entries that have not been read from the ltree yet
+	 */
+	int number_of_unread_sub_entries;
 };
 
 int libewf_single_file_entry_initialize(
@@ -0,0 +1,823 @@
+/*
+ * Single file name index functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_libcdata.h"
+#include "libewf_libcerror.h"
+#include "libewf_libuna.h"
+#include "libewf_single_file_entry.h"
+#include "libewf_single_file_name_index.h"
+
+/* Adds an Unicode character to a FNV-1a hash
+ */
+#define libewf_single_file_name_index_hash_add_character( hash, unicode_character ) \
+	hash ^= (uint32_t) ( unicode_character & 0x000000ffUL ); \
+	hash *= 0x01000193UL; \
+	hash ^= (uint32_t) ( ( unicode_character >> 8 ) & 0x000000ffUL ); \
+	hash *= 0x01000193UL; \
+	hash ^= (uint32_t) ( ( unicode_character >> 16 ) & 0x000000ffUL ); \
+	hash *= 0x01000193UL
+
+/* Creates a name index
+ * Make sure the value name_index is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_single_file_name_index_initialize(
+     libewf_single_file_name_index_t **name_index,
+     int number_of_sub_nodes,
+     libcerror_error_t **error )
+{
+	static char *function      = "libewf_single_file_name_index_initialize";
+	uint32_t number_of_buckets = 16;
+
+	if( name_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *name_index != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid name index value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_sub_nodes < 0 )
+	 || ( number_of_sub_nodes > LIBEWF_SINGLE_FILE_NAME_INDEX_MAXIMUM_NUMBER_OF_SUB_NODES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of sub nodes value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* Keep the load factor of the hash table at 50% or less
+	 */
+	while( number_of_buckets < ( (uint32_t) number_of_sub_nodes * 2 ) )
+	{
+		number_of_buckets <<= 1;
+	}
+	*name_index = memory_allocate_structure(
+	               libewf_single_file_name_index_t );
+
+	if( *name_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create name index.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *name_index,
+	     0,
+	     sizeof( libewf_single_file_name_index_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear name index.",
+		 function );
+
+		memory_free(
+		 *name_index );
+
+		*name_index = NULL;
+
+		return( -1 );
+	}
+	( *name_index )->hashes = (uint32_t *) memory_allocate(
+	                                        sizeof( uint32_t ) * number_of_buckets );
+
+	if( ( *name_index )->hashes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create hashes.",
+		 function );
+
+		goto on_error;
+	}
+	( *name_index )->sub_nodes = (libcdata_tree_node_t **) memory_allocate(
+	                                                        sizeof( libcdata_tree_node_t * ) * number_of_buckets );
+
+	if( ( *name_index )->sub_nodes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create sub nodes.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *name_index )->sub_nodes,
+	     0,
+	     sizeof( libcdata_tree_node_t * ) * number_of_buckets ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear sub nodes.",
+		 function );
+
+		goto on_error;
+	}
+	( *name_index )->number_of_buckets = number_of_buckets;
+
+	return( 1 );
+
+on_error:
+	if( *name_index != NULL )
+	{
+		if( ( *name_index )->sub_nodes != NULL )
+		{
+			memory_free(
+			 ( *name_index )->sub_nodes );
+		}
+		if( ( *name_index )->hashes != NULL )
+		{
+			memory_free(
+			 ( *name_index )->hashes );
+		}
+		memory_free(
+		 *name_index );
+
+		*name_index = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a name index
+ * The sub nodes are not freed since they are owned by the single file entry tree
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_single_file_name_index_free(
+     libewf_single_file_name_index_t **name_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_single_file_name_index_free";
+
+	if( name_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *name_index != NULL )
+	{
+		if( ( *name_index )->sub_nodes != NULL )
+		{
+			memory_free(
+			 ( *name_index )->sub_nodes );
+		}
+		if( ( *name_index )->hashes != NULL )
+		{
+			memory_free(
+			 ( *name_index )->hashes );
+		}
+		memory_free(
+		 *name_index );
+
+		*name_index = NULL;
+	}
+	return( 1 );
+}
+
+/* Calculates the hash of an UTF-8 formatted name
+ * The hash is calculated up to the end of the string or the first end-of-string character
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_single_file_name_index_get_utf8_string_hash(
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     uint32_t *hash,
+     libcerror_error_t **error )
+{
+	libuna_unicode_character_t unicode_character = 0;
+	static char *function                        = "libewf_single_file_name_index_get_utf8_string_hash";
+	size_t utf8_string_index                     = 0;
+	uint32_t safe_hash                           = 0x811c9dc5UL;
+
+	if( utf8_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string_length > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid UTF-8 string length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash.",
+		 function );
+
+		return( -1 );
+	}
+	while( utf8_string_index < utf8_string_length )
+	{
+		if( libuna_unicode_character_copy_from_utf8(
+		     &unicode_character,
+		     utf8_string,
+		     utf8_string_length,
+		     &utf8_string_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy Unicode character from UTF-8 string.",
+			 function );
+
+			return( -1 );
+		}
+		if( unicode_character == 0 )
+		{
+			break;
+		}
+		libewf_single_file_name_index_hash_add_character(
+		 safe_hash,
+		 unicode_character );
+	}
+	*hash = safe_hash;
+
+	return( 1 );
+}
+
+/* Calculates the hash of an UTF-16 formatted name
+ * The hash is calculated up to the end of the string or the first end-of-string character
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_single_file_name_index_get_utf16_string_hash(
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     uint32_t *hash,
+     libcerror_error_t **error )
+{
+	libuna_unicode_character_t unicode_character = 0;
+	static char *function                        = "libewf_single_file_name_index_get_utf16_string_hash";
+	size_t utf16_string_index                    = 0;
+	uint32_t safe_hash                           = 0x811c9dc5UL;
+
+	if( utf16_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-16 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf16_string_length > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid UTF-16 string length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash.",
+		 function );
+
+		return( -1 );
+	}
+	while( utf16_string_index < utf16_string_length )
+	{
+		if( libuna_unicode_character_copy_from_utf16(
+		     &unicode_character,
+		     utf16_string,
+		     utf16_string_length,
+		     &utf16_string_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy Unicode character from UTF-16 string.",
+			 function );
+
+			return( -1 );
+		}
+		if( unicode_character == 0 )
+		{
+			break;
+		}
+		libewf_single_file_name_index_hash_add_character(
+		 safe_hash,
+		 unicode_character );
+	}
+	*hash = safe_hash;
+
+	return( 1 );
+}
+
+/* Builds the name index from the sub nodes of a single file entry node
+ * Sub nodes with the same name are stored in tree order so that a lookup
+ * returns the same sub node as a linear search of the tree
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_single_file_name_index_build(
+     libewf_single_file_name_index_t *name_index,
+     libcdata_tree_node_t *node,
+     libcerror_error_t **error )
+{
+	libcdata_tree_node_t *sub_node                    = NULL;
+	libewf_single_file_entry_t *sub_single_file_entry = NULL;
+	static char *function                             = "libewf_single_file_name_index_build";
+	uint32_t bucket_index                             = 0;
+	uint32_t bucket_mask                              = 0;
+	uint32_t hash                                     = 0;
+	int number_of_sub_nodes                           = 0;
+	int sub_node_index                                = 0;
+
+	if( name_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name index.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( name_index->hashes == NULL )
+	 || ( name_index->sub_nodes == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid name index - missing buckets.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_tree_node_get_number_of_sub_nodes(
+	     node,
+	     &number_of_sub_nodes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of sub nodes.",
+		 function );
+
+		return( -1 );
+	}
+	if( (uint32_t) number_of_sub_nodes >= name_index->number_of_buckets )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of sub nodes value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_sub_nodes == 0 )
+	{
+		return( 1 );
+	}
+	if( libcdata_tree_node_get_sub_node_by_index(
+	     node,
+	     0,
+	     &sub_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve first sub node.",
+		 function );
+
+		return( -1 );
+	}
+	bucket_mask = name_index->number_of_buckets - 1;
+
+	for( sub_node_index = 0;
+	     sub_node_index < number_of_sub_nodes;
+	     sub_node_index++ )
+	{
+		if( libcdata_tree_node_get_value(
+		     sub_node,
+		     (intptr_t **) &sub_single_file_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve value from sub node: %d.",
+			 function,
+			 sub_node_index );
+
+			return( -1 );
+		}
+		if( sub_single_file_entry == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing sub single file entry: %d.",
+			 function,
+			 sub_node_index );
+
+			return( -1 );
+		}
+		/* A sub single file entry without a name cannot be found by name
+		 */
+		if( sub_single_file_entry->name != NULL )
+		{
+			if( libewf_single_file_name_index_get_utf8_string_hash(
+			     sub_single_file_entry->name,
+			     sub_single_file_entry->name_size,
+			     &hash,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve hash of name of sub single file entry: %d.",
+				 function,
+				 sub_node_index );
+
+				return( -1 );
+			}
+			bucket_index = hash & bucket_mask;
+
+			while( name_index->sub_nodes[ bucket_index ] != NULL )
+			{
+				bucket_index = ( bucket_index + 1 ) & bucket_mask;
+			}
+			name_index->hashes[ bucket_index ]    = hash;
+			name_index->sub_nodes[ bucket_index ] = sub_node;
+		}
+		if( libcdata_tree_node_get_next_node(
+		     sub_node,
+		     &sub_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next node from sub node: %d.",
+			 function,
+			 sub_node_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves the sub node for the specific UTF-8 formatted name
+ * Returns 1 if successful, 0 if no such sub node or -1 on error
+ */
+int libewf_single_file_name_index_get_sub_node_by_utf8_name(
+     libewf_single_file_name_index_t *name_index,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libcdata_tree_node_t **sub_node,
+     libcerror_error_t **error )
+{
+	libewf_single_file_entry_t *sub_single_file_entry = NULL;
+	static char *function                             = "libewf_single_file_name_index_get_sub_node_by_utf8_name";
+	uint32_t bucket_index                             = 0;
+	uint32_t bucket_mask                              = 0;
+	uint32_t hash                                     = 0;
+	int result                                        = 0;
+
+	if( name_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name index.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( name_index->hashes == NULL )
+	 || ( name_index->sub_nodes == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid name index - missing buckets.",
+		 function );
+
+		return( -1 );
+	}
+	if( sub_node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sub node.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_single_file_name_index_get_utf8_string_hash(
+	     utf8_string,
+	     utf8_string_length,
+	     &hash,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve hash of UTF-8 string.",
+		 function );
+
+		return( -1 );
+	}
+	bucket_mask  = name_index->number_of_buckets - 1;
+	bucket_index = hash & bucket_mask;
+
+	while( name_index->sub_nodes[ bucket_index ] != NULL )
+	{
+		if( name_index->hashes[ bucket_index ] == hash )
+		{
+			if( libcdata_tree_node_get_value(
+			     name_index->sub_nodes[ bucket_index ],
+			     (intptr_t **) &sub_single_file_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve value from sub node: %" PRIu32 ".",
+				 function,
+				 bucket_index );
+
+				return( -1 );
+			}
+			if( sub_single_file_entry == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing sub single file entry: %" PRIu32 ".",
+				 function,
+				 bucket_index );
+
+				return( -1 );
+			}
+			result = libuna_utf8_string_compare_with_utf8_stream(
+				  utf8_string,
+				  utf8_string_length,
+				  sub_single_file_entry->name,
+				  sub_single_file_entry->name_size,
+				  error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to compare UTF-8 string.",
+				 function );
+
+				return( -1 );
+			}
+			else if( result != 0 )
+			{
+				*sub_node = name_index->sub_nodes[ bucket_index ];
+
+				return( 1 );
+			}
+		}
+		bucket_index = ( bucket_index + 1 ) & bucket_mask;
+	}
+	*sub_node = NULL;
+
+	return( 0 );
+}
+
+/* Retrieves the sub node for the specific UTF-16 formatted name
+ * Returns 1 if successful, 0 if no such sub node or -1 on error
+ */
+int libewf_single_file_name_index_get_sub_node_by_utf16_name(
+     libewf_single_file_name_index_t *name_index,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     libcdata_tree_node_t **sub_node,
+     libcerror_error_t **error )
+{
+	libewf_single_file_entry_t *sub_single_file_entry = NULL;
+	static char *function                             = "libewf_single_file_name_index_get_sub_node_by_utf16_name";
+	uint32_t bucket_index                             = 0;
+	uint32_t bucket_mask                              = 0;
+	uint32_t hash                                     = 0;
+	int result                                        = 0;
+
+	if( name_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name index.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( name_index->hashes == NULL )
+	 || ( name_index->sub_nodes == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid name index - missing buckets.",
+		 function );
+
+		return( -1 );
+	}
+	if( sub_node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sub node.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_single_file_name_index_get_utf16_string_hash(
+	     utf16_string,
+	     utf16_string_length,
+	     &hash,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve hash of UTF-16 string.",
+		 function );
+
+		return( -1 );
+	}
+	bucket_mask  = name_index->number_of_buckets - 1;
+	bucket_index = hash & bucket_mask;
+
+	while( name_index->sub_nodes[ bucket_index ] != NULL )
+	{
+		if( name_index->hashes[ bucket_index ] == hash )
+		{
+			if( libcdata_tree_node_get_value(
+			     name_index->sub_nodes[ bucket_index ],
+			     (intptr_t **) &sub_single_file_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve value from sub node: %" PRIu32 ".",
+				 function,
+				 bucket_index );
+
+				return( -1 );
+			}
+			if( sub_single_file_entry == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing sub single file entry: %" PRIu32 ".",
+				 function,
+				 bucket_index );
+
+				return( -1 );
+			}
+			result = libuna_utf16_string_compare_with_utf8_stream(
+				  utf16_string,
+				  utf16_string_length,
+				  sub_single_file_entry->name,
+				  sub_single_file_entry->name_size,
+				  error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to compare UTF-16 string.",
+				 function );
+
+				return( -1 );
+			}
+			else if( result != 0 )
+			{
+				*sub_node = name_index->sub_nodes[ bucket_index ];
+
+				return( 1 );
+			}
+		}
+		bucket_index = ( bucket_index + 1 ) & bucket_mask;
+	}
+	*sub_node = NULL;
+
+	return( 0 );
+}
+
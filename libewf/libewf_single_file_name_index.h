@@ -0,0 +1,110 @@
+/*
+ * Single file name index functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_SINGLE_FILE_NAME_INDEX_H )
+#define _LIBEWF_SINGLE_FILE_NAME_INDEX_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcdata.h"
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The minimum number of sub nodes for which a name index is built,
+ * directories with fewer sub nodes are searched linearly
+ */
+#define LIBEWF_SINGLE_FILE_NAME_INDEX_MINIMUM_NUMBER_OF_SUB_NODES	32
+
+/* The maximum number of sub nodes for which a name index is built
+ */
+#define LIBEWF_SINGLE_FILE_NAME_INDEX_MAXIMUM_NUMBER_OF_SUB_NODES	( 16 * 1024 * 1024 )
+
+typedef struct libewf_single_file_name_index libewf_single_file_name_index_t;
+
+/* The name index is an open addressing hash table of the sub nodes of
+ * a single file entry node. The hash is calculated over the Unicode
+ * characters of the name so that UTF-8 and UTF-16 names map to the same bucket
+ */
+struct libewf_single_file_name_index
+{
+	/* The number of buckets, which is a power of 2
+	 */
+	uint32_t number_of_buckets;
+
+	/* The name hashes of the buckets
+	 */
+	uint32_t *hashes;
+
+	/* The sub nodes of the buckets, NULL if the bucket is empty
+	 */
+	libcdata_tree_node_t **sub_nodes;
+};
+
+int libewf_single_file_name_index_initialize(
+     libewf_single_file_name_index_t **name_index,
+     int number_of_sub_nodes,
+     libcerror_error_t **error );
+
+int libewf_single_file_name_index_free(
+     libewf_single_file_name_index_t **name_index,
+     libcerror_error_t **error );
+
+int libewf_single_file_name_index_get_utf8_string_hash(
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     uint32_t *hash,
+     libcerror_error_t **error );
+
+int libewf_single_file_name_index_get_utf16_string_hash(
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     uint32_t *hash,
+     libcerror_error_t **error );
+
+int libewf_single_file_name_index_build(
+     libewf_single_file_name_index_t *name_index,
+     libcdata_tree_node_t *node,
+     libcerror_error_t **error );
+
+int libewf_single_file_name_index_get_sub_node_by_utf8_name(
+     libewf_single_file_name_index_t *name_index,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libcdata_tree_node_t **sub_node,
+     libcerror_error_t **error );
+
+int libewf_single_file_name_index_get_sub_node_by_utf16_name(
+     libewf_single_file_name_index_t *name_index,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     libcdata_tree_node_t **sub_node,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_SINGLE_FILE_NAME_INDEX_H ) */
+
@@ -20,6 +20,7 @@
  */
 
 #include <common.h>
+#include <byte_stream.h>
 #include <memory.h>
 #include <narrow_string.h>
 #include <types.h>
@@ -28,9 +29,12 @@
 #include "libewf_libcdata.h"
 #include "libewf_libcerror.h"
 #include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
 #include "libewf_libfvalue.h"
 #include "libewf_libuna.h"
 #include "libewf_single_file_entry.h"
+#include "libewf_single_file_name_index.h"
+#include "libewf_single_file_tree.h"
 #include "libewf_single_files.h"
 
 /* Creates single files
@@ -93,6 +97,21 @@ int libewf_single_files_initialize(
 
 		goto on_error;
 	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *single_files )->lookup_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize lookup mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	return( 1 );
 
 on_error:
@@ -114,6 +133,7 @@ int libewf_single_files_free(
      libcerror_error_t **error )
 {
 	static char *function = "libewf_single_files_free";
+	int cache_index       = 0;
 	int result            = 1;
 
 	if( single_files == NULL )
@@ -151,6 +171,62 @@ int libewf_single_files_free(
 				result = -1;
 			}
 		}
+		if( ( *single_files )->types != NULL )
+		{
+			if( libfvalue_split_utf8_string_free(
+			     &( ( *single_files )->types ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free split types.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *single_files )->record_offsets != NULL )
+		{
+			memory_free(
+			 ( *single_files )->record_offsets );
+		}
+		if( ( *single_files )->record_number_of_descendants != NULL )
+		{
+			memory_free(
+			 ( *single_files )->record_number_of_descendants );
+		}
+		if( ( *single_files )->path_cache != NULL )
+		{
+			for( cache_index = 0;
+			     cache_index < LIBEWF_SINGLE_FILES_PATH_CACHE_SIZE;
+			     cache_index++ )
+			{
+				if( ( *single_files )->path_cache[ cache_index ].path != NULL )
+				{
+					memory_free(
+					 ( *single_files )->path_cache[ cache_index ].path );
+				}
+			}
+			memory_free(
+			 ( *single_files )->path_cache );
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *single_files )->lookup_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free lookup mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
 		memory_free(
 		 *single_files );
 
@@ -160,6 +236,8 @@ int libewf_single_files_free(
 }
 
 /* Parse an EWF ltree for the values
+ * Only the header and the root single file entry are parsed, the ltree records
+ * are indexed so that the sub file entries can be read on demand
  * Returns 1 if successful or -1 on error
  */
 int libewf_single_files_parse(
@@ -168,9 +246,16 @@ int libewf_single_files_parse(
      uint8_t *format,
      libcerror_error_t **error )
 {
-	uint8_t *file_entries_string    = NULL;
-	static char *function           = "libewf_single_files_parse";
-	size_t file_entries_string_size = 0;
+	libewf_single_file_entry_t *single_file_entry = NULL;
+	libfvalue_split_utf8_string_t *lines          = NULL;
+	uint8_t *header_string                        = NULL;
+	uint8_t *line_string                          = NULL;
+	static char *function                         = "libewf_single_files_parse";
+	size_t header_string_size                     = 0;
+	size_t line_string_size                       = 0;
+	size_t records_offset                         = 0;
+	int line_index                                = 0;
+	int result                                    = 0;
 
 	if( single_files == NULL )
 	{
@@ -194,41 +279,89 @@ int libewf_single_files_parse(
 
 		return( -1 );
 	}
+	if( single_files->root_file_entry_node != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid single files - root file entry node value already set.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_single_files_get_records_offset(
+	          single_files,
+	          &records_offset,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve records offset.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		/* Without an entries line there are no records to index
+		 */
+		if( libewf_single_files_parse_ltree_data(
+		     single_files,
+		     media_size,
+		     format,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+			 LIBCERROR_CONVERSION_ERROR_GENERIC,
+			 "%s: unable to parse ltree data.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
 	if( libuna_utf8_string_size_from_utf16_stream(
 	     single_files->ltree_data,
-	     single_files->ltree_data_size,
+	     records_offset,
 	     LIBUNA_ENDIAN_LITTLE,
-	     &file_entries_string_size,
+	     &header_string_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
 		 LIBCERROR_CONVERSION_ERROR_GENERIC,
-		 "%s: unable to determine file entries string size.",
+		 "%s: unable to determine header string size.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	file_entries_string = (uint8_t *) memory_allocate(
-	                                   sizeof( uint8_t ) * (size_t) file_entries_string_size );
+	header_string = (uint8_t *) memory_allocate(
+	                             sizeof( uint8_t ) * (size_t) header_string_size );
 
-	if( file_entries_string == NULL )
+	if( header_string == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_MEMORY,
 		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create file entries string.",
+		 "%s: unable to create header string.",
 		 function );
 
 		goto on_error;
 	}
 	if( libuna_utf8_string_copy_from_utf16_stream(
-	     file_entries_string,
-	     file_entries_string_size,
+	     header_string,
+	     header_string_size,
 	     single_files->ltree_data,
-	     single_files->ltree_data_size,
+	     records_offset,
 	     LIBUNA_ENDIAN_LITTLE,
 	     error ) != 1 )
 	{
@@ -236,420 +369,199 @@ int libewf_single_files_parse(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
 		 LIBCERROR_CONVERSION_ERROR_GENERIC,
-		 "%s: unable to set file entries string.",
+		 "%s: unable to set header string.",
 		 function );
 
 		goto on_error;
 	}
-	if( libewf_single_files_parse_file_entries(
-	     single_files,
+	if( libfvalue_utf8_string_split(
+	     header_string,
+	     header_string_size - 1,
+	     (uint8_t) '\n',
+	     &lines,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to split header string into lines.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_single_files_parse_header(
 	     media_size,
-	     file_entries_string,
-	     file_entries_string_size,
-	     format,
+	     lines,
+	     &line_index,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
 		 LIBCERROR_CONVERSION_ERROR_GENERIC,
-		 "%s: unable to parse file entries string.",
+		 "%s: unable to parse header.",
 		 function );
 
 		goto on_error;
 	}
-	memory_free(
-	 file_entries_string );
+	if( libfvalue_split_utf8_string_get_segment_by_index(
+	     lines,
+	     line_index,
+	     &line_string,
+	     &line_string_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve line string: %d.",
+		 function,
+		 line_index );
 
-	return( 1 );
+		goto on_error;
+	}
+	if( libfvalue_utf8_string_split(
+	     line_string,
+	     line_string_size,
+	     (uint8_t) '\t',
+	     &( single_files->types ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to split entries string into types.",
+		 function );
 
-on_error:
-	if( file_entries_string != NULL )
+		goto on_error;
+	}
+	if( libfvalue_split_utf8_string_free(
+	     &lines,
+	     error ) != 1 )
 	{
-		memory_free(
-		 file_entries_string );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free split lines.",
+		 function );
+
+		goto on_error;
 	}
-	return( -1 );
-}
+	memory_free(
+	 header_string );
 
-/* Parse a single file entries string for the values
- * Returns 1 if successful or -1 on error
- */
-int libewf_single_files_parse_file_entries(
-     libewf_single_files_t *single_files,
-     size64_t *media_size,
-     const uint8_t *entries_string,
-     size_t entries_string_size,
-     uint8_t *format,
-     libcerror_error_t **error )
-{
-	libfvalue_split_utf8_string_t *lines = NULL;
-	libfvalue_split_utf8_string_t *types = NULL;
-	uint8_t *line_string                 = NULL;
-	static char *function                = "libewf_single_files_parse_file_entries";
-	size_t line_string_size              = 0;
-	int line_index                       = 0;
-	int number_of_lines                  = 0;
+	header_string = NULL;
 
-	if( single_files == NULL )
+	if( libewf_single_files_get_format_from_types(
+	     single_files->types,
+	     format,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid single files.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve format from types.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( entries_string == NULL )
+	if( libewf_single_files_index_records(
+	     single_files,
+	     records_offset,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid entries string.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to index records.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( libfvalue_utf8_string_split(
-	     entries_string,
-	     entries_string_size - 1,
-	     (uint8_t) '\n',
-	     &lines,
+	if( libewf_single_files_read_record(
+	     single_files,
+	     0,
+	     &single_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read root record.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_tree_node_initialize(
+	     &( single_files->root_file_entry_node ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to split entries string into lines.",
+		 "%s: unable to create root single file entry node.",
 		 function );
 
 		goto on_error;
 	}
-	if( libfvalue_split_utf8_string_get_number_of_segments(
-	     lines,
-	     &number_of_lines,
+	if( libcdata_tree_node_set_value(
+	     single_files->root_file_entry_node,
+	     (intptr_t *) single_file_entry,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of lines",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set single file entry in root node.",
 		 function );
 
 		goto on_error;
 	}
-	if( number_of_lines > 0 )
+	return( 1 );
+
+on_error:
+	if( single_files->root_file_entry_node != NULL )
 	{
-		if( libfvalue_split_utf8_string_get_segment_by_index(
-		     lines,
-		     0,
-		     &line_string,
-		     &line_string_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve line string: 0.",
-			 function );
+		libcdata_tree_node_free(
+		 &( single_files->root_file_entry_node ),
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_single_file_entry_free,
+		 NULL );
+	}
+	if( single_file_entry != NULL )
+	{
+		libewf_single_file_entry_free(
+		 &single_file_entry,
+		 NULL );
+	}
+	if( single_files->record_number_of_descendants != NULL )
+	{
+		memory_free(
+		 single_files->record_number_of_descendants );
 
-			goto on_error;
-		}
-		if( ( line_string == NULL )
-		 || ( line_string_size < 2 )
-		 || ( line_string[ 0 ] == 0 ) )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing line string: 0.",
-			 function );
-
-			goto on_error;
-		}
-		/* Remove trailing carriage return
-		 */
-		else if( line_string[ line_string_size - 2 ] == (uint8_t) '\r' )
-		{
-			line_string[ line_string_size - 2 ] = 0;
-
-			line_string_size -= 1;
-		}
-		if( line_string_size != 2 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-			 "%s: unsupported single file entries string.",
-			 function );
-
-			goto on_error;
-		}
-		if( ( line_string[ 0 ] < (uint8_t) '0' )
-		 || ( line_string[ 0 ] > (uint8_t) '9' ) )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-			 "%s: unsupported single file entries string.",
-			 function );
-
-			goto on_error;
-		}
-		/* Find the line containing: "rec"
-		 */
-		for( line_index = 0;
-		     line_index < number_of_lines;
-		     line_index++ )
-		{
-			if( libfvalue_split_utf8_string_get_segment_by_index(
-			     lines,
-			     line_index,
-			     &line_string,
-			     &line_string_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve line string: %d.",
-				 function,
-				 line_index );
-
-				goto on_error;
-			}
-			if( line_string_size == 4 )
-			{
-				if( line_string == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-					 "%s: missing line string: %d.",
-					 function,
-					 line_index );
-
-					goto on_error;
-				}
-				if( ( line_string[ 0 ] == (uint8_t) 'r' )
-				 && ( line_string[ 1 ] == (uint8_t) 'e' )
-				 && ( line_string[ 2 ] == (uint8_t) 'c' ) )
-				{
-					line_index += 1;
-
-					break;
-				}
-			}
-		}
-		if( libewf_single_files_parse_record_values(
-		     media_size,
-		     lines,
-		     &line_index,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_CONVERSION,
-			 LIBCERROR_CONVERSION_ERROR_GENERIC,
-			 "%s: unable to parse record values.",
-			 function );
-
-			goto on_error;
-		}
-		/* Find the line containing: "entry"
-		 */
-		for( line_index = 0;
-		     line_index < number_of_lines;
-		     line_index++ )
-		{
-			if( libfvalue_split_utf8_string_get_segment_by_index(
-			     lines,
-			     line_index,
-			     &line_string,
-			     &line_string_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve line string: %d.",
-				 function,
-				 line_index );
-
-				goto on_error;
-			}
-			if( line_string_size == 6 )
-			{
-				if( line_string == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-					 "%s: missing line string: %d.",
-					 function,
-					 line_index );
-
-					goto on_error;
-				}
-				if( ( line_string[ 0 ] == (uint8_t) 'e' )
-				 && ( line_string[ 1 ] == (uint8_t) 'n' )
-				 && ( line_string[ 2 ] == (uint8_t) 't' )
-				 && ( line_string[ 3 ] == (uint8_t) 'r' )
-				 && ( line_string[ 4 ] == (uint8_t) 'y' ) )
-				{
-					line_index += 2;
-
-					break;
-				}
-			}
-		}
-		if( line_index < number_of_lines )
-		{
-			if( libfvalue_split_utf8_string_get_segment_by_index(
-			     lines,
-			     line_index,
-			     &line_string,
-			     &line_string_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve line string: %d.",
-				 function,
-				 line_index );
-
-				goto on_error;
-			}
-			line_index += 1;
-
-			if( libfvalue_utf8_string_split(
-			     line_string,
-			     line_string_size,
-			     (uint8_t) '\t',
-			     &types,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to split entries string into types.",
-				 function );
-
-				goto on_error;
-			}
-			if( libcdata_tree_node_initialize(
-			     &( single_files->root_file_entry_node ),
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to create root single file entry node.",
-				 function );
-
-				goto on_error;
-			}
-			if( libewf_single_files_parse_file_entry(
-			     single_files->root_file_entry_node,
-			     lines,
-			     &line_index,
-			     types,
-			     format,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_CONVERSION,
-				 LIBCERROR_CONVERSION_ERROR_GENERIC,
-				 "%s: unable to parse file entry.",
-				 function );
-
-				goto on_error;
-			}
-			/* The single files entries should be followed by an empty line
-			 */
-			if( libfvalue_split_utf8_string_get_segment_by_index(
-			     lines,
-			     line_index,
-			     &line_string,
-			     &line_string_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve line string: %d.",
-				 function,
-				 line_index );
-
-				goto on_error;
-			}
-			if( ( line_string_size != 1 )
-			 || ( line_string[ 0 ] != 0 ) )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-				 "%s: unsupported empty line string: %d - not empty.",
-				 function,
-				 line_index );
-
-				goto on_error;
-			}
-		}
-		if( libfvalue_split_utf8_string_free(
-		     &types,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free split types.",
-			 function );
-
-			goto on_error;
-		}
+		single_files->record_number_of_descendants = NULL;
 	}
-	if( libfvalue_split_utf8_string_free(
-	     &lines,
-	     error ) != 1 )
+	if( single_files->record_offsets != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free split lines.",
-		 function );
+		memory_free(
+		 single_files->record_offsets );
 
-		goto on_error;
+		single_files->record_offsets = NULL;
 	}
-	return( 1 );
+	single_files->number_of_records = 0;
 
-on_error:
-	if( types != NULL )
+	if( single_files->types != NULL )
 	{
 		libfvalue_split_utf8_string_free(
-		 &types,
+		 &( single_files->types ),
 		 NULL );
 	}
 	if( lines != NULL )
@@ -658,106 +570,176 @@ on_error:
 		 &lines,
 		 NULL );
 	}
+	if( header_string != NULL )
+	{
+		memory_free(
+		 header_string );
+	}
 	return( -1 );
 }
 
-/* Parse a record string for the values
+/* Parse an EWF ltree for the values
+ * All the single file entries are parsed at once
  * Returns 1 if successful or -1 on error
  */
-int libewf_single_files_parse_record_values(
+int libewf_single_files_parse_ltree_data(
+     libewf_single_files_t *single_files,
      size64_t *media_size,
-     libfvalue_split_utf8_string_t *lines,
-     int *line_index,
+     uint8_t *format,
      libcerror_error_t **error )
 {
-	libfvalue_split_utf8_string_t *types  = NULL;
-	libfvalue_split_utf8_string_t *values = NULL;
-	uint8_t *line_string                  = NULL;
-	uint8_t *type_string                  = NULL;
-	uint8_t *value_string                 = NULL;
-	static char *function                 = "libewf_single_files_parse_record_values";
-	size_t line_string_size               = 0;
-	size_t type_string_size               = 0;
-	size_t value_string_size              = 0;
-	uint64_t value_64bit                  = 0;
-	int number_of_types                   = 0;
-	int number_of_values                  = 0;
-	int value_index                       = 0;
+	uint8_t *file_entries_string    = NULL;
+	static char *function           = "libewf_single_files_parse_ltree_data";
+	size_t file_entries_string_size = 0;
 
-	if( media_size == NULL )
+	if( single_files == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid media size.",
+		 "%s: invalid single files.",
 		 function );
 
 		return( -1 );
 	}
-	if( line_index == NULL )
+	if( single_files->ltree_data == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid line index.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid single files - missing ltree data.",
 		 function );
 
 		return( -1 );
 	}
-	if( libfvalue_split_utf8_string_get_segment_by_index(
-	     lines,
-	     *line_index,
-	     &line_string,
-	     &line_string_size,
+	if( libuna_utf8_string_size_from_utf16_stream(
+	     single_files->ltree_data,
+	     single_files->ltree_data_size,
+	     LIBUNA_ENDIAN_LITTLE,
+	     &file_entries_string_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve line string: %d.",
-		 function,
-		 *line_index );
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to determine file entries string size.",
+		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	*line_index += 1;
-
-	if( libfvalue_utf8_string_split(
-	     line_string,
-	     line_string_size,
-	     (uint8_t) '\t',
-	     &types,
+	file_entries_string = (uint8_t *) memory_allocate(
+	                                   sizeof( uint8_t ) * (size_t) file_entries_string_size );
+
+	if( file_entries_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create file entries string.",
+		 function );
+
+		goto on_error;
+	}
+	if( libuna_utf8_string_copy_from_utf16_stream(
+	     file_entries_string,
+	     file_entries_string_size,
+	     single_files->ltree_data,
+	     single_files->ltree_data_size,
+	     LIBUNA_ENDIAN_LITTLE,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to split entries string into types.",
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to set file entries string.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_single_files_parse_file_entries(
+	     single_files,
+	     media_size,
+	     file_entries_string,
+	     file_entries_string_size,
+	     format,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to parse file entries string.",
 		 function );
 
 		goto on_error;
 	}
+	memory_free(
+	 file_entries_string );
+
+	return( 1 );
+
+on_error:
+	if( file_entries_string != NULL )
+	{
+		memory_free(
+		 file_entries_string );
+	}
+	return( -1 );
+}
+
+/* Parse the header lines of a single file entries string for the record values
+ * On return types line index contains the index of the line with the types of the entries
+ * Returns 1 if successful, 0 if no entries line was found or -1 on error
+ */
+int libewf_single_files_parse_header(
+     size64_t *media_size,
+     libfvalue_split_utf8_string_t *lines,
+     int *types_line_index,
+     libcerror_error_t **error )
+{
+	uint8_t *line_string    = NULL;
+	static char *function   = "libewf_single_files_parse_header";
+	size_t line_string_size = 0;
+	int line_index          = 0;
+	int number_of_lines     = 0;
+
+	if( types_line_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid types line index.",
+		 function );
+
+		return( -1 );
+	}
 	if( libfvalue_split_utf8_string_get_number_of_segments(
-	     types,
-	     &number_of_types,
+	     lines,
+	     &number_of_lines,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of types",
+		 "%s: unable to retrieve number of lines",
 		 function );
 
-		goto on_error;
+		return( -1 );
+	}
+	if( number_of_lines == 0 )
+	{
+		return( 0 );
 	}
 	if( libfvalue_split_utf8_string_get_segment_by_index(
 	     lines,
-	     *line_index,
+	     0,
 	     &line_string,
 	     &line_string_size,
 	     error ) != 1 )
@@ -766,433 +748,587 @@ int libewf_single_files_parse_record_values(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve line string: %d.",
-		 function,
-		 *line_index );
+		 "%s: unable to retrieve line string: 0.",
+		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	*line_index += 1;
-
-	if( libfvalue_utf8_string_split(
-	     line_string,
-	     line_string_size,
-	     (uint8_t) '\t',
-	     &values,
-	     error ) != 1 )
+	if( ( line_string == NULL )
+	 || ( line_string_size < 2 )
+	 || ( line_string[ 0 ] == 0 ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to split entries string into values.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing line string: 0.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfvalue_split_utf8_string_get_number_of_segments(
-	     values,
-	     &number_of_values,
-	     error ) != 1 )
+	/* Remove trailing carriage return
+	 */
+	else if( line_string[ line_string_size - 2 ] == (uint8_t) '\r' )
+	{
+		line_string[ line_string_size - 2 ] = 0;
+
+		line_string_size -= 1;
+	}
+	if( line_string_size != 2 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of values",
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported single file entries string.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-#if defined( HAVE_VERBOSE_OUTPUT )
-	if( number_of_types != number_of_values )
+	if( ( line_string[ 0 ] < (uint8_t) '0' )
+	 || ( line_string[ 0 ] > (uint8_t) '9' ) )
 	{
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_printf(
-			"%s: mismatch in number of types and values.\n",
-			 function );
-		}
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported single file entries string.",
+		 function );
+
+		return( -1 );
 	}
-#endif
-	for( value_index = 0;
-	     value_index < number_of_types;
-	     value_index++ )
+	/* Find the line containing: "rec"
+	 */
+	for( line_index = 0;
+	     line_index < number_of_lines;
+	     line_index++ )
 	{
 		if( libfvalue_split_utf8_string_get_segment_by_index(
-		     types,
-		     value_index,
-		     &type_string,
-		     &type_string_size,
+		     lines,
+		     line_index,
+		     &line_string,
+		     &line_string_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve type string: %d.",
-			 function,
-			 value_index );
-
-			goto on_error;
-		}
-		if( ( type_string == NULL )
-		 || ( type_string_size < 2 )
-		 || ( type_string[ 0 ] == 0 ) )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing type string: %d.",
+			 "%s: unable to retrieve line string: %d.",
 			 function,
-			 value_index );
-
-			goto on_error;
-		}
-		/* Remove trailing carriage return
-		 */
-		else if( type_string[ type_string_size - 2 ] == (uint8_t) '\r' )
-		{
-			type_string[ type_string_size - 2 ] = 0;
+			 line_index );
 
-			type_string_size -= 1;
+			return( -1 );
 		}
-		if( value_index < number_of_values )
+		if( line_string_size == 4 )
 		{
-			if( libfvalue_split_utf8_string_get_segment_by_index(
-			     values,
-			     value_index,
-			     &value_string,
-			     &value_string_size,
-			     error ) != 1 )
+			if( line_string == NULL )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve value string: %d.",
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing line string: %d.",
 				 function,
-				 value_index );
-
-				goto on_error;
-			}
-			if( ( value_string == NULL )
-			 || ( value_string_size < 2 )
-			 || ( value_string[ 0 ] == 0 ) )
-			{
-				value_string      = NULL;
-				value_string_size = 0;
-			}
-			/* Remove trailing carriage return
-			 */
-			else if( value_string[ value_string_size - 2 ] == (uint8_t) '\r' )
-			{
-				value_string[ value_string_size - 2 ] = 0;
+				 line_index );
 
-				value_string_size -= 1;
-			}
-		}
-		else
-		{
-			value_string      = NULL;
-			value_string_size = 0;
-		}
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_printf(
-			 "%s: type: %s with value: %s.\n",
-			 function,
-			 (char *) type_string,
-			 (char *) value_string );
-		}
-#endif
-		/* Ignore empty values
-		 */
-		if( value_string == NULL )
-		{
-			continue;
-		}
-		if( type_string_size == 3 )
-		{
-			if( ( type_string[ 0 ] == (uint8_t) 'c' )
-			 && ( type_string[ 1 ] == (uint8_t) 'l' ) )
-			{
+				return( -1 );
 			}
-			else if( ( type_string[ 0 ] == (uint8_t) 't' )
-			      && ( type_string[ 1 ] == (uint8_t) 'b' ) )
+			if( ( line_string[ 0 ] == (uint8_t) 'r' )
+			 && ( line_string[ 1 ] == (uint8_t) 'e' )
+			 && ( line_string[ 2 ] == (uint8_t) 'c' ) )
 			{
-				if( libfvalue_utf8_string_copy_to_integer(
-				     value_string,
-				     value_string_size,
-				     &value_64bit,
-				     64,
-				     LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_MEMORY,
-					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-					 "%s: unable to set media size.",
-					 function );
+				line_index += 1;
 
-					goto on_error;
-				}
-				*media_size = (size64_t) value_64bit;
+				break;
 			}
 		}
 	}
-	if( libfvalue_split_utf8_string_free(
-	     &values,
+	if( libewf_single_files_parse_record_values(
+	     media_size,
+	     lines,
+	     &line_index,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free split values.",
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to parse record values.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfvalue_split_utf8_string_free(
-	     &types,
-	     error ) != 1 )
+	/* Find the line containing: "entry"
+	 */
+	for( line_index = 0;
+	     line_index < number_of_lines;
+	     line_index++ )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free split types.",
-		 function );
+		if( libfvalue_split_utf8_string_get_segment_by_index(
+		     lines,
+		     line_index,
+		     &line_string,
+		     &line_string_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve line string: %d.",
+			 function,
+			 line_index );
 
-		goto on_error;
-	}
-	return( 1 );
+			return( -1 );
+		}
+		if( line_string_size == 6 )
+		{
+			if( line_string == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing line string: %d.",
+				 function,
+				 line_index );
 
-on_error:
-	if( values != NULL )
-	{
-		libfvalue_split_utf8_string_free(
-		 &values,
-		 NULL );
+				return( -1 );
+			}
+			if( ( line_string[ 0 ] == (uint8_t) 'e' )
+			 && ( line_string[ 1 ] == (uint8_t) 'n' )
+			 && ( line_string[ 2 ] == (uint8_t) 't' )
+			 && ( line_string[ 3 ] == (uint8_t) 'r' )
+			 && ( line_string[ 4 ] == (uint8_t) 'y' ) )
+			{
+				line_index += 2;
+
+				break;
+			}
+		}
 	}
-	if( types != NULL )
+	if( line_index >= number_of_lines )
 	{
-		libfvalue_split_utf8_string_free(
-		 &types,
-		 NULL );
+		return( 0 );
 	}
-	return( -1 );
+	*types_line_index = line_index;
+
+	return( 1 );
 }
 
-/* Parse a single file entry string for the values
+/* Parse a single file entries string for the values
  * Returns 1 if successful or -1 on error
  */
-int libewf_single_files_parse_file_entry(
-     libcdata_tree_node_t *parent_file_entry_node,
-     libfvalue_split_utf8_string_t *lines,
-     int *line_index,
-     libfvalue_split_utf8_string_t *types,
+int libewf_single_files_parse_file_entries(
+     libewf_single_files_t *single_files,
+     size64_t *media_size,
+     const uint8_t *entries_string,
+     size_t entries_string_size,
      uint8_t *format,
      libcerror_error_t **error )
 {
-	libewf_single_file_entry_t *single_file_entry = NULL;
-	libfvalue_split_utf8_string_t *values         = NULL;
-	libcdata_tree_node_t *file_entry_node         = NULL;
-	uint8_t *line_string                          = NULL;
-	uint8_t *type_string                          = NULL;
-	uint8_t *value_string                         = NULL;
-	static char *function                         = "libewf_single_files_parse_file_entry";
-	size_t line_string_size                       = 0;
-	size_t type_string_size                       = 0;
-	size_t value_string_size                      = 0;
-	size_t value_string_index                     = 0;
-	uint64_t number_of_sub_entries                = 0;
-	uint64_t value_64bit                          = 0;
-	int number_of_lines                           = 0;
-	int number_of_types                           = 0;
-	int number_of_values                          = 0;
-	int value_index                               = 0;
-	int zero_values_only                          = 0;
-
-	if( parent_file_entry_node == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid parent file entry node.",
-		 function );
+	libfvalue_split_utf8_string_t *lines = NULL;
+	libfvalue_split_utf8_string_t *types = NULL;
+	uint8_t *line_string                 = NULL;
+	static char *function                = "libewf_single_files_parse_file_entries";
+	size_t line_string_size              = 0;
+	int line_index                       = 0;
+	int result                           = 0;
 
-		return( -1 );
-	}
-	if( line_index == NULL )
+	if( single_files == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid line index.",
+		 "%s: invalid single files.",
 		 function );
 
 		return( -1 );
 	}
-	if( format == NULL )
+	if( entries_string == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid format.",
+		 "%s: invalid entries string.",
 		 function );
 
 		return( -1 );
 	}
-	if( libfvalue_split_utf8_string_get_number_of_segments(
-	     types,
-	     &number_of_types,
+	if( libfvalue_utf8_string_split(
+	     entries_string,
+	     entries_string_size - 1,
+	     (uint8_t) '\n',
+	     &lines,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of types",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to split entries string into lines.",
 		 function );
 
 		goto on_error;
 	}
-	if( libewf_single_files_parse_file_entry_number_of_sub_entries(
-	     lines,
-	     line_index,
-	     &number_of_sub_entries,
-	     error ) != 1 )
+	result = libewf_single_files_parse_header(
+	          media_size,
+	          lines,
+	          &line_index,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
 		 LIBCERROR_CONVERSION_ERROR_GENERIC,
-		 "%s: unable to parse file entry number of sub entries.",
+		 "%s: unable to parse header.",
 		 function );
 
 		goto on_error;
 	}
-	if( libfvalue_split_utf8_string_get_segment_by_index(
-	     lines,
-	     *line_index,
-	     &line_string,
-	     &line_string_size,
-	     error ) != 1 )
+	else if( result != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve line string: %d.",
-		 function,
-		 *line_index );
-
-		goto on_error;
-	}
-	*line_index += 1;
+		if( libfvalue_split_utf8_string_get_segment_by_index(
+		     lines,
+		     line_index,
+		     &line_string,
+		     &line_string_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve line string: %d.",
+			 function,
+			 line_index );
 
-	if( libfvalue_utf8_string_split(
-	     line_string,
-	     line_string_size,
-	     (uint8_t) '\t',
-	     &values,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to split entries string into values.",
-		 function );
+			goto on_error;
+		}
+		line_index += 1;
 
-		goto on_error;
-	}
-	if( libfvalue_split_utf8_string_get_number_of_segments(
-	     values,
-	     &number_of_values,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of values",
-		 function );
+		if( libfvalue_utf8_string_split(
+		     line_string,
+		     line_string_size,
+		     (uint8_t) '\t',
+		     &types,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to split entries string into types.",
+			 function );
 
-		goto on_error;
-	}
-#if defined( HAVE_VERBOSE_OUTPUT )
-	if( number_of_types != number_of_values )
-	{
-		if( libcnotify_verbose != 0 )
+			goto on_error;
+		}
+		if( libcdata_tree_node_initialize(
+		     &( single_files->root_file_entry_node ),
+		     error ) != 1 )
 		{
-			libcnotify_printf(
-			"%s: mismatch in number of types and values.\n",
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create root single file entry node.",
 			 function );
+
+			goto on_error;
 		}
-	}
-#endif
-	if( libewf_single_file_entry_initialize(
-	     &single_file_entry,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create single file entry.",
-		 function );
+		if( libewf_single_files_parse_file_entry(
+		     single_files->root_file_entry_node,
+		     lines,
+		     &line_index,
+		     types,
+		     format,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+			 LIBCERROR_CONVERSION_ERROR_GENERIC,
+			 "%s: unable to parse file entry.",
+			 function );
 
-		goto on_error;
-	}
-	for( value_index = 0;
-	     value_index < number_of_types;
-	     value_index++ )
-	{
+			goto on_error;
+		}
+		/* The single files entries should be followed by an empty line
+		 */
 		if( libfvalue_split_utf8_string_get_segment_by_index(
-		     types,
-		     value_index,
-		     &type_string,
-		     &type_string_size,
+		     lines,
+		     line_index,
+		     &line_string,
+		     &line_string_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve type string: %d.",
+			 "%s: unable to retrieve line string: %d.",
 			 function,
-			 value_index );
+			 line_index );
 
 			goto on_error;
 		}
-		if( ( type_string == NULL )
-		 || ( type_string_size < 2 )
-		 || ( type_string[ 0 ] == 0 ) )
+		if( ( line_string_size != 1 )
+		 || ( line_string[ 0 ] != 0 ) )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing type string: %d.",
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported empty line string: %d - not empty.",
 			 function,
-			 value_index );
+			 line_index );
 
 			goto on_error;
 		}
-		/* Remove trailing carriage return
-		 */
-		else if( type_string[ type_string_size - 2 ] == (uint8_t) '\r' )
+		if( libfvalue_split_utf8_string_free(
+		     &types,
+		     error ) != 1 )
 		{
-			type_string[ type_string_size - 2 ] = 0;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free split types.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libfvalue_split_utf8_string_free(
+	     &lines,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free split lines.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( types != NULL )
+	{
+		libfvalue_split_utf8_string_free(
+		 &types,
+		 NULL );
+	}
+	if( lines != NULL )
+	{
+		libfvalue_split_utf8_string_free(
+		 &lines,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Parse a record string for the values
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_single_files_parse_record_values(
+     size64_t *media_size,
+     libfvalue_split_utf8_string_t *lines,
+     int *line_index,
+     libcerror_error_t **error )
+{
+	libfvalue_split_utf8_string_t *types  = NULL;
+	libfvalue_split_utf8_string_t *values = NULL;
+	uint8_t *line_string                  = NULL;
+	uint8_t *type_string                  = NULL;
+	uint8_t *value_string                 = NULL;
+	static char *function                 = "libewf_single_files_parse_record_values";
+	size_t line_string_size               = 0;
+	size_t type_string_size               = 0;
+	size_t value_string_size              = 0;
+	uint64_t value_64bit                  = 0;
+	int number_of_types                   = 0;
+	int number_of_values                  = 0;
+	int value_index                       = 0;
+
+	if( media_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media size.",
+		 function );
+
+		return( -1 );
+	}
+	if( line_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid line index.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfvalue_split_utf8_string_get_segment_by_index(
+	     lines,
+	     *line_index,
+	     &line_string,
+	     &line_string_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve line string: %d.",
+		 function,
+		 *line_index );
+
+		goto on_error;
+	}
+	*line_index += 1;
+
+	if( libfvalue_utf8_string_split(
+	     line_string,
+	     line_string_size,
+	     (uint8_t) '\t',
+	     &types,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to split entries string into types.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfvalue_split_utf8_string_get_number_of_segments(
+	     types,
+	     &number_of_types,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of types",
+		 function );
+
+		goto on_error;
+	}
+	if( libfvalue_split_utf8_string_get_segment_by_index(
+	     lines,
+	     *line_index,
+	     &line_string,
+	     &line_string_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve line string: %d.",
+		 function,
+		 *line_index );
+
+		goto on_error;
+	}
+	*line_index += 1;
+
+	if( libfvalue_utf8_string_split(
+	     line_string,
+	     line_string_size,
+	     (uint8_t) '\t',
+	     &values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to split entries string into values.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfvalue_split_utf8_string_get_number_of_segments(
+	     values,
+	     &number_of_values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of values",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_VERBOSE_OUTPUT )
+	if( number_of_types != number_of_values )
+	{
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			"%s: mismatch in number of types and values.\n",
+			 function );
+		}
+	}
+#endif
+	for( value_index = 0;
+	     value_index < number_of_types;
+	     value_index++ )
+	{
+		if( libfvalue_split_utf8_string_get_segment_by_index(
+		     types,
+		     value_index,
+		     &type_string,
+		     &type_string_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve type string: %d.",
+			 function,
+			 value_index );
+
+			goto on_error;
+		}
+		if( ( type_string == NULL )
+		 || ( type_string_size < 2 )
+		 || ( type_string[ 0 ] == 0 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing type string: %d.",
+			 function,
+			 value_index );
+
+			goto on_error;
+		}
+		/* Remove trailing carriage return
+		 */
+		else if( type_string[ type_string_size - 2 ] == (uint8_t) '\r' )
+		{
+			type_string[ type_string_size - 2 ] = 0;
 
 			type_string_size -= 1;
 		}
@@ -1246,21 +1382,20 @@ int libewf_single_files_parse_file_entry(
 			 (char *) value_string );
 		}
 #endif
+		/* Ignore empty values
+		 */
 		if( value_string == NULL )
 		{
-			/* Ignore empty values
-			 */
+			continue;
 		}
-		else if( type_string_size == 4 )
+		if( type_string_size == 3 )
 		{
 			if( ( type_string[ 0 ] == (uint8_t) 'c' )
-			 && ( type_string[ 1 ] == (uint8_t) 'i' )
-			 && ( type_string[ 2 ] == (uint8_t) 'd' ) )
+			 && ( type_string[ 1 ] == (uint8_t) 'l' ) )
 			{
 			}
-			else if( ( type_string[ 0 ] == (uint8_t) 'o' )
-			      && ( type_string[ 1 ] == (uint8_t) 'p' )
-			      && ( type_string[ 2 ] == (uint8_t) 'r' ) )
+			else if( ( type_string[ 0 ] == (uint8_t) 't' )
+			      && ( type_string[ 1 ] == (uint8_t) 'b' ) )
 			{
 				if( libfvalue_utf8_string_copy_to_integer(
 				     value_string,
@@ -1274,928 +1409,3292 @@ int libewf_single_files_parse_file_entry(
 					 error,
 					 LIBCERROR_ERROR_DOMAIN_MEMORY,
 					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-					 "%s: unable to set entry flags.",
+					 "%s: unable to set media size.",
 					 function );
 
 					goto on_error;
 				}
-				if( value_64bit > (uint64_t) UINT32_MAX )
-				{
-					libcerror_error_set(
-					 error,
+				*media_size = (size64_t) value_64bit;
+			}
+		}
+	}
+	if( libfvalue_split_utf8_string_free(
+	     &values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free split values.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfvalue_split_utf8_string_free(
+	     &types,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free split types.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( values != NULL )
+	{
+		libfvalue_split_utf8_string_free(
+		 &values,
+		 NULL );
+	}
+	if( types != NULL )
+	{
+		libfvalue_split_utf8_string_free(
+		 &types,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Parse a single file entry string for the values
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_single_files_parse_file_entry(
+     libcdata_tree_node_t *parent_file_entry_node,
+     libfvalue_split_utf8_string_t *lines,
+     int *line_index,
+     libfvalue_split_utf8_string_t *types,
+     uint8_t *format,
+     libcerror_error_t **error )
+{
+	libewf_single_file_entry_t *single_file_entry = NULL;
+	libcdata_tree_node_t *file_entry_node         = NULL;
+	static char *function                         = "libewf_single_files_parse_file_entry";
+	uint64_t number_of_sub_entries                = 0;
+	int number_of_lines                           = 0;
+
+	if( parent_file_entry_node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parent file entry node.",
+		 function );
+
+		return( -1 );
+	}
+	if( line_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid line index.",
+		 function );
+
+		return( -1 );
+	}
+	if( format == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid format.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_single_files_parse_file_entry_number_of_sub_entries(
+	     lines,
+	     line_index,
+	     &number_of_sub_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to parse file entry number of sub entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_single_file_entry_initialize(
+	     &single_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create single file entry.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_single_files_parse_file_entry_values(
+	     single_file_entry,
+	     lines,
+	     line_index,
+	     types,
+	     format,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to parse file entry values.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_tree_node_set_value(
+	     parent_file_entry_node,
+	     (intptr_t *) single_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set single file entry in node.",
+		 function );
+
+		goto on_error;
+	}
+	single_file_entry = NULL;
+
+	if( libfvalue_split_utf8_string_get_number_of_segments(
+	     lines,
+	     &number_of_lines,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of lines",
+		 function );
+
+		goto on_error;
+	}
+	if( ( *line_index + number_of_sub_entries ) > (uint64_t) number_of_lines )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: number of sub entries exceed the number of available lines.",
+		 function );
+
+		goto on_error;
+	}
+	while( number_of_sub_entries > 0 )
+	{
+		if( libcdata_tree_node_initialize(
+		     &file_entry_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create single file entry node.",
+			 function );
+
+			goto on_error;
+		}
+		if( libewf_single_files_parse_file_entry(
+		     file_entry_node,
+		     lines,
+		     line_index,
+		     types,
+		     format,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+			 LIBCERROR_CONVERSION_ERROR_GENERIC,
+			 "%s: unable to parse file entry.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcdata_tree_node_append_node(
+		     parent_file_entry_node,
+		     file_entry_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append single file entry node to parent.",
+			 function );
+
+			goto on_error;
+		}
+		file_entry_node = NULL;
+
+		number_of_sub_entries--;
+	}
+	return( 1 );
+
+on_error:
+	if( file_entry_node != NULL )
+	{
+		libcdata_tree_node_free(
+		 &file_entry_node,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_single_file_entry_free,
+		 NULL );
+	}
+	if( single_file_entry != NULL )
+	{
+		libewf_single_file_entry_free(
+		 &single_file_entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
+
+/* Parse a single file entry values string for the values
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_single_files_parse_file_entry_values(
+     libewf_single_file_entry_t *single_file_entry,
+     libfvalue_split_utf8_string_t *lines,
+     int *line_index,
+     libfvalue_split_utf8_string_t *types,
+     uint8_t *format,
+     libcerror_error_t **error )
+{
+	libfvalue_split_utf8_string_t *values = NULL;
+	uint8_t *line_string                  = NULL;
+	uint8_t *type_string                  = NULL;
+	uint8_t *value_string                 = NULL;
+	static char *function                 = "libewf_single_files_parse_file_entry_values";
+	size_t line_string_size               = 0;
+	size_t type_string_size               = 0;
+	size_t value_string_size              = 0;
+	size_t value_string_index             = 0;
+	uint64_t value_64bit                  = 0;
+	int number_of_types                   = 0;
+	int number_of_values                  = 0;
+	int value_index                       = 0;
+	int zero_values_only                  = 0;
+
+	if( single_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid single file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( line_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid line index.",
+		 function );
+
+		return( -1 );
+	}
+	if( format == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid format.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfvalue_split_utf8_string_get_number_of_segments(
+	     types,
+	     &number_of_types,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of types",
+		 function );
+
+		goto on_error;
+	}
+	if( libfvalue_split_utf8_string_get_segment_by_index(
+	     lines,
+	     *line_index,
+	     &line_string,
+	     &line_string_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve line string: %d.",
+		 function,
+		 *line_index );
+
+		goto on_error;
+	}
+	*line_index += 1;
+
+	if( libfvalue_utf8_string_split(
+	     line_string,
+	     line_string_size,
+	     (uint8_t) '\t',
+	     &values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to split entries string into values.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfvalue_split_utf8_string_get_number_of_segments(
+	     values,
+	     &number_of_values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of values",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_VERBOSE_OUTPUT )
+	if( number_of_types != number_of_values )
+	{
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			"%s: mismatch in number of types and values.\n",
+			 function );
+		}
+	}
+#endif
+	for( value_index = 0;
+	     value_index < number_of_types;
+	     value_index++ )
+	{
+		if( libfvalue_split_utf8_string_get_segment_by_index(
+		     types,
+		     value_index,
+		     &type_string,
+		     &type_string_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve type string: %d.",
+			 function,
+			 value_index );
+
+			goto on_error;
+		}
+		if( ( type_string == NULL )
+		 || ( type_string_size < 2 )
+		 || ( type_string[ 0 ] == 0 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing type string: %d.",
+			 function,
+			 value_index );
+
+			goto on_error;
+		}
+		/* Remove trailing carriage return
+		 */
+		else if( type_string[ type_string_size - 2 ] == (uint8_t) '\r' )
+		{
+			type_string[ type_string_size - 2 ] = 0;
+
+			type_string_size -= 1;
+		}
+		if( value_index < number_of_values )
+		{
+			if( libfvalue_split_utf8_string_get_segment_by_index(
+			     values,
+			     value_index,
+			     &value_string,
+			     &value_string_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve value string: %d.",
+				 function,
+				 value_index );
+
+				goto on_error;
+			}
+			if( ( value_string == NULL )
+			 || ( value_string_size < 2 )
+			 || ( value_string[ 0 ] == 0 ) )
+			{
+				value_string      = NULL;
+				value_string_size = 0;
+			}
+			/* Remove trailing carriage return
+			 */
+			else if( value_string[ value_string_size - 2 ] == (uint8_t) '\r' )
+			{
+				value_string[ value_string_size - 2 ] = 0;
+
+				value_string_size -= 1;
+			}
+		}
+		else
+		{
+			value_string      = NULL;
+			value_string_size = 0;
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: type: %s with value: %s.\n",
+			 function,
+			 (char *) type_string,
+			 (char *) value_string );
+		}
+#endif
+		if( value_string == NULL )
+		{
+			/* Ignore empty values
+			 */
+		}
+		else if( type_string_size == 4 )
+		{
+			if( ( type_string[ 0 ] == (uint8_t) 'c' )
+			 && ( type_string[ 1 ] == (uint8_t) 'i' )
+			 && ( type_string[ 2 ] == (uint8_t) 'd' ) )
+			{
+			}
+			else if( ( type_string[ 0 ] == (uint8_t) 'o' )
+			      && ( type_string[ 1 ] == (uint8_t) 'p' )
+			      && ( type_string[ 2 ] == (uint8_t) 'r' ) )
+			{
+				if( libfvalue_utf8_string_copy_to_integer(
+				     value_string,
+				     value_string_size,
+				     &value_64bit,
+				     64,
+				     LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to set entry flags.",
+					 function );
+
+					goto on_error;
+				}
+				if( value_64bit > (uint64_t) UINT32_MAX )
+				{
+					libcerror_error_set(
+					 error,
 					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 					 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
 					 "%s: invalid entry flags value exceeds maximum.",
 					 function );
 
-					goto on_error;
-				}
-				single_file_entry->flags = (uint32_t) value_64bit;
-			}
-			else if( ( type_string[ 0 ] == (uint8_t) 's' )
-			      && ( type_string[ 1 ] == (uint8_t) 'r' )
-			      && ( type_string[ 2 ] == (uint8_t) 'c' ) )
-			{
-			}
-			else if( ( type_string[ 0 ] == (uint8_t) 's' )
-			      && ( type_string[ 1 ] == (uint8_t) 'u' )
-			      && ( type_string[ 2 ] == (uint8_t) 'b' ) )
-			{
-			}
-			else if( ( type_string[ 0 ] == (uint8_t) 's' )
-			      && ( type_string[ 1 ] == (uint8_t) 'h' )
-			      && ( type_string[ 2 ] == (uint8_t) 'a' ) )
-			{
-				single_file_entry->sha1_hash = (uint8_t *) memory_allocate(
-				                                            sizeof( uint8_t ) * value_string_size );
+					goto on_error;
+				}
+				single_file_entry->flags = (uint32_t) value_64bit;
+			}
+			else if( ( type_string[ 0 ] == (uint8_t) 's' )
+			      && ( type_string[ 1 ] == (uint8_t) 'r' )
+			      && ( type_string[ 2 ] == (uint8_t) 'c' ) )
+			{
+			}
+			else if( ( type_string[ 0 ] == (uint8_t) 's' )
+			      && ( type_string[ 1 ] == (uint8_t) 'u' )
+			      && ( type_string[ 2 ] == (uint8_t) 'b' ) )
+			{
+			}
+			else if( ( type_string[ 0 ] == (uint8_t) 's' )
+			      && ( type_string[ 1 ] == (uint8_t) 'h' )
+			      && ( type_string[ 2 ] == (uint8_t) 'a' ) )
+			{
+				single_file_entry->sha1_hash = (uint8_t *) memory_allocate(
+				                                            sizeof( uint8_t ) * value_string_size );
+
+				if( single_file_entry->sha1_hash == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to create MD5 hash.",
+					 function );
+
+					goto on_error;
+				}
+				zero_values_only = 1;
+
+				for( value_string_index = 0;
+				     value_string_index < value_string_size - 1;
+				     value_string_index++ )
+				{
+					if( ( value_string[ value_string_index ] >= (uint8_t) '0' )
+					 && ( value_string[ value_string_index ] <= (uint8_t) '9' ) )
+					{
+						single_file_entry->sha1_hash[ value_string_index ] = value_string[ value_string_index ];
+					}
+					else if( ( value_string[ value_string_index ] >= (uint8_t) 'A' )
+					      && ( value_string[ value_string_index ] <= (uint8_t) 'F' ) )
+					{
+						single_file_entry->sha1_hash[ value_string_index ] = (uint8_t) ( 'a' - 'A' ) + value_string[ value_string_index ];
+					}
+					else if( ( value_string[ value_string_index ] >= (uint8_t) 'a' )
+					      && ( value_string[ value_string_index ] <= (uint8_t) 'f' ) )
+					{
+						single_file_entry->sha1_hash[ value_string_index ] = value_string[ value_string_index ];
+					}
+					else
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+						 "%s: unsupported character in MD5 hash.",
+						 function );
+
+						goto on_error;
+					}
+					if( value_string[ value_string_index ] != (uint8_t) '0' )
+					{
+						zero_values_only = 0;
+					}
+				}
+				single_file_entry->sha1_hash[ value_string_size - 1 ] = 0;
+
+				if( zero_values_only == 0 )
+				{
+					single_file_entry->sha1_hash_size = value_string_size;
+				}
+			}
+		}
+		else if( type_string_size == 3 )
+		{
+			/* Access time
+			 */
+			if( ( type_string[ 0 ] == (uint8_t) 'a' )
+			 && ( type_string[ 1 ] == (uint8_t) 'c' ) )
+			{
+				if( libfvalue_utf8_string_copy_to_integer(
+				     value_string,
+				     value_string_size,
+				     &value_64bit,
+				     32,
+				     LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to set access time.",
+					 function );
+
+					goto on_error;
+				}
+				single_file_entry->access_time = (uint32_t) value_64bit;
+			}
+			else if( ( type_string[ 0 ] == (uint8_t) 'a' )
+			      && ( type_string[ 1 ] == (uint8_t) 'q' ) )
+			{
+			}
+			/* Data offset
+			 * consist of: unknown, offset and size
+			 */
+			else if( ( type_string[ 0 ] == (uint8_t) 'b' )
+			      && ( type_string[ 1 ] == (uint8_t) 'e' ) )
+			{
+				if( libewf_single_files_parse_file_entry_offset_values(
+				     single_file_entry,
+				     value_string,
+				     value_string_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+					 LIBCERROR_CONVERSION_ERROR_GENERIC,
+					 "%s: unable to parse offset values string.",
+					 function );
+
+					goto on_error;
+				}
+				if( value_index == 19 )
+				{
+					*format = LIBEWF_FORMAT_LOGICAL_ENCASE5;
+				}
+				else if( ( value_index == 20 )
+				      || ( value_index == 21 ) )
+				{
+					*format = LIBEWF_FORMAT_LOGICAL_ENCASE6;
+				}
+				else if( value_index == 2 )
+				{
+					*format = LIBEWF_FORMAT_LOGICAL_ENCASE7;
+				}
+			}
+			/* Creation time
+			 */
+			else if( ( type_string[ 0 ] == (uint8_t) 'c' )
+			      && ( type_string[ 1 ] == (uint8_t) 'r' ) )
+			{
+				if( libfvalue_utf8_string_copy_to_integer(
+				     value_string,
+				     value_string_size,
+				     &value_64bit,
+				     32,
+				     LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to set creation time.",
+					 function );
+
+					goto on_error;
+				}
+				single_file_entry->creation_time = (uint32_t) value_64bit;
+			}
+			else if( ( type_string[ 0 ] == (uint8_t) 'd' )
+			      && ( type_string[ 1 ] == (uint8_t) 'l' ) )
+			{
+			}
+			else if( ( type_string[ 0 ] == (uint8_t) 'd' )
+			      && ( type_string[ 1 ] == (uint8_t) 'u' ) )
+			{
+				if( libfvalue_utf8_string_copy_to_integer(
+				     value_string,
+				     value_string_size,
+				     &value_64bit,
+				     64,
+				     LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to set duplicate data offset.",
+					 function );
+
+					goto on_error;
+				}
+				single_file_entry->duplicate_data_offset = (off64_t) value_64bit;
+			}
+			/* MD5 digest hash
+			 */
+			else if( ( type_string[ 0 ] == (uint8_t) 'h' )
+			      && ( type_string[ 1 ] == (uint8_t) 'a' ) )
+			{
+				single_file_entry->md5_hash = (uint8_t *) memory_allocate(
+				                                           sizeof( uint8_t ) * value_string_size );
+
+				if( single_file_entry->md5_hash == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to create MD5 hash.",
+					 function );
+
+					goto on_error;
+				}
+				zero_values_only = 1;
+
+				for( value_string_index = 0;
+				     value_string_index < value_string_size - 1;
+				     value_string_index++ )
+				{
+					if( ( value_string[ value_string_index ] >= (uint8_t) '0' )
+					 && ( value_string[ value_string_index ] <= (uint8_t) '9' ) )
+					{
+						single_file_entry->md5_hash[ value_string_index ] = value_string[ value_string_index ];
+					}
+					else if( ( value_string[ value_string_index ] >= (uint8_t) 'A' )
+					      && ( value_string[ value_string_index ] <= (uint8_t) 'F' ) )
+					{
+						single_file_entry->md5_hash[ value_string_index ] = (uint8_t) ( 'a' - 'A' ) + value_string[ value_string_index ];
+					}
+					else if( ( value_string[ value_string_index ] >= (uint8_t) 'a' )
+					      && ( value_string[ value_string_index ] <= (uint8_t) 'f' ) )
+					{
+						single_file_entry->md5_hash[ value_string_index ] = value_string[ value_string_index ];
+					}
+					else
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+						 "%s: unsupported character in MD5 hash.",
+						 function );
+
+						goto on_error;
+					}
+					if( value_string[ value_string_index ] != (uint8_t) '0' )
+					{
+						zero_values_only = 0;
+					}
+				}
+				single_file_entry->md5_hash[ value_string_size - 1 ] = 0;
+
+				if( zero_values_only == 0 )
+				{
+					single_file_entry->md5_hash_size = value_string_size;
+				}
+			}
+			else if( ( type_string[ 0 ] == (uint8_t) 'i' )
+			      && ( type_string[ 1 ] == (uint8_t) 'd' ) )
+			{
+			}
+			else if( ( type_string[ 0 ] == (uint8_t) 'j' )
+			      && ( type_string[ 1 ] == (uint8_t) 'q' ) )
+			{
+			}
+			else if( ( type_string[ 0 ] == (uint8_t) 'l' )
+			      && ( type_string[ 1 ] == (uint8_t) 'o' ) )
+			{
+			}
+			/* Size
+			 */
+			else if( ( type_string[ 0 ] == (uint8_t) 'l' )
+			      && ( type_string[ 1 ] == (uint8_t) 's' ) )
+			{
+				if( libfvalue_utf8_string_copy_to_integer(
+				     value_string,
+				     value_string_size,
+				     &value_64bit,
+				     64,
+				     LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to set size.",
+					 function );
+
+					goto on_error;
+				}
+				single_file_entry->size = (size64_t) value_64bit;
+			}
+			else if( ( type_string[ 0 ] == (uint8_t) 'm' )
+			      && ( type_string[ 1 ] == (uint8_t) 'o' ) )
+			{
+				if( libfvalue_utf8_string_copy_to_integer(
+				     value_string,
+				     value_string_size,
+				     &value_64bit,
+				     32,
+				     LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to set entry modification time.",
+					 function );
+
+					goto on_error;
+				}
+				single_file_entry->entry_modification_time = (uint32_t) value_64bit;
+			}
+			else if( ( type_string[ 0 ] == (uint8_t) 'p' )
+			      && ( type_string[ 1 ] == (uint8_t) 'm' ) )
+			{
+			}
+			else if( ( type_string[ 0 ] == (uint8_t) 'p' )
+			      && ( type_string[ 1 ] == (uint8_t) 'o' ) )
+			{
+			}
+			/* Modification time
+			 */
+			else if( ( type_string[ 0 ] == (uint8_t) 'w' )
+			      && ( type_string[ 1 ] == (uint8_t) 'r' ) )
+			{
+				if( libfvalue_utf8_string_copy_to_integer(
+				     value_string,
+				     value_string_size,
+				     &value_64bit,
+				     32,
+				     LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to set modification time.",
+					 function );
+
+					goto on_error;
+				}
+				single_file_entry->modification_time = (uint32_t) value_64bit;
+			}
+		}
+		else if( type_string_size == 2 )
+		{
+			/* Name
+			 */
+			if( type_string[ 0 ] == (uint8_t) 'n' )
+			{
+				single_file_entry->name = (uint8_t *) memory_allocate(
+								       sizeof( uint8_t ) * value_string_size );
+
+				if( single_file_entry->name == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to create name.",
+					 function );
+
+					goto on_error;
+				}
+				if( narrow_string_copy(
+				     single_file_entry->name,
+				     value_string,
+				     value_string_size - 1 ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to set name.",
+					 function );
+
+					goto on_error;
+				}
+				single_file_entry->name[ value_string_size - 1 ] = 0;
+
+				single_file_entry->name_size = value_string_size;
+			}
+		}
+		if( type_string_size == 2 )
+		{
+			if( type_string[ 0 ] == (uint8_t) 'p' )
+			{
+				/* p = 1 if directory
+				 * p = empty if file
+				 */
+				if( value_string == NULL )
+				{
+					single_file_entry->type = LIBEWF_FILE_ENTRY_TYPE_FILE;
+				}
+				else if( ( value_string_size == 2 )
+				      && ( value_string[ 0 ] == (uint8_t) '1' ) )
+				{
+					single_file_entry->type = LIBEWF_FILE_ENTRY_TYPE_DIRECTORY;
+				}
+			}
+		}
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "\n" );
+	}
+#endif
+	if( libfvalue_split_utf8_string_free(
+	     &values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free split values.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( values != NULL )
+	{
+		libfvalue_split_utf8_string_free(
+		 &values,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Parse a single file entry string for the number of sub entries
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_single_files_parse_file_entry_number_of_sub_entries(
+     libfvalue_split_utf8_string_t *lines,
+     int *line_index,
+     uint64_t *number_of_sub_entries,
+     libcerror_error_t **error )
+{
+	libfvalue_split_utf8_string_t *values = NULL;
+	uint8_t *line_string                  = NULL;
+	uint8_t *value_string                 = NULL;
+	static char *function                 = "libewf_single_files_parse_file_entry_number_of_sub_entries";
+	size_t line_string_size               = 0;
+	size_t value_string_size              = 0;
+	int number_of_values                  = 0;
+
+	if( line_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid line index.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfvalue_split_utf8_string_get_segment_by_index(
+	     lines,
+	     *line_index,
+	     &line_string,
+	     &line_string_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve line string: %d.",
+		 function,
+		 *line_index );
+
+		goto on_error;
+	}
+	*line_index += 1;
+
+	if( libfvalue_utf8_string_split(
+	     line_string,
+	     line_string_size,
+	     (uint8_t) '\t',
+	     &values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to split entries string into values.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfvalue_split_utf8_string_get_number_of_segments(
+	     values,
+	     &number_of_values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of values",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_values != 2 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported number of values.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfvalue_split_utf8_string_get_segment_by_index(
+	     values,
+	     0,
+	     &value_string,
+	     &value_string_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve value string: 0.",
+		 function );
+
+		goto on_error;
+	}
+	if( value_string_size == 2 )
+	{
+		if( value_string[ 0 ] != (uint8_t) '0' )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported first value: %c.",
+			 function,
+			 value_string[ 0 ] );
+
+			goto on_error;
+		}
+	}
+	else if( value_string_size == 3 )
+	{
+		if( ( value_string[ 0 ] != (uint8_t) '2' )
+		 || ( value_string[ 1 ] != (uint8_t) '6' ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported first value: %c%c.",
+			 function,
+			 value_string[ 0 ],
+			 value_string[ 1 ] );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported first value.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfvalue_split_utf8_string_get_segment_by_index(
+	     values,
+	     1,
+	     &value_string,
+	     &value_string_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve value string: 1.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfvalue_utf8_string_copy_to_integer(
+	     value_string,
+	     value_string_size,
+	     number_of_sub_entries,
+	     64,
+	     LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to set number fo sub entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfvalue_split_utf8_string_free(
+	     &values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free split values.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( values != NULL )
+	{
+		libfvalue_split_utf8_string_free(
+		 &values,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Parse a single file entry offset values string for the values
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_single_files_parse_file_entry_offset_values(
+     libewf_single_file_entry_t *single_file_entry,
+     const uint8_t *offset_values_string,
+     size_t offset_values_string_size,
+     libcerror_error_t **error )
+{
+	libfvalue_split_utf8_string_t *offset_values  = NULL;
+	uint8_t *offset_value_string                  = NULL;
+	static char *function                         = "libewf_single_files_parse_file_entry_offset_values";
+	size_t offset_value_string_size               = 0;
+	uint64_t value_64bit                          = 0;
+	int number_of_offset_values                   = 0;
+
+	if( single_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid single file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfvalue_utf8_string_split(
+	     offset_values_string,
+	     offset_values_string_size,
+	     (uint8_t) ' ',
+	     &offset_values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to split string into offset values.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfvalue_split_utf8_string_get_number_of_segments(
+	     offset_values,
+	     &number_of_offset_values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of offset values",
+		 function );
+
+		goto on_error;
+	}
+	if( ( number_of_offset_values != 1 )
+	 && ( number_of_offset_values != 3 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported number of offset values.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_offset_values == 3 )
+	{
+		if( libfvalue_split_utf8_string_get_segment_by_index(
+		     offset_values,
+		     1,
+		     &offset_value_string,
+		     &offset_value_string_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve offset value string: 1.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfvalue_utf8_string_copy_to_integer(
+		     offset_value_string,
+		     offset_value_string_size,
+		     &value_64bit,
+		     64,
+		     LIBFVALUE_INTEGER_FORMAT_TYPE_HEXADECIMAL | LIBFVALUE_INTEGER_FORMAT_FLAG_NO_BASE_INDICATOR,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to set data offset.",
+			 function );
+
+			goto on_error;
+		}
+		single_file_entry->data_offset = (off64_t) value_64bit;
+
+		if( libfvalue_split_utf8_string_get_segment_by_index(
+		     offset_values,
+		     2,
+		     &offset_value_string,
+		     &offset_value_string_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve offset value string: 2.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfvalue_utf8_string_copy_to_integer(
+		     offset_value_string,
+		     offset_value_string_size,
+		     &value_64bit,
+		     64,
+		     LIBFVALUE_INTEGER_FORMAT_TYPE_HEXADECIMAL | LIBFVALUE_INTEGER_FORMAT_FLAG_NO_BASE_INDICATOR,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to set data size.",
+			 function );
+
+			goto on_error;
+		}
+		single_file_entry->data_size = (size64_t) value_64bit;
+	}
+	if( libfvalue_split_utf8_string_free(
+	     &offset_values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free split offset values.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( offset_values != NULL )
+	{
+		libfvalue_split_utf8_string_free(
+		 &offset_values,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the offset of the next line in the UTF-16 little-endian ltree data
+ * Returns 1 if successful or 0 if the end of the data was reached
+ */
+static int libewf_single_files_get_next_line_offset(
+            const uint8_t *ltree_data,
+            size_t ltree_data_size,
+            size_t *line_offset )
+{
+	size_t data_offset      = 0;
+	uint16_t character_value = 0;
+
+	data_offset = *line_offset;
+
+	while( ( data_offset + 1 ) < ltree_data_size )
+	{
+		byte_stream_copy_to_uint16_little_endian(
+		 &( ltree_data[ data_offset ] ),
+		 character_value );
+
+		data_offset += 2;
+
+		if( character_value == 0 )
+		{
+			break;
+		}
+		if( character_value == (uint16_t) '\n' )
+		{
+			*line_offset = data_offset;
+
+			return( 1 );
+		}
+	}
+	return( 0 );
+}
+
+/* Retrieves the offset of the first record of the entries in the ltree data
+ * Returns 1 if successful, 0 if no entries line was found or -1 on error
+ */
+int libewf_single_files_get_records_offset(
+     libewf_single_files_t *single_files,
+     size_t *records_offset,
+     libcerror_error_t **error )
+{
+	uint8_t entry_line_string[ 10 ] = {
+		(uint8_t) 'e', 0, (uint8_t) 'n', 0, (uint8_t) 't', 0, (uint8_t) 'r', 0, (uint8_t) 'y', 0 };
+
+	static char *function    = "libewf_single_files_get_records_offset";
+	size_t line_offset       = 0;
+	uint16_t character_value = 0;
+	int line_iterator        = 0;
+
+	if( single_files == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid single files.",
+		 function );
+
+		return( -1 );
+	}
+	if( single_files->ltree_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid single files - missing ltree data.",
+		 function );
+
+		return( -1 );
+	}
+	if( records_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid records offset.",
+		 function );
+
+		return( -1 );
+	}
+	/* Find the line containing: "entry"
+	 */
+	do
+	{
+		if( ( line_offset + 12 ) <= single_files->ltree_data_size )
+		{
+			if( memory_compare(
+			     &( single_files->ltree_data[ line_offset ] ),
+			     entry_line_string,
+			     10 ) == 0 )
+			{
+				byte_stream_copy_to_uint16_little_endian(
+				 &( single_files->ltree_data[ line_offset + 10 ] ),
+				 character_value );
+
+				if( ( character_value == (uint16_t) '\n' )
+				 || ( character_value == (uint16_t) '\r' ) )
+				{
+					break;
+				}
+			}
+		}
+	}
+	while( libewf_single_files_get_next_line_offset(
+	        single_files->ltree_data,
+	        single_files->ltree_data_size,
+	        &line_offset ) != 0 );
+
+	/* The records start after the entry, number of entries and types lines
+	 */
+	for( line_iterator = 0;
+	     line_iterator < 3;
+	     line_iterator++ )
+	{
+		if( libewf_single_files_get_next_line_offset(
+		     single_files->ltree_data,
+		     single_files->ltree_data_size,
+		     &line_offset ) == 0 )
+		{
+			return( 0 );
+		}
+	}
+	*records_offset = line_offset;
+
+	return( 1 );
+}
+
+/* Determines the format from the types of the entries
+ * The format is determined by the index of the data offset type
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_single_files_get_format_from_types(
+     libfvalue_split_utf8_string_t *types,
+     uint8_t *format,
+     libcerror_error_t **error )
+{
+	uint8_t *type_string    = NULL;
+	static char *function   = "libewf_single_files_get_format_from_types";
+	size_t type_string_size = 0;
+	int number_of_types     = 0;
+	int value_index         = 0;
+
+	if( format == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid format.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfvalue_split_utf8_string_get_number_of_segments(
+	     types,
+	     &number_of_types,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of types",
+		 function );
+
+		return( -1 );
+	}
+	for( value_index = 0;
+	     value_index < number_of_types;
+	     value_index++ )
+	{
+		if( libfvalue_split_utf8_string_get_segment_by_index(
+		     types,
+		     value_index,
+		     &type_string,
+		     &type_string_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve type string: %d.",
+			 function,
+			 value_index );
+
+			return( -1 );
+		}
+		if( ( type_string == NULL )
+		 || ( type_string_size < 3 ) )
+		{
+			continue;
+		}
+		if( ( type_string[ 0 ] != (uint8_t) 'b' )
+		 || ( type_string[ 1 ] != (uint8_t) 'e' ) )
+		{
+			continue;
+		}
+		if( ( type_string[ 2 ] == 0 )
+		 || ( type_string[ 2 ] == (uint8_t) '\r' ) )
+		{
+			if( value_index == 19 )
+			{
+				*format = LIBEWF_FORMAT_LOGICAL_ENCASE5;
+			}
+			else if( ( value_index == 20 )
+			      || ( value_index == 21 ) )
+			{
+				*format = LIBEWF_FORMAT_LOGICAL_ENCASE6;
+			}
+			else if( value_index == 2 )
+			{
+				*format = LIBEWF_FORMAT_LOGICAL_ENCASE7;
+			}
+			break;
+		}
+	}
+	return( 1 );
+}
+
+/* Parse a record number of sub entries line in the UTF-16 little-endian ltree data
+ * On return line offset contains the offset of the next line
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_single_files_parse_record_number_of_sub_entries(
+     const uint8_t *ltree_data,
+     size_t ltree_data_size,
+     size_t *line_offset,
+     uint64_t *number_of_sub_entries,
+     libcerror_error_t **error )
+{
+	static char *function    = "libewf_single_files_parse_record_number_of_sub_entries";
+	size_t data_offset       = 0;
+	uint64_t value_64bit     = 0;
+	uint16_t character_value = 0;
+	int number_of_digits     = 0;
+	int value_index          = 0;
+
+	if( ltree_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ltree data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ltree_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid ltree data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( line_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid line offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_sub_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of sub entries.",
+		 function );
+
+		return( -1 );
+	}
+	data_offset = *line_offset;
+
+	/* The line consists of 2 values: a first value of "0" or "26"
+	 * and the number of sub entries
+	 */
+	while( ( data_offset + 1 ) < ltree_data_size )
+	{
+		byte_stream_copy_to_uint16_little_endian(
+		 &( ltree_data[ data_offset ] ),
+		 character_value );
+
+		data_offset += 2;
+
+		if( ( character_value == 0 )
+		 || ( character_value == (uint16_t) '\n' ) )
+		{
+			break;
+		}
+		if( character_value == (uint16_t) '\r' )
+		{
+			continue;
+		}
+		if( character_value == (uint16_t) '\t' )
+		{
+			if( value_index != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+				 "%s: unsupported number of values.",
+				 function );
+
+				return( -1 );
+			}
+			if( ( ( number_of_digits != 1 )
+			  || ( value_64bit != 0 ) )
+			 && ( ( number_of_digits != 2 )
+			  || ( value_64bit != 26 ) ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+				 "%s: unsupported first value.",
+				 function );
+
+				return( -1 );
+			}
+			value_64bit      = 0;
+			number_of_digits = 0;
+			value_index     += 1;
+
+			continue;
+		}
+		if( ( character_value < (uint16_t) '0' )
+		 || ( character_value > (uint16_t) '9' ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported character value: 0x%04" PRIx16 ".",
+			 function,
+			 character_value );
+
+			return( -1 );
+		}
+		if( value_64bit > ( ( UINT64_MAX - 9 ) / 10 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of sub entries value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		value_64bit *= 10;
+		value_64bit += character_value - (uint16_t) '0';
+
+		number_of_digits++;
+	}
+	if( ( value_index != 1 )
+	 || ( number_of_digits == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported number of values.",
+		 function );
+
+		return( -1 );
+	}
+	*line_offset           = data_offset;
+	*number_of_sub_entries = value_64bit;
+
+	return( 1 );
+}
+
+/* Indexes the records of the entries in the ltree data
+ * The records are stored in pre-order, where every record consists of
+ * a number of sub entries line and a values line
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_single_files_index_records(
+     libewf_single_files_t *single_files,
+     size_t records_offset,
+     libcerror_error_t **error )
+{
+	int *stack_number_of_sub_entries = NULL;
+	int *stack_record_index          = NULL;
+	static char *function            = "libewf_single_files_index_records";
+	size_t line_offset               = 0;
+	uint64_t number_of_sub_entries   = 0;
+	uint16_t character_value         = 0;
+	int maximum_number_of_records    = 0;
+	int number_of_lines              = 0;
+	int record_index                 = 0;
+	int stack_depth                  = 0;
+
+	if( single_files == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid single files.",
+		 function );
+
+		return( -1 );
+	}
+	if( single_files->ltree_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid single files - missing ltree data.",
+		 function );
+
+		return( -1 );
+	}
+	if( single_files->record_offsets != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid single files - record offsets value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( records_offset >= single_files->ltree_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid records offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* Determine the maximum number of records from the number of lines
+	 */
+	line_offset = records_offset;
+
+	while( libewf_single_files_get_next_line_offset(
+	        single_files->ltree_data,
+	        single_files->ltree_data_size,
+	        &line_offset ) != 0 )
+	{
+		if( number_of_lines == INT32_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of lines value exceeds maximum.",
+			 function );
+
+			goto on_error;
+		}
+		number_of_lines++;
+	}
+	maximum_number_of_records = number_of_lines / 2;
+
+	if( maximum_number_of_records == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing records.",
+		 function );
+
+		goto on_error;
+	}
+	single_files->record_offsets = (size_t *) memory_allocate(
+	                                           sizeof( size_t ) * maximum_number_of_records );
+
+	if( single_files->record_offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create record offsets.",
+		 function );
+
+		goto on_error;
+	}
+	single_files->record_number_of_descendants = (int *) memory_allocate(
+	                                                      sizeof( int ) * maximum_number_of_records );
+
+	if( single_files->record_number_of_descendants == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create record number of descendants.",
+		 function );
+
+		goto on_error;
+	}
+	stack_record_index = (int *) memory_allocate(
+	                              sizeof( int ) * maximum_number_of_records );
+
+	if( stack_record_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create stack record index.",
+		 function );
+
+		goto on_error;
+	}
+	stack_number_of_sub_entries = (int *) memory_allocate(
+	                                       sizeof( int ) * maximum_number_of_records );
+
+	if( stack_number_of_sub_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create stack number of sub entries.",
+		 function );
+
+		goto on_error;
+	}
+	/* Walk the records in pre-order, the stack contains the records
+	 * of which not all the sub entries have been walked yet
+	 */
+	line_offset = records_offset;
+
+	do
+	{
+		if( record_index >= maximum_number_of_records )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: number of sub entries exceed the number of available lines.",
+			 function );
+
+			goto on_error;
+		}
+		if( stack_depth > 0 )
+		{
+			stack_number_of_sub_entries[ stack_depth - 1 ] -= 1;
+		}
+		single_files->record_offsets[ record_index ]               = line_offset;
+		single_files->record_number_of_descendants[ record_index ] = 0;
+
+		if( libewf_single_files_parse_record_number_of_sub_entries(
+		     single_files->ltree_data,
+		     single_files->ltree_data_size,
+		     &line_offset,
+		     &number_of_sub_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+			 LIBCERROR_CONVERSION_ERROR_GENERIC,
+			 "%s: unable to parse record: %d number of sub entries.",
+			 function,
+			 record_index );
+
+			goto on_error;
+		}
+		if( number_of_sub_entries > (uint64_t) ( maximum_number_of_records - record_index ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: number of sub entries exceed the number of available lines.",
+			 function );
+
+			goto on_error;
+		}
+		if( libewf_single_files_get_next_line_offset(
+		     single_files->ltree_data,
+		     single_files->ltree_data_size,
+		     &line_offset ) == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing record: %d values line.",
+			 function,
+			 record_index );
+
+			goto on_error;
+		}
+		stack_record_index[ stack_depth ]          = record_index;
+		stack_number_of_sub_entries[ stack_depth ] = (int) number_of_sub_entries;
+
+		stack_depth++;
+		record_index++;
+
+		while( ( stack_depth > 0 )
+		    && ( stack_number_of_sub_entries[ stack_depth - 1 ] == 0 ) )
+		{
+			stack_depth--;
+
+			single_files->record_number_of_descendants[ stack_record_index[ stack_depth ] ] =
+				record_index - stack_record_index[ stack_depth ] - 1;
+		}
+	}
+	while( stack_depth > 0 );
+
+	/* The single files entries should be followed by an empty line
+	 */
+	if( ( line_offset + 1 ) < single_files->ltree_data_size )
+	{
+		byte_stream_copy_to_uint16_little_endian(
+		 &( single_files->ltree_data[ line_offset ] ),
+		 character_value );
+
+		if( ( character_value != 0 )
+		 && ( character_value != (uint16_t) '\n' )
+		 && ( character_value != (uint16_t) '\r' ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported empty line string - not empty.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	memory_free(
+	 stack_number_of_sub_entries );
+
+	memory_free(
+	 stack_record_index );
+
+	single_files->number_of_records = record_index;
+
+	return( 1 );
+
+on_error:
+	if( stack_number_of_sub_entries != NULL )
+	{
+		memory_free(
+		 stack_number_of_sub_entries );
+	}
+	if( stack_record_index != NULL )
+	{
+		memory_free(
+		 stack_record_index );
+	}
+	if( single_files->record_number_of_descendants != NULL )
+	{
+		memory_free(
+		 single_files->record_number_of_descendants );
+
+		single_files->record_number_of_descendants = NULL;
+	}
+	if( single_files->record_offsets != NULL )
+	{
+		memory_free(
+		 single_files->record_offsets );
+
+		single_files->record_offsets = NULL;
+	}
+	return( -1 );
+}
+
+/* Reads a single file entry from a record in the ltree data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_single_files_read_record(
+     libewf_single_files_t *single_files,
+     int record_index,
+     libewf_single_file_entry_t **single_file_entry,
+     libcerror_error_t **error )
+{
+	libewf_single_file_entry_t *safe_single_file_entry = NULL;
+	libfvalue_split_utf8_string_t *lines               = NULL;
+	uint8_t *record_string                             = NULL;
+	static char *function                              = "libewf_single_files_read_record";
+	size_t record_data_offset                          = 0;
+	size_t record_data_size                            = 0;
+	size_t record_string_size                          = 0;
+	uint64_t number_of_sub_entries                     = 0;
+	uint8_t format                                     = 0;
+	int line_index                                     = 0;
+
+	if( single_files == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid single files.",
+		 function );
+
+		return( -1 );
+	}
+	if( single_files->ltree_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid single files - missing ltree data.",
+		 function );
+
+		return( -1 );
+	}
+	if( single_files->record_offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid single files - missing record offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( record_index < 0 )
+	 || ( record_index >= single_files->number_of_records ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid record index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( single_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid single file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *single_file_entry != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid single file entry value already set.",
+		 function );
+
+		return( -1 );
+	}
+	record_data_offset = single_files->record_offsets[ record_index ];
+	record_data_size   = record_data_offset;
+
+	/* The record consists of a number of sub entries line and a values line
+	 */
+	if( ( libewf_single_files_get_next_line_offset(
+	       single_files->ltree_data,
+	       single_files->ltree_data_size,
+	       &record_data_size ) == 0 )
+	 || ( libewf_single_files_get_next_line_offset(
+	       single_files->ltree_data,
+	       single_files->ltree_data_size,
+	       &record_data_size ) == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid record: %d value out of bounds.",
+		 function,
+		 record_index );
+
+		goto on_error;
+	}
+	record_data_size -= record_data_offset;
+
+	if( libuna_utf8_string_size_from_utf16_stream(
+	     &( single_files->ltree_data[ record_data_offset ] ),
+	     record_data_size,
+	     LIBUNA_ENDIAN_LITTLE,
+	     &record_string_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to determine record string size.",
+		 function );
+
+		goto on_error;
+	}
+	record_string = (uint8_t *) memory_allocate(
+	                             sizeof( uint8_t ) * record_string_size );
+
+	if( record_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create record string.",
+		 function );
+
+		goto on_error;
+	}
+	if( libuna_utf8_string_copy_from_utf16_stream(
+	     record_string,
+	     record_string_size,
+	     &( single_files->ltree_data[ record_data_offset ] ),
+	     record_data_size,
+	     LIBUNA_ENDIAN_LITTLE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to set record string.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfvalue_utf8_string_split(
+	     record_string,
+	     record_string_size - 1,
+	     (uint8_t) '\n',
+	     &lines,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to split record string into lines.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_single_files_parse_file_entry_number_of_sub_entries(
+	     lines,
+	     &line_index,
+	     &number_of_sub_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to parse file entry number of sub entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_sub_entries > (uint64_t) single_files->number_of_records )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of sub entries value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_single_file_entry_initialize(
+	     &safe_single_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create single file entry.",
+		 function );
+
+		goto on_error;
+	}
+	/* The format was determined from the types when the records were indexed
+	 */
+	if( libewf_single_files_parse_file_entry_values(
+	     safe_single_file_entry,
+	     lines,
+	     &line_index,
+	     single_files->types,
+	     &format,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to parse file entry values.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfvalue_split_utf8_string_free(
+	     &lines,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free split lines.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 record_string );
+
+	safe_single_file_entry->record_index                 = record_index;
+	safe_single_file_entry->number_of_unread_sub_entries = (int) number_of_sub_entries;
+
+	*single_file_entry = safe_single_file_entry;
+
+	return( 1 );
+
+on_error:
+	if( safe_single_file_entry != NULL )
+	{
+		libewf_single_file_entry_free(
+		 &safe_single_file_entry,
+		 NULL );
+	}
+	if( lines != NULL )
+	{
+		libfvalue_split_utf8_string_free(
+		 &lines,
+		 NULL );
+	}
+	if( record_string != NULL )
+	{
+		memory_free(
+		 record_string );
+	}
+	return( -1 );
+}
+
+/* Reads a sub node of a single file entry node from a record in the ltree data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_single_files_read_sub_node(
+     libewf_single_files_t *single_files,
+     libcdata_tree_node_t *node,
+     int record_index,
+     libcerror_error_t **error )
+{
+	libewf_single_file_entry_t *single_file_entry = NULL;
+	libcdata_tree_node_t *sub_node                = NULL;
+	static char *function                         = "libewf_single_files_read_sub_node";
 
-				if( single_file_entry->sha1_hash == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_MEMORY,
-					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-					 "%s: unable to create MD5 hash.",
-					 function );
+	if( libewf_single_files_read_record(
+	     single_files,
+	     record_index,
+	     &single_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read record: %d.",
+		 function,
+		 record_index );
 
-					goto on_error;
-				}
-				zero_values_only = 1;
+		goto on_error;
+	}
+	if( libcdata_tree_node_initialize(
+	     &sub_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create single file entry node.",
+		 function );
 
-				for( value_string_index = 0;
-				     value_string_index < value_string_size - 1;
-				     value_string_index++ )
-				{
-					if( ( value_string[ value_string_index ] >= (uint8_t) '0' )
-					 && ( value_string[ value_string_index ] <= (uint8_t) '9' ) )
-					{
-						single_file_entry->sha1_hash[ value_string_index ] = value_string[ value_string_index ];
-					}
-					else if( ( value_string[ value_string_index ] >= (uint8_t) 'A' )
-					      && ( value_string[ value_string_index ] <= (uint8_t) 'F' ) )
-					{
-						single_file_entry->sha1_hash[ value_string_index ] = (uint8_t) ( 'a' - 'A' ) + value_string[ value_string_index ];
-					}
-					else if( ( value_string[ value_string_index ] >= (uint8_t) 'a' )
-					      && ( value_string[ value_string_index ] <= (uint8_t) 'f' ) )
-					{
-						single_file_entry->sha1_hash[ value_string_index ] = value_string[ value_string_index ];
-					}
-					else
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-						 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-						 "%s: unsupported character in MD5 hash.",
-						 function );
+		goto on_error;
+	}
+	if( libcdata_tree_node_set_value(
+	     sub_node,
+	     (intptr_t *) single_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set single file entry in node.",
+		 function );
 
-						goto on_error;
-					}
-					if( value_string[ value_string_index ] != (uint8_t) '0' )
-					{
-						zero_values_only = 0;
-					}
-				}
-				single_file_entry->sha1_hash[ value_string_size - 1 ] = 0;
+		goto on_error;
+	}
+	single_file_entry = NULL;
 
-				if( zero_values_only == 0 )
-				{
-					single_file_entry->sha1_hash_size = value_string_size;
-				}
-			}
-		}
-		else if( type_string_size == 3 )
-		{
-			/* Access time
-			 */
-			if( ( type_string[ 0 ] == (uint8_t) 'a' )
-			 && ( type_string[ 1 ] == (uint8_t) 'c' ) )
-			{
-				if( libfvalue_utf8_string_copy_to_integer(
-				     value_string,
-				     value_string_size,
-				     &value_64bit,
-				     32,
-				     LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_MEMORY,
-					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-					 "%s: unable to set access time.",
-					 function );
+	if( libcdata_tree_node_append_node(
+	     node,
+	     sub_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append single file entry node to parent.",
+		 function );
 
-					goto on_error;
-				}
-				single_file_entry->access_time = (uint32_t) value_64bit;
-			}
-			else if( ( type_string[ 0 ] == (uint8_t) 'a' )
-			      && ( type_string[ 1 ] == (uint8_t) 'q' ) )
-			{
-			}
-			/* Data offset
-			 * consist of: unknown, offset and size
-			 */
-			else if( ( type_string[ 0 ] == (uint8_t) 'b' )
-			      && ( type_string[ 1 ] == (uint8_t) 'e' ) )
-			{
-				if( libewf_single_files_parse_file_entry_offset_values(
-				     single_file_entry,
-				     value_string,
-				     value_string_size,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_CONVERSION,
-					 LIBCERROR_CONVERSION_ERROR_GENERIC,
-					 "%s: unable to parse offset values string.",
-					 function );
+		goto on_error;
+	}
+	return( 1 );
 
-					goto on_error;
-				}
-				if( value_index == 19 )
-				{
-					*format = LIBEWF_FORMAT_LOGICAL_ENCASE5;
-				}
-				else if( ( value_index == 20 )
-				      || ( value_index == 21 ) )
-				{
-					*format = LIBEWF_FORMAT_LOGICAL_ENCASE6;
-				}
-				else if( value_index == 2 )
-				{
-					*format = LIBEWF_FORMAT_LOGICAL_ENCASE7;
-				}
-			}
-			/* Creation time
-			 */
-			else if( ( type_string[ 0 ] == (uint8_t) 'c' )
-			      && ( type_string[ 1 ] == (uint8_t) 'r' ) )
-			{
-				if( libfvalue_utf8_string_copy_to_integer(
-				     value_string,
-				     value_string_size,
-				     &value_64bit,
-				     32,
-				     LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_MEMORY,
-					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-					 "%s: unable to set creation time.",
-					 function );
+on_error:
+	if( sub_node != NULL )
+	{
+		libcdata_tree_node_free(
+		 &sub_node,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_single_file_entry_free,
+		 NULL );
+	}
+	if( single_file_entry != NULL )
+	{
+		libewf_single_file_entry_free(
+		 &single_file_entry,
+		 NULL );
+	}
+	return( -1 );
+}
 
-					goto on_error;
-				}
-				single_file_entry->creation_time = (uint32_t) value_64bit;
-			}
-			else if( ( type_string[ 0 ] == (uint8_t) 'd' )
-			      && ( type_string[ 1 ] == (uint8_t) 'l' ) )
-			{
-			}
-			else if( ( type_string[ 0 ] == (uint8_t) 'd' )
-			      && ( type_string[ 1 ] == (uint8_t) 'u' ) )
-			{
-				if( libfvalue_utf8_string_copy_to_integer(
-				     value_string,
-				     value_string_size,
-				     &value_64bit,
-				     64,
-				     LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_MEMORY,
-					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-					 "%s: unable to set duplicate data offset.",
-					 function );
+/* Reads the sub nodes of a single file entry node from the ltree records if not read before
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_single_files_read_sub_nodes(
+     libewf_single_files_t *single_files,
+     libcdata_tree_node_t *node,
+     libcerror_error_t **error )
+{
+	libewf_single_file_entry_t *single_file_entry = NULL;
+	static char *function                         = "libewf_single_files_read_sub_nodes";
+	int number_of_sub_entries                     = 0;
+	int number_of_sub_nodes                       = 0;
+	int result                                    = 1;
+	int sub_entry_index                           = 0;
+	int sub_record_index                          = 0;
+
+	if( single_files == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid single files.",
+		 function );
 
-					goto on_error;
-				}
-				single_file_entry->duplicate_data_offset = (off64_t) value_64bit;
-			}
-			/* MD5 digest hash
-			 */
-			else if( ( type_string[ 0 ] == (uint8_t) 'h' )
-			      && ( type_string[ 1 ] == (uint8_t) 'a' ) )
-			{
-				single_file_entry->md5_hash = (uint8_t *) memory_allocate(
-				                                           sizeof( uint8_t ) * value_string_size );
+		return( -1 );
+	}
+	/* If the records were not indexed all the single file entries were read at once
+	 */
+	if( single_files->record_offsets == NULL )
+	{
+		return( 1 );
+	}
+	if( libcdata_tree_node_get_value(
+	     node,
+	     (intptr_t **) &single_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve value from node.",
+		 function );
 
-				if( single_file_entry->md5_hash == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_MEMORY,
-					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-					 "%s: unable to create MD5 hash.",
-					 function );
+		return( -1 );
+	}
+	if( single_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing single file entry.",
+		 function );
 
-					goto on_error;
-				}
-				zero_values_only = 1;
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     single_files->lookup_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab lookup mutex.",
+		 function );
 
-				for( value_string_index = 0;
-				     value_string_index < value_string_size - 1;
-				     value_string_index++ )
-				{
-					if( ( value_string[ value_string_index ] >= (uint8_t) '0' )
-					 && ( value_string[ value_string_index ] <= (uint8_t) '9' ) )
-					{
-						single_file_entry->md5_hash[ value_string_index ] = value_string[ value_string_index ];
-					}
-					else if( ( value_string[ value_string_index ] >= (uint8_t) 'A' )
-					      && ( value_string[ value_string_index ] <= (uint8_t) 'F' ) )
-					{
-						single_file_entry->md5_hash[ value_string_index ] = (uint8_t) ( 'a' - 'A' ) + value_string[ value_string_index ];
-					}
-					else if( ( value_string[ value_string_index ] >= (uint8_t) 'a' )
-					      && ( value_string[ value_string_index ] <= (uint8_t) 'f' ) )
-					{
-						single_file_entry->md5_hash[ value_string_index ] = value_string[ value_string_index ];
-					}
-					else
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-						 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-						 "%s: unsupported character in MD5 hash.",
-						 function );
+		return( -1 );
+	}
+#endif
+	if( single_file_entry->number_of_unread_sub_entries > 0 )
+	{
+		if( libcdata_tree_node_get_number_of_sub_nodes(
+		     node,
+		     &number_of_sub_nodes,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of sub nodes.",
+			 function );
 
-						goto on_error;
-					}
-					if( value_string[ value_string_index ] != (uint8_t) '0' )
-					{
-						zero_values_only = 0;
-					}
-				}
-				single_file_entry->md5_hash[ value_string_size - 1 ] = 0;
+			result = -1;
+		}
+		/* The sub entries of a record directly follow the record
+		 * and sibling records are separated by the descendants of the record
+		 */
+		sub_record_index = single_file_entry->record_index + 1;
 
-				if( zero_values_only == 0 )
-				{
-					single_file_entry->md5_hash_size = value_string_size;
-				}
-			}
-			else if( ( type_string[ 0 ] == (uint8_t) 'i' )
-			      && ( type_string[ 1 ] == (uint8_t) 'd' ) )
-			{
-			}
-			else if( ( type_string[ 0 ] == (uint8_t) 'j' )
-			      && ( type_string[ 1 ] == (uint8_t) 'q' ) )
-			{
-			}
-			else if( ( type_string[ 0 ] == (uint8_t) 'l' )
-			      && ( type_string[ 1 ] == (uint8_t) 'o' ) )
-			{
-			}
-			/* Size
-			 */
-			else if( ( type_string[ 0 ] == (uint8_t) 'l' )
-			      && ( type_string[ 1 ] == (uint8_t) 's' ) )
-			{
-				if( libfvalue_utf8_string_copy_to_integer(
-				     value_string,
-				     value_string_size,
-				     &value_64bit,
-				     64,
-				     LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_MEMORY,
-					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-					 "%s: unable to set size.",
-					 function );
+		number_of_sub_entries = number_of_sub_nodes + single_file_entry->number_of_unread_sub_entries;
 
-					goto on_error;
-				}
-				single_file_entry->size = (size64_t) value_64bit;
-			}
-			else if( ( type_string[ 0 ] == (uint8_t) 'm' )
-			      && ( type_string[ 1 ] == (uint8_t) 'o' ) )
+		for( sub_entry_index = 0;
+		     ( result == 1 ) && ( sub_entry_index < number_of_sub_entries );
+		     sub_entry_index++ )
+		{
+			if( ( sub_record_index <= 0 )
+			 || ( sub_record_index >= single_files->number_of_records ) )
 			{
-				if( libfvalue_utf8_string_copy_to_integer(
-				     value_string,
-				     value_string_size,
-				     &value_64bit,
-				     32,
-				     LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_MEMORY,
-					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-					 "%s: unable to set entry modification time.",
-					 function );
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid sub record index value out of bounds.",
+				 function );
 
-					goto on_error;
-				}
-				single_file_entry->entry_modification_time = (uint32_t) value_64bit;
-			}
-			else if( ( type_string[ 0 ] == (uint8_t) 'p' )
-			      && ( type_string[ 1 ] == (uint8_t) 'm' ) )
-			{
-			}
-			else if( ( type_string[ 0 ] == (uint8_t) 'p' )
-			      && ( type_string[ 1 ] == (uint8_t) 'o' ) )
-			{
+				result = -1;
+
+				break;
 			}
-			/* Modification time
+			/* Skip the sub entries that were read before
 			 */
-			else if( ( type_string[ 0 ] == (uint8_t) 'w' )
-			      && ( type_string[ 1 ] == (uint8_t) 'r' ) )
+			if( sub_entry_index >= number_of_sub_nodes )
 			{
-				if( libfvalue_utf8_string_copy_to_integer(
-				     value_string,
-				     value_string_size,
-				     &value_64bit,
-				     32,
-				     LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
-				     error ) != 1 )
+				result = libewf_single_files_read_sub_node(
+				          single_files,
+				          node,
+				          sub_record_index,
+				          error );
+
+				if( result != 1 )
 				{
 					libcerror_error_set(
 					 error,
-					 LIBCERROR_ERROR_DOMAIN_MEMORY,
-					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-					 "%s: unable to set modification time.",
-					 function );
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read sub node from record: %d.",
+					 function,
+					 sub_record_index );
 
-					goto on_error;
+					result = -1;
+
+					break;
 				}
-				single_file_entry->modification_time = (uint32_t) value_64bit;
 			}
+			sub_record_index += 1 + single_files->record_number_of_descendants[ sub_record_index ];
 		}
-		else if( type_string_size == 2 )
+		if( result == 1 )
 		{
-			/* Name
-			 */
-			if( type_string[ 0 ] == (uint8_t) 'n' )
-			{
-				single_file_entry->name = (uint8_t *) memory_allocate(
-								       sizeof( uint8_t ) * value_string_size );
+			single_file_entry->number_of_unread_sub_entries = 0;
+		}
+		else if( sub_entry_index > number_of_sub_nodes )
+		{
+			single_file_entry->number_of_unread_sub_entries -= sub_entry_index - number_of_sub_nodes;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     single_files->lookup_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release lookup mutex.",
+		 function );
 
-				if( single_file_entry->name == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_MEMORY,
-					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-					 "%s: unable to create name.",
-					 function );
+		result = -1;
+	}
+#endif
+	return( result );
+}
 
-					goto on_error;
-				}
-				if( narrow_string_copy(
-				     single_file_entry->name,
-				     value_string,
-				     value_string_size - 1 ) == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_MEMORY,
-					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-					 "%s: unable to set name.",
-					 function );
+/* Retrieves the name index of the sub nodes of a single file entry node
+ * The name index is built on first use, for directories with fewer than
+ * LIBEWF_SINGLE_FILE_NAME_INDEX_MINIMUM_NUMBER_OF_SUB_NODES sub nodes no name index is built
+ * Returns 1 if successful, 0 if no name index is available or -1 on error
+ */
+int libewf_single_files_get_sub_node_name_index(
+     libewf_single_files_t *single_files,
+     libcdata_tree_node_t *node,
+     libewf_single_file_name_index_t **name_index,
+     libcerror_error_t **error )
+{
+	libewf_single_file_entry_t *single_file_entry = NULL;
+	libewf_single_file_name_index_t *safe_index   = NULL;
+	static char *function                         = "libewf_single_files_get_sub_node_name_index";
+	int number_of_sub_nodes                       = 0;
+	int result                                    = 1;
 
-					goto on_error;
-				}
-				single_file_entry->name[ value_string_size - 1 ] = 0;
+	if( single_files == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid single files.",
+		 function );
 
-				single_file_entry->name_size = value_string_size;
-			}
-		}
-		if( type_string_size == 2 )
-		{
-			if( type_string[ 0 ] == (uint8_t) 'p' )
-			{
-				/* p = 1 if directory
-				 * p = empty if file
-				 */
-				if( value_string == NULL )
-				{
-					single_file_entry->type = LIBEWF_FILE_ENTRY_TYPE_FILE;
-				}
-				else if( ( value_string_size == 2 )
-				      && ( value_string[ 0 ] == (uint8_t) '1' ) )
-				{
-					single_file_entry->type = LIBEWF_FILE_ENTRY_TYPE_DIRECTORY;
-				}
-			}
-		}
+		return( -1 );
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	if( name_index == NULL )
 	{
-		libcnotify_printf(
-		 "\n" );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name index.",
+		 function );
+
+		return( -1 );
 	}
-#endif
-	if( libfvalue_split_utf8_string_free(
-	     &values,
+	if( libcdata_tree_node_get_value(
+	     node,
+	     (intptr_t **) &single_file_entry,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free split values.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve value from node.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libcdata_tree_node_set_value(
-	     parent_file_entry_node,
-	     (intptr_t *) single_file_entry,
-	     error ) != 1 )
+	if( single_file_entry == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set single file entry in node.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing single file entry.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	single_file_entry = NULL;
+	if( libewf_single_files_read_sub_nodes(
+	     single_files,
+	     node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read sub nodes.",
+		 function );
 
-	if( libfvalue_split_utf8_string_get_number_of_segments(
-	     lines,
-	     &number_of_lines,
+		return( -1 );
+	}
+	if( libcdata_tree_node_get_number_of_sub_nodes(
+	     node,
+	     &number_of_sub_nodes,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of lines",
+		 "%s: unable to retrieve number of sub nodes.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( ( *line_index + number_of_sub_entries ) > (uint64_t) number_of_lines )
+	if( ( number_of_sub_nodes < LIBEWF_SINGLE_FILE_NAME_INDEX_MINIMUM_NUMBER_OF_SUB_NODES )
+	 || ( number_of_sub_nodes > LIBEWF_SINGLE_FILE_NAME_INDEX_MAXIMUM_NUMBER_OF_SUB_NODES ) )
+	{
+		*name_index = NULL;
+
+		return( 0 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     single_files->lookup_mutex,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: number of sub entries exceed the number of available lines.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab lookup mutex.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	while( number_of_sub_entries > 0 )
+#endif
+	if( single_file_entry->sub_node_name_index == NULL )
 	{
-		if( libcdata_tree_node_initialize(
-		     &file_entry_node,
+		if( libewf_single_file_name_index_initialize(
+		     &safe_index,
+		     number_of_sub_nodes,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create single file entry node.",
+			 "%s: unable to create sub node name index.",
 			 function );
 
-			goto on_error;
+			result = -1;
 		}
-		if( libewf_single_files_parse_file_entry(
-		     file_entry_node,
-		     lines,
-		     line_index,
-		     types,
-		     format,
-		     error ) != 1 )
+		else if( libewf_single_file_name_index_build(
+		          safe_index,
+		          node,
+		          error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_CONVERSION,
-			 LIBCERROR_CONVERSION_ERROR_GENERIC,
-			 "%s: unable to parse file entry.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to build sub node name index.",
 			 function );
 
-			goto on_error;
+			libewf_single_file_name_index_free(
+			 &safe_index,
+			 NULL );
+
+			result = -1;
 		}
-		if( libcdata_tree_node_append_node(
-		     parent_file_entry_node,
-		     file_entry_node,
-		     error ) != 1 )
+		else
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to append single file entry node to parent.",
-			 function );
-
-			goto on_error;
+			single_file_entry->sub_node_name_index = safe_index;
 		}
-		file_entry_node = NULL;
-
-		number_of_sub_entries--;
-	}
-	return( 1 );
-
-on_error:
-	if( file_entry_node != NULL )
-	{
-		libcdata_tree_node_free(
-		 &file_entry_node,
-		 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_single_file_entry_free,
-		 NULL );
-	}
-	if( single_file_entry != NULL )
-	{
-		libewf_single_file_entry_free(
-		 &single_file_entry,
-		 NULL );
 	}
-	if( values != NULL )
+	/* The name index is not modified after it has been built
+	 * so it can be used after the mutex has been released
+	 */
+	*name_index = single_file_entry->sub_node_name_index;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     single_files->lookup_mutex,
+	     error ) != 1 )
 	{
-		libfvalue_split_utf8_string_free(
-		 &values,
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release lookup mutex.",
+		 function );
+
+		return( -1 );
 	}
-	return( -1 );
+#endif
+	return( result );
 }
 
-/* Parse a single file entry string for the number of sub entries
- * Returns 1 if successful or -1 on error
+/* Retrieves the single file entry sub node for the specific UTF-8 formatted name
+ * Uses the name index of the node if available otherwise the sub nodes are searched linearly
+ * Returns 1 if successful, 0 if no such sub single file entry or -1 on error
  */
-int libewf_single_files_parse_file_entry_number_of_sub_entries(
-     libfvalue_split_utf8_string_t *lines,
-     int *line_index,
-     uint64_t *number_of_sub_entries,
+int libewf_single_files_get_sub_node_by_utf8_name(
+     libewf_single_files_t *single_files,
+     libcdata_tree_node_t *node,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libcdata_tree_node_t **sub_node,
+     libewf_single_file_entry_t **sub_single_file_entry,
      libcerror_error_t **error )
 {
-	libfvalue_split_utf8_string_t *values = NULL;
-	uint8_t *line_string                  = NULL;
-	uint8_t *value_string                 = NULL;
-	static char *function                 = "libewf_single_files_parse_file_entry_number_of_sub_entries";
-	size_t line_string_size               = 0;
-	size_t value_string_size              = 0;
-	int number_of_values                  = 0;
+	libewf_single_file_name_index_t *name_index = NULL;
+	static char *function                       = "libewf_single_files_get_sub_node_by_utf8_name";
+	int result                                  = 0;
 
-	if( line_index == NULL )
+	if( sub_node == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid line index.",
+		 "%s: invalid sub node.",
 		 function );
 
 		return( -1 );
 	}
-	if( libfvalue_split_utf8_string_get_segment_by_index(
-	     lines,
-	     *line_index,
-	     &line_string,
-	     &line_string_size,
-	     error ) != 1 )
+	if( sub_single_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sub single file entry.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_single_files_get_sub_node_name_index(
+	          single_files,
+	          node,
+	          &name_index,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve line string: %d.",
-		 function,
-		 *line_index );
+		 "%s: unable to retrieve sub node name index.",
+		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	*line_index += 1;
+	else if( result == 0 )
+	{
+		result = libewf_single_file_tree_get_sub_node_by_utf8_name(
+		          node,
+		          utf8_string,
+		          utf8_string_length,
+		          sub_node,
+		          sub_single_file_entry,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sub node by name.",
+			 function );
 
-	if( libfvalue_utf8_string_split(
-	     line_string,
-	     line_string_size,
-	     (uint8_t) '\t',
-	     &values,
-	     error ) != 1 )
+			return( -1 );
+		}
+		return( result );
+	}
+	result = libewf_single_file_name_index_get_sub_node_by_utf8_name(
+	          name_index,
+	          utf8_string,
+	          utf8_string_length,
+	          sub_node,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to split entries string into values.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve sub node from name index.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfvalue_split_utf8_string_get_number_of_segments(
-	     values,
-	     &number_of_values,
+	else if( result == 0 )
+	{
+		*sub_single_file_entry = NULL;
+
+		return( 0 );
+	}
+	if( libcdata_tree_node_get_value(
+	     *sub_node,
+	     (intptr_t **) sub_single_file_entry,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of values",
+		 "%s: unable to retrieve value from sub node.",
 		 function );
 
-		goto on_error;
+		*sub_node = NULL;
+
+		return( -1 );
 	}
-	if( number_of_values != 2 )
+	return( 1 );
+}
+
+/* Retrieves the single file entry sub node for the specific UTF-16 formatted name
+ * Uses the name index of the node if available otherwise the sub nodes are searched linearly
+ * Returns 1 if successful, 0 if no such sub single file entry or -1 on error
+ */
+int libewf_single_files_get_sub_node_by_utf16_name(
+     libewf_single_files_t *single_files,
+     libcdata_tree_node_t *node,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     libcdata_tree_node_t **sub_node,
+     libewf_single_file_entry_t **sub_single_file_entry,
+     libcerror_error_t **error )
+{
+	libewf_single_file_name_index_t *name_index = NULL;
+	static char *function                       = "libewf_single_files_get_sub_node_by_utf16_name";
+	int result                                  = 0;
+
+	if( sub_node == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported number of values.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sub node.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfvalue_split_utf8_string_get_segment_by_index(
-	     values,
-	     0,
-	     &value_string,
-	     &value_string_size,
-	     error ) != 1 )
+	if( sub_single_file_entry == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve value string: 0.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sub single file entry.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( value_string_size == 2 )
+	result = libewf_single_files_get_sub_node_name_index(
+	          single_files,
+	          node,
+	          &name_index,
+	          error );
+
+	if( result == -1 )
 	{
-		if( value_string[ 0 ] != (uint8_t) '0' )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-			 "%s: unsupported first value: %c.",
-			 function,
-			 value_string[ 0 ] );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve sub node name index.",
+		 function );
 
-			goto on_error;
-		}
+		return( -1 );
 	}
-	else if( value_string_size == 3 )
+	else if( result == 0 )
 	{
-		if( ( value_string[ 0 ] != (uint8_t) '2' )
-		 || ( value_string[ 1 ] != (uint8_t) '6' ) )
+		result = libewf_single_file_tree_get_sub_node_by_utf16_name(
+		          node,
+		          utf16_string,
+		          utf16_string_length,
+		          sub_node,
+		          sub_single_file_entry,
+		          error );
+
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-			 "%s: unsupported first value: %c%c.",
-			 function,
-			 value_string[ 0 ],
-			 value_string[ 1 ] );
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sub node by name.",
+			 function );
 
-			goto on_error;
+			return( -1 );
 		}
+		return( result );
 	}
-	else
+	result = libewf_single_file_name_index_get_sub_node_by_utf16_name(
+	          name_index,
+	          utf16_string,
+	          utf16_string_length,
+	          sub_node,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported first value.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve sub node from name index.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfvalue_split_utf8_string_get_segment_by_index(
-	     values,
-	     1,
-	     &value_string,
-	     &value_string_size,
+	else if( result == 0 )
+	{
+		*sub_single_file_entry = NULL;
+
+		return( 0 );
+	}
+	if( libcdata_tree_node_get_value(
+	     *sub_node,
+	     (intptr_t **) sub_single_file_entry,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve value string: 1.",
+		 "%s: unable to retrieve value from sub node.",
 		 function );
 
-		goto on_error;
+		*sub_node = NULL;
+
+		return( -1 );
 	}
-	if( libfvalue_utf8_string_copy_to_integer(
-	     value_string,
-	     value_string_size,
-	     number_of_sub_entries,
-	     64,
-	     LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
-	     error ) != 1 )
+	return( 1 );
+}
+
+/* Calculates the hash of a path in the path cache
+ */
+static uint32_t libewf_single_files_get_path_hash(
+                 const uint8_t *path,
+                 size_t path_size,
+                 uint8_t character_size )
+{
+	size_t path_index = 0;
+	uint32_t hash     = 0x811c9dc5UL;
+
+	for( path_index = 0;
+	     path_index < path_size;
+	     path_index++ )
+	{
+		hash ^= (uint32_t) path[ path_index ];
+		hash *= 0x01000193UL;
+	}
+	hash ^= (uint32_t) character_size;
+	hash *= 0x01000193UL;
+
+	return( hash );
+}
+
+/* Retrieves the single file entry node of a path from the path cache
+ * The path is stored as a byte stream where character size is 1 for an UTF-8
+ * and 2 for an UTF-16 formatted path
+ * Returns 1 if successful, 0 if the path is not cached or -1 on error
+ */
+int libewf_single_files_get_cached_node_by_path(
+     libewf_single_files_t *single_files,
+     const uint8_t *path,
+     size_t path_size,
+     uint8_t character_size,
+     libcdata_tree_node_t **node,
+     libcerror_error_t **error )
+{
+	libewf_single_files_cached_path_t *cached_path = NULL;
+	static char *function                          = "libewf_single_files_get_cached_node_by_path";
+	uint32_t hash                                  = 0;
+	int result                                     = 0;
+
+	if( single_files == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to set number fo sub entries.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid single files.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfvalue_split_utf8_string_free(
-	     &values,
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		return( -1 );
+	}
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	if( path_size > LIBEWF_SINGLE_FILES_PATH_CACHE_MAXIMUM_PATH_SIZE )
+	{
+		return( 0 );
+	}
+	hash = libewf_single_files_get_path_hash(
+	        path,
+	        path_size,
+	        character_size );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     single_files->lookup_mutex,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free split values.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab lookup mutex.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	return( 1 );
-
-on_error:
-	if( values != NULL )
+#endif
+	if( single_files->path_cache != NULL )
 	{
-		libfvalue_split_utf8_string_free(
-		 &values,
-		 NULL );
+		cached_path = &( single_files->path_cache[ hash % LIBEWF_SINGLE_FILES_PATH_CACHE_SIZE ] );
+
+		if( ( cached_path->path != NULL )
+		 && ( cached_path->hash == hash )
+		 && ( cached_path->character_size == character_size )
+		 && ( cached_path->path_size == path_size )
+		 && ( memory_compare(
+		       cached_path->path,
+		       path,
+		       path_size ) == 0 ) )
+		{
+			*node  = cached_path->node;
+			result = 1;
+		}
 	}
-	return( -1 );
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     single_files->lookup_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release lookup mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
 }
 
-/* Parse a single file entry offset values string for the values
+/* Sets the single file entry node of a path in the path cache
+ * An existing path that maps to the same cache entry is replaced,
+ * paths larger than LIBEWF_SINGLE_FILES_PATH_CACHE_MAXIMUM_PATH_SIZE are not cached
  * Returns 1 if successful or -1 on error
  */
-int libewf_single_files_parse_file_entry_offset_values(
-     libewf_single_file_entry_t *single_file_entry,
-     const uint8_t *offset_values_string,
-     size_t offset_values_string_size,
+int libewf_single_files_set_cached_node_by_path(
+     libewf_single_files_t *single_files,
+     const uint8_t *path,
+     size_t path_size,
+     uint8_t character_size,
+     libcdata_tree_node_t *node,
      libcerror_error_t **error )
 {
-	libfvalue_split_utf8_string_t *offset_values  = NULL;
-	uint8_t *offset_value_string                  = NULL;
-	static char *function                         = "libewf_single_files_parse_file_entry_offset_values";
-	size_t offset_value_string_size               = 0;
-	uint64_t value_64bit                          = 0;
-	int number_of_offset_values                   = 0;
+	libewf_single_files_cached_path_t *cached_path = NULL;
+	uint8_t *safe_path                             = NULL;
+	static char *function                          = "libewf_single_files_set_cached_node_by_path";
+	uint32_t hash                                  = 0;
+	int result                                     = 1;
 
-	if( single_file_entry == NULL )
+	if( single_files == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid single file entry.",
+		 "%s: invalid single files.",
 		 function );
 
 		return( -1 );
 	}
-	if( libfvalue_utf8_string_split(
-	     offset_values_string,
-	     offset_values_string_size,
-	     (uint8_t) ' ',
-	     &offset_values,
-	     error ) != 1 )
+	if( path == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to split string into offset values.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfvalue_split_utf8_string_get_number_of_segments(
-	     offset_values,
-	     &number_of_offset_values,
-	     error ) != 1 )
+	if( ( path_size == 0 )
+	 || ( path_size > LIBEWF_SINGLE_FILES_PATH_CACHE_MAXIMUM_PATH_SIZE ) )
+	{
+		return( 1 );
+	}
+	hash = libewf_single_files_get_path_hash(
+	        path,
+	        path_size,
+	        character_size );
+
+	safe_path = (uint8_t *) memory_allocate(
+	                         sizeof( uint8_t ) * path_size );
+
+	if( safe_path == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of offset values",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create path.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( ( number_of_offset_values != 1 )
-	 && ( number_of_offset_values != 3 ) )
+	if( memory_copy(
+	     safe_path,
+	     path,
+	     path_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy path.",
+		 function );
+
+		memory_free(
+		 safe_path );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     single_files->lookup_mutex,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported number of offset values.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab lookup mutex.",
 		 function );
 
-		goto on_error;
+		memory_free(
+		 safe_path );
+
+		return( -1 );
 	}
-	if( number_of_offset_values == 3 )
+#endif
+	if( single_files->path_cache == NULL )
 	{
-		if( libfvalue_split_utf8_string_get_segment_by_index(
-		     offset_values,
-		     1,
-		     &offset_value_string,
-		     &offset_value_string_size,
-		     error ) != 1 )
+		single_files->path_cache = (libewf_single_files_cached_path_t *) memory_allocate(
+		                                                                  sizeof( libewf_single_files_cached_path_t ) * LIBEWF_SINGLE_FILES_PATH_CACHE_SIZE );
+
+		if( single_files->path_cache == NULL )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve offset value string: 1.",
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create path cache.",
 			 function );
 
-			goto on_error;
+			result = -1;
 		}
-		if( libfvalue_utf8_string_copy_to_integer(
-		     offset_value_string,
-		     offset_value_string_size,
-		     &value_64bit,
-		     64,
-		     LIBFVALUE_INTEGER_FORMAT_TYPE_HEXADECIMAL | LIBFVALUE_INTEGER_FORMAT_FLAG_NO_BASE_INDICATOR,
-		     error ) != 1 )
+		else if( memory_set(
+		          single_files->path_cache,
+		          0,
+		          sizeof( libewf_single_files_cached_path_t ) * LIBEWF_SINGLE_FILES_PATH_CACHE_SIZE ) == NULL )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_MEMORY,
 			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-			 "%s: unable to set data offset.",
+			 "%s: unable to clear path cache.",
 			 function );
 
-			goto on_error;
-		}
-		single_file_entry->data_offset = (off64_t) value_64bit;
+			memory_free(
+			 single_files->path_cache );
 
-		if( libfvalue_split_utf8_string_get_segment_by_index(
-		     offset_values,
-		     2,
-		     &offset_value_string,
-		     &offset_value_string_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve offset value string: 2.",
-			 function );
+			single_files->path_cache = NULL;
 
-			goto on_error;
+			result = -1;
 		}
-		if( libfvalue_utf8_string_copy_to_integer(
-		     offset_value_string,
-		     offset_value_string_size,
-		     &value_64bit,
-		     64,
-		     LIBFVALUE_INTEGER_FORMAT_TYPE_HEXADECIMAL | LIBFVALUE_INTEGER_FORMAT_FLAG_NO_BASE_INDICATOR,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-			 "%s: unable to set data size.",
-			 function );
+	}
+	if( result == 1 )
+	{
+		cached_path = &( single_files->path_cache[ hash % LIBEWF_SINGLE_FILES_PATH_CACHE_SIZE ] );
 
-			goto on_error;
+		if( cached_path->path != NULL )
+		{
+			memory_free(
+			 cached_path->path );
 		}
-		single_file_entry->data_size = (size64_t) value_64bit;
+		cached_path->hash           = hash;
+		cached_path->character_size = character_size;
+		cached_path->path           = safe_path;
+		cached_path->path_size      = path_size;
+		cached_path->node           = node;
+
+		safe_path = NULL;
 	}
-	if( libfvalue_split_utf8_string_free(
-	     &offset_values,
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     single_files->lookup_mutex,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free split offset values.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release lookup mutex.",
 		 function );
 
-		goto on_error;
+		result = -1;
 	}
-	return( 1 );
-
-on_error:
-	if( offset_values != NULL )
+#endif
+	if( safe_path != NULL )
 	{
-		libfvalue_split_utf8_string_free(
-		 &offset_values,
-		 NULL );
+		memory_free(
+		 safe_path );
 	}
-	return( -1 );
+	return( result );
 }
 
@@ -28,14 +28,49 @@
 #include "libewf_extern.h"
 #include "libewf_libcdata.h"
 #include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
 #include "libewf_libfvalue.h"
 #include "libewf_single_file_entry.h"
+#include "libewf_single_file_name_index.h"
 #include "libewf_types.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
+/* The number of entries in the path cache
+ */
+#define LIBEWF_SINGLE_FILES_PATH_CACHE_SIZE		1024
+
+/* The maximum size of a path that is stored in the path cache
+ */
+#define LIBEWF_SINGLE_FILES_PATH_CACHE_MAXIMUM_PATH_SIZE	1024
+
+typedef struct libewf_single_files_cached_path libewf_single_files_cached_path_t;
+
+struct libewf_single_files_cached_path
+{
+	/* The path hash
+	 */
+	uint32_t hash;
+
+	/* The size of a character of the path
+	 */
+	uint8_t character_size;
+
+	/* The path
+	 */
+	uint8_t *path;
+
+	/* The path size
+	 */
+	size_t path_size;
+
+	/* The single file entry node of the path
+	 */
+	libcdata_tree_node_t *node;
+};
+
 typedef struct libewf_single_files libewf_single_files_t;
 
 struct libewf_single_files
@@ -59,6 +94,33 @@ struct libewf_single_files
 	/* The single file entry tree
 	 */
 	libcdata_tree_node_t *root_file_entry_node;
+
+	/* The types of the entries, which are used to read the sub file entries on demand
+	 */
+	libfvalue_split_utf8_string_t *types;
+
+	/* The offsets of the records of the entries in the ltree data
+	 */
+	size_t *record_offsets;
+
+	/* The number of descendants of the records of the entries
+	 */
+	int *record_number_of_descendants;
+
+	/* The number of records of the entries
+	 */
+	int number_of_records;
+
+	/* The path cache, which maps a path to a single file entry node
+	 */
+	libewf_single_files_cached_path_t *path_cache;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The mutex that protects the name indexes and path cache
+	 * since these are modified while the handle is locked for reading
+	 */
+	libcthreads_mutex_t *lookup_mutex;
+#endif
 };
 
 int libewf_single_files_initialize(
@@ -75,6 +137,18 @@ int libewf_single_files_parse(
      uint8_t *format,
      libcerror_error_t **error );
 
+int libewf_single_files_parse_ltree_data(
+     libewf_single_files_t *single_files,
+     size64_t *media_size,
+     uint8_t *format,
+     libcerror_error_t **error );
+
+int libewf_single_files_parse_header(
+     size64_t *media_size,
+     libfvalue_split_utf8_string_t *lines,
+     int *types_line_index,
+     libcerror_error_t **error );
+
 int libewf_single_files_parse_file_entries(
      libewf_single_files_t *single_files,
      size64_t *media_size,
@@ -97,6 +171,14 @@ int libewf_single_files_parse_file_entry(
      uint8_t *format,
      libcerror_error_t **error );
 
+int libewf_single_files_parse_file_entry_values(
+     libewf_single_file_entry_t *single_file_entry,
+     libfvalue_split_utf8_string_t *lines,
+     int *line_index,
+     libfvalue_split_utf8_string_t *types,
+     uint8_t *format,
+     libcerror_error_t **error );
+
 int libewf_single_files_parse_file_entry_number_of_sub_entries(
      libfvalue_split_utf8_string_t *lines,
      int *line_index,
@@ -109,6 +191,85 @@ int libewf_single_files_parse_file_entry_offset_values(
      size_t offset_values_string_size,
      libcerror_error_t **error );
 
+int libewf_single_files_get_records_offset(
+     libewf_single_files_t *single_files,
+     size_t *records_offset,
+     libcerror_error_t **error );
+
+int libewf_single_files_get_format_from_types(
+     libfvalue_split_utf8_string_t *types,
+     uint8_t *format,
+     libcerror_error_t **error );
+
+int libewf_single_files_parse_record_number_of_sub_entries(
+     const uint8_t *ltree_data,
+     size_t ltree_data_size,
+     size_t *line_offset,
+     uint64_t *number_of_sub_entries,
+     libcerror_error_t **error );
+
+int libewf_single_files_index_records(
+     libewf_single_files_t *single_files,
+     size_t records_offset,
+     libcerror_error_t **error );
+
+int libewf_single_files_read_record(
+     libewf_single_files_t *single_files,
+     int record_index,
+     libewf_single_file_entry_t **single_file_entry,
+     libcerror_error_t **error );
+
+int libewf_single_files_read_sub_node(
+     libewf_single_files_t *single_files,
+     libcdata_tree_node_t *node,
+     int record_index,
+     libcerror_error_t **error );
+
+int libewf_single_files_read_sub_nodes(
+     libewf_single_files_t *single_files,
+     libcdata_tree_node_t *node,
+     libcerror_error_t **error );
+
+int libewf_single_files_get_sub_node_name_index(
+     libewf_single_files_t *single_files,
+     libcdata_tree_node_t *node,
+     libewf_single_file_name_index_t **name_index,
+     libcerror_error_t **error );
+
+int libewf_single_files_get_sub_node_by_utf8_name(
+     libewf_single_files_t *single_files,
+     libcdata_tree_node_t *node,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libcdata_tree_node_t **sub_node,
+     libewf_single_file_entry_t **sub_single_file_entry,
+     libcerror_error_t **error );
+
+int libewf_single_files_get_sub_node_by_utf16_name(
+     libewf_single_files_t *single_files,
+     libcdata_tree_node_t *node,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     libcdata_tree_node_t **sub_node,
+     libewf_single_file_entry_t **sub_single_file_entry,
+     libcerror_error_t **error );
+
+int libewf_single_files_get_cached_node_by_path(
+     libewf_single_files_t *single_files,
+     const uint8_t *path,
+     size_t path_size,
+     uint8_t character_size,
+     libcdata_tree_node_t **node,
+     libcerror_error_t **error );
+
+int libewf_single_files_set_cached_node_by_path(
+     libewf_single_files_t *single_files,
+     const uint8_t *path,
+     size_t path_size,
+     uint8_t character_size,
+     libcdata_tree_node_t *node,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -0,0 +1,404 @@
+/*
+ * Statistics functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( TIME_WITH_SYS_TIME )
+#include <sys/time.h>
+#include <time.h>
+#elif defined( HAVE_SYS_TIME_H )
+#include <sys/time.h>
+#else
+#include <time.h>
+#endif
+
+#include "libewf_libcerror.h"
+#include "libewf_statistics.h"
+
+/* Creates statistics
+ * Make sure the value statistics is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_statistics_initialize(
+     libewf_statistics_t **statistics,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_statistics_initialize";
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( *statistics != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid statistics value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*statistics = memory_allocate_structure(
+	               libewf_statistics_t );
+
+	if( *statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create statistics.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *statistics,
+	     0,
+	     sizeof( libewf_statistics_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear statistics.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *statistics != NULL )
+	{
+		memory_free(
+		 *statistics );
+
+		*statistics = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees statistics
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_statistics_free(
+     libewf_statistics_t **statistics,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_statistics_free";
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( *statistics != NULL )
+	{
+		memory_free(
+		 *statistics );
+
+		*statistics = NULL;
+	}
+	return( 1 );
+}
+
+/* Clears the statistics
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_statistics_clear(
+     libewf_statistics_t *statistics,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_statistics_clear";
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     statistics,
+	     0,
+	     sizeof( libewf_statistics_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear statistics.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the current time of a monotonic clock in nano seconds
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_statistics_get_current_time(
+     uint64_t *current_time,
+     libcerror_error_t **error )
+{
+#if defined( WINAPI )
+	LARGE_INTEGER counter;
+	LARGE_INTEGER frequency;
+
+#elif defined( HAVE_CLOCK_GETTIME ) && defined( CLOCK_MONOTONIC )
+	struct timespec time_value;
+
+#elif defined( HAVE_GETTIMEOFDAY )
+	struct timeval time_value;
+
+#else
+	time_t time_value     = 0;
+#endif
+	static char *function = "libewf_statistics_get_current_time";
+
+	if( current_time == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid current time.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI )
+	if( ( QueryPerformanceFrequency(
+	       &frequency ) == 0 )
+	 || ( QueryPerformanceCounter(
+	       &counter ) == 0 )
+	 || ( frequency.QuadPart <= 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve performance counter.",
+		 function );
+
+		return( -1 );
+	}
+	*current_time = ( (uint64_t) ( counter.QuadPart / frequency.QuadPart ) * 1000000000UL )
+	              + ( ( (uint64_t) ( counter.QuadPart % frequency.QuadPart ) * 1000000000UL ) / (uint64_t) frequency.QuadPart );
+
+#elif defined( HAVE_CLOCK_GETTIME ) && defined( CLOCK_MONOTONIC )
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_value ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve monotonic clock time.",
+		 function );
+
+		return( -1 );
+	}
+	*current_time = ( (uint64_t) time_value.tv_sec * 1000000000UL ) + (uint64_t) time_value.tv_nsec;
+
+#elif defined( HAVE_GETTIMEOFDAY )
+	if( gettimeofday(
+	     &time_value,
+	     NULL ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve time of day.",
+		 function );
+
+		return( -1 );
+	}
+	*current_time = ( (uint64_t) time_value.tv_sec * 1000000000UL ) + ( (uint64_t) time_value.tv_usec * 1000UL );
+
+#else
+	time_value = time(
+	              NULL );
+
+	if( time_value == (time_t) -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve time.",
+		 function );
+
+		return( -1 );
+	}
+	*current_time = (uint64_t) time_value * 1000000000UL;
+#endif
+	return( 1 );
+}
+
+/* Adds an event that started at a specific time to the statistics
+ * The elapsed time of the event is the time between the start time and the current time
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_statistics_add_event(
+     libewf_statistics_t *statistics,
+     int statistics_type,
+     uint64_t start_time,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_statistics_add_event";
+	uint64_t current_time = 0;
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( statistics_type < 0 )
+	 || ( statistics_type >= LIBEWF_STATISTICS_NUMBER_OF_TYPES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported statistics type.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_statistics_get_current_time(
+	     &current_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time.",
+		 function );
+
+		return( -1 );
+	}
+	statistics->number_of_events[ statistics_type ] += 1;
+
+	/* The clock can be coarser than the duration of the event
+	 */
+	if( current_time > start_time )
+	{
+		statistics->elapsed_time[ statistics_type ] += current_time - start_time;
+	}
+	return( 1 );
+}
+
+/* Retrieves the number of events and the cumulative elapsed time in nano seconds of a specific statistics type
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_statistics_get_value(
+     libewf_statistics_t *statistics,
+     int statistics_type,
+     uint64_t *number_of_events,
+     uint64_t *elapsed_time,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_statistics_get_value";
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( statistics_type < 0 )
+	 || ( statistics_type >= LIBEWF_STATISTICS_NUMBER_OF_TYPES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported statistics type.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_events == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of events.",
+		 function );
+
+		return( -1 );
+	}
+	if( elapsed_time == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid elapsed time.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_events = statistics->number_of_events[ statistics_type ];
+	*elapsed_time     = statistics->elapsed_time[ statistics_type ];
+
+	return( 1 );
+}
+
@@ -0,0 +1,88 @@
+/*
+ * Statistics functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_STATISTICS_H )
+#define _LIBEWF_STATISTICS_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The number of statistics types
+ */
+#define LIBEWF_STATISTICS_NUMBER_OF_TYPES		7
+
+typedef struct libewf_statistics libewf_statistics_t;
+
+/* The statistics contain the number of events and the elapsed time per stage of a read
+ * The statistics are only maintained while the handle collects statistics
+ */
+struct libewf_statistics
+{
+	/* The number of events per statistics type
+	 */
+	uint64_t number_of_events[ LIBEWF_STATISTICS_NUMBER_OF_TYPES ];
+
+	/* The cumulative elapsed time in nano seconds per statistics type
+	 */
+	uint64_t elapsed_time[ LIBEWF_STATISTICS_NUMBER_OF_TYPES ];
+};
+
+int libewf_statistics_initialize(
+     libewf_statistics_t **statistics,
+     libcerror_error_t **error );
+
+int libewf_statistics_free(
+     libewf_statistics_t **statistics,
+     libcerror_error_t **error );
+
+int libewf_statistics_clear(
+     libewf_statistics_t *statistics,
+     libcerror_error_t **error );
+
+int libewf_statistics_get_current_time(
+     uint64_t *current_time,
+     libcerror_error_t **error );
+
+int libewf_statistics_add_event(
+     libewf_statistics_t *statistics,
+     int statistics_type,
+     uint64_t start_time,
+     libcerror_error_t **error );
+
+int libewf_statistics_get_value(
+     libewf_statistics_t *statistics,
+     int statistics_type,
+     uint64_t *number_of_events,
+     uint64_t *elapsed_time,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_STATISTICS_H ) */
+
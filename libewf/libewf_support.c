@@ -26,12 +26,14 @@
 #include <wide_string.h>
 
 #include "libewf_definitions.h"
+#include "libewf_directory.h"
 #include "libewf_filename.h"
 #include "libewf_error.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcerror.h"
 #include "libewf_libclocale.h"
 #include "libewf_libcnotify.h"
+#include "libewf_open_handles_budget.h"
 #include "libewf_segment_file.h"
 #include "libewf_support.h"
 
@@ -131,6 +133,194 @@ int libewf_set_codepage(
 
 #endif /* !defined( HAVE_LOCAL_LIBEWF ) */
 
+/* Retrieves the process-wide maximum number of open handles
+ * A value of 0 represents no process-wide maximum
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_get_maximum_number_of_open_handles(
+     int *maximum_number_of_open_handles,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_get_maximum_number_of_open_handles";
+
+	if( maximum_number_of_open_handles == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum number of open handles.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_global_open_handles_budget == NULL )
+	{
+		*maximum_number_of_open_handles = 0;
+
+		return( 1 );
+	}
+	if( libewf_open_handles_budget_get_maximum_number_of_open_handles(
+	     libewf_global_open_handles_budget,
+	     maximum_number_of_open_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve maximum number of open handles.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the process-wide maximum number of open handles
+ * The maximum is shared by the file IO pools of all handles opened for reading
+ * after it was set, a value of 0 removes the process-wide maximum
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_set_maximum_number_of_open_handles(
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_set_maximum_number_of_open_handles";
+
+	if( maximum_number_of_open_handles < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid maximum number of open handles value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_open_handles == 0 )
+	{
+		if( libewf_global_open_handles_budget == NULL )
+		{
+			return( 1 );
+		}
+		/* Handles that are open could still be accessing the budget
+		 */
+		if( libewf_global_open_handles_budget->number_of_clients > 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: unable to remove maximum number of open handles while handles are open.",
+			 function );
+
+			return( -1 );
+		}
+		if( libewf_open_handles_budget_free(
+		     &libewf_global_open_handles_budget,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free open handles budget.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else if( libewf_global_open_handles_budget == NULL )
+	{
+		if( libewf_open_handles_budget_initialize(
+		     &libewf_global_open_handles_budget,
+		     maximum_number_of_open_handles,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create open handles budget.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else
+	{
+		if( libewf_open_handles_budget_set_maximum_number_of_open_handles(
+		     libewf_global_open_handles_budget,
+		     maximum_number_of_open_handles,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum number of open handles.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves the process-wide open handles statistics
+ * The statistics are 0 if no process-wide maximum is set
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_get_open_handles_statistics(
+     uint64_t *number_of_opens,
+     uint64_t *number_of_closes,
+     uint64_t *number_of_hits,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_get_open_handles_statistics";
+
+	if( libewf_global_open_handles_budget == NULL )
+	{
+		if( ( number_of_opens == NULL )
+		 || ( number_of_closes == NULL )
+		 || ( number_of_hits == NULL ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid statistics value.",
+			 function );
+
+			return( -1 );
+		}
+		*number_of_opens  = 0;
+		*number_of_closes = 0;
+		*number_of_hits   = 0;
+
+		return( 1 );
+	}
+	if( libewf_open_handles_budget_get_statistics(
+	     libewf_global_open_handles_budget,
+	     number_of_opens,
+	     number_of_closes,
+	     number_of_hits,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve open handles statistics.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Determines if a file contains an EWF file signature
  * Returns 1 if true, 0 if not or -1 on error
  */
@@ -500,30 +690,39 @@ int libewf_check_file_signature_file_io_handle(
 }
 
 /* Globs the segment files according to the EWF naming schema
+ * The segment files are found by testing if every segment file exists or
+ * if scan directory is set by listing the directory that contains them once
  * Make sure the value filenames is referencing, is set to NULL
  *
  * If the format is known the filename should contain the base of the filename
  * otherwise the function will try to determine the format based on the extension
  * Returns 1 if successful or -1 on error
  */
-int libewf_glob(
+int libewf_glob_segment_files(
      const char *filename,
      size_t filename_length,
      uint8_t format,
+     uint8_t scan_directory,
      char **filenames[],
      int *number_of_filenames,
      libcerror_error_t **error )
 {
-	libbfio_handle_t *file_io_handle = NULL;
-	char *segment_filename           = NULL;
-	void *reallocation               = NULL;
-	static char *function            = "libewf_glob";
-	size_t additional_length         = 0;
-	size_t segment_extention_length  = 0;
-	size_t segment_filename_index    = 0;
-	size_t segment_filename_length   = 0;
-	uint8_t segment_file_type        = 0;
-	int result                       = 0;
+	libbfio_handle_t *file_io_handle  = NULL;
+	char *segment_extensions          = NULL;
+	char *segment_filename            = NULL;
+	void *reallocation                = NULL;
+	static char *function             = "libewf_glob_segment_files";
+	size_t additional_length          = 0;
+	size_t path_length                = 0;
+	size_t segment_extension_index    = 0;
+	size_t segment_extension_length   = 0;
+	size_t segment_extention_length   = 0;
+	size_t segment_filename_index     = 0;
+	size_t segment_filename_length    = 0;
+	uint8_t segment_file_type         = 0;
+	int number_of_allocated_filenames = 0;
+	int number_of_segment_extensions  = 0;
+	int result                        = 0;
 
 	if( filename == NULL )
 	{
@@ -779,6 +978,8 @@ int libewf_glob(
 		}
 		segment_filename[ segment_filename_index++ ] = '.';
 
+		segment_extension_index = segment_filename_index;
+
 		if( libewf_filename_set_extension(
 		     segment_filename,
 		     segment_filename_length + 1,
@@ -800,25 +1001,94 @@ int libewf_glob(
 		}
 		/* The libewf_filename_set_extension also adds the end-of-string character */
 
-		if( libbfio_file_set_name(
-		     file_io_handle,
-		     segment_filename,
-		     segment_filename_length,
-		     error ) != 1 )
+		segment_extension_length = segment_filename_index - ( segment_extension_index + 1 );
+
+		if( ( scan_directory != 0 )
+		 && ( *number_of_filenames == 0 ) )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set name in file IO handle.",
-			 function );
+			/* List the directory once and determine the available extensions
+			 */
+			path_length = segment_extension_index;
 
-			goto on_error;
+			while( path_length > 0 )
+			{
+				if( ( segment_filename[ path_length - 1 ] == '/' )
+#if defined( WINAPI )
+				 || ( segment_filename[ path_length - 1 ] == '\\' )
+				 || ( segment_filename[ path_length - 1 ] == ':' )
+#endif
+				 )
+				{
+					break;
+				}
+				path_length--;
+			}
+			result = libewf_directory_get_extensions(
+			          segment_filename,
+			          path_length,
+			          &( segment_filename[ path_length ] ),
+			          segment_extension_index - path_length,
+			          segment_extension_length,
+			          &segment_extensions,
+			          &number_of_segment_extensions,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_GENERIC,
+				 "%s: unable to retrieve extensions from directory.",
+				 function );
+
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				/* Fall back to testing if every segment file exists
+				 * if the directory cannot be listed
+				 */
+				scan_directory = 0;
+			}
+		}
+		if( scan_directory != 0 )
+		{
+			if( number_of_segment_extensions == 0 )
+			{
+				result = 0;
+			}
+			else
+			{
+				result = libewf_directory_has_extension(
+				          segment_extensions,
+				          number_of_segment_extensions,
+				          &( segment_filename[ segment_extension_index ] ),
+				          segment_extension_length,
+				          error );
+			}
 		}
-		result = libbfio_handle_exists(
-		          file_io_handle,
-		          error );
+		else
+		{
+			if( libbfio_file_set_name(
+			     file_io_handle,
+			     segment_filename,
+			     segment_filename_length,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set name in file IO handle.",
+				 function );
 
+				goto on_error;
+			}
+			result = libbfio_handle_exists(
+			          file_io_handle,
+			          error );
+		}
 		if( result == -1 )
 		{
 			libcerror_error_set(
@@ -837,27 +1107,46 @@ int libewf_glob(
 
 			break;
 		}
-		*number_of_filenames += 1;
-
-		reallocation = memory_reallocate(
-		                *filenames,
-		                sizeof( char * ) * *number_of_filenames );
-
-		if( reallocation == NULL )
+		if( *number_of_filenames >= number_of_allocated_filenames )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-			 "%s: unable to resize filenames.",
-			 function );
+			/* Grow the filenames array exponentially to prevent a reallocation per segment file
+			 */
+			if( number_of_allocated_filenames == 0 )
+			{
+				number_of_allocated_filenames = 16;
+			}
+			else
+			{
+				number_of_allocated_filenames *= 2;
+			}
+			reallocation = memory_reallocate(
+			                *filenames,
+			                sizeof( char * ) * number_of_allocated_filenames );
 
-			goto on_error;
+			if( reallocation == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to resize filenames.",
+				 function );
+
+				goto on_error;
+			}
+			*filenames = (char **) reallocation;
 		}
-		*filenames = (char **) reallocation;
+		*number_of_filenames += 1;
 
 		( *filenames )[ *number_of_filenames - 1 ] = segment_filename;
 	}
+	if( segment_extensions != NULL )
+	{
+		memory_free(
+		 segment_extensions );
+
+		segment_extensions = NULL;
+	}
 	if( libbfio_handle_free(
 	     &file_io_handle,
 	     error ) != 1 )
@@ -874,6 +1163,11 @@ int libewf_glob(
 	return( 1 );
 
 on_error:
+	if( segment_extensions != NULL )
+	{
+		memory_free(
+		 segment_extensions );
+	}
 	if( segment_filename != NULL )
 	{
 		memory_free(
@@ -888,6 +1182,84 @@ on_error:
 	return( -1 );
 }
 
+/* Globs the segment files according to the EWF naming schema
+ * Make sure the value filenames is referencing, is set to NULL
+ *
+ * If the format is known the filename should contain the base of the filename
+ * otherwise the function will try to determine the format based on the extension
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_glob(
+     const char *filename,
+     size_t filename_length,
+     uint8_t format,
+     char **filenames[],
+     int *number_of_filenames,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_glob";
+
+	if( libewf_glob_segment_files(
+	     filename,
+	     filename_length,
+	     format,
+	     0,
+	     filenames,
+	     number_of_filenames,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to glob segment files.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Globs the segment files according to the EWF naming schema by listing the directory
+ * This is faster than libewf_glob for directories on a network share or with many segment files
+ * The resulting filenames are the same as those of libewf_glob
+ * Make sure the value filenames is referencing, is set to NULL
+ *
+ * If the format is known the filename should contain the base of the filename
+ * otherwise the function will try to determine the format based on the extension
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_glob_directory(
+     const char *filename,
+     size_t filename_length,
+     uint8_t format,
+     char **filenames[],
+     int *number_of_filenames,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_glob_directory";
+
+	if( libewf_glob_segment_files(
+	     filename,
+	     filename_length,
+	     format,
+	     1,
+	     filenames,
+	     number_of_filenames,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to glob segment files.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Frees globbed filenames
  * Returns 1 if successful or -1 on error
  */
@@ -937,30 +1309,39 @@ int libewf_glob_free(
 #if defined( HAVE_WIDE_CHARACTER_TYPE )
 
 /* Globs the segment files according to the EWF naming schema
+ * The segment files are found by testing if every segment file exists or
+ * if scan directory is set by listing the directory that contains them once
  * Make sure the value filenames is referencing, is set to NULL
  *
  * If the format is known the filename should contain the base of the filename
  * otherwise the function will try to determine the format based on the extension
  * Returns 1 if successful or -1 on error
  */
-int libewf_glob_wide(
+int libewf_glob_segment_files_wide(
      const wchar_t *filename,
      size_t filename_length,
      uint8_t format,
+     uint8_t scan_directory,
      wchar_t **filenames[],
      int *number_of_filenames,
      libcerror_error_t **error )
 {
-	libbfio_handle_t *file_io_handle = NULL;
-	wchar_t *segment_filename        = NULL;
-	void *reallocation               = NULL;
-	static char *function            = "libewf_glob_wide";
-	size_t additional_length         = 0;
-	size_t segment_extention_length  = 0;
-	size_t segment_filename_index    = 0;
-	size_t segment_filename_length   = 0;
-	int result                       = 0;
-	uint8_t segment_file_type        = 0;
+	libbfio_handle_t *file_io_handle  = NULL;
+	wchar_t *segment_extensions       = NULL;
+	wchar_t *segment_filename         = NULL;
+	void *reallocation                = NULL;
+	static char *function             = "libewf_glob_segment_files_wide";
+	size_t additional_length          = 0;
+	size_t path_length                = 0;
+	size_t segment_extension_index    = 0;
+	size_t segment_extension_length   = 0;
+	size_t segment_extention_length   = 0;
+	size_t segment_filename_index     = 0;
+	size_t segment_filename_length    = 0;
+	int number_of_allocated_filenames = 0;
+	int number_of_segment_extensions  = 0;
+	int result                        = 0;
+	uint8_t segment_file_type         = 0;
 
 	if( filename == NULL )
 	{
@@ -1216,6 +1597,8 @@ int libewf_glob_wide(
 		}
 		segment_filename[ segment_filename_index++ ] = (wchar_t) '.';
 
+		segment_extension_index = segment_filename_index;
+
 		if( libewf_filename_set_extension_wide(
 		     segment_filename,
 		     segment_filename_length + 1,
@@ -1237,25 +1620,94 @@ int libewf_glob_wide(
 		}
 		/* The libewf_filename_set_extension_wide also adds the end-of-string character */
 
-		if( libbfio_file_set_name_wide(
-		     file_io_handle,
-		     segment_filename,
-		     segment_filename_length,
-		     error ) != 1 )
+		segment_extension_length = segment_filename_index - ( segment_extension_index + 1 );
+
+		if( ( scan_directory != 0 )
+		 && ( *number_of_filenames == 0 ) )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set name in file IO handle.",
-			 function );
+			/* List the directory once and determine the available extensions
+			 */
+			path_length = segment_extension_index;
 
-			goto on_error;
+			while( path_length > 0 )
+			{
+				if( ( segment_filename[ path_length - 1 ] == (wchar_t) '/' )
+#if defined( WINAPI )
+				 || ( segment_filename[ path_length - 1 ] == (wchar_t) '\\' )
+				 || ( segment_filename[ path_length - 1 ] == (wchar_t) ':' )
+#endif
+				 )
+				{
+					break;
+				}
+				path_length--;
+			}
+			result = libewf_directory_get_extensions_wide(
+			          segment_filename,
+			          path_length,
+			          &( segment_filename[ path_length ] ),
+			          segment_extension_index - path_length,
+			          segment_extension_length,
+			          &segment_extensions,
+			          &number_of_segment_extensions,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_GENERIC,
+				 "%s: unable to retrieve extensions from directory.",
+				 function );
+
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				/* Fall back to testing if every segment file exists
+				 * if the directory cannot be listed
+				 */
+				scan_directory = 0;
+			}
 		}
-		result = libbfio_handle_exists(
-		          file_io_handle,
-		          error );
+		if( scan_directory != 0 )
+		{
+			if( number_of_segment_extensions == 0 )
+			{
+				result = 0;
+			}
+			else
+			{
+				result = libewf_directory_has_extension_wide(
+				          segment_extensions,
+				          number_of_segment_extensions,
+				          &( segment_filename[ segment_extension_index ] ),
+				          segment_extension_length,
+				          error );
+			}
+		}
+		else
+		{
+			if( libbfio_file_set_name_wide(
+			     file_io_handle,
+			     segment_filename,
+			     segment_filename_length,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set name in file IO handle.",
+				 function );
 
+				goto on_error;
+			}
+			result = libbfio_handle_exists(
+			          file_io_handle,
+			          error );
+		}
 		if( result == -1 )
 		{
 			libcerror_error_set(
@@ -1274,27 +1726,46 @@ int libewf_glob_wide(
 
 			break;
 		}
-		*number_of_filenames += 1;
-
-		reallocation = memory_reallocate(
-		                *filenames,
-		                sizeof( wchar_t * ) * *number_of_filenames );
-
-		if( reallocation == NULL )
+		if( *number_of_filenames >= number_of_allocated_filenames )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-			 "%s: unable to resize filenames.",
-			 function );
+			/* Grow the filenames array exponentially to prevent a reallocation per segment file
+			 */
+			if( number_of_allocated_filenames == 0 )
+			{
+				number_of_allocated_filenames = 16;
+			}
+			else
+			{
+				number_of_allocated_filenames *= 2;
+			}
+			reallocation = memory_reallocate(
+			                *filenames,
+			                sizeof( wchar_t * ) * number_of_allocated_filenames );
 
-			goto on_error;
+			if( reallocation == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to resize filenames.",
+				 function );
+
+				goto on_error;
+			}
+			*filenames = (wchar_t **) reallocation;
 		}
-		*filenames = (wchar_t **) reallocation;
+		*number_of_filenames += 1;
 
 		( *filenames )[ *number_of_filenames - 1 ] = segment_filename;
 	}
+	if( segment_extensions != NULL )
+	{
+		memory_free(
+		 segment_extensions );
+
+		segment_extensions = NULL;
+	}
 	if( libbfio_handle_free(
 	     &file_io_handle,
 	     error ) != 1 )
@@ -1311,6 +1782,11 @@ int libewf_glob_wide(
 	return( 1 );
 
 on_error:
+	if( segment_extensions != NULL )
+	{
+		memory_free(
+		 segment_extensions );
+	}
 	if( segment_filename != NULL )
 	{
 		memory_free(
@@ -1325,6 +1801,84 @@ on_error:
 	return( -1 );
 }
 
+/* Globs the segment files according to the EWF naming schema
+ * Make sure the value filenames is referencing, is set to NULL
+ *
+ * If the format is known the filename should contain the base of the filename
+ * otherwise the function will try to determine the format based on the extension
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_glob_wide(
+     const wchar_t *filename,
+     size_t filename_length,
+     uint8_t format,
+     wchar_t **filenames[],
+     int *number_of_filenames,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_glob_wide";
+
+	if( libewf_glob_segment_files_wide(
+	     filename,
+	     filename_length,
+	     format,
+	     0,
+	     filenames,
+	     number_of_filenames,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to glob segment files.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Globs the segment files according to the EWF naming schema by listing the directory
+ * This is faster than libewf_glob_wide for directories on a network share or with many segment files
+ * The resulting filenames are the same as those of libewf_glob_wide
+ * Make sure the value filenames is referencing, is set to NULL
+ *
+ * If the format is known the filename should contain the base of the filename
+ * otherwise the function will try to determine the format based on the extension
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_glob_directory_wide(
+     const wchar_t *filename,
+     size_t filename_length,
+     uint8_t format,
+     wchar_t **filenames[],
+     int *number_of_filenames,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_glob_directory_wide";
+
+	if( libewf_glob_segment_files_wide(
+	     filename,
+	     filename_length,
+	     format,
+	     1,
+	     filenames,
+	     number_of_filenames,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to glob segment files.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Frees globbed wide filenames
  * Returns 1 if successful or -1 on error
  */
@@ -67,6 +67,23 @@ int libewf_set_codepage(
 
 #endif /* !defined( HAVE_LOCAL_LIBEWF ) */
 
+LIBEWF_EXTERN \
+int libewf_get_maximum_number_of_open_handles(
+     int *maximum_number_of_open_handles,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_set_maximum_number_of_open_handles(
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_get_open_handles_statistics(
+     uint64_t *number_of_opens,
+     uint64_t *number_of_closes,
+     uint64_t *number_of_hits,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_check_file_signature(
      const char *filename,
@@ -86,6 +103,15 @@ int libewf_check_file_signature_file_io_handle(
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error );
 
+int libewf_glob_segment_files(
+     const char *filename,
+     size_t filename_length,
+     uint8_t format,
+     uint8_t scan_directory,
+     char **filenames[],
+     int *number_of_filenames,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_glob(
      const char *filename,
@@ -95,6 +121,15 @@ int libewf_glob(
      int *number_of_filenames,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_glob_directory(
+     const char *filename,
+     size_t length,
+     uint8_t format,
+     char **filenames[],
+     int *number_of_filenames,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_glob_free(
      char *filenames[],
@@ -103,6 +138,15 @@ int libewf_glob_free(
 
 #if defined( HAVE_WIDE_CHARACTER_TYPE )
 
+int libewf_glob_segment_files_wide(
+     const wchar_t *filename,
+     size_t filename_length,
+     uint8_t format,
+     uint8_t scan_directory,
+     wchar_t **filenames[],
+     int *number_of_filenames,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_glob_wide(
      const wchar_t *filename,
@@ -112,6 +156,15 @@ int libewf_glob_wide(
      int *number_of_filenames,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_glob_directory_wide(
+     const wchar_t *filename,
+     size_t length,
+     uint8_t format,
+     wchar_t **filenames[],
+     int *number_of_filenames,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_glob_wide_free(
      wchar_t *filenames[],
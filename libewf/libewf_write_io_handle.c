@@ -210,6 +210,22 @@ int libewf_write_io_handle_free(
 			memory_free(
 			 ( *write_io_handle )->compressed_zero_byte_empty_block );
 		}
+		if( ( *write_io_handle )->deflate_encoder != NULL )
+		{
+			if( libewf_deflate_encoder_free(
+			     &( ( *write_io_handle )->deflate_encoder ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free deflate encoder.",
+				 function );
+
+				result = -1;
+			}
+		}
 		if( libewf_chunk_group_free(
 		     &( ( *write_io_handle )->chunk_group ),
 		     error ) != 1 )
@@ -307,6 +323,7 @@ int libewf_write_io_handle_clone(
 	( *destination_write_io_handle )->table_entries_data      = NULL;
 	( *destination_write_io_handle )->table_entries_data_size = 0;
 	( *destination_write_io_handle )->number_of_table_entries = 0;
+	( *destination_write_io_handle )->deflate_encoder         = NULL;
 
 	if( source_write_io_handle->case_data != NULL )
 	{
@@ -581,6 +598,13 @@ int libewf_write_io_handle_initialize_values(
 	 || ( io_handle->format == LIBEWF_FORMAT_SMART ) )
 	{
 		write_io_handle->pack_flags |= LIBEWF_PACK_FLAG_FORCE_COMPRESSION;
+
+		/* If compression is forced but no compression level provided use the default
+		 */
+		if( io_handle->compression_level == LIBEWF_COMPRESSION_NONE )
+		{
+			io_handle->compression_level = LIBEWF_COMPRESSION_DEFAULT;
+		}
 	}
 	else if( ( io_handle->format == LIBEWF_FORMAT_V2_ENCASE7 )
 	      || ( io_handle->format == LIBEWF_FORMAT_V2_LOGICAL_ENCASE7 ) )
@@ -714,6 +738,23 @@ int libewf_write_io_handle_initialize_values(
 	}
 	io_handle->chunk_size = media_values->chunk_size;
 
+	if( ( io_handle->compression_method == LIBEWF_COMPRESSION_METHOD_DEFLATE )
+	 && ( write_io_handle->deflate_encoder == NULL ) )
+	{
+		if( libewf_deflate_encoder_initialize(
+		     &( write_io_handle->deflate_encoder ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create deflate encoder.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( ( write_io_handle->pack_flags & LIBEWF_PACK_FLAG_FORCE_COMPRESSION ) == 0 )
 	{
 		if( write_io_handle->compressed_zero_byte_empty_block == NULL )
@@ -775,6 +816,7 @@ int libewf_write_io_handle_initialize_values(
 				  compression_level,
 				  zero_byte_empty_block,
 				  (size_t) media_values->chunk_size,
+				  write_io_handle->deflate_encoder,
 				  error );
 
 			/* Check if the compressed buffer was too small
@@ -831,6 +873,7 @@ int libewf_write_io_handle_initialize_values(
 					  compression_level,
 					  zero_byte_empty_block,
 					  (size_t) media_values->chunk_size,
+					  write_io_handle->deflate_encoder,
 					  error );
 			}
 			if( result != 1 )
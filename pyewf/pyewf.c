@@ -31,6 +31,7 @@
 
 #include "pyewf.h"
 #include "pyewf_compression_methods.h"
+#include "pyewf_data_chunks.h"
 #include "pyewf_error.h"
 #include "pyewf_file_entries.h"
 #include "pyewf_file_entry.h"
@@ -355,6 +356,7 @@ PyObject *pyewf_check_file_signature_file_object(
 	if( pyewf_file_object_initialize(
 	     &file_io_handle,
 	     file_object,
+	     0,
 	     &error ) != 1 )
 	{
 		pyewf_error_raise(
@@ -845,6 +847,7 @@ PyMODINIT_FUNC initpyewf(
 {
 	PyObject *module                              = NULL;
 	PyTypeObject *compression_methods_type_object = NULL;
+	PyTypeObject *data_chunks_type_object         = NULL;
 	PyTypeObject *file_entries_type_object        = NULL;
 	PyTypeObject *file_entry_type_object          = NULL;
 	PyTypeObject *handle_type_object              = NULL;
@@ -1014,6 +1017,25 @@ PyMODINIT_FUNC initpyewf(
 	 "_file_entries",
 	 (PyObject *) file_entries_type_object );
 
+	/* Setup the data chunks type object
+	 */
+	pyewf_data_chunks_type_object.tp_new = PyType_GenericNew;
+
+	if( PyType_Ready(
+	     &pyewf_data_chunks_type_object ) < 0 )
+	{
+		goto on_error;
+	}
+	Py_IncRef(
+	 (PyObject *) &pyewf_data_chunks_type_object );
+
+	data_chunks_type_object = &pyewf_data_chunks_type_object;
+
+	PyModule_AddObject(
+	 module,
+	 "_data_chunks",
+	 (PyObject *) data_chunks_type_object );
+
 	PyGILState_Release(
 	 gil_state );
 
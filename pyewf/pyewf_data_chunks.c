@@ -0,0 +1,503 @@
+/*
+ * Python object definition of the media data chunks iterator
+ *
+ * Copyright (C) 2008-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( HAVE_WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "pyewf_data_chunks.h"
+#include "pyewf_error.h"
+#include "pyewf_handle.h"
+#include "pyewf_libcerror.h"
+#include "pyewf_libewf.h"
+#include "pyewf_python.h"
+
+PyTypeObject pyewf_data_chunks_type_object = {
+	PyVarObject_HEAD_INIT( NULL, 0 )
+
+	/* tp_name */
+	"pyewf._data_chunks",
+	/* tp_basicsize */
+	sizeof( pyewf_data_chunks_t ),
+	/* tp_itemsize */
+	0,
+	/* tp_dealloc */
+	(destructor) pyewf_data_chunks_free,
+	/* tp_print */
+	0,
+	/* tp_getattr */
+	0,
+	/* tp_setattr */
+	0,
+	/* tp_compare */
+	0,
+	/* tp_repr */
+	0,
+	/* tp_as_number */
+	0,
+	/* tp_as_sequence */
+	0,
+	/* tp_as_mapping */
+	0,
+	/* tp_hash */
+	0,
+	/* tp_call */
+	0,
+	/* tp_str */
+	0,
+	/* tp_getattro */
+	0,
+	/* tp_setattro */
+	0,
+	/* tp_as_buffer */
+	0,
+	/* tp_flags */
+	Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_ITER,
+	/* tp_doc */
+	"internal pyewf media data chunks iterator object",
+	/* tp_traverse */
+	0,
+	/* tp_clear */
+	0,
+	/* tp_richcompare */
+	0,
+	/* tp_weaklistoffset */
+	0,
+	/* tp_iter */
+	(getiterfunc) pyewf_data_chunks_iter,
+	/* tp_iternext */
+	(iternextfunc) pyewf_data_chunks_iternext,
+	/* tp_methods */
+	0,
+	/* tp_members */
+	0,
+	/* tp_getset */
+	0,
+	/* tp_base */
+	0,
+	/* tp_dict */
+	0,
+	/* tp_descr_get */
+	0,
+	/* tp_descr_set */
+	0,
+	/* tp_dictoffset */
+	0,
+	/* tp_init */
+	(initproc) pyewf_data_chunks_init,
+	/* tp_alloc */
+	0,
+	/* tp_new */
+	0,
+	/* tp_free */
+	0,
+	/* tp_is_gc */
+	0,
+	/* tp_bases */
+	NULL,
+	/* tp_mro */
+	NULL,
+	/* tp_cache */
+	NULL,
+	/* tp_subclasses */
+	NULL,
+	/* tp_weaklist */
+	NULL,
+	/* tp_del */
+	0
+};
+
+/* Creates a new data chunks object
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyewf_data_chunks_new(
+           pyewf_handle_t *handle_object,
+           size_t chunk_size,
+           off64_t offset,
+           size64_t media_size,
+           PyObject *buffer_object )
+{
+	pyewf_data_chunks_t *pyewf_data_chunks = NULL;
+	static char *function                  = "pyewf_data_chunks_new";
+
+	if( handle_object == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid handle object.",
+		 function );
+
+		return( NULL );
+	}
+	if( ( chunk_size == 0 )
+	 || ( chunk_size > (size_t) SSIZE_MAX ) )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid chunk size value out of bounds.",
+		 function );
+
+		return( NULL );
+	}
+	if( offset < 0 )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( NULL );
+	}
+	/* Make sure the data chunks values are initialized
+	 */
+	pyewf_data_chunks = PyObject_New(
+	                     struct pyewf_data_chunks,
+	                     &pyewf_data_chunks_type_object );
+
+	if( pyewf_data_chunks == NULL )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to initialize data chunks.",
+		 function );
+
+		goto on_error;
+	}
+	if( pyewf_data_chunks_init(
+	     pyewf_data_chunks ) != 0 )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to initialize data chunks.",
+		 function );
+
+		goto on_error;
+	}
+	pyewf_data_chunks->handle_object  = handle_object;
+	pyewf_data_chunks->buffer_object  = buffer_object;
+	pyewf_data_chunks->chunk_size     = chunk_size;
+	pyewf_data_chunks->current_offset = offset;
+	pyewf_data_chunks->media_size     = media_size;
+
+	Py_IncRef(
+	 (PyObject *) pyewf_data_chunks->handle_object );
+
+	if( pyewf_data_chunks->buffer_object != NULL )
+	{
+		Py_IncRef(
+		 pyewf_data_chunks->buffer_object );
+	}
+	return( (PyObject *) pyewf_data_chunks );
+
+on_error:
+	if( pyewf_data_chunks != NULL )
+	{
+		Py_DecRef(
+		 (PyObject *) pyewf_data_chunks );
+	}
+	return( NULL );
+}
+
+/* Intializes a data chunks object
+ * Returns 0 if successful or -1 on error
+ */
+int pyewf_data_chunks_init(
+     pyewf_data_chunks_t *pyewf_data_chunks )
+{
+	static char *function = "pyewf_data_chunks_init";
+
+	if( pyewf_data_chunks == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid data chunks.",
+		 function );
+
+		return( -1 );
+	}
+	/* Make sure the data chunks values are initialized
+	 */
+	pyewf_data_chunks->handle_object  = NULL;
+	pyewf_data_chunks->buffer_object  = NULL;
+	pyewf_data_chunks->chunk_size     = 0;
+	pyewf_data_chunks->current_offset = 0;
+	pyewf_data_chunks->media_size     = 0;
+
+	return( 0 );
+}
+
+/* Frees a data chunks object
+ */
+void pyewf_data_chunks_free(
+      pyewf_data_chunks_t *pyewf_data_chunks )
+{
+	struct _typeobject *ob_type = NULL;
+	static char *function       = "pyewf_data_chunks_free";
+
+	if( pyewf_data_chunks == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid data chunks.",
+		 function );
+
+		return;
+	}
+	ob_type = Py_TYPE(
+	           pyewf_data_chunks );
+
+	if( ob_type == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: missing ob_type.",
+		 function );
+
+		return;
+	}
+	if( ob_type->tp_free == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid ob_type - missing tp_free.",
+		 function );
+
+		return;
+	}
+	if( pyewf_data_chunks->buffer_object != NULL )
+	{
+		Py_DecRef(
+		 pyewf_data_chunks->buffer_object );
+	}
+	if( pyewf_data_chunks->handle_object != NULL )
+	{
+		Py_DecRef(
+		 (PyObject *) pyewf_data_chunks->handle_object );
+	}
+	ob_type->tp_free(
+	 (PyObject*) pyewf_data_chunks );
+}
+
+/* The data chunks iter() function
+ */
+PyObject *pyewf_data_chunks_iter(
+           pyewf_data_chunks_t *pyewf_data_chunks )
+{
+	static char *function = "pyewf_data_chunks_iter";
+
+	if( pyewf_data_chunks == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid data chunks.",
+		 function );
+
+		return( NULL );
+	}
+	Py_IncRef(
+	 (PyObject *) pyewf_data_chunks );
+
+	return( (PyObject *) pyewf_data_chunks );
+}
+
+/* The data chunks iternext() function
+ * The media data is read directly into the buffer object, which is either
+ * the buffer object of the iterator, that is reused for every chunk, or
+ * a newly created bytearray
+ * Returns a memoryview of the chunk data if successful or NULL on error
+ */
+PyObject *pyewf_data_chunks_iternext(
+           pyewf_data_chunks_t *pyewf_data_chunks )
+{
+	Py_buffer buffer_view;
+
+	libcerror_error_t *error    = NULL;
+	PyObject *buffer_object     = NULL;
+	PyObject *memoryview_object = NULL;
+	PyObject *slice_object      = NULL;
+	static char *function       = "pyewf_data_chunks_iternext";
+	ssize_t read_count          = 0;
+	size_t read_size            = 0;
+	int has_buffer_view         = 0;
+
+	if( pyewf_data_chunks == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid data chunks.",
+		 function );
+
+		return( NULL );
+	}
+	if( pyewf_data_chunks->handle_object == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid data chunks - missing handle object.",
+		 function );
+
+		return( NULL );
+	}
+	if( pyewf_data_chunks->current_offset < 0 )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid data chunks - invalid current offset.",
+		 function );
+
+		return( NULL );
+	}
+	if( (size64_t) pyewf_data_chunks->current_offset >= pyewf_data_chunks->media_size )
+	{
+		PyErr_SetNone(
+		 PyExc_StopIteration );
+
+		return( NULL );
+	}
+	read_size = pyewf_data_chunks->chunk_size;
+
+	if( (size64_t) read_size > ( pyewf_data_chunks->media_size - pyewf_data_chunks->current_offset ) )
+	{
+		read_size = (size_t) ( pyewf_data_chunks->media_size - pyewf_data_chunks->current_offset );
+	}
+	if( pyewf_data_chunks->buffer_object != NULL )
+	{
+		buffer_object = pyewf_data_chunks->buffer_object;
+
+		Py_IncRef(
+		 buffer_object );
+	}
+	else
+	{
+		buffer_object = PyByteArray_FromStringAndSize(
+		                 NULL,
+		                 (Py_ssize_t) read_size );
+
+		if( buffer_object == NULL )
+		{
+			goto on_error;
+		}
+	}
+	if( PyObject_GetBuffer(
+	     buffer_object,
+	     &buffer_view,
+	     PyBUF_WRITABLE ) != 0 )
+	{
+		goto on_error;
+	}
+	has_buffer_view = 1;
+
+	if( buffer_view.len < (Py_ssize_t) read_size )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid buffer size value too small.",
+		 function );
+
+		goto on_error;
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	read_count = libewf_handle_read_buffer_at_offset(
+	              pyewf_data_chunks->handle_object->handle,
+	              (uint8_t *) buffer_view.buf,
+	              read_size,
+	              pyewf_data_chunks->current_offset,
+	              &error );
+
+	Py_END_ALLOW_THREADS
+
+	PyBuffer_Release(
+	 &buffer_view );
+
+	has_buffer_view = 0;
+
+	if( read_count <= -1 )
+	{
+		pyewf_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to read data.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		goto on_error;
+	}
+	if( read_count == 0 )
+	{
+		Py_DecRef(
+		 buffer_object );
+
+		PyErr_SetNone(
+		 PyExc_StopIteration );
+
+		return( NULL );
+	}
+	pyewf_data_chunks->current_offset += (off64_t) read_count;
+
+	memoryview_object = PyMemoryView_FromObject(
+	                     buffer_object );
+
+	Py_DecRef(
+	 buffer_object );
+
+	buffer_object = NULL;
+
+	if( memoryview_object == NULL )
+	{
+		goto on_error;
+	}
+	/* Limit the memoryview to the data that was read
+	 */
+	if( (Py_ssize_t) read_count != PySequence_Size(
+	                                memoryview_object ) )
+	{
+		slice_object = PySequence_GetSlice(
+		                memoryview_object,
+		                0,
+		                (Py_ssize_t) read_count );
+
+		Py_DecRef(
+		 memoryview_object );
+
+		memoryview_object = slice_object;
+	}
+	return( memoryview_object );
+
+on_error:
+	if( has_buffer_view != 0 )
+	{
+		PyBuffer_Release(
+		 &buffer_view );
+	}
+	if( buffer_object != NULL )
+	{
+		Py_DecRef(
+		 buffer_object );
+	}
+	return( NULL );
+}
+
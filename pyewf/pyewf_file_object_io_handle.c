@@ -37,6 +37,7 @@
 int pyewf_file_object_io_handle_initialize(
      pyewf_file_object_io_handle_t **file_object_io_handle,
      PyObject *file_object,
+     size_t read_ahead_size,
      libcerror_error_t **error )
 {
 	static char *function = "pyewf_file_object_io_handle_initialize";
@@ -74,6 +75,17 @@ int pyewf_file_object_io_handle_initialize(
 
 		return( -1 );
 	}
+	if( read_ahead_size > (size_t) PYEWF_FILE_OBJECT_IO_HANDLE_MAXIMUM_READ_AHEAD_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid read-ahead size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
 	*file_object_io_handle = (pyewf_file_object_io_handle_t *) PyMem_Malloc(
 	                                                            sizeof( pyewf_file_object_io_handle_t ) );
 
@@ -102,7 +114,9 @@ int pyewf_file_object_io_handle_initialize(
 
 		goto on_error;
 	}
-	( *file_object_io_handle )->file_object = file_object;
+	( *file_object_io_handle )->file_object        = file_object;
+	( *file_object_io_handle )->read_ahead_size    = read_ahead_size;
+	( *file_object_io_handle )->file_object_offset = -1;
 
 	Py_IncRef(
 	 ( *file_object_io_handle )->file_object );
@@ -126,6 +140,7 @@ on_error:
 int pyewf_file_object_initialize(
      libbfio_handle_t **handle,
      PyObject *file_object,
+     size_t read_ahead_size,
      libcerror_error_t **error )
 {
 	pyewf_file_object_io_handle_t *file_object_io_handle = NULL;
@@ -156,6 +171,7 @@ int pyewf_file_object_initialize(
 	if( pyewf_file_object_io_handle_initialize(
 	     &file_object_io_handle,
 	     file_object,
+	     read_ahead_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -235,6 +251,11 @@ int pyewf_file_object_io_handle_free(
 		PyGILState_Release(
 		 gil_state );
 
+		if( ( *file_object_io_handle )->read_ahead_buffer != NULL )
+		{
+			memory_free(
+			 ( *file_object_io_handle )->read_ahead_buffer );
+		}
 		PyMem_Free(
 		 *file_object_io_handle );
 
@@ -284,6 +305,7 @@ int pyewf_file_object_io_handle_clone(
 	if( pyewf_file_object_io_handle_initialize(
 	     destination_file_object_io_handle,
 	     source_file_object_io_handle->file_object,
+	     source_file_object_io_handle->read_ahead_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -317,7 +339,9 @@ int pyewf_file_object_io_handle_open(
      int access_flags,
      libcerror_error_t **error )
 {
-	static char *function = "pyewf_file_object_io_handle_open";
+	PyObject *method_name      = NULL;
+	static char *function      = "pyewf_file_object_io_handle_open";
+	PyGILState_STATE gil_state = 0;
 
 	if( file_object_io_handle == NULL )
 	{
@@ -364,9 +388,55 @@ int pyewf_file_object_io_handle_open(
 
 		return( -1 );
 	}
-	/* No need to do anything here, because the file object is already open
+	/* No need to open the file object here, because the file object is already open
 	 */
-	file_object_io_handle->access_flags = access_flags;
+	if( file_object_io_handle->read_ahead_size > 0 )
+	{
+		if( file_object_io_handle->read_ahead_buffer == NULL )
+		{
+			file_object_io_handle->read_ahead_buffer = (uint8_t *) memory_allocate(
+			                                                        sizeof( uint8_t ) * file_object_io_handle->read_ahead_size );
+
+			if( file_object_io_handle->read_ahead_buffer == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create read-ahead buffer.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		gil_state = PyGILState_Ensure();
+
+#if PY_MAJOR_VERSION >= 3
+		method_name = PyUnicode_FromString(
+		               "readinto" );
+#else
+		method_name = PyString_FromString(
+		               "readinto" );
+#endif
+		PyErr_Clear();
+
+		/* Determine if the file object has the readinto method
+		 */
+		file_object_io_handle->has_readinto_method = PyObject_HasAttr(
+		                                              file_object_io_handle->file_object,
+		                                              method_name );
+
+		Py_DecRef(
+		 method_name );
+
+		PyGILState_Release(
+		 gil_state );
+	}
+	file_object_io_handle->read_ahead_buffer_offset    = 0;
+	file_object_io_handle->read_ahead_buffer_data_size = 0;
+	file_object_io_handle->current_offset              = 0;
+	file_object_io_handle->file_object_offset          = -1;
+	file_object_io_handle->access_flags                = access_flags;
 
 	return( 1 );
 }
@@ -404,7 +474,8 @@ int pyewf_file_object_io_handle_close(
 	}
 	/* Do not close the file object, have Python deal with it
 	 */
-	file_object_io_handle->access_flags = 0;
+	file_object_io_handle->read_ahead_buffer_data_size = 0;
+	file_object_io_handle->access_flags                = 0;
 
 	return( 0 );
 }
@@ -613,7 +684,268 @@ on_error:
 	return( -1 );
 }
 
+/* Reads a buffer from the file object using its readinto method
+ * Make sure to hold the GIL state before calling this function
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t pyewf_file_object_readinto_buffer(
+         PyObject *file_object,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	PyObject *memory_object    = NULL;
+	PyObject *method_name      = NULL;
+	PyObject *method_result    = NULL;
+	static char *function      = "pyewf_file_object_readinto_buffer";
+	Py_ssize_t safe_read_count = 0;
+	ssize_t read_count         = 0;
+
+	if( file_object == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file object.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > 0 )
+	{
+		/* Let the file object write directly into the buffer
+		 * to prevent an intermediate binary string object
+		 */
+#if PY_MAJOR_VERSION >= 3
+		memory_object = PyMemoryView_FromMemory(
+		                 (char *) buffer,
+		                 (Py_ssize_t) size,
+		                 PyBUF_WRITE );
+#else
+		memory_object = PyBuffer_FromReadWriteMemory(
+		                 (void *) buffer,
+		                 (Py_ssize_t) size );
+#endif
+		if( memory_object == NULL )
+		{
+			pyewf_error_fetch(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create memory object.",
+			 function );
+
+			goto on_error;
+		}
+#if PY_MAJOR_VERSION >= 3
+		method_name = PyUnicode_FromString(
+			       "readinto" );
+#else
+		method_name = PyString_FromString(
+			       "readinto" );
+#endif
+		PyErr_Clear();
+
+		method_result = PyObject_CallMethodObjArgs(
+				 file_object,
+				 method_name,
+				 memory_object,
+				 NULL );
+
+		if( PyErr_Occurred() )
+		{
+			pyewf_error_fetch(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read from file object.",
+			 function );
+
+			goto on_error;
+		}
+		if( method_result == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing method result.",
+			 function );
+
+			goto on_error;
+		}
+		/* A non-blocking file object returns None if no data is available
+		 */
+		if( method_result != Py_None )
+		{
+			safe_read_count = PyNumber_AsSsize_t(
+			                   method_result,
+			                   NULL );
+
+			if( PyErr_Occurred() )
+			{
+				pyewf_error_fetch(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to convert method result into read count.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( ( safe_read_count < 0 )
+		 || ( (size_t) safe_read_count > size ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid read count value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		read_count = (ssize_t) safe_read_count;
+
+		Py_DecRef(
+		 method_result );
+
+		Py_DecRef(
+		 method_name );
+
+		Py_DecRef(
+		 memory_object );
+	}
+	return( read_count );
+
+on_error:
+	if( method_result != NULL )
+	{
+		Py_DecRef(
+		 method_result );
+	}
+	if( method_name != NULL )
+	{
+		Py_DecRef(
+		 method_name );
+	}
+	if( memory_object != NULL )
+	{
+		Py_DecRef(
+		 memory_object );
+	}
+	return( -1 );
+}
+
+/* Reads a buffer from the file object at the current offset of the file object IO handle
+ * The file object is only repositioned if its offset differs from the current offset
+ * Make sure to hold the GIL state before calling this function
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t pyewf_file_object_io_handle_read_from_file_object(
+         pyewf_file_object_io_handle_t *file_object_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function = "pyewf_file_object_io_handle_read_from_file_object";
+	ssize_t read_count    = 0;
+
+	if( file_object_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file object IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_object_io_handle->file_object_offset != file_object_io_handle->current_offset )
+	{
+		if( pyewf_file_object_seek_offset(
+		     file_object_io_handle->file_object,
+		     file_object_io_handle->current_offset,
+		     SEEK_SET,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek offset: %" PRIi64 " (0x%08" PRIx64 ") in file object.",
+			 function,
+			 file_object_io_handle->current_offset,
+			 file_object_io_handle->current_offset );
+
+			return( -1 );
+		}
+		file_object_io_handle->file_object_offset = file_object_io_handle->current_offset;
+	}
+	if( file_object_io_handle->has_readinto_method != 0 )
+	{
+		read_count = pyewf_file_object_readinto_buffer(
+		              file_object_io_handle->file_object,
+		              buffer,
+		              size,
+		              error );
+	}
+	else
+	{
+		read_count = pyewf_file_object_read_buffer(
+		              file_object_io_handle->file_object,
+		              buffer,
+		              size,
+		              error );
+	}
+	if( read_count == -1 )
+	{
+		/* The offset of the file object is unknown after a failed read
+		 */
+		file_object_io_handle->file_object_offset = -1;
+
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read from file object.",
+		 function );
+
+		return( -1 );
+	}
+	file_object_io_handle->file_object_offset += (off64_t) read_count;
+
+	return( read_count );
+}
+
 /* Reads a buffer from the file object IO handle
+ * If a read-ahead size is set, small reads are served from the read-ahead buffer
+ * so that the GIL is acquired and the file object is called less often
  * Returns the number of bytes read if successful, or -1 on error
  */
 ssize_t pyewf_file_object_io_handle_read(
@@ -624,7 +956,10 @@ ssize_t pyewf_file_object_io_handle_read(
 {
 	static char *function      = "pyewf_file_object_io_handle_read";
 	PyGILState_STATE gil_state = 0;
+	size_t buffer_offset       = 0;
+	size_t read_size           = 0;
 	ssize_t read_count         = 0;
+	off64_t data_offset        = 0;
 
 	if( file_object_io_handle == NULL )
 	{
@@ -637,29 +972,160 @@ ssize_t pyewf_file_object_io_handle_read(
 
 		return( -1 );
 	}
-	gil_state = PyGILState_Ensure();
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
 
-	read_count = pyewf_file_object_read_buffer(
-	              file_object_io_handle->file_object,
-	              buffer,
-	              size,
-	              error );
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
 
-	if( read_count == -1 )
+		return( -1 );
+	}
+	if( ( file_object_io_handle->read_ahead_size > 0 )
+	 && ( file_object_io_handle->read_ahead_buffer == NULL ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read from file object.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file object IO handle - missing read-ahead buffer.",
 		 function );
 
-		goto on_error;
+		return( -1 );
+	}
+	gil_state = PyGILState_Ensure();
+
+	if( file_object_io_handle->read_ahead_size == 0 )
+	{
+		read_count = pyewf_file_object_read_buffer(
+		              file_object_io_handle->file_object,
+		              buffer,
+		              size,
+		              error );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read from file object.",
+			 function );
+
+			goto on_error;
+		}
+		PyGILState_Release(
+		 gil_state );
+
+		return( read_count );
+	}
+	while( buffer_offset < size )
+	{
+		data_offset = file_object_io_handle->current_offset
+		            - file_object_io_handle->read_ahead_buffer_offset;
+
+		if( ( data_offset >= 0 )
+		 && ( (size64_t) data_offset < (size64_t) file_object_io_handle->read_ahead_buffer_data_size ) )
+		{
+			read_size = file_object_io_handle->read_ahead_buffer_data_size - (size_t) data_offset;
+
+			if( read_size > ( size - buffer_offset ) )
+			{
+				read_size = size - buffer_offset;
+			}
+			if( memory_copy(
+			     &( buffer[ buffer_offset ] ),
+			     &( file_object_io_handle->read_ahead_buffer[ data_offset ] ),
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy read-ahead data to buffer.",
+				 function );
+
+				goto on_error;
+			}
+			read_count = (ssize_t) read_size;
+		}
+		else if( ( size - buffer_offset ) >= file_object_io_handle->read_ahead_size )
+		{
+			/* Large reads bypass the read-ahead buffer
+			 */
+			read_count = pyewf_file_object_io_handle_read_from_file_object(
+			              file_object_io_handle,
+			              &( buffer[ buffer_offset ] ),
+			              size - buffer_offset,
+			              error );
+
+			if( read_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read from file object.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		else
+		{
+			file_object_io_handle->read_ahead_buffer_offset    = file_object_io_handle->current_offset;
+			file_object_io_handle->read_ahead_buffer_data_size = 0;
+
+			read_count = pyewf_file_object_io_handle_read_from_file_object(
+			              file_object_io_handle,
+			              file_object_io_handle->read_ahead_buffer,
+			              file_object_io_handle->read_ahead_size,
+			              error );
+
+			if( read_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to fill read-ahead buffer from file object.",
+				 function );
+
+				goto on_error;
+			}
+			file_object_io_handle->read_ahead_buffer_data_size = (size_t) read_count;
+
+			/* Continue to copy the data from the read-ahead buffer
+			 */
+			if( read_count > 0 )
+			{
+				continue;
+			}
+		}
+		if( read_count == 0 )
+		{
+			break;
+		}
+		buffer_offset                         += (size_t) read_count;
+		file_object_io_handle->current_offset += (off64_t) read_count;
 	}
 	PyGILState_Release(
 	 gil_state );
 
-	return( read_count );
+	return( (ssize_t) buffer_offset );
 
 on_error:
 	PyGILState_Release(
@@ -824,6 +1290,26 @@ ssize_t pyewf_file_object_io_handle_write(
 	}
 	gil_state = PyGILState_Ensure();
 
+	if( ( file_object_io_handle->read_ahead_size > 0 )
+	 && ( file_object_io_handle->file_object_offset != file_object_io_handle->current_offset ) )
+	{
+		if( pyewf_file_object_seek_offset(
+		     file_object_io_handle->file_object,
+		     file_object_io_handle->current_offset,
+		     SEEK_SET,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek in file object.",
+			 function );
+
+			goto on_error;
+		}
+		file_object_io_handle->file_object_offset = file_object_io_handle->current_offset;
+	}
 	write_count = pyewf_file_object_write_buffer(
 	               file_object_io_handle->file_object,
 	               buffer,
@@ -841,6 +1327,12 @@ ssize_t pyewf_file_object_io_handle_write(
 
 		goto on_error;
 	}
+	if( file_object_io_handle->read_ahead_size > 0 )
+	{
+		file_object_io_handle->current_offset             += (off64_t) write_count;
+		file_object_io_handle->file_object_offset          = file_object_io_handle->current_offset;
+		file_object_io_handle->read_ahead_buffer_data_size = 0;
+	}
 	PyGILState_Release(
 	 gil_state );
 
@@ -1130,6 +1622,8 @@ on_error:
 }
 
 /* Seeks a certain offset within the file object IO handle
+ * If a read-ahead size is set, seeking relative to the start or the current offset
+ * does not call the file object, which is repositioned on the next read instead
  * Returns the offset if the seek is successful or -1 on error
  */
 off64_t pyewf_file_object_io_handle_seek_offset(
@@ -1152,6 +1646,41 @@ off64_t pyewf_file_object_io_handle_seek_offset(
 
 		return( -1 );
 	}
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_object_io_handle->read_ahead_size > 0 )
+	 && ( whence != SEEK_END ) )
+	{
+		if( whence == SEEK_CUR )
+		{
+			offset += file_object_io_handle->current_offset;
+		}
+		if( offset < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid offset value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		file_object_io_handle->current_offset = offset;
+
+		return( offset );
+	}
 	gil_state = PyGILState_Ensure();
 
 	if( pyewf_file_object_seek_offset(
@@ -1183,12 +1712,17 @@ off64_t pyewf_file_object_io_handle_seek_offset(
 
 		goto on_error;
 	}
+	file_object_io_handle->current_offset     = offset;
+	file_object_io_handle->file_object_offset = offset;
+
 	PyGILState_Release(
 	 gil_state );
 
 	return( offset );
 
 on_error:
+	file_object_io_handle->file_object_offset = -1;
+
 	PyGILState_Release(
 	 gil_state );
 
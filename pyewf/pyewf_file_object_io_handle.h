@@ -33,6 +33,14 @@
 extern "C" {
 #endif
 
+/* The default read-ahead size
+ */
+#define PYEWF_FILE_OBJECT_IO_HANDLE_DEFAULT_READ_AHEAD_SIZE	( 1024 * 1024 )
+
+/* The maximum read-ahead size
+ */
+#define PYEWF_FILE_OBJECT_IO_HANDLE_MAXIMUM_READ_AHEAD_SIZE	( 256 * 1024 * 1024 )
+
 typedef struct pyewf_file_object_io_handle pyewf_file_object_io_handle_t;
 
 struct pyewf_file_object_io_handle
@@ -44,16 +52,46 @@ struct pyewf_file_object_io_handle
 	/* The access flags
 	 */
 	int access_flags;
+
+	/* The read-ahead size, where 0 represents no read-ahead
+	 */
+	size_t read_ahead_size;
+
+	/* The read-ahead buffer
+	 */
+	uint8_t *read_ahead_buffer;
+
+	/* The offset of the data in the read-ahead buffer
+	 */
+	off64_t read_ahead_buffer_offset;
+
+	/* The size of the data in the read-ahead buffer
+	 */
+	size_t read_ahead_buffer_data_size;
+
+	/* The current offset, used when read-ahead is enabled
+	 */
+	off64_t current_offset;
+
+	/* The offset of the file object, where -1 represents not known
+	 */
+	off64_t file_object_offset;
+
+	/* Value to indicate the file object has a readinto method
+	 */
+	int has_readinto_method;
 };
 
 int pyewf_file_object_io_handle_initialize(
      pyewf_file_object_io_handle_t **file_object_io_handle,
      PyObject *file_object,
+     size_t read_ahead_size,
      libcerror_error_t **error );
 
 int pyewf_file_object_initialize(
      libbfio_handle_t **handle,
      PyObject *file_object,
+     size_t read_ahead_size,
      libcerror_error_t **error );
 
 int pyewf_file_object_io_handle_free(
@@ -80,6 +118,18 @@ ssize_t pyewf_file_object_read_buffer(
          size_t size,
          libcerror_error_t **error );
 
+ssize_t pyewf_file_object_readinto_buffer(
+         PyObject *file_object,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+ssize_t pyewf_file_object_io_handle_read_from_file_object(
+         pyewf_file_object_io_handle_t *file_object_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
 ssize_t pyewf_file_object_io_handle_read(
          pyewf_file_object_io_handle_t *file_object_io_handle,
          uint8_t *buffer,
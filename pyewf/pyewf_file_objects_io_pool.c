@@ -36,6 +36,7 @@ int pyewf_file_objects_pool_initialize(
      libbfio_pool_t **pool,
      PyObject *sequence_object,
      int access_flags,
+     size_t read_ahead_size,
      libcerror_error_t **error )
 {
 	libbfio_handle_t *file_io_handle = NULL;
@@ -121,6 +122,7 @@ int pyewf_file_objects_pool_initialize(
 		if( pyewf_file_object_initialize(
 		     &file_io_handle,
 		     file_object,
+		     read_ahead_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -37,6 +37,7 @@ int pyewf_file_objects_pool_initialize(
      libbfio_pool_t **pool,
      PyObject *sequence_object,
      int access_flags,
+     size_t read_ahead_size,
      libcerror_error_t **error );
 
 #if defined( __cplusplus )
@@ -30,8 +30,10 @@
 #include <stdlib.h>
 #endif
 
+#include "pyewf_data_chunks.h"
 #include "pyewf_error.h"
 #include "pyewf_file_entry.h"
+#include "pyewf_file_object_io_handle.h"
 #include "pyewf_file_objects_io_pool.h"
 #include "pyewf_handle.h"
 #include "pyewf_integer.h"
@@ -42,6 +44,17 @@
 #include "pyewf_python.h"
 #include "pyewf_unused.h"
 
+/* The names of the statistics types
+ */
+static const char *pyewf_handle_statistics_names[ PYEWF_HANDLE_NUMBER_OF_STATISTICS_TYPES ] = {
+	"read_buffer",
+	"chunk_read",
+	"chunks_cache_hit",
+	"chunk_group_read",
+	"chunk_groups_cache_hit",
+	"decompress",
+	"checksum" };
+
 #if !defined( LIBEWF_HAVE_BFIO )
 LIBEWF_EXTERN \
 int libewf_handle_open_file_io_pool(
@@ -73,9 +86,11 @@ PyMethodDef pyewf_handle_object_methods[] = {
 	{ "open_file_objects",
 	  (PyCFunction) pyewf_handle_open_file_objects,
 	  METH_VARARGS | METH_KEYWORDS,
-	  "open_file_objects(file_objects, mode='r') -> None\n"
+	  "open_file_objects(file_objects, mode='r', read_ahead_size=1048576) -> None\n"
 	  "\n"
-	  "Opens a handle using a list of file-like objects." },
+	  "Opens a handle using a list of file-like objects.\n"
+	  "Small reads are served from a read-ahead buffer of read_ahead_size bytes per\n"
+	  "file object, use 0 to pass every read directly to the file object." },
 
 	{ "close",
 	  (PyCFunction) pyewf_handle_close,
@@ -98,6 +113,32 @@ PyMethodDef pyewf_handle_object_methods[] = {
 	  "\n"
 	  "Reads a buffer of media data at a specific offset." },
 
+	{ "read_buffer_into",
+	  (PyCFunction) pyewf_handle_read_buffer_into,
+	  METH_VARARGS | METH_KEYWORDS,
+	  "read_buffer_into(buffer) -> Integer\n"
+	  "\n"
+	  "Reads media data into a writable buffer object, such as a bytearray or memoryview.\n"
+	  "Returns the number of bytes read." },
+
+	{ "read_buffer_at_offset_into",
+	  (PyCFunction) pyewf_handle_read_buffer_at_offset_into,
+	  METH_VARARGS | METH_KEYWORDS,
+	  "read_buffer_at_offset_into(buffer, offset) -> Integer\n"
+	  "\n"
+	  "Reads media data at a specific offset into a writable buffer object.\n"
+	  "Returns the number of bytes read." },
+
+	{ "read_chunks",
+	  (PyCFunction) pyewf_handle_read_chunks,
+	  METH_VARARGS | METH_KEYWORDS,
+	  "read_chunks(size=0, offset=0, buffer=None) -> Iterator\n"
+	  "\n"
+	  "Retrieves an iterator that reads the media data in chunks of size bytes from offset.\n"
+	  "A size of 0 represents the chunk size of the handle. Every chunk is returned as a\n"
+	  "memoryview. If buffer is set it is reused for every chunk, in which case a chunk\n"
+	  "is only valid until the next chunk is read." },
+
 	{ "write_buffer",
 	  (PyCFunction) pyewf_handle_write_buffer,
 	  METH_VARARGS | METH_KEYWORDS,
@@ -135,6 +176,13 @@ PyMethodDef pyewf_handle_object_methods[] = {
 	  "\n"
 	  "Reads a buffer of media data." },
 
+	{ "readinto",
+	  (PyCFunction) pyewf_handle_read_buffer_into,
+	  METH_VARARGS | METH_KEYWORDS,
+	  "readinto(buffer) -> Integer\n"
+	  "\n"
+	  "Reads media data into a writable buffer object." },
+
 	{ "write",
 	  (PyCFunction) pyewf_handle_write_buffer,
 	  METH_VARARGS | METH_KEYWORDS,
@@ -156,6 +204,43 @@ PyMethodDef pyewf_handle_object_methods[] = {
 	  "\n"
 	  "Retrieves the current offset within the media data." },
 
+	/* Functions to access the statistics */
+
+	{ "set_collect_statistics",
+	  (PyCFunction) pyewf_handle_set_collect_statistics,
+	  METH_VARARGS | METH_KEYWORDS,
+	  "set_collect_statistics(collect_statistics=True) -> None\n"
+	  "\n"
+	  "Sets if the handle should collect statistics about reading the media data.\n"
+	  "Disabling the collection of statistics discards the collected statistics." },
+
+	{ "get_statistics",
+	  (PyCFunction) pyewf_handle_get_statistics,
+	  METH_NOARGS,
+	  "get_statistics() -> Dictionary or None\n"
+	  "\n"
+	  "Retrieves the collected statistics as a dictionary that maps the name of a stage\n"
+	  "to a tuple of the number of events and the cumulative elapsed time in nanoseconds.\n"
+	  "Returns None if the handle does not collect statistics." },
+
+	{ "reset_statistics",
+	  (PyCFunction) pyewf_handle_reset_statistics,
+	  METH_NOARGS,
+	  "reset_statistics() -> None\n"
+	  "\n"
+	  "Resets the collected statistics." },
+
+	/* Functions to access the shared memory chunks cache */
+
+	{ "set_shared_memory_chunks_cache",
+	  (PyCFunction) pyewf_handle_set_shared_memory_chunks_cache,
+	  METH_VARARGS | METH_KEYWORDS,
+	  "set_shared_memory_chunks_cache(name, maximum_cache_size) -> None\n"
+	  "\n"
+	  "Sets the chunks cache in shared memory, which is shared with other processes\n"
+	  "that read the same image using the same name.\n"
+	  "A name of None stops using the shared memory chunks cache." },
+
 	/* Functions to access the metadata */
 
 	{ "get_media_size",
@@ -1122,8 +1207,9 @@ PyObject *pyewf_handle_open_file_objects(
 	PyObject *file_objects      = NULL;
 	libcerror_error_t *error    = NULL;
 	char *mode                  = NULL;
-	static char *keyword_list[] = { "file_object", "mode", NULL };
+	static char *keyword_list[] = { "file_object", "mode", "read_ahead_size", NULL };
 	static char *function       = "pyewf_handle_open_file_objects";
+	Py_ssize_t read_ahead_size  = PYEWF_FILE_OBJECT_IO_HANDLE_DEFAULT_READ_AHEAD_SIZE;
 	int result                  = 0;
 
 	if( pyewf_handle == NULL )
@@ -1138,10 +1224,11 @@ PyObject *pyewf_handle_open_file_objects(
 	if( PyArg_ParseTupleAndKeywords(
 	     arguments,
 	     keywords,
-	     "O|s",
+	     "O|sn",
 	     keyword_list,
 	     &file_objects,
-	     &mode ) == 0 )
+	     &mode,
+	     &read_ahead_size ) == 0 )
 	{
 		return( NULL );
 	}
@@ -1156,10 +1243,21 @@ PyObject *pyewf_handle_open_file_objects(
 
 		return( NULL );
 	}
+	if( ( read_ahead_size < 0 )
+	 || ( read_ahead_size > (Py_ssize_t) PYEWF_FILE_OBJECT_IO_HANDLE_MAXIMUM_READ_AHEAD_SIZE ) )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid read-ahead size value out of bounds.",
+		 function );
+
+		return( NULL );
+	}
 	if( pyewf_file_objects_pool_initialize(
 	     &( pyewf_handle->file_io_pool ),
 	     file_objects,
 	     LIBBFIO_OPEN_READ,
+	     (size_t) read_ahead_size,
 	     &error ) != 1 )
 	{
 		pyewf_error_raise(
@@ -1526,6 +1624,298 @@ PyObject *pyewf_handle_read_buffer_at_offset(
 	return( string_object );
 }
 
+/* Reads media data into a buffer object
+ * Returns a Python object holding the number of bytes read if successful or NULL on error
+ */
+PyObject *pyewf_handle_read_buffer_into(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments,
+           PyObject *keywords )
+{
+	Py_buffer buffer_view;
+
+	libcerror_error_t *error    = NULL;
+	PyObject *buffer_object     = NULL;
+	static char *function       = "pyewf_handle_read_buffer_into";
+	static char *keyword_list[] = { "buffer", NULL };
+	ssize_t read_count          = 0;
+
+	if( pyewf_handle == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid pyewf handle.",
+		 function );
+
+		return( NULL );
+	}
+	if( PyArg_ParseTupleAndKeywords(
+	     arguments,
+	     keywords,
+	     "O",
+	     keyword_list,
+	     &buffer_object ) == 0 )
+	{
+		return( NULL );
+	}
+	if( PyObject_GetBuffer(
+	     buffer_object,
+	     &buffer_view,
+	     PyBUF_WRITABLE ) != 0 )
+	{
+		return( NULL );
+	}
+	if( buffer_view.len > (Py_ssize_t) SSIZE_MAX )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid argument buffer size value exceeds maximum.",
+		 function );
+
+		PyBuffer_Release(
+		 &buffer_view );
+
+		return( NULL );
+	}
+	/* The buffer view keeps the buffer from being resized while the GIL is released
+	 */
+	Py_BEGIN_ALLOW_THREADS
+
+	read_count = libewf_handle_read_buffer(
+	              pyewf_handle->handle,
+	              (uint8_t *) buffer_view.buf,
+	              (size_t) buffer_view.len,
+	              &error );
+
+	Py_END_ALLOW_THREADS
+
+	PyBuffer_Release(
+	 &buffer_view );
+
+	if( read_count <= -1 )
+	{
+		pyewf_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to read data.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+	return( pyewf_integer_signed_new_from_64bit(
+	         (int64_t) read_count ) );
+}
+
+/* Reads media data at a specific offset into a buffer object
+ * Returns a Python object holding the number of bytes read if successful or NULL on error
+ */
+PyObject *pyewf_handle_read_buffer_at_offset_into(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments,
+           PyObject *keywords )
+{
+	Py_buffer buffer_view;
+
+	libcerror_error_t *error    = NULL;
+	PyObject *buffer_object     = NULL;
+	static char *function       = "pyewf_handle_read_buffer_at_offset_into";
+	static char *keyword_list[] = { "buffer", "offset", NULL };
+	off64_t read_offset         = 0;
+	ssize_t read_count          = 0;
+
+	if( pyewf_handle == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid pyewf handle.",
+		 function );
+
+		return( NULL );
+	}
+	if( PyArg_ParseTupleAndKeywords(
+	     arguments,
+	     keywords,
+	     "OL",
+	     keyword_list,
+	     &buffer_object,
+	     &read_offset ) == 0 )
+	{
+		return( NULL );
+	}
+	if( read_offset < 0 )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid argument read offset value less than zero.",
+		 function );
+
+		return( NULL );
+	}
+	if( PyObject_GetBuffer(
+	     buffer_object,
+	     &buffer_view,
+	     PyBUF_WRITABLE ) != 0 )
+	{
+		return( NULL );
+	}
+	if( buffer_view.len > (Py_ssize_t) SSIZE_MAX )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid argument buffer size value exceeds maximum.",
+		 function );
+
+		PyBuffer_Release(
+		 &buffer_view );
+
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	read_count = libewf_handle_read_buffer_at_offset(
+	              pyewf_handle->handle,
+	              (uint8_t *) buffer_view.buf,
+	              (size_t) buffer_view.len,
+	              read_offset,
+	              &error );
+
+	Py_END_ALLOW_THREADS
+
+	PyBuffer_Release(
+	 &buffer_view );
+
+	if( read_count <= -1 )
+	{
+		pyewf_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to read data.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+	return( pyewf_integer_signed_new_from_64bit(
+	         (int64_t) read_count ) );
+}
+
+/* Retrieves an iterator that reads the media data in chunks
+ * Returns a Python object holding the iterator if successful or NULL on error
+ */
+PyObject *pyewf_handle_read_chunks(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments,
+           PyObject *keywords )
+{
+	libcerror_error_t *error    = NULL;
+	PyObject *buffer_object     = NULL;
+	static char *function       = "pyewf_handle_read_chunks";
+	static char *keyword_list[] = { "size", "offset", "buffer", NULL };
+	size64_t media_size         = 0;
+	size32_t handle_chunk_size  = 0;
+	off64_t read_offset         = 0;
+	int read_size               = 0;
+	int result                  = 0;
+
+	if( pyewf_handle == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid pyewf handle.",
+		 function );
+
+		return( NULL );
+	}
+	if( PyArg_ParseTupleAndKeywords(
+	     arguments,
+	     keywords,
+	     "|iLO",
+	     keyword_list,
+	     &read_size,
+	     &read_offset,
+	     &buffer_object ) == 0 )
+	{
+		return( NULL );
+	}
+	if( read_size < 0 )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid argument read size value less than zero.",
+		 function );
+
+		return( NULL );
+	}
+	if( read_offset < 0 )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid argument read offset value less than zero.",
+		 function );
+
+		return( NULL );
+	}
+	if( buffer_object == Py_None )
+	{
+		buffer_object = NULL;
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libewf_handle_get_media_size(
+	          pyewf_handle->handle,
+	          &media_size,
+	          &error );
+
+	if( ( result == 1 )
+	 && ( read_size == 0 ) )
+	{
+		result = libewf_handle_get_chunk_size(
+		          pyewf_handle->handle,
+		          &handle_chunk_size,
+		          &error );
+	}
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pyewf_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to retrieve media size or chunk size.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+	if( read_size == 0 )
+	{
+		if( ( handle_chunk_size == 0 )
+		 || ( handle_chunk_size > (size32_t) INT_MAX ) )
+		{
+			PyErr_Format(
+			 PyExc_IOError,
+			 "%s: invalid chunk size value out of bounds.",
+			 function );
+
+			return( NULL );
+		}
+		read_size = (int) handle_chunk_size;
+	}
+	return( pyewf_data_chunks_new(
+	         pyewf_handle,
+	         (size_t) read_size,
+	         read_offset,
+	         media_size,
+	         buffer_object ) );
+}
+
 /* Writes a buffer of media data
  * Returns a Python object holding the data if successful or NULL on error
  */
@@ -1824,6 +2214,328 @@ PyObject *pyewf_handle_get_offset(
 	return( integer_object );
 }
 
+/* Sets if the handle should collect statistics
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyewf_handle_set_collect_statistics(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments,
+           PyObject *keywords )
+{
+	PyObject *boolean_object    = NULL;
+	libcerror_error_t *error    = NULL;
+	static char *function       = "pyewf_handle_set_collect_statistics";
+	static char *keyword_list[] = { "collect_statistics", NULL };
+	uint8_t collect_statistics  = 1;
+	int result                  = 0;
+
+	if( pyewf_handle == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid handle.",
+		 function );
+
+		return( NULL );
+	}
+	if( PyArg_ParseTupleAndKeywords(
+	     arguments,
+	     keywords,
+	     "|O",
+	     keyword_list,
+	     &boolean_object ) == 0 )
+	{
+		return( NULL );
+	}
+	if( boolean_object != NULL )
+	{
+		result = PyObject_IsTrue(
+		          boolean_object );
+
+		if( result == -1 )
+		{
+			PyErr_Format(
+			 PyExc_TypeError,
+			 "%s: invalid collect statistics value.",
+			 function );
+
+			return( NULL );
+		}
+		collect_statistics = (uint8_t) result;
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libewf_handle_set_collect_statistics(
+	          pyewf_handle->handle,
+	          collect_statistics,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pyewf_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to set collect statistics.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+	Py_IncRef(
+	 Py_None );
+
+	return( Py_None );
+}
+
+/* Retrieves the collected statistics
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyewf_handle_get_statistics(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments PYEWF_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error    = NULL;
+	PyObject *dictionary_object = NULL;
+	PyObject *tuple_object      = NULL;
+	static char *function       = "pyewf_handle_get_statistics";
+	uint64_t elapsed_time       = 0;
+	uint64_t number_of_events   = 0;
+	int result                  = 0;
+	int statistics_type         = 0;
+
+	PYEWF_UNREFERENCED_PARAMETER( arguments )
+
+	if( pyewf_handle == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid handle.",
+		 function );
+
+		return( NULL );
+	}
+	dictionary_object = PyDict_New();
+
+	if( dictionary_object == NULL )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to create dictionary.",
+		 function );
+
+		goto on_error;
+	}
+	for( statistics_type = 0;
+	     statistics_type < PYEWF_HANDLE_NUMBER_OF_STATISTICS_TYPES;
+	     statistics_type++ )
+	{
+		Py_BEGIN_ALLOW_THREADS
+
+		result = libewf_handle_get_statistics_value(
+		          pyewf_handle->handle,
+		          statistics_type,
+		          &number_of_events,
+		          &elapsed_time,
+		          &error );
+
+		Py_END_ALLOW_THREADS
+
+		if( result == -1 )
+		{
+			pyewf_error_raise(
+			 error,
+			 PyExc_IOError,
+			 "%s: unable to retrieve statistics value: %s.",
+			 function,
+			 pyewf_handle_statistics_names[ statistics_type ] );
+
+			libcerror_error_free(
+			 &error );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			Py_DecRef(
+			 dictionary_object );
+
+			Py_IncRef(
+			 Py_None );
+
+			return( Py_None );
+		}
+		tuple_object = Py_BuildValue(
+		                "(KK)",
+		                (unsigned PY_LONG_LONG) number_of_events,
+		                (unsigned PY_LONG_LONG) elapsed_time );
+
+		if( tuple_object == NULL )
+		{
+			PyErr_Format(
+			 PyExc_MemoryError,
+			 "%s: unable to create statistics value: %s tuple.",
+			 function,
+			 pyewf_handle_statistics_names[ statistics_type ] );
+
+			goto on_error;
+		}
+		if( PyDict_SetItemString(
+		     dictionary_object,
+		     pyewf_handle_statistics_names[ statistics_type ],
+		     tuple_object ) != 0 )
+		{
+			PyErr_Format(
+			 PyExc_MemoryError,
+			 "%s: unable to set statistics value: %s in dictionary.",
+			 function,
+			 pyewf_handle_statistics_names[ statistics_type ] );
+
+			goto on_error;
+		}
+		Py_DecRef(
+		 tuple_object );
+
+		tuple_object = NULL;
+	}
+	return( dictionary_object );
+
+on_error:
+	if( tuple_object != NULL )
+	{
+		Py_DecRef(
+		 tuple_object );
+	}
+	if( dictionary_object != NULL )
+	{
+		Py_DecRef(
+		 dictionary_object );
+	}
+	return( NULL );
+}
+
+/* Resets the collected statistics
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyewf_handle_reset_statistics(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments PYEWF_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "pyewf_handle_reset_statistics";
+	int result               = 0;
+
+	PYEWF_UNREFERENCED_PARAMETER( arguments )
+
+	if( pyewf_handle == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid handle.",
+		 function );
+
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libewf_handle_reset_statistics(
+	          pyewf_handle->handle,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pyewf_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to reset statistics.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+	Py_IncRef(
+	 Py_None );
+
+	return( Py_None );
+}
+
+/* Sets the chunks cache in shared memory
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyewf_handle_set_shared_memory_chunks_cache(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments,
+           PyObject *keywords )
+{
+	libcerror_error_t *error              = NULL;
+	static char *function                 = "pyewf_handle_set_shared_memory_chunks_cache";
+	static char *keyword_list[]           = { "name", "maximum_cache_size", NULL };
+	const char *name                      = NULL;
+	unsigned long long maximum_cache_size = 0;
+	size_t name_length                    = 0;
+	int result                            = 0;
+
+	if( pyewf_handle == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid handle.",
+		 function );
+
+		return( NULL );
+	}
+	if( PyArg_ParseTupleAndKeywords(
+	     arguments,
+	     keywords,
+	     "zK",
+	     keyword_list,
+	     &name,
+	     &maximum_cache_size ) == 0 )
+	{
+		return( NULL );
+	}
+	if( name != NULL )
+	{
+		name_length = narrow_string_length(
+		               name );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libewf_handle_set_shared_memory_chunks_cache(
+	          pyewf_handle->handle,
+	          name,
+	          name_length,
+	          (size64_t) maximum_cache_size,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pyewf_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to set shared memory chunks cache.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+	Py_IncRef(
+	 Py_None );
+
+	return( Py_None );
+}
+
 /* Retrieves the root file entry
  * Returns a Python object if successful or NULL on error
  */
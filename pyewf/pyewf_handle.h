@@ -35,6 +35,10 @@
 extern "C" {
 #endif
 
+/* The number of statistics types
+ */
+#define PYEWF_HANDLE_NUMBER_OF_STATISTICS_TYPES		7
+
 typedef struct pyewf_handle pyewf_handle_t;
 
 struct pyewf_handle
@@ -102,6 +106,21 @@ PyObject *pyewf_handle_read_buffer_at_offset(
            PyObject *arguments,
            PyObject *keywords );
 
+PyObject *pyewf_handle_read_buffer_into(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments,
+           PyObject *keywords );
+
+PyObject *pyewf_handle_read_buffer_at_offset_into(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments,
+           PyObject *keywords );
+
+PyObject *pyewf_handle_read_chunks(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments,
+           PyObject *keywords );
+
 PyObject *pyewf_handle_write_buffer(
            pyewf_handle_t *pyewf_handle,
            PyObject *arguments,
@@ -121,6 +140,24 @@ PyObject *pyewf_handle_get_offset(
            pyewf_handle_t *pyewf_handle,
            PyObject *arguments );
 
+PyObject *pyewf_handle_set_collect_statistics(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments,
+           PyObject *keywords );
+
+PyObject *pyewf_handle_get_statistics(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments );
+
+PyObject *pyewf_handle_reset_statistics(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments );
+
+PyObject *pyewf_handle_set_shared_memory_chunks_cache(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments,
+           PyObject *keywords );
+
 PyObject *pyewf_handle_get_root_file_entry(
            pyewf_handle_t *pyewf_handle,
            PyObject *arguments );
@@ -0,0 +1,74 @@
+#!/bin/bash
+# Verify tool scaling benchmark script
+#
+# Runs ewfverify on the test input with an increasing number of jobs (threads)
+# and prints the elapsed time per number of jobs. This script is not part of
+# the regular tests since its outcome depends on the system it runs on.
+#
+# Version: 20171007
+
+EXIT_SUCCESS=0;
+EXIT_FAILURE=1;
+EXIT_IGNORE=77;
+
+NUMBERS_OF_JOBS="0 1 2 4 8 16 32 64 128";
+OPTIONS="-q";
+
+INPUT_GLOB="*.[Ees]*01";
+
+TEST_EXECUTABLE="../ewftools/ewfverify";
+
+if ! test -x "${TEST_EXECUTABLE}";
+then
+	TEST_EXECUTABLE="../ewftools/ewfverify.exe";
+fi
+
+if ! test -x "${TEST_EXECUTABLE}";
+then
+	echo "Missing test executable: ${TEST_EXECUTABLE}";
+
+	exit ${EXIT_FAILURE};
+fi
+
+if ! test -z "$1";
+then
+	NUMBERS_OF_JOBS=$1;
+fi
+
+if ! test -d "input";
+then
+	echo "No input directory found.";
+
+	exit ${EXIT_IGNORE};
+fi
+
+RESULT=${EXIT_IGNORE};
+
+for INPUT_FILE in `ls -1 input/${INPUT_GLOB} 2> /dev/null`;
+do
+	echo "Benchmarking: ${INPUT_FILE}";
+
+	for NUMBER_OF_JOBS in ${NUMBERS_OF_JOBS};
+	do
+		START_TIME=`date +%s%N`;
+
+		${TEST_EXECUTABLE} ${OPTIONS} -j ${NUMBER_OF_JOBS} "${INPUT_FILE}" > /dev/null 2>&1;
+		RESULT=$?;
+
+		END_TIME=`date +%s%N`;
+
+		if test ${RESULT} -ne ${EXIT_SUCCESS};
+		then
+			echo "Unable to verify: ${INPUT_FILE} with: ${NUMBER_OF_JOBS} jobs";
+
+			exit ${EXIT_FAILURE};
+		fi
+		ELAPSED_TIME=$(( ( ${END_TIME} - ${START_TIME} ) / 1000000 ));
+
+		echo "jobs: ${NUMBER_OF_JOBS}	elapsed: ${ELAPSED_TIME} ms";
+	done
+	echo "";
+done
+
+exit ${RESULT};
+
@@ -0,0 +1,96 @@
+#!/bin/bash
+# Logical evidence file (single files) benchmark script
+#
+# Runs ewfinfo on the logical test input, once printing only the image
+# information, which opens the file but reads the single file entries on
+# demand, and once printing all the file entries, and prints the elapsed time
+# and peak memory usage of both. This script is not part of the regular tests
+# since its outcome depends on the system it runs on.
+#
+# Version: 20171014
+
+EXIT_SUCCESS=0;
+EXIT_FAILURE=1;
+EXIT_IGNORE=77;
+
+INFO_OPTIONS="-i -e";
+
+INPUT_GLOB="*.[Ll]*01";
+
+TEST_EXECUTABLE="../ewftools/ewfinfo";
+
+if ! test -x "${TEST_EXECUTABLE}";
+then
+	TEST_EXECUTABLE="../ewftools/ewfinfo.exe";
+fi
+
+if ! test -x "${TEST_EXECUTABLE}";
+then
+	echo "Missing test executable: ${TEST_EXECUTABLE}";
+
+	exit ${EXIT_FAILURE};
+fi
+
+TIME_EXECUTABLE="/usr/bin/time";
+
+if ! test -x "${TIME_EXECUTABLE}";
+then
+	TIME_EXECUTABLE="";
+fi
+
+if ! test -d "input";
+then
+	echo "No input directory found.";
+
+	exit ${EXIT_IGNORE};
+fi
+
+TIME_FILE="tmp_benchmark_single_files.$$";
+
+RESULT=${EXIT_IGNORE};
+
+for INPUT_FILE in `ls -1 input/${INPUT_GLOB} 2> /dev/null`;
+do
+	echo "Benchmarking: ${INPUT_FILE}";
+
+	for INFO_OPTION in ${INFO_OPTIONS};
+	do
+		TIME_OUTPUT="";
+
+		START_TIME=`date +%s%N`;
+
+		if test -n "${TIME_EXECUTABLE}";
+		then
+			${TIME_EXECUTABLE} -f "%M" -o "${TIME_FILE}" ${TEST_EXECUTABLE} ${INFO_OPTION} "${INPUT_FILE}" > /dev/null 2>&1;
+			RESULT=$?;
+
+			TIME_OUTPUT=`tail -n 1 "${TIME_FILE}" 2> /dev/null`;
+		else
+			${TEST_EXECUTABLE} ${INFO_OPTION} "${INPUT_FILE}" > /dev/null 2>&1;
+			RESULT=$?;
+		fi
+
+		END_TIME=`date +%s%N`;
+
+		rm -f "${TIME_FILE}";
+
+		if test ${RESULT} -ne ${EXIT_SUCCESS};
+		then
+			echo "Unable to run: ${TEST_EXECUTABLE} ${INFO_OPTION} ${INPUT_FILE}";
+
+			exit ${EXIT_FAILURE};
+		fi
+		ELAPSED_TIME=$(( ( ${END_TIME} - ${START_TIME} ) / 1000000 ));
+
+		if test -n "${TIME_OUTPUT}";
+		then
+			echo "option: ${INFO_OPTION}	elapsed: ${ELAPSED_TIME} ms	peak memory: ${TIME_OUTPUT} KiB";
+		else
+			echo "option: ${INFO_OPTION}	elapsed: ${ELAPSED_TIME} ms";
+		fi
+	done
+	echo "";
+done
+
+exit ${RESULT};
+
@@ -122,6 +122,8 @@ int main(
 
 	/* TODO: add tests for libewf_chunk_data_read_from_file_io_pool */
 
+	/* TODO: add tests for libewf_chunk_data_read_buffer_from_file_io_pool */
+
 	/* TODO: add tests for libewf_chunk_data_read_element_data */
 
 #endif /* defined( __GNUC__ ) */
@@ -112,6 +112,8 @@ int main(
 
 	/* TODO: add tests for libewf_chunk_table_chunk_exists_for_offset */
 
+	/* TODO: add tests for libewf_chunk_table_get_chunk_data_range_by_offset */
+
 	/* TODO: add tests for libewf_chunk_table_get_chunk_data_by_offset */
 
 	/* TODO: add tests for libewf_chunk_table_set_chunk_data_by_offset */
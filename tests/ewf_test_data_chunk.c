@@ -73,6 +73,45 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_data_chunk_set_compression_level function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_data_chunk_set_compression_level(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_data_chunk_set_compression_level(
+	          NULL,
+	          LIBEWF_COMPRESSION_FAST,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 #if defined( __GNUC__ )
 
 #endif /* defined( __GNUC__ ) */
@@ -102,6 +141,10 @@ int main(
 	 "libewf_data_chunk_free",
 	 ewf_test_data_chunk_free );
 
+	EWF_TEST_RUN(
+	 "libewf_data_chunk_set_compression_level",
+	 ewf_test_data_chunk_set_compression_level );
+
 #if defined( __GNUC__ )
 
 	/* TODO: add tests for libewf_data_chunk_read_buffer */
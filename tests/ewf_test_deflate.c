@@ -0,0 +1,729 @@
+/*
+ * Library deflate functions test program
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_deflate.h"
+
+#if defined( __GNUC__ )
+
+/* Fills the buffer with test data
+ * The first half of the buffer contains repetitive text and the second half pseudo random data
+ */
+void ewf_test_deflate_fill_buffer(
+     uint8_t *buffer,
+     size_t buffer_size )
+{
+	const char *text      = "The quick brown fox jumps over the lazy dog. ";
+	size_t buffer_offset  = 0;
+	size_t text_offset    = 0;
+	uint32_t random_value = 1;
+
+	for( buffer_offset = 0;
+	     buffer_offset < ( buffer_size / 2 );
+	     buffer_offset++ )
+	{
+		buffer[ buffer_offset ] = (uint8_t) text[ text_offset++ ];
+
+		if( text[ text_offset ] == 0 )
+		{
+			text_offset = 0;
+		}
+	}
+	while( buffer_offset < buffer_size )
+	{
+		random_value = ( random_value * 1103515245UL ) + 12345;
+
+		buffer[ buffer_offset++ ] = (uint8_t) ( random_value >> 16 );
+	}
+}
+
+/* Tests the libewf_deflate_encoder_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_deflate_encoder_initialize(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libewf_deflate_encoder_t *encoder = NULL;
+	int result                        = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests   = 1;
+	int number_of_memset_fail_tests   = 1;
+	int test_number                   = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libewf_deflate_encoder_initialize(
+	          &encoder,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "encoder",
+	 encoder );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_deflate_encoder_free(
+	          &encoder,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "encoder",
+	 encoder );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_deflate_encoder_initialize(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	encoder = (libewf_deflate_encoder_t *) 0x12345678UL;
+
+	result = libewf_deflate_encoder_initialize(
+	          &encoder,
+	          &error );
+
+	encoder = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_deflate_encoder_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_deflate_encoder_initialize(
+		          &encoder,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( encoder != NULL )
+			{
+				libewf_deflate_encoder_free(
+				 &encoder,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "encoder",
+			 encoder );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_deflate_encoder_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_deflate_encoder_initialize(
+		          &encoder,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( encoder != NULL )
+			{
+				libewf_deflate_encoder_free(
+				 &encoder,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "encoder",
+			 encoder );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( encoder != NULL )
+	{
+		libewf_deflate_encoder_free(
+		 &encoder,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_deflate_encoder_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_deflate_encoder_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_deflate_encoder_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_deflate_compress function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_deflate_compress(
+     void )
+{
+	int8_t compression_levels[ 4 ] = {
+		LIBEWF_COMPRESSION_NONE,
+		LIBEWF_COMPRESSION_FAST,
+		LIBEWF_COMPRESSION_DEFAULT,
+		LIBEWF_COMPRESSION_BEST };
+
+	size_t uncompressed_data_sizes[ 4 ] = {
+		0, 1, 32768, 65536 + 7 };
+
+	libcerror_error_t *error          = NULL;
+	libewf_deflate_encoder_t *encoder = NULL;
+	uint8_t *compressed_data          = NULL;
+	uint8_t *data                     = NULL;
+	uint8_t *uncompressed_data        = NULL;
+	size_t compressed_data_size       = 0;
+	size_t data_size                  = 65536 + 7;
+	size_t maximum_compressed_size    = 0;
+	size_t uncompressed_data_size     = 0;
+	int level_index                   = 0;
+	int result                        = 0;
+	int size_index                    = 0;
+
+	/* Initialize test
+	 */
+	maximum_compressed_size = libewf_deflate_get_compressed_data_bound(
+	                           data_size );
+
+	EWF_TEST_ASSERT_LESS_THAN_UINT64(
+	 "data_size",
+	 (uint64_t) data_size,
+	 (uint64_t) maximum_compressed_size );
+
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * data_size );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "data",
+	 data );
+
+	compressed_data = (uint8_t *) memory_allocate(
+	                               sizeof( uint8_t ) * maximum_compressed_size );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "compressed_data",
+	 compressed_data );
+
+	uncompressed_data = (uint8_t *) memory_allocate(
+	                                 sizeof( uint8_t ) * data_size );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "uncompressed_data",
+	 uncompressed_data );
+
+	ewf_test_deflate_fill_buffer(
+	 data,
+	 data_size );
+
+	result = libewf_deflate_encoder_initialize(
+	          &encoder,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "encoder",
+	 encoder );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 * the encoder is reused for every compression level and data size
+	 */
+	for( level_index = 0;
+	     level_index < 4;
+	     level_index++ )
+	{
+		for( size_index = 0;
+		     size_index < 4;
+		     size_index++ )
+		{
+			compressed_data_size = maximum_compressed_size;
+
+			result = libewf_deflate_compress(
+			          data,
+			          uncompressed_data_sizes[ size_index ],
+			          compressed_data,
+			          &compressed_data_size,
+			          compression_levels[ level_index ],
+			          encoder,
+			          &error );
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			uncompressed_data_size = data_size;
+
+			result = libewf_deflate_decompress(
+			          compressed_data,
+			          compressed_data_size,
+			          uncompressed_data,
+			          &uncompressed_data_size,
+			          &error );
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			EWF_TEST_ASSERT_EQUAL_SIZE(
+			 "uncompressed_data_size",
+			 uncompressed_data_size,
+			 uncompressed_data_sizes[ size_index ] );
+
+			result = memory_compare(
+			          data,
+			          uncompressed_data,
+			          uncompressed_data_size );
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 0 );
+		}
+	}
+	/* Test compression without an encoder
+	 */
+	compressed_data_size = maximum_compressed_size;
+
+	result = libewf_deflate_compress(
+	          data,
+	          data_size,
+	          compressed_data,
+	          &compressed_data_size,
+	          LIBEWF_COMPRESSION_FAST,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_LESS_THAN_UINT64(
+	 "compressed_data_size",
+	 (uint64_t) compressed_data_size,
+	 (uint64_t) data_size );
+
+	uncompressed_data_size = data_size;
+
+	result = libewf_deflate_decompress(
+	          compressed_data,
+	          compressed_data_size,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "uncompressed_data_size",
+	 uncompressed_data_size,
+	 data_size );
+
+	result = memory_compare(
+	          data,
+	          uncompressed_data,
+	          data_size );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test compression with a compressed data buffer that is too small
+	 */
+	compressed_data_size = 16;
+
+	result = libewf_deflate_compress(
+	          data,
+	          data_size,
+	          compressed_data,
+	          &compressed_data_size,
+	          LIBEWF_COMPRESSION_FAST,
+	          encoder,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "compressed_data_size",
+	 compressed_data_size,
+	 maximum_compressed_size );
+
+	/* Test error cases
+	 */
+	compressed_data_size = maximum_compressed_size;
+
+	result = libewf_deflate_compress(
+	          NULL,
+	          data_size,
+	          compressed_data,
+	          &compressed_data_size,
+	          LIBEWF_COMPRESSION_FAST,
+	          encoder,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_deflate_compress(
+	          data,
+	          (size_t) SSIZE_MAX + 1,
+	          compressed_data,
+	          &compressed_data_size,
+	          LIBEWF_COMPRESSION_FAST,
+	          encoder,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_deflate_compress(
+	          data,
+	          data_size,
+	          NULL,
+	          &compressed_data_size,
+	          LIBEWF_COMPRESSION_FAST,
+	          encoder,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_deflate_compress(
+	          data,
+	          data_size,
+	          compressed_data,
+	          NULL,
+	          LIBEWF_COMPRESSION_FAST,
+	          encoder,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_deflate_encoder_free(
+	          &encoder,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "encoder",
+	 encoder );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 uncompressed_data );
+
+	uncompressed_data = NULL;
+
+	memory_free(
+	 compressed_data );
+
+	compressed_data = NULL;
+
+	memory_free(
+	 data );
+
+	data = NULL;
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( encoder != NULL )
+	{
+		libewf_deflate_encoder_free(
+		 &encoder,
+		 NULL );
+	}
+	if( uncompressed_data != NULL )
+	{
+		memory_free(
+		 uncompressed_data );
+	}
+	if( compressed_data != NULL )
+	{
+		memory_free(
+		 compressed_data );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ )
+
+	EWF_TEST_RUN(
+	 "libewf_deflate_encoder_initialize",
+	 ewf_test_deflate_encoder_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_deflate_encoder_free",
+	 ewf_test_deflate_encoder_free );
+
+	EWF_TEST_RUN(
+	 "libewf_deflate_compress",
+	 ewf_test_deflate_compress );
+
+#endif /* defined( __GNUC__ ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
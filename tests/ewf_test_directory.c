@@ -0,0 +1,453 @@
+/*
+ * Library directory functions test program
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_directory.h"
+
+#if defined( __GNUC__ )
+
+/* Tests the libewf_directory_append_extension and libewf_directory_has_extension functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_directory_has_extension(
+     void )
+{
+	libcerror_error_t *error           = NULL;
+	char *extensions                   = NULL;
+	int number_of_allocated_extensions = 0;
+	int number_of_extensions           = 0;
+	int result                         = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_directory_append_extension(
+	          &extensions,
+	          &number_of_extensions,
+	          &number_of_allocated_extensions,
+	          "E02",
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "extensions",
+	 extensions );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_directory_append_extension(
+	          &extensions,
+	          &number_of_extensions,
+	          &number_of_allocated_extensions,
+	          "E01",
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_extensions",
+	 number_of_extensions,
+	 2 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	qsort(
+	 extensions,
+	 (size_t) number_of_extensions,
+	 sizeof( char ) * LIBEWF_DIRECTORY_EXTENSION_SIZE,
+	 &libewf_directory_compare_extensions );
+
+	/* Test regular cases
+	 */
+	result = libewf_directory_has_extension(
+	          extensions,
+	          number_of_extensions,
+	          "E01",
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_directory_has_extension(
+	          extensions,
+	          number_of_extensions,
+	          "E03",
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* An extension only matches an extension of the same length
+	 */
+	result = libewf_directory_has_extension(
+	          extensions,
+	          number_of_extensions,
+	          "E0",
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_directory_has_extension(
+	          NULL,
+	          number_of_extensions,
+	          "E01",
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_directory_has_extension(
+	          extensions,
+	          -1,
+	          "E01",
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_directory_has_extension(
+	          extensions,
+	          number_of_extensions,
+	          NULL,
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_directory_has_extension(
+	          extensions,
+	          number_of_extensions,
+	          "E01",
+	          LIBEWF_DIRECTORY_EXTENSION_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	memory_free(
+	 extensions );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( extensions != NULL )
+	{
+		memory_free(
+		 extensions );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_directory_get_extensions function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_directory_get_extensions(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	char *extensions         = NULL;
+	int number_of_extensions = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_directory_get_extensions(
+	          "",
+	          0,
+	          "ewf_test_directory_nonexisting.",
+	          31,
+	          3,
+	          &extensions,
+	          &number_of_extensions,
+	          &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_extensions",
+	 number_of_extensions,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_directory_get_extensions(
+	          NULL,
+	          0,
+	          "prefix.",
+	          7,
+	          3,
+	          &extensions,
+	          &number_of_extensions,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_directory_get_extensions(
+	          "",
+	          0,
+	          NULL,
+	          7,
+	          3,
+	          &extensions,
+	          &number_of_extensions,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_directory_get_extensions(
+	          "",
+	          0,
+	          "prefix.",
+	          7,
+	          0,
+	          &extensions,
+	          &number_of_extensions,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_directory_get_extensions(
+	          "",
+	          0,
+	          "prefix.",
+	          7,
+	          3,
+	          NULL,
+	          &number_of_extensions,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_directory_get_extensions(
+	          "",
+	          0,
+	          "prefix.",
+	          7,
+	          3,
+	          &extensions,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( extensions != NULL )
+	{
+		memory_free(
+		 extensions );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ )
+
+	EWF_TEST_RUN(
+	 "libewf_directory_has_extension",
+	 ewf_test_directory_has_extension );
+
+	EWF_TEST_RUN(
+	 "libewf_directory_get_extensions",
+	 ewf_test_directory_get_extensions );
+
+#endif /* defined( __GNUC__ ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
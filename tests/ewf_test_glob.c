@@ -41,13 +41,17 @@ int main( int argc, char * const argv[] )
 #endif
 {
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	wchar_t **filenames     = NULL;
+	wchar_t **directory_filenames     = NULL;
+	wchar_t **filenames               = NULL;
 #else
-	char **filenames        = NULL;
+	char **directory_filenames        = NULL;
+	char **filenames                  = NULL;
 #endif
-	libewf_error_t *error   = NULL;
-	int number_of_filenames = 0;
-	int filename_iterator   = 0;
+	libewf_error_t *error             = NULL;
+	size_t filename_length            = 0;
+	int number_of_directory_filenames = 0;
+	int number_of_filenames           = 0;
+	int filename_iterator             = 0;
 
 	if( argc < 2 )
 	{
@@ -99,6 +103,95 @@ int main( int argc, char * const argv[] )
 
 		return( EXIT_FAILURE );
 	}
+	/* The directory scan based glob must result in the same filenames
+	 */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_glob_directory_wide(
+	     argv[ 1 ],
+	     wide_string_length(
+	      argv[ 1 ] ),
+	     LIBEWF_FORMAT_UNKNOWN,
+	     &directory_filenames,
+	     &number_of_directory_filenames,
+	     &error ) != 1 )
+#else
+	if( libewf_glob_directory(
+	     argv[ 1 ],
+	     narrow_string_length(
+	      argv[ 1 ] ),
+	     LIBEWF_FORMAT_UNKNOWN,
+	     &directory_filenames,
+	     &number_of_directory_filenames,
+	     &error ) != 1 )
+#endif
+	{
+		fprintf(
+		 stderr,
+		 "Unable to glob filenames by directory.\n" );
+
+		goto on_error;
+	}
+	if( number_of_directory_filenames != number_of_filenames )
+	{
+		fprintf(
+		 stderr,
+		 "Mismatch in number of filenames globbed by directory.\n" );
+
+		goto on_error;
+	}
+	for( filename_iterator = 0;
+	     filename_iterator < number_of_filenames;
+	     filename_iterator++ )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		filename_length = wide_string_length(
+		                   filenames[ filename_iterator ] );
+
+		if( ( wide_string_length(
+		       directory_filenames[ filename_iterator ] ) != filename_length )
+		 || ( wide_string_compare(
+		       directory_filenames[ filename_iterator ],
+		       filenames[ filename_iterator ],
+		       filename_length ) != 0 ) )
+#else
+		filename_length = narrow_string_length(
+		                   filenames[ filename_iterator ] );
+
+		if( ( narrow_string_length(
+		       directory_filenames[ filename_iterator ] ) != filename_length )
+		 || ( narrow_string_compare(
+		       directory_filenames[ filename_iterator ],
+		       filenames[ filename_iterator ],
+		       filename_length ) != 0 ) )
+#endif
+		{
+			fprintf(
+			 stderr,
+			 "Mismatch in filename globbed by directory.\n" );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_glob_wide_free(
+	     directory_filenames,
+	     number_of_directory_filenames,
+	     &error ) != 1 )
+#else
+	if( libewf_glob_free(
+	     directory_filenames,
+	     number_of_directory_filenames,
+	     &error ) != 1 )
+#endif
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free directory glob.\n" );
+
+		goto on_error;
+	}
+	directory_filenames = NULL;
+
 	for( filename_iterator = 0;
 	     filename_iterator < number_of_filenames;
 	     filename_iterator++ )
@@ -156,6 +249,34 @@ on_error:
 		libewf_error_free(
 		 &error );
 	}
+	if( directory_filenames != NULL )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		libewf_glob_wide_free(
+		 directory_filenames,
+		 number_of_directory_filenames,
+		 NULL );
+#else
+		libewf_glob_free(
+		 directory_filenames,
+		 number_of_directory_filenames,
+		 NULL );
+#endif
+	}
+	if( filenames != NULL )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		libewf_glob_wide_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#else
+		libewf_glob_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#endif
+	}
 	return( EXIT_FAILURE );
 }
 
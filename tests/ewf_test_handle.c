@@ -21,6 +21,7 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <narrow_string.h>
 #include <system_string.h>
 #include <types.h>
@@ -38,6 +39,7 @@
 #include "ewf_test_libuna.h"
 #include "ewf_test_macros.h"
 #include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
 
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER ) && SIZEOF_WCHAR_T != 2 && SIZEOF_WCHAR_T != 4
 #error Unsupported size of wchar_t
@@ -1655,6 +1657,488 @@ on_error:
 	return( 0 );
 }
 
+/* Stores the read count of a completed asynchronous read
+ */
+void ewf_test_handle_read_callback(
+      libewf_handle_t *handle EWF_TEST_ATTRIBUTE_UNUSED,
+      void *buffer EWF_TEST_ATTRIBUTE_UNUSED,
+      ssize_t read_count,
+      void *callback_data )
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( handle )
+	EWF_TEST_UNREFERENCED_PARAMETER( buffer )
+
+	*( (ssize_t *) callback_data ) = read_count;
+}
+
+/* Tests the libewf_handle_read_buffers_at_offsets function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_read_buffers_at_offsets(
+     libewf_handle_t *handle )
+{
+	uint8_t batch_buffers[ 6 ][ 4096 ];
+	uint8_t buffer[ 4096 ];
+	void *buffers[ 6 ];
+	size_t buffer_sizes[ 6 ];
+	ssize_t read_counts[ 6 ];
+	off64_t offsets[ 6 ];
+
+	libcerror_error_t *error = NULL;
+	size64_t size            = 0;
+	ssize_t read_count       = 0;
+	off64_t offset           = 0;
+	int request_index        = 0;
+	int result               = 0;
+
+	/* Determine size
+	 */
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_END,
+	          &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	size = (size64_t) offset;
+
+	for( request_index = 0;
+	     request_index < 6;
+	     request_index++ )
+	{
+		buffers[ request_index ] = batch_buffers[ request_index ];
+	}
+	/* Test regular cases
+	 */
+	if( size > 8192 )
+	{
+		/* Requests that are not in order of offset, unaligned, overlapping,
+		 * of zero bytes, on the size boundary and beyond the size
+		 */
+		offsets[ 0 ]      = (off64_t) ( size / 2 ) + 3;
+		buffer_sizes[ 0 ] = 4096;
+		offsets[ 1 ]      = 0;
+		buffer_sizes[ 1 ] = 4096;
+		offsets[ 2 ]      = 100;
+		buffer_sizes[ 2 ] = 4000;
+		offsets[ 3 ]      = 512;
+		buffer_sizes[ 3 ] = 0;
+		offsets[ 4 ]      = (off64_t) ( size - 1000 );
+		buffer_sizes[ 4 ] = 4096;
+		offsets[ 5 ]      = (off64_t) size + 10;
+		buffer_sizes[ 5 ] = 4096;
+
+		result = libewf_handle_read_buffers_at_offsets(
+		          handle,
+		          buffers,
+		          buffer_sizes,
+		          offsets,
+		          read_counts,
+		          6,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* The scatter/gather reads must match the single reads
+		 */
+		for( request_index = 0;
+		     request_index < 6;
+		     request_index++ )
+		{
+			read_count = libewf_handle_read_buffer_at_offset(
+			              handle,
+			              buffer,
+			              buffer_sizes[ request_index ],
+			              offsets[ request_index ],
+			              &error );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			EWF_TEST_ASSERT_EQUAL_SSIZE(
+			 "read_counts[ request_index ]",
+			 read_counts[ request_index ],
+			 read_count );
+
+			result = memory_compare(
+			          batch_buffers[ request_index ],
+			          buffer,
+			          (size_t) read_count );
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 0 );
+		}
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_counts[ 3 ]",
+		 read_counts[ 3 ],
+		 (ssize_t) 0 );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_counts[ 4 ]",
+		 read_counts[ 4 ],
+		 (ssize_t) 1000 );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_counts[ 5 ]",
+		 read_counts[ 5 ],
+		 (ssize_t) 0 );
+	}
+	/* Test error cases
+	 */
+	offsets[ 0 ]      = 0;
+	buffer_sizes[ 0 ] = 16;
+
+	result = libewf_handle_read_buffers_at_offsets(
+	          NULL,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_read_buffers_at_offsets(
+	          handle,
+	          NULL,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_read_buffers_at_offsets(
+	          handle,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          NULL,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_read_buffers_at_offsets(
+	          handle,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          read_counts,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_read_buffer_at_offset_async function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_read_buffer_at_offset_async(
+     libewf_handle_t *handle )
+{
+	uint8_t async_buffers[ 5 ][ 64 ];
+	uint8_t buffer[ 64 ];
+	ssize_t async_read_counts[ 5 ];
+	off64_t offsets[ 5 ];
+
+	ssize_t expected_read_counts[ 5 ] = { 64, 64, 64, 32, 0 };
+	libcerror_error_t *error          = NULL;
+	size64_t size                     = 0;
+	ssize_t read_count                = 0;
+	off64_t offset                    = 0;
+	int read_index                    = 0;
+	int result                        = 0;
+
+	/* Determine size
+	 */
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_END,
+	          &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	size = (size64_t) offset;
+
+	/* Test regular cases
+	 */
+	if( size > 64 )
+	{
+		/* Concurrent reads of the same chunk, a read in the middle,
+		 * a read on the size boundary and a read beyond the size
+		 */
+		offsets[ 0 ] = 0;
+		offsets[ 1 ] = 0;
+		offsets[ 2 ] = (off64_t) ( size / 2 );
+		offsets[ 3 ] = (off64_t) ( size - 32 );
+		offsets[ 4 ] = (off64_t) size;
+
+		for( read_index = 0;
+		     read_index < 5;
+		     read_index++ )
+		{
+			async_read_counts[ read_index ] = -2;
+
+			result = libewf_handle_read_buffer_at_offset_async(
+			          handle,
+			          async_buffers[ read_index ],
+			          64,
+			          offsets[ read_index ],
+			          &ewf_test_handle_read_callback,
+			          (void *) &( async_read_counts[ read_index ] ),
+			          &error );
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+		result = libewf_handle_wait_for_async_reads(
+		          handle,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* The asynchronous reads must match the synchronous reads
+		 */
+		for( read_index = 0;
+		     read_index < 5;
+		     read_index++ )
+		{
+			read_count = libewf_handle_read_buffer_at_offset(
+			              handle,
+			              buffer,
+			              64,
+			              offsets[ read_index ],
+			              &error );
+
+			EWF_TEST_ASSERT_EQUAL_SSIZE(
+			 "read_count",
+			 read_count,
+			 expected_read_counts[ read_index ] );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			EWF_TEST_ASSERT_EQUAL_SSIZE(
+			 "async_read_count",
+			 async_read_counts[ read_index ],
+			 read_count );
+
+			result = memory_compare(
+			          async_buffers[ read_index ],
+			          buffer,
+			          (size_t) read_count );
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 0 );
+		}
+	}
+	/* Test error cases
+	 */
+	result = libewf_handle_read_buffer_at_offset_async(
+	          NULL,
+	          async_buffers[ 0 ],
+	          64,
+	          0,
+	          &ewf_test_handle_read_callback,
+	          (void *) &( async_read_counts[ 0 ] ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_read_buffer_at_offset_async(
+	          handle,
+	          async_buffers[ 0 ],
+	          64,
+	          0,
+	          NULL,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	libewf_handle_wait_for_async_reads(
+	 handle,
+	 NULL );
+
+	return( 0 );
+}
+
+/* Tests the libewf_handle_wait_for_async_reads function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_wait_for_async_reads(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_wait_for_async_reads(
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_wait_for_async_reads(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 /* Tests the libewf_handle_get_data_chunk function
  * Returns 1 if successful or 0 if not
  */
@@ -2752,6 +3236,21 @@ int main(
 
 		/* TODO: add tests for libewf_handle_read_buffer_at_offset */
 
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_read_buffers_at_offsets",
+		 ewf_test_handle_read_buffers_at_offsets,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_read_buffer_at_offset_async",
+		 ewf_test_handle_read_buffer_at_offset_async,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_wait_for_async_reads",
+		 ewf_test_handle_wait_for_async_reads,
+		 handle );
+
 		/* TODO: add tests for libewf_handle_write_buffer */
 
 		/* TODO: add tests for libewf_handle_write_buffer_at_offset */
@@ -2779,6 +3278,8 @@ int main(
 
 		/* TODO: add tests for libewf_handle_set_maximum_number_of_open_handles */
 
+		/* TODO: add tests for libewf_handle_set_shared_memory_chunks_cache */
+
 		/* TODO: add tests for libewf_handle_segment_files_corrupted */
 
 		/* TODO: add tests for libewf_handle_segment_files_encrypted */
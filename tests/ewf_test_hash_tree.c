@@ -0,0 +1,1434 @@
+/*
+ * Library hash_tree type test program
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_hash_tree.h"
+
+#if defined( __GNUC__ )
+
+/* The SHA-256 digest of empty data
+ */
+uint8_t ewf_test_hash_tree_empty_digest[ 32 ] = {
+	0xe3, 0xb0, 0xc4, 0x42, 0x98, 0xfc, 0x1c, 0x14, 0x9a, 0xfb, 0xf4, 0xc8, 0x99, 0x6f, 0xb9, 0x24,
+	0x27, 0xae, 0x41, 0xe4, 0x64, 0x9b, 0x93, 0x4c, 0xa4, 0x95, 0x99, 0x1b, 0x78, 0x52, 0xb8, 0x55 };
+
+/* Creates a finalized hash tree of 3 ranges of 64 KiB and a range of 100 bytes
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_hash_tree_create(
+     libewf_hash_tree_t **hash_tree,
+     libcerror_error_t **error )
+{
+	uint8_t *buffer    = NULL;
+	size_t buffer_size = ( 3 * 65536 ) + 100;
+	size_t data_offset = 0;
+	size_t update_size = 0;
+
+	buffer = (uint8_t *) malloc(
+	                      buffer_size );
+
+	if( buffer == NULL )
+	{
+		return( -1 );
+	}
+	for( data_offset = 0;
+	     data_offset < buffer_size;
+	     data_offset++ )
+	{
+		buffer[ data_offset ] = (uint8_t) ( data_offset % 251 );
+	}
+	if( libewf_hash_tree_initialize(
+	     hash_tree,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libewf_hash_tree_set_range_size(
+	     *hash_tree,
+	     65536,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	/* Use an update size that does not align with the range size
+	 */
+	for( data_offset = 0;
+	     data_offset < buffer_size;
+	     data_offset += update_size )
+	{
+		update_size = buffer_size - data_offset;
+
+		if( update_size > 30000 )
+		{
+			update_size = 30000;
+		}
+		if( libewf_hash_tree_update(
+		     *hash_tree,
+		     &( buffer[ data_offset ] ),
+		     update_size,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+	}
+	if( libewf_hash_tree_finalize(
+	     *hash_tree,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	free(
+	 buffer );
+
+	return( 1 );
+
+on_error:
+	if( *hash_tree != NULL )
+	{
+		libewf_hash_tree_free(
+		 hash_tree,
+		 NULL );
+	}
+	free(
+	 buffer );
+
+	return( -1 );
+}
+
+/* Tests the libewf_hash_tree_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_hash_tree_initialize(
+     void )
+{
+	libcerror_error_t *error       = NULL;
+	libewf_hash_tree_t *hash_tree  = NULL;
+	int result                     = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests = 1;
+	int number_of_memset_fail_tests = 1;
+	int test_number                 = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libewf_hash_tree_initialize(
+	          &hash_tree,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "hash_tree",
+	 hash_tree );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_hash_tree_free(
+	          &hash_tree,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "hash_tree",
+	 hash_tree );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_hash_tree_initialize(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	hash_tree = (libewf_hash_tree_t *) 0x12345678UL;
+
+	result = libewf_hash_tree_initialize(
+	          &hash_tree,
+	          &error );
+
+	hash_tree = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_hash_tree_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_hash_tree_initialize(
+		          &hash_tree,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( hash_tree != NULL )
+			{
+				libewf_hash_tree_free(
+				 &hash_tree,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "hash_tree",
+			 hash_tree );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_hash_tree_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_hash_tree_initialize(
+		          &hash_tree,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( hash_tree != NULL )
+			{
+				libewf_hash_tree_free(
+				 &hash_tree,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "hash_tree",
+			 hash_tree );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( hash_tree != NULL )
+	{
+		libewf_hash_tree_free(
+		 &hash_tree,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_hash_tree_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_hash_tree_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_hash_tree_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_hash_tree_set_range_size function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_hash_tree_set_range_size(
+     void )
+{
+	libcerror_error_t *error      = NULL;
+	libewf_hash_tree_t *hash_tree = NULL;
+	int result                    = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_hash_tree_initialize(
+	          &hash_tree,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "hash_tree",
+	 hash_tree );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_hash_tree_set_range_size(
+	          hash_tree,
+	          65536,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "hash_tree->range_size",
+	 (uint64_t) hash_tree->range_size,
+	 (uint64_t) 65536 );
+
+	/* Test error cases
+	 */
+	result = libewf_hash_tree_set_range_size(
+	          NULL,
+	          65536,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_hash_tree_set_range_size(
+	          hash_tree,
+	          4096,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_hash_tree_set_range_size(
+	          hash_tree,
+	          65536 + 100,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_hash_tree_free(
+	          &hash_tree,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "hash_tree",
+	 hash_tree );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( hash_tree != NULL )
+	{
+		libewf_hash_tree_free(
+		 &hash_tree,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_hash_tree_update and libewf_hash_tree_finalize functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_hash_tree_update(
+     void )
+{
+	uint8_t buffer[ 16 ];
+
+	libcerror_error_t *error      = NULL;
+	libewf_hash_tree_t *hash_tree = NULL;
+	int result                    = 0;
+
+	/* Test regular cases
+	 */
+	result = ewf_test_hash_tree_create(
+	          &hash_tree,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "hash_tree",
+	 hash_tree );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "hash_tree->media_size",
+	 (uint64_t) hash_tree->media_size,
+	 (uint64_t) ( 3 * 65536 ) + 100 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "hash_tree->number_of_leaves",
+	 hash_tree->number_of_leaves,
+	 (uint64_t) 4 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "hash_tree->is_finalized",
+	 (int) hash_tree->is_finalized,
+	 1 );
+
+	/* Test error cases
+	 */
+	result = libewf_hash_tree_update(
+	          NULL,
+	          buffer,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test libewf_hash_tree_update on a finalized hash tree
+	 */
+	result = libewf_hash_tree_update(
+	          hash_tree,
+	          buffer,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_hash_tree_free(
+	          &hash_tree,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "hash_tree",
+	 hash_tree );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( hash_tree != NULL )
+	{
+		libewf_hash_tree_free(
+		 &hash_tree,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_hash_tree_calculate_root_digest function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_hash_tree_calculate_root_digest(
+     void )
+{
+	uint8_t leaf_digests[ 64 ];
+	uint8_t root_digest[ 32 ];
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	memory_set(
+	 leaf_digests,
+	 0x5a,
+	 64 );
+
+	/* Test regular cases
+	 */
+	result = libewf_hash_tree_calculate_root_digest(
+	          NULL,
+	          0,
+	          root_digest,
+	          32,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          root_digest,
+	          ewf_test_hash_tree_empty_digest,
+	          32 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libewf_hash_tree_calculate_root_digest(
+	          leaf_digests,
+	          1,
+	          root_digest,
+	          32,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          root_digest,
+	          leaf_digests,
+	          32 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libewf_hash_tree_calculate_root_digest(
+	          leaf_digests,
+	          2,
+	          root_digest,
+	          32,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          root_digest,
+	          leaf_digests,
+	          32 );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libewf_hash_tree_calculate_root_digest(
+	          NULL,
+	          2,
+	          root_digest,
+	          32,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_hash_tree_calculate_root_digest(
+	          leaf_digests,
+	          2,
+	          NULL,
+	          32,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_hash_tree_calculate_root_digest(
+	          leaf_digests,
+	          2,
+	          root_digest,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_hash_tree_write_data and libewf_hash_tree_read_data functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_hash_tree_write_data(
+     void )
+{
+	libcerror_error_t *error           = NULL;
+	libewf_hash_tree_t *hash_tree      = NULL;
+	libewf_hash_tree_t *read_hash_tree = NULL;
+	uint8_t *data                      = NULL;
+	size_t data_size                   = 0;
+	int result                         = 0;
+
+	/* Initialize test
+	 */
+	result = ewf_test_hash_tree_create(
+	          &hash_tree,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "hash_tree",
+	 hash_tree );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_hash_tree_initialize(
+	          &read_hash_tree,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "read_hash_tree",
+	 read_hash_tree );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_hash_tree_get_data_size(
+	          hash_tree,
+	          &data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "data_size",
+	 data_size,
+	 (size_t) ( 68 + ( 4 * 32 ) + 4 ) );
+
+	data = (uint8_t *) malloc(
+	                    data_size );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "data",
+	 data );
+
+	result = libewf_hash_tree_write_data(
+	          hash_tree,
+	          data,
+	          data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_hash_tree_read_data(
+	          read_hash_tree,
+	          data,
+	          data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "read_hash_tree->number_of_leaves",
+	 read_hash_tree->number_of_leaves,
+	 hash_tree->number_of_leaves );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "read_hash_tree->media_size",
+	 (uint64_t) read_hash_tree->media_size,
+	 (uint64_t) hash_tree->media_size );
+
+	result = memory_compare(
+	          read_hash_tree->root_digest,
+	          hash_tree->root_digest,
+	          32 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = memory_compare(
+	          read_hash_tree->leaf_digests,
+	          hash_tree->leaf_digests,
+	          4 * 32 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libewf_hash_tree_free(
+	          &read_hash_tree,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_hash_tree_write_data(
+	          hash_tree,
+	          data,
+	          data_size - 1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test libewf_hash_tree_read_data with a corrupted leaf digest
+	 */
+	data[ 68 + 40 ] ^= 0xff;
+
+	result = libewf_hash_tree_initialize(
+	          &read_hash_tree,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_hash_tree_read_data(
+	          read_hash_tree,
+	          data,
+	          data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	free(
+	 data );
+
+	data = NULL;
+
+	result = libewf_hash_tree_free(
+	          &read_hash_tree,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_hash_tree_free(
+	          &hash_tree,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( data != NULL )
+	{
+		free(
+		 data );
+	}
+	if( read_hash_tree != NULL )
+	{
+		libewf_hash_tree_free(
+		 &read_hash_tree,
+		 NULL );
+	}
+	if( hash_tree != NULL )
+	{
+		libewf_hash_tree_free(
+		 &hash_tree,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_hash_tree_get_leaf_range function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_hash_tree_get_leaf_range(
+     void )
+{
+	libcerror_error_t *error      = NULL;
+	libewf_hash_tree_t *hash_tree = NULL;
+	size64_t range_size           = 0;
+	off64_t range_offset          = 0;
+	int result                    = 0;
+
+	/* Initialize test
+	 */
+	result = ewf_test_hash_tree_create(
+	          &hash_tree,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "hash_tree",
+	 hash_tree );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_hash_tree_get_leaf_range(
+	          hash_tree,
+	          1,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "range_offset",
+	 (int64_t) range_offset,
+	 (int64_t) 65536 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) 65536 );
+
+	result = libewf_hash_tree_get_leaf_range(
+	          hash_tree,
+	          3,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "range_offset",
+	 (int64_t) range_offset,
+	 (int64_t) ( 3 * 65536 ) );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) 100 );
+
+	/* Test error cases
+	 */
+	result = libewf_hash_tree_get_leaf_range(
+	          NULL,
+	          0,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_hash_tree_get_leaf_range(
+	          hash_tree,
+	          4,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_hash_tree_free(
+	          &hash_tree,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( hash_tree != NULL )
+	{
+		libewf_hash_tree_free(
+		 &hash_tree,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_hash_tree_compare_leaf_digest function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_hash_tree_compare_leaf_digest(
+     void )
+{
+	uint8_t digest[ 32 ];
+
+	libcerror_error_t *error      = NULL;
+	libewf_hash_tree_t *hash_tree = NULL;
+	int result                    = 0;
+
+	/* Initialize test
+	 */
+	result = ewf_test_hash_tree_create(
+	          &hash_tree,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "hash_tree",
+	 hash_tree );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_copy(
+	 digest,
+	 &( hash_tree->leaf_digests[ 2 * 32 ] ),
+	 32 );
+
+	/* Test regular cases
+	 */
+	result = libewf_hash_tree_compare_leaf_digest(
+	          hash_tree,
+	          2,
+	          digest,
+	          32,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_hash_tree_compare_leaf_digest(
+	          hash_tree,
+	          1,
+	          digest,
+	          32,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_hash_tree_compare_leaf_digest(
+	          NULL,
+	          2,
+	          digest,
+	          32,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_hash_tree_compare_leaf_digest(
+	          hash_tree,
+	          4,
+	          digest,
+	          32,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_hash_tree_compare_leaf_digest(
+	          hash_tree,
+	          2,
+	          digest,
+	          20,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_hash_tree_free(
+	          &hash_tree,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( hash_tree != NULL )
+	{
+		libewf_hash_tree_free(
+		 &hash_tree,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ )
+
+	EWF_TEST_RUN(
+	 "libewf_hash_tree_initialize",
+	 ewf_test_hash_tree_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_hash_tree_free",
+	 ewf_test_hash_tree_free );
+
+	/* TODO: add tests for libewf_hash_tree_clone */
+
+	EWF_TEST_RUN(
+	 "libewf_hash_tree_set_range_size",
+	 ewf_test_hash_tree_set_range_size );
+
+	EWF_TEST_RUN(
+	 "libewf_hash_tree_update",
+	 ewf_test_hash_tree_update );
+
+	EWF_TEST_RUN(
+	 "libewf_hash_tree_calculate_root_digest",
+	 ewf_test_hash_tree_calculate_root_digest );
+
+	EWF_TEST_RUN(
+	 "libewf_hash_tree_write_data",
+	 ewf_test_hash_tree_write_data );
+
+	EWF_TEST_RUN(
+	 "libewf_hash_tree_get_leaf_range",
+	 ewf_test_hash_tree_get_leaf_range );
+
+	EWF_TEST_RUN(
+	 "libewf_hash_tree_compare_leaf_digest",
+	 ewf_test_hash_tree_compare_leaf_digest );
+
+#endif /* defined( __GNUC__ ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
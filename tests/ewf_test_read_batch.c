@@ -0,0 +1,1076 @@
+/*
+ * Library read_batch type test program
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_chunk_data.h"
+#include "../libewf/libewf_definitions.h"
+#include "../libewf/libewf_io_handle.h"
+#include "../libewf/libewf_read_batch.h"
+
+#if defined( __GNUC__ )
+
+/* The requests in the order of the caller, the media size is 10010 and the chunk size 100
+ */
+size_t ewf_test_read_batch_buffer_sizes[ 8 ] = {
+	50, 250, 10, 0, 1000, 30, 5, 100 };
+
+off64_t ewf_test_read_batch_offsets[ 8 ] = {
+	950, 120, 5000, 10, 9950, 160, 2999, 20000 };
+
+/* The chunks that are referenced by the requests
+ */
+uint64_t ewf_test_read_batch_chunk_indexes[ 9 ] = {
+	1, 2, 3, 9, 29, 30, 50, 99, 100 };
+
+uint8_t ewf_test_read_batch_buffer[ 8 ][ 1000 ];
+
+/* The chunk of which the chunk data is corrupted
+ */
+#define EWF_TEST_READ_BATCH_CORRUPTED_CHUNK	3
+
+/* Tests the libewf_read_batch_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_read_batch_initialize(
+     void )
+{
+	void *buffers[ 8 ];
+
+	libcerror_error_t *error        = NULL;
+	libewf_io_handle_t *io_handle   = NULL;
+	libewf_read_batch_t *read_batch = NULL;
+	int request_index               = 0;
+	int result                      = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests = 3;
+	int number_of_memset_fail_tests = 1;
+	int test_number                 = 0;
+#endif
+
+	/* Initialize test
+	 */
+	for( request_index = 0;
+	     request_index < 8;
+	     request_index++ )
+	{
+		buffers[ request_index ] = ewf_test_read_batch_buffer[ request_index ];
+	}
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	io_handle->chunk_size = 100;
+
+	/* Test regular cases
+	 */
+	result = libewf_read_batch_initialize(
+	          &read_batch,
+	          io_handle,
+	          buffers,
+	          ewf_test_read_batch_buffer_sizes,
+	          ewf_test_read_batch_offsets,
+	          8,
+	          10010,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "read_batch",
+	 read_batch );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "read_batch->sorted_requests[ 0 ]->request_index",
+	 read_batch->sorted_requests[ 0 ]->request_index,
+	 3 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "read_batch->sorted_requests[ 7 ]->request_index",
+	 read_batch->sorted_requests[ 7 ]->request_index,
+	 7 );
+
+	/* The size of the requests is limited to the media size
+	 */
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "read_batch->requests[ 4 ].buffer_size",
+	 read_batch->requests[ 4 ].buffer_size,
+	 (size_t) 60 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "read_batch->requests[ 7 ].buffer_size",
+	 read_batch->requests[ 7 ].buffer_size,
+	 (size_t) 0 );
+
+	result = libewf_read_batch_free(
+	          &read_batch,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "read_batch",
+	 read_batch );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_read_batch_initialize(
+	          NULL,
+	          io_handle,
+	          buffers,
+	          ewf_test_read_batch_buffer_sizes,
+	          ewf_test_read_batch_offsets,
+	          8,
+	          10010,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_batch = (libewf_read_batch_t *) 0x12345678UL;
+
+	result = libewf_read_batch_initialize(
+	          &read_batch,
+	          io_handle,
+	          buffers,
+	          ewf_test_read_batch_buffer_sizes,
+	          ewf_test_read_batch_offsets,
+	          8,
+	          10010,
+	          &error );
+
+	read_batch = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_batch_initialize(
+	          &read_batch,
+	          NULL,
+	          buffers,
+	          ewf_test_read_batch_buffer_sizes,
+	          ewf_test_read_batch_offsets,
+	          8,
+	          10010,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_batch_initialize(
+	          &read_batch,
+	          io_handle,
+	          NULL,
+	          ewf_test_read_batch_buffer_sizes,
+	          ewf_test_read_batch_offsets,
+	          8,
+	          10010,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_batch_initialize(
+	          &read_batch,
+	          io_handle,
+	          buffers,
+	          NULL,
+	          ewf_test_read_batch_offsets,
+	          8,
+	          10010,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_batch_initialize(
+	          &read_batch,
+	          io_handle,
+	          buffers,
+	          ewf_test_read_batch_buffer_sizes,
+	          NULL,
+	          8,
+	          10010,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_batch_initialize(
+	          &read_batch,
+	          io_handle,
+	          buffers,
+	          ewf_test_read_batch_buffer_sizes,
+	          ewf_test_read_batch_offsets,
+	          0,
+	          10010,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_read_batch_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_read_batch_initialize(
+		          &read_batch,
+		          io_handle,
+		          buffers,
+		          ewf_test_read_batch_buffer_sizes,
+		          ewf_test_read_batch_offsets,
+		          8,
+		          10010,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( read_batch != NULL )
+			{
+				libewf_read_batch_free(
+				 &read_batch,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "read_batch",
+			 read_batch );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_read_batch_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_read_batch_initialize(
+		          &read_batch,
+		          io_handle,
+		          buffers,
+		          ewf_test_read_batch_buffer_sizes,
+		          ewf_test_read_batch_offsets,
+		          8,
+		          10010,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( read_batch != NULL )
+			{
+				libewf_read_batch_free(
+				 &read_batch,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "read_batch",
+			 read_batch );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	/* Clean up
+	 */
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_batch != NULL )
+	{
+		libewf_read_batch_free(
+		 &read_batch,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_read_batch_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_read_batch_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_read_batch_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_read_batch_get_next_chunks function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_read_batch_get_next_chunks(
+     void )
+{
+	void *buffers[ 8 ];
+
+	libcerror_error_t *error        = NULL;
+	libewf_io_handle_t *io_handle   = NULL;
+	libewf_read_batch_t *read_batch = NULL;
+	int chunk_index                 = 0;
+	int request_index               = 0;
+	int result                      = 0;
+
+	/* Initialize test
+	 */
+	for( request_index = 0;
+	     request_index < 8;
+	     request_index++ )
+	{
+		buffers[ request_index ] = ewf_test_read_batch_buffer[ request_index ];
+	}
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	io_handle->chunk_size = 100;
+
+	result = libewf_read_batch_initialize(
+	          &read_batch,
+	          io_handle,
+	          buffers,
+	          ewf_test_read_batch_buffer_sizes,
+	          ewf_test_read_batch_offsets,
+	          8,
+	          10010,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "read_batch",
+	 read_batch );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_read_batch_get_next_chunks(
+	          read_batch,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "read_batch->number_of_chunks",
+	 read_batch->number_of_chunks,
+	 9 );
+
+	for( chunk_index = 0;
+	     chunk_index < 9;
+	     chunk_index++ )
+	{
+		EWF_TEST_ASSERT_EQUAL_UINT64(
+		 "read_batch->chunks[ chunk_index ].chunk_index",
+		 read_batch->chunks[ chunk_index ].chunk_index,
+		 ewf_test_read_batch_chunk_indexes[ chunk_index ] );
+	}
+	/* The last chunk is limited to the media size
+	 */
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "read_batch->chunks[ 8 ].data_size",
+	 read_batch->chunks[ 8 ].data_size,
+	 (size_t) 10 );
+
+	result = libewf_read_batch_free_chunks(
+	          read_batch,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_read_batch_get_next_chunks(
+	          read_batch,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_read_batch_get_next_chunks(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_read_batch_free(
+	          &read_batch,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "read_batch",
+	 read_batch );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_batch != NULL )
+	{
+		libewf_read_batch_free(
+		 &read_batch,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_read_batch_unpack_chunks function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_read_batch_unpack_chunks(
+     void )
+{
+	void *buffers[ 8 ];
+
+	libcerror_error_t *error        = NULL;
+	libewf_chunk_data_t *chunk_data = NULL;
+	libewf_io_handle_t *io_handle   = NULL;
+	libewf_read_batch_t *read_batch = NULL;
+	int chunk_index                 = 0;
+	int pass                        = 0;
+	int request_index               = 0;
+	int result                      = 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_thread_pool_t *unpack_thread_pool = NULL;
+#endif
+
+	/* Initialize test
+	 */
+	for( request_index = 0;
+	     request_index < 8;
+	     request_index++ )
+	{
+		buffers[ request_index ] = ewf_test_read_batch_buffer[ request_index ];
+	}
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	io_handle->chunk_size = 100;
+
+	result = libewf_read_batch_initialize(
+	          &read_batch,
+	          io_handle,
+	          buffers,
+	          ewf_test_read_batch_buffer_sizes,
+	          ewf_test_read_batch_offsets,
+	          8,
+	          10010,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "read_batch",
+	 read_batch );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_read_batch_get_next_chunks(
+	          read_batch,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "read_batch->number_of_chunks",
+	 read_batch->number_of_chunks,
+	 9 );
+
+	/* Test regular cases
+	 * The chunks are unpacked twice to test that the unpack thread pool is reused
+	 */
+	for( pass = 0;
+	     pass < 2;
+	     pass++ )
+	{
+		for( chunk_index = 0;
+		     chunk_index < 9;
+		     chunk_index++ )
+		{
+			result = libewf_chunk_data_initialize(
+			          &chunk_data,
+			          io_handle->chunk_size,
+			          1,
+			          &error );
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "chunk_data",
+			 chunk_data );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			read_batch->chunks[ chunk_index ].chunk_data = chunk_data;
+
+			chunk_data = NULL;
+
+			memory_set(
+			 read_batch->chunks[ chunk_index ].chunk_data->data,
+			 chunk_index + pass + 1,
+			 read_batch->chunks[ chunk_index ].data_size );
+
+			read_batch->chunks[ chunk_index ].chunk_data->data_size = read_batch->chunks[ chunk_index ].data_size;
+
+			result = libewf_chunk_data_pack(
+			          read_batch->chunks[ chunk_index ].chunk_data,
+			          io_handle,
+			          LIBEWF_COMPRESSION_NONE,
+			          NULL,
+			          0,
+			          LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM,
+			          NULL,
+			          &error );
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+		/* Chunk data that does not match its checksum is freed
+		 * so that the chunk is read by means of the chunks cache
+		 */
+		read_batch->chunks[ EWF_TEST_READ_BATCH_CORRUPTED_CHUNK ].chunk_data->data[ 0 ] ^= 0xff;
+
+		result = libewf_read_batch_unpack_chunks(
+		          read_batch,
+		          NULL,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		for( chunk_index = 0;
+		     chunk_index < 9;
+		     chunk_index++ )
+		{
+			if( chunk_index == EWF_TEST_READ_BATCH_CORRUPTED_CHUNK )
+			{
+				EWF_TEST_ASSERT_IS_NULL(
+				 "read_batch->chunks[ chunk_index ].chunk_data",
+				 read_batch->chunks[ chunk_index ].chunk_data );
+
+				continue;
+			}
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "read_batch->chunks[ chunk_index ].chunk_data",
+			 read_batch->chunks[ chunk_index ].chunk_data );
+
+			EWF_TEST_ASSERT_EQUAL_SIZE(
+			 "read_batch->chunks[ chunk_index ].chunk_data->data_size",
+			 read_batch->chunks[ chunk_index ].chunk_data->data_size,
+			 read_batch->chunks[ chunk_index ].data_size );
+
+			EWF_TEST_ASSERT_EQUAL_UINT8(
+			 "read_batch->chunks[ chunk_index ].chunk_data->data[ 0 ]",
+			 read_batch->chunks[ chunk_index ].chunk_data->data[ 0 ],
+			 (uint8_t) ( chunk_index + pass + 1 ) );
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "read_batch->unpack_thread_pool",
+		 read_batch->unpack_thread_pool );
+
+		if( pass == 0 )
+		{
+			unpack_thread_pool = read_batch->unpack_thread_pool;
+		}
+		else
+		{
+			result = ( read_batch->unpack_thread_pool == unpack_thread_pool );
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+		}
+#endif
+		result = libewf_read_batch_free_chunks(
+		          read_batch,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Reuse the same chunks for the next pass
+		 */
+		read_batch->number_of_chunks = 9;
+	}
+	read_batch->number_of_chunks = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_read_batch_unpack_chunks(
+	          NULL,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_read_batch_free(
+	          &read_batch,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "read_batch",
+	 read_batch );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	if( read_batch != NULL )
+	{
+		libewf_read_batch_free(
+		 &read_batch,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ )
+
+	EWF_TEST_RUN(
+	 "libewf_read_batch_initialize",
+	 ewf_test_read_batch_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_read_batch_free",
+	 ewf_test_read_batch_free );
+
+	EWF_TEST_RUN(
+	 "libewf_read_batch_get_next_chunks",
+	 ewf_test_read_batch_get_next_chunks );
+
+	EWF_TEST_RUN(
+	 "libewf_read_batch_unpack_chunks",
+	 ewf_test_read_batch_unpack_chunks );
+
+#endif /* defined( __GNUC__ ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,950 @@
+/*
+ * Library read_digest type test program
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_read_digest.h"
+
+#if defined( __GNUC__ )
+
+/* The digests of "abc"
+ */
+uint8_t ewf_test_read_digest_md5_digest[ 16 ] = {
+	0x90, 0x01, 0x50, 0x98, 0x3c, 0xd2, 0x4f, 0xb0, 0xd6, 0x96, 0x3f, 0x7d, 0x28, 0xe1, 0x7f, 0x72 };
+
+uint8_t ewf_test_read_digest_sha1_digest[ 20 ] = {
+	0xa9, 0x99, 0x3e, 0x36, 0x47, 0x06, 0x81, 0x6a, 0xba, 0x3e, 0x25, 0x71, 0x78, 0x50, 0xc2, 0x6c,
+	0x9c, 0xd0, 0xd8, 0x9d };
+
+uint8_t ewf_test_read_digest_sha256_digest[ 32 ] = {
+	0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+	0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad };
+
+/* Tests the libewf_read_digest_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_read_digest_initialize(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libewf_read_digest_t *read_digest = NULL;
+	int result                        = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests   = 1;
+	int number_of_memset_fail_tests   = 1;
+	int test_number                   = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libewf_read_digest_initialize(
+	          &read_digest,
+	          LIBEWF_DIGEST_TYPE_MD5 | LIBEWF_DIGEST_TYPE_SHA1 | LIBEWF_DIGEST_TYPE_SHA256,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "read_digest",
+	 read_digest );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_read_digest_free(
+	          &read_digest,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "read_digest",
+	 read_digest );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_read_digest_initialize(
+	          NULL,
+	          LIBEWF_DIGEST_TYPE_MD5,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_digest = (libewf_read_digest_t *) 0x12345678UL;
+
+	result = libewf_read_digest_initialize(
+	          &read_digest,
+	          LIBEWF_DIGEST_TYPE_MD5,
+	          0,
+	          &error );
+
+	read_digest = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_digest_initialize(
+	          &read_digest,
+	          0,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_digest_initialize(
+	          &read_digest,
+	          0x80,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_digest_initialize(
+	          &read_digest,
+	          LIBEWF_DIGEST_TYPE_MD5,
+	          -1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_read_digest_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_read_digest_initialize(
+		          &read_digest,
+		          LIBEWF_DIGEST_TYPE_MD5,
+		          0,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( read_digest != NULL )
+			{
+				libewf_read_digest_free(
+				 &read_digest,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "read_digest",
+			 read_digest );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_read_digest_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_read_digest_initialize(
+		          &read_digest,
+		          LIBEWF_DIGEST_TYPE_MD5,
+		          0,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( read_digest != NULL )
+			{
+				libewf_read_digest_free(
+				 &read_digest,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "read_digest",
+			 read_digest );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_digest != NULL )
+	{
+		libewf_read_digest_free(
+		 &read_digest,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_read_digest_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_read_digest_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_read_digest_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_read_digest_update function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_read_digest_update(
+     void )
+{
+	uint8_t buffer[ 3 ] = { 'a', 'b', 'c' };
+
+	libcerror_error_t *error          = NULL;
+	libewf_read_digest_t *read_digest = NULL;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_read_digest_initialize(
+	          &read_digest,
+	          LIBEWF_DIGEST_TYPE_MD5,
+	          512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "read_digest",
+	 read_digest );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_read_digest_update(
+	          read_digest,
+	          512,
+	          buffer,
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "read_digest->current_offset",
+	 (int64_t) read_digest->current_offset,
+	 (int64_t) 515 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "read_digest->is_out_of_order",
+	 (int) read_digest->is_out_of_order,
+	 0 );
+
+	/* Test libewf_read_digest_update with media data that is not read in order
+	 */
+	result = libewf_read_digest_update(
+	          read_digest,
+	          0,
+	          buffer,
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "read_digest->current_offset",
+	 (int64_t) read_digest->current_offset,
+	 (int64_t) 515 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "read_digest->is_out_of_order",
+	 (int) read_digest->is_out_of_order,
+	 1 );
+
+	/* Test error cases
+	 */
+	result = libewf_read_digest_update(
+	          NULL,
+	          515,
+	          buffer,
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_digest_update(
+	          read_digest,
+	          515,
+	          NULL,
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_digest_update(
+	          read_digest,
+	          515,
+	          buffer,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_read_digest_free(
+	          &read_digest,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "read_digest",
+	 read_digest );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_digest != NULL )
+	{
+		libewf_read_digest_free(
+		 &read_digest,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_read_digest_get_digest function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_read_digest_get_digest(
+     void )
+{
+	uint8_t buffer[ 3 ] = { 'a', 'b', 'c' };
+	uint8_t digest[ 32 ];
+
+	libcerror_error_t *error          = NULL;
+	libewf_read_digest_t *read_digest = NULL;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_read_digest_initialize(
+	          &read_digest,
+	          LIBEWF_DIGEST_TYPE_MD5 | LIBEWF_DIGEST_TYPE_SHA1 | LIBEWF_DIGEST_TYPE_SHA256,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "read_digest",
+	 read_digest );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Update the digests in 2 parts to test that the contexts are continued
+	 */
+	result = libewf_read_digest_update(
+	          read_digest,
+	          0,
+	          buffer,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_read_digest_update(
+	          read_digest,
+	          1,
+	          &( buffer[ 1 ] ),
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_read_digest_get_digest(
+	          read_digest,
+	          LIBEWF_DIGEST_TYPE_MD5,
+	          digest,
+	          32,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          digest,
+	          ewf_test_read_digest_md5_digest,
+	          16 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libewf_read_digest_get_digest(
+	          read_digest,
+	          LIBEWF_DIGEST_TYPE_SHA1,
+	          digest,
+	          32,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          digest,
+	          ewf_test_read_digest_sha1_digest,
+	          20 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libewf_read_digest_get_digest(
+	          read_digest,
+	          LIBEWF_DIGEST_TYPE_SHA256,
+	          digest,
+	          32,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          digest,
+	          ewf_test_read_digest_sha256_digest,
+	          32 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test libewf_read_digest_update on finalized digests
+	 */
+	result = libewf_read_digest_update(
+	          read_digest,
+	          3,
+	          buffer,
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "read_digest->current_offset",
+	 (int64_t) read_digest->current_offset,
+	 (int64_t) 3 );
+
+	/* Test error cases
+	 */
+	result = libewf_read_digest_get_digest(
+	          NULL,
+	          LIBEWF_DIGEST_TYPE_MD5,
+	          digest,
+	          32,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_digest_get_digest(
+	          read_digest,
+	          LIBEWF_DIGEST_TYPE_MD5,
+	          NULL,
+	          32,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_digest_get_digest(
+	          read_digest,
+	          0x80,
+	          digest,
+	          32,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_digest_get_digest(
+	          read_digest,
+	          LIBEWF_DIGEST_TYPE_SHA256,
+	          digest,
+	          20,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_read_digest_free(
+	          &read_digest,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "read_digest",
+	 read_digest );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test libewf_read_digest_get_digest with a digest type that was not requested
+	 */
+	result = libewf_read_digest_initialize(
+	          &read_digest,
+	          LIBEWF_DIGEST_TYPE_MD5,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_read_digest_get_digest(
+	          read_digest,
+	          LIBEWF_DIGEST_TYPE_SHA1,
+	          digest,
+	          32,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test libewf_read_digest_get_digest with media data that was not read in order
+	 */
+	result = libewf_read_digest_update(
+	          read_digest,
+	          1,
+	          buffer,
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_read_digest_get_digest(
+	          read_digest,
+	          LIBEWF_DIGEST_TYPE_MD5,
+	          digest,
+	          32,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libewf_read_digest_free(
+	          &read_digest,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "read_digest",
+	 read_digest );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_digest != NULL )
+	{
+		libewf_read_digest_free(
+		 &read_digest,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ )
+
+	EWF_TEST_RUN(
+	 "libewf_read_digest_initialize",
+	 ewf_test_read_digest_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_read_digest_free",
+	 ewf_test_read_digest_free );
+
+	EWF_TEST_RUN(
+	 "libewf_read_digest_update",
+	 ewf_test_read_digest_update );
+
+	/* TODO: add tests for libewf_read_digest_finalize */
+
+	EWF_TEST_RUN(
+	 "libewf_read_digest_get_digest",
+	 ewf_test_read_digest_get_digest );
+
+#endif /* defined( __GNUC__ ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
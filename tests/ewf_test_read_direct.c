@@ -0,0 +1,2022 @@
+/*
+ * Expert Witness Compression Format (EWF) library direct read testing program
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+#include <wide_string.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <stdio.h>
+
+#include "ewf_test_getopt.h"
+#include "ewf_test_libbfio.h"
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+#include "../libewf/libewf_chunk_table.h"
+#include "../libewf/libewf_definitions.h"
+#include "../libewf/libewf_handle.h"
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The test data consists of chunks of text, random data, zero bytes
+ * and a repeating 64-bit pattern and a last chunk that is not completely filled
+ */
+#define EWF_TEST_READ_DIRECT_CHUNK_SIZE		32768
+#define EWF_TEST_READ_DIRECT_NUMBER_OF_CHUNKS	12
+#define EWF_TEST_READ_DIRECT_MEDIA_SIZE		( ( EWF_TEST_READ_DIRECT_NUMBER_OF_CHUNKS * EWF_TEST_READ_DIRECT_CHUNK_SIZE ) + 1000 )
+
+/* The size of the reads that are served by means of the chunks cache
+ */
+#define EWF_TEST_READ_DIRECT_SECTOR_READ_SIZE	512
+
+/* The zero bytes chunk that is stored as pattern fill in version 2
+ */
+#define EWF_TEST_READ_DIRECT_PATTERN_FILL_CHUNK		6
+
+/* The text chunk and random data chunk that are corrupted
+ */
+#define EWF_TEST_READ_DIRECT_CORRUPTED_TEXT_CHUNK	4
+#define EWF_TEST_READ_DIRECT_CORRUPTED_RANDOM_CHUNK	9
+
+/* The number of requests of the scatter/gather read
+ */
+#define EWF_TEST_READ_DIRECT_NUMBER_OF_BATCH_REQUESTS	9
+
+/* Copies a string of a decimal value to a 64-bit value
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_system_string_decimal_copy_to_64_bit(
+     const system_character_t *string,
+     size_t string_size,
+     uint64_t *value_64bit,
+     libcerror_error_t **error )
+{
+	static char *function              = "ewf_test_system_string_decimal_copy_to_64_bit";
+	size_t string_index                = 0;
+	system_character_t character_value = 0;
+	uint8_t maximum_string_index       = 20;
+	int8_t sign                        = 1;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( string_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid string size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value 64-bit.",
+		 function );
+
+		return( -1 );
+	}
+	*value_64bit = 0;
+
+	if( string[ string_index ] == (system_character_t) '-' )
+	{
+		string_index++;
+		maximum_string_index++;
+
+		sign = -1;
+	}
+	else if( string[ string_index ] == (system_character_t) '+' )
+	{
+		string_index++;
+		maximum_string_index++;
+	}
+	while( string_index < string_size )
+	{
+		if( string[ string_index ] == 0 )
+		{
+			break;
+		}
+		if( string_index > (size_t) maximum_string_index )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_LARGE,
+			 "%s: string too large.",
+			 function );
+
+			return( -1 );
+		}
+		*value_64bit *= 10;
+
+		if( ( string[ string_index ] >= (system_character_t) '0' )
+		 && ( string[ string_index ] <= (system_character_t) '9' ) )
+		{
+			character_value = (system_character_t) ( string[ string_index ] - (system_character_t) '0' );
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported character value: %" PRIc_SYSTEM " at index: %d.",
+			 function,
+			 string[ string_index ],
+			 string_index );
+
+			return( -1 );
+		}
+		*value_64bit += character_value;
+
+		string_index++;
+	}
+	if( sign == -1 )
+	{
+		*value_64bit *= (uint64_t) -1;
+	}
+	return( 1 );
+}
+
+/* Generates the test data
+ */
+void ewf_test_read_direct_generate_data(
+      uint8_t *data,
+      size_t data_size )
+{
+	const char *text           = "libewf direct read test data\n";
+	size_t data_offset         = 0;
+	size_t text_length         = 0;
+	uint64_t chunk_index       = 0;
+	uint32_t random_value      = 0x12345678UL;
+
+	text_length = narrow_string_length(
+	               text );
+
+	for( data_offset = 0;
+	     data_offset < data_size;
+	     data_offset++ )
+	{
+		chunk_index = data_offset / EWF_TEST_READ_DIRECT_CHUNK_SIZE;
+
+		switch( chunk_index % 4 )
+		{
+			case 0:
+				data[ data_offset ] = (uint8_t) text[ data_offset % text_length ];
+				break;
+
+			case 1:
+				random_value ^= random_value << 13;
+				random_value ^= random_value >> 17;
+				random_value ^= random_value << 5;
+
+				data[ data_offset ] = (uint8_t) random_value;
+				break;
+
+			case 2:
+				data[ data_offset ] = 0;
+				break;
+
+			case 3:
+				data[ data_offset ] = (uint8_t) ( 0x10 + ( data_offset % 8 ) );
+				break;
+		}
+	}
+}
+
+/* Writes the test data to EWF file(s)
+ * Return 1 if successful or -1 on error
+ */
+int ewf_test_read_direct_write(
+     const system_character_t *filename,
+     uint8_t format,
+     int8_t compression_level,
+     uint8_t compression_flags,
+     size64_t maximum_segment_size,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libewf_handle_t *handle = NULL;
+	static char *function   = "ewf_test_read_direct_write";
+	ssize_t write_count     = 0;
+
+	if( libewf_handle_initialize(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     handle,
+	     (wchar_t * const *) &filename,
+	     1,
+	     LIBEWF_OPEN_WRITE,
+	     error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     handle,
+	     (char * const *) &filename,
+	     1,
+	     LIBEWF_OPEN_WRITE,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_format(
+	     handle,
+	     format,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable set format.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_media_size(
+	     handle,
+	     (size64_t) data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable set media size.",
+		 function );
+
+		goto on_error;
+	}
+	if( maximum_segment_size > 0 )
+	{
+		if( libewf_handle_set_maximum_segment_size(
+		     handle,
+		     maximum_segment_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable set maximum segment size.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libewf_handle_set_compression_values(
+	     handle,
+	     compression_level,
+	     compression_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable set compression values.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = libewf_handle_write_buffer(
+		       handle,
+		       data,
+		       data_size,
+		       error );
+
+	if( write_count != (ssize_t) data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable write buffer of size: %" PRIzd ".",
+		 function,
+		 data_size );
+
+		goto on_error;
+	}
+	if( libewf_handle_close(
+	     handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Creates and opens a handle of the EWF file(s) for reading
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_read_direct_open(
+     libewf_handle_t **handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	system_character_t **filenames = NULL;
+	static char *function          = "ewf_test_read_direct_open";
+	size_t filename_length         = 0;
+	int number_of_filenames        = 0;
+	int result                     = 0;
+
+	filename_length = system_string_length(
+	                   filename );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libewf_glob_wide(
+	          filename,
+	          filename_length,
+	          LIBEWF_FORMAT_UNKNOWN,
+	          &filenames,
+	          &number_of_filenames,
+	          error );
+#else
+	result = libewf_glob(
+	          filename,
+	          filename_length,
+	          LIBEWF_FORMAT_UNKNOWN,
+	          &filenames,
+	          &number_of_filenames,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to resolve filename(s).",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_initialize(
+	     handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libewf_handle_open_wide(
+	          *handle,
+	          (wchar_t * const *) filenames,
+	          number_of_filenames,
+	          LIBEWF_OPEN_READ,
+	          error );
+#else
+	result = libewf_handle_open(
+	          *handle,
+	          (char * const *) filenames,
+	          number_of_filenames,
+	          LIBEWF_OPEN_READ,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libewf_glob_wide_free(
+	          filenames,
+	          number_of_filenames,
+	          error );
+#else
+	result = libewf_glob_free(
+	          filenames,
+	          number_of_filenames,
+	          error );
+#endif
+	filenames = NULL;
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free globbed filenames.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *handle != NULL )
+	{
+		libewf_handle_close(
+		 *handle,
+		 NULL );
+		libewf_handle_free(
+		 handle,
+		 NULL );
+	}
+	if( filenames != NULL )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		libewf_glob_wide_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#else
+		libewf_glob_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#endif
+	}
+	return( -1 );
+}
+
+/* Reads the media data of the EWF file(s) with reads of a specific size
+ * The media data is read in reads of at least the chunk size to read whole chunks directly
+ * and in reads of the sector size to read the chunks by means of the chunks cache
+ * The sector ranges of the checksum errors are stored in checksum_errors
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_read_direct_read(
+     const system_character_t *filename,
+     uint8_t zero_chunk_on_error,
+     size_t read_size,
+     uint8_t *buffer,
+     size_t buffer_size,
+     uint64_t *checksum_errors,
+     uint32_t maximum_number_of_checksum_errors,
+     uint32_t *number_of_checksum_errors,
+     libcerror_error_t **error )
+{
+	libewf_handle_t *handle = NULL;
+	static char *function   = "ewf_test_read_direct_read";
+	size_t buffer_offset    = 0;
+	size_t remaining_size   = 0;
+	ssize_t read_count      = 0;
+	uint32_t error_index    = 0;
+
+	if( ewf_test_read_direct_open(
+	     &handle,
+	     filename,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_read_zero_chunk_on_error(
+	     handle,
+	     zero_chunk_on_error,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set read zero chunk on error.",
+		 function );
+
+		goto on_error;
+	}
+	while( buffer_offset < buffer_size )
+	{
+		remaining_size = buffer_size - buffer_offset;
+
+		if( remaining_size > read_size )
+		{
+			remaining_size = read_size;
+		}
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              &( buffer[ buffer_offset ] ),
+		              remaining_size,
+		              (off64_t) buffer_offset,
+		              error );
+
+		if( read_count != (ssize_t) remaining_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer of size: %" PRIzd " at offset: %" PRIzd ".",
+			 function,
+			 remaining_size,
+			 buffer_offset );
+
+			goto on_error;
+		}
+		buffer_offset += remaining_size;
+	}
+	if( libewf_handle_get_number_of_checksum_errors(
+	     handle,
+	     number_of_checksum_errors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of checksum errors.",
+		 function );
+
+		goto on_error;
+	}
+	if( *number_of_checksum_errors > maximum_number_of_checksum_errors )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: number of checksum errors value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	for( error_index = 0;
+	     error_index < *number_of_checksum_errors;
+	     error_index++ )
+	{
+		if( libewf_handle_get_checksum_error(
+		     handle,
+		     error_index,
+		     &( checksum_errors[ error_index * 2 ] ),
+		     &( checksum_errors[ ( error_index * 2 ) + 1 ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve checksum error: %" PRIu32 ".",
+			 function,
+			 error_index );
+
+			goto on_error;
+		}
+	}
+	if( libewf_handle_close(
+	     handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the media data directly and by means of the chunks cache and compares the results
+ * Returns 1 if the results match the expected data, 0 if not or -1 on error
+ */
+int ewf_test_read_direct_compare(
+     const system_character_t *filename,
+     const uint8_t *expected_data,
+     size_t expected_data_size,
+     uint8_t zero_chunk_on_error,
+     libcerror_error_t **error )
+{
+	uint64_t cache_checksum_errors[ 8 ];
+	uint64_t direct_checksum_errors[ 8 ];
+
+	uint8_t *cache_buffer                    = NULL;
+	uint8_t *direct_buffer                   = NULL;
+	static char *function                    = "ewf_test_read_direct_compare";
+	uint32_t cache_number_of_checksum_errors  = 0;
+	uint32_t direct_number_of_checksum_errors = 0;
+	int result                               = 1;
+
+	cache_buffer = (uint8_t *) memory_allocate(
+	                            sizeof( uint8_t ) * expected_data_size );
+
+	if( cache_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create cache buffer.",
+		 function );
+
+		goto on_error;
+	}
+	direct_buffer = (uint8_t *) memory_allocate(
+	                             sizeof( uint8_t ) * expected_data_size );
+
+	if( direct_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create direct buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( ewf_test_read_direct_read(
+	     filename,
+	     zero_chunk_on_error,
+	     EWF_TEST_READ_DIRECT_SECTOR_READ_SIZE,
+	     cache_buffer,
+	     expected_data_size,
+	     cache_checksum_errors,
+	     4,
+	     &cache_number_of_checksum_errors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read media data by means of the chunks cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( ewf_test_read_direct_read(
+	     filename,
+	     zero_chunk_on_error,
+	     expected_data_size,
+	     direct_buffer,
+	     expected_data_size,
+	     direct_checksum_errors,
+	     4,
+	     &direct_number_of_checksum_errors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read media data directly.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_compare(
+	     cache_buffer,
+	     expected_data,
+	     expected_data_size ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Media data read by means of the chunks cache does not match the expected data.\n" );
+
+		result = 0;
+	}
+	if( memory_compare(
+	     direct_buffer,
+	     expected_data,
+	     expected_data_size ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Media data read directly does not match the expected data.\n" );
+
+		result = 0;
+	}
+	if( direct_number_of_checksum_errors != cache_number_of_checksum_errors )
+	{
+		fprintf(
+		 stderr,
+		 "Number of checksum errors of direct read: %" PRIu32 " does not match chunks cache read: %" PRIu32 ".\n",
+		 direct_number_of_checksum_errors,
+		 cache_number_of_checksum_errors );
+
+		result = 0;
+	}
+	else if( ( direct_number_of_checksum_errors > 0 )
+	      && ( memory_compare(
+	            direct_checksum_errors,
+	            cache_checksum_errors,
+	            sizeof( uint64_t ) * 2 * direct_number_of_checksum_errors ) != 0 ) )
+	{
+		fprintf(
+		 stderr,
+		 "Checksum errors of direct read do not match chunks cache read.\n" );
+
+		result = 0;
+	}
+	memory_free(
+	 direct_buffer );
+
+	memory_free(
+	 cache_buffer );
+
+	return( result );
+
+on_error:
+	if( direct_buffer != NULL )
+	{
+		memory_free(
+		 direct_buffer );
+	}
+	if( cache_buffer != NULL )
+	{
+		memory_free(
+		 cache_buffer );
+	}
+	return( -1 );
+}
+
+/* Reads the media data of scattered requests in a single batch and one request at a time
+ * and compares the results
+ * The requests are unaligned, overlap, are not in order of offset and include the corrupted chunks
+ * Returns 1 if the results match, 0 if not or -1 on error
+ */
+int ewf_test_read_direct_compare_batch(
+     const system_character_t *filename,
+     uint8_t zero_chunk_on_error,
+     libcerror_error_t **error )
+{
+	off64_t offsets[ EWF_TEST_READ_DIRECT_NUMBER_OF_BATCH_REQUESTS ] = {
+		( 5 * EWF_TEST_READ_DIRECT_CHUNK_SIZE ) + 100,
+		0,
+		( 3 * EWF_TEST_READ_DIRECT_CHUNK_SIZE ) + 7,
+		EWF_TEST_READ_DIRECT_CHUNK_SIZE + ( EWF_TEST_READ_DIRECT_CHUNK_SIZE / 2 ),
+		( 9 * EWF_TEST_READ_DIRECT_CHUNK_SIZE ) - 513,
+		EWF_TEST_READ_DIRECT_MEDIA_SIZE - 300,
+		2 * EWF_TEST_READ_DIRECT_CHUNK_SIZE,
+		EWF_TEST_READ_DIRECT_MEDIA_SIZE + 10,
+		0 };
+
+	size_t buffer_sizes[ EWF_TEST_READ_DIRECT_NUMBER_OF_BATCH_REQUESTS ] = {
+		3 * EWF_TEST_READ_DIRECT_CHUNK_SIZE,
+		2 * EWF_TEST_READ_DIRECT_CHUNK_SIZE,
+		2 * EWF_TEST_READ_DIRECT_CHUNK_SIZE,
+		EWF_TEST_READ_DIRECT_CHUNK_SIZE,
+		EWF_TEST_READ_DIRECT_CHUNK_SIZE + 1026,
+		1000,
+		0,
+		10,
+		EWF_TEST_READ_DIRECT_MEDIA_SIZE };
+
+	uint8_t *batch_buffers[ EWF_TEST_READ_DIRECT_NUMBER_OF_BATCH_REQUESTS ];
+	ssize_t batch_read_counts[ EWF_TEST_READ_DIRECT_NUMBER_OF_BATCH_REQUESTS ];
+
+	libewf_handle_t *batch_handle  = NULL;
+	libewf_handle_t *single_handle = NULL;
+	uint8_t *single_buffer         = NULL;
+	static char *function          = "ewf_test_read_direct_compare_batch";
+	ssize_t single_read_count      = 0;
+	int request_index              = 0;
+	int result                     = 1;
+
+	for( request_index = 0;
+	     request_index < EWF_TEST_READ_DIRECT_NUMBER_OF_BATCH_REQUESTS;
+	     request_index++ )
+	{
+		batch_buffers[ request_index ] = NULL;
+	}
+	for( request_index = 0;
+	     request_index < EWF_TEST_READ_DIRECT_NUMBER_OF_BATCH_REQUESTS;
+	     request_index++ )
+	{
+		/* A buffer is allocated also for a request of zero bytes
+		 */
+		batch_buffers[ request_index ] = (uint8_t *) memory_allocate(
+		                                              sizeof( uint8_t ) * ( buffer_sizes[ request_index ] + 1 ) );
+
+		if( batch_buffers[ request_index ] == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create batch buffer: %d.",
+			 function,
+			 request_index );
+
+			goto on_error;
+		}
+	}
+	single_buffer = (uint8_t *) memory_allocate(
+	                             sizeof( uint8_t ) * EWF_TEST_READ_DIRECT_MEDIA_SIZE );
+
+	if( single_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create single buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( ewf_test_read_direct_open(
+	     &batch_handle,
+	     filename,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open batch handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( ewf_test_read_direct_open(
+	     &single_handle,
+	     filename,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open single handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_read_zero_chunk_on_error(
+	     batch_handle,
+	     zero_chunk_on_error,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set read zero chunk on error of batch handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_read_zero_chunk_on_error(
+	     single_handle,
+	     zero_chunk_on_error,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set read zero chunk on error of single handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_read_buffers_at_offsets(
+	     batch_handle,
+	     (void * const *) batch_buffers,
+	     buffer_sizes,
+	     offsets,
+	     batch_read_counts,
+	     EWF_TEST_READ_DIRECT_NUMBER_OF_BATCH_REQUESTS,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffers at offsets.",
+		 function );
+
+		goto on_error;
+	}
+	for( request_index = 0;
+	     request_index < EWF_TEST_READ_DIRECT_NUMBER_OF_BATCH_REQUESTS;
+	     request_index++ )
+	{
+		single_read_count = libewf_handle_read_buffer_at_offset(
+		                     single_handle,
+		                     single_buffer,
+		                     buffer_sizes[ request_index ],
+		                     offsets[ request_index ],
+		                     NULL );
+
+		if( batch_read_counts[ request_index ] != single_read_count )
+		{
+			fprintf(
+			 stderr,
+			 "Batch read count: %" PRIzd " of request: %d does not match single read count: %" PRIzd ".\n",
+			 batch_read_counts[ request_index ],
+			 request_index,
+			 single_read_count );
+
+			result = 0;
+		}
+		else if( ( single_read_count > 0 )
+		      && ( memory_compare(
+		            batch_buffers[ request_index ],
+		            single_buffer,
+		            (size_t) single_read_count ) != 0 ) )
+		{
+			fprintf(
+			 stderr,
+			 "Batch read data of request: %d does not match single read data.\n",
+			 request_index );
+
+			result = 0;
+		}
+	}
+	if( libewf_handle_close(
+	     single_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close single handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &single_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free single handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_close(
+	     batch_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close batch handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &batch_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free batch handle.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 single_buffer );
+
+	for( request_index = 0;
+	     request_index < EWF_TEST_READ_DIRECT_NUMBER_OF_BATCH_REQUESTS;
+	     request_index++ )
+	{
+		memory_free(
+		 batch_buffers[ request_index ] );
+	}
+	return( result );
+
+on_error:
+	if( single_handle != NULL )
+	{
+		libewf_handle_close(
+		 single_handle,
+		 NULL );
+		libewf_handle_free(
+		 &single_handle,
+		 NULL );
+	}
+	if( batch_handle != NULL )
+	{
+		libewf_handle_close(
+		 batch_handle,
+		 NULL );
+		libewf_handle_free(
+		 &batch_handle,
+		 NULL );
+	}
+	if( single_buffer != NULL )
+	{
+		memory_free(
+		 single_buffer );
+	}
+	for( request_index = 0;
+	     request_index < EWF_TEST_READ_DIRECT_NUMBER_OF_BATCH_REQUESTS;
+	     request_index++ )
+	{
+		if( batch_buffers[ request_index ] != NULL )
+		{
+			memory_free(
+			 batch_buffers[ request_index ] );
+		}
+	}
+	return( -1 );
+}
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Retrieves the range of the stored data of a chunk
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_read_direct_get_chunk_data_range(
+     libewf_handle_t *handle,
+     uint64_t chunk_index,
+     int *file_io_pool_entry,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *chunk_data_flags,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "ewf_test_read_direct_get_chunk_data_range";
+
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( libewf_chunk_table_get_chunk_data_range_by_offset(
+	     internal_handle->chunk_table,
+	     chunk_index,
+	     internal_handle->file_io_pool,
+	     internal_handle->segment_table,
+	     internal_handle->chunk_groups_cache,
+	     (off64_t) ( chunk_index * EWF_TEST_READ_DIRECT_CHUNK_SIZE ),
+	     file_io_pool_entry,
+	     chunk_data_offset,
+	     chunk_data_size,
+	     chunk_data_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " data range.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the range flags of the stored data of a chunk in the EWF file(s)
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_read_direct_get_chunk_data_flags(
+     const system_character_t *filename,
+     uint64_t chunk_index,
+     uint32_t *chunk_data_flags,
+     libcerror_error_t **error )
+{
+	libewf_handle_t *handle   = NULL;
+	static char *function     = "ewf_test_read_direct_get_chunk_data_flags";
+	size64_t chunk_data_size  = 0;
+	off64_t chunk_data_offset = 0;
+	int file_io_pool_entry    = 0;
+
+	if( ewf_test_read_direct_open(
+	     &handle,
+	     filename,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( ewf_test_read_direct_get_chunk_data_range(
+	     handle,
+	     chunk_index,
+	     &file_io_pool_entry,
+	     &chunk_data_offset,
+	     &chunk_data_size,
+	     chunk_data_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " data range.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	if( libewf_handle_close(
+	     handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Corrupts the stored data of a chunk in the EWF file(s)
+ * The range flags of the stored chunk data are stored in chunk_data_flags
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_read_direct_corrupt_chunk(
+     const system_character_t *filename,
+     uint64_t chunk_index,
+     uint32_t *chunk_data_flags,
+     libcerror_error_t **error )
+{
+	uint8_t chunk_data[ 4 ];
+
+	libewf_handle_t *handle                   = NULL;
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "ewf_test_read_direct_corrupt_chunk";
+	size64_t chunk_data_size                  = 0;
+	off64_t chunk_data_offset                 = 0;
+	ssize_t read_count                        = 0;
+	ssize_t write_count                       = 0;
+	int file_io_pool_entry                    = 0;
+
+	if( ewf_test_read_direct_open(
+	     &handle,
+	     filename,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( ewf_test_read_direct_get_chunk_data_range(
+	     handle,
+	     chunk_index,
+	     &file_io_pool_entry,
+	     &chunk_data_offset,
+	     &chunk_data_size,
+	     chunk_data_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " data range.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	if( chunk_data_size < 8 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk: %" PRIu64 " data size value out of bounds.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	/* Invert 4 bytes in the middle of the stored chunk data
+	 */
+	chunk_data_offset += (off64_t) ( chunk_data_size / 2 );
+
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( libbfio_pool_reopen(
+	     internal_handle->file_io_pool,
+	     file_io_pool_entry,
+	     LIBBFIO_OPEN_READ_WRITE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to reopen file IO pool entry: %d.",
+		 function,
+		 file_io_pool_entry );
+
+		goto on_error;
+	}
+	if( libbfio_pool_seek_offset(
+	     internal_handle->file_io_pool,
+	     file_io_pool_entry,
+	     chunk_data_offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek chunk: %" PRIu64 " data offset: %" PRIi64 ".",
+		 function,
+		 chunk_index,
+		 chunk_data_offset );
+
+		goto on_error;
+	}
+	read_count = libbfio_pool_read_buffer(
+	              internal_handle->file_io_pool,
+	              file_io_pool_entry,
+	              chunk_data,
+	              4,
+	              error );
+
+	if( read_count != (ssize_t) 4 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	chunk_data[ 0 ] ^= 0xff;
+	chunk_data[ 1 ] ^= 0xff;
+	chunk_data[ 2 ] ^= 0xff;
+	chunk_data[ 3 ] ^= 0xff;
+
+	if( libbfio_pool_seek_offset(
+	     internal_handle->file_io_pool,
+	     file_io_pool_entry,
+	     chunk_data_offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek chunk: %" PRIu64 " data offset: %" PRIi64 ".",
+		 function,
+		 chunk_index,
+		 chunk_data_offset );
+
+		goto on_error;
+	}
+	write_count = libbfio_pool_write_buffer(
+	               internal_handle->file_io_pool,
+	               file_io_pool_entry,
+	               chunk_data,
+	               4,
+	               error );
+
+	if( write_count != (ssize_t) 4 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	if( libewf_handle_close(
+	     handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* Tests reading compressed, uncompressed, pattern fill and corrupted chunks directly
+ * Return 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_read_direct(
+     const system_character_t *target,
+     uint8_t format,
+     int8_t compression_level,
+     uint8_t compression_flags,
+     size64_t maximum_segment_size,
+     libcerror_error_t **error )
+{
+	system_character_t *filename = NULL;
+	uint8_t *data                = NULL;
+	static char *function        = "ewf_test_read_direct";
+	size_t filename_size         = 0;
+	size_t target_length         = 0;
+	int result                   = 0;
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+	uint32_t chunk_data_flags    = 0;
+	uint64_t chunk_index         = 0;
+	size_t data_offset           = 0;
+#endif
+
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * EWF_TEST_READ_DIRECT_MEDIA_SIZE );
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data.",
+		 function );
+
+		goto on_error;
+	}
+	ewf_test_read_direct_generate_data(
+	 data,
+	 EWF_TEST_READ_DIRECT_MEDIA_SIZE );
+
+	if( ewf_test_read_direct_write(
+	     target,
+	     format,
+	     compression_level,
+	     compression_flags,
+	     maximum_segment_size,
+	     data,
+	     EWF_TEST_READ_DIRECT_MEDIA_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write test data.",
+		 function );
+
+		goto on_error;
+	}
+	/* The filename of the first segment file is the target with the extension .E01 or .Ex01
+	 */
+	target_length = system_string_length(
+	                 target );
+
+	filename_size = target_length + 6;
+
+	filename = system_string_allocate(
+	            filename_size );
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     filename,
+	     target,
+	     target_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy target to filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( format == LIBEWF_FORMAT_V2_ENCASE7 )
+	{
+		result = ( system_string_copy(
+		            &( filename[ target_length ] ),
+		            _SYSTEM_STRING( ".Ex01" ),
+		            6 ) != NULL );
+	}
+	else
+	{
+		result = ( system_string_copy(
+		            &( filename[ target_length ] ),
+		            _SYSTEM_STRING( ".E01" ),
+		            5 ) != NULL );
+	}
+	if( result == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy extension to filename.",
+		 function );
+
+		goto on_error;
+	}
+	/* The direct reads of intact chunks must match the test data
+	 */
+	result = ewf_test_read_direct_compare(
+	          filename,
+	          data,
+	          EWF_TEST_READ_DIRECT_MEDIA_SIZE,
+	          0,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to compare media data of intact chunks.",
+		 function );
+
+		goto on_error;
+	}
+	if( result == 1 )
+	{
+		/* The scatter/gather reads of intact chunks must match the single reads
+		 */
+		result = ewf_test_read_direct_compare_batch(
+		          filename,
+		          0,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to compare batch read of intact chunks.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+	if( ( result == 1 )
+	 && ( format == LIBEWF_FORMAT_V2_ENCASE7 )
+	 && ( ( compression_flags & LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION ) != 0 ) )
+	{
+		/* A chunk of zero bytes is stored as pattern fill
+		 */
+		if( ewf_test_read_direct_get_chunk_data_flags(
+		     filename,
+		     EWF_TEST_READ_DIRECT_PATTERN_FILL_CHUNK,
+		     &chunk_data_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %d data flags.",
+			 function,
+			 EWF_TEST_READ_DIRECT_PATTERN_FILL_CHUNK );
+
+			goto on_error;
+		}
+		if( ( chunk_data_flags & LIBEWF_RANGE_FLAG_USES_PATTERN_FILL ) == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Zero bytes chunk: %d is not stored as pattern fill.\n",
+			 EWF_TEST_READ_DIRECT_PATTERN_FILL_CHUNK );
+
+			result = 0;
+		}
+	}
+	if( result == 1 )
+	{
+		/* Corrupt a text chunk, which is stored compressed if compression is used,
+		 * and a random data chunk, which is stored uncompressed with a checksum
+		 */
+		for( chunk_index = EWF_TEST_READ_DIRECT_CORRUPTED_TEXT_CHUNK;
+		     chunk_index <= EWF_TEST_READ_DIRECT_CORRUPTED_RANDOM_CHUNK;
+		     chunk_index += EWF_TEST_READ_DIRECT_CORRUPTED_RANDOM_CHUNK - EWF_TEST_READ_DIRECT_CORRUPTED_TEXT_CHUNK )
+		{
+			if( ewf_test_read_direct_corrupt_chunk(
+			     filename,
+			     chunk_index,
+			     &chunk_data_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to corrupt chunk: %" PRIu64 ".",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+			if( ( compression_level != LIBEWF_COMPRESSION_NONE )
+			 && ( chunk_index == EWF_TEST_READ_DIRECT_CORRUPTED_TEXT_CHUNK )
+			 && ( ( chunk_data_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) == 0 ) )
+			{
+				fprintf(
+				 stderr,
+				 "Text chunk: %" PRIu64 " is not stored compressed.\n",
+				 chunk_index );
+
+				result = 0;
+			}
+			/* Corrupted chunk data that is not compressed can only be detected by its checksum
+			 */
+			if( ( ( chunk_data_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) == 0 )
+			 && ( ( chunk_data_flags & LIBEWF_RANGE_FLAG_HAS_CHECKSUM ) == 0 ) )
+			{
+				fprintf(
+				 stderr,
+				 "Chunk: %" PRIu64 " is not stored with a checksum.\n",
+				 chunk_index );
+
+				result = 0;
+			}
+			/* The chunk is expected to read as zero bytes with zero chunk on error
+			 */
+			data_offset = (size_t) ( chunk_index * EWF_TEST_READ_DIRECT_CHUNK_SIZE );
+
+			if( memory_set(
+			     &( data[ data_offset ] ),
+			     0,
+			     EWF_TEST_READ_DIRECT_CHUNK_SIZE ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+		}
+	}
+	if( result == 1 )
+	{
+		/* The direct reads of corrupted chunks must match the reads by means
+		 * of the chunks cache, including the checksum errors
+		 */
+		result = ewf_test_read_direct_compare(
+		          filename,
+		          data,
+		          EWF_TEST_READ_DIRECT_MEDIA_SIZE,
+		          1,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to compare media data of corrupted chunks.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( result == 1 )
+	{
+		/* The scatter/gather reads of corrupted chunks must match the single reads
+		 */
+		result = ewf_test_read_direct_compare_batch(
+		          filename,
+		          1,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to compare batch read of corrupted chunks.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	memory_free(
+	 filename );
+
+	memory_free(
+	 data );
+
+	return( result );
+
+on_error:
+	if( filename != NULL )
+	{
+		memory_free(
+		 filename );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	return( -1 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libcerror_error_t *error                        = NULL;
+	system_character_t *option_compression_level    = NULL;
+	system_character_t *option_format               = NULL;
+	system_character_t *option_maximum_segment_size = NULL;
+	system_integer_t option                         = 0;
+	size64_t maximum_segment_size                   = 0;
+	size_t string_length                            = 0;
+	uint8_t compression_flags                       = 0;
+	uint8_t format                                  = LIBEWF_FORMAT_ENCASE6;
+	int8_t compression_level                        = LIBEWF_COMPRESSION_NONE;
+	int result                                      = 0;
+
+	while( ( option = ewf_test_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "c:f:S:" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM ".\n",
+				 argv[ optind - 1 ] );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'c':
+				option_compression_level = optarg;
+
+				break;
+
+			case (system_integer_t) 'f':
+				option_format = optarg;
+
+				break;
+
+			case (system_integer_t) 'S':
+				option_maximum_segment_size = optarg;
+
+				break;
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing EWF image filename.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	if( option_compression_level != NULL )
+	{
+		string_length = system_string_length(
+				 option_compression_level );
+
+		if( string_length != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported compression level.\n" );
+
+			goto on_error;
+		}
+		if( option_compression_level[ 0 ] == (system_character_t) 'b' )
+		{
+			compression_level = LIBEWF_COMPRESSION_BEST;
+			compression_flags = 0;
+		}
+		else if( option_compression_level[ 0 ] == (system_character_t) 'e' )
+		{
+			compression_level = LIBEWF_COMPRESSION_NONE;
+			compression_flags = LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION;
+		}
+		else if( option_compression_level[ 0 ] == (system_character_t) 'f' )
+		{
+			compression_level = LIBEWF_COMPRESSION_FAST;
+			compression_flags = 0;
+		}
+		else if( option_compression_level[ 0 ] == (system_character_t) 'n' )
+		{
+			compression_level = LIBEWF_COMPRESSION_NONE;
+			compression_flags = 0;
+		}
+		else
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported compression level.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_format != NULL )
+	{
+		string_length = system_string_length(
+				 option_format );
+
+		if( string_length != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported format.\n" );
+
+			goto on_error;
+		}
+		/* Version 2 stores chunks of a 64-bit pattern as pattern fill
+		 * if empty block compression is used
+		 */
+		if( option_format[ 0 ] == (system_character_t) '1' )
+		{
+			format = LIBEWF_FORMAT_ENCASE6;
+		}
+		else if( option_format[ 0 ] == (system_character_t) '2' )
+		{
+			format = LIBEWF_FORMAT_V2_ENCASE7;
+		}
+		else
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported format.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_maximum_segment_size != NULL )
+	{
+		string_length = system_string_length(
+				 option_maximum_segment_size );
+
+		if( ewf_test_system_string_decimal_copy_to_64_bit(
+		     option_maximum_segment_size,
+		     string_length + 1,
+		     &maximum_segment_size,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported maximum segment size.\n" );
+
+			goto on_error;
+		}
+	}
+	result = ewf_test_read_direct(
+	          argv[ optind ],
+	          format,
+	          compression_level,
+	          compression_flags,
+	          maximum_segment_size,
+	          &error );
+
+	if( result == -1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test direct read.\n" );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		return( EXIT_FAILURE );
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libewf_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libewf_error_free(
+		 &error );
+	}
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,729 @@
+/*
+ * Library read_scheduler type test program
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_read_scheduler.h"
+
+#if defined( __GNUC__ ) && defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* The media size is 950 and the chunk size 100, where chunk 7 cannot be read
+ */
+size_t ewf_test_read_scheduler_buffer_sizes[ 5 ] = {
+	300, 100, 100, 10, 250 };
+
+off64_t ewf_test_read_scheduler_offsets[ 5 ] = {
+	0, 650, 900, 1000, 50 };
+
+ssize_t ewf_test_read_scheduler_expected_read_counts[ 5 ] = {
+	300, -1, 50, 0, 250 };
+
+uint8_t ewf_test_read_scheduler_buffer[ 5 ][ 300 ];
+
+ssize_t ewf_test_read_scheduler_read_counts[ 5 ];
+
+/* Reads the data of a chunk where every byte contains the lower 8 bits of its (media) offset
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t ewf_test_read_scheduler_read_chunk(
+         intptr_t *data_handle EWF_TEST_ATTRIBUTE_UNUSED,
+         uint64_t chunk_index,
+         uint8_t *chunk_buffer,
+         size_t chunk_buffer_size EWF_TEST_ATTRIBUTE_UNUSED,
+         libcerror_error_t **error )
+{
+	static char *function = "ewf_test_read_scheduler_read_chunk";
+	size_t buffer_offset  = 0;
+	size_t read_size      = 100;
+
+	EWF_TEST_UNREFERENCED_PARAMETER( data_handle )
+	EWF_TEST_UNREFERENCED_PARAMETER( chunk_buffer_size )
+
+	if( chunk_index == 7 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk: %" PRIu64 ".",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	if( chunk_index == 9 )
+	{
+		read_size = 50;
+	}
+	for( buffer_offset = 0;
+	     buffer_offset < read_size;
+	     buffer_offset++ )
+	{
+		chunk_buffer[ buffer_offset ] = (uint8_t) ( ( chunk_index * 100 ) + buffer_offset );
+	}
+	return( (ssize_t) read_size );
+}
+
+/* Stores the read count of a completed read
+ */
+void ewf_test_read_scheduler_callback(
+      libewf_handle_t *handle EWF_TEST_ATTRIBUTE_UNUSED,
+      void *buffer EWF_TEST_ATTRIBUTE_UNUSED,
+      ssize_t read_count,
+      void *callback_data )
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( handle )
+	EWF_TEST_UNREFERENCED_PARAMETER( buffer )
+
+	*( (ssize_t *) callback_data ) = read_count;
+}
+
+/* Tests the libewf_read_scheduler_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_read_scheduler_initialize(
+     void )
+{
+	libcerror_error_t *error                = NULL;
+	libewf_read_scheduler_t *read_scheduler = NULL;
+	int result                              = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_read_scheduler_initialize(
+	          &read_scheduler,
+	          100,
+	          950,
+	          2,
+	          &ewf_test_read_scheduler_read_chunk,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "read_scheduler",
+	 read_scheduler );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_read_scheduler_free(
+	          &read_scheduler,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "read_scheduler",
+	 read_scheduler );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_read_scheduler_initialize(
+	          NULL,
+	          100,
+	          950,
+	          2,
+	          &ewf_test_read_scheduler_read_chunk,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_scheduler_initialize(
+	          &read_scheduler,
+	          0,
+	          950,
+	          2,
+	          &ewf_test_read_scheduler_read_chunk,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_scheduler_initialize(
+	          &read_scheduler,
+	          100,
+	          950,
+	          0,
+	          &ewf_test_read_scheduler_read_chunk,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_scheduler_initialize(
+	          &read_scheduler,
+	          100,
+	          950,
+	          2,
+	          NULL,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_scheduler != NULL )
+	{
+		libewf_read_scheduler_free(
+		 &read_scheduler,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_read_scheduler_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_read_scheduler_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_read_scheduler_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_read_scheduler_grab and libewf_read_scheduler_release functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_read_scheduler_grab(
+     void )
+{
+	libcerror_error_t *error                = NULL;
+	libewf_read_scheduler_t *read_scheduler = NULL;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_read_scheduler_initialize(
+	          &read_scheduler,
+	          100,
+	          950,
+	          1,
+	          &ewf_test_read_scheduler_read_chunk,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "read_scheduler",
+	 read_scheduler );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_read_scheduler_grab(
+	          read_scheduler,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "read_scheduler->number_of_users",
+	 read_scheduler->number_of_users,
+	 1 );
+
+	result = libewf_read_scheduler_release(
+	          read_scheduler,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "read_scheduler->number_of_users",
+	 read_scheduler->number_of_users,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libewf_read_scheduler_grab(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_scheduler_release(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test libewf_read_scheduler_release without a reference
+	 */
+	result = libewf_read_scheduler_release(
+	          read_scheduler,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_read_scheduler_free(
+	          &read_scheduler,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "read_scheduler",
+	 read_scheduler );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_scheduler != NULL )
+	{
+		libewf_read_scheduler_free(
+		 &read_scheduler,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_read_scheduler_submit function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_read_scheduler_submit(
+     void )
+{
+	libcerror_error_t *error                = NULL;
+	libewf_read_scheduler_t *read_scheduler = NULL;
+	size_t buffer_offset                    = 0;
+	int request_index                       = 0;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_read_scheduler_initialize(
+	          &read_scheduler,
+	          100,
+	          950,
+	          2,
+	          &ewf_test_read_scheduler_read_chunk,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "read_scheduler",
+	 read_scheduler );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( request_index = 0;
+	     request_index < 5;
+	     request_index++ )
+	{
+		ewf_test_read_scheduler_read_counts[ request_index ] = -2;
+
+		result = libewf_read_scheduler_submit(
+		          read_scheduler,
+		          NULL,
+		          ewf_test_read_scheduler_buffer[ request_index ],
+		          ewf_test_read_scheduler_buffer_sizes[ request_index ],
+		          ewf_test_read_scheduler_offsets[ request_index ],
+		          &ewf_test_read_scheduler_callback,
+		          (void *) &( ewf_test_read_scheduler_read_counts[ request_index ] ),
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libewf_read_scheduler_wait(
+	          read_scheduler,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( request_index = 0;
+	     request_index < 5;
+	     request_index++ )
+	{
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 ewf_test_read_scheduler_read_counts[ request_index ],
+		 ewf_test_read_scheduler_expected_read_counts[ request_index ] );
+
+		for( buffer_offset = 0;
+		     (ssize_t) buffer_offset < ewf_test_read_scheduler_read_counts[ request_index ];
+		     buffer_offset++ )
+		{
+			EWF_TEST_ASSERT_EQUAL_UINT8(
+			 "buffer",
+			 ewf_test_read_scheduler_buffer[ request_index ][ buffer_offset ],
+			 (uint8_t) ( ewf_test_read_scheduler_offsets[ request_index ] + buffer_offset ) );
+		}
+	}
+	/* Test error cases
+	 */
+	result = libewf_read_scheduler_submit(
+	          NULL,
+	          NULL,
+	          ewf_test_read_scheduler_buffer[ 0 ],
+	          100,
+	          0,
+	          &ewf_test_read_scheduler_callback,
+	          (void *) &( ewf_test_read_scheduler_read_counts[ 0 ] ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_scheduler_submit(
+	          read_scheduler,
+	          NULL,
+	          NULL,
+	          100,
+	          0,
+	          &ewf_test_read_scheduler_callback,
+	          (void *) &( ewf_test_read_scheduler_read_counts[ 0 ] ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_scheduler_submit(
+	          read_scheduler,
+	          NULL,
+	          ewf_test_read_scheduler_buffer[ 0 ],
+	          100,
+	          -1,
+	          &ewf_test_read_scheduler_callback,
+	          (void *) &( ewf_test_read_scheduler_read_counts[ 0 ] ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_scheduler_submit(
+	          read_scheduler,
+	          NULL,
+	          ewf_test_read_scheduler_buffer[ 0 ],
+	          100,
+	          0,
+	          NULL,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_read_scheduler_free(
+	          &read_scheduler,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "read_scheduler",
+	 read_scheduler );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_scheduler != NULL )
+	{
+		libewf_read_scheduler_free(
+		 &read_scheduler,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_read_scheduler_initialize",
+	 ewf_test_read_scheduler_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_read_scheduler_free",
+	 ewf_test_read_scheduler_free );
+
+	EWF_TEST_RUN(
+	 "libewf_read_scheduler_grab",
+	 ewf_test_read_scheduler_grab );
+
+	EWF_TEST_RUN(
+	 "libewf_read_scheduler_submit",
+	 ewf_test_read_scheduler_submit );
+
+	/* TODO: add tests for libewf_read_scheduler_process_job */
+
+#endif /* defined( __GNUC__ ) && defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
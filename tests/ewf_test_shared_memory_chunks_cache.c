@@ -0,0 +1,1543 @@
+/*
+ * Library shared_memory_chunks_cache type test program
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if !defined( WINAPI )
+#if defined( HAVE_SYS_MMAN_H )
+#include <sys/mman.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+#endif /* !defined( WINAPI ) */
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcthreads.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_checksum.h"
+#include "../libewf/libewf_shared_memory_chunks_cache.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && ( defined( WINAPI ) || ( defined( HAVE_SYS_MMAN_H ) && defined( HAVE_SHM_OPEN ) && defined( HAVE_MMAP ) && defined( HAVE_MUNMAP ) && defined( HAVE_FTRUNCATE ) && defined( HAVE_UNISTD_H ) ) )
+#define EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_HAVE_SHARED_MEMORY	1
+#endif
+
+#if defined( EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_HAVE_SHARED_MEMORY )
+
+/* The chunk size of the shared memory chunks cache
+ */
+#define EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE		512
+
+/* The number of times the chunk data is read during the racing write
+ */
+#define EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_NUMBER_OF_READS	20000
+
+/* The name of the shared memory, which is unique per process
+ */
+char ewf_test_shared_memory_chunks_cache_name[ 64 ];
+
+size_t ewf_test_shared_memory_chunks_cache_name_length = 0;
+
+/* Sets the name of the shared memory
+ */
+void ewf_test_shared_memory_chunks_cache_set_name(
+      void )
+{
+#if defined( WINAPI )
+	unsigned long process_identifier = (unsigned long) GetCurrentProcessId();
+#else
+	unsigned long process_identifier = (unsigned long) getpid();
+#endif
+
+	narrow_string_snprintf(
+	 ewf_test_shared_memory_chunks_cache_name,
+	 64,
+	 "/ewf_test_shared_memory_chunks_cache_%lu",
+	 process_identifier );
+
+	ewf_test_shared_memory_chunks_cache_name_length = narrow_string_length(
+	                                                   ewf_test_shared_memory_chunks_cache_name );
+}
+
+/* Removes the shared memory
+ * On Windows the shared memory is removed when the last handle is closed
+ */
+void ewf_test_shared_memory_chunks_cache_remove(
+      void )
+{
+#if !defined( WINAPI )
+	shm_unlink(
+	 ewf_test_shared_memory_chunks_cache_name );
+#endif
+}
+
+/* Sets the values of a key
+ */
+void ewf_test_shared_memory_chunks_cache_set_key(
+      libewf_shared_memory_chunks_cache_key_t *key,
+      uint32_t segment_file_index,
+      uint64_t chunk_data_size )
+{
+	memory_set(
+	 key,
+	 0,
+	 sizeof( libewf_shared_memory_chunks_cache_key_t ) );
+
+	memory_set(
+	 key->set_identifier,
+	 0xa5,
+	 16 );
+
+	key->media_size         = 64 * EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE;
+	key->chunk_data_offset  = 1024;
+	key->chunk_data_size    = chunk_data_size;
+	key->chunk_size         = EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE;
+	key->segment_file_index = segment_file_index;
+	key->chunk_data_flags   = 0;
+}
+
+/* Tests the libewf_shared_memory_chunks_cache_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_shared_memory_chunks_cache_initialize(
+     void )
+{
+	libcerror_error_t *error                                        = NULL;
+	libewf_shared_memory_chunks_cache_t *shared_memory_chunks_cache = NULL;
+	libewf_shared_memory_chunks_cache_t *second_chunks_cache        = NULL;
+	int result                                                      = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_shared_memory_chunks_cache_initialize(
+	          &shared_memory_chunks_cache,
+	          ewf_test_shared_memory_chunks_cache_name,
+	          ewf_test_shared_memory_chunks_cache_name_length,
+	          1024 * 1024,
+	          EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "shared_memory_chunks_cache",
+	 shared_memory_chunks_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test opening the shared memory created by another cache
+	 */
+	result = libewf_shared_memory_chunks_cache_initialize(
+	          &second_chunks_cache,
+	          ewf_test_shared_memory_chunks_cache_name,
+	          ewf_test_shared_memory_chunks_cache_name_length,
+	          1024 * 1024,
+	          EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "second_chunks_cache",
+	 second_chunks_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "second_chunks_cache->number_of_sets",
+	 second_chunks_cache->number_of_sets,
+	 shared_memory_chunks_cache->number_of_sets );
+
+	result = libewf_shared_memory_chunks_cache_free(
+	          &second_chunks_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "second_chunks_cache",
+	 second_chunks_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_shared_memory_chunks_cache_initialize(
+	          NULL,
+	          ewf_test_shared_memory_chunks_cache_name,
+	          ewf_test_shared_memory_chunks_cache_name_length,
+	          1024 * 1024,
+	          EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_shared_memory_chunks_cache_initialize(
+	          &shared_memory_chunks_cache,
+	          ewf_test_shared_memory_chunks_cache_name,
+	          ewf_test_shared_memory_chunks_cache_name_length,
+	          1024 * 1024,
+	          EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_shared_memory_chunks_cache_free(
+	          &shared_memory_chunks_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "shared_memory_chunks_cache",
+	 shared_memory_chunks_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_shared_memory_chunks_cache_initialize(
+	          &shared_memory_chunks_cache,
+	          NULL,
+	          ewf_test_shared_memory_chunks_cache_name_length,
+	          1024 * 1024,
+	          EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_shared_memory_chunks_cache_initialize(
+	          &shared_memory_chunks_cache,
+	          ewf_test_shared_memory_chunks_cache_name,
+	          0,
+	          1024 * 1024,
+	          EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_shared_memory_chunks_cache_initialize(
+	          &shared_memory_chunks_cache,
+	          ewf_test_shared_memory_chunks_cache_name,
+	          ewf_test_shared_memory_chunks_cache_name_length,
+	          1024 * 1024,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_shared_memory_chunks_cache_initialize(
+	          &shared_memory_chunks_cache,
+	          ewf_test_shared_memory_chunks_cache_name,
+	          ewf_test_shared_memory_chunks_cache_name_length,
+	          64,
+	          EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	ewf_test_shared_memory_chunks_cache_remove();
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( second_chunks_cache != NULL )
+	{
+		libewf_shared_memory_chunks_cache_free(
+		 &second_chunks_cache,
+		 NULL );
+	}
+	if( shared_memory_chunks_cache != NULL )
+	{
+		libewf_shared_memory_chunks_cache_free(
+		 &shared_memory_chunks_cache,
+		 NULL );
+	}
+	ewf_test_shared_memory_chunks_cache_remove();
+
+	return( 0 );
+}
+
+/* Tests the libewf_shared_memory_chunks_cache_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_shared_memory_chunks_cache_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_shared_memory_chunks_cache_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_shared_memory_chunks_cache_write_chunk and libewf_shared_memory_chunks_cache_read_chunk functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_shared_memory_chunks_cache_write_chunk(
+     void )
+{
+	libewf_shared_memory_chunks_cache_key_t key;
+	uint8_t buffer[ EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE ];
+	uint8_t data[ EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE ];
+
+	libcerror_error_t *error                                        = NULL;
+	libewf_shared_memory_chunks_cache_t *shared_memory_chunks_cache = NULL;
+	size_t data_index                                               = 0;
+	ssize_t read_count                                              = 0;
+	int result                                                      = 0;
+
+	/* Initialize test
+	 */
+	for( data_index = 0;
+	     data_index < EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE;
+	     data_index++ )
+	{
+		data[ data_index ] = (uint8_t) ( data_index % 251 );
+	}
+	ewf_test_shared_memory_chunks_cache_set_key(
+	 &key,
+	 1,
+	 300 );
+
+	result = libewf_shared_memory_chunks_cache_initialize(
+	          &shared_memory_chunks_cache,
+	          ewf_test_shared_memory_chunks_cache_name,
+	          ewf_test_shared_memory_chunks_cache_name_length,
+	          1024 * 1024,
+	          EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "shared_memory_chunks_cache",
+	 shared_memory_chunks_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_shared_memory_chunks_cache_write_chunk(
+	          shared_memory_chunks_cache,
+	          &key,
+	          3,
+	          data,
+	          EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libewf_shared_memory_chunks_cache_read_chunk(
+	              shared_memory_chunks_cache,
+	              &key,
+	              3,
+	              0,
+	              buffer,
+	              EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          data,
+	          EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test reading part of the chunk data
+	 */
+	read_count = libewf_shared_memory_chunks_cache_read_chunk(
+	              shared_memory_chunks_cache,
+	              &key,
+	              3,
+	              100,
+	              buffer,
+	              20,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 20 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          &( data[ 100 ] ),
+	          20 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test reading up to the end of the chunk data
+	 */
+	read_count = libewf_shared_memory_chunks_cache_read_chunk(
+	              shared_memory_chunks_cache,
+	              &key,
+	              3,
+	              EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE - 12,
+	              buffer,
+	              EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 12 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test writing a chunk that is already cached
+	 */
+	result = libewf_shared_memory_chunks_cache_write_chunk(
+	          shared_memory_chunks_cache,
+	          &key,
+	          3,
+	          data,
+	          EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test writing a chunk that is larger than a slot
+	 */
+	result = libewf_shared_memory_chunks_cache_write_chunk(
+	          shared_memory_chunks_cache,
+	          &key,
+	          4,
+	          data,
+	          EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE + 1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_shared_memory_chunks_cache_write_chunk(
+	          NULL,
+	          &key,
+	          3,
+	          data,
+	          EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_shared_memory_chunks_cache_write_chunk(
+	          shared_memory_chunks_cache,
+	          NULL,
+	          3,
+	          data,
+	          EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_shared_memory_chunks_cache_write_chunk(
+	          shared_memory_chunks_cache,
+	          &key,
+	          3,
+	          NULL,
+	          EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_shared_memory_chunks_cache_read_chunk(
+	              NULL,
+	              &key,
+	              3,
+	              0,
+	              buffer,
+	              EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_shared_memory_chunks_cache_read_chunk(
+	              shared_memory_chunks_cache,
+	              NULL,
+	              3,
+	              0,
+	              buffer,
+	              EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_shared_memory_chunks_cache_read_chunk(
+	              shared_memory_chunks_cache,
+	              &key,
+	              3,
+	              0,
+	              NULL,
+	              EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_shared_memory_chunks_cache_read_chunk(
+	              shared_memory_chunks_cache,
+	              &key,
+	              3,
+	              0,
+	              buffer,
+	              (size_t) SSIZE_MAX + 1,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_shared_memory_chunks_cache_free(
+	          &shared_memory_chunks_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "shared_memory_chunks_cache",
+	 shared_memory_chunks_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	ewf_test_shared_memory_chunks_cache_remove();
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( shared_memory_chunks_cache != NULL )
+	{
+		libewf_shared_memory_chunks_cache_free(
+		 &shared_memory_chunks_cache,
+		 NULL );
+	}
+	ewf_test_shared_memory_chunks_cache_remove();
+
+	return( 0 );
+}
+
+/* Tests the libewf_shared_memory_chunks_cache_read_chunk function with chunks that are not cached
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_shared_memory_chunks_cache_read_chunk(
+     void )
+{
+	libewf_shared_memory_chunks_cache_key_t key;
+	libewf_shared_memory_chunks_cache_key_t other_key;
+	uint8_t buffer[ EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE ];
+	uint8_t data[ EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE ];
+
+	libcerror_error_t *error                                        = NULL;
+	libewf_shared_memory_chunks_cache_slot_t *slot                  = NULL;
+	libewf_shared_memory_chunks_cache_t *shared_memory_chunks_cache = NULL;
+	uint8_t *slot_data                                              = NULL;
+	ssize_t read_count                                              = 0;
+	uint32_t set_index                                              = 0;
+	int result                                                      = 0;
+	int way_index                                                   = 0;
+
+	/* Initialize test
+	 */
+	memory_set(
+	 data,
+	 'A',
+	 EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE );
+
+	ewf_test_shared_memory_chunks_cache_set_key(
+	 &key,
+	 1,
+	 300 );
+
+	result = libewf_shared_memory_chunks_cache_initialize(
+	          &shared_memory_chunks_cache,
+	          ewf_test_shared_memory_chunks_cache_name,
+	          ewf_test_shared_memory_chunks_cache_name_length,
+	          1024 * 1024,
+	          EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "shared_memory_chunks_cache",
+	 shared_memory_chunks_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test reading a chunk from an empty cache
+	 */
+	read_count = libewf_shared_memory_chunks_cache_read_chunk(
+	              shared_memory_chunks_cache,
+	              &key,
+	              5,
+	              0,
+	              buffer,
+	              EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_shared_memory_chunks_cache_write_chunk(
+	          shared_memory_chunks_cache,
+	          &key,
+	          5,
+	          data,
+	          EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test reading another chunk
+	 */
+	read_count = libewf_shared_memory_chunks_cache_read_chunk(
+	              shared_memory_chunks_cache,
+	              &key,
+	              6,
+	              0,
+	              buffer,
+	              EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test reading the chunk of an image with the same segment file set identifier
+	 * but a different size of the stored chunk data
+	 */
+	ewf_test_shared_memory_chunks_cache_set_key(
+	 &other_key,
+	 1,
+	 412 );
+
+	read_count = libewf_shared_memory_chunks_cache_read_chunk(
+	              shared_memory_chunks_cache,
+	              &other_key,
+	              5,
+	              0,
+	              buffer,
+	              EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test reading the chunk of an image with the same segment file set identifier
+	 * and stored chunk data size but stored in another segment file
+	 */
+	ewf_test_shared_memory_chunks_cache_set_key(
+	 &other_key,
+	 2,
+	 300 );
+
+	read_count = libewf_shared_memory_chunks_cache_read_chunk(
+	              shared_memory_chunks_cache,
+	              &other_key,
+	              5,
+	              0,
+	              buffer,
+	              EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	ewf_test_shared_memory_chunks_cache_set_key(
+	 &other_key,
+	 1,
+	 300 );
+
+	other_key.chunk_data_offset += 512;
+
+	read_count = libewf_shared_memory_chunks_cache_read_chunk(
+	              shared_memory_chunks_cache,
+	              &other_key,
+	              5,
+	              0,
+	              buffer,
+	              EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test reading beyond the end of the chunk data
+	 */
+	read_count = libewf_shared_memory_chunks_cache_read_chunk(
+	              shared_memory_chunks_cache,
+	              &key,
+	              5,
+	              EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE,
+	              buffer,
+	              EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test reading a chunk of which the data in the slot does not match its checksum
+	 */
+	key.chunk_index = 5;
+
+	set_index = libewf_shared_memory_chunks_cache_get_set_index(
+	             shared_memory_chunks_cache,
+	             &key );
+
+	for( way_index = 0;
+	     way_index < LIBEWF_SHARED_MEMORY_CHUNKS_CACHE_NUMBER_OF_WAYS;
+	     way_index++ )
+	{
+		slot = libewf_shared_memory_chunks_cache_get_slot(
+		        shared_memory_chunks_cache,
+		        set_index,
+		        way_index );
+
+		if( memory_compare(
+		     &( slot->key ),
+		     &key,
+		     sizeof( libewf_shared_memory_chunks_cache_key_t ) ) == 0 )
+		{
+			break;
+		}
+		slot = NULL;
+	}
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "slot",
+	 slot );
+
+	slot_data = &( ( (uint8_t *) slot )[ sizeof( libewf_shared_memory_chunks_cache_slot_t ) ] );
+
+	slot_data[ 200 ] = 'B';
+
+	read_count = libewf_shared_memory_chunks_cache_read_chunk(
+	              shared_memory_chunks_cache,
+	              &key,
+	              5,
+	              0,
+	              buffer,
+	              EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test reading a chunk of which the slot is being written
+	 */
+	slot_data[ 200 ] = 'A';
+
+	slot->sequence_number += 1;
+
+	read_count = libewf_shared_memory_chunks_cache_read_chunk(
+	              shared_memory_chunks_cache,
+	              &key,
+	              5,
+	              0,
+	              buffer,
+	              EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	slot->sequence_number += 1;
+
+	read_count = libewf_shared_memory_chunks_cache_read_chunk(
+	              shared_memory_chunks_cache,
+	              &key,
+	              5,
+	              0,
+	              buffer,
+	              EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_CHUNK_SIZE );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libewf_shared_memory_chunks_cache_free(
+	          &shared_memory_chunks_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "shared_memory_chunks_cache",
+	 shared_memory_chunks_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	ewf_test_shared_memory_chunks_cache_remove();
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( shared_memory_chunks_cache != NULL )
+	{
+		libewf_shared_memory_chunks_cache_free(
+		 &shared_memory_chunks_cache,
+		 NULL );
+	}
+	ewf_test_shared_memory_chunks_cache_remove();
+
+	return( 0 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBEWF )
+
+/* The chunk size of the shared memory chunks cache used by the racing write,
+ * which is large so that the racing write is likely to overlap with a read
+ */
+#define EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_RACING_CHUNK_SIZE	32768
+
+/* The buffers of the racing write test
+ */
+uint8_t ewf_test_shared_memory_chunks_cache_racing_buffer[ EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_RACING_CHUNK_SIZE ];
+
+uint8_t ewf_test_shared_memory_chunks_cache_racing_data[ EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_RACING_CHUNK_SIZE ];
+
+/* The slot that is written by the racing write
+ */
+libewf_shared_memory_chunks_cache_slot_t *ewf_test_shared_memory_chunks_cache_racing_slot = NULL;
+
+/* The checksums of the chunk data that is written by the racing write
+ */
+uint32_t ewf_test_shared_memory_chunks_cache_racing_checksums[ 2 ];
+
+/* The number of times the racing write replaced the chunk data
+ */
+volatile int ewf_test_shared_memory_chunks_cache_racing_number_of_writes = 0;
+
+/* Value to indicate the racing write should stop
+ */
+volatile int ewf_test_shared_memory_chunks_cache_racing_write_stop = 0;
+
+/* Replaces the chunk data in the slot by alternately all 'B' and all 'A' bytes until stopped
+ * using the same protocol as libewf_shared_memory_chunks_cache_write_chunk
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_shared_memory_chunks_cache_racing_write(
+     void *arguments EWF_TEST_ATTRIBUTE_UNUSED )
+{
+	libewf_shared_memory_chunks_cache_slot_t *slot = ewf_test_shared_memory_chunks_cache_racing_slot;
+	uint8_t *slot_data                             = NULL;
+	volatile int delay_index                       = 0;
+	int write_index                                = 0;
+
+	EWF_TEST_UNREFERENCED_PARAMETER( arguments )
+
+	slot_data = &( ( (uint8_t *) slot )[ sizeof( libewf_shared_memory_chunks_cache_slot_t ) ] );
+
+	while( ewf_test_shared_memory_chunks_cache_racing_write_stop == 0 )
+	{
+		slot->sequence_number += 1;
+
+		__sync_synchronize();
+
+		slot->checksum = ewf_test_shared_memory_chunks_cache_racing_checksums[ write_index % 2 ];
+
+		memory_set(
+		 slot_data,
+		 ( write_index % 2 ) == 0 ? 'B' : 'A',
+		 EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_RACING_CHUNK_SIZE );
+
+		__sync_synchronize();
+
+		slot->sequence_number += 1;
+
+		write_index++;
+
+		ewf_test_shared_memory_chunks_cache_racing_number_of_writes = write_index;
+
+		/* Leave the slot unchanged for a while so that reads can succeed
+		 */
+		for( delay_index = 0;
+		     delay_index < 10000;
+		     delay_index++ )
+		{
+		}
+	}
+
+	return( 1 );
+}
+
+/* Tests the libewf_shared_memory_chunks_cache_read_chunk function with a racing write
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_shared_memory_chunks_cache_read_chunk_with_racing_write(
+     void )
+{
+	libewf_shared_memory_chunks_cache_key_t key;
+
+	libcerror_error_t *error                                        = NULL;
+	uint8_t *buffer                                                 = ewf_test_shared_memory_chunks_cache_racing_buffer;
+	uint8_t *data                                                   = ewf_test_shared_memory_chunks_cache_racing_data;
+	libcthreads_thread_t *thread                                    = NULL;
+	libewf_shared_memory_chunks_cache_t *shared_memory_chunks_cache = NULL;
+	size_t data_index                                               = 0;
+	ssize_t read_count                                              = 0;
+	uint32_t set_index                                              = 0;
+	int number_of_torn_reads                                        = 0;
+	int read_index                                                  = 0;
+	int result                                                      = 0;
+	int way_index                                                   = 0;
+
+	/* Initialize test
+	 */
+	memory_set(
+	 data,
+	 'B',
+	 EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_RACING_CHUNK_SIZE );
+
+	result = libewf_checksum_calculate_adler32(
+	          &( ewf_test_shared_memory_chunks_cache_racing_checksums[ 0 ] ),
+	          data,
+	          EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_RACING_CHUNK_SIZE,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	memory_set(
+	 data,
+	 'A',
+	 EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_RACING_CHUNK_SIZE );
+
+	result = libewf_checksum_calculate_adler32(
+	          &( ewf_test_shared_memory_chunks_cache_racing_checksums[ 1 ] ),
+	          data,
+	          EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_RACING_CHUNK_SIZE,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	ewf_test_shared_memory_chunks_cache_set_key(
+	 &key,
+	 1,
+	 300 );
+
+	result = libewf_shared_memory_chunks_cache_initialize(
+	          &shared_memory_chunks_cache,
+	          ewf_test_shared_memory_chunks_cache_name,
+	          ewf_test_shared_memory_chunks_cache_name_length,
+	          4 * 1024 * 1024,
+	          EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_RACING_CHUNK_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_shared_memory_chunks_cache_write_chunk(
+	          shared_memory_chunks_cache,
+	          &key,
+	          7,
+	          data,
+	          EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_RACING_CHUNK_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	key.chunk_index = 7;
+
+	set_index = libewf_shared_memory_chunks_cache_get_set_index(
+	             shared_memory_chunks_cache,
+	             &key );
+
+	for( way_index = 0;
+	     way_index < LIBEWF_SHARED_MEMORY_CHUNKS_CACHE_NUMBER_OF_WAYS;
+	     way_index++ )
+	{
+		ewf_test_shared_memory_chunks_cache_racing_slot = libewf_shared_memory_chunks_cache_get_slot(
+		                                                   shared_memory_chunks_cache,
+		                                                   set_index,
+		                                                   way_index );
+
+		if( memory_compare(
+		     &( ewf_test_shared_memory_chunks_cache_racing_slot->key ),
+		     &key,
+		     sizeof( libewf_shared_memory_chunks_cache_key_t ) ) == 0 )
+		{
+			break;
+		}
+		ewf_test_shared_memory_chunks_cache_racing_slot = NULL;
+	}
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "ewf_test_shared_memory_chunks_cache_racing_slot",
+	 ewf_test_shared_memory_chunks_cache_racing_slot );
+
+	ewf_test_shared_memory_chunks_cache_racing_number_of_writes = 0;
+	ewf_test_shared_memory_chunks_cache_racing_write_stop       = 0;
+
+	/* Test regular cases
+	 */
+	result = libcthreads_thread_create(
+	          &thread,
+	          NULL,
+	          (int (*)(void *)) &ewf_test_shared_memory_chunks_cache_racing_write,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	while( ewf_test_shared_memory_chunks_cache_racing_number_of_writes == 0 )
+	{
+	}
+	/* Every read either misses or returns the chunk data of a single write
+	 */
+	for( read_index = 0;
+	     read_index < EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_NUMBER_OF_READS;
+	     read_index++ )
+	{
+		read_count = libewf_shared_memory_chunks_cache_read_chunk(
+		              shared_memory_chunks_cache,
+		              &key,
+		              7,
+		              0,
+		              buffer,
+		              EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_RACING_CHUNK_SIZE,
+		              &error );
+
+		if( read_count == 0 )
+		{
+			continue;
+		}
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_RACING_CHUNK_SIZE );
+
+		for( data_index = 1;
+		     data_index < EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_RACING_CHUNK_SIZE;
+		     data_index++ )
+		{
+			if( buffer[ data_index ] != buffer[ 0 ] )
+			{
+				number_of_torn_reads++;
+
+				break;
+			}
+		}
+	}
+	ewf_test_shared_memory_chunks_cache_racing_write_stop = 1;
+
+	result = libcthreads_thread_join(
+	          &thread,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_torn_reads",
+	 number_of_torn_reads,
+	 0 );
+
+	/* The chunk data of the last write is read after the racing write has stopped
+	 */
+	read_count = libewf_shared_memory_chunks_cache_read_chunk(
+	              shared_memory_chunks_cache,
+	              &key,
+	              7,
+	              0,
+	              buffer,
+	              EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_RACING_CHUNK_SIZE,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_RACING_CHUNK_SIZE );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( data_index = 1;
+	     data_index < EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_RACING_CHUNK_SIZE;
+	     data_index++ )
+	{
+		if( buffer[ data_index ] != buffer[ 0 ] )
+		{
+			break;
+		}
+	}
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "data_index",
+	 data_index,
+	 (size_t) EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_RACING_CHUNK_SIZE );
+
+	/* Clean up
+	 */
+	result = libewf_shared_memory_chunks_cache_free(
+	          &shared_memory_chunks_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	ewf_test_shared_memory_chunks_cache_remove();
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( thread != NULL )
+	{
+		ewf_test_shared_memory_chunks_cache_racing_write_stop = 1;
+
+		libcthreads_thread_join(
+		 &thread,
+		 NULL );
+	}
+	if( shared_memory_chunks_cache != NULL )
+	{
+		libewf_shared_memory_chunks_cache_free(
+		 &shared_memory_chunks_cache,
+		 NULL );
+	}
+	ewf_test_shared_memory_chunks_cache_remove();
+
+	return( 0 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBEWF ) */
+
+#endif /* defined( EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_HAVE_SHARED_MEMORY ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_HAVE_SHARED_MEMORY )
+
+	ewf_test_shared_memory_chunks_cache_set_name();
+
+	/* Remove shared memory left behind by a previous run
+	 */
+	ewf_test_shared_memory_chunks_cache_remove();
+
+	EWF_TEST_RUN(
+	 "libewf_shared_memory_chunks_cache_initialize",
+	 ewf_test_shared_memory_chunks_cache_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_shared_memory_chunks_cache_free",
+	 ewf_test_shared_memory_chunks_cache_free );
+
+	EWF_TEST_RUN(
+	 "libewf_shared_memory_chunks_cache_write_chunk",
+	 ewf_test_shared_memory_chunks_cache_write_chunk );
+
+	EWF_TEST_RUN(
+	 "libewf_shared_memory_chunks_cache_read_chunk",
+	 ewf_test_shared_memory_chunks_cache_read_chunk );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBEWF )
+
+	EWF_TEST_RUN(
+	 "libewf_shared_memory_chunks_cache_read_chunk with racing write",
+	 ewf_test_shared_memory_chunks_cache_read_chunk_with_racing_write );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBEWF ) */
+
+#endif /* defined( EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_HAVE_SHARED_MEMORY ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( EWF_TEST_SHARED_MEMORY_CHUNKS_CACHE_HAVE_SHARED_MEMORY )
+on_error:
+	return( EXIT_FAILURE );
+#endif
+}
+
@@ -0,0 +1,1429 @@
+/*
+ * Library single_file_name_index type test program
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_libcdata.h"
+#include "../libewf/libewf_single_file_entry.h"
+#include "../libewf/libewf_single_file_name_index.h"
+#include "../libewf/libewf_single_file_tree.h"
+
+#if defined( __GNUC__ )
+
+/* The names of the sub nodes, where:
+ * file368889 and file1855780 have the same hash
+ * file7 is stored twice
+ * NULL represents a sub node without a name
+ */
+const char *ewf_test_single_file_name_index_sub_node_names[ 40 ] = {
+	"file0", "file1", "file2", "file3", "file4", "file5", "file6", "file7",
+	"file8", "file9", "file10", "file11", "file12", "file13", "file14", "file15",
+	"file16", "file17", "file18", "file19", "file20", "file21", "file22", "file23",
+	"file24", "file25", "file26", "file27", "file28", "file29", "file30", "file31",
+	"file368889", "file1855780", "file368888", "file7", NULL, "\xc3\xa9t\xc3\xa9",
+	"file32", "file33" };
+
+/* The names that are not stored, where file1855781 has the same hash as file368888
+ */
+const char *ewf_test_single_file_name_index_missing_names[ 5 ] = {
+	"file1855781", "file34", "FILE0", "file", "file00" };
+
+/* Creates a single file entry tree node with sub nodes of the test names
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_single_file_name_index_create_tree(
+     libcdata_tree_node_t **node,
+     libcerror_error_t **error )
+{
+	libewf_single_file_entry_t *single_file_entry = NULL;
+	static char *function                         = "ewf_test_single_file_name_index_create_tree";
+	size_t name_size                              = 0;
+	int name_index                                = 0;
+
+	if( libcdata_tree_node_initialize(
+	     node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create node.",
+		 function );
+
+		goto on_error;
+	}
+	for( name_index = 0;
+	     name_index < 40;
+	     name_index++ )
+	{
+		if( libewf_single_file_entry_initialize(
+		     &single_file_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create single file entry: %d.",
+			 function,
+			 name_index );
+
+			goto on_error;
+		}
+		if( ewf_test_single_file_name_index_sub_node_names[ name_index ] != NULL )
+		{
+			name_size = narrow_string_length(
+			             ewf_test_single_file_name_index_sub_node_names[ name_index ] ) + 1;
+
+			single_file_entry->name = (uint8_t *) memory_allocate(
+			                                       sizeof( uint8_t ) * name_size );
+
+			if( single_file_entry->name == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create name: %d.",
+				 function,
+				 name_index );
+
+				goto on_error;
+			}
+			if( memory_copy(
+			     single_file_entry->name,
+			     ewf_test_single_file_name_index_sub_node_names[ name_index ],
+			     name_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy name: %d.",
+				 function,
+				 name_index );
+
+				goto on_error;
+			}
+			single_file_entry->name_size = name_size;
+		}
+		if( libcdata_tree_node_append_value(
+		     *node,
+		     (intptr_t *) single_file_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append single file entry: %d.",
+			 function,
+			 name_index );
+
+			goto on_error;
+		}
+		single_file_entry = NULL;
+	}
+	return( 1 );
+
+on_error:
+	if( single_file_entry != NULL )
+	{
+		libewf_single_file_entry_free(
+		 &single_file_entry,
+		 NULL );
+	}
+	if( *node != NULL )
+	{
+		libcdata_tree_node_free(
+		 node,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_single_file_entry_free,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Copies an UTF-8 string of 1 and 2 byte sequences to an UTF-16 string
+ * Returns the number of UTF-16 characters
+ */
+size_t ewf_test_single_file_name_index_copy_to_utf16(
+     const char *utf8_string,
+     uint16_t *utf16_string )
+{
+	const uint8_t *utf8_stream = (const uint8_t *) utf8_string;
+	size_t utf16_string_index  = 0;
+	size_t utf8_string_index   = 0;
+
+	while( utf8_stream[ utf8_string_index ] != 0 )
+	{
+		if( utf8_stream[ utf8_string_index ] < 0x80 )
+		{
+			utf16_string[ utf16_string_index ] = utf8_stream[ utf8_string_index ];
+
+			utf8_string_index += 1;
+		}
+		else
+		{
+			utf16_string[ utf16_string_index ] = (uint16_t) ( ( utf8_stream[ utf8_string_index ] & 0x1f ) << 6 )
+			                                   | (uint16_t) ( utf8_stream[ utf8_string_index + 1 ] & 0x3f );
+
+			utf8_string_index += 2;
+		}
+		utf16_string_index += 1;
+	}
+	return( utf16_string_index );
+}
+
+/* Tests the libewf_single_file_name_index_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_single_file_name_index_initialize(
+     void )
+{
+	libcerror_error_t *error                    = NULL;
+	libewf_single_file_name_index_t *name_index = NULL;
+	int result                                  = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests             = 3;
+	int number_of_memset_fail_tests             = 2;
+	int test_number                             = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libewf_single_file_name_index_initialize(
+	          &name_index,
+	          100,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "name_index",
+	 name_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "name_index->number_of_buckets",
+	 name_index->number_of_buckets,
+	 (uint32_t) 256 );
+
+	result = libewf_single_file_name_index_free(
+	          &name_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "name_index",
+	 name_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_single_file_name_index_initialize(
+	          NULL,
+	          100,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	name_index = (libewf_single_file_name_index_t *) 0x12345678UL;
+
+	result = libewf_single_file_name_index_initialize(
+	          &name_index,
+	          100,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	name_index = NULL;
+
+	result = libewf_single_file_name_index_initialize(
+	          &name_index,
+	          -1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_single_file_name_index_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_single_file_name_index_initialize(
+		          &name_index,
+		          100,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( name_index != NULL )
+			{
+				libewf_single_file_name_index_free(
+				 &name_index,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "name_index",
+			 name_index );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_single_file_name_index_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_single_file_name_index_initialize(
+		          &name_index,
+		          100,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( name_index != NULL )
+			{
+				libewf_single_file_name_index_free(
+				 &name_index,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "name_index",
+			 name_index );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( name_index != NULL )
+	{
+		libewf_single_file_name_index_free(
+		 &name_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_single_file_name_index_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_single_file_name_index_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_single_file_name_index_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_single_file_name_index_get_utf8_string_hash and
+ * libewf_single_file_name_index_get_utf16_string_hash functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_single_file_name_index_get_string_hash(
+     void )
+{
+	uint8_t utf8_string[ 8 ]   = { 'F', 'i', 'l', 'e', 0xc3, 0xa9, 0, 0 };
+	uint16_t utf16_string[ 6 ] = { 'F', 'i', 'l', 'e', 0x00e9, 0 };
+	libcerror_error_t *error   = NULL;
+	uint32_t other_hash        = 0;
+	uint32_t utf16_hash        = 0;
+	uint32_t utf8_hash         = 0;
+	int result                 = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_single_file_name_index_get_utf8_string_hash(
+	          utf8_string,
+	          6,
+	          &utf8_hash,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_single_file_name_index_get_utf16_string_hash(
+	          utf16_string,
+	          5,
+	          &utf16_hash,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "utf16_hash",
+	 utf16_hash,
+	 utf8_hash );
+
+	/* Test that the end-of-string character is ignored
+	 */
+	result = libewf_single_file_name_index_get_utf8_string_hash(
+	          utf8_string,
+	          8,
+	          &other_hash,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "other_hash",
+	 other_hash,
+	 utf8_hash );
+
+	/* Test error cases
+	 */
+	result = libewf_single_file_name_index_get_utf8_string_hash(
+	          NULL,
+	          6,
+	          &utf8_hash,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_single_file_name_index_get_utf8_string_hash(
+	          utf8_string,
+	          6,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_single_file_name_index_get_utf16_string_hash(
+	          NULL,
+	          5,
+	          &utf16_hash,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_single_file_name_index_build function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_single_file_name_index_build(
+     void )
+{
+	libcdata_tree_node_t *node                  = NULL;
+	libcerror_error_t *error                    = NULL;
+	libewf_single_file_name_index_t *name_index = NULL;
+	uint32_t bucket_index                       = 0;
+	int number_of_used_buckets                  = 0;
+	int result                                  = 0;
+
+	/* Initialize test
+	 */
+	result = ewf_test_single_file_name_index_create_tree(
+	          &node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "node",
+	 node );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_single_file_name_index_initialize(
+	          &name_index,
+	          40,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_single_file_name_index_build(
+	          name_index,
+	          node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Every sub node with a name is stored in a bucket
+	 */
+	for( bucket_index = 0;
+	     bucket_index < name_index->number_of_buckets;
+	     bucket_index++ )
+	{
+		if( name_index->sub_nodes[ bucket_index ] != NULL )
+		{
+			number_of_used_buckets++;
+		}
+	}
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_used_buckets",
+	 number_of_used_buckets,
+	 39 );
+
+	result = libewf_single_file_name_index_free(
+	          &name_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_single_file_name_index_initialize(
+	          &name_index,
+	          10,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_single_file_name_index_build(
+	          NULL,
+	          node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_single_file_name_index_build(
+	          name_index,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* The name index is too small for the number of sub nodes
+	 */
+	result = libewf_single_file_name_index_build(
+	          name_index,
+	          node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_single_file_name_index_free(
+	          &name_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_tree_node_free(
+	          &node,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libewf_single_file_entry_free,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( name_index != NULL )
+	{
+		libewf_single_file_name_index_free(
+		 &name_index,
+		 NULL );
+	}
+	if( node != NULL )
+	{
+		libcdata_tree_node_free(
+		 &node,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_single_file_entry_free,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_single_file_name_index_get_sub_node_by_utf8_name function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_single_file_name_index_get_sub_node_by_utf8_name(
+     void )
+{
+	libcdata_tree_node_t *index_sub_node              = NULL;
+	libcdata_tree_node_t *node                        = NULL;
+	libcdata_tree_node_t *tree_sub_node               = NULL;
+	libcerror_error_t *error                          = NULL;
+	libewf_single_file_entry_t *sub_single_file_entry = NULL;
+	libewf_single_file_name_index_t *name_index       = NULL;
+	const uint8_t *string                             = NULL;
+	size_t string_length                              = 0;
+	int string_index                                  = 0;
+	int result                                        = 0;
+	int tree_result                                   = 0;
+
+	/* Initialize test
+	 */
+	result = ewf_test_single_file_name_index_create_tree(
+	          &node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_single_file_name_index_initialize(
+	          &name_index,
+	          40,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_single_file_name_index_build(
+	          name_index,
+	          node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 * The lookups by means of the name index must match the linear search of the tree
+	 */
+	for( string_index = 0;
+	     string_index < 40;
+	     string_index++ )
+	{
+		if( ewf_test_single_file_name_index_sub_node_names[ string_index ] == NULL )
+		{
+			continue;
+		}
+		string        = (const uint8_t *) ewf_test_single_file_name_index_sub_node_names[ string_index ];
+		string_length = narrow_string_length(
+		                 ewf_test_single_file_name_index_sub_node_names[ string_index ] );
+
+		result = libewf_single_file_name_index_get_sub_node_by_utf8_name(
+		          name_index,
+		          string,
+		          string_length,
+		          &index_sub_node,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		tree_result = libewf_single_file_tree_get_sub_node_by_utf8_name(
+		               node,
+		               string,
+		               string_length,
+		               &tree_sub_node,
+		               &sub_single_file_entry,
+		               &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "tree_result",
+		 tree_result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = ( index_sub_node == tree_sub_node );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+	}
+	for( string_index = 0;
+	     string_index < 5;
+	     string_index++ )
+	{
+		string        = (const uint8_t *) ewf_test_single_file_name_index_missing_names[ string_index ];
+		string_length = narrow_string_length(
+		                 ewf_test_single_file_name_index_missing_names[ string_index ] );
+
+		result = libewf_single_file_name_index_get_sub_node_by_utf8_name(
+		          name_index,
+		          string,
+		          string_length,
+		          &index_sub_node,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "index_sub_node",
+		 index_sub_node );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		tree_result = libewf_single_file_tree_get_sub_node_by_utf8_name(
+		               node,
+		               string,
+		               string_length,
+		               &tree_sub_node,
+		               &sub_single_file_entry,
+		               &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "tree_result",
+		 tree_result,
+		 0 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	string        = (const uint8_t *) ewf_test_single_file_name_index_sub_node_names[ 0 ];
+	string_length = narrow_string_length(
+	                 ewf_test_single_file_name_index_sub_node_names[ 0 ] );
+
+	result = libewf_single_file_name_index_get_sub_node_by_utf8_name(
+	          NULL,
+	          string,
+	          string_length,
+	          &index_sub_node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_single_file_name_index_get_sub_node_by_utf8_name(
+	          name_index,
+	          NULL,
+	          string_length,
+	          &index_sub_node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_single_file_name_index_get_sub_node_by_utf8_name(
+	          name_index,
+	          string,
+	          string_length,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_single_file_name_index_free(
+	          &name_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_tree_node_free(
+	          &node,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libewf_single_file_entry_free,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( name_index != NULL )
+	{
+		libewf_single_file_name_index_free(
+		 &name_index,
+		 NULL );
+	}
+	if( node != NULL )
+	{
+		libcdata_tree_node_free(
+		 &node,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_single_file_entry_free,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_single_file_name_index_get_sub_node_by_utf16_name function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_single_file_name_index_get_sub_node_by_utf16_name(
+     void )
+{
+	uint16_t string[ 16 ];
+
+	libcdata_tree_node_t *index_sub_node              = NULL;
+	libcdata_tree_node_t *node                        = NULL;
+	libcdata_tree_node_t *tree_sub_node               = NULL;
+	libcerror_error_t *error                          = NULL;
+	libewf_single_file_entry_t *sub_single_file_entry = NULL;
+	libewf_single_file_name_index_t *name_index       = NULL;
+	size_t string_length                              = 0;
+	int string_index                                  = 0;
+	int result                                        = 0;
+	int tree_result                                   = 0;
+
+	/* Initialize test
+	 */
+	result = ewf_test_single_file_name_index_create_tree(
+	          &node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_single_file_name_index_initialize(
+	          &name_index,
+	          40,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_single_file_name_index_build(
+	          name_index,
+	          node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 * The lookups by means of the name index must match the linear search of the tree
+	 */
+	for( string_index = 0;
+	     string_index < 40;
+	     string_index++ )
+	{
+		if( ewf_test_single_file_name_index_sub_node_names[ string_index ] == NULL )
+		{
+			continue;
+		}
+		string_length = ewf_test_single_file_name_index_copy_to_utf16(
+		                 ewf_test_single_file_name_index_sub_node_names[ string_index ],
+		                 string );
+
+		result = libewf_single_file_name_index_get_sub_node_by_utf16_name(
+		          name_index,
+		          string,
+		          string_length,
+		          &index_sub_node,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		tree_result = libewf_single_file_tree_get_sub_node_by_utf16_name(
+		               node,
+		               string,
+		               string_length,
+		               &tree_sub_node,
+		               &sub_single_file_entry,
+		               &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "tree_result",
+		 tree_result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = ( index_sub_node == tree_sub_node );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+	}
+	for( string_index = 0;
+	     string_index < 5;
+	     string_index++ )
+	{
+		string_length = ewf_test_single_file_name_index_copy_to_utf16(
+		                 ewf_test_single_file_name_index_missing_names[ string_index ],
+		                 string );
+
+		result = libewf_single_file_name_index_get_sub_node_by_utf16_name(
+		          name_index,
+		          string,
+		          string_length,
+		          &index_sub_node,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "index_sub_node",
+		 index_sub_node );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		tree_result = libewf_single_file_tree_get_sub_node_by_utf16_name(
+		               node,
+		               string,
+		               string_length,
+		               &tree_sub_node,
+		               &sub_single_file_entry,
+		               &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "tree_result",
+		 tree_result,
+		 0 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	string_length = ewf_test_single_file_name_index_copy_to_utf16(
+	                 ewf_test_single_file_name_index_sub_node_names[ 0 ],
+	                 string );
+
+	result = libewf_single_file_name_index_get_sub_node_by_utf16_name(
+	          NULL,
+	          string,
+	          string_length,
+	          &index_sub_node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_single_file_name_index_get_sub_node_by_utf16_name(
+	          name_index,
+	          NULL,
+	          string_length,
+	          &index_sub_node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_single_file_name_index_get_sub_node_by_utf16_name(
+	          name_index,
+	          string,
+	          string_length,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_single_file_name_index_free(
+	          &name_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_tree_node_free(
+	          &node,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libewf_single_file_entry_free,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( name_index != NULL )
+	{
+		libewf_single_file_name_index_free(
+		 &name_index,
+		 NULL );
+	}
+	if( node != NULL )
+	{
+		libcdata_tree_node_free(
+		 &node,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_single_file_entry_free,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ )
+
+	EWF_TEST_RUN(
+	 "libewf_single_file_name_index_initialize",
+	 ewf_test_single_file_name_index_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_single_file_name_index_free",
+	 ewf_test_single_file_name_index_free );
+
+	EWF_TEST_RUN(
+	 "libewf_single_file_name_index_get_string_hash",
+	 ewf_test_single_file_name_index_get_string_hash );
+
+	EWF_TEST_RUN(
+	 "libewf_single_file_name_index_build",
+	 ewf_test_single_file_name_index_build );
+
+	EWF_TEST_RUN(
+	 "libewf_single_file_name_index_get_sub_node_by_utf8_name",
+	 ewf_test_single_file_name_index_get_sub_node_by_utf8_name );
+
+	EWF_TEST_RUN(
+	 "libewf_single_file_name_index_get_sub_node_by_utf16_name",
+	 ewf_test_single_file_name_index_get_sub_node_by_utf16_name );
+
+#endif /* defined( __GNUC__ ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -21,6 +21,8 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
@@ -33,6 +35,8 @@
 #include "ewf_test_memory.h"
 #include "ewf_test_unused.h"
 
+#include "../libewf/libewf_libcdata.h"
+#include "../libewf/libewf_single_file_entry.h"
 #include "../libewf/libewf_single_files.h"
 
 #if defined( __GNUC__ )
@@ -270,6 +274,1539 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_single_files_get_cached_node_by_path and
+ * libewf_single_files_set_cached_node_by_path functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_single_files_path_cache(
+     void )
+{
+	uint8_t path[ 8 ]                   = { '\\', 'd', 'i', 'r', '\\', 'f', 'i', 'l' };
+	libcdata_tree_node_t *node          = NULL;
+	libcerror_error_t *error            = NULL;
+	libewf_single_files_t *single_files = NULL;
+	int result                          = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_single_files_initialize(
+	          &single_files,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "single_files",
+	 single_files );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_single_files_get_cached_node_by_path(
+	          single_files,
+	          path,
+	          8,
+	          1,
+	          &node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_single_files_set_cached_node_by_path(
+	          single_files,
+	          path,
+	          8,
+	          1,
+	          (libcdata_tree_node_t *) 0x12345678UL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_single_files_get_cached_node_by_path(
+	          single_files,
+	          path,
+	          8,
+	          1,
+	          &node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "node",
+	 (int) ( node == (libcdata_tree_node_t *) 0x12345678UL ),
+	 1 );
+
+	/* A path with a different character size is a different path
+	 */
+	result = libewf_single_files_get_cached_node_by_path(
+	          single_files,
+	          path,
+	          8,
+	          2,
+	          &node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_single_files_get_cached_node_by_path(
+	          single_files,
+	          path,
+	          7,
+	          1,
+	          &node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_single_files_get_cached_node_by_path(
+	          NULL,
+	          path,
+	          8,
+	          1,
+	          &node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_single_files_get_cached_node_by_path(
+	          single_files,
+	          NULL,
+	          8,
+	          1,
+	          &node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_single_files_set_cached_node_by_path(
+	          NULL,
+	          path,
+	          8,
+	          1,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_single_files_free(
+	          &single_files,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "single_files",
+	 single_files );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( single_files != NULL )
+	{
+		libewf_single_files_free(
+		 &single_files,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Copies an ASCII string into an UTF-16 little-endian stream
+ * Returns the size of the stream
+ */
+size_t ewf_test_single_files_copy_to_utf16_stream(
+        const char *string,
+        uint8_t *utf16_stream,
+        size_t utf16_stream_size )
+{
+	size_t string_index = 0;
+
+	while( ( string[ string_index ] != 0 )
+	    && ( ( ( string_index * 2 ) + 1 ) < utf16_stream_size ) )
+	{
+		utf16_stream[ string_index * 2 ]       = (uint8_t) string[ string_index ];
+		utf16_stream[ ( string_index * 2 ) + 1 ] = 0;
+
+		string_index++;
+	}
+	return( string_index * 2 );
+}
+
+/* Tests the libewf_single_files_parse_record_number_of_sub_entries function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_single_files_parse_record_number_of_sub_entries(
+     void )
+{
+	uint8_t ltree_data[ 64 ];
+
+	libcerror_error_t *error       = NULL;
+	size_t line_offset             = 0;
+	size_t ltree_data_size         = 0;
+	uint64_t number_of_sub_entries = 0;
+	int result                     = 0;
+
+	/* Test regular cases
+	 */
+	ltree_data_size = ewf_test_single_files_copy_to_utf16_stream(
+	                   "26\t12\r\nvalues\n",
+	                   ltree_data,
+	                   64 );
+
+	result = libewf_single_files_parse_record_number_of_sub_entries(
+	          ltree_data,
+	          ltree_data_size,
+	          &line_offset,
+	          &number_of_sub_entries,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_sub_entries",
+	 number_of_sub_entries,
+	 (uint64_t) 12 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "line_offset",
+	 line_offset,
+	 (size_t) 14 );
+
+	/* Test error cases
+	 */
+	result = libewf_single_files_parse_record_number_of_sub_entries(
+	          NULL,
+	          ltree_data_size,
+	          &line_offset,
+	          &number_of_sub_entries,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	line_offset = 0;
+
+	result = libewf_single_files_parse_record_number_of_sub_entries(
+	          ltree_data,
+	          ltree_data_size,
+	          &line_offset,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test with an unsupported first value
+	 */
+	ltree_data_size = ewf_test_single_files_copy_to_utf16_stream(
+	                   "1\t12\n",
+	                   ltree_data,
+	                   64 );
+
+	result = libewf_single_files_parse_record_number_of_sub_entries(
+	          ltree_data,
+	          ltree_data_size,
+	          &line_offset,
+	          &number_of_sub_entries,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test with a missing number of sub entries
+	 */
+	ltree_data_size = ewf_test_single_files_copy_to_utf16_stream(
+	                   "0\n",
+	                   ltree_data,
+	                   64 );
+
+	result = libewf_single_files_parse_record_number_of_sub_entries(
+	          ltree_data,
+	          ltree_data_size,
+	          &line_offset,
+	          &number_of_sub_entries,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_single_files_get_records_offset and
+ * libewf_single_files_index_records functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_single_files_index_records(
+     void )
+{
+	uint8_t ltree_data[ 256 ];
+
+	libcerror_error_t *error            = NULL;
+	libewf_single_files_t *single_files = NULL;
+	size_t records_offset               = 0;
+	int result                          = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_single_files_initialize(
+	          &single_files,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "single_files",
+	 single_files );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The root has 2 sub entries of which the first has 1 sub entry
+	 */
+	single_files->ltree_data      = ltree_data;
+	single_files->ltree_data_size = ewf_test_single_files_copy_to_utf16_stream(
+	                                 "5\nentry\n1\nn\tp\n26\t2\n\t\n0\t1\na\t\n0\t0\nb\t\n0\t0\nc\t\n\n",
+	                                 ltree_data,
+	                                 256 );
+
+	/* Test regular cases
+	 */
+	result = libewf_single_files_get_records_offset(
+	          single_files,
+	          &records_offset,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "records_offset",
+	 records_offset,
+	 (size_t) 28 );
+
+	result = libewf_single_files_index_records(
+	          single_files,
+	          records_offset,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "single_files->number_of_records",
+	 single_files->number_of_records,
+	 4 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "single_files->record_number_of_descendants[ 0 ]",
+	 single_files->record_number_of_descendants[ 0 ],
+	 3 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "single_files->record_number_of_descendants[ 1 ]",
+	 single_files->record_number_of_descendants[ 1 ],
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "single_files->record_number_of_descendants[ 3 ]",
+	 single_files->record_number_of_descendants[ 3 ],
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libewf_single_files_index_records(
+	          single_files,
+	          records_offset,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_single_files_get_records_offset(
+	          NULL,
+	          &records_offset,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	single_files->ltree_data      = NULL;
+	single_files->ltree_data_size = 0;
+
+	result = libewf_single_files_free(
+	          &single_files,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "single_files",
+	 single_files );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( single_files != NULL )
+	{
+		single_files->ltree_data = NULL;
+
+		libewf_single_files_free(
+		 &single_files,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* The ltree of the read tests, where the records are:
+ * 0 root, 1 a, 2 a1, 3 a2, 4 a2x, 5 b, 6 c, 7 c1
+ */
+const char ewf_test_single_files_nested_ltree[] = \
+	"5\nrec\ntb\n0\nentry\n1\nn\tp\n"
+	"26\t3\n\t1\n"
+	"26\t2\na\t1\n"
+	"0\t0\na1\t\n"
+	"26\t1\na2\t1\n"
+	"0\t0\na2x\t\n"
+	"0\t0\nb\t\n"
+	"26\t1\nc\t1\n"
+	"0\t0\nc1\t\n"
+	"\n";
+
+/* Parses the nested ltree with records that are read on demand
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_single_files_parse_nested_ltree(
+     libewf_single_files_t *single_files,
+     uint8_t *ltree_data,
+     size_t ltree_data_size,
+     libcerror_error_t **error )
+{
+	size64_t media_size = 0;
+	uint8_t format      = 0;
+
+	single_files->ltree_data      = ltree_data;
+	single_files->ltree_data_size = ewf_test_single_files_copy_to_utf16_stream(
+	                                 ewf_test_single_files_nested_ltree,
+	                                 ltree_data,
+	                                 ltree_data_size );
+
+	return( libewf_single_files_parse(
+	         single_files,
+	         &media_size,
+	         &format,
+	         error ) );
+}
+
+/* Retrieves the single file entry of a sub node
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_single_files_get_sub_entry(
+     libcdata_tree_node_t *node,
+     int sub_node_index,
+     libcdata_tree_node_t **sub_node,
+     libewf_single_file_entry_t **single_file_entry,
+     libcerror_error_t **error )
+{
+	if( libcdata_tree_node_get_sub_node_by_index(
+	     node,
+	     sub_node_index,
+	     sub_node,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	return( libcdata_tree_node_get_value(
+	         *sub_node,
+	         (intptr_t **) single_file_entry,
+	         error ) );
+}
+
+/* Compares a node read on demand with a node parsed at once, including their sub nodes
+ * Returns 1 if equal, 0 if not or -1 on error
+ */
+int ewf_test_single_files_compare_nodes(
+     libewf_single_files_t *single_files,
+     libcdata_tree_node_t *node,
+     libcdata_tree_node_t *parsed_node,
+     libcerror_error_t **error )
+{
+	libcdata_tree_node_t *parsed_sub_node                = NULL;
+	libcdata_tree_node_t *sub_node                       = NULL;
+	libewf_single_file_entry_t *parsed_single_file_entry = NULL;
+	libewf_single_file_entry_t *single_file_entry        = NULL;
+	int number_of_parsed_sub_nodes                       = 0;
+	int number_of_sub_nodes                              = 0;
+	int result                                           = 0;
+	int sub_node_index                                   = 0;
+
+	if( libewf_single_files_read_sub_nodes(
+	     single_files,
+	     node,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( libcdata_tree_node_get_value(
+	     node,
+	     (intptr_t **) &single_file_entry,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( libcdata_tree_node_get_value(
+	     parsed_node,
+	     (intptr_t **) &parsed_single_file_entry,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( ( single_file_entry == NULL )
+	 || ( parsed_single_file_entry == NULL ) )
+	{
+		return( -1 );
+	}
+	if( ( single_file_entry->type != parsed_single_file_entry->type )
+	 || ( single_file_entry->name_size != parsed_single_file_entry->name_size )
+	 || ( single_file_entry->number_of_unread_sub_entries != 0 ) )
+	{
+		return( 0 );
+	}
+	if( ( single_file_entry->name_size > 0 )
+	 && ( memory_compare(
+	       single_file_entry->name,
+	       parsed_single_file_entry->name,
+	       single_file_entry->name_size ) != 0 ) )
+	{
+		return( 0 );
+	}
+	if( libcdata_tree_node_get_number_of_sub_nodes(
+	     node,
+	     &number_of_sub_nodes,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( libcdata_tree_node_get_number_of_sub_nodes(
+	     parsed_node,
+	     &number_of_parsed_sub_nodes,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( number_of_sub_nodes != number_of_parsed_sub_nodes )
+	{
+		return( 0 );
+	}
+	for( sub_node_index = 0;
+	     sub_node_index < number_of_sub_nodes;
+	     sub_node_index++ )
+	{
+		if( libcdata_tree_node_get_sub_node_by_index(
+		     node,
+		     sub_node_index,
+		     &sub_node,
+		     error ) != 1 )
+		{
+			return( -1 );
+		}
+		if( libcdata_tree_node_get_sub_node_by_index(
+		     parsed_node,
+		     sub_node_index,
+		     &parsed_sub_node,
+		     error ) != 1 )
+		{
+			return( -1 );
+		}
+		result = ewf_test_single_files_compare_nodes(
+		          single_files,
+		          sub_node,
+		          parsed_sub_node,
+		          error );
+
+		if( result != 1 )
+		{
+			return( result );
+		}
+	}
+	return( 1 );
+}
+
+/* Tests the libewf_single_files_read_record function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_single_files_read_record(
+     void )
+{
+	uint8_t ltree_data[ 512 ];
+
+	libcerror_error_t *error                      = NULL;
+	libewf_single_file_entry_t *single_file_entry = NULL;
+	libewf_single_files_t *single_files           = NULL;
+	int result                                    = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_single_files_initialize(
+	          &single_files,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "single_files",
+	 single_files );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_single_files_parse_nested_ltree(
+	          single_files,
+	          ltree_data,
+	          512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "single_files->number_of_records",
+	 single_files->number_of_records,
+	 8 );
+
+	/* Test regular cases
+	 */
+	result = libewf_single_files_read_record(
+	          single_files,
+	          3,
+	          &single_file_entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "single_file_entry",
+	 single_file_entry );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "single_file_entry->record_index",
+	 single_file_entry->record_index,
+	 3 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "single_file_entry->number_of_unread_sub_entries",
+	 single_file_entry->number_of_unread_sub_entries,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "single_file_entry->name_size",
+	 single_file_entry->name_size,
+	 (size_t) 3 );
+
+	result = memory_compare(
+	          single_file_entry->name,
+	          "a2",
+	          3 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "single_file_entry->type",
+	 single_file_entry->type,
+	 (uint8_t) LIBEWF_FILE_ENTRY_TYPE_DIRECTORY );
+
+	result = libewf_single_file_entry_free(
+	          &single_file_entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_single_files_read_record(
+	          single_files,
+	          7,
+	          &single_file_entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "single_file_entry",
+	 single_file_entry );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "single_file_entry->number_of_unread_sub_entries",
+	 single_file_entry->number_of_unread_sub_entries,
+	 0 );
+
+	result = memory_compare(
+	          single_file_entry->name,
+	          "c1",
+	          3 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libewf_single_file_entry_free(
+	          &single_file_entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_single_files_read_record(
+	          NULL,
+	          3,
+	          &single_file_entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_single_files_read_record(
+	          single_files,
+	          -1,
+	          &single_file_entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_single_files_read_record(
+	          single_files,
+	          8,
+	          &single_file_entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_single_files_read_record(
+	          single_files,
+	          3,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	single_files->ltree_data      = NULL;
+	single_files->ltree_data_size = 0;
+
+	result = libewf_single_files_free(
+	          &single_files,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "single_files",
+	 single_files );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( single_file_entry != NULL )
+	{
+		libewf_single_file_entry_free(
+		 &single_file_entry,
+		 NULL );
+	}
+	if( single_files != NULL )
+	{
+		single_files->ltree_data = NULL;
+
+		libewf_single_files_free(
+		 &single_files,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_single_files_read_sub_nodes function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_single_files_read_sub_nodes(
+     void )
+{
+	uint8_t ltree_data[ 512 ];
+
+	libcdata_tree_node_t *sub_node                = NULL;
+	libcdata_tree_node_t *sub_sub_node            = NULL;
+	libcerror_error_t *error                      = NULL;
+	libewf_single_file_entry_t *single_file_entry = NULL;
+	libewf_single_files_t *parsed_single_files    = NULL;
+	libewf_single_files_t *single_files           = NULL;
+	size64_t media_size                           = 0;
+	uint8_t format                                = 0;
+	int number_of_sub_nodes                       = 0;
+	int result                                    = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_single_files_initialize(
+	          &single_files,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "single_files",
+	 single_files );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_single_files_parse_nested_ltree(
+	          single_files,
+	          ltree_data,
+	          512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The same ltree with all the single file entries parsed at once
+	 */
+	result = libewf_single_files_initialize(
+	          &parsed_single_files,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_single_files_parse_file_entries(
+	          parsed_single_files,
+	          &media_size,
+	          (uint8_t *) ewf_test_single_files_nested_ltree,
+	          narrow_string_length(
+	           ewf_test_single_files_nested_ltree ) + 1,
+	          &format,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libcdata_tree_node_get_value(
+	          single_files->root_file_entry_node,
+	          (intptr_t **) &single_file_entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "single_file_entry->number_of_unread_sub_entries",
+	 single_file_entry->number_of_unread_sub_entries,
+	 3 );
+
+	result = libewf_single_files_read_sub_nodes(
+	          single_files,
+	          single_files->root_file_entry_node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "single_file_entry->number_of_unread_sub_entries",
+	 single_file_entry->number_of_unread_sub_entries,
+	 0 );
+
+	/* Open the directories in a different order than they are stored:
+	 * first c, then a2 through a, so that the sub record index of each
+	 * directory is determined from the descendants of its preceding siblings
+	 */
+	result = ewf_test_single_files_get_sub_entry(
+	          single_files->root_file_entry_node,
+	          2,
+	          &sub_node,
+	          &single_file_entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "single_file_entry->record_index",
+	 single_file_entry->record_index,
+	 6 );
+
+	result = libewf_single_files_read_sub_nodes(
+	          single_files,
+	          sub_node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_single_files_get_sub_entry(
+	          sub_node,
+	          0,
+	          &sub_sub_node,
+	          &single_file_entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "single_file_entry->record_index",
+	 single_file_entry->record_index,
+	 7 );
+
+	result = ewf_test_single_files_get_sub_entry(
+	          single_files->root_file_entry_node,
+	          0,
+	          &sub_node,
+	          &single_file_entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_single_files_read_sub_nodes(
+	          single_files,
+	          sub_node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_single_files_get_sub_entry(
+	          sub_node,
+	          1,
+	          &sub_sub_node,
+	          &single_file_entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "single_file_entry->record_index",
+	 single_file_entry->record_index,
+	 3 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "single_file_entry->number_of_unread_sub_entries",
+	 single_file_entry->number_of_unread_sub_entries,
+	 1 );
+
+	/* Reading the sub nodes again should not add sub nodes
+	 */
+	result = libewf_single_files_read_sub_nodes(
+	          single_files,
+	          single_files->root_file_entry_node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_tree_node_get_number_of_sub_nodes(
+	          single_files->root_file_entry_node,
+	          &number_of_sub_nodes,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_sub_nodes",
+	 number_of_sub_nodes,
+	 3 );
+
+	/* The remaining directories are read by the comparison
+	 */
+	result = ewf_test_single_files_compare_nodes(
+	          single_files,
+	          single_files->root_file_entry_node,
+	          parsed_single_files->root_file_entry_node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Read the sub nodes of the root with a record count that no longer
+	 * covers the last sub entry: the sub entries read before the failure
+	 * are kept and only the remaining ones stay unread
+	 */
+	single_files->ltree_data      = NULL;
+	single_files->ltree_data_size = 0;
+
+	result = libewf_single_files_free(
+	          &single_files,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_single_files_initialize(
+	          &single_files,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_single_files_parse_nested_ltree(
+	          single_files,
+	          ltree_data,
+	          512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	single_files->number_of_records = 6;
+
+	result = libewf_single_files_read_sub_nodes(
+	          single_files,
+	          single_files->root_file_entry_node,
+	          &error );
+
+	single_files->number_of_records = 8;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libcdata_tree_node_get_number_of_sub_nodes(
+	          single_files->root_file_entry_node,
+	          &number_of_sub_nodes,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_sub_nodes",
+	 number_of_sub_nodes,
+	 2 );
+
+	result = libcdata_tree_node_get_value(
+	          single_files->root_file_entry_node,
+	          (intptr_t **) &single_file_entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "single_file_entry->number_of_unread_sub_entries",
+	 single_file_entry->number_of_unread_sub_entries,
+	 1 );
+
+	/* Reading again skips the sub entries that were read before
+	 */
+	result = libewf_single_files_read_sub_nodes(
+	          single_files,
+	          single_files->root_file_entry_node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "single_file_entry->number_of_unread_sub_entries",
+	 single_file_entry->number_of_unread_sub_entries,
+	 0 );
+
+	result = ewf_test_single_files_compare_nodes(
+	          single_files,
+	          single_files->root_file_entry_node,
+	          parsed_single_files->root_file_entry_node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_single_files_read_sub_nodes(
+	          NULL,
+	          single_files->root_file_entry_node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_single_files_read_sub_nodes(
+	          single_files,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_single_files_free(
+	          &parsed_single_files,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "parsed_single_files",
+	 parsed_single_files );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	single_files->ltree_data      = NULL;
+	single_files->ltree_data_size = 0;
+
+	result = libewf_single_files_free(
+	          &single_files,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "single_files",
+	 single_files );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( parsed_single_files != NULL )
+	{
+		libewf_single_files_free(
+		 &parsed_single_files,
+		 NULL );
+	}
+	if( single_files != NULL )
+	{
+		single_files->ltree_data = NULL;
+
+		libewf_single_files_free(
+		 &single_files,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) */
 
 /* The main program
@@ -309,6 +1846,32 @@ int main(
 
 	/* TODO: add tests for libewf_single_files_parse_file_entry_offset_values */
 
+	EWF_TEST_RUN(
+	 "libewf_single_files_parse_record_number_of_sub_entries",
+	 ewf_test_single_files_parse_record_number_of_sub_entries );
+
+	EWF_TEST_RUN(
+	 "libewf_single_files_index_records",
+	 ewf_test_single_files_index_records );
+
+	EWF_TEST_RUN(
+	 "libewf_single_files_read_record",
+	 ewf_test_single_files_read_record );
+
+	EWF_TEST_RUN(
+	 "libewf_single_files_read_sub_nodes",
+	 ewf_test_single_files_read_sub_nodes );
+
+	/* TODO: add tests for libewf_single_files_get_sub_node_name_index */
+
+	/* TODO: add tests for libewf_single_files_get_sub_node_by_utf8_name */
+
+	/* TODO: add tests for libewf_single_files_get_sub_node_by_utf16_name */
+
+	EWF_TEST_RUN(
+	 "libewf_single_files_path_cache",
+	 ewf_test_single_files_path_cache );
+
 #endif /* defined( __GNUC__ ) */
 
 	return( EXIT_SUCCESS );
@@ -143,6 +143,153 @@ def pyewf_test_read_buffer_at_offset(
   return result
 
 
+def pyewf_test_read_buffer_at_offset_into(
+    ewf_handle, input_offset, input_size, expected_offset, expected_size):
+
+  print(
+      ("Testing reading buffer into bytearray at offset: {0:d} and "
+       "size: {1:d}\t").format(input_offset, input_size), end="")
+
+  error_string = ""
+  result = True
+  try:
+    buffer_object = bytearray(4096)
+
+    result_size = 0
+    while input_size > 0:
+      read_size = 4096
+      if input_size < read_size:
+        read_size = input_size
+
+      data_size = ewf_handle.read_buffer_at_offset_into(
+          memoryview(buffer_object)[:read_size], input_offset)
+
+      data = ewf_handle.read_buffer_at_offset(data_size, input_offset)
+      if data != bytes(buffer_object[:data_size]):
+        error_string = "Mismatch in data at offset: {0:d}".format(
+            input_offset)
+        result = False
+        break
+
+      input_offset += data_size
+      input_size -= data_size
+      result_size += data_size
+
+      if data_size != read_size:
+        break
+
+    if result and input_offset != expected_offset:
+      error_string = "Unexpected offset: {0:d}".format(input_offset)
+      result = False
+
+    elif result and result_size != expected_size:
+      error_string = "Unexpected read count: {0:d}".format(result_size)
+      result = False
+
+  except Exception as exception:
+    print(str(exception))
+    if expected_offset != -1:
+      result = False
+
+  if not result:
+    print("(FAIL)")
+  else:
+    print("(PASS)")
+
+  if error_string:
+    print(error_string)
+  return result
+
+
+def pyewf_test_read_chunks(ewf_handle, chunk_size, use_buffer):
+  print(
+      ("Testing reading chunks of size: {0:d} with reused buffer: {1!s}"
+       "\t").format(chunk_size, use_buffer), end="")
+
+  error_string = ""
+  result = True
+  try:
+    media_size = ewf_handle.get_media_size()
+
+    buffer_object = None
+    if use_buffer:
+      buffer_object = bytearray(chunk_size)
+
+    result_size = 0
+    for chunk in ewf_handle.read_chunks(
+        size=chunk_size, offset=0, buffer=buffer_object):
+      data = ewf_handle.read_buffer_at_offset(len(chunk), result_size)
+      if data != chunk.tobytes():
+        error_string = "Mismatch in data at offset: {0:d}".format(
+            result_size)
+        result = False
+        break
+
+      result_size += len(chunk)
+
+    if result and result_size != media_size:
+      error_string = "Unexpected read count: {0:d}".format(result_size)
+      result = False
+
+  except Exception as exception:
+    print(str(exception))
+    result = False
+
+  if not result:
+    print("(FAIL)")
+  else:
+    print("(PASS)")
+
+  if error_string:
+    print(error_string)
+  return result
+
+
+def pyewf_test_statistics(ewf_handle):
+  print("Testing statistics\t", end="")
+
+  error_string = ""
+  result = True
+  try:
+    if ewf_handle.get_statistics() is not None:
+      error_string = "Unexpected statistics before collecting"
+      result = False
+
+    if result:
+      ewf_handle.set_collect_statistics(True)
+      ewf_handle.read_buffer_at_offset(4096, 0)
+
+      statistics = ewf_handle.get_statistics()
+      number_of_events, _ = statistics["read_buffer"]
+      if number_of_events != 1:
+        error_string = "Unexpected number of read buffer events: {0:d}".format(
+            number_of_events)
+        result = False
+
+    if result:
+      ewf_handle.reset_statistics()
+
+      statistics = ewf_handle.get_statistics()
+      if statistics["read_buffer"] != (0, 0):
+        error_string = "Unexpected statistics after reset"
+        result = False
+
+    ewf_handle.set_collect_statistics(False)
+
+  except Exception as exception:
+    print(str(exception))
+    result = False
+
+  if not result:
+    print("(FAIL)")
+  else:
+    print("(PASS)")
+
+  if error_string:
+    print(error_string)
+  return result
+
+
 def pyewf_test_read(ewf_handle):
   media_size = ewf_handle.media_size
 
@@ -231,6 +378,31 @@ def pyewf_test_read(ewf_handle):
       read_offset + read_size, read_size):
     return False
 
+  # Case 4: test buffer at offset read into a buffer object
+
+  # Test: offset: <media_size / 7> size: <media_size / 2>
+  # Expected result: offset: < ( media_size / 7 ) + ( media_size / 2 ) > size: <media_size / 2>
+  read_offset, _ = divmod(media_size, 7)
+  read_size, _ = divmod(media_size, 2)
+
+  if not pyewf_test_read_buffer_at_offset_into(
+      ewf_handle, read_offset, read_size,
+      read_offset + read_size, read_size):
+    return False
+
+  # Case 5: test chunk iterator read
+
+  if not pyewf_test_read_chunks(ewf_handle, 65536, False):
+    return False
+
+  if not pyewf_test_read_chunks(ewf_handle, 65536, True):
+    return False
+
+  # Case 6: test statistics
+
+  if not pyewf_test_statistics(ewf_handle):
+    return False
+
   return True
 
 
@@ -245,7 +417,7 @@ def pyewf_test_read_file(filename):
   return result
 
 
-def pyewf_test_read_file_object(filename):
+def pyewf_test_read_file_object(filename, read_ahead_size=1048576):
   filenames = pyewf.glob(filename)
   file_objects = []
   for filename in filenames:
@@ -253,7 +425,8 @@ def pyewf_test_read_file_object(filename):
     file_objects.append(file_object)
 
   ewf_handle = pyewf.handle()
-  ewf_handle.open_file_objects(file_objects, "r")
+  ewf_handle.open_file_objects(
+      file_objects, "r", read_ahead_size=read_ahead_size)
 
   result = pyewf_test_read(ewf_handle)
   ewf_handle.close()
@@ -307,6 +480,9 @@ def main():
   if not pyewf_test_read_file_object(options.source):
     return False
 
+  if not pyewf_test_read_file_object(options.source, read_ahead_size=0):
+    return False
+
   if not pyewf_test_read_file_no_open(options.source):
     return False
 
@@ -1,7 +1,7 @@
 #!/bin/bash
 # Acquire tool testing script
 #
-# Version: 20160411
+# Version: 20261018
 
 EXIT_SUCCESS=0;
 EXIT_FAILURE=1;
@@ -20,42 +20,71 @@ TEST_TOOL="${TEST_PREFIX}${TEST_SUFFIX}";
 INPUT_DIRECTORY="input";
 INPUT_GLOB="*.[Rr][Aa][Ww]";
 
-test_callback()
-{ 
-	local TMPDIR=$1;
-	local TEST_SET_DIRECTORY=$2;
-	local TEST_OUTPUT=$3;
-	local TEST_EXECUTABLE=$4;
-	local TEST_INPUT=$5;
-	shift 5;
+calculate_md5()
+{
+	local INPUT_FILE=$1;
+
+	if test "${PLATFORM}" = "Darwin";
+	then
+		md5 -q "${INPUT_FILE}";
+	else
+		md5sum "${INPUT_FILE}" | cut -d ' ' -f 1;
+	fi
+}
+
+# Acquires a device and compares the calculated MD5 with the MD5 of the verified image
+# and, if specified, the expected MD5
+test_acquire_device()
+{
+	local INPUT_DEVICE=$1;
+	local INPUT_SIZE=$2;
+	local EXPECTED_MD5=$3;
+	shift 3;
 	local ARGUMENTS=$@;
 
-	TEST_EXECUTABLE=`readlink -f ${TEST_EXECUTABLE}`;
-	INPUT_FILE_FULL_PATH=`readlink -f "${INPUT_FILE}"`;
+	local TEST_LOG="${TMPDIR}/acquire.log";
 
-	local TEST_LOG="${TEST_OUTPUT}.log";
+	rm -f ${TMPDIR}/acquire.*;
 
-	(cd ${TMPDIR} && run_test_with_input_and_arguments "${TEST_EXECUTABLE}" "${INPUT_FILE_FULL_PATH}" ${ARGUMENTS[@]} | sed '1,2d' > "${TEST_LOG}");
+	${TEST_EXECUTABLE} -B ${INPUT_SIZE} -m removable -M logical -P 512 -q -t "${TMPDIR}/acquire" -u ${ARGUMENTS} "${INPUT_DEVICE}" > "${TEST_LOG}" 2>&1;
 	local RESULT=$?;
 
-	local TEST_RESULTS="${TMPDIR}/${TEST_LOG}";
-	local STORED_TEST_RESULTS="${TEST_SET_DIRECTORY}/${TEST_LOG}.gz";
+	local CALCULATED_MD5="";
 
-	if test -f "${STORED_TEST_RESULTS}";
+	if test ${RESULT} -eq ${EXIT_SUCCESS};
 	then
-		# Using zcat here since zdiff has issues on Mac OS X.
-		# Note that zcat on Mac OS X requires the input from stdin.
-		zcat < "${STORED_TEST_RESULTS}" | diff "${TEST_RESULTS}" -;
-		RESULT=$?;
-	else
-		gzip "${TEST_RESULTS}";
+		CALCULATED_MD5=`grep "MD5 hash calculated over data:" "${TEST_LOG}" | sed 's/^.*:[[:space:]]*//'`;
 
-		mv "${TEST_RESULTS}.gz" ${TEST_SET_DIRECTORY};
+		if test -z "${CALCULATED_MD5}";
+		then
+			RESULT=${EXIT_FAILURE};
+
+		elif test -n "${EXPECTED_MD5}" && test "${CALCULATED_MD5}" != "${EXPECTED_MD5}";
+		then
+			RESULT=${EXIT_FAILURE};
+		fi
 	fi
 	if test ${RESULT} -eq ${EXIT_SUCCESS};
 	then
-		run_test_with_input_and_arguments "${VERIFY_TOOL}" ${TMPDIR}/acquire.* -q > /dev/null;
-		local RESULT=$?;
+		${VERIFY_TOOL} -q "${TMPDIR}/acquire.E01" > "${TEST_LOG}" 2>&1;
+		RESULT=$?;
+	fi
+	if test ${RESULT} -eq ${EXIT_SUCCESS};
+	then
+		local VERIFIED_MD5=`grep "MD5 hash calculated over data:" "${TEST_LOG}" | sed 's/^.*:[[:space:]]*//'`;
+
+		if test "${VERIFIED_MD5}" != "${CALCULATED_MD5}";
+		then
+			RESULT=${EXIT_FAILURE};
+		fi
+	fi
+	echo -n "Testing ${TEST_DESCRIPTION} with input: ${INPUT_DEVICE} and options: ${ARGUMENTS}";
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		echo " (FAIL)";
+	else
+		echo " (PASS)";
 	fi
 	return ${RESULT};
 }
@@ -107,10 +136,62 @@ then
 	exit ${EXIT_FAILURE};
 fi
 
+PLATFORM=`uname -s`;
+
 source ${TEST_RUNNER};
 
+if test "${PLATFORM}" = "Darwin";
+then
+	assert_availability_binary md5;
+else
+	assert_availability_binary md5sum;
+fi
+
 run_test_on_input_directory "${TEST_PROFILE}" "${TEST_DESCRIPTION}" "with_callback" "${OPTION_SETS}" "${TEST_EXECUTABLE}" "${INPUT_DIRECTORY}" "${INPUT_GLOB}" -CCase -DDescription -EEvidence -eExaminer -mremovable -Mlogical -NNotes -q -tacquire -u;
 RESULT=$?;
 
-exit ${RESULT};
+if test ${RESULT} -ne ${EXIT_SUCCESS} && test ${RESULT} -ne ${EXIT_IGNORE};
+then
+	exit ${RESULT};
+fi
+
+TMPDIR="tmp$$";
+
+rm -rf ${TMPDIR};
+mkdir ${TMPDIR};
+
+# The concurrent device reads (-k) are only used for devices
+INPUT_SIZE=$(( ( 8 * 1024 * 1024 ) + 4608 ));
+
+head -c ${INPUT_SIZE} /dev/zero > "${TMPDIR}/zero.raw";
+
+EXPECTED_MD5=$(calculate_md5 "${TMPDIR}/zero.raw");
+
+rm -f "${TMPDIR}/zero.raw";
+
+for READER_OPTIONS in "-j0 -k0" "-j4 -k0" "-j4 -k1" "-j4 -k4" "-j4 -k4 -b 16" "-j4 -k4 -x";
+do
+	if ! test_acquire_device "/dev/zero" ${INPUT_SIZE} "${EXPECTED_MD5}" ${READER_OPTIONS};
+	then
+		rm -rf ${TMPDIR};
+
+		exit ${EXIT_FAILURE};
+	fi
+done
+
+# The data of /dev/urandom differs per read, hence the MD5 of the acquired
+# data is compared with that of the verified image
+for READER_OPTIONS in "-j4 -k1" "-j4 -k4 -c deflate:fast";
+do
+	if ! test_acquire_device "/dev/urandom" ${INPUT_SIZE} "" ${READER_OPTIONS};
+	then
+		rm -rf ${TMPDIR};
+
+		exit ${EXIT_FAILURE};
+	fi
+done
+
+rm -rf ${TMPDIR};
+
+exit ${EXIT_SUCCESS};
 
@@ -1,7 +1,7 @@
 #!/bin/bash
 # Acquirestream tool testing script
 #
-# Version: 20160411
+# Version: 20261018
 
 EXIT_SUCCESS=0;
 EXIT_FAILURE=1;
@@ -20,6 +20,67 @@ TEST_TOOL="${TEST_PREFIX}${TEST_SUFFIX}";
 INPUT_DIRECTORY="input";
 INPUT_GLOB="*.[Rr][Aa][Ww]";
 
+calculate_md5()
+{
+	local INPUT_FILE=$1;
+
+	if test "${PLATFORM}" = "Darwin";
+	then
+		md5 -q "${INPUT_FILE}";
+	else
+		md5sum "${INPUT_FILE}" | cut -d ' ' -f 1;
+	fi
+}
+
+# Acquires test data from a pipe and compares the calculated MD5 and the MD5 of the verified image with the MD5 of the test data
+test_acquire_test_data()
+{
+	local TEST_DATA=$1;
+	local EXPECTED_MD5=$2;
+	shift 2;
+	local ARGUMENTS=$@;
+
+	local TEST_LOG="${TMPDIR}/acquirestream.log";
+
+	rm -f ${TMPDIR}/acquirestream.*;
+
+	cat "${TEST_DATA}" | ${TEST_EXECUTABLE} -q -t "${TMPDIR}/acquirestream" ${ARGUMENTS} > "${TEST_LOG}" 2>&1;
+	local RESULT=$?;
+
+	if test ${RESULT} -eq ${EXIT_SUCCESS};
+	then
+		local CALCULATED_MD5=`grep "MD5 hash calculated over data:" "${TEST_LOG}" | sed 's/^.*:[[:space:]]*//'`;
+
+		if test "${CALCULATED_MD5}" != "${EXPECTED_MD5}";
+		then
+			RESULT=${EXIT_FAILURE};
+		fi
+	fi
+	if test ${RESULT} -eq ${EXIT_SUCCESS};
+	then
+		${VERIFY_TOOL} -q "${TMPDIR}/acquirestream.E01" > "${TEST_LOG}" 2>&1;
+		RESULT=$?;
+	fi
+	if test ${RESULT} -eq ${EXIT_SUCCESS};
+	then
+		local CALCULATED_MD5=`grep "MD5 hash calculated over data:" "${TEST_LOG}" | sed 's/^.*:[[:space:]]*//'`;
+
+		if test "${CALCULATED_MD5}" != "${EXPECTED_MD5}";
+		then
+			RESULT=${EXIT_FAILURE};
+		fi
+	fi
+	echo -n "Testing ${TEST_DESCRIPTION} with options: ${ARGUMENTS}";
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		echo " (FAIL)";
+	else
+		echo " (PASS)";
+	fi
+	return ${RESULT};
+}
+
 test_callback()
 { 
 	local TMPDIR=$1;
@@ -107,10 +168,49 @@ then
 	exit ${EXIT_FAILURE};
 fi
 
+PLATFORM=`uname -s`;
+
 source ${TEST_RUNNER};
 
+if test "${PLATFORM}" = "Darwin";
+then
+	assert_availability_binary md5;
+else
+	assert_availability_binary md5sum;
+fi
+
 run_test_on_input_directory "${TEST_PROFILE}" "${TEST_DESCRIPTION}" "with_callback" "${OPTION_SETS}" "${TEST_EXECUTABLE}" "${INPUT_DIRECTORY}" "${INPUT_GLOB}" -CCase -DDescription -EEvidence -eExaminer -mremovable -Mlogical -NNotes -q -tacquirestream;
 RESULT=$?;
 
-exit ${RESULT};
+if test ${RESULT} -ne ${EXIT_SUCCESS} && test ${RESULT} -ne ${EXIT_IGNORE};
+then
+	exit ${RESULT};
+fi
+
+TMPDIR="tmp$$";
+
+rm -rf ${TMPDIR};
+mkdir ${TMPDIR};
+
+TEST_DATA="${TMPDIR}/input.raw";
+
+(head -c 1048576 /dev/zero; yes "ewfacquirestream test data" | head -c 2097152; head -c 2097152 /dev/urandom; head -c 4608 /dev/urandom) > "${TEST_DATA}";
+
+EXPECTED_MD5=$(calculate_md5 "${TEST_DATA}");
+
+# The data acquired with the read-ahead buffer (-k) must match the test data,
+# including for buffer sizes smaller than the chunk size and the input
+for BUFFER_OPTIONS in "-j0 -k0" "-j4 -k0" "-j4 -k4KiB" "-j4 -k64KiB" "-j4 -k1MiB" "-j4 -k16MiB" "-j4 -k1MiB -x" "-j4 -k1MiB -c deflate:fast";
+do
+	if ! test_acquire_test_data "${TEST_DATA}" "${EXPECTED_MD5}" ${BUFFER_OPTIONS};
+	then
+		rm -rf ${TMPDIR};
+
+		exit ${EXIT_FAILURE};
+	fi
+done
+
+rm -rf ${TMPDIR};
+
+exit ${EXIT_SUCCESS};
 
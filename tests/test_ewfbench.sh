@@ -0,0 +1,87 @@
+#!/bin/bash
+# Benchmark tool testing script
+#
+# Runs ewfbench on a small synthetic image to test that all benchmark stages
+# succeed. If EWFBENCH_BASELINE is set to the results file of a previous run
+# the results are compared with it and a regression of more than
+# EWFBENCH_TOLERANCE percent (default is 10) makes the test fail.
+#
+# Version: 20261018
+
+EXIT_SUCCESS=0;
+EXIT_FAILURE=1;
+EXIT_IGNORE=77;
+
+OPTIONS="-B 4MiB -S 1MiB -n 64 -j 1 -o 0,1";
+
+if ! test -z ${SKIP_TOOLS_TESTS};
+then
+	exit ${EXIT_IGNORE};
+fi
+
+TEST_EXECUTABLE="../ewftools/ewfbench";
+
+if ! test -x "${TEST_EXECUTABLE}";
+then
+	TEST_EXECUTABLE="../ewftools/ewfbench.exe";
+fi
+
+if ! test -x "${TEST_EXECUTABLE}";
+then
+	echo "Missing test executable: ${TEST_EXECUTABLE}";
+
+	exit ${EXIT_FAILURE};
+fi
+
+TMPDIR="tmp";
+
+rm -rf ${TMPDIR};
+mkdir ${TMPDIR};
+
+RESULTS_FILE="${TMPDIR}/ewfbench.json";
+
+BASELINE_OPTIONS="";
+
+if ! test -z "${EWFBENCH_BASELINE}";
+then
+	BASELINE_OPTIONS="-r ${EWFBENCH_BASELINE}";
+
+	if ! test -z "${EWFBENCH_TOLERANCE}";
+	then
+		BASELINE_OPTIONS="${BASELINE_OPTIONS} -R ${EWFBENCH_TOLERANCE}";
+	fi
+fi
+
+echo -n "Testing ewfbench with options: ${OPTIONS} ";
+
+${TEST_EXECUTABLE} ${OPTIONS} ${BASELINE_OPTIONS} -t "${TMPDIR}/ewfbench" -w "${RESULTS_FILE}" 2> /dev/null;
+RESULT=$?;
+
+if test ${RESULT} -eq ${EXIT_SUCCESS};
+then
+	if ! test -s "${RESULTS_FILE}";
+	then
+		RESULT=${EXIT_FAILURE};
+
+	elif ! grep -q "\"sequential_read:threads=1:open_handles=0\"" "${RESULTS_FILE}";
+	then
+		RESULT=${EXIT_FAILURE};
+
+	elif ls ${TMPDIR}/ewfbench.* 2> /dev/null | grep -v "\.json$" > /dev/null;
+	then
+		# The segment and export files should have been removed
+		RESULT=${EXIT_FAILURE};
+	fi
+fi
+
+if test ${RESULT} -eq ${EXIT_SUCCESS};
+then
+	echo " (PASS)";
+else
+	echo " (FAIL)";
+fi
+
+rm -rf ${TMPDIR};
+
+exit ${RESULT};
+
@@ -1,7 +1,7 @@
 #!/bin/bash
 # Export tool testing script
 #
-# Version: 20170902
+# Version: 20261018
 
 EXIT_SUCCESS=0;
 EXIT_FAILURE=1;
@@ -13,6 +13,78 @@ OPTIONS="-q -texport -u";
 INPUT_DIRECTORY="input";
 INPUT_GLOB="*.[Ees]*01";
 
+# Creates a test image of data that contains empty, compressible and
+# uncompressible chunks and a last chunk that is not completely filled
+create_test_image()
+{
+	local TEST_DATA=$1;
+	local TEST_IMAGE=$2;
+
+	(head -c 1048576 /dev/zero; yes "ewfexport test data" | head -c 2097152; head -c 2097152 /dev/urandom; head -c 1048576 /dev/zero; head -c 4608 /dev/urandom) > "${TEST_DATA}";
+
+	${ACQUIRESTREAM_TOOL} -c deflate:fast -q -S 1MiB -t "${TEST_IMAGE}" < "${TEST_DATA}" > /dev/null 2>&1;
+	local RESULT=$?;
+
+	echo -n "Creating test image: ${TEST_IMAGE}";
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		echo " (FAIL)";
+	else
+		echo " (PASS)";
+	fi
+	return ${RESULT};
+}
+
+calculate_md5()
+{
+	local INPUT_FILE=$1;
+
+	if test "${PLATFORM}" = "Darwin";
+	then
+		md5 -q "${INPUT_FILE}";
+	else
+		md5sum "${INPUT_FILE}" | cut -d ' ' -f 1;
+	fi
+}
+
+# Exports a test image to a raw file and compares its MD5 with the MD5 of the test data
+test_export_test_image()
+{
+	local TEST_IMAGE=$1;
+	local EXPECTED_MD5=$2;
+	shift 2;
+	local ARGUMENTS=$@;
+
+	local EXPORT_FILE="${TMPDIR}/export.raw";
+
+	rm -f "${EXPORT_FILE}";
+
+	${TEST_EXECUTABLE} -f raw -q -t "${TMPDIR}/export" -u ${ARGUMENTS} "${TEST_IMAGE}.E01" > /dev/null 2>&1;
+	local RESULT=$?;
+
+	if test ${RESULT} -eq ${EXIT_SUCCESS};
+	then
+		if ! test -f "${EXPORT_FILE}";
+		then
+			RESULT=${EXIT_FAILURE};
+
+		elif test "$(calculate_md5 "${EXPORT_FILE}")" != "${EXPECTED_MD5}";
+		then
+			RESULT=${EXIT_FAILURE};
+		fi
+	fi
+	echo -n "Testing ewfexport with options: ${ARGUMENTS}";
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		echo " (FAIL)";
+	else
+		echo " (PASS)";
+	fi
+	return ${RESULT};
+}
+
 test_callback()
 {
 	local TMPDIR=$1;
@@ -94,6 +166,20 @@ then
 	exit ${EXIT_FAILURE};
 fi
 
+ACQUIRESTREAM_TOOL="../ewftools/ewfacquirestream";
+
+if ! test -x "${ACQUIRESTREAM_TOOL}";
+then
+	ACQUIRESTREAM_TOOL="../ewftools/ewfacquirestream.exe";
+fi
+
+if ! test -x "${ACQUIRESTREAM_TOOL}";
+then
+	echo "Missing executable: ${ACQUIRESTREAM_TOOL}";
+
+	exit ${EXIT_FAILURE};
+fi
+
 TEST_RUNNER="tests/test_runner.sh";
 
 if ! test -f "${TEST_RUNNER}";
@@ -122,5 +208,37 @@ fi
 run_test_on_input_directory "ewfexport" "ewfexport" "with_callback" "${OPTION_SETS}" "${TEST_EXECUTABLE}" "${INPUT_DIRECTORY}" "${INPUT_GLOB}" "${OPTIONS}";
 RESULT=$?;
 
-exit ${RESULT};
+if test ${RESULT} -ne ${EXIT_SUCCESS} && test ${RESULT} -ne ${EXIT_IGNORE};
+then
+	exit ${RESULT};
+fi
+
+TMPDIR="tmp$$";
+
+rm -rf ${TMPDIR};
+mkdir ${TMPDIR};
+
+if ! create_test_image "${TMPDIR}/input.raw" "${TMPDIR}/image";
+then
+	rm -rf ${TMPDIR};
+
+	exit ${EXIT_FAILURE};
+fi
+EXPECTED_MD5=$(calculate_md5 "${TMPDIR}/input.raw");
+
+# The data exported with reader threads must match the single-threaded
+# and single reader export, which is the test data
+for READER_OPTIONS in "-j0" "-j4 -k0" "-j1 -k1" "-j4 -k1" "-j4 -k4" "-j4 -k4 -x";
+do
+	if ! test_export_test_image "${TMPDIR}/image" "${EXPECTED_MD5}" ${READER_OPTIONS};
+	then
+		rm -rf ${TMPDIR};
+
+		exit ${EXIT_FAILURE};
+	fi
+done
+
+rm -rf ${TMPDIR};
+
+exit ${EXIT_SUCCESS};
 
@@ -1,7 +1,7 @@
 #!/bin/bash
 # Export tool testing script
 #
-# Version: 20160411
+# Version: 20261018
 
 EXIT_SUCCESS=0;
 EXIT_FAILURE=1;
@@ -20,6 +20,69 @@ TEST_TOOL="${TEST_PREFIX}export";
 INPUT_DIRECTORY="input";
 INPUT_GLOB="*.[Ll]*01";
 
+# Exports the single files of a logical image and writes the exported directories and the MD5 of the exported files to a log
+export_single_files()
+{
+	local INPUT_FILE=$1;
+	local TEST_LOG=$2;
+	shift 2;
+	local ARGUMENTS=$@;
+
+	rm -rf "${TMPDIR}/export";
+
+	${TEST_EXECUTABLE} -ffiles -q -t "${TMPDIR}/export" -u ${ARGUMENTS} "${INPUT_FILE}" > /dev/null 2>&1;
+	local RESULT=$?;
+
+	if test ${RESULT} -eq ${EXIT_SUCCESS};
+	then
+		if test "${PLATFORM}" = "Darwin";
+		then
+			(cd ${TMPDIR} && find export -type d | sort > "${TEST_LOG}" && find export -type f -exec md5 {} \; | sort -k2 >> "${TEST_LOG}");
+		else
+			(cd ${TMPDIR} && find export -type d | sort > "${TEST_LOG}" && find export -type f -exec md5sum {} \; | sort -k2 >> "${TEST_LOG}");
+		fi
+		RESULT=$?;
+	fi
+	return ${RESULT};
+}
+
+# Compares the single files exported by multiple writer jobs (threads) with those exported single-threaded
+test_export_single_files_jobs()
+{
+	local INPUT_FILE=$1;
+
+	export_single_files "${INPUT_FILE}" "single_threaded.log" -j0;
+	local RESULT=$?;
+
+	if test ${RESULT} -eq ${EXIT_SUCCESS};
+	then
+		for JOBS_OPTIONS in "-j1" "-j4" "-j8";
+		do
+			export_single_files "${INPUT_FILE}" "multi_threaded.log" ${JOBS_OPTIONS};
+			RESULT=$?;
+
+			if test ${RESULT} -eq ${EXIT_SUCCESS};
+			then
+				diff "${TMPDIR}/single_threaded.log" "${TMPDIR}/multi_threaded.log" > /dev/null;
+				RESULT=$?;
+			fi
+			if test ${RESULT} -ne ${EXIT_SUCCESS};
+			then
+				break;
+			fi
+		done
+	fi
+	echo -n "Testing ${TEST_DESCRIPTION} with jobs and input: ${INPUT_FILE}";
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		echo " (FAIL)";
+	else
+		echo " (PASS)";
+	fi
+	return ${RESULT};
+}
+
 test_callback()
 {
 	local TMPDIR=$1;
@@ -111,5 +174,40 @@ fi
 run_test_on_input_directory "${TEST_PROFILE}" "${TEST_DESCRIPTION}" "with_callback" "${OPTION_SETS}" "${TEST_EXECUTABLE}" "${INPUT_DIRECTORY}" "${INPUT_GLOB}" -ffiles -q -texport -u;
 RESULT=$?;
 
+if test ${RESULT} -ne ${EXIT_SUCCESS};
+then
+	exit ${RESULT};
+fi
+
+# The single files are exported in media data offset order, where the file
+# data is written by the jobs, which must not change the exported files
+TMPDIR="tmp$$";
+
+rm -rf ${TMPDIR};
+mkdir ${TMPDIR};
+
+for TEST_SET_INPUT_DIRECTORY in ${INPUT_DIRECTORY}/*;
+do
+	if ! test -d "${TEST_SET_INPUT_DIRECTORY}";
+	then
+		continue;
+	fi
+	for INPUT_FILE in `ls -1 ${TEST_SET_INPUT_DIRECTORY}/${INPUT_GLOB} 2> /dev/null`;
+	do
+		if ! test_export_single_files_jobs "${INPUT_FILE}";
+		then
+			RESULT=${EXIT_FAILURE};
+
+			break;
+		fi
+	done
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		break;
+	fi
+done
+
+rm -rf ${TMPDIR};
+
 exit ${RESULT};
 
@@ -0,0 +1,292 @@
+#!/bin/bash
+# Mount tool testing script
+#
+# Mounts a test image with different numbers of read jobs (threads) and
+# compares the MD5 of the mounted media data, read concurrently, with the
+# MD5 of the test data. The logical images in the input directory are
+# mounted as files and the MD5 of the mounted files, read concurrently,
+# are compared with those read single-threaded. The test is skipped if FUSE
+# is not available.
+#
+# Version: 20261018
+
+EXIT_SUCCESS=0;
+EXIT_FAILURE=1;
+EXIT_IGNORE=77;
+
+NUMBER_OF_CONCURRENT_READS=4;
+
+INPUT_DIRECTORY="input";
+INPUT_GLOB="*.[Ll]*01";
+
+calculate_md5()
+{
+	local INPUT_FILE=$1;
+
+	if test "${PLATFORM}" = "Darwin";
+	then
+		md5 -q "${INPUT_FILE}";
+	else
+		md5sum "${INPUT_FILE}" | cut -d ' ' -f 1;
+	fi
+}
+
+unmount_mount_point()
+{
+	local MOUNT_POINT=$1;
+
+	if test "${PLATFORM}" = "Darwin";
+	then
+		umount "${MOUNT_POINT}";
+	else
+		fusermount -u "${MOUNT_POINT}";
+	fi
+}
+
+# Mounts a test image and compares the MD5 of the concurrently read media data with the MD5 of the test data
+test_mount_test_image()
+{
+	local TEST_IMAGE=$1;
+	local EXPECTED_MD5=$2;
+	shift 2;
+	local ARGUMENTS=$@;
+
+	local MOUNT_POINT="${TMPDIR}/mount";
+
+	mkdir -p "${MOUNT_POINT}";
+
+	${TEST_EXECUTABLE} ${ARGUMENTS} "${TEST_IMAGE}.E01" "${MOUNT_POINT}" > /dev/null 2>&1;
+	local RESULT=$?;
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		echo "Unable to mount test image with options: ${ARGUMENTS} (SKIP)";
+
+		return ${EXIT_IGNORE};
+	fi
+	local READ_INDEX=0;
+
+	while test ${READ_INDEX} -lt ${NUMBER_OF_CONCURRENT_READS};
+	do
+		calculate_md5 "${MOUNT_POINT}/ewf1" > "${TMPDIR}/read${READ_INDEX}.md5" &
+
+		READ_INDEX=$(( ${READ_INDEX} + 1 ));
+	done
+	wait;
+
+	READ_INDEX=0;
+
+	while test ${READ_INDEX} -lt ${NUMBER_OF_CONCURRENT_READS};
+	do
+		if test "`cat ${TMPDIR}/read${READ_INDEX}.md5`" != "${EXPECTED_MD5}";
+		then
+			RESULT=${EXIT_FAILURE};
+		fi
+		READ_INDEX=$(( ${READ_INDEX} + 1 ));
+	done
+
+	if ! unmount_mount_point "${MOUNT_POINT}";
+	then
+		RESULT=${EXIT_FAILURE};
+	fi
+	echo -n "Testing ewfmount with options: ${ARGUMENTS}";
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		echo " (FAIL)";
+	else
+		echo " (PASS)";
+	fi
+	return ${RESULT};
+}
+
+# Writes the MD5 of the mounted files to a log, where the files are read in reverse order if requested
+read_mounted_files()
+{
+	local MOUNT_POINT=$1;
+	local TEST_LOG=$2;
+	local SORT_OPTIONS=$3;
+
+	(cd "${MOUNT_POINT}" && find . -type f | sort ${SORT_OPTIONS} | while read FILENAME;
+	do
+		echo "`calculate_md5 "${FILENAME}"` ${FILENAME}";
+	done) | sort -k2 > "${TEST_LOG}";
+}
+
+# Mounts a logical image as files and compares the MD5 of the concurrently read files with those read single-threaded
+test_mount_logical_image()
+{
+	local INPUT_FILE=$1;
+	shift 1;
+	local ARGUMENTS=$@;
+
+	local MOUNT_POINT="${TMPDIR}/mount";
+
+	mkdir -p "${MOUNT_POINT}";
+
+	${TEST_EXECUTABLE} -ffiles -j0 "${INPUT_FILE}" "${MOUNT_POINT}" > /dev/null 2>&1;
+	local RESULT=$?;
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		echo "Unable to mount logical image: ${INPUT_FILE} (SKIP)";
+
+		return ${EXIT_IGNORE};
+	fi
+	read_mounted_files "${MOUNT_POINT}" "${TMPDIR}/single_threaded.log" "";
+
+	if ! unmount_mount_point "${MOUNT_POINT}";
+	then
+		RESULT=${EXIT_FAILURE};
+	fi
+	if test ${RESULT} -eq ${EXIT_SUCCESS};
+	then
+		${TEST_EXECUTABLE} -ffiles ${ARGUMENTS} "${INPUT_FILE}" "${MOUNT_POINT}" > /dev/null 2>&1;
+		RESULT=$?;
+	fi
+	if test ${RESULT} -eq ${EXIT_SUCCESS};
+	then
+		local READ_INDEX=0;
+
+		# Half of the readers read the files in reverse order so that
+		# different files of the same handle are read at the same time
+		while test ${READ_INDEX} -lt ${NUMBER_OF_CONCURRENT_READS};
+		do
+			if test $(( ${READ_INDEX} % 2 )) -eq 0;
+			then
+				read_mounted_files "${MOUNT_POINT}" "${TMPDIR}/read${READ_INDEX}.log" "" &
+			else
+				read_mounted_files "${MOUNT_POINT}" "${TMPDIR}/read${READ_INDEX}.log" "-r" &
+			fi
+			READ_INDEX=$(( ${READ_INDEX} + 1 ));
+		done
+		wait;
+
+		READ_INDEX=0;
+
+		while test ${READ_INDEX} -lt ${NUMBER_OF_CONCURRENT_READS};
+		do
+			if ! diff "${TMPDIR}/single_threaded.log" "${TMPDIR}/read${READ_INDEX}.log" > /dev/null;
+			then
+				RESULT=${EXIT_FAILURE};
+			fi
+			READ_INDEX=$(( ${READ_INDEX} + 1 ));
+		done
+
+		if ! unmount_mount_point "${MOUNT_POINT}";
+		then
+			RESULT=${EXIT_FAILURE};
+		fi
+	fi
+	echo -n "Testing ewfmount with options: -ffiles ${ARGUMENTS} and input: ${INPUT_FILE}";
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		echo " (FAIL)";
+	else
+		echo " (PASS)";
+	fi
+	return ${RESULT};
+}
+
+if ! test -z ${SKIP_TOOLS_TESTS};
+then
+	exit ${EXIT_IGNORE};
+fi
+
+TEST_EXECUTABLE="../ewftools/ewfmount";
+
+if ! test -x "${TEST_EXECUTABLE}";
+then
+	# ewfmount is only built if FUSE is available
+	exit ${EXIT_IGNORE};
+fi
+
+ACQUIRESTREAM_TOOL="../ewftools/ewfacquirestream";
+
+if ! test -x "${ACQUIRESTREAM_TOOL}";
+then
+	echo "Missing executable: ${ACQUIRESTREAM_TOOL}";
+
+	exit ${EXIT_FAILURE};
+fi
+
+PLATFORM=`uname -s`;
+
+if test "${PLATFORM}" = "Darwin";
+then
+	if ! test -x "`which md5`";
+	then
+		exit ${EXIT_IGNORE};
+	fi
+else
+	if ! test -c "/dev/fuse" || ! test -x "`which fusermount`" || ! test -x "`which md5sum`";
+	then
+		exit ${EXIT_IGNORE};
+	fi
+fi
+
+TMPDIR="tmp$$";
+
+rm -rf ${TMPDIR};
+mkdir ${TMPDIR};
+
+TEST_DATA="${TMPDIR}/input.raw";
+
+(head -c 1048576 /dev/zero; yes "ewfmount test data" | head -c 2097152; head -c 2097152 /dev/urandom; head -c 4608 /dev/urandom) > "${TEST_DATA}";
+
+EXPECTED_MD5=$(calculate_md5 "${TEST_DATA}");
+
+${ACQUIRESTREAM_TOOL} -c deflate:fast -q -S 1MiB -t "${TMPDIR}/image" < "${TEST_DATA}" > /dev/null 2>&1;
+RESULT=$?;
+
+if test ${RESULT} -ne ${EXIT_SUCCESS};
+then
+	echo "Unable to create test image.";
+
+	rm -rf ${TMPDIR};
+
+	exit ${EXIT_FAILURE};
+fi
+
+for MOUNT_OPTIONS in "-j0" "-j1" "-j4" "-j4 -k" "-j4 -r 65536";
+do
+	test_mount_test_image "${TMPDIR}/image" "${EXPECTED_MD5}" ${MOUNT_OPTIONS};
+	RESULT=$?;
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		break;
+	fi
+done
+
+if test ${RESULT} -eq ${EXIT_SUCCESS} && test -d "${INPUT_DIRECTORY}";
+then
+	for TEST_SET_INPUT_DIRECTORY in ${INPUT_DIRECTORY}/*;
+	do
+		if ! test -d "${TEST_SET_INPUT_DIRECTORY}";
+		then
+			continue;
+		fi
+		for INPUT_FILE in `ls -1 ${TEST_SET_INPUT_DIRECTORY}/${INPUT_GLOB} 2> /dev/null`;
+		do
+			for MOUNT_OPTIONS in "-j4" "-j4 -r 65536";
+			do
+				test_mount_logical_image "${INPUT_FILE}" ${MOUNT_OPTIONS};
+				RESULT=$?;
+
+				if test ${RESULT} -eq ${EXIT_IGNORE};
+				then
+					RESULT=${EXIT_SUCCESS};
+				elif test ${RESULT} -ne ${EXIT_SUCCESS};
+				then
+					break 3;
+				fi
+			done
+		done
+	done
+fi
+
+rm -rf ${TMPDIR};
+
+exit ${RESULT};
@@ -1,7 +1,7 @@
 #!/bin/bash
 # Verify tool testing script
 #
-# Version: 20170825
+# Version: 20261018
 
 EXIT_SUCCESS=0;
 EXIT_FAILURE=1;
@@ -12,6 +12,181 @@ OPTIONS="-q";
 
 INPUT_GLOB="*.[Ees]*01";
 
+# Creates a test image of data that contains empty, compressible and
+# uncompressible chunks and a last chunk that is not completely filled
+create_test_image()
+{
+	local TEST_DATA=$1;
+	local TEST_IMAGE=$2;
+	local COMPRESSION_VALUES=$3;
+
+	(head -c 1048576 /dev/zero; yes "ewfverify test data" | head -c 2097152; head -c 2097152 /dev/urandom; head -c 1048576 /dev/zero; head -c 4608 /dev/urandom) > "${TEST_DATA}";
+
+	${ACQUIRESTREAM_TOOL} -c ${COMPRESSION_VALUES} -q -S 1MiB -t "${TEST_IMAGE}" < "${TEST_DATA}" > /dev/null 2>&1;
+	local RESULT=$?;
+
+	echo -n "Creating test image: ${TEST_IMAGE}";
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		echo " (FAIL)";
+	else
+		echo " (PASS)";
+	fi
+	return ${RESULT};
+}
+
+# Creates a copy of a test image with corrupted chunk data in the first segment file
+create_corrupted_test_image()
+{
+	local TEST_IMAGE=$1;
+	local CORRUPTED_TEST_IMAGE=$2;
+
+	for SEGMENT_FILE in ${TEST_IMAGE}.E*;
+	do
+		cp "${SEGMENT_FILE}" "${CORRUPTED_TEST_IMAGE}.${SEGMENT_FILE##*.}";
+	done
+	printf "corrupted chunk data" | dd of="${CORRUPTED_TEST_IMAGE}.E01" bs=1 seek=524288 conv=notrunc > /dev/null 2>&1;
+}
+
+calculate_md5()
+{
+	local INPUT_FILE=$1;
+
+	if test "${PLATFORM}" = "Darwin";
+	then
+		md5 -q "${INPUT_FILE}";
+	else
+		md5sum "${INPUT_FILE}" | cut -d ' ' -f 1;
+	fi
+}
+
+# Verifies a test image and compares the calculated MD5 with the MD5 of the test data
+test_verify_test_image()
+{
+	local TEST_IMAGE=$1;
+	local EXPECTED_MD5=$2;
+	shift 2;
+	local ARGUMENTS=$@;
+
+	local TEST_LOG="${TMPDIR}/ewfverify.log";
+
+	${TEST_EXECUTABLE} -q ${ARGUMENTS} "${TEST_IMAGE}.E01" > "${TEST_LOG}" 2>&1;
+	local RESULT=$?;
+
+	if test ${RESULT} -eq ${EXIT_SUCCESS};
+	then
+		local CALCULATED_MD5=`grep "MD5 hash calculated over data:" "${TEST_LOG}" | sed 's/^.*:[[:space:]]*//'`;
+
+		if test "${CALCULATED_MD5}" != "${EXPECTED_MD5}";
+		then
+			RESULT=${EXIT_FAILURE};
+		fi
+	fi
+	echo -n "Testing ewfverify with options: ${ARGUMENTS}";
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		echo " (FAIL)";
+	else
+		echo " (PASS)";
+	fi
+	return ${RESULT};
+}
+
+# Verifies the test images in a manifest in batch mode and compares the result line of every test image
+# with the expected status and MD5 in the expected results file
+test_verify_batch()
+{
+	local MANIFEST=$1;
+	local EXPECTED_RESULTS=$2;
+	local EXPECTED_EXIT_STATUS=$3;
+	shift 3;
+	local ARGUMENTS=$@;
+
+	local TEST_LOG="${TMPDIR}/ewfverify_batch.log";
+
+	${TEST_EXECUTABLE} -B "${MANIFEST}" -q ${ARGUMENTS} > "${TEST_LOG}" 2> /dev/null;
+	local RESULT=$?;
+
+	if test ${RESULT} -ne ${EXPECTED_EXIT_STATUS};
+	then
+		RESULT=${EXIT_FAILURE};
+	else
+		RESULT=${EXIT_SUCCESS};
+	fi
+	while read -r EXPECTED_STATUS EXPECTED_MD5 FILENAME;
+	do
+		# A result line contains: status, media size, number of checksum errors, MD5, stored MD5, SHA1, SHA256 and filename
+		local RESULT_LINE=`awk -F '\t' -v filename="${FILENAME}" '$8 == filename { print $1 " " $3 " " $4 }' "${TEST_LOG}"`;
+
+		local STATUS=`echo "${RESULT_LINE}" | cut -d ' ' -f 1`;
+		local NUMBER_OF_CHECKSUM_ERRORS=`echo "${RESULT_LINE}" | cut -d ' ' -f 2`;
+		local CALCULATED_MD5=`echo "${RESULT_LINE}" | cut -d ' ' -f 3`;
+
+		if test "${STATUS}" != "${EXPECTED_STATUS}";
+		then
+			RESULT=${EXIT_FAILURE};
+
+		elif test "${EXPECTED_STATUS}" = "SUCCESS" && test "${CALCULATED_MD5}" != "${EXPECTED_MD5}";
+		then
+			RESULT=${EXIT_FAILURE};
+
+		elif test "${EXPECTED_STATUS}" = "FAILURE" && test "${NUMBER_OF_CHECKSUM_ERRORS}" = "0";
+		then
+			RESULT=${EXIT_FAILURE};
+		fi
+	done < "${EXPECTED_RESULTS}";
+
+	echo -n "Testing ewfverify batch mode with manifest: ${MANIFEST} and options: ${ARGUMENTS}";
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		echo " (FAIL)";
+	else
+		echo " (PASS)";
+	fi
+	return ${RESULT};
+}
+
+# Checks the chunks of a test image and compares the sectors with checksum errors
+# with the sectors with checksum errors of verifying the test image
+test_check_chunks()
+{
+	local TEST_IMAGE=$1;
+	local EXPECTED_EXIT_STATUS=$2;
+	local EXPECTED_CHECKSUM_ERRORS=$3;
+	shift 3;
+	local ARGUMENTS=$@;
+
+	local TEST_LOG="${TMPDIR}/ewfverify_check_chunks.log";
+
+	${TEST_EXECUTABLE} -C -q ${ARGUMENTS} "${TEST_IMAGE}.E01" > "${TEST_LOG}" 2>&1;
+	local RESULT=$?;
+
+	if test ${RESULT} -ne ${EXPECTED_EXIT_STATUS};
+	then
+		RESULT=${EXIT_FAILURE};
+	else
+		RESULT=${EXIT_SUCCESS};
+	fi
+	grep "at sector(s):" "${TEST_LOG}" > "${TEST_LOG}.checksum_errors";
+
+	if ! cmp -s "${EXPECTED_CHECKSUM_ERRORS}" "${TEST_LOG}.checksum_errors";
+	then
+		RESULT=${EXIT_FAILURE};
+	fi
+	echo -n "Testing ewfverify check chunks of: ${TEST_IMAGE} with options: ${ARGUMENTS}";
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		echo " (FAIL)";
+	else
+		echo " (PASS)";
+	fi
+	return ${RESULT};
+}
+
 if ! test -z ${SKIP_TOOLS_TESTS};
 then
 	exit ${EXIT_IGNORE};
@@ -31,6 +206,20 @@ then
 	exit ${EXIT_FAILURE};
 fi
 
+ACQUIRESTREAM_TOOL="../ewftools/ewfacquirestream";
+
+if ! test -x "${ACQUIRESTREAM_TOOL}";
+then
+	ACQUIRESTREAM_TOOL="../ewftools/ewfacquirestream.exe";
+fi
+
+if ! test -x "${ACQUIRESTREAM_TOOL}";
+then
+	echo "Missing executable: ${ACQUIRESTREAM_TOOL}";
+
+	exit ${EXIT_FAILURE};
+fi
+
 TEST_RUNNER="tests/test_runner.sh";
 
 if ! test -f "${TEST_RUNNER}";
@@ -45,10 +234,134 @@ then
 	exit ${EXIT_FAILURE};
 fi
 
+PLATFORM=`uname -s`;
+
 source ${TEST_RUNNER};
 
+if test "${PLATFORM}" = "Darwin";
+then
+	assert_availability_binary md5;
+else
+	assert_availability_binary md5sum;
+fi
+
 run_test_on_input_directory "ewfverify" "ewfverify" "with_stdout_reference" "${OPTION_SETS}" "${TEST_EXECUTABLE}" "input" "${INPUT_GLOB}" "${OPTIONS}";
 RESULT=$?;
 
-exit ${RESULT};
+if test ${RESULT} -ne ${EXIT_SUCCESS} && test ${RESULT} -ne ${EXIT_IGNORE};
+then
+	exit ${RESULT};
+fi
+
+TMPDIR="tmp$$";
+
+rm -rf ${TMPDIR};
+mkdir ${TMPDIR};
+
+if ! create_test_image "${TMPDIR}/input.raw" "${TMPDIR}/image" "deflate:fast";
+then
+	rm -rf ${TMPDIR};
+
+	exit ${EXIT_FAILURE};
+fi
+EXPECTED_MD5=$(calculate_md5 "${TMPDIR}/input.raw");
+
+# The MD5 calculated with reader threads must match the single-threaded
+# and single reader MD5, which is the MD5 of the test data
+for READER_OPTIONS in "-j0" "-j4 -k0" "-j1 -k1" "-j4 -k1" "-j4 -k4" "-j4 -k4 -x";
+do
+	if ! test_verify_test_image "${TMPDIR}/image" "${EXPECTED_MD5}" ${READER_OPTIONS};
+	then
+		rm -rf ${TMPDIR};
+
+		exit ${EXIT_FAILURE};
+	fi
+done
+
+# The second test image is not compressed, so that the corrupted copy
+# contains corrupted chunk data instead of corrupted compressed data
+if ! create_test_image "${TMPDIR}/input2.raw" "${TMPDIR}/image2" "deflate:none";
+then
+	rm -rf ${TMPDIR};
+
+	exit ${EXIT_FAILURE};
+fi
+EXPECTED_MD5_IMAGE2=$(calculate_md5 "${TMPDIR}/input2.raw");
+
+create_corrupted_test_image "${TMPDIR}/image2" "${TMPDIR}/corrupted";
+
+# The batch mode result of every image set must match the result of verifying it separately
+MANIFEST="${TMPDIR}/manifest";
+
+echo "# ewfverify test manifest" > "${MANIFEST}";
+echo "${TMPDIR}/image.E01" >> "${MANIFEST}";
+echo "" >> "${MANIFEST}";
+echo "${TMPDIR}/image2.E01" >> "${MANIFEST}";
+
+echo "SUCCESS ${EXPECTED_MD5} ${TMPDIR}/image.E01" > "${MANIFEST}.expected";
+echo "SUCCESS ${EXPECTED_MD5_IMAGE2} ${TMPDIR}/image2.E01" >> "${MANIFEST}.expected";
+
+CORRUPTED_MANIFEST="${TMPDIR}/corrupted_manifest";
+
+cp "${MANIFEST}" "${CORRUPTED_MANIFEST}";
+echo "${TMPDIR}/corrupted.E01" >> "${CORRUPTED_MANIFEST}";
+
+cp "${MANIFEST}.expected" "${CORRUPTED_MANIFEST}.expected";
+echo "FAILURE - ${TMPDIR}/corrupted.E01" >> "${CORRUPTED_MANIFEST}.expected";
+
+for BATCH_OPTIONS in "-j0" "-j1" "-j4" "-j4 -d sha1";
+do
+	if ! test_verify_batch "${MANIFEST}" "${MANIFEST}.expected" ${EXIT_SUCCESS} ${BATCH_OPTIONS};
+	then
+		rm -rf ${TMPDIR};
+
+		exit ${EXIT_FAILURE};
+	fi
+	# A failing image set must not affect the results of the other image sets
+	if ! test_verify_batch "${CORRUPTED_MANIFEST}" "${CORRUPTED_MANIFEST}.expected" ${EXIT_FAILURE} ${BATCH_OPTIONS};
+	then
+		rm -rf ${TMPDIR};
+
+		exit ${EXIT_FAILURE};
+	fi
+done
+
+# Checking the chunks must report the same sectors with checksum errors as verifying the test image
+${TEST_EXECUTABLE} -q -j0 "${TMPDIR}/corrupted.E01" 2>&1 | grep "at sector(s):" > "${TMPDIR}/corrupted.checksum_errors";
+
+if ! test -s "${TMPDIR}/corrupted.checksum_errors";
+then
+	echo "Missing checksum errors of corrupted test image.";
+
+	rm -rf ${TMPDIR};
+
+	exit ${EXIT_FAILURE};
+fi
+touch "${TMPDIR}/no_checksum_errors";
+
+for CHECK_CHUNKS_OPTIONS in "-j0" "-j1" "-j4";
+do
+	if ! test_check_chunks "${TMPDIR}/image" ${EXIT_SUCCESS} "${TMPDIR}/no_checksum_errors" ${CHECK_CHUNKS_OPTIONS};
+	then
+		rm -rf ${TMPDIR};
+
+		exit ${EXIT_FAILURE};
+	fi
+	if ! test_check_chunks "${TMPDIR}/image2" ${EXIT_SUCCESS} "${TMPDIR}/no_checksum_errors" ${CHECK_CHUNKS_OPTIONS};
+	then
+		rm -rf ${TMPDIR};
+
+		exit ${EXIT_FAILURE};
+	fi
+	if ! test_check_chunks "${TMPDIR}/corrupted" ${EXIT_FAILURE} "${TMPDIR}/corrupted.checksum_errors" ${CHECK_CHUNKS_OPTIONS};
+	then
+		rm -rf ${TMPDIR};
+
+		exit ${EXIT_FAILURE};
+	fi
+done
+
+rm -rf ${TMPDIR};
+
+exit ${EXIT_SUCCESS};
 
@@ -6,7 +6,7 @@ $ExitSuccess = 0
 $ExitFailure = 1
 $ExitIgnore = 77
 
-$LibraryTests = "chunk_data chunk_group chunk_table data_chunk error file_entry hash_sections header_sections io_handle media_values notify read_io_handle section sector_range segment_file segment_table single_file_entry single_files write_io_handle"
+$LibraryTests = "chunk_data chunk_group chunk_table data_chunk deflate directory error file_entry hash_sections hash_tree header_sections io_handle media_values notify open_handles_budget read_batch read_digest read_io_handle read_scheduler section sector_range segment_file segment_table shared_memory_chunks_cache shared_metadata single_file_entry single_file_name_index single_files statistics write_io_handle"
 $LibraryTestsWithInput = "handle support"
 
 Function GetTestToolDirectory
@@ -7,7 +7,7 @@ EXIT_SUCCESS=0;
 EXIT_FAILURE=1;
 EXIT_IGNORE=77;
 
-LIBRARY_TESTS="chunk_data chunk_group chunk_table data_chunk error file_entry hash_sections header_sections io_handle media_values notify read_io_handle section sector_range segment_file segment_table single_file_entry single_files write_io_handle";
+LIBRARY_TESTS="chunk_data chunk_group chunk_table data_chunk deflate directory error file_entry hash_sections hash_tree header_sections io_handle media_values notify open_handles_budget read_batch read_digest read_io_handle read_scheduler section sector_range segment_file segment_table shared_memory_chunks_cache shared_metadata single_file_entry single_file_name_index single_files statistics write_io_handle";
 LIBRARY_TESTS_WITH_INPUT="handle support";
 OPTION_SETS="";
 
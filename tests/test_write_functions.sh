@@ -1,7 +1,7 @@
 #!/bin/bash
 # Library API write functions testing script
 #
-# Version: 20160403
+# Version: 20261018
 
 EXIT_SUCCESS=0;
 EXIT_FAILURE=1;
@@ -11,7 +11,7 @@ TEST_PREFIX=`dirname ${PWD}`;
 TEST_PREFIX=`basename ${TEST_PREFIX} | sed 's/^lib\([^-]*\)/\1/'`;
 
 TEST_PROFILE="lib${TEST_PREFIX}";
-TEST_FUNCTIONS="write write_chunk";
+TEST_FUNCTIONS="write write_chunk read_direct";
 OPTION_SETS="";
 
 TEST_TOOL_DIRECTORY=".";
@@ -101,6 +101,41 @@ test_write()
 	return ${RESULT};
 }
 
+test_read_direct()
+{
+	local TEST_PROFILE=$1;
+	local TEST_FUNCTION=$2;
+	local OPTION_SETS=$3;
+
+	for FORMAT in 1 2;
+	do
+		for COMPRESSION_LEVEL in none empty-block fast best;
+		do
+			COMPRESSION_LEVEL=`echo ${COMPRESSION_LEVEL} | cut -c 1`;
+
+			test_api_write_function "${TEST_FUNCTION}" -c${COMPRESSION_LEVEL} -f${FORMAT} -S0;
+			RESULT=$?;
+
+			if test ${RESULT} -ne ${EXIT_SUCCESS};
+			then
+				return ${RESULT};
+			fi
+
+			test_api_write_function "${TEST_FUNCTION}" -c${COMPRESSION_LEVEL} -f${FORMAT} -S10000;
+			RESULT=$?;
+
+			if test ${RESULT} -ne ${EXIT_SUCCESS};
+			then
+				return ${RESULT};
+			fi
+
+			echo "";
+		done
+	done
+
+	return ${RESULT};
+}
+
 if ! test -z ${SKIP_LIBRARY_TESTS};
 then
 	exit ${EXIT_IGNORE};
@@ -124,7 +159,12 @@ source ${TEST_RUNNER};
 
 for TEST_FUNCTION in ${TEST_FUNCTIONS};
 do
-	test_write "${TEST_PROFILE}" "${TEST_FUNCTION}" "${OPTION_SETS}";
+	if test "${TEST_FUNCTION}" = "read_direct";
+	then
+		test_read_direct "${TEST_PROFILE}" "${TEST_FUNCTION}" "${OPTION_SETS}";
+	else
+		test_write "${TEST_PROFILE}" "${TEST_FUNCTION}" "${OPTION_SETS}";
+	fi
 	RESULT=$?;
 
 	if test ${RESULT} -ne ${EXIT_SUCCESS};